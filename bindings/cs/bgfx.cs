@@ -1911,6 +1911,11 @@ public static partial class bgfx
 		/// </summary>
 		DepthDescending,
 	
+		/// <summary>
+		/// Sort by program, render state, texture bindings, and vertex/index buffers to minimize state changes.
+		/// </summary>
+		Material,
+	
 		Count
 	}
 	
@@ -2046,6 +2051,7 @@ public static partial class bgfx
 		public uint size;
 		public uint startIndex;
 		public IndexBufferHandle handle;
+		public byte isIndex16;
 	}
 	
 	public unsafe struct TransientVertexBuffer
@@ -2111,6 +2117,17 @@ public static partial class bgfx
 		public long cpuTimeEnd;
 		public long gpuTimeBegin;
 		public long gpuTimeEnd;
+		public uint numDraw;
+		public uint numCompute;
+		public uint numBlit;
+		public uint numDropped;
+		public uint numProgramChanges;
+		public uint numBindChanges;
+		public uint numBufferChanges;
+		public uint numStateChanges;
+		public uint uniformSize;
+		public uint numInstances;
+		public fixed uint numPrims[5];
 	}
 	
 	public unsafe struct EncoderStats
@@ -2160,6 +2177,10 @@ public static partial class bgfx
 		public ViewStats* viewStats;
 		public byte numEncoders;
 		public EncoderStats* encoderStats;
+		public uint numProgramChanges;
+		public uint numBindChanges;
+		public uint numBufferChanges;
+		public uint numStateChanges;
 	}
 	
 	public unsafe struct VertexLayout
@@ -2759,9 +2780,10 @@ public static partial class bgfx
 	/// </summary>
 	///
 	/// <param name="_num">Number of required indices.</param>
+	/// <param name="_index32">Set to `true` if input indices will be 32-bit.</param>
 	///
 	[DllImport(DllName, EntryPoint="bgfx_get_avail_transient_index_buffer", CallingConvention = CallingConvention.Cdecl)]
-	public static extern unsafe uint get_avail_transient_index_buffer(uint _num);
+	public static extern unsafe uint get_avail_transient_index_buffer(uint _num, bool _index32);
 	
 	/// <summary>
 	/// Returns number of requested or maximum available vertices.
@@ -2786,14 +2808,15 @@ public static partial class bgfx
 	/// <summary>
 	/// Allocate transient index buffer.
 	/// @remarks
-	///   Only 16-bit index buffer is supported.
+	///   32-bit indices require `BGFX_CAPS_INDEX32`.
 	/// </summary>
 	///
 	/// <param name="_tib">TransientIndexBuffer structure is filled and is valid for the duration of frame, and it can be reused for multiple draw calls.</param>
 	/// <param name="_num">Number of indices to allocate.</param>
+	/// <param name="_index32">Set to `true` if input indices will be 32-bit.</param>
 	///
 	[DllImport(DllName, EntryPoint="bgfx_alloc_transient_index_buffer", CallingConvention = CallingConvention.Cdecl)]
-	public static extern unsafe void alloc_transient_index_buffer(TransientIndexBuffer* _tib, uint _num);
+	public static extern unsafe void alloc_transient_index_buffer(TransientIndexBuffer* _tib, uint _num, bool _index32);
 	
 	/// <summary>
 	/// Allocate transient vertex buffer.
@@ -2811,7 +2834,7 @@ public static partial class bgfx
 	/// buffers. If both space requirements are satisfied function returns
 	/// true.
 	/// @remarks
-	///   Only 16-bit index buffer is supported.
+	///   32-bit indices require `BGFX_CAPS_INDEX32`.
 	/// </summary>
 	///
 	/// <param name="_tvb">TransientVertexBuffer structure is filled and is valid for the duration of frame, and it can be reused for multiple draw calls.</param>
@@ -2819,10 +2842,11 @@ public static partial class bgfx
 	/// <param name="_numVertices">Number of vertices to allocate.</param>
 	/// <param name="_tib">TransientIndexBuffer structure is filled and is valid for the duration of frame, and it can be reused for multiple draw calls.</param>
 	/// <param name="_numIndices">Number of indices to allocate.</param>
+	/// <param name="_index32">Set to `true` if input indices will be 32-bit.</param>
 	///
 	[DllImport(DllName, EntryPoint="bgfx_alloc_transient_buffers", CallingConvention = CallingConvention.Cdecl)]
 	[return: MarshalAs(UnmanagedType.I1)]
-	public static extern unsafe bool alloc_transient_buffers(TransientVertexBuffer* _tvb, VertexLayout* _layout, uint _numVertices, TransientIndexBuffer* _tib, uint _numIndices);
+	public static extern unsafe bool alloc_transient_buffers(TransientVertexBuffer* _tvb, VertexLayout* _layout, uint _numVertices, TransientIndexBuffer* _tib, uint _numIndices, bool _index32);
 	
 	/// <summary>
 	/// Allocate instance data buffer.
@@ -3095,6 +3119,23 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_read_texture", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe uint read_texture(TextureHandle _handle, void* _data, byte _mip);
 	
+	/// <summary>
+	/// Set most detailed resident mip of texture. Sampling is clamped to mips from `_mip` to
+	/// the smallest mip, so that texture can be created with full mip chain, and only the
+	/// smallest mips uploaded. Higher mips can be streamed in later with `bgfx::updateTexture*`,
+	/// and made visible by lowering resident mip, or evicted by raising it again.
+	/// @remarks
+	///   Clamp is applied from the next frame, after texture updates submitted in the same
+	///   frame. Backends don't release memory of evicted mips. Use `Stats::gpuMemoryUsed` and
+	///   `Stats::gpuMemoryMax` as memory budget where available.
+	/// </summary>
+	///
+	/// <param name="_handle">Texture handle.</param>
+	/// <param name="_mip">Most detailed mip level that can be sampled.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_set_texture_resident_mip", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void set_texture_resident_mip(TextureHandle _handle, byte _mip);
+	
 	/// <summary>
 	/// Set texture debug name.
 	/// </summary>
@@ -3466,9 +3507,10 @@ public static partial class bgfx
 	/// </summary>
 	///
 	/// <param name="_forThread">Explicitly request an encoder for a worker thread.</param>
+	/// <param name="_ordinal">Sequential view ordering slot. Draw calls from encoder with lower ordinal are ordered first. Valid ordinals are 0 to 254. When `UINT8_MAX`, encoder index is used, which depends on order in which threads call begin, so order of draw calls between encoders is not deterministic. Each encoder orders up to 2^20 draw calls per sequential view, further draw calls share the last sequence number.</param>
 	///
 	[DllImport(DllName, EntryPoint="bgfx_encoder_begin", CallingConvention = CallingConvention.Cdecl)]
-	public static extern unsafe Encoder* encoder_begin(bool _forThread);
+	public static extern unsafe Encoder* encoder_begin(bool _forThread, byte _ordinal);
 	
 	/// <summary>
 	/// End submitting draw calls from thread.
@@ -3931,6 +3973,22 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_request_screen_shot", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void request_screen_shot(FrameBufferHandle _handle, [MarshalAs(UnmanagedType.LPStr)] string _filePath);
 	
+	/// <summary>
+	/// Request timeline trace. Profiler scopes from all threads, encoder submit times, and per view
+	/// CPU and GPU times are recorded, and written as Chrome trace event JSON after requested number
+	/// of frames is rendered.
+	/// @remarks
+	///   Profiler scopes are recorded only when library is built with `BGFX_CONFIG_PROFILER`.
+	///   Trace is recorded only when library is built with `BGFX_CONFIG_TRACE`, which is disabled by
+	///   default.
+	/// </summary>
+	///
+	/// <param name="_filePath">Trace file path.</param>
+	/// <param name="_numFrames">Number of frames to record.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_request_trace", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void request_trace([MarshalAs(UnmanagedType.LPStr)] string _filePath, uint _numFrames);
+	
 	/// <summary>
 	/// Render frame.
 	/// @attention `bgfx::renderFrame` is blocking call. It waits for
@@ -5,6 +5,7 @@
 
 #include "common.h"
 #include "bgfx_utils.h"
+#include "meshloader.h"
 #include "imgui/imgui.h"
 
 namespace
@@ -51,7 +52,10 @@ public:
 		// Create program from shaders.
 		m_program = loadProgram("vs_mesh", "fs_mesh");
 
-		m_mesh = meshLoad("meshes/bunny.bin");
+		// Mesh is loaded on worker threads, and it's rendered once it's ready.
+		m_mesh = NULL;
+		m_meshLoader = new MeshLoader;
+		m_meshRequest = m_meshLoader->load("meshes/bunny.bin");
 
 		m_timeOffset = bx::getHPCounter();
 
@@ -62,7 +66,12 @@ public:
 	{
 		imguiDestroy();
 
-		meshUnload(m_mesh);
+		delete m_meshLoader;
+
+		if (NULL != m_mesh)
+		{
+			meshUnload(m_mesh);
+		}
 
 		// Cleanup.
 		bgfx::destroy(m_program);
@@ -125,7 +134,16 @@ public:
 				, time*0.37f
 				);
 
-			meshSubmit(m_mesh, 0, m_program, mtx);
+			m_meshLoader->update();
+			if (NULL == m_mesh)
+			{
+				m_meshLoader->poll(m_meshRequest, &m_mesh);
+			}
+
+			if (NULL != m_mesh)
+			{
+				meshSubmit(m_mesh, 0, m_program, mtx);
+			}
 
 			// Advance to next frame. Rendering thread will be kicked to
 			// process submitted rendering primitives.
@@ -146,6 +164,8 @@ public:
 
 	int64_t m_timeOffset;
 	Mesh* m_mesh;
+	MeshLoader* m_meshLoader;
+	uint32_t m_meshRequest;
 	bgfx::ProgramHandle m_program;
 	bgfx::UniformHandle u_time;
 };
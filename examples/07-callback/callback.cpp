@@ -11,7 +11,7 @@
 #include <bx/file.h>
 #include <bx/string.h>
 
-#include "aviwriter.h"
+#include "capturewriter.h"
 
 #include <inttypes.h>
 
@@ -93,6 +93,11 @@ void saveTga(const char* _filePath, uint32_t _width, uint32_t _height, uint32_t
 
 struct BgfxCallback : public bgfx::CallbackI
 {
+	BgfxCallback()
+		: m_writer(NULL)
+	{
+	}
+
 	virtual ~BgfxCallback()
 	{
 	}
@@ -197,10 +202,10 @@ struct BgfxCallback : public bgfx::CallbackI
 		saveTga(temp, _width, _height, _pitch, _data, false, _yflip);
 	}
 
-	virtual void captureBegin(uint32_t _width, uint32_t _height, uint32_t /*_pitch*/, bgfx::TextureFormat::Enum /*_format*/, bool _yflip) override
+	virtual void captureBegin(uint32_t _width, uint32_t _height, uint32_t _pitch, bgfx::TextureFormat::Enum /*_format*/, bool _yflip) override
 	{
-		m_writer = BX_NEW(entry::getAllocator(), AviWriter)(entry::getFileWriter() );
-		if (!m_writer->open("temp/capture.avi", _width, _height, 60, _yflip) )
+		m_writer = BX_NEW(entry::getAllocator(), CaptureWriter)(entry::getAllocator() );
+		if (!m_writer->open("temp/capture.bcap", _width, _height, _pitch, 60, _yflip) )
 		{
 			BX_DELETE(entry::getAllocator(), m_writer);
 			m_writer = NULL;
@@ -212,20 +217,31 @@ struct BgfxCallback : public bgfx::CallbackI
 		if (NULL != m_writer)
 		{
 			m_writer->close();
+
+			CaptureStats stats;
+			m_writer->getStats(stats);
+			bx::debugPrintf("Capture: %d frames, %d dropped, max queue depth %d, %" PRIu64 " -> %" PRIu64 " bytes.\n"
+				, stats.numFrames
+				, stats.numDropped
+				, stats.maxQueueDepth
+				, stats.rawBytes
+				, stats.writtenBytes
+				);
+
 			BX_DELETE(entry::getAllocator(), m_writer);
 			m_writer = NULL;
 		}
 	}
 
-	virtual void captureFrame(const void* _data, uint32_t /*_size*/) override
+	virtual void captureFrame(const void* _data, uint32_t _size) override
 	{
 		if (NULL != m_writer)
 		{
-			m_writer->frame(_data);
+			m_writer->frame(_data, _size);
 		}
 	}
 
-	AviWriter* m_writer;
+	CaptureWriter* m_writer;
 };
 
 const size_t kNaturalAlignment = 8;
@@ -972,8 +972,10 @@ struct Mesh
 
 		for (::GroupArray::iterator it = mesh->m_groups.begin(), itEnd = mesh->m_groups.end(); it != itEnd; ++it)
 		{
+			BX_ASSERT(!it->m_index32, "Shadow volume meshes must use 16-bit indices.");
+
 			Group group;
-			group.m_numVertices = it->m_numVertices;
+			group.m_numVertices = uint16_t(it->m_numVertices);
 			const uint32_t vertexSize = group.m_numVertices*stride;
 			group.m_vertices = (uint8_t*)malloc(vertexSize);
 			bx::memCopy(group.m_vertices, it->m_vertices, vertexSize);
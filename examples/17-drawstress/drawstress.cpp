@@ -87,6 +87,19 @@ static const float s_mod[6][3] =
 	{ 0.0f, 1.0f, 1.0f },
 };
 
+// Material variations, they don't change how cubes look, but each one is
+// separate render state or vertex buffer for sorting.
+static const uint64_t s_materialState[] =
+{
+	BGFX_STATE_DEFAULT,
+	BGFX_STATE_DEFAULT & ~BGFX_STATE_MSAA,
+	(BGFX_STATE_DEFAULT & ~BGFX_STATE_DEPTH_TEST_MASK) | BGFX_STATE_DEPTH_TEST_LEQUAL,
+	(BGFX_STATE_DEFAULT & ~BGFX_STATE_DEPTH_TEST_MASK & ~BGFX_STATE_MSAA) | BGFX_STATE_DEPTH_TEST_LEQUAL,
+};
+
+static const uint32_t kNumMaterialBuffers = 4;
+static const uint32_t kMaxMaterials = BX_COUNTOF(s_materialState)*kNumMaterialBuffers;
+
 #if BX_PLATFORM_EMSCRIPTEN
 static const int64_t highwm = 1000000/35;
 static const int64_t lowwm  = 1000000/27;
@@ -120,6 +133,9 @@ public:
 		m_maxDim     = 40;
 		m_transform  = 0;
 
+		m_numMaterials = 1;
+		m_sortMaterial = false;
+
 		m_timeOffset = bx::getHPCounter();
 
 		m_deltaTimeNs    = 0;
@@ -160,11 +176,14 @@ public:
 			, true /* destroy shaders when program is destroyed */
 			);
 
-		// Create static vertex buffer.
-		m_vbh = bgfx::createVertexBuffer(
-			  bgfx::makeRef(s_cubeVertices, sizeof(s_cubeVertices) )
-			, PosColorVertex::ms_layout
-			);
+		// Create static vertex buffers.
+		for (uint32_t ii = 0; ii < kNumMaterialBuffers; ++ii)
+		{
+			m_vbh[ii] = bgfx::createVertexBuffer(
+				  bgfx::makeRef(s_cubeVertices, sizeof(s_cubeVertices) )
+				, PosColorVertex::ms_layout
+				);
+		}
 
 		// Create static index buffer.
 		m_ibh = bgfx::createIndexBuffer(bgfx::makeRef(s_cubeIndices, sizeof(s_cubeIndices) ) );
@@ -192,7 +211,12 @@ public:
 		// Cleanup.
 		imguiDestroy();
 		bgfx::destroy(m_ibh);
-		bgfx::destroy(m_vbh);
+
+		for (uint32_t ii = 0; ii < kNumMaterialBuffers; ++ii)
+		{
+			bgfx::destroy(m_vbh[ii]);
+		}
+
 		bgfx::destroy(m_program);
 
 		// Shutdown bgfx.
@@ -275,10 +299,14 @@ public:
 						mtx[13] = pos[1] + float(yy)*step;
 						mtx[14] = pos[2] + float(zz)*step;
 
+						const uint32_t material = ( (xx*73856093) ^ (yy*19349663) ^ (zz*83492791) ) % uint32_t(m_numMaterials);
+						const uint32_t buffer   = material % kNumMaterialBuffers;
+						const uint32_t state    = material / kNumMaterialBuffers;
+
 						encoder->setTransform(mtx);
-						encoder->setVertexBuffer(0, m_vbh);
+						encoder->setVertexBuffer(0, m_vbh[buffer]);
 						encoder->setIndexBuffer(m_ibh);
-						encoder->setState(BGFX_STATE_DEFAULT);
+						encoder->setState(s_materialState[state]);
 						encoder->submit(0, m_program);
 					}
 				}
@@ -365,7 +393,17 @@ public:
 			ImGui::Text("Avg Delta Time (1 second) [ms]: %0.4f", m_deltaTimeAvgNs/1000.0f);
 
 			ImGui::Separator();
+			ImGui::SliderInt("Materials", &m_numMaterials, 1, kMaxMaterials);
+			ImGui::Checkbox("Sort by material", &m_sortMaterial);
+
+			// State change counters are updated only with profiler enabled (F6).
 			const bgfx::Stats* stats = bgfx::getStats();
+			ImGui::Text("Program changes: %d", stats->numProgramChanges);
+			ImGui::Text("State changes: %d", stats->numStateChanges);
+			ImGui::Text("Buffer changes: %d", stats->numBufferChanges);
+			ImGui::Text("Bind changes: %d", stats->numBindChanges);
+
+			ImGui::Separator();
 			ImGui::Text("GPU %0.6f [ms]", double(stats->gpuTimeEnd - stats->gpuTimeBegin)*1000.0/stats->gpuTimerFreq);
 			ImGui::Text("CPU %0.6f [ms]", double(stats->cpuTimeEnd - stats->cpuTimeBegin)*1000.0/stats->cpuTimerFreq);
 			ImGui::Text("Waiting for render thread %0.6f [ms]", double(stats->waitRender) * toMs);
@@ -391,6 +429,8 @@ public:
 			// Set view 0 default viewport.
 			bgfx::setViewRect(0, 0, 0, uint16_t(m_width), uint16_t(m_height) );
 
+			bgfx::setViewMode(0, m_sortMaterial ? bgfx::ViewMode::Material : bgfx::ViewMode::Default);
+
 			// This dummy draw call is here to make sure that view 0 is cleared
 			// if no other draw calls are submitted to view 0.
 			bgfx::touch(0);
@@ -434,6 +474,8 @@ public:
 	int32_t  m_dim;
 	int32_t  m_maxDim;
 	int32_t  m_transform;
+	int32_t  m_numMaterials;
+	bool     m_sortMaterial;
 	int32_t  m_numThreads;
 	int32_t  m_maxThreads;
 
@@ -447,7 +489,7 @@ public:
 	bx::Semaphore m_sync;
 
 	bgfx::ProgramHandle m_program;
-	bgfx::VertexBufferHandle m_vbh;
+	bgfx::VertexBufferHandle m_vbh[kNumMaterialBuffers];
 	bgfx::IndexBufferHandle  m_ibh;
 };
 
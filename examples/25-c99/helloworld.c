@@ -45,7 +45,7 @@ int32_t _main_(int32_t _argc, char** _argv)
 
 		// This dummy draw call is here to make sure that view 0 is cleared
 		// if no other draw calls are submitted to view 0.
-		bgfx_encoder_t* encoder = bgfx_encoder_begin(true);
+		bgfx_encoder_t* encoder = bgfx_encoder_begin(true, UINT8_MAX);
 		bgfx_encoder_touch(encoder, 0);
 		bgfx_encoder_end(encoder);
 
@@ -141,7 +141,8 @@ public:
 		m_vti = new vt::VirtualTextureInfo();
 		m_vti->m_virtualTextureSize = 8192; // The actual size will be read from the tile data file
 		m_vti->m_tileSize = 128;
-		m_vti->m_borderSize = 1;
+		m_vti->m_borderSize = 2; // Block compressed page size must be multiple of 4
+		m_vti->m_format = bgfx::TextureFormat::BC1;
 
 		// Generate tile data file (if not yet created)
 		{
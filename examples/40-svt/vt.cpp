@@ -13,17 +13,201 @@
   *   http://web.archive.org/web/20190103162730/http://www.celestiamotherlode.net/catalog/mars.php
   */
 
+#include <bx/cpu.h>
 #include <bx/file.h>
 #include <bx/sort.h>
 
 #include "vt.h"
 
+#include <thread>
+
+#if BX_PLATFORM_WINDOWS
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif // NOMINMAX
+#	include <windows.h>
+#	include <io.h>
+#elif BX_PLATFORM_LINUX || BX_PLATFORM_OSX || BX_PLATFORM_BSD || BX_PLATFORM_ANDROID || BX_PLATFORM_IOS
+#	include <sys/mman.h>
+#endif // BX_PLATFORM_*
+
 namespace vt
 {
 
 // Constants
 static const int s_channelCount = 4;
-static const int s_tileFileDataOffset = sizeof(VirtualTextureInfo);
+static const uint32_t s_tileFileMagic = BX_MAKEFOURCC('V', 'T', 'F', 0x1);
+static const int s_pagesInFlightPerUpload = 4;
+
+static int getPageDataSize(int _pagesize, bgfx::TextureFormat::Enum _format)
+{
+	if (bgfx::TextureFormat::BC1 == _format)
+	{
+		return (_pagesize / 4) * (_pagesize / 4) * 8;
+	}
+
+	return _pagesize * _pagesize * s_channelCount;
+}
+
+static uint16_t packRgb565(const uint8_t* _bgra)
+{
+	return uint16_t( ( (_bgra[2] >> 3) << 11) | ( (_bgra[1] >> 2) << 5) | (_bgra[0] >> 3) );
+}
+
+static void unpackRgb565(uint16_t _color, uint8_t* _bgra)
+{
+	uint8_t r = uint8_t( (_color >> 11) & 0x1f);
+	uint8_t g = uint8_t( (_color >>  5) & 0x3f);
+	uint8_t b = uint8_t( (_color      ) & 0x1f);
+	_bgra[0] = uint8_t( (b << 3) | (b >> 2) );
+	_bgra[1] = uint8_t( (g << 2) | (g >> 4) );
+	_bgra[2] = uint8_t( (r << 3) | (r >> 2) );
+	_bgra[3] = 255;
+}
+
+static void bc1Palette(uint16_t _c0, uint16_t _c1, uint8_t _palette[4][4])
+{
+	unpackRgb565(_c0, _palette[0]);
+	unpackRgb565(_c1, _palette[1]);
+
+	for (int i = 0; i < 3; ++i)
+	{
+		if (_c0 > _c1)
+		{
+			_palette[2][i] = uint8_t( (2 * _palette[0][i] +     _palette[1][i]) / 3);
+			_palette[3][i] = uint8_t( (    _palette[0][i] + 2 * _palette[1][i]) / 3);
+		}
+		else
+		{
+			_palette[2][i] = uint8_t( (_palette[0][i] + _palette[1][i]) / 2);
+			_palette[3][i] = 0;
+		}
+	}
+
+	_palette[2][3] = 255;
+	_palette[3][3] = _c0 > _c1 ? 255 : 0;
+}
+
+// Bounding box BC1 encoder, endpoints are inset color extents of 4x4 block
+static void encodeBc1Block(const uint8_t* _bgra, int _pitch, uint8_t* _dst)
+{
+	uint8_t minColor[4] = { 255, 255, 255, 255 };
+	uint8_t maxColor[4] = {   0,   0,   0, 255 };
+
+	for (int y = 0; y < 4; ++y)
+	{
+		const uint8_t* row = &_bgra[y * _pitch];
+		for (int x = 0; x < 4; ++x)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				minColor[i] = bx::min(minColor[i], row[x * s_channelCount + i]);
+				maxColor[i] = bx::max(maxColor[i], row[x * s_channelCount + i]);
+			}
+		}
+	}
+
+	for (int i = 0; i < 3; ++i)
+	{
+		uint8_t inset = uint8_t( (maxColor[i] - minColor[i]) >> 4);
+		minColor[i] = uint8_t(minColor[i] + inset);
+		maxColor[i] = uint8_t(maxColor[i] - inset);
+	}
+
+	uint16_t c0 = packRgb565(maxColor);
+	uint16_t c1 = packRgb565(minColor);
+	if (c0 < c1)
+	{
+		bx::swap(c0, c1);
+	}
+
+	uint32_t indices = 0;
+
+	if (c0 != c1)
+	{
+		uint8_t palette[4][4];
+		bc1Palette(c0, c1, palette);
+
+		for (int y = 0; y < 4; ++y)
+		{
+			const uint8_t* row = &_bgra[y * _pitch];
+			for (int x = 0; x < 4; ++x)
+			{
+				const uint8_t* color = &row[x * s_channelCount];
+
+				uint32_t best = 0;
+				int bestDist = INT32_MAX;
+				for (uint32_t j = 0; j < 4; ++j)
+				{
+					int db = int(color[0]) - palette[j][0];
+					int dg = int(color[1]) - palette[j][1];
+					int dr = int(color[2]) - palette[j][2];
+					int dist = db * db + dg * dg + dr * dr;
+					if (dist < bestDist)
+					{
+						bestDist = dist;
+						best = j;
+					}
+				}
+
+				indices |= best << ( (y * 4 + x) * 2);
+			}
+		}
+	}
+
+	_dst[0] = uint8_t(c0     );
+	_dst[1] = uint8_t(c0 >> 8);
+	_dst[2] = uint8_t(c1     );
+	_dst[3] = uint8_t(c1 >> 8);
+	bx::memCopy(&_dst[4], &indices, sizeof(indices) );
+}
+
+static void decodeBc1Block(const uint8_t* _src, uint8_t* _bgra, int _pitch)
+{
+	uint16_t c0 = uint16_t(_src[0] | (_src[1] << 8) );
+	uint16_t c1 = uint16_t(_src[2] | (_src[3] << 8) );
+	uint32_t indices;
+	bx::memCopy(&indices, &_src[4], sizeof(indices) );
+
+	uint8_t palette[4][4];
+	bc1Palette(c0, c1, palette);
+
+	for (int y = 0; y < 4; ++y)
+	{
+		uint8_t* row = &_bgra[y * _pitch];
+		for (int x = 0; x < 4; ++x)
+		{
+			uint32_t index = (indices >> ( (y * 4 + x) * 2) ) & 3;
+			bx::memCopy(&row[x * s_channelCount], palette[index], s_channelCount);
+		}
+	}
+}
+
+static void encodeBc1(const uint8_t* _bgra, int _size, uint8_t* _dst)
+{
+	int pitch = _size * s_channelCount;
+	for (int y = 0; y < _size; y += 4)
+	{
+		for (int x = 0; x < _size; x += 4)
+		{
+			encodeBc1Block(&_bgra[y * pitch + x * s_channelCount], pitch, _dst);
+			_dst += 8;
+		}
+	}
+}
+
+static void decodeBc1(const uint8_t* _src, int _size, uint8_t* _bgra)
+{
+	int pitch = _size * s_channelCount;
+	for (int y = 0; y < _size; y += 4)
+	{
+		for (int x = 0; x < _size; x += 4)
+		{
+			decodeBc1Block(_src, &_bgra[y * pitch + x * s_channelCount], pitch);
+			_src += 8;
+		}
+	}
+}
 
 // Page
 Page::operator size_t() const
@@ -66,11 +250,17 @@ int VirtualTextureInfo::GetPageTableSize() const
 	return m_virtualTextureSize / m_tileSize;
 }
 
-StagingPool::StagingPool(int _width, int _height, int _count, bool _readBack)
+int VirtualTextureInfo::GetPageDataSize() const
+{
+	return getPageDataSize(GetPageSize(), m_format);
+}
+
+StagingPool::StagingPool(int _width, int _height, int _count, bool _readBack, bgfx::TextureFormat::Enum _format)
 	: m_stagingTextureIndex(0)
 	, m_width(_width)
 	, m_height(_height)
 	, m_flags(0)
+	, m_format(_format)
 {
 	m_flags = BGFX_TEXTURE_BLIT_DST | BGFX_SAMPLER_UVW_CLAMP;
 	if (_readBack)
@@ -92,7 +282,7 @@ void StagingPool::grow(int count)
 {
 	while ((int)m_stagingTextures.size() < count)
 	{
-		auto stagingTexture = bgfx::createTexture2D((uint16_t)m_width, (uint16_t)m_height, false, 1, bgfx::TextureFormat::BGRA8, m_flags);
+		auto stagingTexture = bgfx::createTexture2D((uint16_t)m_width, (uint16_t)m_height, false, 1, m_format, m_flags);
 		m_stagingTextures.push_back(stagingTexture);
 	}
 }
@@ -499,40 +689,266 @@ bgfx::TextureHandle PageTable::getTexture()
 }
 
 // PageLoader
-PageLoader::PageLoader(TileDataFile* _tileDataFile, PageIndexer* _indexer, VirtualTextureInfo* _info)
+PageLoader::PageLoader(TileDataFile* _tileDataFile, PageIndexer* _indexer, VirtualTextureInfo* _info, bgfx::TextureFormat::Enum _format)
 	: m_colorMipLevels(false)
 	, m_showBorders(false)
 	, m_tileDataFile(_tileDataFile)
 	, m_indexer(_indexer)
 	, m_info(_info)
+	, m_format(_format)
+	, m_exit(false)
+	, m_completed(VirtualTexture::getAllocator() )
 {
+	m_queue.reserve(m_indexer->getCount() );
+	m_thread.init(threadFunc, this, 0, "vt::PageLoader");
 }
 
-void PageLoader::submit(Page request)
+PageLoader::~PageLoader()
 {
-	ReadState state;
-	state.m_page = request;
-	loadPage(state);
-	onPageLoadComplete(state);
+	{
+		bx::MutexScope scope(m_mutex);
+		m_exit = true;
+	}
+
+	m_sem.post();
+	m_thread.shutdown();
+
+	while (ReadState* state = m_completed.pop() )
+	{
+		BX_DELETE(VirtualTexture::getAllocator(), state);
+	}
+}
+
+void PageLoader::submit(Page request, int count)
+{
+	m_cancelled.erase(request);
+
+	bx::MutexScope scope(m_mutex);
+
+	// Already pending, just update priority
+	for (int i = 0; i < (int)m_queue.size(); ++i)
+	{
+		if (m_queue[i].m_page == request)
+		{
+			if (m_queue[i].m_count != count)
+			{
+				m_queue[i].m_count = count;
+				siftUp(i);
+				siftDown(i);
+			}
+
+			return;
+		}
+	}
+
+	m_queue.push_back(PageCount(request, count) );
+	siftUp((int)m_queue.size() - 1);
+	m_sem.post();
+}
+
+void PageLoader::cancel(Page request)
+{
+	{
+		bx::MutexScope scope(m_mutex);
+
+		for (int i = 0; i < (int)m_queue.size(); ++i)
+		{
+			if (m_queue[i].m_page == request)
+			{
+				removeAt(i);
+				return;
+			}
+		}
+	}
+
+	// Page is either being loaded or waiting in completed queue, result will be discarded
+	m_cancelled.insert(request);
+}
+
+int PageLoader::update(int maxCount)
+{
+	int count = 0;
+
+	while (count < maxCount)
+	{
+		ReadState* state = m_completed.pop();
+		if (NULL == state)
+		{
+			break;
+		}
+
+		auto it = m_cancelled.find(state->m_page);
+		if (it != m_cancelled.end() )
+		{
+			m_cancelled.erase(it);
+		}
+		else
+		{
+			onPageLoadComplete(*state);
+			++count;
+		}
+
+		BX_DELETE(VirtualTexture::getAllocator(), state);
+	}
+
+	return count;
+}
+
+int32_t PageLoader::threadFunc(bx::Thread* _thread, void* _userData)
+{
+	BX_UNUSED(_thread);
+	PageLoader* loader = (PageLoader*)_userData;
+	return loader->run();
+}
+
+int32_t PageLoader::run()
+{
+	for (;;)
+	{
+		m_sem.wait();
+
+		Page page;
+
+		{
+			bx::MutexScope scope(m_mutex);
+
+			if (m_exit)
+			{
+				break;
+			}
+
+			// Request was cancelled before worker got to it
+			if (m_queue.empty() )
+			{
+				continue;
+			}
+
+			page = m_queue[0].m_page;
+			removeAt(0);
+		}
+
+		ReadState* state = BX_NEW(VirtualTexture::getAllocator(), ReadState);
+		state->m_page = page;
+		loadPage(*state);
+
+		m_completed.push(state);
+	}
+
+	return 0;
+}
+
+// Heap is ordered by PageCount::compareTo, front is lowest resolution mip with most requests
+void PageLoader::siftUp(int index)
+{
+	while (index > 0)
+	{
+		int parent = (index - 1) / 2;
+		if (m_queue[index].compareTo(m_queue[parent]) >= 0)
+		{
+			break;
+		}
+
+		bx::swap(m_queue[index], m_queue[parent]);
+		index = parent;
+	}
+}
+
+void PageLoader::siftDown(int index)
+{
+	int size = (int)m_queue.size();
+
+	for (;;)
+	{
+		int best  = index;
+		int left  = index * 2 + 1;
+		int right = index * 2 + 2;
+
+		if (left < size && m_queue[left].compareTo(m_queue[best]) < 0)
+		{
+			best = left;
+		}
+
+		if (right < size && m_queue[right].compareTo(m_queue[best]) < 0)
+		{
+			best = right;
+		}
+
+		if (best == index)
+		{
+			break;
+		}
+
+		bx::swap(m_queue[index], m_queue[best]);
+		index = best;
+	}
+}
+
+void PageLoader::removeAt(int index)
+{
+	int last = (int)m_queue.size() - 1;
+	if (index != last)
+	{
+		m_queue[index] = m_queue[last];
+		m_queue.pop_back();
+		siftUp(index);
+		siftDown(index);
+	}
+	else
+	{
+		m_queue.pop_back();
+	}
 }
 
 void PageLoader::loadPage(ReadState& state)
 {
-	int size = m_info->GetPageSize() * m_info->GetPageSize() * s_channelCount;
-	state.m_data.resize(size);
+	int pagesize = m_info->GetPageSize();
+	state.m_data.resize(getPageDataSize(pagesize, m_format));
+
+	// Page is passed as-is when it's stored in upload format and doesn't need to be modified
+	bool passthrough = !m_colorMipLevels && !m_showBorders && m_format == m_info->m_format;
+	if (passthrough)
+	{
+		if (m_tileDataFile != nullptr)
+		{
+			m_tileDataFile->readPage(m_indexer->getIndexFromPage(state.m_page), &state.m_data[0]);
+		}
+
+		return;
+	}
+
+	m_pixels.resize(pagesize * pagesize * s_channelCount);
+	bx::memSet(&m_pixels[0], 0, m_pixels.size() );
 
 	if (m_colorMipLevels)
 	{
-		copyColor(&state.m_data[0], state.m_page);
+		copyColor(&m_pixels[0], state.m_page);
 	}
 	else if (m_tileDataFile != nullptr)
 	{
-		m_tileDataFile->readPage(m_indexer->getIndexFromPage(state.m_page), &state.m_data[0]);
+		if (bgfx::TextureFormat::BC1 == m_info->m_format)
+		{
+			m_fileData.resize(m_info->GetPageDataSize() );
+			m_tileDataFile->readPage(m_indexer->getIndexFromPage(state.m_page), &m_fileData[0]);
+			decodeBc1(&m_fileData[0], pagesize, &m_pixels[0]);
+		}
+		else
+		{
+			m_tileDataFile->readPage(m_indexer->getIndexFromPage(state.m_page), &m_pixels[0]);
+		}
 	}
 
 	if (m_showBorders)
 	{
-		copyBorder(&state.m_data[0]);
+		copyBorder(&m_pixels[0]);
+	}
+
+	if (bgfx::TextureFormat::BC1 == m_format)
+	{
+		encodeBc1(&m_pixels[0], pagesize, &state.m_data[0]);
+	}
+	else
+	{
+		bx::memCopy(&state.m_data[0], &m_pixels[0], m_pixels.size() );
 	}
 }
 
@@ -628,8 +1044,8 @@ bool PageCache::touch(Page page)
 	return false;
 }
 
-// Schedule a load if not already loaded or loading
-bool PageCache::request(Page request, bgfx::ViewId blitViewId)
+// Schedule a load if not already loaded or loading, pages already loading get their priority updated
+bool PageCache::request(Page request, int count, bgfx::ViewId blitViewId)
 {
 	m_blitViewId = blitViewId;
 	if (m_loading.find(request) == m_loading.end())
@@ -637,14 +1053,42 @@ bool PageCache::request(Page request, bgfx::ViewId blitViewId)
 		if (m_lru_used.find(request) == m_lru_used.end())
 		{
 			m_loading.insert(request);
-			m_loader->submit(request);
+			m_loader->submit(request, count);
 			return true;
 		}
 	}
+	else
+	{
+		m_loader->submit(request, count);
+	}
 
 	return false;
 }
 
+// Cancel pending loads, used to drop pages that are no longer visible
+void PageCache::cancelIf(const std::function<bool(Page)>& predicate)
+{
+	m_cancel.clear();
+	for (auto it = m_loading.begin(); it != m_loading.end(); ++it)
+	{
+		if (predicate(*it) )
+		{
+			m_cancel.push_back(*it);
+		}
+	}
+
+	for (auto page : m_cancel)
+	{
+		m_loader->cancel(page);
+		m_loading.erase(page);
+	}
+}
+
+int PageCache::getLoadingCount() const
+{
+	return (int)m_loading.size();
+}
+
 void PageCache::clear()
 {
 	for (auto& lru_page : m_lru)
@@ -658,6 +1102,9 @@ void PageCache::clear()
 	m_lru.clear();
 	m_lru.reserve(m_count * m_count);
 	m_current = 0;
+
+	// Pages in flight were loaded with old settings
+	cancelIf([](Page) { return true; });
 }
 
 void PageCache::loadComplete(Page page, uint8_t* data)
@@ -698,9 +1145,10 @@ void PageCache::loadComplete(Page page, uint8_t* data)
 }
 
 // TextureAtlas
-TextureAtlas::TextureAtlas(VirtualTextureInfo* _info, int _count, int _uploadsperframe)
+TextureAtlas::TextureAtlas(VirtualTextureInfo* _info, bgfx::TextureFormat::Enum _format, int _count, int _uploadsperframe)
 	: m_info(_info)
-	, m_stagingPool(_info->GetPageSize(), _info->GetPageSize(), _uploadsperframe, false)
+	, m_stagingPool(_info->GetPageSize(), _info->GetPageSize(), _uploadsperframe, false, _format)
+	, m_format(_format)
 {
 	// Create atlas texture
 	int pagesize = m_info->GetPageSize();
@@ -711,8 +1159,8 @@ TextureAtlas::TextureAtlas(VirtualTextureInfo* _info, int _count, int _uploadspe
 		, (uint16_t)size
 		, false
 		, 1
-		, bgfx::TextureFormat::BGRA8
-		, BGFX_SAMPLER_UVW_CLAMP
+		, m_format
+		, BGFX_SAMPLER_UVW_CLAMP | BGFX_TEXTURE_BLIT_DST
 		);
 }
 
@@ -742,7 +1190,7 @@ void TextureAtlas::uploadPage(Point pt, uint8_t* data, bgfx::ViewId blitViewId)
 		, 0
 		, pagesize
 		, pagesize
-		, bgfx::copy(data, pagesize * pagesize * s_channelCount)
+		, bgfx::copy(data, getPageDataSize(pagesize, m_format) )
 		);
 
 	// Copy the texture part to the actual atlas texture
@@ -890,9 +1338,16 @@ VirtualTexture::VirtualTexture(TileDataFile* _tileDataFile, VirtualTextureInfo*
 	m_indexer = BX_NEW(VirtualTexture::getAllocator(), PageIndexer)(m_info);
 	m_pagesToLoad.reserve(m_indexer->getCount());
 
+	// Upload pages as stored in tile data file if format is supported, otherwise decode them
+	bgfx::TextureFormat::Enum format = m_info->m_format;
+	if (0 == (bgfx::getCaps()->formats[format] & BGFX_CAPS_FORMAT_TEXTURE_2D) )
+	{
+		format = bgfx::TextureFormat::BGRA8;
+	}
+
 	// Setup classes
-	m_atlas = BX_NEW(VirtualTexture::getAllocator(), TextureAtlas)(m_info, m_atlasCount, m_uploadsPerFrame);
-	m_loader = BX_NEW(VirtualTexture::getAllocator(), PageLoader)(m_tileDataFile, m_indexer, m_info);
+	m_atlas = BX_NEW(VirtualTexture::getAllocator(), TextureAtlas)(m_info, format, m_atlasCount, m_uploadsPerFrame);
+	m_loader = BX_NEW(VirtualTexture::getAllocator(), PageLoader)(m_tileDataFile, m_indexer, m_info, format);
 	m_cache = BX_NEW(VirtualTexture::getAllocator(), PageCache)(m_atlas, m_loader, m_atlasCount);
 	m_pageTable = BX_NEW(VirtualTexture::getAllocator(), PageTable)(m_cache, m_info, m_indexer);
 
@@ -1029,6 +1484,12 @@ void VirtualTexture::update(const tinystl::vector<int>& requests, bgfx::ViewId b
 {
 	m_pagesToLoad.clear();
 
+	// Upload pages loaded since last update
+	m_loader->update(m_uploadsPerFrame);
+
+	// Cancel loading of pages that are not visible anymore
+	m_cache->cancelIf([&](Page page) { return 0 == requests[m_indexer->getIndexFromPage(page)]; });
+
 	// Find out what is already in memory
 	// If it is, update it's position in the LRU collection
 	// Otherwise add it to the list of pages to load
@@ -1063,10 +1524,14 @@ void VirtualTexture::update(const tinystl::vector<int>& requests, bgfx::ViewId b
 			return lhs.compareTo(rhs);
 		});
 
-		// if more pages than will fit in memory or more than update per frame drop high res pages with lowest use count
-		int loadcount = bx::min(bx::min((int)m_pagesToLoad.size(), m_uploadsPerFrame), m_atlasCount * m_atlasCount);
-		for (int i = 0; i < loadcount; ++i)
-			m_cache->request(m_pagesToLoad[i].m_page, blitViewId);
+		// if more pages than will fit in memory drop high res pages with lowest use count
+		// Loader keeps limited number of pages in flight, the rest are requested again in one of the next frames
+		int loadcount = bx::min((int)m_pagesToLoad.size(), m_atlasCount * m_atlasCount);
+		int maxInFlight = bx::max(1, m_uploadsPerFrame) * s_pagesInFlightPerUpload;
+		for (int i = 0; i < loadcount && m_cache->getLoadingCount() < maxInFlight; ++i)
+		{
+			m_cache->request(m_pagesToLoad[i].m_page, m_pagesToLoad[i].m_count, blitViewId);
+		}
 	}
 	else
 	{
@@ -1091,58 +1556,294 @@ bx::AllocatorI* VirtualTexture::getAllocator()
 	return s_allocator;
 }
 
-TileDataFile::TileDataFile(const bx::FilePath& filename, VirtualTextureInfo* _info, bool _readWrite) : m_info(_info)
+static int fileSeek(FILE* _file, int64_t _offset, int _origin)
+{
+#if BX_CRT_MSVC
+	return _fseeki64(_file, _offset, _origin);
+#else
+	return fseeko(_file, off_t(_offset), _origin);
+#endif // BX_CRT_MSVC
+}
+
+static int64_t fileTell(FILE* _file)
+{
+#if BX_CRT_MSVC
+	return _ftelli64(_file);
+#else
+	return int64_t(ftello(_file) );
+#endif // BX_CRT_MSVC
+}
+
+TileDataFile::TileDataFile(const bx::FilePath& filename, VirtualTextureInfo* _info, bool _readWrite)
+	: m_info(_info)
+	, m_readWrite(_readWrite)
+	, m_mapped(nullptr)
+	, m_mappedSize(0)
+	, m_mapping(nullptr)
 {
 	const char* access = _readWrite ? "w+b" : "rb";
 	m_file = fopen(filename.getCPtr(), access);
-	m_size = m_info->GetPageSize() * m_info->GetPageSize() * s_channelCount;
+	m_size = m_info->GetPageDataSize();
+
+	if (m_readWrite)
+	{
+		// All pages have the same size, so their location is known upfront
+		PageIndexer indexer(m_info);
+		m_index.resize(indexer.getCount() );
+
+		uint64_t offset = sizeof(Header) + m_index.size() * sizeof(IndexEntry);
+		for (auto& entry : m_index)
+		{
+			entry.m_offset   = offset;
+			entry.m_size     = uint32_t(m_size);
+			entry.m_reserved = 0;
+			offset += m_size;
+		}
+	}
+	else
+	{
+		map();
+	}
 }
 
 TileDataFile::~TileDataFile()
 {
-	fclose(m_file);
+	unmap();
+
+	if (nullptr != m_file)
+	{
+		fclose(m_file);
+	}
 }
 
-void TileDataFile::readInfo()
+bool TileDataFile::isValid() const
 {
-	fseek(m_file, 0, SEEK_SET);
-	auto ret = fread(m_info, sizeof(*m_info), 1, m_file);
-	BX_UNUSED(ret);
-	m_size = m_info->GetPageSize() * m_info->GetPageSize() * s_channelCount;
+	return nullptr != m_file;
+}
+
+void TileDataFile::map()
+{
+	if (nullptr == m_file)
+	{
+		return;
+	}
+
+	fileSeek(m_file, 0, SEEK_END);
+	int64_t size = fileTell(m_file);
+	fileSeek(m_file, 0, SEEK_SET);
+
+	if (0 >= size)
+	{
+		return;
+	}
+
+#if BX_PLATFORM_WINDOWS
+	HANDLE file = (HANDLE)_get_osfhandle(_fileno(m_file) );
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (NULL != mapping)
+	{
+		m_mapped = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (nullptr == m_mapped)
+		{
+			CloseHandle(mapping);
+			return;
+		}
+
+		m_mapping = mapping;
+	}
+#elif BX_PLATFORM_LINUX || BX_PLATFORM_OSX || BX_PLATFORM_BSD || BX_PLATFORM_ANDROID || BX_PLATFORM_IOS
+	void* ptr = mmap(NULL, size_t(size), PROT_READ, MAP_SHARED, fileno(m_file), 0);
+	if (MAP_FAILED != ptr)
+	{
+		m_mapped = (const uint8_t*)ptr;
+	}
+#endif // BX_PLATFORM_*
+
+	if (nullptr != m_mapped)
+	{
+		m_mappedSize = size;
+	}
+	else
+	{
+		bx::debugPrintf("Failed to memory-map tile data file, falling back to file reads.\n");
+	}
+}
+
+void TileDataFile::unmap()
+{
+	if (nullptr == m_mapped)
+	{
+		return;
+	}
+
+#if BX_PLATFORM_WINDOWS
+	UnmapViewOfFile(m_mapped);
+	CloseHandle( (HANDLE)m_mapping);
+#elif BX_PLATFORM_LINUX || BX_PLATFORM_OSX || BX_PLATFORM_BSD || BX_PLATFORM_ANDROID || BX_PLATFORM_IOS
+	munmap(const_cast<uint8_t*>(m_mapped), size_t(m_mappedSize) );
+#endif // BX_PLATFORM_*
+
+	m_mapped = nullptr;
+	m_mapping = nullptr;
+	m_mappedSize = 0;
+}
+
+bool TileDataFile::readInfo()
+{
+	if (nullptr == m_file)
+	{
+		return false;
+	}
+
+	Header header;
+
+	if (nullptr != m_mapped)
+	{
+		if (m_mappedSize < int64_t(sizeof(header) ) )
+		{
+			return false;
+		}
+
+		bx::memCopy(&header, m_mapped, sizeof(header) );
+	}
+	else
+	{
+		bx::MutexScope scope(m_mutex);
+		fileSeek(m_file, 0, SEEK_SET);
+		if (1 != fread(&header, sizeof(header), 1, m_file) )
+		{
+			return false;
+		}
+	}
+
+	if (s_tileFileMagic != header.m_magic)
+	{
+		bx::debugPrintf("Invalid tile data file.\n");
+		return false;
+	}
+
+	*m_info = header.m_info;
+	m_size = m_info->GetPageDataSize();
+
+	m_index.resize(header.m_pageCount);
+	if (0 == header.m_pageCount)
+	{
+		return true;
+	}
+
+	uint32_t indexSize = header.m_pageCount * sizeof(IndexEntry);
+
+	if (nullptr != m_mapped)
+	{
+		if (m_mappedSize < int64_t(sizeof(header) + indexSize) )
+		{
+			return false;
+		}
+
+		bx::memCopy(&m_index[0], &m_mapped[sizeof(header)], indexSize);
+	}
+	else
+	{
+		bx::MutexScope scope(m_mutex);
+		if (1 != fread(&m_index[0], indexSize, 1, m_file) )
+		{
+			return false;
+		}
+	}
+
+	return true;
 }
 
 void TileDataFile::writeInfo()
 {
-	fseek(m_file, 0, SEEK_SET);
-	auto ret = fwrite(m_info, sizeof(*m_info), 1, m_file);
+	Header header;
+	header.m_magic     = s_tileFileMagic;
+	header.m_info      = *m_info;
+	header.m_pageCount = uint32_t(m_index.size() );
+
+	bx::MutexScope scope(m_mutex);
+	fileSeek(m_file, 0, SEEK_SET);
+	auto ret = fwrite(&header, sizeof(header), 1, m_file);
+	if (!m_index.empty() )
+	{
+		ret = fwrite(&m_index[0], m_index.size() * sizeof(IndexEntry), 1, m_file);
+	}
 	BX_UNUSED(ret);
 }
 
 void TileDataFile::readPage(int index, uint8_t* data)
 {
-	fseek(m_file, m_size * index + s_tileFileDataOffset, SEEK_SET);
-	auto ret = fread(data, m_size, 1, m_file);
+	if (index < 0 || index >= (int)m_index.size() )
+	{
+		return;
+	}
+
+	const IndexEntry& entry = m_index[index];
+	uint32_t size = bx::min(entry.m_size, uint32_t(m_size) );
+
+	if (nullptr != m_mapped)
+	{
+		if (int64_t(entry.m_offset + size) <= m_mappedSize)
+		{
+			bx::memCopy(data, &m_mapped[entry.m_offset], size);
+		}
+
+		return;
+	}
+
+	bx::MutexScope scope(m_mutex);
+	fileSeek(m_file, int64_t(entry.m_offset), SEEK_SET);
+	auto ret = fread(data, size, 1, m_file);
 	BX_UNUSED(ret);
 }
 
 void TileDataFile::writePage(int index, uint8_t* data)
 {
-	fseek(m_file, m_size * index + s_tileFileDataOffset, SEEK_SET);
-	auto ret = fwrite(data, m_size, 1, m_file);
+	if (index < 0 || index >= (int)m_index.size() )
+	{
+		return;
+	}
+
+	const IndexEntry& entry = m_index[index];
+
+	bx::MutexScope scope(m_mutex);
+	fileSeek(m_file, int64_t(entry.m_offset), SEEK_SET);
+	auto ret = fwrite(data, entry.m_size, 1, m_file);
 	BX_UNUSED(ret);
 }
 
 // TileGenerator
+TileGenerator::Worker::Worker(TileGenerator* _generator)
+	: m_generator(_generator)
+{
+	int pagesize = _generator->m_pagesize;
+	int tilesize = _generator->m_tilesize;
+
+	m_page1Image  = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(pagesize, pagesize, s_channelCount, 0xff);
+	m_page2Image  = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(pagesize, pagesize, s_channelCount, 0xff);
+	m_2xtileImage = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(tilesize * 2, tilesize * 2, s_channelCount, 0xff);
+	m_4xtileImage = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(tilesize * 4, tilesize * 4, s_channelCount, 0xff);
+
+	m_compressed.resize(_generator->m_info->GetPageDataSize() );
+}
+
+TileGenerator::Worker::~Worker()
+{
+	BX_DELETE(VirtualTexture::getAllocator(), m_page1Image);
+	BX_DELETE(VirtualTexture::getAllocator(), m_page2Image);
+	BX_DELETE(VirtualTexture::getAllocator(), m_2xtileImage);
+	BX_DELETE(VirtualTexture::getAllocator(), m_4xtileImage);
+}
+
 TileGenerator::TileGenerator(VirtualTextureInfo* _info)
 	: m_info(_info)
 	, m_indexer(nullptr)
 	, m_tileDataFile(nullptr)
+	, m_rawDataFile(nullptr)
+	, m_mip(0)
+	, m_count(0)
+	, m_next(0)
 	, m_sourceImage(nullptr)
-	, m_page1Image(nullptr)
-	, m_page2Image(nullptr)
-	, m_2xtileImage(nullptr)
-	, m_4xtileImage(nullptr)
-	, m_tileImage(nullptr)
 {
 	m_tilesize = m_info->m_tileSize;
 	m_pagesize = m_info->GetPageSize();
@@ -1157,11 +1858,49 @@ TileGenerator::~TileGenerator()
 
 	BX_DELETE(VirtualTexture::getAllocator(), m_indexer);
 
-	BX_DELETE(VirtualTexture::getAllocator(), m_page1Image);
-	BX_DELETE(VirtualTexture::getAllocator(), m_page2Image);
-	BX_DELETE(VirtualTexture::getAllocator(), m_2xtileImage);
-	BX_DELETE(VirtualTexture::getAllocator(), m_4xtileImage);
-	BX_DELETE(VirtualTexture::getAllocator(), m_tileImage);
+	for (auto worker : m_workers)
+	{
+		BX_DELETE(VirtualTexture::getAllocator(), worker);
+	}
+}
+
+int32_t TileGenerator::threadFunc(bx::Thread* _thread, void* _userData)
+{
+	BX_UNUSED(_thread);
+	Worker* worker = (Worker*)_userData;
+	worker->m_generator->generatePages(*worker);
+	return 0;
+}
+
+void TileGenerator::generatePages(Worker& worker)
+{
+	int total = m_count * m_count;
+
+	for (;;)
+	{
+		int32_t idx = bx::atomicFetchAndAdd<int32_t>(&m_next, 1);
+		if (idx >= total)
+		{
+			break;
+		}
+
+		Page page = { idx % m_count, idx / m_count, m_mip };
+		int index = m_indexer->getIndexFromPage(page);
+		uint8_t* data = &worker.m_page1Image->m_data[0];
+
+		CopyTile(worker, *worker.m_page1Image, page);
+
+		if (m_rawDataFile != m_tileDataFile)
+		{
+			m_rawDataFile->writePage(index, data);
+			encodeBc1(data, m_pagesize, &worker.m_compressed[0]);
+			m_tileDataFile->writePage(index, &worker.m_compressed[0]);
+		}
+		else
+		{
+			m_tileDataFile->writePage(index, data);
+		}
+	}
 }
 
 bool TileGenerator::generate(const bx::FilePath& _filePath)
@@ -1177,13 +1916,12 @@ bool TileGenerator::generate(const bx::FilePath& _filePath)
 
 	// Check if tile file already exist
 	{
-		bx::Error err;
-		bx::FileReader fileReader;
+		VirtualTextureInfo info = *m_info;
+		TileDataFile tileDataFile(cacheFilePath, &info);
 
-		if (bx::open(&fileReader, cacheFilePath, &err) )
+		if (tileDataFile.isValid()
+		&&  tileDataFile.readInfo() )
 		{
-			bx::close(&fileReader);
-
 			bx::debugPrintf("Tile data file '%s' already exists. Skipping generation.\n", cacheFilePath.getCPtr() );
 			return true;
 		}
@@ -1234,46 +1972,86 @@ bool TileGenerator::generate(const bx::FilePath& _filePath)
 
 	// Setup
 	m_info->m_virtualTextureSize = int(m_sourceImage->m_width);
+
+	if (bgfx::TextureFormat::BC1 != m_info->m_format)
+	{
+		m_info->m_format = bgfx::TextureFormat::BGRA8;
+	}
+	else if (0 != m_pagesize % 4)
+	{
+		bx::debugPrintf("Page size %d is not multiple of 4, storing uncompressed pages.\n", m_pagesize);
+		m_info->m_format = bgfx::TextureFormat::BGRA8;
+	}
+
 	m_indexer = BX_NEW(VirtualTexture::getAllocator(), PageIndexer)(m_info);
 
 	// Open tile data file
 	m_tileDataFile = BX_NEW(VirtualTexture::getAllocator(), TileDataFile)(cacheFilePath, m_info, true);
-	m_page1Image   = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_pagesize, m_pagesize, s_channelCount, 0xff);
-	m_page2Image   = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_pagesize, m_pagesize, s_channelCount, 0xff);
-	m_tileImage    = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_tilesize, m_tilesize, s_channelCount, 0xff);
-	m_2xtileImage  = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_tilesize * 2, m_tilesize * 2, s_channelCount, 0xff);
-	m_4xtileImage  = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_tilesize * 4, m_tilesize * 4, s_channelCount, 0xff);
+
+	// Mip levels are generated from uncompressed pages of previous level
+	bx::snprintf(tmp, sizeof(tmp), "%.*s.vt.raw", baseName.getLength(), baseName.getPtr() );
+
+	bx::FilePath rawFilePath("temp");
+	rawFilePath.join(tmp);
+
+	if (bgfx::TextureFormat::BGRA8 != m_info->m_format)
+	{
+		m_rawInfo = *m_info;
+		m_rawInfo.m_format = bgfx::TextureFormat::BGRA8;
+		m_rawDataFile = BX_NEW(VirtualTexture::getAllocator(), TileDataFile)(rawFilePath, &m_rawInfo, true);
+	}
+	else
+	{
+		m_rawDataFile = m_tileDataFile;
+	}
+
+	// Setup workers
+	int numThreads = bx::max(1, (int)std::thread::hardware_concurrency() );
+	for (int i = 0; i < numThreads; ++i)
+	{
+		m_workers.push_back(BX_NEW(VirtualTexture::getAllocator(), Worker)(this) );
+	}
 
 	// Generate tiles
-	bx::debugPrintf("Generating tiles\n");
+	bx::debugPrintf("Generating tiles on %d threads\n", numThreads);
 	auto mipcount = m_indexer->getMipCount();
 	for (int i = 0; i < mipcount; ++i)
 	{
-		int count = (m_info->m_virtualTextureSize / m_tilesize) >> i;
-		bx::debugPrintf("Generating Mip:%d Count:%dx%d\n", i, count, count);
-		for (int y = 0; y < count; ++y)
+		m_mip = i;
+		m_count = (m_info->m_virtualTextureSize / m_tilesize) >> i;
+		m_next = 0;
+
+		bx::debugPrintf("Generating Mip:%d Count:%dx%d\n", i, m_count, m_count);
+
+		for (auto worker : m_workers)
 		{
-			for (int x = 0; x < count; ++x)
-			{
-				Page page = { x, y, i };
-				int index = m_indexer->getIndexFromPage(page);
-				CopyTile(*m_page1Image, page);
-				m_tileDataFile->writePage(index, &m_page1Image->m_data[0]);
-			}
+			worker->m_thread.init(threadFunc, worker, 0, "vt::TileGenerator");
+		}
+
+		// Next mip level reads pages of this one, wait for all of them to be written
+		for (auto worker : m_workers)
+		{
+			worker->m_thread.shutdown();
 		}
 	}
 
 	bx::debugPrintf("Finising\n");
 	// Write header
 	m_tileDataFile->writeInfo();
-	// Close tile file
+	// Close tile files
+	if (m_rawDataFile != m_tileDataFile)
+	{
+		BX_DELETE(VirtualTexture::getAllocator(), m_rawDataFile);
+		remove(rawFilePath.getCPtr() );
+	}
+	m_rawDataFile = nullptr;
 	BX_DELETE(VirtualTexture::getAllocator(), m_tileDataFile);
 	m_tileDataFile = nullptr;
 	bx::debugPrintf("Done!\n");
 	return true;
 }
 
-void TileGenerator::CopyTile(SimpleImage& image, Page request)
+void TileGenerator::CopyTile(Worker& worker, SimpleImage& image, Page request)
 {
 	if (request.m_mip == 0)
 	{
@@ -1302,7 +2080,7 @@ void TileGenerator::CopyTile(SimpleImage& image, Page request)
 
 		int size = m_info->GetPageTableSize() >> mip;
 
-		m_4xtileImage->clear((uint8_t)request.m_mip);
+		worker.m_4xtileImage->clear((uint8_t)request.m_mip);
 
 		for (int y = 0; y < 4; ++y)
 		{
@@ -1314,19 +2092,19 @@ void TileGenerator::CopyTile(SimpleImage& image, Page request)
 				page.m_x = (int)bx::mod((float)page.m_x, (float)size);
 				page.m_y = (int)bx::mod((float)page.m_y, (float)size);
 
-				m_tileDataFile->readPage(m_indexer->getIndexFromPage(page), &m_page2Image->m_data[0]);
+				m_rawDataFile->readPage(m_indexer->getIndexFromPage(page), &worker.m_page2Image->m_data[0]);
 
 				Rect src_rect = { m_info->m_borderSize, m_info->m_borderSize, m_tilesize, m_tilesize };
 				Point dst_offset = { x * m_tilesize, y * m_tilesize };
 
-				m_4xtileImage->copy(dst_offset, *m_page2Image, src_rect);
+				worker.m_4xtileImage->copy(dst_offset, *worker.m_page2Image, src_rect);
 			}
 		}
 
-		SimpleImage::mipmap(&m_4xtileImage->m_data[0], m_4xtileImage->m_width, s_channelCount, &m_2xtileImage->m_data[0]);
+		SimpleImage::mipmap(&worker.m_4xtileImage->m_data[0], worker.m_4xtileImage->m_width, s_channelCount, &worker.m_2xtileImage->m_data[0]);
 
 		Rect srect = { m_tilesize / 2 - m_info->m_borderSize, m_tilesize / 2 - m_info->m_borderSize, m_pagesize, m_pagesize };
-		image.copy({ 0,0 }, *m_2xtileImage, srect);
+		image.copy({ 0,0 }, *worker.m_2xtileImage, srect);
 	}
 }
 
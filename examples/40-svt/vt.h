@@ -16,6 +16,10 @@
 #pragma once
 
 #include <bimg/decode.h>
+#include <bx/mutex.h>
+#include <bx/semaphore.h>
+#include <bx/spscqueue.h>
+#include <bx/thread.h>
 #include <tinystl/allocator.h>
 #include <tinystl/unordered_set.h>
 #include <tinystl/vector.h>
@@ -104,17 +108,22 @@ struct VirtualTextureInfo
 	VirtualTextureInfo();
 	int GetPageSize() const;
 	int GetPageTableSize() const;
+	int GetPageDataSize() const;
 
 	int m_virtualTextureSize = 0;
 	int m_tileSize = 0;
 	int m_borderSize = 0;
+
+	// Format of pages stored in tile data file, BGRA8 or BC1. Block compressed pages
+	// require page size (tile size + 2 * border size) to be multiple of 4.
+	bgfx::TextureFormat::Enum m_format = bgfx::TextureFormat::BGRA8;
 };
 
 // StagingPool
 class StagingPool
 {
 public:
-	StagingPool(int _width, int _height, int _count, bool _readBack);
+	StagingPool(int _width, int _height, int _count, bool _readBack, bgfx::TextureFormat::Enum _format = bgfx::TextureFormat::BGRA8);
 	~StagingPool();
 
 	void grow(int count);
@@ -129,6 +138,8 @@ private:
 	int			m_width;
 	int			m_height;
 	uint64_t	m_flags;
+
+	bgfx::TextureFormat::Enum m_format;
 };
 
 // PageIndexer
@@ -215,6 +226,10 @@ private:
 };
 
 // PageLoader
+// Pages are loaded on worker thread. Requests are kept in priority queue ordered by mip level
+// (low resolution first) and feedback count, and can be cancelled while pending or in flight.
+// Completed pages are handed back to main thread through lock-free queue, and delivered by
+// calling update.
 class PageLoader
 {
 public:
@@ -224,8 +239,13 @@ public:
 		tinystl::vector<uint8_t>	m_data;
 	};
 
-	PageLoader(TileDataFile* _tileDataFile, PageIndexer* _indexer, VirtualTextureInfo* _info);
-	void submit(Page request);
+	PageLoader(TileDataFile* _tileDataFile, PageIndexer* _indexer, VirtualTextureInfo* _info, bgfx::TextureFormat::Enum _format);
+	~PageLoader();
+
+	void submit(Page request, int count);
+	void cancel(Page request);
+	int  update(int maxCount);
+
 	void loadPage(ReadState& state);
 	void onPageLoadComplete(ReadState& state);
 	void copyBorder(uint8_t* image);
@@ -237,9 +257,30 @@ public:
 	bool m_showBorders;
 
 private:
+	static int32_t threadFunc(bx::Thread* _thread, void* _userData);
+	int32_t run();
+
+	void siftUp(int index);
+	void siftDown(int index);
+	void removeAt(int index);
+
 	TileDataFile*		m_tileDataFile;
 	PageIndexer*        m_indexer;
 	VirtualTextureInfo* m_info;
+
+	bgfx::TextureFormat::Enum	m_format; // Format of pages handed to loadComplete
+	tinystl::vector<uint8_t>	m_pixels; // Worker thread scratch for decoded page
+	tinystl::vector<uint8_t>	m_fileData; // Worker thread scratch for page read from file
+
+	bx::Thread		m_thread;
+	bx::Semaphore	m_sem;
+	bx::Mutex		m_mutex;
+	bool			m_exit;
+
+	tinystl::vector<PageCount>		m_queue; // Binary heap of pending requests, guarded by m_mutex
+	tinystl::unordered_set<Page>	m_cancelled; // Pages cancelled while in flight, main thread only
+
+	bx::SpScUnboundedQueueT<ReadState> m_completed;
 };
 
 // PageCache
@@ -248,7 +289,9 @@ class PageCache
 public:
 	PageCache(TextureAtlas* _atlas, PageLoader* _loader, int _count);
 	bool touch(Page page);
-	bool request(Page request, bgfx::ViewId blitViewId);
+	bool request(Page request, int count, bgfx::ViewId blitViewId);
+	void cancelIf(const std::function<bool(Page)>& predicate);
+	int  getLoadingCount() const;
 	void clear();
 	void loadComplete(Page page, uint8_t* data);
 
@@ -278,6 +321,7 @@ private:
 	tinystl::unordered_set<Page>    m_lru_used;
 	tinystl::vector<LruPage>		m_lru;
 	tinystl::unordered_set<Page>	m_loading;
+	tinystl::vector<Page>			m_cancel;
 
 	bgfx::ViewId m_blitViewId;
 };
@@ -286,7 +330,7 @@ private:
 class TextureAtlas
 {
 public:
-	TextureAtlas(VirtualTextureInfo* _info, int count, int uploadsperframe);
+	TextureAtlas(VirtualTextureInfo* _info, bgfx::TextureFormat::Enum _format, int count, int uploadsperframe);
 	~TextureAtlas();
 
 	void setUploadsPerFrame(int count);
@@ -298,6 +342,8 @@ private:
 	VirtualTextureInfo*  m_info;
 	bgfx::TextureHandle  m_texture;
 	StagingPool          m_stagingPool;
+
+	bgfx::TextureFormat::Enum m_format;
 };
 
 // FeedbackBuffer
@@ -393,25 +439,58 @@ private:
 };
 
 // TileDataFile
+// File starts with header, followed by index with offset and size of every page, so that
+// page can be read with single read. Page data is stored in format from VirtualTextureInfo.
 class TileDataFile
 {
 public:
 	TileDataFile(const bx::FilePath& filename, VirtualTextureInfo* _info, bool _readWrite = false);
 	~TileDataFile();
 
-	void readInfo();
+	bool isValid() const;
+
+	bool readInfo();
 	void writeInfo();
 
+	// Thread safe. Read-only files are memory-mapped, and pages are copied out of mapping.
 	void readPage(int index, uint8_t* data);
 	void writePage(int index, uint8_t* data);
 
 private:
+	struct Header
+	{
+		uint32_t			m_magic;
+		VirtualTextureInfo	m_info;
+		uint32_t			m_pageCount;
+	};
+
+	struct IndexEntry
+	{
+		uint64_t m_offset;
+		uint32_t m_size;
+		uint32_t m_reserved;
+	};
+
+	void map();
+	void unmap();
+
 	VirtualTextureInfo*	m_info;
 	int					m_size;
 	FILE*				m_file;
+	bool				m_readWrite;
+
+	tinystl::vector<IndexEntry> m_index;
+
+	const uint8_t*		m_mapped;
+	int64_t				m_mappedSize;
+	void*				m_mapping;
+	bx::Mutex			m_mutex;
 };
 
 // TileGenerator
+// Pages of each mip level are generated in parallel on worker threads. Mip levels are built
+// from previous level's uncompressed pages, which are kept in temporary tile data file when
+// output is block compressed.
 class TileGenerator
 {
 public:
@@ -421,23 +500,44 @@ public:
 	bool generate(const bx::FilePath& filename);
 
 private:
-	void CopyTile(SimpleImage& image, Page request);
+	struct Worker
+	{
+		Worker(TileGenerator* _generator);
+		~Worker();
+
+		TileGenerator* m_generator;
+		bx::Thread     m_thread;
+
+		SimpleImage* m_page1Image;
+		SimpleImage* m_page2Image;
+		SimpleImage* m_2xtileImage;
+		SimpleImage* m_4xtileImage;
+
+		tinystl::vector<uint8_t> m_compressed;
+	};
+
+	static int32_t threadFunc(bx::Thread* _thread, void* _userData);
+	void generatePages(Worker& worker);
+	void CopyTile(Worker& worker, SimpleImage& image, Page request);
 
 private:
 	VirtualTextureInfo* m_info;
 	PageIndexer*		m_indexer;
 	TileDataFile*		m_tileDataFile;
+	TileDataFile*		m_rawDataFile;
+
+	VirtualTextureInfo	m_rawInfo;
 
 	int	m_tilesize;
 	int	m_pagesize;
 
+	int		m_mip;
+	int		m_count;
+	int32_t	m_next;
+
 	bimg::ImageContainer*	m_sourceImage;
 
-	SimpleImage* m_page1Image;
-	SimpleImage* m_page2Image;
-	SimpleImage* m_2xtileImage;
-	SimpleImage* m_4xtileImage;
-	SimpleImage* m_tileImage;
+	tinystl::vector<Worker*> m_workers;
 };
 
 } // namespace vt
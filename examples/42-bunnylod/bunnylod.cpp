@@ -118,7 +118,7 @@ public:
 
 				for (uint32_t ii = 0, num = it->m_numIndices; ii < num; ++ii)
 				{
-					ibptr[ii] = it->m_indices[ii] + index;
+					ibptr[ii] = (it->m_index32 ? it->m_indices32[ii] : it->m_indices[ii]) + index;
 				}
 
 				voffset += vsize;
@@ -0,0 +1,282 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+#include "bgfx_utils.h"
+
+#include <bx/cpu.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
+#include "imgui/imgui.h"
+
+namespace
+{
+
+struct PosColorVertex
+{
+	float m_x;
+	float m_y;
+	float m_z;
+	uint32_t m_abgr;
+
+	static void init()
+	{
+		ms_layout
+			.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::Color0,   4, bgfx::AttribType::Uint8, true)
+			.end();
+	}
+
+	static bgfx::VertexLayout ms_layout;
+};
+
+bgfx::VertexLayout PosColorVertex::ms_layout;
+
+// Encoder 0 belongs to API thread, and allocation threads take remaining encoders.
+static const uint32_t kNumAllocThreads    = 15;
+static const uint32_t kNumAllocsPerThread = 1024;
+
+int32_t allocThreadFunc(bx::Thread* _thread, void* _userData);
+
+class ExampleTransientAlloc : public entry::AppI
+{
+public:
+	ExampleTransientAlloc(const char* _name, const char* _description, const char* _url)
+		: entry::AppI(_name, _description, _url)
+	{
+	}
+
+	void init(int32_t _argc, const char* const* _argv, uint32_t _width, uint32_t _height) override
+	{
+		Args args(_argc, _argv);
+
+		m_width  = _width;
+		m_height = _height;
+		m_debug  = BGFX_DEBUG_NONE;
+		m_reset  = BGFX_RESET_NONE;
+
+		m_allocBench     = true;
+		m_allocEncoderMs = 0.0;
+		m_allocSharedMs  = 0.0;
+		m_allocShort     = 0;
+
+		bgfx::Init init;
+		init.type     = args.m_type;
+		init.vendorId = args.m_pciId;
+		init.resolution.width  = m_width;
+		init.resolution.height = m_height;
+		init.resolution.reset  = m_reset;
+		// One encoder for API thread, and one for each allocation thread.
+		init.limits.maxEncoders = 1 + kNumAllocThreads;
+		bgfx::init(init);
+
+		// Enable debug text.
+		bgfx::setDebug(m_debug);
+
+		// Set view 0 clear state.
+		bgfx::setViewClear(0
+			, BGFX_CLEAR_COLOR|BGFX_CLEAR_DEPTH
+			, 0x303030ff
+			, 1.0f
+			, 0
+			);
+
+		// Create vertex stream declaration.
+		PosColorVertex::init();
+
+		// Imgui.
+		imguiCreate();
+
+		for (uint32_t ii = 0; ii < kNumAllocThreads; ++ii)
+		{
+			m_allocThread[ii].init(allocThreadFunc, this);
+		}
+	}
+
+	int shutdown() override
+	{
+		for (uint32_t ii = 0; ii < kNumAllocThreads; ++ii)
+		{
+			m_allocThread[ii].push(reinterpret_cast<void*>(UINTPTR_MAX) );
+			m_allocThread[ii].shutdown();
+		}
+
+		// Cleanup.
+		imguiDestroy();
+
+		// Shutdown bgfx.
+		bgfx::shutdown();
+
+		return 0;
+	}
+
+	int32_t allocThread(bx::Thread* _thread)
+	{
+		for (;;)
+		{
+			union
+			{
+				void* ptr;
+				uintptr_t id;
+
+			} cast;
+
+			cast.ptr = _thread->pop();
+			if (UINTPTR_MAX == cast.id)
+			{
+				break;
+			}
+
+			// Thread with active encoder sub-allocates from encoder's slab without locking,
+			// otherwise every allocation goes through shared locked path.
+			const bool useEncoder = 0 != cast.id;
+			bgfx::Encoder* encoder = useEncoder ? bgfx::begin(true) : NULL;
+
+			for (uint32_t ii = 0; ii < kNumAllocsPerThread; ++ii)
+			{
+				if (1 != bgfx::getAvailInstanceDataBuffer(1, 64) )
+				{
+					break;
+				}
+
+				bgfx::InstanceDataBuffer idb;
+				bgfx::allocInstanceDataBuffer(&idb, 1, 64);
+				bx::memSet(idb.data, 0, idb.size);
+
+				// allocTransientBuffers must return either both buffers in full size, or
+				// nothing, while other threads allocate concurrently.
+				if (0 == (ii & 7) )
+				{
+					bgfx::TransientVertexBuffer tvb;
+					bgfx::TransientIndexBuffer  tib;
+					if (bgfx::allocTransientBuffers(&tvb, PosColorVertex::ms_layout, 4, &tib, 6)
+					&&  (tvb.size != 4*PosColorVertex::ms_layout.getStride() || tib.size != 6*sizeof(uint16_t) ) )
+					{
+						bx::atomicFetchAndAdd<uint32_t>(&m_allocShort, 1);
+					}
+				}
+			}
+
+			if (NULL != encoder)
+			{
+				bgfx::end(encoder);
+			}
+
+			m_allocSync.post();
+		}
+
+		return bx::kExitSuccess;
+	}
+
+	double allocBench(bool _useEncoder)
+	{
+		const int64_t start = bx::getHPCounter();
+
+		for (uint32_t ii = 0; ii < kNumAllocThreads; ++ii)
+		{
+			m_allocThread[ii].push(reinterpret_cast<void*>(uintptr_t(_useEncoder) ) );
+		}
+
+		for (uint32_t ii = 0; ii < kNumAllocThreads; ++ii)
+		{
+			m_allocSync.wait();
+		}
+
+		return double(bx::getHPCounter() - start)*1000.0/double(bx::getHPFrequency() );
+	}
+
+	bool update() override
+	{
+		if (!entry::processEvents(m_width, m_height, m_debug, m_reset, &m_mouseState) )
+		{
+			imguiBeginFrame(m_mouseState.m_mx
+				,  m_mouseState.m_my
+				, (m_mouseState.m_buttons[entry::MouseButton::Left  ] ? IMGUI_MBUT_LEFT   : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Right ] ? IMGUI_MBUT_RIGHT  : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Middle] ? IMGUI_MBUT_MIDDLE : 0)
+				,  m_mouseState.m_mz
+				, uint16_t(m_width)
+				, uint16_t(m_height)
+				);
+
+			showExampleDialog(this);
+
+			ImGui::SetNextWindowPos(
+				  ImVec2((float)m_width - (float)m_width / 4.0f - 10.0f, 10.0f)
+				, ImGuiCond_FirstUseEver
+				);
+			ImGui::SetNextWindowSize(
+				  ImVec2((float)m_width / 4.0f, (float)m_height / 3.0f)
+				, ImGuiCond_FirstUseEver
+				);
+			ImGui::Begin("Settings"
+				, NULL
+				, 0
+				);
+
+			ImGui::Checkbox("Run benchmark", &m_allocBench);
+			ImGui::Text("%d threads x %d allocs", kNumAllocThreads, kNumAllocsPerThread);
+			ImGui::Text("Per encoder %0.6f [ms]", m_allocEncoderMs);
+			ImGui::Text("Shared %0.6f [ms]", m_allocSharedMs);
+			ImGui::Text("Short transient allocs: %d", m_allocShort);
+
+			ImGui::End();
+
+			imguiEndFrame();
+
+			// Set view 0 default viewport.
+			bgfx::setViewRect(0, 0, 0, uint16_t(m_width), uint16_t(m_height) );
+
+			// This dummy draw call is here to make sure that view 0 is cleared
+			// if no other draw calls are submitted to view 0.
+			bgfx::touch(0);
+
+			if (m_allocBench)
+			{
+				m_allocEncoderMs = allocBench(true);
+				m_allocSharedMs  = allocBench(false);
+			}
+
+			// Advance to next frame. Rendering thread will be kicked to
+			// process submitted rendering primitives.
+			bgfx::frame();
+
+			return true;
+		}
+
+		return false;
+	}
+
+	entry::MouseState m_mouseState;
+
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_debug;
+	uint32_t m_reset;
+
+	bool     m_allocBench;
+	double   m_allocEncoderMs;
+	double   m_allocSharedMs;
+	uint32_t m_allocShort;
+
+	bx::Thread m_allocThread[kNumAllocThreads];
+	bx::Semaphore m_allocSync;
+};
+
+int32_t allocThreadFunc(bx::Thread* _thread, void* _userData)
+{
+	ExampleTransientAlloc* self = static_cast<ExampleTransientAlloc*>(_userData);
+	return self->allocThread(_thread);
+}
+
+} // namespace
+
+ENTRY_IMPLEMENT_MAIN(
+	  ExampleTransientAlloc
+	, "43-transientalloc"
+	, "Transient and instance data allocation from multiple threads."
+	, "https://bkaradzic.github.io/bgfx/examples.html#transientalloc"
+	);
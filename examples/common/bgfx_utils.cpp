@@ -96,10 +96,8 @@ static void* loadMem(bx::FileReaderI* _reader, bx::AllocatorI* _allocator, const
 	return NULL;
 }
 
-static bgfx::ShaderHandle loadShader(bx::FileReaderI* _reader, const char* _name)
+const char* getShaderPath()
 {
-	char filePath[512];
-
 	const char* shaderPath = "???";
 
 	switch (bgfx::getRendererType() )
@@ -121,6 +119,15 @@ static bgfx::ShaderHandle loadShader(bx::FileReaderI* _reader, const char* _name
 		break;
 	}
 
+	return shaderPath;
+}
+
+static bgfx::ShaderHandle loadShader(bx::FileReaderI* _reader, const char* _name)
+{
+	char filePath[512];
+
+	const char* shaderPath = getShaderPath();
+
 	bx::strCopy(filePath, BX_COUNTOF(filePath), shaderPath);
 	bx::strCat(filePath, BX_COUNTOF(filePath), _name);
 	bx::strCat(filePath, BX_COUNTOF(filePath), ".bin");
@@ -160,6 +167,86 @@ static void imageReleaseCb(void* _ptr, void* _userData)
 	bimg::imageFree(imageContainer);
 }
 
+bgfx::TextureHandle createTexture(bimg::ImageContainer* _imageContainer, uint64_t _flags, const char* _name, bgfx::TextureInfo* _info)
+{
+	bgfx::TextureHandle handle = BGFX_INVALID_HANDLE;
+
+	const bgfx::TextureFormat::Enum format = bgfx::TextureFormat::Enum(_imageContainer->m_format);
+
+	if (NULL != _info)
+	{
+		bgfx::calcTextureSize(
+			  *_info
+			, uint16_t(_imageContainer->m_width)
+			, uint16_t(_imageContainer->m_height)
+			, uint16_t(_imageContainer->m_depth)
+			, _imageContainer->m_cubeMap
+			, 1 < _imageContainer->m_numMips
+			, _imageContainer->m_numLayers
+			, format
+			);
+	}
+
+	if (!_imageContainer->m_cubeMap
+	&&  1 >= _imageContainer->m_depth
+	&&  !bgfx::isTextureValid(0, false, _imageContainer->m_numLayers, format, _flags) )
+	{
+		bimg::imageFree(_imageContainer);
+		return handle;
+	}
+
+	const bgfx::Memory* mem = bgfx::makeRef(
+			  _imageContainer->m_data
+			, _imageContainer->m_size
+			, imageReleaseCb
+			, _imageContainer
+			);
+
+	if (_imageContainer->m_cubeMap)
+	{
+		handle = bgfx::createTextureCube(
+			  uint16_t(_imageContainer->m_width)
+			, 1 < _imageContainer->m_numMips
+			, _imageContainer->m_numLayers
+			, format
+			, _flags
+			, mem
+			);
+	}
+	else if (1 < _imageContainer->m_depth)
+	{
+		handle = bgfx::createTexture3D(
+			  uint16_t(_imageContainer->m_width)
+			, uint16_t(_imageContainer->m_height)
+			, uint16_t(_imageContainer->m_depth)
+			, 1 < _imageContainer->m_numMips
+			, format
+			, _flags
+			, mem
+			);
+	}
+	else
+	{
+		handle = bgfx::createTexture2D(
+			  uint16_t(_imageContainer->m_width)
+			, uint16_t(_imageContainer->m_height)
+			, 1 < _imageContainer->m_numMips
+			, _imageContainer->m_numLayers
+			, format
+			, _flags
+			, mem
+			);
+	}
+
+	if (bgfx::isValid(handle)
+	&&  NULL != _name)
+	{
+		bgfx::setName(handle, _name);
+	}
+
+	return handle;
+}
+
 bgfx::TextureHandle loadTexture(bx::FileReaderI* _reader, const char* _filePath, uint64_t _flags, uint8_t _skip, bgfx::TextureInfo* _info, bimg::Orientation::Enum* _orientation)
 {
 	BX_UNUSED(_skip);
@@ -170,6 +257,7 @@ bgfx::TextureHandle loadTexture(bx::FileReaderI* _reader, const char* _filePath,
 	if (NULL != data)
 	{
 		bimg::ImageContainer* imageContainer = bimg::imageParse(entry::getAllocator(), data, size);
+		unload(data);
 
 		if (NULL != imageContainer)
 		{
@@ -178,68 +266,7 @@ bgfx::TextureHandle loadTexture(bx::FileReaderI* _reader, const char* _filePath,
 				*_orientation = imageContainer->m_orientation;
 			}
 
-			const bgfx::Memory* mem = bgfx::makeRef(
-					  imageContainer->m_data
-					, imageContainer->m_size
-					, imageReleaseCb
-					, imageContainer
-					);
-			unload(data);
-
-			if (imageContainer->m_cubeMap)
-			{
-				handle = bgfx::createTextureCube(
-					  uint16_t(imageContainer->m_width)
-					, 1 < imageContainer->m_numMips
-					, imageContainer->m_numLayers
-					, bgfx::TextureFormat::Enum(imageContainer->m_format)
-					, _flags
-					, mem
-					);
-			}
-			else if (1 < imageContainer->m_depth)
-			{
-				handle = bgfx::createTexture3D(
-					  uint16_t(imageContainer->m_width)
-					, uint16_t(imageContainer->m_height)
-					, uint16_t(imageContainer->m_depth)
-					, 1 < imageContainer->m_numMips
-					, bgfx::TextureFormat::Enum(imageContainer->m_format)
-					, _flags
-					, mem
-					);
-			}
-			else if (bgfx::isTextureValid(0, false, imageContainer->m_numLayers, bgfx::TextureFormat::Enum(imageContainer->m_format), _flags) )
-			{
-				handle = bgfx::createTexture2D(
-					  uint16_t(imageContainer->m_width)
-					, uint16_t(imageContainer->m_height)
-					, 1 < imageContainer->m_numMips
-					, imageContainer->m_numLayers
-					, bgfx::TextureFormat::Enum(imageContainer->m_format)
-					, _flags
-					, mem
-					);
-			}
-
-			if (bgfx::isValid(handle) )
-			{
-				bgfx::setName(handle, _filePath);
-			}
-
-			if (NULL != _info)
-			{
-				bgfx::calcTextureSize(
-					  *_info
-					, uint16_t(imageContainer->m_width)
-					, uint16_t(imageContainer->m_height)
-					, uint16_t(imageContainer->m_depth)
-					, imageContainer->m_cubeMap
-					, 1 < imageContainer->m_numMips
-					, imageContainer->m_numLayers
-					, bgfx::TextureFormat::Enum(imageContainer->m_format)
-					);
-			}
+			handle = createTexture(imageContainer, _flags, _filePath, _info);
 		}
 	}
 
@@ -371,7 +398,52 @@ void Group::reset()
 	m_vertices = NULL;
 	m_numIndices = 0;
 	m_indices = NULL;
+	m_indices32 = NULL;
+	m_index32 = false;
 	m_prims.clear();
+	m_lodIbh.idx = bgfx::kInvalidHandle;
+	m_lods.clear();
+	m_meshletIbh.idx = bgfx::kInvalidHandle;
+	m_meshlets.clear();
+	m_meshletVertices = NULL;
+	m_meshletTriangles = NULL;
+}
+
+uint32_t Group::selectLod(float _distance, float _threshold) const
+{
+	const float maxError = _distance * _threshold;
+
+	uint32_t lod = 0;
+	for (uint32_t ii = 0, num = uint32_t(m_lods.size() ); ii < num; ++ii)
+	{
+		if (m_lods[ii].m_error > maxError)
+		{
+			break;
+		}
+
+		lod = ii + 1;
+	}
+
+	return lod;
+}
+
+void Group::setLodIndexBuffer(uint32_t _lod) const
+{
+	if (0 == _lod)
+	{
+		bgfx::setIndexBuffer(m_ibh);
+	}
+	else
+	{
+		const MeshLod& lod = m_lods[_lod-1];
+		bgfx::setIndexBuffer(m_lodIbh, lod.m_startIndex, lod.m_numIndices);
+	}
+}
+
+bool isMeshletBackfacing(const Meshlet& _meshlet, const bx::Vec3& _eye)
+{
+	const bx::Vec3 dir = bx::normalize(bx::sub(_meshlet.m_coneApex, _eye) );
+	return bx::dot(dir, _meshlet.m_coneAxis) >= _meshlet.m_coneCutoff;
 }
 
 namespace bgfx
@@ -379,6 +451,35 @@ namespace bgfx
 	int32_t read(bx::ReaderI* _reader, bgfx::VertexLayout& _layout, bx::Error* _err = NULL);
 }
 
+static void readNumVertices(bx::ReaderI* _reader, uint32_t& _numVertices, bool _vertex32)
+{
+	if (_vertex32)
+	{
+		bx::read(_reader, _numVertices);
+	}
+	else
+	{
+		uint16_t numVertices;
+		bx::read(_reader, numVertices);
+		_numVertices = numVertices;
+	}
+}
+
+static void copyIndices(Group& _group, const bgfx::Memory* _mem, bx::AllocatorI* _allocator)
+{
+	void* indices = BX_ALLOC(_allocator, _mem->size);
+	bx::memCopy(indices, _mem->data, _mem->size);
+
+	if (_group.m_index32)
+	{
+		_group.m_indices32 = (uint32_t*)indices;
+	}
+	else
+	{
+		_group.m_indices = (uint16_t*)indices;
+	}
+}
+
 void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 {
 #define BGFX_CHUNK_MAGIC_VB  BX_MAKEFOURCC('V', 'B', ' ', 0x1)
@@ -386,6 +487,12 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 #define BGFX_CHUNK_MAGIC_IB  BX_MAKEFOURCC('I', 'B', ' ', 0x0)
 #define BGFX_CHUNK_MAGIC_IBC BX_MAKEFOURCC('I', 'B', 'C', 0x1)
 #define BGFX_CHUNK_MAGIC_PRI BX_MAKEFOURCC('P', 'R', 'I', 0x0)
+#define BGFX_CHUNK_MAGIC_VB32  BX_MAKEFOURCC('V', 'B', ' ', 0x2)
+#define BGFX_CHUNK_MAGIC_VBC32 BX_MAKEFOURCC('V', 'B', 'C', 0x1)
+#define BGFX_CHUNK_MAGIC_IB32  BX_MAKEFOURCC('I', 'B', ' ', 0x1)
+#define BGFX_CHUNK_MAGIC_IBC32 BX_MAKEFOURCC('I', 'B', 'C', 0x2)
+#define BGFX_CHUNK_MAGIC_LOD BX_MAKEFOURCC('L', 'O', 'D', 0x0)
+#define BGFX_CHUNK_MAGIC_MSH BX_MAKEFOURCC('M', 'S', 'H', 0x0)
 
 	using namespace bx;
 	using namespace bgfx;
@@ -402,6 +509,7 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 		switch (chunk)
 		{
 			case BGFX_CHUNK_MAGIC_VB:
+			case BGFX_CHUNK_MAGIC_VB32:
 			{
 				read(_reader, group.m_sphere);
 				read(_reader, group.m_aabb);
@@ -411,7 +519,7 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 				
 				uint16_t stride = m_layout.getStride();
 				
-				read(_reader, group.m_numVertices);
+				readNumVertices(_reader, group.m_numVertices, BGFX_CHUNK_MAGIC_VB32 == chunk);
 				const bgfx::Memory* mem = bgfx::alloc(group.m_numVertices*stride);
 				read(_reader, mem->data, mem->size);
 				if ( _ramcopy )
@@ -424,6 +532,7 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 				break;
 				
 			case BGFX_CHUNK_MAGIC_VBC:
+			case BGFX_CHUNK_MAGIC_VBC32:
 			{
 				read(_reader, group.m_sphere);
 				read(_reader, group.m_aabb);
@@ -433,7 +542,7 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 				
 				uint16_t stride = m_layout.getStride();
 				
-				read(_reader, group.m_numVertices);
+				readNumVertices(_reader, group.m_numVertices, BGFX_CHUNK_MAGIC_VBC32 == chunk);
 				
 				const bgfx::Memory* mem = bgfx::alloc(group.m_numVertices*stride);
 				
@@ -458,25 +567,32 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 				break;
 				
 			case BGFX_CHUNK_MAGIC_IB:
+			case BGFX_CHUNK_MAGIC_IB32:
 			{
+				group.m_index32 = BGFX_CHUNK_MAGIC_IB32 == chunk;
+				const uint32_t indexSize = group.m_index32 ? 4 : 2;
+
 				read(_reader, group.m_numIndices);
-				const bgfx::Memory* mem = bgfx::alloc(group.m_numIndices*2);
+				const bgfx::Memory* mem = bgfx::alloc(group.m_numIndices*indexSize);
 				read(_reader, mem->data, mem->size);
 				if ( _ramcopy )
 				{
-					group.m_indices = (uint16_t*)BX_ALLOC(allocator, group.m_numIndices*2);
-					bx::memCopy(group.m_indices, mem->data, mem->size);
+					copyIndices(group, mem, allocator);
 				}
 
-				group.m_ibh = bgfx::createIndexBuffer(mem);
+				group.m_ibh = bgfx::createIndexBuffer(mem, group.m_index32 ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE);
 			}
 				break;
 				
 			case BGFX_CHUNK_MAGIC_IBC:
+			case BGFX_CHUNK_MAGIC_IBC32:
 			{
+				group.m_index32 = BGFX_CHUNK_MAGIC_IBC32 == chunk;
+				const uint32_t indexSize = group.m_index32 ? 4 : 2;
+
 				bx::read(_reader, group.m_numIndices);
 				
-				const bgfx::Memory* mem = bgfx::alloc(group.m_numIndices*2);
+				const bgfx::Memory* mem = bgfx::alloc(group.m_numIndices*indexSize);
 				
 				uint32_t compressedSize;
 				bx::read(_reader, compressedSize);
@@ -485,20 +601,139 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 				
 				bx::read(_reader, compressedIndices, compressedSize);
 				
-				meshopt_decodeIndexBuffer(mem->data, group.m_numIndices, 2, (uint8_t*)compressedIndices, compressedSize);
+				meshopt_decodeIndexBuffer(mem->data, group.m_numIndices, indexSize, (uint8_t*)compressedIndices, compressedSize);
 				
 				BX_FREE(allocator, compressedIndices);
 				
 				if ( _ramcopy )
 				{
-					group.m_indices = (uint16_t*)BX_ALLOC(allocator, group.m_numIndices*2);
-					bx::memCopy(group.m_indices, mem->data, mem->size);
+					copyIndices(group, mem, allocator);
 				}
 				
-				group.m_ibh = bgfx::createIndexBuffer(mem);
+				group.m_ibh = bgfx::createIndexBuffer(mem, group.m_index32 ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE);
 			}
 				break;
 				
+			case BGFX_CHUNK_MAGIC_LOD:
+			{
+				const uint32_t indexSize = group.m_index32 ? 4 : 2;
+
+				uint8_t numLods;
+				read(_reader, numLods);
+
+				const int64_t start = bx::seek(_reader);
+
+				uint32_t totalIndices = 0;
+				for (uint32_t ii = 0; ii < numLods; ++ii)
+				{
+					MeshLod lod;
+					read(_reader, lod.m_error);
+					read(_reader, lod.m_numIndices);
+					lod.m_startIndex = totalIndices;
+					totalIndices += lod.m_numIndices;
+					bx::skip(_reader, lod.m_numIndices*indexSize);
+
+					group.m_lods.push_back(lod);
+				}
+
+				if (0 < totalIndices)
+				{
+					bx::seek(_reader, start, bx::Whence::Begin);
+
+					const bgfx::Memory* mem = bgfx::alloc(totalIndices*indexSize);
+					for (uint32_t ii = 0; ii < numLods; ++ii)
+					{
+						const MeshLod& lod = group.m_lods[ii];
+						bx::skip(_reader, sizeof(lod.m_error) + sizeof(lod.m_numIndices) );
+						read(_reader, &mem->data[lod.m_startIndex*indexSize], lod.m_numIndices*indexSize);
+					}
+
+					group.m_lodIbh = bgfx::createIndexBuffer(mem, group.m_index32 ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE);
+				}
+			}
+				break;
+
+			case BGFX_CHUNK_MAGIC_MSH:
+			{
+				uint32_t numMeshlets;
+				read(_reader, numMeshlets);
+
+				group.m_meshlets.resize(numMeshlets);
+				for (uint32_t ii = 0; ii < numMeshlets; ++ii)
+				{
+					Meshlet& meshlet = group.m_meshlets[ii];
+					uint32_t startTriangle;
+					read(_reader, meshlet.m_sphere);
+					read(_reader, meshlet.m_coneApex);
+					read(_reader, meshlet.m_coneAxis);
+					read(_reader, meshlet.m_coneCutoff);
+					read(_reader, meshlet.m_startVertex);
+					read(_reader, startTriangle);
+					read(_reader, meshlet.m_numVertices);
+					read(_reader, meshlet.m_numTriangles);
+					meshlet.m_startIndex = startTriangle*3;
+				}
+
+				uint32_t numVertices;
+				read(_reader, numVertices);
+				uint32_t* vertices = (uint32_t*)BX_ALLOC(allocator, numVertices*4);
+				if (group.m_index32)
+				{
+					read(_reader, vertices, numVertices*4);
+				}
+				else
+				{
+					for (uint32_t ii = 0; ii < numVertices; ++ii)
+					{
+						uint16_t vertex;
+						read(_reader, vertex);
+						vertices[ii] = vertex;
+					}
+				}
+
+				uint32_t numTriangles;
+				read(_reader, numTriangles);
+				uint8_t* triangles = (uint8_t*)BX_ALLOC(allocator, numTriangles*3);
+				read(_reader, triangles, numTriangles*3);
+
+				// Expand meshlet local triangles into group index buffer, so meshlets can
+				// be drawn as index ranges after culling.
+				const uint32_t indexSize = group.m_index32 ? 4 : 2;
+				const bgfx::Memory* mem = bgfx::alloc(numTriangles*3*indexSize);
+				for (uint32_t ii = 0; ii < numMeshlets; ++ii)
+				{
+					const Meshlet& meshlet = group.m_meshlets[ii];
+					const uint32_t* meshletVertices = &vertices[meshlet.m_startVertex];
+					for (uint32_t jj = 0, num = meshlet.m_numTriangles*3; jj < num; ++jj)
+					{
+						const uint32_t idx = meshlet.m_startIndex + jj;
+						const uint32_t index = meshletVertices[triangles[idx] ];
+						if (group.m_index32)
+						{
+							( (uint32_t*)mem->data)[idx] = index;
+						}
+						else
+						{
+							( (uint16_t*)mem->data)[idx] = uint16_t(index);
+						}
+					}
+				}
+
+				group.m_meshletIbh = bgfx::createIndexBuffer(mem, group.m_index32 ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE);
+
+				if (_ramcopy)
+				{
+					group.m_meshletVertices  = vertices;
+					group.m_meshletTriangles = triangles;
+				}
+				else
+				{
+					BX_FREE(allocator, vertices);
+					BX_FREE(allocator, triangles);
+				}
+			}
+				break;
+
 			case BGFX_CHUNK_MAGIC_PRI:
 			{
 				uint16_t len;
@@ -566,6 +801,31 @@ void Mesh::unload()
 		{
 			BX_FREE(allocator, group.m_indices);
 		}
+
+		if (NULL != group.m_indices32)
+		{
+			BX_FREE(allocator, group.m_indices32);
+		}
+
+		if (bgfx::isValid(group.m_lodIbh) )
+		{
+			bgfx::destroy(group.m_lodIbh);
+		}
+
+		if (bgfx::isValid(group.m_meshletIbh) )
+		{
+			bgfx::destroy(group.m_meshletIbh);
+		}
+
+		if (NULL != group.m_meshletVertices)
+		{
+			BX_FREE(allocator, group.m_meshletVertices);
+		}
+
+		if (NULL != group.m_meshletTriangles)
+		{
+			BX_FREE(allocator, group.m_meshletTriangles);
+		}
 	}
 	m_groups.clear();
 }
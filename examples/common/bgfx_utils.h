@@ -22,12 +22,20 @@ void* load(const char* _filePath, uint32_t* _size = NULL);
 ///
 void unload(void* _ptr);
 
+/// Returns renderer specific shader directory, e.g. "shaders/dx11/".
+const char* getShaderPath();
+
 ///
 bgfx::ShaderHandle loadShader(const char* _name);
 
 ///
 bgfx::ProgramHandle loadProgram(const char* _vsName, const char* _fsName);
 
+/// Creates texture from image container. Ownership of image container is passed to
+/// function, and it's released once texture data is uploaded, or immediately if
+/// texture can't be created.
+bgfx::TextureHandle createTexture(bimg::ImageContainer* _imageContainer, uint64_t _flags = BGFX_TEXTURE_NONE|BGFX_SAMPLER_NONE, const char* _name = NULL, bgfx::TextureInfo* _info = NULL);
+
 ///
 bgfx::TextureHandle loadTexture(const char* _name, uint64_t _flags = BGFX_TEXTURE_NONE|BGFX_SAMPLER_NONE, uint8_t _skip = 0, bgfx::TextureInfo* _info = NULL, bimg::Orientation::Enum* _orientation = NULL);
 
@@ -43,11 +51,12 @@ void calcTangents(void* _vertices, uint16_t _numVertices, bgfx::VertexLayout _la
 /// @param[in] _numVertices Number of vertices.
 /// @param[in] _layout Vertex layout.
 /// @param[in] _numIndices Number of indices.
+/// @param[in] _index32 Set to `true` if indices are 32-bit.
 ///
-inline bool checkAvailTransientBuffers(uint32_t _numVertices, const bgfx::VertexLayout& _layout, uint32_t _numIndices)
+inline bool checkAvailTransientBuffers(uint32_t _numVertices, const bgfx::VertexLayout& _layout, uint32_t _numIndices, bool _index32 = false)
 {
 	return _numVertices == bgfx::getAvailTransientVertexBuffer(_numVertices, _layout)
-		&& (0 == _numIndices || _numIndices == bgfx::getAvailTransientIndexBuffer(_numIndices) )
+		&& (0 == _numIndices || _numIndices == bgfx::getAvailTransientIndexBuffer(_numIndices, _index32) )
 		;
 }
 
@@ -98,21 +107,66 @@ struct Primitive
 
 typedef stl::vector<Primitive> PrimitiveArray;
 
+/// Simplified index list, indices reference group vertex buffer.
+struct MeshLod
+{
+	float    m_error;      //!< Object space error.
+	uint32_t m_startIndex; //!< Start index in Group::m_lodIbh.
+	uint32_t m_numIndices;
+};
+
+typedef stl::vector<MeshLod> MeshLodArray;
+
+/// Cluster of up to 64 vertices and 124 triangles.
+struct Meshlet
+{
+	Sphere   m_sphere;
+	bx::Vec3 m_coneApex;
+	bx::Vec3 m_coneAxis;
+	float    m_coneCutoff;
+	uint32_t m_startVertex; //!< Start of meshlet vertices in Group::m_meshletVertices.
+	uint32_t m_startIndex;  //!< Start index in Group::m_meshletIbh, and Group::m_meshletTriangles.
+	uint8_t  m_numVertices;
+	uint8_t  m_numTriangles;
+};
+
+typedef stl::vector<Meshlet> MeshletArray;
+
 struct Group
 {
 	Group();
 	void reset();
+
+	/// Returns LOD to use, 0 is full detail group index buffer, and N is `m_lods[N-1]`.
+	///
+	/// @param[in] _distance Object space distance from viewer.
+	/// @param[in] _threshold Acceptable object space error per unit of distance.
+	///
+	uint32_t selectLod(float _distance, float _threshold) const;
+
+	/// Set index buffer for selected LOD.
+	void setLodIndexBuffer(uint32_t _lod) const;
 	
 	bgfx::VertexBufferHandle m_vbh;
 	bgfx::IndexBufferHandle m_ibh;
-	uint16_t m_numVertices;
+	uint32_t m_numVertices;
 	uint8_t* m_vertices;
 	uint32_t m_numIndices;
-	uint16_t* m_indices;
+	uint16_t* m_indices;   //!< 16-bit indices, when m_index32 is false.
+	uint32_t* m_indices32; //!< 32-bit indices, when m_index32 is true.
+	bool m_index32;
 	Sphere m_sphere;
 	Aabb m_aabb;
 	Obb m_obb;
 	PrimitiveArray m_prims;
+
+	bgfx::IndexBufferHandle m_lodIbh;
+	MeshLodArray m_lods;
+
+	bgfx::IndexBufferHandle m_meshletIbh;
+	MeshletArray m_meshlets;
+	uint32_t* m_meshletVertices;
+	uint8_t* m_meshletTriangles;
 };
 typedef stl::vector<Group> GroupArray;
 
@@ -127,6 +181,13 @@ struct Mesh
 	GroupArray m_groups;
 };
 
+/// Returns true if all triangles of meshlet are facing away from viewer.
+///
+/// @param[in] _meshlet Meshlet.
+/// @param[in] _eye Object space viewer position.
+///
+bool isMeshletBackfacing(const Meshlet& _meshlet, const bx::Vec3& _eye);
+
 ///
 Mesh* meshLoad(const char* _filePath, bool _ramcopy = false);
 
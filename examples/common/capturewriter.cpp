@@ -0,0 +1,696 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "capturewriter.h"
+
+#include <bx/string.h>
+
+#define CAPTURE_MAGIC   BX_MAKEFOURCC('B', 'C', 'A', 'P')
+#define CAPTURE_VERSION 1
+
+#define QOI_OP_INDEX 0x00
+#define QOI_OP_DIFF  0x40
+#define QOI_OP_LUMA  0x80
+#define QOI_OP_RUN   0xc0
+#define QOI_OP_RGB   0xfe
+#define QOI_OP_RGBA  0xff
+#define QOI_MASK_2   0xc0
+
+struct CaptureWriter::Slot
+{
+	struct State
+	{
+		enum Enum
+		{
+			Free,
+			Queued,
+			Encoded,
+		};
+	};
+
+	uint8_t* m_pixels;
+	uint8_t* m_data;
+	uint32_t m_size;
+	uint32_t m_frame;
+	uint32_t m_seq;
+	State::Enum m_state;
+};
+
+static uint32_t qoiHash(const uint8_t* _px)
+{
+	return (_px[0]*3 + _px[1]*5 + _px[2]*7 + _px[3]*11) % 64;
+}
+
+static uint32_t encodeQoi(uint8_t* _dst, const uint8_t* _src, uint32_t _numPixels)
+{
+	uint8_t index[64][4];
+	bx::memSet(index, 0, sizeof(index) );
+
+	uint8_t prev[4] = { 0, 0, 0, 255 };
+	uint8_t* dst = _dst;
+	uint32_t run = 0;
+
+	for (uint32_t ii = 0; ii < _numPixels; ++ii)
+	{
+		const uint8_t* px = &_src[ii*4];
+
+		if (0 == bx::memCmp(px, prev, 4) )
+		{
+			++run;
+			if (62 == run
+			||  ii == _numPixels-1)
+			{
+				*dst++ = uint8_t(QOI_OP_RUN | (run-1) );
+				run = 0;
+			}
+
+			continue;
+		}
+
+		if (0 < run)
+		{
+			*dst++ = uint8_t(QOI_OP_RUN | (run-1) );
+			run = 0;
+		}
+
+		const uint32_t hash = qoiHash(px);
+
+		if (0 == bx::memCmp(index[hash], px, 4) )
+		{
+			*dst++ = uint8_t(QOI_OP_INDEX | hash);
+		}
+		else
+		{
+			bx::memCopy(index[hash], px, 4);
+
+			if (px[3] == prev[3])
+			{
+				const int8_t vr = int8_t(px[0] - prev[0]);
+				const int8_t vg = int8_t(px[1] - prev[1]);
+				const int8_t vb = int8_t(px[2] - prev[2]);
+				const int8_t vgr = int8_t(vr - vg);
+				const int8_t vgb = int8_t(vb - vg);
+
+				if (vr > -3 && vr < 2
+				&&  vg > -3 && vg < 2
+				&&  vb > -3 && vb < 2)
+				{
+					*dst++ = uint8_t(QOI_OP_DIFF | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2) );
+				}
+				else if (vgr >  -9 && vgr <  8
+					 &&  vg  > -33 && vg  < 32
+					 &&  vgb >  -9 && vgb <  8)
+				{
+					*dst++ = uint8_t(QOI_OP_LUMA | (vg + 32) );
+					*dst++ = uint8_t( (vgr + 8) << 4 | (vgb + 8) );
+				}
+				else
+				{
+					*dst++ = QOI_OP_RGB;
+					*dst++ = px[0];
+					*dst++ = px[1];
+					*dst++ = px[2];
+				}
+			}
+			else
+			{
+				*dst++ = QOI_OP_RGBA;
+				*dst++ = px[0];
+				*dst++ = px[1];
+				*dst++ = px[2];
+				*dst++ = px[3];
+			}
+		}
+
+		bx::memCopy(prev, px, 4);
+	}
+
+	return uint32_t(dst - _dst);
+}
+
+static bool decodeQoi(uint8_t* _dst, uint32_t _numPixels, const uint8_t* _src, uint32_t _size)
+{
+	uint8_t index[64][4];
+	bx::memSet(index, 0, sizeof(index) );
+
+	uint8_t px[4] = { 0, 0, 0, 255 };
+	const uint8_t* src = _src;
+	const uint8_t* end = _src + _size;
+	uint32_t run = 0;
+
+	for (uint32_t ii = 0; ii < _numPixels; ++ii)
+	{
+		if (0 < run)
+		{
+			--run;
+		}
+		else
+		{
+			if (src >= end)
+			{
+				return false;
+			}
+
+			const uint8_t b1 = *src++;
+
+			const int32_t payload = 0
+				+ (QOI_OP_RGBA == b1 ? 4 : 0)
+				+ (QOI_OP_RGB  == b1 ? 3 : 0)
+				+ (QOI_OP_LUMA == (b1 & QOI_MASK_2) ? 1 : 0)
+				;
+
+			if (end - src < payload)
+			{
+				return false;
+			}
+
+			if (QOI_OP_RGB == b1)
+			{
+				px[0] = src[0];
+				px[1] = src[1];
+				px[2] = src[2];
+				src += 3;
+			}
+			else if (QOI_OP_RGBA == b1)
+			{
+				bx::memCopy(px, src, 4);
+				src += 4;
+			}
+			else if (QOI_OP_INDEX == (b1 & QOI_MASK_2) )
+			{
+				bx::memCopy(px, index[b1], 4);
+			}
+			else if (QOI_OP_DIFF == (b1 & QOI_MASK_2) )
+			{
+				px[0] = uint8_t(px[0] + ( (b1 >> 4) & 3) - 2);
+				px[1] = uint8_t(px[1] + ( (b1 >> 2) & 3) - 2);
+				px[2] = uint8_t(px[2] + ( (b1     ) & 3) - 2);
+			}
+			else if (QOI_OP_LUMA == (b1 & QOI_MASK_2) )
+			{
+				const uint8_t b2 = *src++;
+				const int32_t vg = (b1 & 0x3f) - 32;
+				px[0] = uint8_t(px[0] + vg - 8 + ( (b2 >> 4) & 0xf) );
+				px[1] = uint8_t(px[1] + vg);
+				px[2] = uint8_t(px[2] + vg - 8 + ( (b2     ) & 0xf) );
+			}
+			else
+			{
+				run = b1 & 0x3f;
+			}
+
+			bx::memCopy(index[qoiHash(px)], px, 4);
+		}
+
+		bx::memCopy(&_dst[ii*4], px, 4);
+	}
+
+	return true;
+}
+
+static uint8_t deltaResidual(const uint8_t* _row, uint32_t _ii)
+{
+	return 4 > _ii ? _row[_ii] : uint8_t(_row[_ii] - _row[_ii-4]);
+}
+
+// Each row is predicted from left pixel per channel. Residuals are written as
+// literal spans or zero runs:
+//   0x00-0x7f - 1-128 literal bytes follow.
+//   0x80-0xff - 1-128 zero bytes.
+static uint32_t encodeDeltaRle(uint8_t* _dst, const uint8_t* _src, uint32_t _width, uint32_t _height)
+{
+	const uint32_t rowSize = _width*4;
+	uint8_t* dst = _dst;
+
+	for (uint32_t yy = 0; yy < _height; ++yy)
+	{
+		const uint8_t* row = &_src[yy*rowSize];
+
+		for (uint32_t ii = 0; ii < rowSize;)
+		{
+			uint32_t num = 0;
+			while (ii+num < rowSize
+			&&     128 >  num
+			&&     0   == deltaResidual(row, ii+num) )
+			{
+				++num;
+			}
+
+			if (0 < num)
+			{
+				*dst++ = uint8_t(0x80 | (num-1) );
+				ii += num;
+				continue;
+			}
+
+			while (ii+num < rowSize
+			&&     128 >  num
+			&&     0   != deltaResidual(row, ii+num) )
+			{
+				++num;
+			}
+
+			*dst++ = uint8_t(num-1);
+			for (uint32_t jj = 0; jj < num; ++jj)
+			{
+				*dst++ = deltaResidual(row, ii+jj);
+			}
+
+			ii += num;
+		}
+	}
+
+	return uint32_t(dst - _dst);
+}
+
+static bool decodeDeltaRle(uint8_t* _dst, uint32_t _width, uint32_t _height, const uint8_t* _src, uint32_t _size)
+{
+	const uint32_t rowSize = _width*4;
+	const uint8_t* src = _src;
+	const uint8_t* end = _src + _size;
+
+	for (uint32_t yy = 0; yy < _height; ++yy)
+	{
+		uint8_t* row = &_dst[yy*rowSize];
+
+		for (uint32_t ii = 0; ii < rowSize;)
+		{
+			if (src >= end)
+			{
+				return false;
+			}
+
+			const uint8_t  code = *src++;
+			const uint32_t num  = (code & 0x7f) + 1;
+
+			if (ii + num > rowSize)
+			{
+				return false;
+			}
+
+			if (0 != (code & 0x80) )
+			{
+				bx::memSet(&row[ii], 0, num);
+			}
+			else
+			{
+				if (src + num > end)
+				{
+					return false;
+				}
+
+				bx::memCopy(&row[ii], src, num);
+				src += num;
+			}
+
+			ii += num;
+		}
+
+		for (uint32_t ii = 4; ii < rowSize; ++ii)
+		{
+			row[ii] = uint8_t(row[ii] + row[ii-4]);
+		}
+	}
+
+	return true;
+}
+
+static uint32_t getMaxEncodedSize(CaptureCodec::Enum _codec, uint32_t _width, uint32_t _height)
+{
+	const uint32_t numPixels = _width*_height;
+
+	switch (_codec)
+	{
+	case CaptureCodec::Qoi:      return numPixels*5;
+	case CaptureCodec::DeltaRle: return numPixels*6; // Alternating zero and literal bytes.
+	default:                     return numPixels*4;
+	}
+}
+
+CaptureWriter::CaptureWriter(bx::AllocatorI* _allocator)
+	: m_allocator(_allocator)
+	, m_slot(NULL)
+	, m_queue(NULL)
+	, m_index(NULL)
+	, m_indexMax(0)
+	, m_numBuffers(0)
+	, m_numThreads(0)
+{
+}
+
+CaptureWriter::~CaptureWriter()
+{
+	close();
+}
+
+bool CaptureWriter::open(
+	  const char* _filePath
+	, uint32_t _width
+	, uint32_t _height
+	, uint32_t _pitch
+	, uint32_t _fps
+	, bool _yflip
+	, CaptureCodec::Enum _codec
+	, uint32_t _numBuffers
+	, uint32_t _numThreads
+	)
+{
+	BX_ASSERT(!isOpen(), "Capture is already open.");
+
+	if (!bx::open(&m_writer, _filePath) )
+	{
+		return false;
+	}
+
+	bx::memSet(&m_header, 0, sizeof(m_header) );
+	m_header.magic   = CAPTURE_MAGIC;
+	m_header.version = CAPTURE_VERSION;
+	m_header.width   = _width;
+	m_header.height  = _height;
+	m_header.fps     = _fps;
+	m_header.codec   = _codec;
+	bx::write(&m_writer, m_header);
+
+	bx::memSet(&m_stats, 0, sizeof(m_stats) );
+
+	m_pitch      = _pitch;
+	m_numBuffers = bx::max<uint32_t>(_numBuffers, 1);
+	m_numThreads = bx::clamp<uint32_t>(_numThreads, 1, kMaxThreads);
+	m_frame      = 0;
+	m_seq        = 0;
+	m_nextWrite  = 0;
+	m_queueRead  = 0;
+	m_queueWrite = 0;
+	m_offset     = sizeof(CaptureFileHeader);
+	m_yflip      = _yflip;
+	m_exit       = false;
+
+	const uint32_t rawSize     = _pitch*_height;
+	const uint32_t encodedSize = getMaxEncodedSize(_codec, _width, _height);
+
+	m_slot  = (Slot*)BX_ALLOC(m_allocator, m_numBuffers*sizeof(Slot) );
+	m_queue = (uint32_t*)BX_ALLOC(m_allocator, m_numBuffers*sizeof(uint32_t) );
+
+	for (uint32_t ii = 0; ii < m_numBuffers; ++ii)
+	{
+		Slot& slot = m_slot[ii];
+		slot.m_pixels = (uint8_t*)BX_ALLOC(m_allocator, rawSize);
+		slot.m_data   = (uint8_t*)BX_ALLOC(m_allocator, encodedSize);
+		slot.m_size   = 0;
+		slot.m_state  = Slot::State::Free;
+	}
+
+	for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+	{
+		m_thread[ii].init(workerThread, this, 0, "capture");
+	}
+
+	return true;
+}
+
+void CaptureWriter::close()
+{
+	if (!isOpen() )
+	{
+		return;
+	}
+
+	{
+		bx::MutexScope scope(m_mutex);
+		m_exit = true;
+	}
+
+	for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+	{
+		m_work.post();
+	}
+
+	for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+	{
+		m_thread[ii].shutdown();
+	}
+
+	// Workers drain queue before exiting, write anything left behind.
+	write();
+
+	m_header.numFrames   = m_stats.numFrames;
+	m_header.numDropped  = m_stats.numDropped;
+	m_header.indexOffset = m_offset;
+
+	bx::write(&m_writer, m_index, m_header.numFrames*sizeof(CaptureIndexEntry) );
+
+	m_writer.seek(0, bx::Whence::Begin);
+	bx::write(&m_writer, m_header);
+	bx::close(&m_writer);
+
+	for (uint32_t ii = 0; ii < m_numBuffers; ++ii)
+	{
+		BX_FREE(m_allocator, m_slot[ii].m_pixels);
+		BX_FREE(m_allocator, m_slot[ii].m_data);
+	}
+
+	BX_FREE(m_allocator, m_slot);
+	BX_FREE(m_allocator, m_queue);
+	BX_FREE(m_allocator, m_index);
+
+	m_slot     = NULL;
+	m_queue    = NULL;
+	m_index    = NULL;
+	m_indexMax = 0;
+}
+
+bool CaptureWriter::frame(const void* _data, uint32_t _size)
+{
+	if (!isOpen() )
+	{
+		return false;
+	}
+
+	Slot* slot = NULL;
+
+	{
+		bx::MutexScope scope(m_mutex);
+
+		const uint32_t frame = m_frame++;
+
+		for (uint32_t ii = 0; ii < m_numBuffers; ++ii)
+		{
+			if (Slot::State::Free == m_slot[ii].m_state)
+			{
+				slot = &m_slot[ii];
+				break;
+			}
+		}
+
+		if (NULL == slot)
+		{
+			++m_stats.numDropped;
+			return false;
+		}
+
+		slot->m_state = Slot::State::Queued;
+		slot->m_frame = frame;
+		slot->m_seq   = m_seq++;
+
+		++m_stats.queueDepth;
+		m_stats.maxQueueDepth = bx::max(m_stats.maxQueueDepth, m_stats.queueDepth);
+	}
+
+	// Slot is owned by this thread until it's pushed to queue.
+	bx::memCopy(slot->m_pixels, _data, bx::min(_size, m_pitch*m_header.height) );
+
+	{
+		bx::MutexScope scope(m_mutex);
+		m_queue[m_queueWrite % m_numBuffers] = uint32_t(slot - m_slot);
+		++m_queueWrite;
+	}
+
+	m_work.post();
+
+	return true;
+}
+
+void CaptureWriter::getStats(CaptureStats& _stats)
+{
+	bx::MutexScope scope(m_mutex);
+	_stats = m_stats;
+}
+
+int32_t CaptureWriter::workerThread(bx::Thread* /*_thread*/, void* _userData)
+{
+	CaptureWriter* writer = (CaptureWriter*)_userData;
+	return writer->worker();
+}
+
+int32_t CaptureWriter::worker()
+{
+	for (;;)
+	{
+		m_work.wait();
+
+		Slot* slot = NULL;
+
+		{
+			bx::MutexScope scope(m_mutex);
+
+			if (m_queueRead != m_queueWrite)
+			{
+				slot = &m_slot[m_queue[m_queueRead % m_numBuffers] ];
+				++m_queueRead;
+			}
+			else if (m_exit)
+			{
+				// Wake next worker, it will exit too.
+				m_work.post();
+				return 0;
+			}
+		}
+
+		if (NULL != slot)
+		{
+			encode(*slot);
+
+			{
+				bx::MutexScope scope(m_mutex);
+				slot->m_state = Slot::State::Encoded;
+			}
+
+			write();
+		}
+	}
+}
+
+void CaptureWriter::encode(Slot& _slot)
+{
+	const uint32_t width   = m_header.width;
+	const uint32_t height  = m_header.height;
+	const uint32_t rowSize = width*4;
+
+	// Convert to tightly packed, top-down rows in place.
+	for (uint32_t yy = 0, num = m_yflip ? height/2 : 0; yy < num; ++yy)
+	{
+		uint8_t* top    = &_slot.m_pixels[yy*m_pitch];
+		uint8_t* bottom = &_slot.m_pixels[(height-1-yy)*m_pitch];
+
+		for (uint32_t ii = 0; ii < rowSize; ++ii)
+		{
+			bx::swap(top[ii], bottom[ii]);
+		}
+	}
+
+	if (m_pitch != rowSize)
+	{
+		for (uint32_t yy = 1; yy < height; ++yy)
+		{
+			bx::memMove(&_slot.m_pixels[yy*rowSize], &_slot.m_pixels[yy*m_pitch], rowSize);
+		}
+	}
+
+	switch (m_header.codec)
+	{
+	case CaptureCodec::Qoi:
+		_slot.m_size = encodeQoi(_slot.m_data, _slot.m_pixels, width*height);
+		break;
+
+	case CaptureCodec::DeltaRle:
+		_slot.m_size = encodeDeltaRle(_slot.m_data, _slot.m_pixels, width, height);
+		break;
+
+	default:
+		bx::memCopy(_slot.m_data, _slot.m_pixels, rowSize*height);
+		_slot.m_size = rowSize*height;
+		break;
+	}
+}
+
+void CaptureWriter::write()
+{
+	// Frames are encoded out of order, but written in submit order. Whichever
+	// worker finishes frame that's next in sequence writes it, and any frames
+	// after it that are already encoded.
+	bx::MutexScope writeScope(m_writeMutex);
+
+	for (;;)
+	{
+		Slot* slot = NULL;
+
+		{
+			bx::MutexScope scope(m_mutex);
+
+			for (uint32_t ii = 0; ii < m_numBuffers; ++ii)
+			{
+				if (Slot::State::Encoded == m_slot[ii].m_state
+				&&  m_nextWrite == m_slot[ii].m_seq)
+				{
+					slot = &m_slot[ii];
+					break;
+				}
+			}
+		}
+
+		if (NULL == slot)
+		{
+			break;
+		}
+
+		bx::write(&m_writer, slot->m_data, slot->m_size);
+
+		if (m_stats.numFrames == m_indexMax)
+		{
+			m_indexMax = bx::max<uint32_t>(m_indexMax*2, 256);
+			m_index = (CaptureIndexEntry*)BX_REALLOC(m_allocator, m_index, m_indexMax*sizeof(CaptureIndexEntry) );
+		}
+
+		CaptureIndexEntry& entry = m_index[m_stats.numFrames];
+		entry.offset = m_offset;
+		entry.size   = slot->m_size;
+		entry.frame  = slot->m_frame;
+
+		m_offset += slot->m_size;
+
+		{
+			bx::MutexScope scope(m_mutex);
+
+			++m_stats.numFrames;
+			--m_stats.queueDepth;
+			m_stats.rawBytes     += m_header.width*m_header.height*4;
+			m_stats.writtenBytes += slot->m_size;
+
+			slot->m_state = Slot::State::Free;
+			++m_nextWrite;
+		}
+	}
+}
+
+bool captureDecodeFrame(
+	  CaptureCodec::Enum _codec
+	, void* _dst
+	, uint32_t _width
+	, uint32_t _height
+	, const void* _src
+	, uint32_t _size
+	)
+{
+	uint8_t* dst = (uint8_t*)_dst;
+	const uint8_t* src = (const uint8_t*)_src;
+
+	switch (_codec)
+	{
+	case CaptureCodec::Qoi:
+		return decodeQoi(dst, _width*_height, src, _size);
+
+	case CaptureCodec::DeltaRle:
+		return decodeDeltaRle(dst, _width, _height, src, _size);
+
+	default:
+		if (_size != _width*_height*4)
+		{
+			return false;
+		}
+
+		bx::memCopy(dst, src, _size);
+		return true;
+	}
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef CAPTUREWRITER_H_HEADER_GUARD
+#define CAPTUREWRITER_H_HEADER_GUARD
+
+#include <bx/allocator.h>
+#include <bx/file.h>
+#include <bx/mutex.h>
+#include <bx/semaphore.h>
+#include <bx/thread.h>
+
+///
+struct CaptureCodec
+{
+	enum Enum
+	{
+		Raw,      //!< Uncompressed BGRA8 rows.
+		Qoi,      //!< QOI-style lossless pixel stream.
+		DeltaRle, //!< Per channel left prediction, with zero runs RLE encoded.
+
+		Count
+	};
+};
+
+///
+struct CaptureStats
+{
+	uint32_t numFrames;     //!< Frames written to file.
+	uint32_t numDropped;    //!< Frames dropped because all frame buffers were in use.
+	uint32_t queueDepth;    //!< Frames currently waiting to be encoded or written.
+	uint32_t maxQueueDepth; //!< Highest queue depth observed.
+	uint64_t rawBytes;      //!< Uncompressed size of written frames.
+	uint64_t writtenBytes;  //!< Compressed size of written frames.
+};
+
+/// Capture file layout:
+///
+///   Header               - CaptureFileHeader.
+///   Frame data           - Encoded frames, in frame order.
+///   Index                - CaptureFileHeader::numFrames x CaptureIndexEntry.
+///
+/// Header is rewritten on close with number of frames and index offset.
+///
+struct CaptureFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t width;
+	uint32_t height;
+	uint32_t fps;
+	uint32_t codec;
+	uint32_t numFrames;
+	uint32_t numDropped;
+	uint64_t indexOffset;
+};
+
+///
+struct CaptureIndexEntry
+{
+	uint64_t offset; //!< File offset of encoded frame.
+	uint32_t size;   //!< Encoded frame size.
+	uint32_t frame;  //!< Capture frame number, gaps indicate dropped frames.
+};
+
+/// Frame capture writer. Frames are copied into bounded pool of frame buffers
+/// on calling thread, then converted, compressed and written by worker threads.
+/// `frame` never waits for workers, when all buffers are in use frame is dropped.
+///
+class CaptureWriter
+{
+public:
+	///
+	CaptureWriter(bx::AllocatorI* _allocator);
+
+	///
+	~CaptureWriter();
+
+	///
+	bool open(
+		  const char* _filePath
+		, uint32_t _width
+		, uint32_t _height
+		, uint32_t _pitch
+		, uint32_t _fps
+		, bool _yflip
+		, CaptureCodec::Enum _codec = CaptureCodec::Qoi
+		, uint32_t _numBuffers = 8
+		, uint32_t _numThreads = 2
+		);
+
+	/// Waits for all queued frames to be written, and writes index.
+	void close();
+
+	/// Queue BGRA8 frame. Returns false if frame was dropped.
+	bool frame(const void* _data, uint32_t _size);
+
+	///
+	void getStats(CaptureStats& _stats);
+
+	///
+	bool isOpen() const
+	{
+		return NULL != m_slot;
+	}
+
+private:
+	struct Slot;
+
+	static int32_t workerThread(bx::Thread* _thread, void* _userData);
+	int32_t worker();
+	void encode(Slot& _slot);
+	void write();
+
+	static const uint32_t kMaxThreads = 8;
+
+	bx::AllocatorI* m_allocator;
+	bx::FileWriter  m_writer;
+	bx::Thread      m_thread[kMaxThreads];
+	bx::Semaphore   m_work;
+	bx::Mutex       m_mutex;
+	bx::Mutex       m_writeMutex;
+
+	Slot*     m_slot;
+	uint32_t* m_queue;
+	uint32_t  m_queueRead;
+	uint32_t  m_queueWrite;
+
+	CaptureIndexEntry* m_index;
+	uint32_t m_indexMax;
+
+	CaptureFileHeader m_header;
+	CaptureStats m_stats;
+
+	uint32_t m_pitch;
+	uint32_t m_numBuffers;
+	uint32_t m_numThreads;
+	uint32_t m_frame;
+	uint32_t m_seq;
+	uint32_t m_nextWrite;
+	uint64_t m_offset;
+	bool     m_yflip;
+	bool     m_exit;
+};
+
+/// Decode frame written by CaptureWriter into BGRA8 buffer of `_width*_height*4` bytes.
+bool captureDecodeFrame(
+	  CaptureCodec::Enum _codec
+	, void* _dst
+	, uint32_t _width
+	, uint32_t _height
+	, const void* _src
+	, uint32_t _size
+	);
+
+#endif // CAPTUREWRITER_H_HEADER_GUARD
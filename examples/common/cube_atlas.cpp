@@ -7,6 +7,7 @@
 #include <bgfx/bgfx.h>
 
 #include <limits.h> // INT_MAX
+#include <algorithm>
 #include <vector>
 
 #include "cube_atlas.h"
@@ -250,7 +251,9 @@ struct Atlas::PackedLayer
 };
 
 Atlas::Atlas(uint16_t _textureSize, uint16_t _maxRegionsCount)
-	: m_usedLayers(0)
+	: m_numFreeRegions(0)
+	, m_generation(0)
+	, m_usedLayers(0)
 	, m_usedFaces(0)
 	, m_textureSize(_textureSize)
 	, m_regionCount(0)
@@ -268,6 +271,8 @@ Atlas::Atlas(uint16_t _textureSize, uint16_t _maxRegionsCount)
 	}
 
 	m_regions = new AtlasRegion[_maxRegionsCount];
+	m_regionOutline = new uint8_t[_maxRegionsCount];
+	m_freeRegions = new uint16_t[_maxRegionsCount];
 	m_textureBuffer = new uint8_t[ _textureSize * _textureSize * 6 * 4 ];
 	bx::memSet(m_textureBuffer, 0, _textureSize * _textureSize * 6 * 4);
 
@@ -279,7 +284,10 @@ Atlas::Atlas(uint16_t _textureSize, uint16_t _maxRegionsCount)
 }
 
 Atlas::Atlas(uint16_t _textureSize, const uint8_t* _textureBuffer, uint16_t _regionCount, const uint8_t* _regionBuffer, uint16_t _maxRegionsCount)
-	: m_usedLayers(24)
+	: m_layers(NULL)
+	, m_numFreeRegions(0)
+	, m_generation(0)
+	, m_usedLayers(24)
 	, m_usedFaces(6)
 	, m_textureSize(_textureSize)
 	, m_regionCount(_regionCount)
@@ -290,9 +298,12 @@ Atlas::Atlas(uint16_t _textureSize, const uint8_t* _textureBuffer, uint16_t _reg
 	init();
 
 	m_regions = new AtlasRegion[_regionCount];
+	m_regionOutline = new uint8_t[_regionCount];
+	m_freeRegions = new uint16_t[_regionCount];
 	m_textureBuffer = new uint8_t[getTextureBufferSize()];
 
 	bx::memCopy(m_regions, _regionBuffer, _regionCount * sizeof(AtlasRegion) );
+	bx::memSet(m_regionOutline, 0, _regionCount);
 	bx::memCopy(m_textureBuffer, _textureBuffer, getTextureBufferSize() );
 
 	m_textureHandle = bgfx::createTextureCube(_textureSize
@@ -310,11 +321,21 @@ Atlas::~Atlas()
 
 	delete [] m_layers;
 	delete [] m_regions;
+	delete [] m_regionOutline;
+	delete [] m_freeRegions;
 	delete [] m_textureBuffer;
 }
 
 void Atlas::init()
 {
+	for (uint32_t ii = 0; ii < BX_COUNTOF(m_dirty); ++ii)
+	{
+		m_dirty[ii].x0 = UINT16_MAX;
+		m_dirty[ii].y0 = UINT16_MAX;
+		m_dirty[ii].x1 = 0;
+		m_dirty[ii].y1 = 0;
+	}
+
 	m_texelSize = float(UINT16_MAX) / float(m_textureSize);
 	float texelHalf = m_texelSize/2.0f;
 	switch (bgfx::getRendererType() )
@@ -337,20 +358,13 @@ void Atlas::init()
 	}
 }
 
-uint16_t Atlas::addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bitmapBuffer, AtlasRegion::Type _type, uint16_t outline)
+bool Atlas::packRegion(uint16_t _width, uint16_t _height, AtlasRegion::Type _type, uint16_t& _outX, uint16_t& _outY, uint32_t& _outLayer)
 {
-	if (m_regionCount >= m_maxRegionCount)
-	{
-		return UINT16_MAX;
-	}
-
-	uint16_t xx = 0;
-	uint16_t yy = 0;
 	uint32_t idx = 0;
 	while (idx < m_usedLayers)
 	{
 		if (m_layers[idx].faceRegion.getType() == _type
-		&&  m_layers[idx].packer.addRectangle(_width + 1, _height + 1, xx, yy) )
+		&&  m_layers[idx].packer.addRectangle(_width + 1, _height + 1, _outX, _outY) )
 		{
 			break;
 		}
@@ -363,7 +377,7 @@ uint16_t Atlas::addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bit
 		if ( (idx + _type) > 24
 		|| m_usedFaces >= 6)
 		{
-			return UINT16_MAX;
+			return false;
 		}
 
 		for (int ii = 0; ii < _type; ++ii)
@@ -379,13 +393,38 @@ uint16_t Atlas::addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bit
 		m_usedLayers += _type;
 		m_usedFaces++;
 
-		if (!m_layers[idx].packer.addRectangle(_width + 1, _height + 1, xx, yy) )
+		if (!m_layers[idx].packer.addRectangle(_width + 1, _height + 1, _outX, _outY) )
 		{
-			return UINT16_MAX;
+			return false;
 		}
 	}
 
-	AtlasRegion& region = m_regions[m_regionCount];
+	_outLayer = idx;
+	return true;
+}
+
+uint16_t Atlas::addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bitmapBuffer, AtlasRegion::Type _type, uint16_t outline)
+{
+	if (NULL == m_layers
+	|| (m_regionCount >= m_maxRegionCount && 0 == m_numFreeRegions) )
+	{
+		return UINT16_MAX;
+	}
+
+	uint16_t xx = 0;
+	uint16_t yy = 0;
+	uint32_t idx = 0;
+	if (!packRegion(_width, _height, _type, xx, yy, idx) )
+	{
+		return UINT16_MAX;
+	}
+
+	const uint16_t handle = 0 < m_numFreeRegions
+		? m_freeRegions[--m_numFreeRegions]
+		: m_regionCount++
+		;
+
+	AtlasRegion& region = m_regions[handle];
 	region.x = xx;
 	region.y = yy;
 	region.width = _width;
@@ -399,51 +438,227 @@ uint16_t Atlas::addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bit
 	region.width -= (outline * 2);
 	region.height -= (outline * 2);
 
-	return m_regionCount++;
+	m_regionOutline[handle] = uint8_t(outline);
+
+	return handle;
+}
+
+void Atlas::removeRegion(uint16_t _regionHandle)
+{
+	BX_ASSERT(_regionHandle < m_regionCount, "Invalid region handle %d.", _regionHandle);
+
+	AtlasRegion& region = m_regions[_regionHandle];
+	if (0 != region.mask)
+	{
+		region.mask = 0;
+		m_freeRegions[m_numFreeRegions++] = _regionHandle;
+	}
+}
+
+void Atlas::markDirty(uint32_t _faceIndex, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
+{
+	DirtyRect& dirty = m_dirty[_faceIndex];
+	dirty.x0 = bx::min<uint16_t>(dirty.x0, _x);
+	dirty.y0 = bx::min<uint16_t>(dirty.y0, _y);
+	dirty.x1 = bx::max<uint16_t>(dirty.x1, _x + _width);
+	dirty.y1 = bx::max<uint16_t>(dirty.y1, _y + _height);
 }
 
 void Atlas::updateRegion(const AtlasRegion& _region, const uint8_t* _bitmapBuffer)
 {
-	uint32_t size = _region.width * _region.height * 4;
-	if (0 < size)
+	if (0 == _region.width * _region.height)
 	{
-		const bgfx::Memory* mem = bgfx::alloc(size);
-		bx::memSet(mem->data, 0, mem->size);
-		if (_region.getType() == AtlasRegion::TYPE_BGRA8)
-		{
-			const uint8_t* inLineBuffer = _bitmapBuffer;
-			uint8_t* outLineBuffer = m_textureBuffer + _region.getFaceIndex() * (m_textureSize * m_textureSize * 4) + ( ( (_region.y * m_textureSize) + _region.x) * 4);
+		return;
+	}
+
+	uint8_t* outLineBuffer = m_textureBuffer + _region.getFaceIndex() * (m_textureSize * m_textureSize * 4) + ( ( (_region.y * m_textureSize) + _region.x) * 4);
+	const uint8_t* inLineBuffer = _bitmapBuffer;
 
-			for (int yy = 0; yy < _region.height; ++yy)
+	// NULL bitmap clears the region.
+	if (_region.getType() == AtlasRegion::TYPE_BGRA8)
+	{
+		for (int yy = 0; yy < _region.height; ++yy)
+		{
+			if (NULL == inLineBuffer)
+			{
+				bx::memSet(outLineBuffer, 0, _region.width * 4);
+			}
+			else
 			{
 				bx::memCopy(outLineBuffer, inLineBuffer, _region.width * 4);
 				inLineBuffer += _region.width * 4;
-				outLineBuffer += m_textureSize * 4;
 			}
 
-			bx::memCopy(mem->data, _bitmapBuffer, mem->size);
+			outLineBuffer += m_textureSize * 4;
 		}
-		else
+	}
+	else
+	{
+		uint32_t layer = _region.getComponentIndex();
+
+		for (int yy = 0; yy < _region.height; ++yy)
+		{
+			for (int xx = 0; xx < _region.width; ++xx)
+			{
+				outLineBuffer[(xx * 4) + layer] = NULL == inLineBuffer ? 0 : inLineBuffer[xx];
+			}
+
+			if (NULL != inLineBuffer)
+			{
+				inLineBuffer += _region.width;
+			}
+
+			outLineBuffer += m_textureSize * 4;
+		}
+	}
+
+	markDirty(_region.getFaceIndex(), _region.x, _region.y, _region.width, _region.height);
+}
+
+void Atlas::update()
+{
+	const uint32_t faceSize = m_textureSize * m_textureSize * 4;
+
+	for (uint32_t face = 0; face < BX_COUNTOF(m_dirty); ++face)
+	{
+		DirtyRect& dirty = m_dirty[face];
+		if (dirty.x0 >= dirty.x1
+		||  dirty.y0 >= dirty.y1)
 		{
-			uint32_t layer = _region.getComponentIndex();
-			const uint8_t* inLineBuffer = _bitmapBuffer;
-			uint8_t* outLineBuffer = (m_textureBuffer + _region.getFaceIndex() * (m_textureSize * m_textureSize * 4) + ( ( (_region.y * m_textureSize) + _region.x) * 4) );
+			continue;
+		}
+
+		const uint16_t width  = dirty.x1 - dirty.x0;
+		const uint16_t height = dirty.y1 - dirty.y0;
+
+		const bgfx::Memory* mem = bgfx::alloc(width * height * 4);
+
+		const uint8_t* inLineBuffer = m_textureBuffer + face * faceSize + ( (dirty.y0 * m_textureSize) + dirty.x0) * 4;
+		for (uint16_t yy = 0; yy < height; ++yy)
+		{
+			bx::memCopy(mem->data + yy * width * 4, inLineBuffer, width * 4);
+			inLineBuffer += m_textureSize * 4;
+		}
+
+		bgfx::updateTextureCube(m_textureHandle, 0, uint8_t(face), 0, dirty.x0, dirty.y0, width, height, mem);
 
-			for (int yy = 0; yy < _region.height; ++yy)
+		dirty.x0 = UINT16_MAX;
+		dirty.y0 = UINT16_MAX;
+		dirty.x1 = 0;
+		dirty.y1 = 0;
+	}
+}
+
+bool Atlas::repack()
+{
+	if (NULL == m_layers)
+	{
+		return false;
+	}
+
+	const uint32_t faceSize = m_textureSize * m_textureSize * 4;
+	const uint32_t usedFaces = m_usedFaces;
+
+	uint8_t* oldBuffer = new uint8_t[getTextureBufferSize()];
+	bx::memCopy(oldBuffer, m_textureBuffer, getTextureBufferSize() );
+	bx::memSet(m_textureBuffer, 0, getTextureBufferSize() );
+
+	// Tallest regions first, skyline packer wastes less space that way.
+	std::vector<uint16_t> order;
+	order.reserve(m_regionCount);
+	for (uint16_t ii = 0; ii < m_regionCount; ++ii)
+	{
+		if (0 != m_regions[ii].mask)
+		{
+			order.push_back(ii);
+		}
+	}
+
+	const AtlasRegion* regions = m_regions;
+	const uint8_t* outline = m_regionOutline;
+	std::sort(order.begin(), order.end(), [regions, outline](uint16_t _a, uint16_t _b)
+		{
+			return regions[_a].height + outline[_a] > regions[_b].height + outline[_b];
+		});
+
+	for (uint32_t ii = 0; ii < 24; ++ii)
+	{
+		m_layers[ii].packer.clear();
+	}
+
+	m_usedLayers = 0;
+	m_usedFaces  = 0;
+
+	bool result = true;
+
+	for (uint32_t ii = 0, num = uint32_t(order.size() ); ii < num; ++ii)
+	{
+		const uint16_t handle = order[ii];
+		AtlasRegion& region = m_regions[handle];
+
+		// Move whole region, including outline.
+		AtlasRegion src = region;
+		src.x      -= m_regionOutline[handle];
+		src.y      -= m_regionOutline[handle];
+		src.width  += m_regionOutline[handle] * 2;
+		src.height += m_regionOutline[handle] * 2;
+
+		uint16_t xx = 0;
+		uint16_t yy = 0;
+		uint32_t idx = 0;
+		if (!packRegion(src.width, src.height, src.getType(), xx, yy, idx) )
+		{
+			region.mask = 0;
+			m_freeRegions[m_numFreeRegions++] = handle;
+			result = false;
+			continue;
+		}
+
+		AtlasRegion dst = src;
+		dst.x = xx;
+		dst.y = yy;
+		dst.mask = m_layers[idx].faceRegion.mask;
+
+		const uint8_t* inLineBuffer = oldBuffer + src.getFaceIndex() * faceSize + ( (src.y * m_textureSize) + src.x) * 4;
+		uint8_t* outLineBuffer = m_textureBuffer + dst.getFaceIndex() * faceSize + ( (dst.y * m_textureSize) + dst.x) * 4;
+
+		for (int yy = 0; yy < src.height; ++yy)
+		{
+			if (src.getType() == AtlasRegion::TYPE_BGRA8)
+			{
+				bx::memCopy(outLineBuffer, inLineBuffer, src.width * 4);
+			}
+			else
 			{
-				for (int xx = 0; xx < _region.width; ++xx)
+				const uint32_t srcLayer = src.getComponentIndex();
+				const uint32_t dstLayer = dst.getComponentIndex();
+
+				for (int xx = 0; xx < src.width; ++xx)
 				{
-					outLineBuffer[(xx * 4) + layer] = inLineBuffer[xx];
+					outLineBuffer[(xx * 4) + dstLayer] = inLineBuffer[(xx * 4) + srcLayer];
 				}
-
-				bx::memCopy(mem->data + yy * _region.width * 4, outLineBuffer, _region.width * 4);
-				inLineBuffer += _region.width;
-				outLineBuffer += m_textureSize * 4;
 			}
+
+			inLineBuffer += m_textureSize * 4;
+			outLineBuffer += m_textureSize * 4;
 		}
 
-		bgfx::updateTextureCube(m_textureHandle, 0, (uint8_t)_region.getFaceIndex(), 0, _region.x, _region.y, _region.width, _region.height, mem);
+		region.x    = dst.x + m_regionOutline[handle];
+		region.y    = dst.y + m_regionOutline[handle];
+		region.mask = dst.mask;
 	}
+
+	delete [] oldBuffer;
+
+	// Faces that became empty must be cleared too.
+	for (uint32_t face = 0; face < bx::max<uint32_t>(usedFaces, m_usedFaces); ++face)
+	{
+		markDirty(face, 0, 0, m_textureSize, m_textureSize);
+	}
+
+	++m_generation;
+
+	return result;
 }
 
 void Atlas::packFaceLayerUV(uint32_t _idx, uint8_t* _vertexBuffer, uint32_t _offset, uint32_t _stride) const
@@ -68,11 +68,33 @@ public:
 	~Atlas();
 
 	/// add a region to the atlas, and copy the content of mem to the underlying texture
+	/// @remark texture is updated on next call to update()
+	/// @return UINT16_MAX if there is no space left for region
 	uint16_t addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bitmapBuffer, AtlasRegion::Type _type = AtlasRegion::TYPE_BGRA8, uint16_t outline = 0);
 
 	/// update a preallocated region
+	/// @remark texture is updated on next call to update()
 	void updateRegion(const AtlasRegion& _region, const uint8_t* _bitmapBuffer);
 
+	/// release region, its space is reclaimed on next repack()
+	void removeRegion(uint16_t _regionHandle);
+
+	/// repack all live regions to reclaim space of removed regions. Region
+	/// handles stay valid, but their positions change, so UVs packed before
+	/// repack must be packed again. getGeneration() is incremented on repack.
+	/// @return false if some regions didn't fit, those regions are removed
+	bool repack();
+
+	/// upload all regions updated since last call, one texture update per
+	/// dirty cube face
+	void update();
+
+	/// incremented every time regions are moved by repack()
+	uint32_t getGeneration() const
+	{
+		return m_generation;
+	}
+
 	/// Pack the UV coordinates of the four corners of a region to a vertex buffer using the supplied vertex format.
 	/// v0 -- v3
 	/// |     |     encoded in that order:  v0,v1,v2,v3
@@ -116,6 +138,12 @@ public:
 		return m_regionCount;
 	}
 
+	/// retrieve the maximum number of region allowed in the atlas
+	uint16_t getMaxRegionCount() const
+	{
+		return m_maxRegionCount;
+	}
+
 	/// retrieve a pointer to the region buffer (in order to serialize it)
 	const AtlasRegion* getRegionBuffer() const
 	{
@@ -136,12 +164,27 @@ public:
 
 private:
 	void init();
+	bool packRegion(uint16_t _width, uint16_t _height, AtlasRegion::Type _type, uint16_t& _outX, uint16_t& _outY, uint32_t& _outLayer);
+	void markDirty(uint32_t _faceIndex, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height);
 
 	struct PackedLayer;
 	PackedLayer* m_layers;
 	AtlasRegion* m_regions;
+	uint8_t* m_regionOutline;
 	uint8_t* m_textureBuffer;
 
+	struct DirtyRect
+	{
+		uint16_t x0, y0;
+		uint16_t x1, y1;
+	};
+
+	DirtyRect m_dirty[6];
+
+	uint16_t* m_freeRegions;
+	uint16_t m_numFreeRegions;
+	uint32_t m_generation;
+
 	uint32_t m_usedLayers;
 	uint32_t m_usedFaces;
 
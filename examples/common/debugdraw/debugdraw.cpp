@@ -333,6 +333,27 @@ bx::Vec3 getPoint(Axis::Enum _axis, float _x, float _y)
 #include "fs_debugdraw_fill_lit.bin.h"
 #include "vs_debugdraw_fill_texture.bin.h"
 #include "fs_debugdraw_fill_texture.bin.h"
+#include "vs_debugdraw_fill_instanced.bin.h"
+#include "vs_debugdraw_fill_lit_instanced.bin.h"
+#include "fs_debugdraw_fill_lit_instanced.bin.h"
+
+// Instanced shaders don't have Direct3D 9/11 bytecode embedded, and on those
+// renderers shapes are drawn through non-instanced path.
+#define DEBUGDRAW_EMBEDDED_SHADER_NO_DX(_name)                                                     \
+			{                                                                                      \
+				#_name,                                                                            \
+				{                                                                                  \
+					BGFX_EMBEDDED_SHADER_PSSL (bgfx::RendererType::Gnm,        _name)              \
+					BGFX_EMBEDDED_SHADER_METAL(bgfx::RendererType::Metal,      _name)              \
+					BGFX_EMBEDDED_SHADER_NVN  (bgfx::RendererType::Nvn,        _name)              \
+					BGFX_EMBEDDED_SHADER_ESSL (bgfx::RendererType::OpenGLES,   _name)              \
+					BGFX_EMBEDDED_SHADER_GLSL (bgfx::RendererType::OpenGL,     _name)              \
+					BGFX_EMBEDDED_SHADER_SPIRV(bgfx::RendererType::Vulkan,     _name)              \
+					BGFX_EMBEDDED_SHADER_SPIRV(bgfx::RendererType::WebGPU,     _name)              \
+					{ bgfx::RendererType::Noop,  (const uint8_t*)"VSH\x5\x0\x0\x0\x0\x0\x0", 10 }, \
+					{ bgfx::RendererType::Count, NULL, 0 }                                         \
+				}                                                                                  \
+			}
 
 static const bgfx::EmbeddedShader s_embeddedShaders[] =
 {
@@ -348,6 +369,9 @@ static const bgfx::EmbeddedShader s_embeddedShaders[] =
 	BGFX_EMBEDDED_SHADER(fs_debugdraw_fill_lit),
 	BGFX_EMBEDDED_SHADER(vs_debugdraw_fill_texture),
 	BGFX_EMBEDDED_SHADER(fs_debugdraw_fill_texture),
+	DEBUGDRAW_EMBEDDED_SHADER_NO_DX(vs_debugdraw_fill_instanced),
+	DEBUGDRAW_EMBEDDED_SHADER_NO_DX(vs_debugdraw_fill_lit_instanced),
+	DEBUGDRAW_EMBEDDED_SHADER_NO_DX(fs_debugdraw_fill_lit_instanced),
 
 	BGFX_EMBEDDED_SHADER_END()
 };
@@ -523,6 +547,8 @@ struct Program
 		FillLit,
 		FillLitMesh,
 		FillTexture,
+		FillInstanced,
+		FillLitInstanced,
 
 		Count
 	};
@@ -636,6 +662,40 @@ struct DebugDrawShared
 			, true
 			);
 
+		m_program[Program::FillInstanced].idx    = bx::kInvalidHandle;
+		m_program[Program::FillLitInstanced].idx = bx::kInvalidHandle;
+
+		bgfx::ShaderHandle vsh    = bgfx::createEmbeddedShader(s_embeddedShaders, type, "vs_debugdraw_fill_instanced");
+		bgfx::ShaderHandle vshLit = bgfx::createEmbeddedShader(s_embeddedShaders, type, "vs_debugdraw_fill_lit_instanced");
+
+		if (bgfx::isValid(vsh)
+		&&  bgfx::isValid(vshLit) )
+		{
+			m_program[Program::FillInstanced] = bgfx::createProgram(
+				  vsh
+				, bgfx::createEmbeddedShader(s_embeddedShaders, type, "fs_debugdraw_lines")
+				, true
+				);
+
+			m_program[Program::FillLitInstanced] = bgfx::createProgram(
+				  vshLit
+				, bgfx::createEmbeddedShader(s_embeddedShaders, type, "fs_debugdraw_fill_lit_instanced")
+				, true
+				);
+		}
+		else
+		{
+			if (bgfx::isValid(vsh) )
+			{
+				bgfx::destroy(vsh);
+			}
+
+			if (bgfx::isValid(vshLit) )
+			{
+				bgfx::destroy(vshLit);
+			}
+		}
+
 		u_params   = bgfx::createUniform("u_params",   bgfx::UniformType::Vec4, 4);
 		s_texColor = bgfx::createUniform("s_texColor", bgfx::UniformType::Sampler);
 		m_texture  = bgfx::createTexture2D(SPRITE_TEXTURE_SIZE, SPRITE_TEXTURE_SIZE, false, 1, bgfx::TextureFormat::BGRA8);
@@ -968,7 +1028,10 @@ struct DebugDrawShared
 		bgfx::destroy(m_vbh);
 		for (uint32_t ii = 0; ii < Program::Count; ++ii)
 		{
-			bgfx::destroy(m_program[ii]);
+			if (bgfx::isValid(m_program[ii]) )
+			{
+				bgfx::destroy(m_program[ii]);
+			}
 		}
 		bgfx::destroy(u_params);
 		bgfx::destroy(s_texColor);
@@ -1030,10 +1093,25 @@ struct DebugDrawShared
 
 static DebugDrawShared s_dds;
 
+/// Per-shape instance data, laid out as i_data0-4. Columns 0-2 hold rotation/scale
+/// of the shape matrix in xyz and translation of the second shape matrix (cone,
+/// cylinder and capsule end point) in w.
+struct DebugInstance
+{
+	float m_col[3][4];
+	float m_translate[4];
+	float m_color[4];
+};
+
+BX_STATIC_ASSERT(sizeof(DebugInstance) == 80, "Instance data must fit i_data0-4.");
+
 struct DebugDrawEncoderImpl
 {
 	DebugDrawEncoderImpl()
-		: m_depthTestLess(true)
+		: m_instance(NULL)
+		, m_instanceBucket(NULL)
+		, m_depthTestLess(true)
+		, m_instancing(false)
 		, m_state(State::Count)
 		, m_defaultEncoder(NULL)
 	{
@@ -1042,10 +1120,30 @@ struct DebugDrawEncoderImpl
 	void init(bgfx::Encoder* _encoder)
 	{
 		m_defaultEncoder = _encoder;
+
+		m_instancing = 0 != (bgfx::getCaps()->supported & BGFX_CAPS_INSTANCING)
+			&& bgfx::isValid(s_dds.m_program[Program::FillLitInstanced])
+			;
+		if (m_instancing)
+		{
+			m_instance = (DebugInstance*)BX_ALLOC(s_dds.m_allocator
+				, kInstanceCacheSize * (sizeof(DebugInstance) + sizeof(uint8_t) )
+				);
+			m_instanceBucket = (uint8_t*)&m_instance[kInstanceCacheSize];
+		}
+
+		m_instancePos = 0;
+		m_numBuckets  = 0;
 	}
 
 	void shutdown()
 	{
+		if (NULL != m_instance)
+		{
+			BX_FREE(s_dds.m_allocator, m_instance);
+			m_instance       = NULL;
+			m_instanceBucket = NULL;
+		}
 	}
 
 	void begin(bgfx::ViewId _viewId, bool _depthTestLess, bgfx::Encoder* _encoder)
@@ -1088,6 +1186,7 @@ struct DebugDrawEncoderImpl
 
 		flushQuad();
 		flush();
+		flushInstances();
 
 		m_encoder = NULL;
 		m_state   = State::Count;
@@ -1218,6 +1317,16 @@ struct DebugDrawEncoderImpl
 		pushTranslate(_pos.x, _pos.y, _pos.z);
 	}
 
+	void setInstancing(bool _instancing)
+	{
+		if (!_instancing)
+		{
+			flushInstances();
+		}
+
+		m_instancing = _instancing && NULL != m_instance;
+	}
+
 	void setState(bool _depthTest, bool _depthWrite, bool _clockwise)
 	{
 		const uint64_t depthTest = m_depthTestLess
@@ -1530,11 +1639,27 @@ struct DebugDrawEncoderImpl
 		}
 	}
 
-	void setUParams(const Attrib& _attrib, bool _wireframe)
+	static uint64_t getFillState(const Attrib& _attrib, bool _wireframe)
 	{
-		const float flip = 0 == (_attrib.m_state & BGFX_STATE_CULL_CCW) ? 1.0f : -1.0f;
 		const uint8_t alpha = _attrib.m_abgr >> 24;
 
+		return 0
+			| _attrib.m_state
+			| (_wireframe ? BGFX_STATE_PT_LINES | BGFX_STATE_LINEAA | BGFX_STATE_BLEND_ALPHA
+			: (alpha < 0xff) ? BGFX_STATE_BLEND_ALPHA : 0)
+			;
+	}
+
+	void setUParams(const Attrib& _attrib, bool _wireframe)
+	{
+		setUParams(getFillState(_attrib, _wireframe), _attrib.m_abgr);
+	}
+
+	void setUParams(uint64_t _state, uint32_t _abgr)
+	{
+		const float flip = 0 == (_state & BGFX_STATE_CULL_CCW) ? 1.0f : -1.0f;
+		const uint8_t alpha = _abgr >> 24;
+
 		float params[4][4] =
 		{
 			{ // lightDir
@@ -1556,9 +1681,9 @@ struct DebugDrawEncoderImpl
 				0.0f, // unused
 			},
 			{ // matColor
-				( (_attrib.m_abgr)       & 0xff) / 255.0f,
-				( (_attrib.m_abgr >> 8)  & 0xff) / 255.0f,
-				( (_attrib.m_abgr >> 16) & 0xff) / 255.0f,
+				( (_abgr)       & 0xff) / 255.0f,
+				( (_abgr >> 8)  & 0xff) / 255.0f,
+				( (_abgr >> 16) & 0xff) / 255.0f,
 				(alpha) / 255.0f,
 			},
 		};
@@ -1566,11 +1691,7 @@ struct DebugDrawEncoderImpl
 		bx::store(params[0], bx::normalize(bx::load<bx::Vec3>(params[0]) ) );
 		m_encoder->setUniform(s_dds.u_params, params, 4);
 
-		m_encoder->setState(0
-			| _attrib.m_state
-			| (_wireframe ? BGFX_STATE_PT_LINES | BGFX_STATE_LINEAA | BGFX_STATE_BLEND_ALPHA
-			: (alpha < 0xff) ? BGFX_STATE_BLEND_ALPHA : 0)
-			);
+		m_encoder->setState(_state);
 	}
 
 	void draw(GeometryHandle _handle)
@@ -2127,6 +2248,12 @@ struct DebugDrawEncoderImpl
 
 	void draw(DebugMesh::Enum _mesh, const float* _mtx, uint16_t _num, bool _wireframe)
 	{
+		if (m_instancing
+		&&  drawInstanced(_mesh, _mtx, _num, _wireframe) )
+		{
+			return;
+		}
+
 		pushTransform(_mtx, _num, false /* flush */);
 
 		const DebugMesh& mesh = s_dds.m_mesh[_mesh];
@@ -2151,6 +2278,175 @@ struct DebugDrawEncoderImpl
 		popTransform(false /* flush */);
 	}
 
+	bool drawInstanced(DebugMesh::Enum _mesh, const float* _mtx, uint16_t _num, bool _wireframe)
+	{
+		if (2 < _num)
+		{
+			return false;
+		}
+
+		float mtx[2][16];
+
+		const MatrixStack& stack = m_mtxStack[m_mtxStackCurrent];
+		for (uint16_t ii = 0; ii < _num; ++ii)
+		{
+			if (NULL == stack.data)
+			{
+				bx::memCopy(mtx[ii], &_mtx[ii*16], 64);
+			}
+			else
+			{
+				bx::mtxMul(mtx[ii], &_mtx[ii*16], stack.data);
+			}
+		}
+
+		const float* mtx0 = mtx[0];
+		const float* mtx1 = mtx[_num-1];
+
+		// Instance data stores affine 3x4 matrix, and second matrix may only
+		// differ in translation. Anything else goes through immediate path.
+		if (0.0f != mtx0[3]
+		||  0.0f != mtx0[7]
+		||  0.0f != mtx0[11]
+		||  1.0f != mtx0[15]
+		||  0    != bx::memCmp(mtx0, mtx1, 12*sizeof(float) ) )
+		{
+			return false;
+		}
+
+		if (m_instancePos == kInstanceCacheSize)
+		{
+			flushInstances();
+		}
+
+		const Attrib& attrib = m_attrib[m_stack];
+		const uint64_t state = getFillState(attrib, _wireframe);
+
+		uint8_t bucket = findBucket(_mesh, _wireframe, state);
+		if (UINT8_MAX == bucket)
+		{
+			flushInstances();
+			bucket = findBucket(_mesh, _wireframe, state);
+		}
+
+		DebugInstance& instance = m_instance[m_instancePos];
+		m_instanceBucket[m_instancePos] = bucket;
+		m_instancePos++;
+		m_bucket[bucket].m_num++;
+
+		for (uint32_t ii = 0; ii < 3; ++ii)
+		{
+			instance.m_col[ii][0] = mtx0[ii*4+0];
+			instance.m_col[ii][1] = mtx0[ii*4+1];
+			instance.m_col[ii][2] = mtx0[ii*4+2];
+			instance.m_col[ii][3] = mtx1[12+ii];
+		}
+
+		instance.m_translate[0] = mtx0[12];
+		instance.m_translate[1] = mtx0[13];
+		instance.m_translate[2] = mtx0[14];
+		instance.m_translate[3] = 1.0f;
+
+		instance.m_color[0] = ( (attrib.m_abgr)       & 0xff) / 255.0f;
+		instance.m_color[1] = ( (attrib.m_abgr >> 8)  & 0xff) / 255.0f;
+		instance.m_color[2] = ( (attrib.m_abgr >> 16) & 0xff) / 255.0f;
+		instance.m_color[3] = ( (attrib.m_abgr >> 24) & 0xff) / 255.0f;
+
+		return true;
+	}
+
+	uint8_t findBucket(DebugMesh::Enum _mesh, bool _wireframe, uint64_t _state)
+	{
+		for (uint8_t ii = 0; ii < m_numBuckets; ++ii)
+		{
+			const InstanceBucket& bucket = m_bucket[ii];
+			if (bucket.m_state     == _state
+			&&  bucket.m_mesh      == _mesh
+			&&  bucket.m_wireframe == _wireframe)
+			{
+				return ii;
+			}
+		}
+
+		if (m_numBuckets == kInstanceBucketSize)
+		{
+			return UINT8_MAX;
+		}
+
+		InstanceBucket& bucket = m_bucket[m_numBuckets];
+		bucket.m_state     = _state;
+		bucket.m_num       = 0;
+		bucket.m_mesh      = uint8_t(_mesh);
+		bucket.m_wireframe = _wireframe;
+
+		return m_numBuckets++;
+	}
+
+	void flushInstances()
+	{
+		if (0 == m_instancePos)
+		{
+			return;
+		}
+
+		const uint16_t stride = uint16_t(sizeof(DebugInstance) );
+
+		bgfx::InstanceDataBuffer idb[kInstanceBucketSize];
+		uint8_t*  data[kInstanceBucketSize];
+		uint32_t  avail[kInstanceBucketSize];
+
+		for (uint8_t ii = 0; ii < m_numBuckets; ++ii)
+		{
+			avail[ii] = bgfx::getAvailInstanceDataBuffer(m_bucket[ii].m_num, stride);
+			data[ii]  = NULL;
+
+			if (0 != avail[ii])
+			{
+				bgfx::allocInstanceDataBuffer(&idb[ii], avail[ii], stride);
+				data[ii] = idb[ii].data;
+			}
+		}
+
+		for (uint32_t ii = 0; ii < m_instancePos; ++ii)
+		{
+			const uint8_t bucket = m_instanceBucket[ii];
+			if (0 != avail[bucket])
+			{
+				bx::memCopy(data[bucket], &m_instance[ii], stride);
+				data[bucket] += stride;
+				avail[bucket]--;
+			}
+		}
+
+		for (uint8_t ii = 0; ii < m_numBuckets; ++ii)
+		{
+			if (NULL == data[ii])
+			{
+				continue;
+			}
+
+			const InstanceBucket& bucket = m_bucket[ii];
+			const DebugMesh& mesh = s_dds.m_mesh[bucket.m_mesh];
+
+			if (0 != mesh.m_numIndices[bucket.m_wireframe])
+			{
+				m_encoder->setIndexBuffer(s_dds.m_ibh
+					, mesh.m_startIndex[bucket.m_wireframe]
+					, mesh.m_numIndices[bucket.m_wireframe]
+					);
+			}
+
+			setUParams(bucket.m_state, UINT32_MAX);
+
+			m_encoder->setVertexBuffer(0, s_dds.m_vbh, mesh.m_startVertex, mesh.m_numVertices);
+			m_encoder->setInstanceDataBuffer(&idb[ii]);
+			m_encoder->submit(m_viewId, s_dds.m_program[bucket.m_wireframe ? Program::FillInstanced : Program::FillLitInstanced]);
+		}
+
+		m_instancePos = 0;
+		m_numBuckets  = 0;
+	}
+
 	void softFlush()
 	{
 		if (m_pos == uint16_t(BX_COUNTOF(m_cache) ) )
@@ -2253,8 +2549,18 @@ struct DebugDrawEncoderImpl
 	static const uint32_t kCacheSize = 1024;
 	static const uint32_t kStackSize = 16;
 	static const uint32_t kCacheQuadSize = 1024;
+	static const uint32_t kInstanceCacheSize = 4096;
+	static const uint8_t  kInstanceBucketSize = 16;
 	BX_STATIC_ASSERT(kCacheSize >= 3, "Cache must be at least 3 elements.");
 
+	struct InstanceBucket
+	{
+		uint64_t m_state;
+		uint32_t m_num;
+		uint8_t  m_mesh;
+		bool     m_wireframe;
+	};
+
 	DebugVertex   m_cache[kCacheSize+1];
 	DebugUvVertex m_cacheQuad[kCacheQuadSize];
 	uint16_t m_indices[kCacheSize*2];
@@ -2264,6 +2570,12 @@ struct DebugDrawEncoderImpl
 	uint16_t m_vertexPos;
 	uint32_t m_mtxStackCurrent;
 
+	DebugInstance* m_instance;
+	uint8_t*       m_instanceBucket;
+	uint32_t       m_instancePos;
+	InstanceBucket m_bucket[kInstanceBucketSize];
+	uint8_t        m_numBuckets;
+
 	struct MatrixStack
 	{
 		void reset()
@@ -2283,6 +2595,7 @@ struct DebugDrawEncoderImpl
 	bgfx::ViewId m_viewId;
 	uint8_t m_stack;
 	bool    m_depthTestLess;
+	bool    m_instancing;
 
 	Attrib m_attrib[kStackSize];
 
@@ -2364,6 +2677,11 @@ void DebugDrawEncoder::setDepthTestLess(bool _depthTestLess)
 	DEBUG_DRAW_ENCODER(setDepthTestLess(_depthTestLess) );
 }
 
+void DebugDrawEncoder::setInstancing(bool _instancing)
+{
+	DEBUG_DRAW_ENCODER(setInstancing(_instancing) );
+}
+
 void DebugDrawEncoder::setState(bool _depthTest, bool _depthWrite, bool _clockwise)
 {
 	DEBUG_DRAW_ENCODER(setState(_depthTest, _depthWrite, _clockwise) );
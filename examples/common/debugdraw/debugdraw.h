@@ -75,6 +75,11 @@ struct DebugDrawEncoder
 	///
 	void setDepthTestLess(bool _depthTestLess);
 
+	/// Batch shapes (sphere, cone, cylinder, capsule, cube) into instanced draws
+	/// submitted at `end()`. Enabled by default when instancing is supported.
+	/// Disable to submit each shape immediately with its own transform.
+	void setInstancing(bool _instancing);
+
 	///
 	void setState(bool _depthTest, bool _depthWrite, bool _clockwise);
 
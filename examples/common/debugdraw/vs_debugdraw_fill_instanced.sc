@@ -0,0 +1,26 @@
+$input a_position, a_indices, i_data0, i_data1, i_data2, i_data3, i_data4
+$output v_color0
+
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bgfx_shader.sh>
+
+void main()
+{
+	// i_data0-2.xyz are rotation/scale columns, i_data3 is translation of the
+	// first matrix, and i_data0-2.w is translation of the second matrix.
+	vec4 translate = mix(i_data3, vec4(i_data0.w, i_data1.w, i_data2.w, 1.0), float(a_indices.x) );
+	mat4 model = mtxFromCols(
+		  vec4(i_data0.xyz, 0.0)
+		, vec4(i_data1.xyz, 0.0)
+		, vec4(i_data2.xyz, 0.0)
+		, translate
+		);
+
+	vec4 world = mul(model, vec4(a_position, 1.0) );
+	gl_Position = mul(u_viewProj, world);
+	v_color0 = i_data4;
+}
@@ -323,6 +323,30 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 
 				return bx::kExitSuccess;
 			}
+			else if (0 == bx::strCmp(_argv[1], "trace") )
+			{
+				uint32_t numFrames = 8;
+				if (_argc > 3)
+				{
+					bx::fromString(&numFrames, _argv[3]);
+				}
+
+				if (_argc > 2)
+				{
+					bgfx::requestTrace(_argv[2], numFrames);
+				}
+				else
+				{
+					time_t tt;
+					time(&tt);
+
+					char filePath[256];
+					bx::snprintf(filePath, sizeof(filePath), "temp/trace-%d.json", tt);
+					bgfx::requestTrace(filePath, numFrames);
+				}
+
+				return bx::kExitSuccess;
+			}
 			else if (0 == bx::strCmp(_argv[1], "fullscreen") )
 			{
 				WindowHandle window = { 0 };
@@ -359,6 +383,7 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 		{ entry::Key::F10,          entry::Modifier::None,      1, NULL, "graphics hidpi"                    },
 		{ entry::Key::Print,        entry::Modifier::None,      1, NULL, "graphics screenshot"               },
 		{ entry::Key::KeyP,         entry::Modifier::LeftCtrl,  1, NULL, "graphics screenshot"               },
+		{ entry::Key::KeyT,         entry::Modifier::LeftCtrl,  1, NULL, "graphics trace"                    },
 
 		INPUT_BINDING_END
 	};
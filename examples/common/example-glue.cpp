@@ -447,10 +447,18 @@ void showExampleDialog(entry::AppI* _app, const char* _errorText)
 
 									if (bar(cpuWidth, maxWidth, itemHeight, cpuColor) )
 									{
-										ImGui::SetTooltip("View %d \"%s\", CPU: %f [ms]"
+										ImGui::SetTooltip("View %d \"%s\", CPU: %f [ms]\n"
+											"Draw: %d, Compute: %d, Blit: %d, Dropped: %d\n"
+											"Instances: %d, State changes: %d"
 											, pos
 											, viewStats.name
 											, cpuTimeElapsed
+											, viewStats.numDraw
+											, viewStats.numCompute
+											, viewStats.numBlit
+											, viewStats.numDropped
+											, viewStats.numInstances
+											, viewStats.numStateChanges
 											);
 									}
 
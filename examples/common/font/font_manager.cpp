@@ -4,6 +4,9 @@
  */
 
 #include <bx/bx.h>
+#include <bx/mutex.h>
+#include <bx/semaphore.h>
+#include <bx/thread.h>
 
 #include <stb/stb_truetype.h>
 
@@ -16,8 +19,11 @@
 
 #include <wchar.h> // wcslen
 
+#include <algorithm>
+
 #include <tinystl/allocator.h>
 #include <tinystl/unordered_map.h>
+#include <tinystl/vector.h>
 namespace stl = tinystl;
 
 #include "font_manager.h"
@@ -38,6 +44,10 @@ public:
 	/// return the font descriptor of the current font
 	FontInfo getFontInfo();
 
+	/// fill GlyphInfo metrics without rasterizing the glyph
+	/// @remark bitmap baked by bakeGlyphAlpha/bakeGlyphDistance has the same size
+	void getGlyphMetrics(CodePoint _codePoint, bool _distance, GlyphInfo& _outGlyphInfo);
+
 	/// raster a glyph as 8bit alpha to a memory buffer
 	/// update the GlyphInfo according to the raster strategy
 	/// @ remark buffer min size: glyphInfo.m_width * glyphInfo * height * sizeof(char)
@@ -103,14 +113,16 @@ FontInfo TrueTypeFont::getFontInfo()
 	return outFontInfo;
 }
 
-bool TrueTypeFont::bakeGlyphAlpha(CodePoint _codePoint, GlyphInfo& _glyphInfo, uint8_t* _outBuffer)
+#define SDF_PADDING 6
+
+void TrueTypeFont::getGlyphMetrics(CodePoint _codePoint, bool _distance, GlyphInfo& _glyphInfo)
 {
 	BX_ASSERT(m_font != NULL, "TrueTypeFont not initialized");
 
-	int xx;
-	int yy;
-	int ww;
-	int hh;
+	int x0;
+	int y0;
+	int x1;
+	int y1;
 	int advance;
 	int ascent;
 	int descent;
@@ -121,59 +133,59 @@ bool TrueTypeFont::bakeGlyphAlpha(CodePoint _codePoint, GlyphInfo& _glyphInfo, u
 
 	stbtt_GetFontVMetrics(&m_font, &ascent, &descent, &lineGap);
 	stbtt_GetCodepointHMetrics(&m_font, _codePoint, &advance, &lsb);
-	stbtt_GetCodepointBitmap(&m_font, scale, scale, _codePoint, &ww, &hh, &xx, &yy);
+	stbtt_GetCodepointBitmapBox(&m_font, _codePoint, scale, scale, &x0, &y0, &x1, &y1);
+
+	const int32_t ww = x1 - x0;
+	const int32_t hh = y1 - y0;
 
-	_glyphInfo.offset_x = (float)xx;
-	_glyphInfo.offset_y = (float)yy;
+	_glyphInfo.offset_x = (float)x0;
+	_glyphInfo.offset_y = (float)y0;
 	_glyphInfo.width = (float)ww;
 	_glyphInfo.height = (float)hh;
 	_glyphInfo.advance_x = bx::round(((float)advance) * scale);
 	_glyphInfo.advance_y = bx::round(((float)(ascent + descent + lineGap)) * scale);
 
+	if (_distance
+	&&  ww * hh > 0)
+	{
+		_glyphInfo.offset_x -= (float)SDF_PADDING;
+		_glyphInfo.offset_y -= (float)SDF_PADDING;
+		_glyphInfo.width  += (float)(SDF_PADDING * 2);
+		_glyphInfo.height += (float)(SDF_PADDING * 2);
+	}
+}
+
+bool TrueTypeFont::bakeGlyphAlpha(CodePoint _codePoint, GlyphInfo& _glyphInfo, uint8_t* _outBuffer)
+{
+	getGlyphMetrics(_codePoint, false, _glyphInfo);
+
+	int32_t ww = (int32_t)_glyphInfo.width;
+	int32_t hh = (int32_t)_glyphInfo.height;
+
 	uint32_t bpp = 1;
 	uint32_t dstPitch = ww * bpp;
 
-	stbtt_MakeCodepointBitmap(&m_font, _outBuffer, ww, hh, dstPitch, scale, scale, _codePoint);
+	stbtt_MakeCodepointBitmap(&m_font, _outBuffer, ww, hh, dstPitch, m_scale, m_scale, _codePoint);
 
 	return true;
 }
 
 bool TrueTypeFont::bakeGlyphDistance(CodePoint _codePoint, GlyphInfo& _glyphInfo, uint8_t* _outBuffer)
 {
-	BX_ASSERT(m_font != NULL, "TrueTypeFont not initialized");
+	getGlyphMetrics(_codePoint, false, _glyphInfo);
 
-	int32_t xx;
-	int32_t yy;
-	int32_t ww;
-	int32_t hh;
-	int advance;
-	int ascent;
-	int descent;
-	int lineGap;
-	int lsb;
-
-	float scale = m_scale;
-
-	stbtt_GetFontVMetrics(&m_font, &ascent, &descent, &lineGap);
-	stbtt_GetCodepointHMetrics(&m_font, _codePoint, &advance, &lsb);
-	stbtt_GetCodepointBitmap(&m_font, scale, scale, _codePoint, &ww, &hh, &xx, &yy);
-
-	_glyphInfo.offset_x = (float)xx;
-	_glyphInfo.offset_y = (float)yy;
-	_glyphInfo.width = (float)ww;
-	_glyphInfo.height = (float)hh;
-	_glyphInfo.advance_x = bx::round(((float)advance) * scale);
-	_glyphInfo.advance_y = bx::round(((float)(ascent + descent + lineGap)) * scale);
+	int32_t ww = (int32_t)_glyphInfo.width;
+	int32_t hh = (int32_t)_glyphInfo.height;
 
 	uint32_t bpp = 1;
 	uint32_t dstPitch = ww * bpp;
 
-	stbtt_MakeCodepointBitmap(&m_font, _outBuffer, ww, hh, dstPitch, scale, scale, _codePoint);
+	stbtt_MakeCodepointBitmap(&m_font, _outBuffer, ww, hh, dstPitch, m_scale, m_scale, _codePoint);
 
 	if (ww * hh > 0)
 	{
-		uint32_t dw = 6;
-		uint32_t dh = 6;
+		uint32_t dw = SDF_PADDING;
+		uint32_t dh = SDF_PADDING;
 
 		uint32_t nw = ww + dw * 2;
 		uint32_t nh = hh + dh * 2;
@@ -224,26 +236,153 @@ struct FontManager::CachedFont
 
 #define MAX_FONT_BUFFER_SIZE (512 * 512 * 4)
 
-FontManager::FontManager(Atlas* _atlas)
+struct BakeJob
+{
+	TrueTypeFont* trueTypeFont;
+	CodePoint codePoint;
+	bool distance;
+	AtlasRegion region;
+	uint8_t* buffer;
+};
+
+// Glyph bitmaps are baked on worker threads. Jobs are pushed to pending
+// queue, and baked bitmaps are picked up from done queue by the main thread
+// in FontManager::update(), which writes them to atlas.
+struct FontManager::BakeQueue
+{
+	BakeQueue(uint32_t _numThreads)
+		: numThreads(bx::min<uint32_t>(_numThreads, MAX_BAKE_THREADS) )
+		, numPending(0)
+		, exit(false)
+	{
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			thread[ii].init(threadFunc, this, 0, "font");
+		}
+	}
+
+	~BakeQueue()
+	{
+		{
+			bx::MutexScope scope(mutex);
+			exit = true;
+		}
+
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			work.post();
+		}
+
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			thread[ii].shutdown();
+		}
+
+		for (uint32_t ii = 0, num = uint32_t(done.size() ); ii < num; ++ii)
+		{
+			delete [] done[ii].buffer;
+		}
+	}
+
+	void push(const BakeJob& _job)
+	{
+		{
+			bx::MutexScope scope(mutex);
+			pending.push_back(_job);
+		}
+
+		++numPending;
+		work.post();
+	}
+
+	static int32_t threadFunc(bx::Thread* /*_thread*/, void* _userData)
+	{
+		BakeQueue* queue = (BakeQueue*)_userData;
+
+		for (;;)
+		{
+			queue->work.wait();
+
+			BakeJob job;
+
+			{
+				bx::MutexScope scope(queue->mutex);
+
+				if (queue->pending.empty() )
+				{
+					if (queue->exit)
+					{
+						return 0;
+					}
+
+					continue;
+				}
+
+				job = queue->pending.back();
+				queue->pending.pop_back();
+			}
+
+			GlyphInfo glyphInfo;
+			if (job.distance)
+			{
+				job.trueTypeFont->bakeGlyphDistance(job.codePoint, glyphInfo, job.buffer);
+			}
+			else
+			{
+				job.trueTypeFont->bakeGlyphAlpha(job.codePoint, glyphInfo, job.buffer);
+			}
+
+			{
+				bx::MutexScope scope(queue->mutex);
+				queue->done.push_back(job);
+			}
+
+			queue->finished.post();
+		}
+	}
+
+	typedef stl::vector<BakeJob> JobArray;
+
+	bx::Thread thread[MAX_BAKE_THREADS];
+	bx::Semaphore work;
+	bx::Semaphore finished;
+	bx::Mutex mutex;
+	JobArray pending;
+	JobArray done;
+	uint32_t numThreads;
+	uint32_t numPending; // Jobs pushed and not yet picked up from done queue, main thread only.
+	bool exit;
+};
+
+FontManager::FontManager(Atlas* _atlas, uint32_t _numBakeThreads)
 	: m_ownAtlas(false)
 	, m_atlas(_atlas)
 {
-	init();
+	init(_numBakeThreads);
 }
 
-FontManager::FontManager(uint16_t _textureSideWidth)
+FontManager::FontManager(uint16_t _textureSideWidth, uint32_t _numBakeThreads)
 	: m_ownAtlas(true)
 	, m_atlas(new Atlas(_textureSideWidth) )
 {
-	init();
+	init(_numBakeThreads);
 }
 
-void FontManager::init()
+void FontManager::init(uint32_t _numBakeThreads)
 {
 	m_cachedFiles = new CachedFile[MAX_OPENED_FILES];
 	m_cachedFonts = new CachedFont[MAX_OPENED_FONT];
 	m_buffer = new uint8_t[MAX_FONT_BUFFER_SIZE];
 
+	m_bakeQueue = 0 < _numBakeThreads
+		? new BakeQueue(_numBakeThreads)
+		: NULL
+		;
+
+	m_regionUse = new uint32_t[m_atlas->getMaxRegionCount()];
+	bx::memSet(m_regionUse, 0, m_atlas->getMaxRegionCount() * sizeof(uint32_t) );
+	m_tick = 0;
+
 	const uint32_t W = 3;
 	// Create filler rectangle
 	uint8_t buffer[W * W * 4];
@@ -258,6 +397,9 @@ void FontManager::init()
 
 FontManager::~FontManager()
 {
+	delete m_bakeQueue;
+	delete [] m_regionUse;
+
 	BX_ASSERT(m_fontHandles.getNumHandles() == 0, "All the fonts must be destroyed before destroying the manager");
 	delete [] m_cachedFonts;
 
@@ -287,6 +429,7 @@ TrueTypeHandle FontManager::createTtf(const uint8_t* _buffer, uint32_t _size)
 void FontManager::destroyTtf(TrueTypeHandle _handle)
 {
 	BX_ASSERT(bgfx::isValid(_handle), "Invalid handle used");
+	waitBakes();
 	delete m_cachedFiles[_handle.idx].buffer;
 	m_cachedFiles[_handle.idx].bufferSize = 0;
 	m_cachedFiles[_handle.idx].buffer = NULL;
@@ -357,6 +500,7 @@ void FontManager::destroyFont(FontHandle _handle)
 
 	if (font.trueTypeFont != NULL)
 	{
+		waitBakes();
 		delete font.trueTypeFont;
 		font.trueTypeFont = NULL;
 	}
@@ -403,29 +547,63 @@ bool FontManager::preloadGlyph(FontHandle _handle, CodePoint _codePoint)
 	{
 		GlyphInfo glyphInfo;
 
+		bool distance = false;
 		switch (font.fontInfo.fontType)
 		{
 		case FONT_TYPE_ALPHA:
-			font.trueTypeFont->bakeGlyphAlpha(_codePoint, glyphInfo, m_buffer);
 			break;
 
 		case FONT_TYPE_DISTANCE:
-			font.trueTypeFont->bakeGlyphDistance(_codePoint, glyphInfo, m_buffer);
-			break;
-
 		case FONT_TYPE_DISTANCE_SUBPIXEL:
-			font.trueTypeFont->bakeGlyphDistance(_codePoint, glyphInfo, m_buffer);
+			distance = true;
 			break;
 
 		default:
 			BX_ASSERT(false, "TextureType not supported yet");
 		}
 
-		if (!addBitmap(glyphInfo, m_buffer) )
+		if (NULL == m_bakeQueue)
 		{
-			return false;
+			if (distance)
+			{
+				font.trueTypeFont->bakeGlyphDistance(_codePoint, glyphInfo, m_buffer);
+			}
+			else
+			{
+				font.trueTypeFont->bakeGlyphAlpha(_codePoint, glyphInfo, m_buffer);
+			}
+
+			if (!addBitmap(glyphInfo, m_buffer)
+			&& (!evictGlyphs() || !addBitmap(glyphInfo, m_buffer) ) )
+			{
+				return false;
+			}
+		}
+		else
+		{
+			// Reserve cleared region now, bitmap is written to it in update()
+			// once baked.
+			font.trueTypeFont->getGlyphMetrics(_codePoint, distance, glyphInfo);
+
+			if (!addBitmap(glyphInfo, NULL)
+			&& (!evictGlyphs() || !addBitmap(glyphInfo, NULL) ) )
+			{
+				return false;
+			}
+
+			const AtlasRegion& region = m_atlas->getRegion(glyphInfo.regionIndex);
+
+			BakeJob job;
+			job.trueTypeFont = font.trueTypeFont;
+			job.codePoint = _codePoint;
+			job.distance  = distance;
+			job.region    = region;
+			job.buffer    = new uint8_t[bx::max<uint32_t>(region.width * region.height, 1)];
+			m_bakeQueue->push(job);
 		}
 
+		m_regionUse[glyphInfo.regionIndex] = ++m_tick;
+
 		glyphInfo.advance_x = (glyphInfo.advance_x * fontInfo.scale);
 		glyphInfo.advance_y = (glyphInfo.advance_y * fontInfo.scale);
 		glyphInfo.offset_x = (glyphInfo.offset_x * fontInfo.scale);
@@ -479,9 +657,110 @@ const GlyphInfo* FontManager::getGlyphInfo(FontHandle _handle, CodePoint _codePo
 	}
 
 	BX_ASSERT(it != cachedGlyphs.end(), "Failed to preload glyph.");
+
+	m_regionUse[it->second.regionIndex] = ++m_tick;
 	return &it->second;
 }
 
+void FontManager::update()
+{
+	if (NULL != m_bakeQueue)
+	{
+		BakeQueue::JobArray done;
+
+		{
+			bx::MutexScope scope(m_bakeQueue->mutex);
+			done.swap(m_bakeQueue->done);
+		}
+
+		for (uint32_t ii = 0, num = uint32_t(done.size() ); ii < num; ++ii)
+		{
+			const BakeJob& job = done[ii];
+			m_atlas->updateRegion(job.region, job.buffer);
+			delete [] job.buffer;
+		}
+
+		m_bakeQueue->numPending -= uint32_t(done.size() );
+	}
+
+	m_atlas->update();
+}
+
+void FontManager::waitBakes()
+{
+	if (NULL == m_bakeQueue)
+	{
+		return;
+	}
+
+	while (0 != m_bakeQueue->numPending)
+	{
+		m_bakeQueue->finished.wait();
+		update();
+	}
+}
+
+bool FontManager::evictGlyphs()
+{
+	// Regions can move during repack, make sure all bitmaps are in atlas first.
+	waitBakes();
+
+	stl::vector<uint16_t> regions;
+	for (uint16_t ii = 0, num = m_atlas->getRegionCount(); ii < num; ++ii)
+	{
+		if (0 != m_regionUse[ii])
+		{
+			regions.push_back(ii);
+		}
+	}
+
+	if (regions.empty() )
+	{
+		return false;
+	}
+
+	// Evict least recently used half of glyphs.
+	const uint32_t* regionUse = m_regionUse;
+	std::sort(regions.begin(), regions.end(), [regionUse](uint16_t _a, uint16_t _b)
+		{
+			return regionUse[_a] < regionUse[_b];
+		});
+
+	const uint32_t numEvict = bx::max<uint32_t>(uint32_t(regions.size() ) / 2, 1);
+	for (uint32_t ii = 0; ii < numEvict; ++ii)
+	{
+		const uint16_t region = regions[ii];
+		m_regionUse[region] = 0;
+		m_atlas->removeRegion(region);
+	}
+
+	// Scaled fonts share regions with their master font, drop every glyph
+	// referencing evicted region.
+	stl::vector<CodePoint> evicted;
+	for (uint16_t ii = 0, num = m_fontHandles.getNumHandles(); ii < num; ++ii)
+	{
+		CachedFont& font = m_cachedFonts[m_fontHandles.getHandleAt(ii)];
+
+		evicted.clear();
+		for (GlyphHashMap::iterator it = font.cachedGlyphs.begin(), itEnd = font.cachedGlyphs.end(); it != itEnd; ++it)
+		{
+			if (0 == m_regionUse[it->second.regionIndex])
+			{
+				evicted.push_back(it->first);
+			}
+		}
+
+		for (uint32_t jj = 0, numEvicted = uint32_t(evicted.size() ); jj < numEvicted; ++jj)
+		{
+			font.cachedGlyphs.erase(evicted[jj]);
+		}
+	}
+
+	m_atlas->repack();
+
+	return true;
+}
+
 bool FontManager::addBitmap(GlyphInfo& _glyphInfo, const uint8_t* _data)
 {
 	_glyphInfo.regionIndex = m_atlas->addRegion(
@@ -490,5 +769,6 @@ bool FontManager::addBitmap(GlyphInfo& _glyphInfo, const uint8_t* _data)
 		, _data
 		, AtlasRegion::TYPE_GRAY
 		);
-	return true;
+
+	return UINT16_MAX != _glyphInfo.regionIndex;
 }
@@ -14,6 +14,7 @@ class Atlas;
 
 #define MAX_OPENED_FILES 64
 #define MAX_OPENED_FONT  64
+#define MAX_BAKE_THREADS 8
 
 #define FONT_TYPE_ALPHA             UINT32_C(0x00000100) // L8
 // #define FONT_TYPE_LCD               UINT32_C(0x00000200) // BGRA8
@@ -122,11 +123,14 @@ class FontManager
 public:
 	/// Create the font manager using an external cube atlas (doesn't take
 	/// ownership of the atlas).
-	FontManager(Atlas* _atlas);
+	///
+	/// @param _numBakeThreads Number of worker threads baking glyph bitmaps.
+	///   When 0 glyphs are baked synchronously.
+	FontManager(Atlas* _atlas, uint32_t _numBakeThreads = 2);
 
 	/// Create the font manager and create the texture cube as BGRA8 with
 	/// linear filtering.
-	FontManager(uint16_t _textureSideWidth = 512);
+	FontManager(uint16_t _textureSideWidth = 512, uint32_t _numBakeThreads = 2);
 
 	~FontManager();
 
@@ -161,8 +165,17 @@ public:
 	bool preloadGlyph(FontHandle _handle, const wchar_t* _string);
 
 	/// Preload a single glyph, return true on success.
+	///
+	/// @remark Glyph metrics and atlas region are available immediately,
+	///   bitmap is baked on worker thread and appears in atlas after update().
+	///   When atlas is full, least recently used glyphs are evicted and atlas
+	///   is repacked, see Atlas::getGeneration().
 	bool preloadGlyph(FontHandle _handle, CodePoint _character);
 
+	/// Upload glyphs baked since last call to atlas. Call once per frame
+	/// before submitting text.
+	void update();
+
 	/// Return the font descriptor of a font.
 	///
 	/// @remark the handle is required to be valid
@@ -186,8 +199,12 @@ private:
 		uint32_t bufferSize;
 	};
 
-	void init();
+	struct BakeQueue;
+
+	void init(uint32_t _numBakeThreads);
 	bool addBitmap(GlyphInfo& _glyphInfo, const uint8_t* _data);
+	bool evictGlyphs();
+	void waitBakes();
 
 	bool m_ownAtlas;
 	Atlas* m_atlas;
@@ -202,6 +219,12 @@ private:
 
 	//temporary buffer to raster glyph
 	uint8_t* m_buffer;
+
+	BakeQueue* m_bakeQueue;
+
+	// last use tick of each atlas region holding glyph, 0 if region is not a glyph
+	uint32_t* m_regionUse;
+	uint32_t m_tick;
 };
 
 #endif // FONT_MANAGER_H_HEADER_GUARD
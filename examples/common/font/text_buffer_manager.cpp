@@ -692,6 +692,9 @@ void TextBufferManager::submitTextBuffer(TextBufferHandle _handle, bgfx::ViewId
 		return;
 	}
 
+	// Upload glyphs baked on worker threads.
+	m_fontManager->update();
+
 	bgfx::setTexture(0, s_texColor, m_fontManager->getAtlas()->getTextureHandle() );
 
 	bgfx::ProgramHandle program = BGFX_INVALID_HANDLE;
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+#include "mappedfile.h"
+#include "entry/entry.h"
+
+#include <bx/cpu.h>
+
+#include <stdio.h>
+
+#if BX_PLATFORM_WINDOWS
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif // NOMINMAX
+#	include <windows.h>
+#	include <io.h>
+#elif BX_PLATFORM_LINUX || BX_PLATFORM_OSX || BX_PLATFORM_BSD || BX_PLATFORM_ANDROID || BX_PLATFORM_IOS
+#	include <sys/mman.h>
+#endif // BX_PLATFORM_*
+
+MappedFile* mappedFileOpen(const char* _filePath)
+{
+	FILE* file = fopen(_filePath, "rb");
+	if (NULL == file)
+	{
+		return NULL;
+	}
+
+	fseek(file, 0, SEEK_END);
+	const long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	if (0 >= size)
+	{
+		fclose(file);
+		return NULL;
+	}
+
+	bx::AllocatorI* allocator = entry::getAllocator();
+
+	MappedFile* mf = BX_NEW(allocator, MappedFile);
+	mf->m_data     = NULL;
+	mf->m_size     = uint32_t(size);
+	mf->m_refCount = 1;
+	mf->m_mapping  = NULL;
+	mf->m_mapped   = false;
+
+#if BX_PLATFORM_WINDOWS
+	HANDLE handle  = (HANDLE)_get_osfhandle(_fileno(file) );
+	HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (NULL != mapping)
+	{
+		mf->m_data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (NULL == mf->m_data)
+		{
+			CloseHandle(mapping);
+		}
+		else
+		{
+			mf->m_mapping = mapping;
+		}
+	}
+#elif BX_PLATFORM_LINUX || BX_PLATFORM_OSX || BX_PLATFORM_BSD || BX_PLATFORM_ANDROID || BX_PLATFORM_IOS
+	void* ptr = mmap(NULL, size_t(size), PROT_READ, MAP_SHARED, fileno(file), 0);
+	if (MAP_FAILED != ptr)
+	{
+		mf->m_data = (const uint8_t*)ptr;
+	}
+#endif // BX_PLATFORM_*
+
+	mf->m_mapped = NULL != mf->m_data;
+
+	if (!mf->m_mapped)
+	{
+		uint8_t* data = (uint8_t*)BX_ALLOC(allocator, mf->m_size);
+		if (mf->m_size != fread(data, 1, mf->m_size, file) )
+		{
+			BX_FREE(allocator, data);
+			BX_DELETE(allocator, mf);
+			fclose(file);
+			return NULL;
+		}
+
+		mf->m_data = data;
+	}
+
+	// Mapping keeps file open.
+	fclose(file);
+
+	return mf;
+}
+
+void mappedFileAddRef(MappedFile* _file)
+{
+	bx::atomicFetchAndAdd<int32_t>(&_file->m_refCount, 1);
+}
+
+void mappedFileRelease(MappedFile* _file)
+{
+	if (1 != bx::atomicFetchAndSub<int32_t>(&_file->m_refCount, 1) )
+	{
+		return;
+	}
+
+	bx::AllocatorI* allocator = entry::getAllocator();
+
+	if (_file->m_mapped)
+	{
+#if BX_PLATFORM_WINDOWS
+		UnmapViewOfFile(_file->m_data);
+		CloseHandle( (HANDLE)_file->m_mapping);
+#elif BX_PLATFORM_LINUX || BX_PLATFORM_OSX || BX_PLATFORM_BSD || BX_PLATFORM_ANDROID || BX_PLATFORM_IOS
+		munmap(const_cast<uint8_t*>(_file->m_data), _file->m_size);
+#endif // BX_PLATFORM_*
+	}
+	else
+	{
+		BX_FREE(allocator, const_cast<uint8_t*>(_file->m_data) );
+	}
+
+	BX_DELETE(allocator, _file);
+}
+
+void mappedFileReleaseRef(void* /*_ptr*/, void* _userData)
+{
+	mappedFileRelease( (MappedFile*)_userData);
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef MAPPEDFILE_H_HEADER_GUARD
+#define MAPPEDFILE_H_HEADER_GUARD
+
+#include <bx/bx.h>
+
+/// Memory-mapped read-only file, or heap copy when mapping is not available.
+/// Reference counted, unmapped when last reference is released.
+struct MappedFile
+{
+	const uint8_t* m_data;
+	uint32_t m_size;
+	int32_t  m_refCount;
+	void*    m_mapping;
+	bool     m_mapped;
+};
+
+/// Returns NULL if file can't be opened or it's empty. Returned file has one reference.
+MappedFile* mappedFileOpen(const char* _filePath);
+
+///
+void mappedFileAddRef(MappedFile* _file);
+
+///
+void mappedFileRelease(MappedFile* _file);
+
+/// `bgfx::ReleaseFn` that releases file passed as user data. Add reference
+/// before passing memory to `bgfx::makeRef`.
+void mappedFileReleaseRef(void* _ptr, void* _userData);
+
+#endif // MAPPEDFILE_H_HEADER_GUARD
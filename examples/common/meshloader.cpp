@@ -0,0 +1,796 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+#include "mappedfile.h"
+#include "meshloader.h"
+#include "entry/entry.h"
+
+#include <bx/cpu.h>
+#include <bx/filepath.h>
+#include <bx/readerwriter.h>
+#include <bx/string.h>
+#include <bx/uint32_t.h>
+#include <meshoptimizer/src/meshoptimizer.h>
+
+#define BGFX_CHUNK_MAGIC_VB    BX_MAKEFOURCC('V', 'B', ' ', 0x1)
+#define BGFX_CHUNK_MAGIC_VBC   BX_MAKEFOURCC('V', 'B', 'C', 0x0)
+#define BGFX_CHUNK_MAGIC_IB    BX_MAKEFOURCC('I', 'B', ' ', 0x0)
+#define BGFX_CHUNK_MAGIC_IBC   BX_MAKEFOURCC('I', 'B', 'C', 0x1)
+#define BGFX_CHUNK_MAGIC_PRI   BX_MAKEFOURCC('P', 'R', 'I', 0x0)
+#define BGFX_CHUNK_MAGIC_VB32  BX_MAKEFOURCC('V', 'B', ' ', 0x2)
+#define BGFX_CHUNK_MAGIC_VBC32 BX_MAKEFOURCC('V', 'B', 'C', 0x1)
+#define BGFX_CHUNK_MAGIC_IB32  BX_MAKEFOURCC('I', 'B', ' ', 0x1)
+#define BGFX_CHUNK_MAGIC_IBC32 BX_MAKEFOURCC('I', 'B', 'C', 0x2)
+#define BGFX_CHUNK_MAGIC_LOD   BX_MAKEFOURCC('L', 'O', 'D', 0x0)
+#define BGFX_CHUNK_MAGIC_MSH   BX_MAKEFOURCC('M', 'S', 'H', 0x0)
+
+namespace bgfx
+{
+	int32_t read(bx::ReaderI* _reader, bgfx::VertexLayout& _layout, bx::Error* _err = NULL);
+}
+
+/// Bounds checked reader over mapped file.
+struct ChunkReader
+{
+	ChunkReader(const uint8_t* _data, uint32_t _size)
+		: m_data(_data)
+		, m_size(_size)
+		, m_pos(0)
+		, m_ok(true)
+	{
+	}
+
+	bool skip(uint64_t _size)
+	{
+		if (!m_ok
+		||  uint64_t(m_size - m_pos) < _size)
+		{
+			m_ok = false;
+			return false;
+		}
+
+		m_pos += uint32_t(_size);
+		return true;
+	}
+
+	template<typename Ty>
+	bool read(Ty& _value)
+	{
+		const uint32_t pos = m_pos;
+		if (skip(sizeof(Ty) ) )
+		{
+			bx::memCopy(&_value, &m_data[pos], sizeof(Ty) );
+			return true;
+		}
+
+		return false;
+	}
+
+	bool read(bgfx::VertexLayout& _layout)
+	{
+		if (!m_ok)
+		{
+			return false;
+		}
+
+		bx::MemoryReader reader(&m_data[m_pos], m_size - m_pos);
+		bx::Error err;
+		bgfx::read(&reader, _layout, &err);
+		m_ok = err.isOk();
+
+		return skip(uint64_t(bx::seek(&reader) ) );
+	}
+
+	bool isEnd() const
+	{
+		return m_size == m_pos;
+	}
+
+	const uint8_t* m_data;
+	uint32_t m_size;
+	uint32_t m_pos;
+	bool     m_ok;
+};
+
+struct MeshLoader::Request
+{
+	struct GroupLoad
+	{
+		GroupLoad()
+			: m_vbMagic(0)
+			, m_vbOffset(0)
+			, m_vbSize(0)
+			, m_ibMagic(0)
+			, m_ibOffset(0)
+			, m_ibSize(0)
+			, m_lodOffset(UINT32_MAX)
+			, m_meshletVertexOffset(0)
+			, m_numMeshletVertices(0)
+			, m_meshletTriangleOffset(0)
+			, m_numMeshletTriangles(0)
+			, m_vbMem(NULL)
+			, m_ibMem(NULL)
+			, m_lodMem(NULL)
+			, m_meshletMem(NULL)
+		{
+		}
+
+		Group m_group;
+		bgfx::VertexLayout m_layout;
+
+		uint32_t m_vbMagic;
+		uint32_t m_vbOffset;
+		uint32_t m_vbSize;
+		uint32_t m_ibMagic;
+		uint32_t m_ibOffset;
+		uint32_t m_ibSize;
+		uint32_t m_lodOffset;
+		uint32_t m_meshletVertexOffset;
+		uint32_t m_numMeshletVertices;
+		uint32_t m_meshletTriangleOffset;
+		uint32_t m_numMeshletTriangles;
+
+		const bgfx::Memory* m_vbMem;
+		const bgfx::Memory* m_ibMem;
+		const bgfx::Memory* m_lodMem;
+		const bgfx::Memory* m_meshletMem;
+	};
+
+	typedef stl::vector<GroupLoad> GroupLoadArray;
+
+	char       m_filePath[bx::kMaxFilePath];
+	MappedFile*  m_file;
+	GroupLoadArray m_groups;
+	MeshLoadFn m_fn;
+	void*      m_userData;
+	uint32_t   m_id;
+	int32_t    m_remaining;
+	int32_t    m_numErrors;
+	bool       m_ramcopy;
+};
+
+MeshLoader::MeshLoader(uint32_t _numThreads)
+	: m_jobHead(0)
+	, m_numThreads(bx::uint32_clamp(_numThreads, 1, kMaxThreads) )
+	, m_numPending(0)
+	, m_nextId(1)
+	, m_exit(false)
+{
+	for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+	{
+		m_thread[ii].init(workerThread, this, 0, "meshloader");
+	}
+}
+
+MeshLoader::~MeshLoader()
+{
+	{
+		bx::MutexScope scope(m_mutex);
+		m_exit = true;
+	}
+
+	m_work.post();
+
+	for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+	{
+		m_thread[ii].shutdown();
+	}
+
+	// Workers drain queue before exiting, all requests are completed here.
+	update();
+
+	for (MeshMap::iterator it = m_done.begin(), itEnd = m_done.end(); it != itEnd; ++it)
+	{
+		if (NULL != it->second)
+		{
+			meshUnload(it->second);
+		}
+	}
+
+	m_done.clear();
+}
+
+uint32_t MeshLoader::load(const char* _filePath, bool _ramcopy, MeshLoadFn _fn, void* _userData)
+{
+	Request* request = BX_NEW(entry::getAllocator(), Request);
+	bx::strCopy(request->m_filePath, BX_COUNTOF(request->m_filePath), _filePath);
+	request->m_file      = NULL;
+	request->m_fn        = _fn;
+	request->m_userData  = _userData;
+	request->m_id        = m_nextId++;
+	request->m_remaining = 0;
+	request->m_numErrors = 0;
+	request->m_ramcopy   = _ramcopy;
+
+	++m_numPending;
+
+	Job job;
+	job.m_request = request;
+	job.m_group   = UINT32_MAX;
+	push(job);
+
+	return request->m_id;
+}
+
+uint32_t MeshLoader::update()
+{
+	RequestArray completed;
+
+	{
+		bx::MutexScope scope(m_mutex);
+		completed.swap(m_completed);
+	}
+
+	for (RequestArray::iterator it = completed.begin(), itEnd = completed.end(); it != itEnd; ++it)
+	{
+		Request* request = *it;
+		const bool failed = 0 != request->m_numErrors;
+
+		Mesh* mesh = failed ? NULL : new Mesh;
+
+		for (uint32_t ii = 0, num = uint32_t(request->m_groups.size() ); ii < num; ++ii)
+		{
+			Request::GroupLoad& gl = request->m_groups[ii];
+			Group& group = gl.m_group;
+			const uint16_t ibFlags = group.m_index32 ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE;
+
+			// Memory passed to bgfx is released only by creating buffer, when loading failed
+			// buffers are created and destroyed right away.
+			if (NULL != gl.m_vbMem)
+			{
+				group.m_vbh = bgfx::createVertexBuffer(gl.m_vbMem, gl.m_layout);
+			}
+
+			if (NULL != gl.m_ibMem)
+			{
+				group.m_ibh = bgfx::createIndexBuffer(gl.m_ibMem, ibFlags);
+			}
+
+			if (NULL != gl.m_lodMem)
+			{
+				group.m_lodIbh = bgfx::createIndexBuffer(gl.m_lodMem, ibFlags);
+			}
+
+			if (NULL != gl.m_meshletMem)
+			{
+				group.m_meshletIbh = bgfx::createIndexBuffer(gl.m_meshletMem, ibFlags);
+			}
+
+			if (NULL != mesh)
+			{
+				mesh->m_layout = gl.m_layout;
+				mesh->m_groups.push_back(group);
+			}
+			else
+			{
+				Mesh temp;
+				temp.m_groups.push_back(group);
+				temp.unload();
+			}
+		}
+
+		if (NULL != request->m_file)
+		{
+			mappedFileRelease(request->m_file);
+		}
+
+		if (NULL != request->m_fn)
+		{
+			request->m_fn(mesh, request->m_filePath, request->m_userData);
+		}
+		else
+		{
+			m_done.insert(stl::make_pair(request->m_id, mesh) );
+		}
+
+		--m_numPending;
+
+		BX_DELETE(entry::getAllocator(), request);
+	}
+
+	return uint32_t(completed.size() );
+}
+
+bool MeshLoader::poll(uint32_t _id, Mesh** _mesh)
+{
+	MeshMap::iterator it = m_done.find(_id);
+	if (it == m_done.end() )
+	{
+		return false;
+	}
+
+	*_mesh = it->second;
+	m_done.erase(_id);
+
+	return true;
+}
+
+int32_t MeshLoader::workerThread(bx::Thread* /*_thread*/, void* _userData)
+{
+	MeshLoader* loader = (MeshLoader*)_userData;
+	return loader->worker();
+}
+
+int32_t MeshLoader::worker()
+{
+	for (;;)
+	{
+		m_work.wait();
+
+		Job job;
+		bool hasJob = false;
+
+		{
+			bx::MutexScope scope(m_mutex);
+
+			if (m_jobHead < m_jobs.size() )
+			{
+				job = m_jobs[m_jobHead];
+				++m_jobHead;
+
+				if (m_jobHead == m_jobs.size() )
+				{
+					m_jobs.clear();
+					m_jobHead = 0;
+				}
+
+				hasJob = true;
+			}
+			else if (m_exit)
+			{
+				// Wake next worker, it will exit too.
+				m_work.post();
+				return 0;
+			}
+		}
+
+		if (hasJob)
+		{
+			if (UINT32_MAX == job.m_group)
+			{
+				scan(job.m_request);
+			}
+			else
+			{
+				decode(job.m_request, job.m_group);
+			}
+		}
+	}
+}
+
+void MeshLoader::push(const Job& _job)
+{
+	{
+		bx::MutexScope scope(m_mutex);
+		m_jobs.push_back(_job);
+	}
+
+	m_work.post();
+}
+
+void MeshLoader::scan(Request* _request)
+{
+	MappedFile* mf = mappedFileOpen(_request->m_filePath);
+	if (NULL == mf)
+	{
+		DBG("Failed to open mesh '%s'.", _request->m_filePath);
+		_request->m_numErrors = 1;
+		complete(_request);
+		return;
+	}
+
+	_request->m_file = mf;
+
+	ChunkReader cr(mf->m_data, mf->m_size);
+	Request::GroupLoad gl;
+
+	while (cr.m_ok
+	&&    !cr.isEnd() )
+	{
+		uint32_t chunk;
+		cr.read(chunk);
+
+		Group& group = gl.m_group;
+
+		switch (chunk)
+		{
+		case BGFX_CHUNK_MAGIC_VB:
+		case BGFX_CHUNK_MAGIC_VB32:
+		case BGFX_CHUNK_MAGIC_VBC:
+		case BGFX_CHUNK_MAGIC_VBC32:
+			{
+				cr.read(group.m_sphere);
+				cr.read(group.m_aabb);
+				cr.read(group.m_obb);
+				cr.read(gl.m_layout);
+
+				if (BGFX_CHUNK_MAGIC_VB32  == chunk
+				||  BGFX_CHUNK_MAGIC_VBC32 == chunk)
+				{
+					cr.read(group.m_numVertices);
+				}
+				else
+				{
+					uint16_t numVertices = 0;
+					cr.read(numVertices);
+					group.m_numVertices = numVertices;
+				}
+
+				gl.m_vbMagic = chunk;
+
+				if (BGFX_CHUNK_MAGIC_VBC   == chunk
+				||  BGFX_CHUNK_MAGIC_VBC32 == chunk)
+				{
+					cr.read(gl.m_vbSize);
+				}
+				else
+				{
+					gl.m_vbSize = group.m_numVertices*gl.m_layout.getStride();
+				}
+
+				gl.m_vbOffset = cr.m_pos;
+				cr.skip(gl.m_vbSize);
+			}
+			break;
+
+		case BGFX_CHUNK_MAGIC_IB:
+		case BGFX_CHUNK_MAGIC_IB32:
+		case BGFX_CHUNK_MAGIC_IBC:
+		case BGFX_CHUNK_MAGIC_IBC32:
+			{
+				group.m_index32 = false
+					|| BGFX_CHUNK_MAGIC_IB32  == chunk
+					|| BGFX_CHUNK_MAGIC_IBC32 == chunk
+					;
+
+				cr.read(group.m_numIndices);
+
+				gl.m_ibMagic = chunk;
+
+				if (BGFX_CHUNK_MAGIC_IBC   == chunk
+				||  BGFX_CHUNK_MAGIC_IBC32 == chunk)
+				{
+					cr.read(gl.m_ibSize);
+				}
+				else
+				{
+					gl.m_ibSize = group.m_numIndices * (group.m_index32 ? 4 : 2);
+				}
+
+				gl.m_ibOffset = cr.m_pos;
+				cr.skip(gl.m_ibSize);
+			}
+			break;
+
+		case BGFX_CHUNK_MAGIC_LOD:
+			{
+				const uint32_t indexSize = group.m_index32 ? 4 : 2;
+
+				uint8_t numLods = 0;
+				cr.read(numLods);
+
+				gl.m_lodOffset = cr.m_pos;
+
+				uint32_t totalIndices = 0;
+				for (uint32_t ii = 0; ii < numLods && cr.m_ok; ++ii)
+				{
+					MeshLod lod;
+					cr.read(lod.m_error);
+					cr.read(lod.m_numIndices);
+					cr.skip(uint64_t(lod.m_numIndices)*indexSize);
+					lod.m_startIndex = totalIndices;
+					totalIndices += lod.m_numIndices;
+
+					group.m_lods.push_back(lod);
+				}
+			}
+			break;
+
+		case BGFX_CHUNK_MAGIC_MSH:
+			{
+				const uint32_t indexSize = group.m_index32 ? 4 : 2;
+
+				uint32_t numMeshlets = 0;
+				cr.read(numMeshlets);
+
+				// Reject count before resizing, meshlet header is 54 bytes.
+				if (!cr.m_ok
+				||  numMeshlets > (cr.m_size - cr.m_pos) / 54)
+				{
+					cr.m_ok = false;
+					break;
+				}
+
+				group.m_meshlets.resize(numMeshlets);
+				for (uint32_t ii = 0; ii < numMeshlets; ++ii)
+				{
+					Meshlet& meshlet = group.m_meshlets[ii];
+					uint32_t startTriangle = 0;
+					cr.read(meshlet.m_sphere);
+					cr.read(meshlet.m_coneApex);
+					cr.read(meshlet.m_coneAxis);
+					cr.read(meshlet.m_coneCutoff);
+					cr.read(meshlet.m_startVertex);
+					cr.read(startTriangle);
+					cr.read(meshlet.m_numVertices);
+					cr.read(meshlet.m_numTriangles);
+					meshlet.m_startIndex = startTriangle*3;
+				}
+
+				cr.read(gl.m_numMeshletVertices);
+				gl.m_meshletVertexOffset = cr.m_pos;
+				cr.skip(uint64_t(gl.m_numMeshletVertices)*indexSize);
+
+				cr.read(gl.m_numMeshletTriangles);
+				gl.m_meshletTriangleOffset = cr.m_pos;
+				cr.skip(uint64_t(gl.m_numMeshletTriangles)*3);
+
+				for (uint32_t ii = 0; ii < numMeshlets && cr.m_ok; ++ii)
+				{
+					const Meshlet& meshlet = group.m_meshlets[ii];
+					if (meshlet.m_startVertex + meshlet.m_numVertices > gl.m_numMeshletVertices
+					||  meshlet.m_startIndex/3 + meshlet.m_numTriangles > gl.m_numMeshletTriangles)
+					{
+						cr.m_ok = false;
+					}
+				}
+			}
+			break;
+
+		case BGFX_CHUNK_MAGIC_PRI:
+			{
+				uint16_t len = 0;
+				cr.read(len);
+				cr.skip(len);
+
+				uint16_t num = 0;
+				cr.read(num);
+
+				for (uint32_t ii = 0; ii < num && cr.m_ok; ++ii)
+				{
+					cr.read(len);
+					cr.skip(len);
+
+					Primitive prim;
+					cr.read(prim.m_startIndex);
+					cr.read(prim.m_numIndices);
+					cr.read(prim.m_startVertex);
+					cr.read(prim.m_numVertices);
+					cr.read(prim.m_sphere);
+					cr.read(prim.m_aabb);
+					cr.read(prim.m_obb);
+
+					group.m_prims.push_back(prim);
+				}
+
+				_request->m_groups.push_back(gl);
+				gl = Request::GroupLoad();
+			}
+			break;
+
+		default:
+			DBG("%08x at %d", chunk, cr.m_pos);
+			cr.m_ok = false;
+			break;
+		}
+	}
+
+	const uint32_t numGroups = uint32_t(_request->m_groups.size() );
+
+	if (!cr.m_ok
+	||  0 == numGroups)
+	{
+		DBG("Failed to parse mesh '%s'.", _request->m_filePath);
+		_request->m_groups.clear();
+		_request->m_numErrors = 1;
+		complete(_request);
+		return;
+	}
+
+	_request->m_remaining = int32_t(numGroups);
+
+	{
+		bx::MutexScope scope(m_mutex);
+
+		for (uint32_t ii = 0; ii < numGroups; ++ii)
+		{
+			Job job;
+			job.m_request = _request;
+			job.m_group   = ii;
+			m_jobs.push_back(job);
+		}
+	}
+
+	for (uint32_t ii = 0; ii < numGroups; ++ii)
+	{
+		m_work.post();
+	}
+}
+
+void MeshLoader::decode(Request* _request, uint32_t _group)
+{
+	bx::AllocatorI* allocator = entry::getAllocator();
+
+	MappedFile* mf = _request->m_file;
+	Request::GroupLoad& gl = _request->m_groups[_group];
+	Group& group = gl.m_group;
+
+	const uint8_t* data = mf->m_data;
+	const uint32_t indexSize = group.m_index32 ? 4 : 2;
+	int32_t numErrors = 0;
+
+	if (0 != gl.m_vbMagic)
+	{
+		const bool compressed = BGFX_CHUNK_MAGIC_VBC == gl.m_vbMagic || BGFX_CHUNK_MAGIC_VBC32 == gl.m_vbMagic;
+		const uint32_t stride = gl.m_layout.getStride();
+		const uint32_t size   = group.m_numVertices*stride;
+
+		uint8_t* dst = NULL;
+
+		if (_request->m_ramcopy)
+		{
+			group.m_vertices = (uint8_t*)BX_ALLOC(allocator, size);
+			gl.m_vbMem = bgfx::makeRef(group.m_vertices, size);
+			dst = group.m_vertices;
+		}
+		else if (compressed)
+		{
+			gl.m_vbMem = bgfx::alloc(size);
+			dst = gl.m_vbMem->data;
+		}
+		else
+		{
+			mappedFileAddRef(mf);
+			gl.m_vbMem = bgfx::makeRef(&data[gl.m_vbOffset], size, mappedFileReleaseRef, mf);
+		}
+
+		if (NULL != dst)
+		{
+			if (compressed)
+			{
+				numErrors += 0 != meshopt_decodeVertexBuffer(dst, group.m_numVertices, stride, &data[gl.m_vbOffset], gl.m_vbSize);
+			}
+			else
+			{
+				bx::memCopy(dst, &data[gl.m_vbOffset], size);
+			}
+		}
+	}
+
+	if (0 != gl.m_ibMagic)
+	{
+		const bool compressed = BGFX_CHUNK_MAGIC_IBC == gl.m_ibMagic || BGFX_CHUNK_MAGIC_IBC32 == gl.m_ibMagic;
+		const uint32_t size   = group.m_numIndices*indexSize;
+
+		uint8_t* dst = NULL;
+
+		if (_request->m_ramcopy)
+		{
+			dst = (uint8_t*)BX_ALLOC(allocator, size);
+			gl.m_ibMem = bgfx::makeRef(dst, size);
+
+			if (group.m_index32)
+			{
+				group.m_indices32 = (uint32_t*)dst;
+			}
+			else
+			{
+				group.m_indices = (uint16_t*)dst;
+			}
+		}
+		else if (compressed)
+		{
+			gl.m_ibMem = bgfx::alloc(size);
+			dst = gl.m_ibMem->data;
+		}
+		else
+		{
+			mappedFileAddRef(mf);
+			gl.m_ibMem = bgfx::makeRef(&data[gl.m_ibOffset], size, mappedFileReleaseRef, mf);
+		}
+
+		if (NULL != dst)
+		{
+			if (compressed)
+			{
+				numErrors += 0 != meshopt_decodeIndexBuffer(dst, group.m_numIndices, indexSize, &data[gl.m_ibOffset], gl.m_ibSize);
+			}
+			else
+			{
+				bx::memCopy(dst, &data[gl.m_ibOffset], size);
+			}
+		}
+	}
+
+	if (!group.m_lods.empty() )
+	{
+		const MeshLod& last = group.m_lods.back();
+		const uint32_t totalIndices = last.m_startIndex + last.m_numIndices;
+
+		if (0 < totalIndices)
+		{
+			gl.m_lodMem = bgfx::alloc(totalIndices*indexSize);
+
+			const uint8_t* src = &data[gl.m_lodOffset];
+			for (uint32_t ii = 0, num = uint32_t(group.m_lods.size() ); ii < num; ++ii)
+			{
+				const MeshLod& lod = group.m_lods[ii];
+				src += sizeof(lod.m_error) + sizeof(lod.m_numIndices);
+				bx::memCopy(&gl.m_lodMem->data[lod.m_startIndex*indexSize], src, lod.m_numIndices*indexSize);
+				src += lod.m_numIndices*indexSize;
+			}
+		}
+	}
+
+	if (!group.m_meshlets.empty() )
+	{
+		uint32_t* vertices = (uint32_t*)BX_ALLOC(allocator, gl.m_numMeshletVertices*4);
+		const uint8_t* src = &data[gl.m_meshletVertexOffset];
+		if (group.m_index32)
+		{
+			bx::memCopy(vertices, src, gl.m_numMeshletVertices*4);
+		}
+		else
+		{
+			for (uint32_t ii = 0; ii < gl.m_numMeshletVertices; ++ii)
+			{
+				uint16_t vertex;
+				bx::memCopy(&vertex, &src[ii*2], 2);
+				vertices[ii] = vertex;
+			}
+		}
+
+		const uint8_t* triangles = &data[gl.m_meshletTriangleOffset];
+
+		gl.m_meshletMem = bgfx::alloc(gl.m_numMeshletTriangles*3*indexSize);
+		for (uint32_t ii = 0, num = uint32_t(group.m_meshlets.size() ); ii < num; ++ii)
+		{
+			const Meshlet& meshlet = group.m_meshlets[ii];
+			const uint32_t* meshletVertices = &vertices[meshlet.m_startVertex];
+			for (uint32_t jj = 0, numIndices = meshlet.m_numTriangles*3; jj < numIndices; ++jj)
+			{
+				const uint32_t idx = meshlet.m_startIndex + jj;
+				const uint32_t index = meshletVertices[triangles[idx] ];
+				if (group.m_index32)
+				{
+					( (uint32_t*)gl.m_meshletMem->data)[idx] = index;
+				}
+				else
+				{
+					( (uint16_t*)gl.m_meshletMem->data)[idx] = uint16_t(index);
+				}
+			}
+		}
+
+		if (_request->m_ramcopy)
+		{
+			group.m_meshletVertices  = vertices;
+			group.m_meshletTriangles = (uint8_t*)BX_ALLOC(allocator, gl.m_numMeshletTriangles*3);
+			bx::memCopy(group.m_meshletTriangles, triangles, gl.m_numMeshletTriangles*3);
+		}
+		else
+		{
+			BX_FREE(allocator, vertices);
+		}
+	}
+
+	if (0 != numErrors)
+	{
+		DBG("Failed to decode mesh '%s' group %d.", _request->m_filePath, _group);
+		bx::atomicFetchAndAdd<int32_t>(&_request->m_numErrors, numErrors);
+	}
+
+	if (1 == bx::atomicFetchAndSub<int32_t>(&_request->m_remaining, 1) )
+	{
+		complete(_request);
+	}
+}
+
+void MeshLoader::complete(Request* _request)
+{
+	bx::MutexScope scope(m_mutex);
+	m_completed.push_back(_request);
+}
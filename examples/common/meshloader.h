@@ -0,0 +1,101 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef MESHLOADER_H_HEADER_GUARD
+#define MESHLOADER_H_HEADER_GUARD
+
+#include <bx/allocator.h>
+#include <bx/mutex.h>
+#include <bx/semaphore.h>
+#include <bx/thread.h>
+
+#include "bgfx_utils.h"
+
+#include <tinystl/allocator.h>
+#include <tinystl/unordered_map.h>
+#include <tinystl/vector.h>
+namespace stl = tinystl;
+
+/// Called from `MeshLoader::update` when mesh is loaded. `_mesh` is NULL if
+/// loading failed. Ownership of mesh is passed to callback, release it with
+/// `meshUnload`.
+typedef void (*MeshLoadFn)(Mesh* _mesh, const char* _filePath, void* _userData);
+
+/// Asynchronous mesh loader. Mesh file is memory-mapped, chunk headers are
+/// parsed by worker thread, and then every group is decoded as separate job
+/// on worker threads. Uncompressed buffers are passed to bgfx as references
+/// into mapped file, which is unmapped when bgfx releases last reference.
+/// Compressed buffers are decoded directly into `bgfx::alloc` memory.
+///
+/// With `_ramcopy` buffers are decoded once into RAM copy which is also used
+/// as bgfx reference. In that case mesh must not be unloaded during two
+/// frames after it was loaded.
+///
+class MeshLoader
+{
+public:
+	///
+	MeshLoader(uint32_t _numThreads = 2);
+
+	/// Waits for all workers, and releases meshes that were not claimed.
+	~MeshLoader();
+
+	/// Queue mesh for loading. Returns request id, used with `poll`. If
+	/// `_fn` is not NULL, mesh is passed to callback and it's not available
+	/// through `poll`.
+	uint32_t load(const char* _filePath, bool _ramcopy = false, MeshLoadFn _fn = NULL, void* _userData = NULL);
+
+	/// Creates buffers of decoded meshes, and calls callbacks. Must be called
+	/// from thread that calls bgfx API. Returns number of completed requests.
+	uint32_t update();
+
+	/// Returns true when request is completed. On success `_mesh` receives
+	/// mesh, and caller owns it. On failure `_mesh` receives NULL.
+	bool poll(uint32_t _id, Mesh** _mesh);
+
+	/// Returns number of requests in flight.
+	uint32_t getNumPending() const
+	{
+		return m_numPending;
+	}
+
+private:
+	struct Request;
+
+	struct Job
+	{
+		Request* m_request;
+		uint32_t m_group; //!< UINT32_MAX for scan job.
+	};
+
+	static const uint32_t kMaxThreads = 8;
+
+	static int32_t workerThread(bx::Thread* _thread, void* _userData);
+	int32_t worker();
+	void push(const Job& _job);
+	void scan(Request* _request);
+	void decode(Request* _request, uint32_t _group);
+	void complete(Request* _request);
+
+	typedef stl::vector<Job> JobArray;
+	typedef stl::vector<Request*> RequestArray;
+	typedef stl::unordered_map<uint32_t, Mesh*> MeshMap;
+
+	bx::Thread    m_thread[kMaxThreads];
+	bx::Semaphore m_work;
+	bx::Mutex     m_mutex;
+
+	JobArray     m_jobs;
+	uint32_t     m_jobHead;
+	RequestArray m_completed;
+	MeshMap      m_done;
+
+	uint32_t m_numThreads;
+	uint32_t m_numPending;
+	uint32_t m_nextId;
+	bool     m_exit;
+};
+
+#endif // MESHLOADER_H_HEADER_GUARD
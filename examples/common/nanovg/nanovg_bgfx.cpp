@@ -566,17 +566,37 @@ namespace
 		bgfx::setViewRect(gl->viewId, 0, 0, width * devicePixelRatio, height * devicePixelRatio);
 	}
 
+	template<typename Ty>
+	static void fanIndices(Ty* _data, uint32_t _start, uint32_t _numTris)
+	{
+		for (uint32_t ii = 0; ii < _numTris; ++ii)
+		{
+			_data[ii*3+0] = Ty(_start);
+			_data[ii*3+1] = Ty(_start + ii + 1);
+			_data[ii*3+2] = Ty(_start + ii + 2);
+		}
+	}
+
 	static void fan(uint32_t _start, uint32_t _count)
 	{
 		uint32_t numTris = _count-2;
+
+		// All vertices of frame are in single transient vertex buffer, so fan
+		// can reference vertices past 16-bit index range.
+		const bool index32 = UINT16_MAX < _start + _count
+			&& 0 != (bgfx::getCaps()->supported & BGFX_CAPS_INDEX32)
+			;
+
 		bgfx::TransientIndexBuffer tib;
-		bgfx::allocTransientIndexBuffer(&tib, numTris*3);
-		uint16_t* data = (uint16_t*)tib.data;
-		for (uint32_t ii = 0; ii < numTris; ++ii)
+		bgfx::allocTransientIndexBuffer(&tib, numTris*3, index32);
+
+		if (index32)
+		{
+			fanIndices( (uint32_t*)tib.data, _start, numTris);
+		}
+		else
 		{
-			data[ii*3+0] = _start;
-			data[ii*3+1] = _start + ii + 1;
-			data[ii*3+2] = _start + ii + 2;
+			fanIndices( (uint16_t*)tib.data, _start, numTris);
 		}
 
 		bgfx::setIndexBuffer(&tib);
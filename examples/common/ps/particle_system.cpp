@@ -12,6 +12,8 @@
 
 #include <bx/easing.h>
 #include <bx/handlealloc.h>
+#include <bx/simd_t.h>
+#include <bx/sort.h>
 
 #include "vs_particle.bin.h"
 #include "fs_particle.bin.h"
@@ -96,25 +98,46 @@ void EmitterUniforms::reset()
 
 namespace ps
 {
-	struct Particle
+	/// Particle data is stored as structure of arrays. Every stream is 16-byte aligned and
+	/// padded to multiple of 4 elements, so that emitter update can be done with SIMD.
+	struct ParticleStream
 	{
-		bx::Vec3 start;
-		bx::Vec3 end[2];
-		float blendStart;
-		float blendEnd;
-		float scaleStart;
-		float scaleEnd;
-
-		uint32_t rgba[5];
-
-		float life;
-		float lifeSpan;
+		enum Enum
+		{
+			StartX,
+			StartY,
+			StartZ,
+			End0X,
+			End0Y,
+			End0Z,
+			End1X,
+			End1Y,
+			End1Z,
+			BlendStart,
+			BlendEnd,
+			ScaleStart,
+			ScaleEnd,
+			Life,
+			InvLifeSpan,
+			Rgba0,
+			Rgba1,
+			Rgba2,
+			Rgba3,
+			Rgba4,
+
+			Count
+		};
 	};
 
-	struct ParticleSort
+	/// Evaluated particle, written by emitter and read back in sorted order when generating
+	/// vertices.
+	struct ParticleQuad
 	{
-		float    dist;
-		uint32_t idx;
+		float    pos[3];
+		uint32_t abgr;
+		float    blend;
+		float    scale;
+		uint16_t emitter;
 	};
 
 	inline uint32_t toAbgr(const float* _rgba)
@@ -137,6 +160,29 @@ namespace ps
 			;
 	}
 
+	inline bx::simd128_t simdLerp(bx::simd128_t _a, bx::simd128_t _b, bx::simd128_t _t)
+	{
+		using namespace bx;
+		return simd_madd(simd_sub(_b, _a), _t, _a);
+	}
+
+	inline bx::simd128_t simdBezier(bx::simd128_t _a, bx::simd128_t _b, bx::simd128_t _c, bx::simd128_t _t)
+	{
+		return simdLerp(simdLerp(_a, _b, _t), simdLerp(_b, _c, _t), _t);
+	}
+
+	inline uint32_t lerpRgba(uint32_t _a, uint32_t _b, float _t)
+	{
+		const uint8_t* aa = (const uint8_t*)&_a;
+		const uint8_t* bb = (const uint8_t*)&_b;
+
+		return toAbgr(
+			  bx::lerp(aa[0], bb[0], _t)/255.0f
+			, bx::lerp(aa[1], bb[1], _t)/255.0f
+			, bx::lerp(aa[2], bb[2], _t)/255.0f
+			, bx::lerp(aa[3], bb[3], _t)/255.0f
+			);
+	}
 #define SPRITE_TEXTURE_SIZE 1024
 	template<uint16_t MaxHandlesT = 256, uint16_t TextureSizeT = 1024>
 	struct SpriteT
@@ -195,23 +241,53 @@ namespace ps
 			m_rng.reset();
 		}
 
+		float* getStream(ParticleStream::Enum _stream) const
+		{
+			return m_stream[_stream];
+		}
+
+		uint32_t* getRgbaStream(uint32_t _idx) const
+		{
+			return (uint32_t*)m_stream[ParticleStream::Rgba0 + _idx];
+		}
+
+		void move(uint32_t _dst, uint32_t _src)
+		{
+			for (uint32_t ii = 0; ii < ParticleStream::Count; ++ii)
+			{
+				uint32_t* stream = (uint32_t*)m_stream[ii];
+				stream[_dst] = stream[_src];
+			}
+		}
+
 		void update(float _dt)
 		{
-			uint32_t num = m_num;
-			for (uint32_t ii = 0; ii < num; ++ii)
+			using namespace bx;
+
+			float*       life        = getStream(ParticleStream::Life);
+			const float* invLifeSpan = getStream(ParticleStream::InvLifeSpan);
+
+			const simd128_t dt = simd_splat(_dt);
+
+			// Streams are padded to multiple of 4, lanes past m_num are ignored.
+			for (uint32_t ii = 0, num = m_num; ii < num; ii += 4)
 			{
-				Particle& particle = m_particles[ii];
-				particle.life += _dt * 1.0f/particle.lifeSpan;
+				const simd128_t ll  = simd_ld<simd128_t>(&life[ii]);
+				const simd128_t ils = simd_ld<simd128_t>(&invLifeSpan[ii]);
+				simd_st(&life[ii], simd_madd(dt, ils, ll) );
+			}
 
-				if (particle.life > 1.0f)
+			uint32_t num = m_num;
+			for (uint32_t ii = 0; ii < num;)
+			{
+				if (life[ii] > 1.0f)
 				{
-					if (ii != num-1)
-					{
-						bx::memCopy(&particle, &m_particles[num-1], sizeof(Particle) );
-						--ii;
-					}
-
 					--num;
+					move(ii, num);
+				}
+				else
+				{
+					++ii;
 				}
 			}
 
@@ -239,13 +315,29 @@ namespace ps
 
 			constexpr bx::Vec3 up = { 0.0f, 1.0f, 0.0f };
 
+			float* startX      = getStream(ParticleStream::StartX);
+			float* startY      = getStream(ParticleStream::StartY);
+			float* startZ      = getStream(ParticleStream::StartZ);
+			float* end0X       = getStream(ParticleStream::End0X);
+			float* end0Y       = getStream(ParticleStream::End0Y);
+			float* end0Z       = getStream(ParticleStream::End0Z);
+			float* end1X       = getStream(ParticleStream::End1X);
+			float* end1Y       = getStream(ParticleStream::End1Y);
+			float* end1Z       = getStream(ParticleStream::End1Z);
+			float* blendStart  = getStream(ParticleStream::BlendStart);
+			float* blendEnd    = getStream(ParticleStream::BlendEnd);
+			float* scaleStart  = getStream(ParticleStream::ScaleStart);
+			float* scaleEnd    = getStream(ParticleStream::ScaleEnd);
+			float* life        = getStream(ParticleStream::Life);
+			float* invLifeSpan = getStream(ParticleStream::InvLifeSpan);
+
 			float time = 0.0f;
 			for (uint32_t ii = 0
 				; ii < numParticles && m_num < m_max
 				; ++ii
 				)
 			{
-				Particle& particle = m_particles[m_num];
+				const uint32_t idx = m_num;
 				m_num++;
 
 				bx::Vec3 pos;
@@ -301,121 +393,190 @@ namespace ps
 				const bx::Vec3 tmp1 = bx::mul(dir, endOffset);
 				const bx::Vec3 end  = bx::add(tmp1, start);
 
-				particle.life = time;
-				particle.lifeSpan = bx::lerp(m_uniforms.m_lifeSpan[0], m_uniforms.m_lifeSpan[1], bx::frnd(&m_rng) );
+				const float lifeSpan = bx::lerp(m_uniforms.m_lifeSpan[0], m_uniforms.m_lifeSpan[1], bx::frnd(&m_rng) );
+				life[idx]        = time;
+				invLifeSpan[idx] = 1.0f/lifeSpan;
 
-				const bx::Vec3 gravity = { 0.0f, -9.81f * m_uniforms.m_gravityScale * bx::square(particle.lifeSpan), 0.0f };
+				const bx::Vec3 gravity = { 0.0f, -9.81f * m_uniforms.m_gravityScale * bx::square(lifeSpan), 0.0f };
 
-				particle.start  = bx::mul(start, mtx);
-				particle.end[0] = bx::mul(end,   mtx);
-				particle.end[1] = bx::add(particle.end[0], gravity);
+				const bx::Vec3 wsStart = bx::mul(start, mtx);
+				const bx::Vec3 wsEnd0  = bx::mul(end,   mtx);
+				const bx::Vec3 wsEnd1  = bx::add(wsEnd0, gravity);
 
-				bx::memCopy(particle.rgba, m_uniforms.m_rgba, BX_COUNTOF(m_uniforms.m_rgba)*sizeof(uint32_t) );
+				startX[idx] = wsStart.x;
+				startY[idx] = wsStart.y;
+				startZ[idx] = wsStart.z;
+				end0X[idx]  = wsEnd0.x;
+				end0Y[idx]  = wsEnd0.y;
+				end0Z[idx]  = wsEnd0.z;
+				end1X[idx]  = wsEnd1.x;
+				end1Y[idx]  = wsEnd1.y;
+				end1Z[idx]  = wsEnd1.z;
 
-				particle.blendStart = bx::lerp(m_uniforms.m_blendStart[0], m_uniforms.m_blendStart[1], bx::frnd(&m_rng) );
-				particle.blendEnd   = bx::lerp(m_uniforms.m_blendEnd[0],   m_uniforms.m_blendEnd[1],   bx::frnd(&m_rng) );
+				for (uint32_t jj = 0; jj < BX_COUNTOF(m_uniforms.m_rgba); ++jj)
+				{
+					getRgbaStream(jj)[idx] = m_uniforms.m_rgba[jj];
+				}
 
-				particle.scaleStart = bx::lerp(m_uniforms.m_scaleStart[0], m_uniforms.m_scaleStart[1], bx::frnd(&m_rng) );
-				particle.scaleEnd   = bx::lerp(m_uniforms.m_scaleEnd[0],   m_uniforms.m_scaleEnd[1],   bx::frnd(&m_rng) );
+				blendStart[idx] = bx::lerp(m_uniforms.m_blendStart[0], m_uniforms.m_blendStart[1], bx::frnd(&m_rng) );
+				blendEnd[idx]   = bx::lerp(m_uniforms.m_blendEnd[0],   m_uniforms.m_blendEnd[1],   bx::frnd(&m_rng) );
+
+				scaleStart[idx] = bx::lerp(m_uniforms.m_scaleStart[0], m_uniforms.m_scaleStart[1], bx::frnd(&m_rng) );
+				scaleEnd[idx]   = bx::lerp(m_uniforms.m_scaleEnd[0],   m_uniforms.m_scaleEnd[1],   bx::frnd(&m_rng) );
 
 				time += timePerParticle;
 			}
 		}
 
-		uint32_t render(const float _uv[4], const float* _mtxView, const bx::Vec3& _eye, uint32_t _first, uint32_t _max, ParticleSort* _outSort, PosColorTexCoord0Vertex* _outVertices)
+		/// Evaluates first _num particles into _outQuads, and writes back-to-front sort keys.
+		/// Position, blend and scale curves are evaluated 4 particles at the time, easing
+		/// functions are called through function pointers and remain scalar.
+		void evaluate(
+			  uint16_t _emitter
+			, const float* _mtxView
+			, const bx::Vec3& _eye
+			, uint32_t _first
+			, uint32_t _num
+			, ParticleQuad* _outQuads
+			, uint32_t* _outKeys
+			, uint32_t* _outValues
+			)
 		{
-			bx::EaseFn easeRgba  = bx::getEaseFunc(m_uniforms.m_easeRgba);
-			bx::EaseFn easePos   = bx::getEaseFunc(m_uniforms.m_easePos);
-			bx::EaseFn easeBlend = bx::getEaseFunc(m_uniforms.m_easeBlend);
-			bx::EaseFn easeScale = bx::getEaseFunc(m_uniforms.m_easeScale);
+			using namespace bx;
+
+			const EaseFn easeRgba  = getEaseFunc(m_uniforms.m_easeRgba);
+			const EaseFn easePos   = getEaseFunc(m_uniforms.m_easePos);
+			const EaseFn easeBlend = getEaseFunc(m_uniforms.m_easeBlend);
+			const EaseFn easeScale = getEaseFunc(m_uniforms.m_easeScale);
+
+			const float* startX     = getStream(ParticleStream::StartX);
+			const float* startY     = getStream(ParticleStream::StartY);
+			const float* startZ     = getStream(ParticleStream::StartZ);
+			const float* end0X      = getStream(ParticleStream::End0X);
+			const float* end0Y      = getStream(ParticleStream::End0Y);
+			const float* end0Z      = getStream(ParticleStream::End0Z);
+			const float* end1X      = getStream(ParticleStream::End1X);
+			const float* end1Y      = getStream(ParticleStream::End1Y);
+			const float* end1Z      = getStream(ParticleStream::End1Z);
+			const float* blendStart = getStream(ParticleStream::BlendStart);
+			const float* blendEnd   = getStream(ParticleStream::BlendEnd);
+			const float* scaleStart = getStream(ParticleStream::ScaleStart);
+			const float* scaleEnd   = getStream(ParticleStream::ScaleEnd);
+			const float* life       = getStream(ParticleStream::Life);
+
+			// Billboard corners are pos +/- udir +/- vdir, so particle extent along each axis is
+			// (|udir| + |vdir|) * scale.
+			const Vec3 extent =
+			{
+				bx::abs(_mtxView[0]) + bx::abs(_mtxView[1]),
+				bx::abs(_mtxView[4]) + bx::abs(_mtxView[5]),
+				bx::abs(_mtxView[8]) + bx::abs(_mtxView[9]),
+			};
+
+			const simd128_t eyeX = simd_splat(_eye.x);
+			const simd128_t eyeY = simd_splat(_eye.y);
+			const simd128_t eyeZ = simd_splat(_eye.z);
 
 			Aabb aabb =
 			{
-				{  bx::kInfinity,  bx::kInfinity,  bx::kInfinity },
-				{ -bx::kInfinity, -bx::kInfinity, -bx::kInfinity },
+				{  kInfinity,  kInfinity,  kInfinity },
+				{ -kInfinity, -kInfinity, -kInfinity },
 			};
 
-			for (uint32_t jj = 0, num = m_num, current = _first
-				; jj < num && current < _max
-				; ++jj, ++current
-				)
+			BX_ALIGN_DECL_16(float ttPos[4]);
+			BX_ALIGN_DECL_16(float ttBlend[4]);
+			BX_ALIGN_DECL_16(float ttScale[4]);
+			BX_ALIGN_DECL_16(float posX[4]);
+			BX_ALIGN_DECL_16(float posY[4]);
+			BX_ALIGN_DECL_16(float posZ[4]);
+			BX_ALIGN_DECL_16(float dist[4]);
+			BX_ALIGN_DECL_16(float blend[4]);
+			BX_ALIGN_DECL_16(float scale[4]);
+
+			for (uint32_t ii = 0; ii < _num; ii += 4)
 			{
-				const Particle& particle = m_particles[jj];
-
-				const float ttPos   = easePos(particle.life);
-				const float ttScale = easeScale(particle.life);
-				const float ttBlend = bx::clamp(easeBlend(particle.life), 0.0f, 1.0f);
-				const float ttRgba  = bx::clamp(easeRgba(particle.life),  0.0f, 1.0f);
-
-				const bx::Vec3 p0  = bx::lerp(particle.start,  particle.end[0], ttPos);
-				const bx::Vec3 p1  = bx::lerp(particle.end[0], particle.end[1], ttPos);
-				const bx::Vec3 pos = bx::lerp(p0, p1, ttPos);
-
-				ParticleSort& sort = _outSort[current];
-				const bx::Vec3 tmp0 = bx::sub(_eye, pos);
-				sort.dist = bx::length(tmp0);
-				sort.idx  = current;
-
-				uint32_t idx = uint32_t(ttRgba*4);
-				float ttmod = bx::mod(ttRgba, 0.25f)/0.25f;
-				uint32_t rgbaStart = particle.rgba[idx];
-				uint32_t rgbaEnd   = particle.rgba[idx+1];
-
-				float rr = bx::lerp( ( (uint8_t*)&rgbaStart)[0], ( (uint8_t*)&rgbaEnd)[0], ttmod)/255.0f;
-				float gg = bx::lerp( ( (uint8_t*)&rgbaStart)[1], ( (uint8_t*)&rgbaEnd)[1], ttmod)/255.0f;
-				float bb = bx::lerp( ( (uint8_t*)&rgbaStart)[2], ( (uint8_t*)&rgbaEnd)[2], ttmod)/255.0f;
-				float aa = bx::lerp( ( (uint8_t*)&rgbaStart)[3], ( (uint8_t*)&rgbaEnd)[3], ttmod)/255.0f;
-
-				float blend = bx::lerp(particle.blendStart, particle.blendEnd, ttBlend);
-				float scale = bx::lerp(particle.scaleStart, particle.scaleEnd, ttScale);
-
-				uint32_t abgr = toAbgr(rr, gg, bb, aa);
-
-				const bx::Vec3 udir = { _mtxView[0]*scale, _mtxView[4]*scale, _mtxView[8]*scale };
-				const bx::Vec3 vdir = { _mtxView[1]*scale, _mtxView[5]*scale, _mtxView[9]*scale };
+				for (uint32_t lane = 0; lane < 4; ++lane)
+				{
+					const float tt = life[ii+lane];
+					ttPos[lane]   = easePos(tt);
+					ttBlend[lane] = clamp(easeBlend(tt), 0.0f, 1.0f);
+					ttScale[lane] = easeScale(tt);
+				}
 
-				PosColorTexCoord0Vertex* vertex = &_outVertices[current*4];
+				const simd128_t tp = simd_ld<simd128_t>(ttPos);
+				const simd128_t px = simdBezier(
+					  simd_ld<simd128_t>(&startX[ii])
+					, simd_ld<simd128_t>(&end0X[ii])
+					, simd_ld<simd128_t>(&end1X[ii])
+					, tp
+					);
+				const simd128_t py = simdBezier(
+					  simd_ld<simd128_t>(&startY[ii])
+					, simd_ld<simd128_t>(&end0Y[ii])
+					, simd_ld<simd128_t>(&end1Y[ii])
+					, tp
+					);
+				const simd128_t pz = simdBezier(
+					  simd_ld<simd128_t>(&startZ[ii])
+					, simd_ld<simd128_t>(&end0Z[ii])
+					, simd_ld<simd128_t>(&end1Z[ii])
+					, tp
+					);
 
-				const bx::Vec3 ul = bx::sub(bx::sub(pos, udir), vdir);
-				bx::store(&vertex->m_x, ul);
-				aabbExpand(aabb, ul);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = _uv[0];
-				vertex->m_v     = _uv[1];
-				vertex->m_blend = blend;
-				++vertex;
+				const simd128_t dx = simd_sub(eyeX, px);
+				const simd128_t dy = simd_sub(eyeY, py);
+				const simd128_t dz = simd_sub(eyeZ, pz);
+				const simd128_t dd = simd_madd(dx, dx, simd_madd(dy, dy, simd_mul(dz, dz) ) );
 
-				const bx::Vec3 ur = bx::sub(bx::add(pos, udir), vdir);
-				bx::store(&vertex->m_x, ur);
-				aabbExpand(aabb, ur);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = _uv[2];
-				vertex->m_v     = _uv[1];
-				vertex->m_blend = blend;
-				++vertex;
+				const simd128_t bl = simdLerp(
+					  simd_ld<simd128_t>(&blendStart[ii])
+					, simd_ld<simd128_t>(&blendEnd[ii])
+					, simd_ld<simd128_t>(ttBlend)
+					);
+				const simd128_t sc = simdLerp(
+					  simd_ld<simd128_t>(&scaleStart[ii])
+					, simd_ld<simd128_t>(&scaleEnd[ii])
+					, simd_ld<simd128_t>(ttScale)
+					);
 
-				const bx::Vec3 br = bx::add(bx::add(pos, udir), vdir);
-				bx::store(&vertex->m_x, br);
-				aabbExpand(aabb, br);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = _uv[2];
-				vertex->m_v     = _uv[3];
-				vertex->m_blend = blend;
-				++vertex;
+				simd_st(posX,  px);
+				simd_st(posY,  py);
+				simd_st(posZ,  pz);
+				simd_st(dist,  dd);
+				simd_st(blend, bl);
+				simd_st(scale, sc);
 
-				const bx::Vec3 bl = bx::add(bx::sub(pos, udir), vdir);
-				bx::store(&vertex->m_x, bl);
-				aabbExpand(aabb, bl);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = _uv[0];
-				vertex->m_v     = _uv[3];
-				vertex->m_blend = blend;
-				++vertex;
+				for (uint32_t lane = 0, numLanes = uint32_min(4, _num-ii); lane < numLanes; ++lane)
+				{
+					const uint32_t idx     = ii + lane;
+					const uint32_t current = _first + idx;
+
+					const float ttRgba = clamp(easeRgba(life[idx]), 0.0f, 1.0f);
+					const uint32_t rgbaIdx = uint32_min(uint32_t(ttRgba*4.0f), 3);
+					const float    ttmod   = ttRgba*4.0f - float(rgbaIdx);
+
+					ParticleQuad& quad = _outQuads[current];
+					quad.pos[0]  = posX[lane];
+					quad.pos[1]  = posY[lane];
+					quad.pos[2]  = posZ[lane];
+					quad.abgr    = lerpRgba(getRgbaStream(rgbaIdx)[idx], getRgbaStream(rgbaIdx+1)[idx], ttmod);
+					quad.blend   = blend[lane];
+					quad.scale   = scale[lane];
+					quad.emitter = _emitter;
+
+					// Squared distance is positive, so its bits sort the same as its value.
+					// Inverting them orders particles back-to-front.
+					_outKeys[current]   = UINT32_MAX - floatToBits(dist[lane]);
+					_outValues[current] = current;
+
+					const Vec3 pos = { posX[lane], posY[lane], posZ[lane] };
+					const Vec3 ext = mul(extent, scale[lane]);
+					aabbExpand(aabb, sub(pos, ext) );
+					aabbExpand(aabb, add(pos, ext) );
+				}
 			}
 
 			m_aabb = aabb;
-
-			return m_num;
 		}
 
 		EmitterShape::Enum     m_shape;
@@ -425,23 +586,30 @@ namespace ps
 		bx::RngMwc      m_rng;
 		EmitterUniforms m_uniforms;
 
-		Aabb m_aabb;
+		Aabb  m_aabb;
+		float m_uv[4];
 
-		Particle* m_particles;
+		float*   m_stream[ParticleStream::Count];
 		uint32_t m_num;
 		uint32_t m_max;
 	};
 
-	static int32_t particleSortFn(const void* _lhs, const void* _rhs)
+	struct EmitterRange
 	{
-		const ParticleSort& lhs = *(const ParticleSort*)_lhs;
-		const ParticleSort& rhs = *(const ParticleSort*)_rhs;
-		return lhs.dist > rhs.dist ? -1 : 1;
-	}
+		uint32_t first;
+		uint32_t num;
+		uint16_t emitter;
+	};
 
 	struct ParticleSystem
 	{
-		void init(uint16_t _maxEmitters, bx::AllocatorI* _allocator)
+		// Number of emitters updated by single job.
+		static constexpr uint32_t kEmittersPerJob = 16;
+
+		// Number of particles written to transient buffers by single job.
+		static constexpr uint32_t kQuadsPerJob = 1024;
+
+		void init(uint16_t _maxEmitters, bx::AllocatorI* _allocator, PsParallelForFn _parallelFor, void* _context)
 		{
 			m_allocator = _allocator;
 
@@ -451,13 +619,20 @@ namespace ps
 				m_allocator = &allocator;
 			}
 
+			m_parallelFor = _parallelFor;
+			m_context     = _context;
+
 			m_emitterAlloc = bx::createHandleAlloc(m_allocator, _maxEmitters);
 			m_emitter = (Emitter*)BX_ALLOC(m_allocator, sizeof(Emitter)*_maxEmitters);
+			m_range   = (EmitterRange*)BX_ALLOC(m_allocator, sizeof(EmitterRange)*_maxEmitters);
 
 			PosColorTexCoord0Vertex::init();
 
 			m_num = 0;
 
+			m_scratch    = NULL;
+			m_scratchMax = 0;
+
 			s_texColor = bgfx::createUniform("s_texColor", bgfx::UniformType::Sampler);
 			m_texture  = bgfx::createTexture2D(
 				  SPRITE_TEXTURE_SIZE
@@ -481,12 +656,53 @@ namespace ps
 			bgfx::destroy(m_texture);
 			bgfx::destroy(s_texColor);
 
+			BX_FREE(m_allocator, m_scratch);
+			m_scratch    = NULL;
+			m_scratchMax = 0;
+
 			bx::destroyHandleAlloc(m_allocator, m_emitterAlloc);
+			BX_FREE(m_allocator, m_range);
 			BX_FREE(m_allocator, m_emitter);
 
 			m_allocator = NULL;
 		}
 
+		void parallelFor(PsJobFn _fn, uint32_t _num)
+		{
+			if (NULL != m_parallelFor
+			&&  1 < _num)
+			{
+				m_parallelFor(m_context, _fn, this, _num);
+			}
+			else
+			{
+				for (uint32_t ii = 0; ii < _num; ++ii)
+				{
+					_fn(this, ii);
+				}
+			}
+		}
+
+		void reserve(uint32_t _num)
+		{
+			if (_num > m_scratchMax)
+			{
+				BX_FREE(m_allocator, m_scratch);
+
+				m_scratchMax = bx::uint32_max(bx::uint32_nextpow2(_num), 1024);
+
+				const uint32_t size = m_scratchMax*(4*sizeof(uint32_t) + sizeof(ParticleQuad) );
+				m_scratch = (uint8_t*)BX_ALLOC(m_allocator, size);
+
+				uint8_t* data = m_scratch;
+				m_keys       = (uint32_t*)data; data += m_scratchMax*sizeof(uint32_t);
+				m_tempKeys   = (uint32_t*)data; data += m_scratchMax*sizeof(uint32_t);
+				m_values     = (uint32_t*)data; data += m_scratchMax*sizeof(uint32_t);
+				m_tempValues = (uint32_t*)data; data += m_scratchMax*sizeof(uint32_t);
+				m_quads      = (ParticleQuad*)data;
+			}
+		}
+
 		EmitterSpriteHandle createSprite(uint16_t _width, uint16_t _height, const void* _data)
 		{
 			EmitterSpriteHandle handle = m_sprite.create(_width, _height);
@@ -514,15 +730,127 @@ namespace ps
 			m_sprite.destroy(_handle);
 		}
 
+		static void updateJob(void* _userData, uint32_t _idx)
+		{
+			ParticleSystem& ps = *(ParticleSystem*)_userData;
+
+			const uint32_t first = _idx*kEmittersPerJob;
+			const uint32_t last  = bx::uint32_min(first + kEmittersPerJob, ps.m_emitterAlloc->getNumHandles() );
+
+			for (uint32_t ii = first; ii < last; ++ii)
+			{
+				const uint16_t idx = ps.m_emitterAlloc->getHandleAt(uint16_t(ii) );
+				ps.m_emitter[idx].update(ps.m_dt);
+			}
+		}
+
+		static void evaluateJob(void* _userData, uint32_t _idx)
+		{
+			ParticleSystem& ps = *(ParticleSystem*)_userData;
+
+			const uint32_t first = _idx*kEmittersPerJob;
+			const uint32_t last  = bx::uint32_min(first + kEmittersPerJob, ps.m_emitterAlloc->getNumHandles() );
+
+			for (uint32_t ii = first; ii < last; ++ii)
+			{
+				const EmitterRange& range = ps.m_range[ii];
+				ps.m_emitter[range.emitter].evaluate(
+					  range.emitter
+					, ps.m_mtxView
+					, ps.m_eye
+					, range.first
+					, range.num
+					, ps.m_quads
+					, ps.m_keys
+					, ps.m_values
+					);
+			}
+		}
+
+		static void writeJob(void* _userData, uint32_t _idx)
+		{
+			ParticleSystem& ps = *(ParticleSystem*)_userData;
+
+			const uint32_t first = _idx*kQuadsPerJob;
+			const uint32_t last  = bx::uint32_min(first + kQuadsPerJob, ps.m_numQuads);
+
+			const float* mtxView = ps.m_mtxView;
+			const bx::Vec3 uaxis = { mtxView[0], mtxView[4], mtxView[8] };
+			const bx::Vec3 vaxis = { mtxView[1], mtxView[5], mtxView[9] };
+
+			PosColorTexCoord0Vertex* vertex = &ps.m_vertices[first*4];
+			uint16_t* index = &ps.m_indices[first*6];
+
+			// Vertices are written in sorted order, directly into transient vertex buffer,
+			// so index buffer is just sequence of quads.
+			for (uint32_t ii = first; ii < last; ++ii)
+			{
+				const ParticleQuad& quad = ps.m_quads[ps.m_values[ii] ];
+				const float* uv = ps.m_emitter[quad.emitter].m_uv;
+
+				const bx::Vec3 pos  = bx::load<bx::Vec3>(quad.pos);
+				const bx::Vec3 udir = bx::mul(uaxis, quad.scale);
+				const bx::Vec3 vdir = bx::mul(vaxis, quad.scale);
+
+				const bx::Vec3 ul = bx::sub(bx::sub(pos, udir), vdir);
+				bx::store(&vertex->m_x, ul);
+				vertex->m_abgr  = quad.abgr;
+				vertex->m_u     = uv[0];
+				vertex->m_v     = uv[1];
+				vertex->m_blend = quad.blend;
+				vertex->m_angle = 0.0f;
+				++vertex;
+
+				const bx::Vec3 ur = bx::sub(bx::add(pos, udir), vdir);
+				bx::store(&vertex->m_x, ur);
+				vertex->m_abgr  = quad.abgr;
+				vertex->m_u     = uv[2];
+				vertex->m_v     = uv[1];
+				vertex->m_blend = quad.blend;
+				vertex->m_angle = 0.0f;
+				++vertex;
+
+				const bx::Vec3 br = bx::add(bx::add(pos, udir), vdir);
+				bx::store(&vertex->m_x, br);
+				vertex->m_abgr  = quad.abgr;
+				vertex->m_u     = uv[2];
+				vertex->m_v     = uv[3];
+				vertex->m_blend = quad.blend;
+				vertex->m_angle = 0.0f;
+				++vertex;
+
+				const bx::Vec3 bl = bx::add(bx::sub(pos, udir), vdir);
+				bx::store(&vertex->m_x, bl);
+				vertex->m_abgr  = quad.abgr;
+				vertex->m_u     = uv[0];
+				vertex->m_v     = uv[3];
+				vertex->m_blend = quad.blend;
+				vertex->m_angle = 0.0f;
+				++vertex;
+
+				const uint16_t idx = uint16_t(ii*4);
+				index[0] = idx+0;
+				index[1] = idx+1;
+				index[2] = idx+2;
+				index[3] = idx+2;
+				index[4] = idx+3;
+				index[5] = idx+0;
+				index += 6;
+			}
+		}
+
 		void update(float _dt)
 		{
+			const uint32_t numEmitters = m_emitterAlloc->getNumHandles();
+
+			m_dt = _dt;
+			parallelFor(updateJob, (numEmitters + kEmittersPerJob - 1) / kEmittersPerJob);
+
 			uint32_t numParticles = 0;
-			for (uint16_t ii = 0, num = m_emitterAlloc->getNumHandles(); ii < num; ++ii)
+			for (uint16_t ii = 0; ii < numEmitters; ++ii)
 			{
 				const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
-				Emitter& emitter = m_emitter[idx];
-				emitter.update(_dt);
-				numParticles += emitter.m_num;
+				numParticles += m_emitter[idx].m_num;
 			}
 
 			m_num = numParticles;
@@ -552,50 +880,42 @@ namespace ps
 						, &tib
 						, max*6
 						);
-					PosColorTexCoord0Vertex* vertices = (PosColorTexCoord0Vertex*)tvb.data;
 
-					ParticleSort* particleSort = (ParticleSort*)BX_ALLOC(m_allocator, max*sizeof(ParticleSort) );
+					reserve(max);
+
+					const uint32_t numEmitters = m_emitterAlloc->getNumHandles();
+					const float invTextureSize = 1.0f/SPRITE_TEXTURE_SIZE;
 
 					uint32_t pos = 0;
-					for (uint16_t ii = 0, numEmitters = m_emitterAlloc->getNumHandles(); ii < numEmitters; ++ii)
+					for (uint16_t ii = 0; ii < numEmitters; ++ii)
 					{
 						const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
 						Emitter& emitter = m_emitter[idx];
 
 						const Pack2D& pack = m_sprite.get(emitter.m_uniforms.m_handle);
-						const float invTextureSize = 1.0f/SPRITE_TEXTURE_SIZE;
-						const float uv[4] =
-						{
-							 pack.m_x                  * invTextureSize,
-							 pack.m_y                  * invTextureSize,
-							(pack.m_x + pack.m_width ) * invTextureSize,
-							(pack.m_y + pack.m_height) * invTextureSize,
-						};
-
-						pos += emitter.render(uv, _mtxView, _eye, pos, max, particleSort, vertices);
+						emitter.m_uv[0] =  pack.m_x                  * invTextureSize;
+						emitter.m_uv[1] =  pack.m_y                  * invTextureSize;
+						emitter.m_uv[2] = (pack.m_x + pack.m_width ) * invTextureSize;
+						emitter.m_uv[3] = (pack.m_y + pack.m_height) * invTextureSize;
+
+						EmitterRange& range = m_range[ii];
+						range.first   = pos;
+						range.num     = bx::uint32_min(emitter.m_num, max - pos);
+						range.emitter = idx;
+						pos += range.num;
 					}
 
-					qsort(particleSort
-						, max
-						, sizeof(ParticleSort)
-						, particleSortFn
-						);
+					m_mtxView  = _mtxView;
+					m_eye      = _eye;
+					m_numQuads = max;
+					m_vertices = (PosColorTexCoord0Vertex*)tvb.data;
+					m_indices  = (uint16_t*)tib.data;
 
-					uint16_t* indices = (uint16_t*)tib.data;
-					for (uint32_t ii = 0; ii < max; ++ii)
-					{
-						const ParticleSort& sort = particleSort[ii];
-						uint16_t* index = &indices[ii*6];
-						uint16_t idx = (uint16_t)sort.idx;
-						index[0] = idx*4+0;
-						index[1] = idx*4+1;
-						index[2] = idx*4+2;
-						index[3] = idx*4+2;
-						index[4] = idx*4+3;
-						index[5] = idx*4+0;
-					}
+					parallelFor(evaluateJob, (numEmitters + kEmittersPerJob - 1) / kEmittersPerJob);
 
-					BX_FREE(m_allocator, particleSort);
+					bx::radixSort(m_keys, m_tempKeys, m_values, m_tempValues, max);
+
+					parallelFor(writeJob, (max + kQuadsPerJob - 1) / kQuadsPerJob);
 
 					bgfx::setState(0
 						| BGFX_STATE_WRITE_RGB
@@ -665,8 +985,29 @@ namespace ps
 
 		bx::AllocatorI* m_allocator;
 
+		PsParallelForFn m_parallelFor;
+		void*           m_context;
+
 		bx::HandleAlloc* m_emitterAlloc;
-		Emitter* m_emitter;
+		Emitter*         m_emitter;
+		EmitterRange*    m_range;
+
+		// Persistent scratch memory for evaluated particles and depth sort.
+		uint8_t*      m_scratch;
+		uint32_t      m_scratchMax;
+		uint32_t*     m_keys;
+		uint32_t*     m_tempKeys;
+		uint32_t*     m_values;
+		uint32_t*     m_tempValues;
+		ParticleQuad* m_quads;
+
+		// Per frame state shared with jobs.
+		float                    m_dt;
+		const float*             m_mtxView;
+		bx::Vec3                 m_eye;
+		uint32_t                 m_numQuads;
+		PosColorTexCoord0Vertex* m_vertices;
+		uint16_t*                m_indices;
 
 		typedef SpriteT<256, SPRITE_TEXTURE_SIZE> Sprite;
 		Sprite m_sprite;
@@ -687,22 +1028,31 @@ namespace ps
 		m_shape     = _shape;
 		m_direction = _direction;
 		m_max       = _maxParticles;
-		m_particles = (Particle*)BX_ALLOC(s_ctx.m_allocator, m_max*sizeof(Particle) );
+
+		const uint32_t stride = bx::strideAlign(m_max, 4)*sizeof(float);
+		const uint32_t size   = stride*ParticleStream::Count;
+		uint8_t* data = (uint8_t*)BX_ALIGNED_ALLOC(s_ctx.m_allocator, size, 16);
+		bx::memSet(data, 0, size);
+
+		for (uint32_t ii = 0; ii < ParticleStream::Count; ++ii)
+		{
+			m_stream[ii] = (float*)&data[ii*stride];
+		}
 	}
 
 	void Emitter::destroy()
 	{
-		BX_FREE(s_ctx.m_allocator, m_particles);
-		m_particles = NULL;
+		BX_ALIGNED_FREE(s_ctx.m_allocator, m_stream[0], 16);
+		bx::memSet(m_stream, 0, sizeof(m_stream) );
 	}
 
 } // namespace ps
 
 using namespace ps;
 
-void psInit(uint16_t _maxEmitters, bx::AllocatorI* _allocator)
+void psInit(uint16_t _maxEmitters, bx::AllocatorI* _allocator, PsParallelForFn _parallelFor, void* _context)
 {
-	s_ctx.init(_maxEmitters, _allocator);
+	s_ctx.init(_maxEmitters, _allocator, _parallelFor, _context);
 }
 
 void psShutdown()
@@ -73,8 +73,20 @@ struct EmitterUniforms
 	EmitterSpriteHandle m_handle;
 };
 
+/// Job function invoked by parallel for callback for each job index in range [0, _num).
+typedef void (*PsJobFn)(void* _userData, uint32_t _idx);
+
+/// Parallel for callback. Must call `_fn(_userData, ii)` for every `ii` in range [0, _num), on
+/// any thread, and return only after all invocations have completed.
+typedef void (*PsParallelForFn)(void* _context, PsJobFn _fn, void* _userData, uint32_t _num);
+
 ///
-void psInit(uint16_t _maxEmitters = 64, bx::AllocatorI* _allocator = NULL);
+void psInit(
+	  uint16_t _maxEmitters = 64
+	, bx::AllocatorI* _allocator = NULL
+	, PsParallelForFn _parallelFor = NULL
+	, void* _context = NULL
+	);
 
 ///
 void psShutdown();
@@ -0,0 +1,289 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+#include "bgfx_utils.h"
+#include "mappedfile.h"
+#include "shaderpack.h"
+#include "entry/entry.h"
+
+#include <bx/hash.h>
+#include <bx/string.h>
+
+#define BGFX_CHUNK_MAGIC_SPK BX_MAKEFOURCC('S', 'P', 'K', 0x0)
+
+struct ShaderPack::Blob
+{
+	bgfx::ShaderHandle m_handle;
+	uint32_t m_prev;
+	uint32_t m_next;
+};
+
+ShaderPack::ShaderPack()
+	: m_file(NULL)
+	, m_entries(NULL)
+	, m_blobDesc(NULL)
+	, m_blobs(NULL)
+	, m_numEntries(0)
+	, m_numBlobs(0)
+	, m_numShaders(0)
+	, m_maxShaders(UINT32_MAX)
+	, m_head(UINT32_MAX)
+	, m_tail(UINT32_MAX)
+{
+}
+
+ShaderPack::~ShaderPack()
+{
+	close();
+}
+
+bool ShaderPack::open(const char* _name, uint32_t _maxShaders)
+{
+	char filePath[512];
+	bx::strCopy(filePath, BX_COUNTOF(filePath), getShaderPath() );
+	bx::strCat(filePath, BX_COUNTOF(filePath), _name);
+	bx::strCat(filePath, BX_COUNTOF(filePath), ".pack");
+
+	return openFile(filePath, _maxShaders);
+}
+
+bool ShaderPack::openFile(const char* _filePath, uint32_t _maxShaders)
+{
+	close();
+
+	MappedFile* file = mappedFileOpen(_filePath);
+	if (NULL == file)
+	{
+		DBG("Failed to open shader pack '%s'.", _filePath);
+		return false;
+	}
+
+	const uint32_t* header = (const uint32_t*)file->m_data;
+	const uint32_t  size   = file->m_size;
+
+	if (size < sizeof(uint32_t)*3
+	||  BGFX_CHUNK_MAGIC_SPK != header[0])
+	{
+		DBG("Invalid shader pack '%s'.", _filePath);
+		mappedFileRelease(file);
+		return false;
+	}
+
+	const uint32_t numEntries = header[1];
+	const uint32_t numBlobs   = header[2];
+	const uint64_t tableSize  = sizeof(uint32_t)*3 + (uint64_t(numEntries) + numBlobs)*sizeof(uint32_t)*2;
+
+	bool valid = tableSize <= size;
+
+	const uint32_t* entries  = &header[3];
+	const uint32_t* blobDesc = &entries[numEntries*2];
+
+	for (uint32_t ii = 0; valid && ii < numBlobs; ++ii)
+	{
+		valid = uint64_t(blobDesc[ii*2+0]) + blobDesc[ii*2+1] <= size;
+	}
+
+	for (uint32_t ii = 0; valid && ii < numEntries; ++ii)
+	{
+		valid = entries[ii*2+1] < numBlobs
+			&& (0 == ii || entries[ii*2-2] < entries[ii*2])
+			;
+	}
+
+	if (!valid)
+	{
+		DBG("Corrupted shader pack '%s'.", _filePath);
+		mappedFileRelease(file);
+		return false;
+	}
+
+	bx::AllocatorI* allocator = entry::getAllocator();
+
+	m_file       = file;
+	m_entries    = entries;
+	m_blobDesc   = blobDesc;
+	m_numEntries = numEntries;
+	m_numBlobs   = numBlobs;
+	m_blobs      = (Blob*)BX_ALLOC(allocator, bx::max<uint32_t>(numBlobs, 1)*sizeof(Blob) );
+
+	for (uint32_t ii = 0; ii < numBlobs; ++ii)
+	{
+		Blob& blob = m_blobs[ii];
+		blob.m_handle.idx = bgfx::kInvalidHandle;
+		blob.m_prev       = UINT32_MAX;
+		blob.m_next       = UINT32_MAX;
+	}
+
+	setMaxShaders(_maxShaders);
+
+	return true;
+}
+
+void ShaderPack::close()
+{
+	if (NULL == m_file)
+	{
+		return;
+	}
+
+	for (uint32_t ii = 0; ii < m_numBlobs; ++ii)
+	{
+		if (bgfx::isValid(m_blobs[ii].m_handle) )
+		{
+			bgfx::destroy(m_blobs[ii].m_handle);
+		}
+	}
+
+	BX_FREE(entry::getAllocator(), m_blobs);
+
+	// References passed to bgfx keep file mapped until shaders are created.
+	mappedFileRelease(m_file);
+
+	m_file       = NULL;
+	m_entries    = NULL;
+	m_blobDesc   = NULL;
+	m_blobs      = NULL;
+	m_numEntries = 0;
+	m_numBlobs   = 0;
+	m_numShaders = 0;
+	m_head       = UINT32_MAX;
+	m_tail       = UINT32_MAX;
+}
+
+bgfx::ShaderHandle ShaderPack::get(const char* _name)
+{
+	return get(bx::hash<bx::HashMurmur2A>(_name) );
+}
+
+bgfx::ShaderHandle ShaderPack::get(uint32_t _key)
+{
+	const uint32_t idx = find(_key);
+	if (UINT32_MAX == idx)
+	{
+		bgfx::ShaderHandle invalid = BGFX_INVALID_HANDLE;
+		return invalid;
+	}
+
+	const uint32_t blobIdx = m_entries[idx*2+1];
+	Blob& blob = m_blobs[blobIdx];
+
+	if (bgfx::isValid(blob.m_handle) )
+	{
+		unlink(blobIdx);
+	}
+	else
+	{
+		mappedFileAddRef(m_file);
+		const bgfx::Memory* mem = bgfx::makeRef(
+			  &m_file->m_data[m_blobDesc[blobIdx*2+0] ]
+			, m_blobDesc[blobIdx*2+1]
+			, mappedFileReleaseRef
+			, m_file
+			);
+
+		blob.m_handle = bgfx::createShader(mem);
+		++m_numShaders;
+	}
+
+	blob.m_prev = UINT32_MAX;
+	blob.m_next = m_head;
+
+	if (UINT32_MAX != m_head)
+	{
+		m_blobs[m_head].m_prev = blobIdx;
+	}
+
+	m_head = blobIdx;
+
+	if (UINT32_MAX == m_tail)
+	{
+		m_tail = blobIdx;
+	}
+
+	evict();
+
+	return blob.m_handle;
+}
+
+bool ShaderPack::contains(uint32_t _key) const
+{
+	return UINT32_MAX != find(_key);
+}
+
+void ShaderPack::setMaxShaders(uint32_t _maxShaders)
+{
+	// Vertex and fragment shader must be alive at the same time to create program.
+	m_maxShaders = bx::max<uint32_t>(_maxShaders, 2);
+	evict();
+}
+
+uint32_t ShaderPack::find(uint32_t _key) const
+{
+	uint32_t first = 0;
+	uint32_t last  = m_numEntries;
+
+	while (first < last)
+	{
+		const uint32_t mid = (first + last) / 2;
+		const uint32_t key = m_entries[mid*2];
+
+		if (key == _key)
+		{
+			return mid;
+		}
+
+		if (key < _key)
+		{
+			first = mid + 1;
+		}
+		else
+		{
+			last = mid;
+		}
+	}
+
+	return UINT32_MAX;
+}
+
+void ShaderPack::unlink(uint32_t _blob)
+{
+	Blob& blob = m_blobs[_blob];
+
+	if (UINT32_MAX != blob.m_prev)
+	{
+		m_blobs[blob.m_prev].m_next = blob.m_next;
+	}
+	else
+	{
+		m_head = blob.m_next;
+	}
+
+	if (UINT32_MAX != blob.m_next)
+	{
+		m_blobs[blob.m_next].m_prev = blob.m_prev;
+	}
+	else
+	{
+		m_tail = blob.m_prev;
+	}
+
+	blob.m_prev = UINT32_MAX;
+	blob.m_next = UINT32_MAX;
+}
+
+void ShaderPack::evict()
+{
+	while (m_numShaders > m_maxShaders)
+	{
+		const uint32_t blobIdx = m_tail;
+		unlink(blobIdx);
+
+		Blob& blob = m_blobs[blobIdx];
+		bgfx::destroy(blob.m_handle);
+		blob.m_handle.idx = bgfx::kInvalidHandle;
+		--m_numShaders;
+	}
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef SHADERPACK_H_HEADER_GUARD
+#define SHADERPACK_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+
+struct MappedFile;
+
+/// Shader permutations packed with `shaderc --pack`. Pack file is memory-mapped,
+/// and shader is created only when permutation is requested for the first time.
+/// Shader bytecode is passed to bgfx as reference into mapped file.
+///
+/// When number of created shaders exceeds budget, least recently requested
+/// shader is destroyed. Programs created from it remain valid. Shaders owned by
+/// pack must not be passed to `bgfx::createProgram` with `_destroyShaders`.
+///
+class ShaderPack
+{
+public:
+	///
+	ShaderPack();
+
+	///
+	~ShaderPack();
+
+	/// Opens `<name>.pack` from renderer specific shader directory.
+	bool open(const char* _name, uint32_t _maxShaders = UINT32_MAX);
+
+	/// Opens pack file.
+	bool openFile(const char* _filePath, uint32_t _maxShaders = UINT32_MAX);
+
+	/// Destroys all shaders created by pack.
+	void close();
+
+	/// Returns shader for permutation name, or invalid handle when permutation
+	/// is not in pack. Handle stays valid until it's evicted by later request.
+	bgfx::ShaderHandle get(const char* _name);
+
+	/// Returns shader for permutation key, which is MurmurHash2A of permutation name.
+	bgfx::ShaderHandle get(uint32_t _key);
+
+	/// Returns true if permutation is in pack.
+	bool contains(uint32_t _key) const;
+
+	///
+	void setMaxShaders(uint32_t _maxShaders);
+
+	/// Returns number of permutations in pack.
+	uint32_t getNumPermutations() const
+	{
+		return m_numEntries;
+	}
+
+	/// Returns number of shaders currently created.
+	uint32_t getNumShaders() const
+	{
+		return m_numShaders;
+	}
+
+private:
+	struct Blob;
+
+	uint32_t find(uint32_t _key) const;
+	void unlink(uint32_t _blob);
+	void evict();
+
+	MappedFile*     m_file;
+	const uint32_t* m_entries;
+	const uint32_t* m_blobDesc;
+	Blob*           m_blobs;
+
+	uint32_t m_numEntries;
+	uint32_t m_numBlobs;
+	uint32_t m_numShaders;
+	uint32_t m_maxShaders;
+	uint32_t m_head; //!< Most recently requested.
+	uint32_t m_tail; //!< Least recently requested.
+};
+
+#endif // SHADERPACK_H_HEADER_GUARD
@@ -386,6 +386,7 @@ namespace bgfx
 			Sequential,      //!< Sort in the same order in which submit calls were called.
 			DepthAscending,  //!< Sort draw call depth in ascending order.
 			DepthDescending, //!< Sort draw call depth in descending order.
+			Material,        //!< Sort by program, render state, texture bindings, and vertex/index buffers to minimize state changes.
 
 			Count
 		};
@@ -821,6 +822,7 @@ namespace bgfx
 		uint32_t size;            //!< Data size.
 		uint32_t startIndex;      //!< First index.
 		IndexBufferHandle handle; //!< Index buffer handle.
+		bool isIndex16;           //!< Index buffer format is 16-bits if true, otherwise it is 32-bit.
 	};
 
 	/// Transient vertex buffer.
@@ -925,14 +927,30 @@ namespace bgfx
 	///
 	/// @attention C99 equivalent is `bgfx_view_stats_t`.
 	///
+	/// @remarks View stats are collected only when `BGFX_DEBUG_PROFILER` debug flag is set.
+	///   Views whose items were all dropped are reported without timings.
+	///
 	struct ViewStats
 	{
-		char    name[256];      //!< View name.
-		ViewId  view;           //!< View id.
-		int64_t cpuTimeBegin;   //!< CPU (submit) begin time.
-		int64_t cpuTimeEnd;     //!< CPU (submit) end time.
-		int64_t gpuTimeBegin;   //!< GPU begin time.
-		int64_t gpuTimeEnd;     //!< GPU end time.
+		char     name[256];                 //!< View name.
+		ViewId   view;                      //!< View id.
+		int64_t  cpuTimeBegin;              //!< CPU (submit) begin time.
+		int64_t  cpuTimeEnd;                //!< CPU (submit) end time.
+		int64_t  gpuTimeBegin;              //!< GPU begin time.
+		int64_t  gpuTimeEnd;                //!< GPU end time.
+
+		uint32_t numDraw;                   //!< Number of draw calls submitted to view.
+		uint32_t numCompute;                //!< Number of compute calls submitted to view.
+		uint32_t numBlit;                   //!< Number of blit calls submitted to view.
+		uint32_t numDropped;                //!< Number of draw and compute calls dropped because frame
+		                                    //!  exceeded `BGFX_CONFIG_MAX_DRAW_CALLS`.
+		uint32_t numProgramChanges;         //!< Number of program changes between sorted draw calls.
+		uint32_t numBindChanges;            //!< Number of texture and buffer binding changes between sorted draw calls.
+		uint32_t numBufferChanges;          //!< Number of vertex and index buffer changes between sorted draw calls.
+		uint32_t numStateChanges;           //!< Number of render state changes between sorted draw calls.
+		uint32_t uniformSize;               //!< Size of uniform data submitted to view in bytes.
+		uint32_t numInstances;              //!< Number of instances rendered.
+		uint32_t numPrims[Topology::Count]; //!< Number of primitives rendered.
 	};
 
 	/// Encoder stats.
@@ -1003,6 +1021,12 @@ namespace bgfx
 
 		uint8_t       numEncoders;          //!< Number of encoders used during frame.
 		EncoderStats* encoderStats;         //!< Array of encoder stats.
+
+		uint32_t numProgramChanges;         //!< Number of program changes between sorted draw calls.
+		uint32_t numBindChanges;            //!< Number of texture and buffer binding changes between sorted draw calls.
+		uint32_t numBufferChanges;          //!< Number of vertex and index buffer changes between sorted draw calls.
+		uint32_t numStateChanges;           //!< Number of render state changes between sorted draw calls. State change
+		                                    //!  counters are updated only when `BGFX_DEBUG_PROFILER` is set.
 	};
 
 	/// Encoders are used for submitting draw calls from multiple threads. Only one encoder
@@ -1978,8 +2002,17 @@ namespace bgfx
 	/// Begin submitting draw calls from thread.
 	///
 	/// @param[in] _forThread Explicitly request an encoder for a worker thread.
-	///
-	Encoder* begin(bool _forThread = false);
+	/// @param[in] _ordinal Sequential view ordering slot. Draw calls from encoder with lower ordinal are ordered first.
+	///   Sequential views order draw calls by encoder ordinal first, and then in submit
+	///   order within encoder. Each ordinal should be used by one encoder per frame. API
+	///   thread encoder always uses ordinal 0. Valid ordinals are 0 to 254.
+	///   When `UINT8_MAX`, encoder index is used. Encoder index depends on order in which
+	///   threads call `begin`, so order of draw calls between encoders is not deterministic.
+	///   Pass explicit ordinal when sequential views must be reproducible.
+	///   Each encoder orders up to 2^20 draw calls per sequential view, further draw calls
+	///   share the last sequence number.
+	///
+	Encoder* begin(bool _forThread = false, uint8_t _ordinal = UINT8_MAX);
 
 	/// End submitting draw calls from thread.
 	///
@@ -2403,10 +2436,14 @@ namespace bgfx
 	/// Returns number of requested or maximum available indices.
 	///
 	/// @param[in] _num Number of required indices.
+	/// @param[in] _index32 Set to `true` if input indices will be 32-bit.
 	///
 	/// @attention C99 equivalent is `bgfx_get_avail_transient_index_buffer`.
 	///
-	uint32_t getAvailTransientIndexBuffer(uint32_t _num);
+	uint32_t getAvailTransientIndexBuffer(
+		  uint32_t _num
+		, bool _index32 = false
+		);
 
 	/// Returns number of requested or maximum available vertices.
 	///
@@ -2438,15 +2475,17 @@ namespace bgfx
 	///   for the duration of frame, and it can be reused for multiple draw
 	///   calls.
 	/// @param[in] _num Number of indices to allocate.
+	/// @param[in] _index32 Set to `true` if input indices will be 32-bit.
 	///
 	/// @remarks
-	///   Only 16-bit index buffer is supported.
+	///   32-bit indices require `BGFX_CAPS_INDEX32`.
 	///
 	/// @attention C99 equivalent is `bgfx_alloc_transient_index_buffer`.
 	///
 	void allocTransientIndexBuffer(
 		  TransientIndexBuffer* _tib
 		, uint32_t _num
+		, bool _index32 = false
 		);
 
 	/// Allocate transient vertex buffer.
@@ -2470,7 +2509,7 @@ namespace bgfx
 	/// true.
 	///
 	/// @remarks
-	///   Only 16-bit index buffer is supported.
+	///   32-bit indices require `BGFX_CAPS_INDEX32`.
 	///
 	/// @attention C99 equivalent is `bgfx_alloc_transient_buffers`.
 	///
@@ -2480,6 +2519,7 @@ namespace bgfx
 		, uint32_t _numVertices
 		, TransientIndexBuffer* _tib
 		, uint32_t _numIndices
+		, bool _index32 = false
 		);
 
 	/// Allocate instance data buffer.
@@ -2908,6 +2948,25 @@ namespace bgfx
 		, uint8_t _mip = 0
 		);
 
+	/// Set most detailed resident mip of texture. Sampling is clamped to mips from `_mip` to
+	/// the smallest mip, so that texture can be created with full mip chain, and only the
+	/// smallest mips uploaded. Higher mips can be streamed in later with `bgfx::updateTexture*`,
+	/// and made visible by lowering resident mip, or evicted by raising it again.
+	///
+	/// @param[in] _handle Texture handle.
+	/// @param[in] _mip Most detailed mip level that can be sampled.
+	///
+	/// @remarks Clamp is applied from the next frame, after texture updates submitted in the same
+	///   frame. Backends don't release memory of evicted mips. Use `Stats::gpuMemoryUsed` and
+	///   `Stats::gpuMemoryMax` as memory budget where available.
+	///
+	/// @attention C99 equivalent is `bgfx_set_texture_resident_mip`.
+	///
+	void setTextureResidentMip(
+		  TextureHandle _handle
+		, uint8_t _mip
+		);
+
 	/// Set texture debug name.
 	///
 	/// @param[in] _handle Texture handle.
@@ -4108,6 +4167,25 @@ namespace bgfx
 		, const char* _filePath
 		);
 
+	/// Request timeline trace. Profiler scopes from all threads, encoder submit times, and per view
+	/// CPU and GPU times are recorded, and written as Chrome trace event JSON after requested number
+	/// of frames is rendered.
+	///
+	/// @param[in] _filePath Trace file path.
+	/// @param[in] _numFrames Number of frames to record.
+	///
+	/// @remarks
+	///   Profiler scopes are recorded only when library is built with `BGFX_CONFIG_PROFILER`.
+	///   Trace is recorded only when library is built with `BGFX_CONFIG_TRACE`, which is disabled by
+	///   default.
+	///
+	/// @attention C99 equivalent is `bgfx_request_trace`.
+	///
+	void requestTrace(
+		  const char* _filePath
+		, uint32_t _numFrames = 1
+		);
+
 } // namespace bgfx
 
 #endif // BGFX_H_HEADER_GUARD
@@ -374,6 +374,7 @@ typedef enum bgfx_view_mode
     BGFX_VIEW_MODE_SEQUENTIAL,                /** ( 1) Sort in the same order in which submit calls were called. */
     BGFX_VIEW_MODE_DEPTH_ASCENDING,           /** ( 2) Sort draw call depth in ascending order. */
     BGFX_VIEW_MODE_DEPTH_DESCENDING,          /** ( 3) Sort draw call depth in descending order. */
+    BGFX_VIEW_MODE_MATERIAL,                  /** ( 4) Sort by program, render state, texture bindings, and vertex/index buffers to minimize state changes. */
 
     BGFX_VIEW_MODE_COUNT
 
@@ -709,6 +710,7 @@ typedef struct bgfx_transient_index_buffer_s
     uint32_t             size;               /** Data size.                               */
     uint32_t             startIndex;         /** First index.                             */
     bgfx_index_buffer_handle_t handle;       /** Index buffer handle.                     */
+    bool                 isIndex16;          /** Index buffer format is 16-bits if true, otherwise it is 32-bit. */
 
 } bgfx_transient_index_buffer_t;
 
@@ -809,6 +811,17 @@ typedef struct bgfx_view_stats_s
     int64_t              cpuTimeEnd;         /** CPU (submit) end time.                   */
     int64_t              gpuTimeBegin;       /** GPU begin time.                          */
     int64_t              gpuTimeEnd;         /** GPU end time.                            */
+    uint32_t             numDraw;            /** Number of draw calls submitted to view.  */
+    uint32_t             numCompute;         /** Number of compute calls submitted to view. */
+    uint32_t             numBlit;            /** Number of blit calls submitted to view.  */
+    uint32_t             numDropped;         /** Number of draw and compute calls dropped because frame exceeded `BGFX_CONFIG_MAX_DRAW_CALLS`. */
+    uint32_t             numProgramChanges;  /** Number of program changes between sorted draw calls. */
+    uint32_t             numBindChanges;     /** Number of texture and buffer binding changes between sorted draw calls. */
+    uint32_t             numBufferChanges;   /** Number of vertex and index buffer changes between sorted draw calls. */
+    uint32_t             numStateChanges;    /** Number of render state changes between sorted draw calls. */
+    uint32_t             uniformSize;        /** Size of uniform data submitted to view in bytes. */
+    uint32_t             numInstances;       /** Number of instances rendered.            */
+    uint32_t             numPrims[BGFX_TOPOLOGY_COUNT]; /** Number of primitives rendered.   */
 
 } bgfx_view_stats_t;
 
@@ -870,6 +883,10 @@ typedef struct bgfx_stats_s
     bgfx_view_stats_t*   viewStats;          /** Array of View stats.                     */
     uint8_t              numEncoders;        /** Number of encoders used during frame.    */
     bgfx_encoder_stats_t* encoderStats;      /** Array of encoder stats.                  */
+    uint32_t             numProgramChanges;  /** Number of program changes between sorted draw calls. */
+    uint32_t             numBindChanges;     /** Number of texture and buffer binding changes between sorted draw calls. */
+    uint32_t             numBufferChanges;   /** Number of vertex and index buffer changes between sorted draw calls. */
+    uint32_t             numStateChanges;    /** Number of render state changes between sorted draw calls. State change counters are updated only when `BGFX_DEBUG_PROFILER` is set. */
 
 } bgfx_stats_t;
 
@@ -1505,11 +1522,12 @@ BGFX_C_API void bgfx_destroy_dynamic_vertex_buffer(bgfx_dynamic_vertex_buffer_ha
  * Returns number of requested or maximum available indices.
  *
  * @param[in] _num Number of required indices.
+ * @param[in] _index32 Set to `true` if input indices will be 32-bit.
  *
  * @returns Number of requested or maximum available indices.
  *
  */
-BGFX_C_API uint32_t bgfx_get_avail_transient_index_buffer(uint32_t _num);
+BGFX_C_API uint32_t bgfx_get_avail_transient_index_buffer(uint32_t _num, bool _index32);
 
 /**
  * Returns number of requested or maximum available vertices.
@@ -1536,15 +1554,16 @@ BGFX_C_API uint32_t bgfx_get_avail_instance_data_buffer(uint32_t _num, uint16_t
 /**
  * Allocate transient index buffer.
  * @remarks
- *   Only 16-bit index buffer is supported.
+ *   32-bit indices require `BGFX_CAPS_INDEX32`.
  *
  * @param[out] _tib TransientIndexBuffer structure is filled and is valid
  *  for the duration of frame, and it can be reused for multiple draw
  *  calls.
  * @param[in] _num Number of indices to allocate.
+ * @param[in] _index32 Set to `true` if input indices will be 32-bit.
  *
  */
-BGFX_C_API void bgfx_alloc_transient_index_buffer(bgfx_transient_index_buffer_t* _tib, uint32_t _num);
+BGFX_C_API void bgfx_alloc_transient_index_buffer(bgfx_transient_index_buffer_t* _tib, uint32_t _num, bool _index32);
 
 /**
  * Allocate transient vertex buffer.
@@ -1563,7 +1582,7 @@ BGFX_C_API void bgfx_alloc_transient_vertex_buffer(bgfx_transient_vertex_buffer_
  * buffers. If both space requirements are satisfied function returns
  * true.
  * @remarks
- *   Only 16-bit index buffer is supported.
+ *   32-bit indices require `BGFX_CAPS_INDEX32`.
  *
  * @param[out] _tvb TransientVertexBuffer structure is filled and is valid
  *  for the duration of frame, and it can be reused for multiple draw
@@ -1574,9 +1593,10 @@ BGFX_C_API void bgfx_alloc_transient_vertex_buffer(bgfx_transient_vertex_buffer_
  *  for the duration of frame, and it can be reused for multiple draw
  *  calls.
  * @param[in] _numIndices Number of indices to allocate.
+ * @param[in] _index32 Set to `true` if input indices will be 32-bit.
  *
  */
-BGFX_C_API bool bgfx_alloc_transient_buffers(bgfx_transient_vertex_buffer_t* _tvb, const bgfx_vertex_layout_t * _layout, uint32_t _numVertices, bgfx_transient_index_buffer_t* _tib, uint32_t _numIndices);
+BGFX_C_API bool bgfx_alloc_transient_buffers(bgfx_transient_vertex_buffer_t* _tvb, const bgfx_vertex_layout_t * _layout, uint32_t _numVertices, bgfx_transient_index_buffer_t* _tib, uint32_t _numIndices, bool _index32);
 
 /**
  * Allocate instance data buffer.
@@ -1908,6 +1928,22 @@ BGFX_C_API void bgfx_update_texture_cube(bgfx_texture_handle_t _handle, uint16_t
  */
 BGFX_C_API uint32_t bgfx_read_texture(bgfx_texture_handle_t _handle, void* _data, uint8_t _mip);
 
+/**
+ * Set most detailed resident mip of texture. Sampling is clamped to mips from `_mip` to
+ * the smallest mip, so that texture can be created with full mip chain, and only the
+ * smallest mips uploaded. Higher mips can be streamed in later with `bgfx::updateTexture*`,
+ * and made visible by lowering resident mip, or evicted by raising it again.
+ * @remarks
+ *   Clamp is applied from the next frame, after texture updates submitted in the same
+ *   frame. Backends don't release memory of evicted mips. Use `Stats::gpuMemoryUsed` and
+ *   `Stats::gpuMemoryMax` as memory budget where available.
+ *
+ * @param[in] _handle Texture handle.
+ * @param[in] _mip Most detailed mip level that can be sampled.
+ *
+ */
+BGFX_C_API void bgfx_set_texture_resident_mip(bgfx_texture_handle_t _handle, uint8_t _mip);
+
 /**
  * Set texture debug name.
  *
@@ -2292,11 +2328,12 @@ BGFX_C_API void bgfx_reset_view(bgfx_view_id_t _id);
  * Begin submitting draw calls from thread.
  *
  * @param[in] _forThread Explicitly request an encoder for a worker thread.
+ * @param[in] _ordinal Sequential view ordering slot. Draw calls from encoder with lower ordinal are ordered first. Valid ordinals are 0 to 254. When `UINT8_MAX`, encoder index is used, which depends on order in which threads call begin, so order of draw calls between encoders is not deterministic. Each encoder orders up to 2^20 draw calls per sequential view, further draw calls share the last sequence number.
  *
  * @returns Encoder.
  *
  */
-BGFX_C_API bgfx_encoder_t* bgfx_encoder_begin(bool _forThread);
+BGFX_C_API bgfx_encoder_t* bgfx_encoder_begin(bool _forThread, uint8_t _ordinal);
 
 /**
  * End submitting draw calls from thread.
@@ -2759,6 +2796,21 @@ BGFX_C_API void bgfx_encoder_blit(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgf
  */
 BGFX_C_API void bgfx_request_screen_shot(bgfx_frame_buffer_handle_t _handle, const char* _filePath);
 
+/**
+ * Request timeline trace. Profiler scopes from all threads, encoder submit times, and per view
+ * CPU and GPU times are recorded, and written as Chrome trace event JSON after requested number
+ * of frames is rendered.
+ * @remarks
+ *   Profiler scopes are recorded only when library is built with `BGFX_CONFIG_PROFILER`.
+ *   Trace is recorded only when library is built with `BGFX_CONFIG_TRACE`, which is disabled by
+ *   default.
+ *
+ * @param[in] _filePath Trace file path.
+ * @param[in] _numFrames Number of frames to record.
+ *
+ */
+BGFX_C_API void bgfx_request_trace(const char* _filePath, uint32_t _numFrames);
+
 /**
  * Render frame.
  * @attention `bgfx::renderFrame` is blocking call. It waits for
@@ -3344,6 +3396,7 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_UPDATE_TEXTURE_3D,
     BGFX_FUNCTION_ID_UPDATE_TEXTURE_CUBE,
     BGFX_FUNCTION_ID_READ_TEXTURE,
+    BGFX_FUNCTION_ID_SET_TEXTURE_RESIDENT_MIP,
     BGFX_FUNCTION_ID_SET_TEXTURE_NAME,
     BGFX_FUNCTION_ID_GET_DIRECT_ACCESS_PTR,
     BGFX_FUNCTION_ID_DESTROY_TEXTURE,
@@ -3413,6 +3466,7 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_ENCODER_DISCARD,
     BGFX_FUNCTION_ID_ENCODER_BLIT,
     BGFX_FUNCTION_ID_REQUEST_SCREEN_SHOT,
+    BGFX_FUNCTION_ID_REQUEST_TRACE,
     BGFX_FUNCTION_ID_RENDER_FRAME,
     BGFX_FUNCTION_ID_SET_PLATFORM_DATA,
     BGFX_FUNCTION_ID_GET_INTERNAL_DATA,
@@ -3510,12 +3564,12 @@ struct bgfx_interface_vtbl
     bgfx_dynamic_vertex_buffer_handle_t (*create_dynamic_vertex_buffer_mem)(const bgfx_memory_t* _mem, const bgfx_vertex_layout_t* _layout, uint16_t _flags);
     void (*update_dynamic_vertex_buffer)(bgfx_dynamic_vertex_buffer_handle_t _handle, uint32_t _startVertex, const bgfx_memory_t* _mem);
     void (*destroy_dynamic_vertex_buffer)(bgfx_dynamic_vertex_buffer_handle_t _handle);
-    uint32_t (*get_avail_transient_index_buffer)(uint32_t _num);
+    uint32_t (*get_avail_transient_index_buffer)(uint32_t _num, bool _index32);
     uint32_t (*get_avail_transient_vertex_buffer)(uint32_t _num, const bgfx_vertex_layout_t * _layout);
     uint32_t (*get_avail_instance_data_buffer)(uint32_t _num, uint16_t _stride);
-    void (*alloc_transient_index_buffer)(bgfx_transient_index_buffer_t* _tib, uint32_t _num);
+    void (*alloc_transient_index_buffer)(bgfx_transient_index_buffer_t* _tib, uint32_t _num, bool _index32);
     void (*alloc_transient_vertex_buffer)(bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_layout_t * _layout);
-    bool (*alloc_transient_buffers)(bgfx_transient_vertex_buffer_t* _tvb, const bgfx_vertex_layout_t * _layout, uint32_t _numVertices, bgfx_transient_index_buffer_t* _tib, uint32_t _numIndices);
+    bool (*alloc_transient_buffers)(bgfx_transient_vertex_buffer_t* _tvb, const bgfx_vertex_layout_t * _layout, uint32_t _numVertices, bgfx_transient_index_buffer_t* _tib, uint32_t _numIndices, bool _index32);
     void (*alloc_instance_data_buffer)(bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride);
     bgfx_indirect_buffer_handle_t (*create_indirect_buffer)(uint32_t _num);
     void (*destroy_indirect_buffer)(bgfx_indirect_buffer_handle_t _handle);
@@ -3537,6 +3591,7 @@ struct bgfx_interface_vtbl
     void (*update_texture_3d)(bgfx_texture_handle_t _handle, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _z, uint16_t _width, uint16_t _height, uint16_t _depth, const bgfx_memory_t* _mem);
     void (*update_texture_cube)(bgfx_texture_handle_t _handle, uint16_t _layer, uint8_t _side, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const bgfx_memory_t* _mem, uint16_t _pitch);
     uint32_t (*read_texture)(bgfx_texture_handle_t _handle, void* _data, uint8_t _mip);
+    void (*set_texture_resident_mip)(bgfx_texture_handle_t _handle, uint8_t _mip);
     void (*set_texture_name)(bgfx_texture_handle_t _handle, const char* _name, int32_t _len);
     void* (*get_direct_access_ptr)(bgfx_texture_handle_t _handle);
     void (*destroy_texture)(bgfx_texture_handle_t _handle);
@@ -3567,7 +3622,7 @@ struct bgfx_interface_vtbl
     void (*set_view_transform)(bgfx_view_id_t _id, const void* _view, const void* _proj);
     void (*set_view_order)(bgfx_view_id_t _id, uint16_t _num, const bgfx_view_id_t* _order);
     void (*reset_view)(bgfx_view_id_t _id);
-    bgfx_encoder_t* (*encoder_begin)(bool _forThread);
+    bgfx_encoder_t* (*encoder_begin)(bool _forThread, uint8_t _ordinal);
     void (*encoder_end)(bgfx_encoder_t* _encoder);
     void (*encoder_set_marker)(bgfx_encoder_t* _this, const char* _marker);
     void (*encoder_set_state)(bgfx_encoder_t* _this, uint64_t _state, uint32_t _rgba);
@@ -3606,6 +3661,7 @@ struct bgfx_interface_vtbl
     void (*encoder_discard)(bgfx_encoder_t* _this, uint8_t _flags);
     void (*encoder_blit)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_texture_handle_t _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, bgfx_texture_handle_t _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
     void (*request_screen_shot)(bgfx_frame_buffer_handle_t _handle, const char* _filePath);
+    void (*request_trace)(const char* _filePath, uint32_t _numFrames);
     bgfx_render_frame_t (*render_frame)(int32_t _msecs);
     void (*set_platform_data)(const bgfx_platform_data_t * _data);
     const bgfx_internal_data_t* (*get_internal_data)(void);
@@ -228,6 +228,7 @@ function bgfxProjectBase(_kind, _defines)
 			path.join(BGFX_DIR, "src/nvapi.cpp"),
 			path.join(BGFX_DIR, "src/renderer_**.cpp"),
 			path.join(BGFX_DIR, "src/shader**.cpp"),
+			path.join(BGFX_DIR, "src/timeline.cpp"),
 			path.join(BGFX_DIR, "src/topology.cpp"),
 			path.join(BGFX_DIR, "src/vertexlayout.cpp"),
 		}
@@ -579,9 +579,10 @@ or _OPTIONS["with-combined-examples"] then
 		, "42-bunnylod"
 		)
 
-	-- 17-drawstress requires multithreading, does not compile for singlethreaded wasm
+	-- 17-drawstress and 43-transientalloc require multithreading, do not compile for singlethreaded wasm
 --	if platform is not single-threaded then
 		exampleProject(false, "17-drawstress")
+		exampleProject(false, "43-transientalloc")
 --	end
 
 	-- C99 source doesn't compile under WinRT settings
@@ -23,5 +23,6 @@
 #include "shader_dx9bc.cpp"
 #include "shader_dxbc.cpp"
 #include "shader_spirv.cpp"
+#include "timeline.cpp"
 #include "topology.cpp"
 #include "vertexlayout.cpp"
@@ -290,10 +290,12 @@ namespace bgfx
 	};
 
 	static ThreadData s_threadIndex(0);
+	static ThreadData s_threadEncoder(0);
 #elif !BGFX_CONFIG_MULTITHREADED
 	static uint32_t s_threadIndex(0);
 #else
 	static BX_THREAD_LOCAL uint32_t s_threadIndex(0);
+	static BX_THREAD_LOCAL uintptr_t s_threadEncoder(0);
 #endif
 
 	static Context* s_ctx = NULL;
@@ -1202,6 +1204,47 @@ namespace bgfx
 		}
 	}
 
+	// Material sort field, ordered from the most to the least expensive state change: render
+	// state, texture bindings, and vertex/index buffers. Each part is hashed, collision only
+	// makes order less optimal.
+	static uint32_t encodeMaterial(const RenderDraw& _draw, const RenderBind& _bind)
+	{
+		constexpr uint32_t kStateBits  = BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL/4;
+		constexpr uint32_t kBufferBits = BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL/4;
+		constexpr uint32_t kBindBits   = BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL - kStateBits - kBufferBits;
+		BX_STATIC_ASSERT(0 < kStateBits && 32 >= kBindBits);
+
+		bx::HashMurmur2A state;
+		state.begin();
+		state.add(_draw.m_stateFlags);
+		state.add(_draw.m_stencil);
+
+		bx::HashMurmur2A bind;
+		bind.begin();
+		for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+		{
+			const Binding& binding = _bind.m_bind[stage];
+			if (kInvalidHandle != binding.m_idx)
+			{
+				bind.add(stage);
+				bind.add(binding.m_idx);
+				bind.add(binding.m_type);
+				bind.add(binding.m_samplerFlags);
+			}
+		}
+
+		bx::HashMurmur2A buffer;
+		buffer.begin();
+		buffer.add(0 != (_draw.m_streamMask & 1) ? _draw.m_stream[0].m_handle.idx : kInvalidHandle);
+		buffer.add(_draw.m_indexBuffer.idx);
+
+		return 0
+			| ( (state.end()  >> (32-kStateBits ) ) << (kBindBits+kBufferBits) )
+			| ( (bind.end()   >> (32-kBindBits  ) ) << kBufferBits)
+			| ( (buffer.end() >> (32-kBufferBits) ) )
+			;
+	}
+
 	void EncoderImpl::submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, uint8_t _flags)
 	{
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
@@ -1239,6 +1282,7 @@ namespace bgfx
 		{
 			discard(_flags);
 			++m_numDropped;
+			bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_viewCounters[_id].m_numDropped, 1);
 			return;
 		}
 
@@ -1257,9 +1301,14 @@ namespace bgfx
 		SortKey::Enum type = SortKey::SortProgram;
 		switch (s_ctx->m_view[_id].m_mode)
 		{
-		case ViewMode::Sequential:      m_key.m_seq   = s_ctx->getSeqIncr(_id); type = SortKey::SortSequence; break;
+		case ViewMode::Sequential:      m_key.m_seq   = getSeqIncr(_id);        type = SortKey::SortSequence; break;
 		case ViewMode::DepthAscending:  m_key.m_depth =            _depth;      type = SortKey::SortDepth;    break;
 		case ViewMode::DepthDescending: m_key.m_depth = UINT32_MAX-_depth;      type = SortKey::SortDepth;    break;
+		case ViewMode::Material:
+			m_key.m_depth    = _depth;
+			m_key.m_material = encodeMaterial(m_draw, m_bind);
+			type = SortKey::SortMaterial;
+			break;
 		default: break;
 		}
 
@@ -1328,6 +1377,7 @@ namespace bgfx
 		{
 			discard(_flags);
 			++m_numDropped;
+			bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_viewCounters[_id].m_numDropped, 1);
 			return;
 		}
 
@@ -1345,7 +1395,7 @@ namespace bgfx
 		m_key.m_program = _handle;
 		m_key.m_depth   = 0;
 		m_key.m_view    = _id;
-		m_key.m_seq     = s_ctx->getSeqIncr(_id);
+		m_key.m_seq     = getSeqIncr(_id);
 
 		uint64_t key = m_key.encodeCompute();
 		m_frame->m_sortKeys[renderItemIdx]   = key;
@@ -1415,6 +1465,106 @@ namespace bgfx
 			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
 		}
 		bx::radixSort(m_blitKeys, (uint32_t*)&s_ctx->m_tempKeys, m_numBlitItems);
+
+		if (0 != (m_debug & BGFX_DEBUG_PROFILER) )
+		{
+			countViewStats();
+		}
+	}
+
+	void Frame::countViewStats()
+	{
+		uint32_t numProgramChanges = 0;
+		uint32_t numBindChanges    = 0;
+		uint32_t numBufferChanges  = 0;
+		uint32_t numStateChanges   = 0;
+
+		RenderBind currentBind;
+		currentBind.clear();
+
+		uint16_t currentProgram = kInvalidHandle;
+		uint16_t currentVb      = kInvalidHandle;
+		uint16_t currentIb      = kInvalidHandle;
+		uint64_t currentState   = 0;
+		uint64_t currentStencil = 0;
+
+		for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+		{
+			const uint64_t key = m_sortKeys[ii];
+
+			SortKey sortKey;
+			const bool isCompute = sortKey.decode(key, m_viewRemap);
+
+			const uint32_t    itemIdx  = m_sortValues[ii];
+			const RenderItem& item     = m_renderItem[itemIdx];
+			ViewCounters&     counters = m_viewCounters[sortKey.m_view];
+
+			if (isCompute)
+			{
+				++counters.m_numCompute;
+				counters.m_uniformSize += item.compute.m_uniformEnd - item.compute.m_uniformBegin;
+				continue;
+			}
+
+			const RenderDraw& draw = item.draw;
+			const RenderBind& bind = m_renderItemBind[itemIdx];
+
+			++counters.m_numDraw;
+			counters.m_uniformSize += draw.m_uniformEnd - draw.m_uniformBegin;
+
+			if (currentProgram != sortKey.m_program.idx)
+			{
+				currentProgram = sortKey.m_program.idx;
+				++numProgramChanges;
+				++counters.m_numProgramChanges;
+			}
+
+			if (currentState   != draw.m_stateFlags
+			||  currentStencil != draw.m_stencil)
+			{
+				currentState   = draw.m_stateFlags;
+				currentStencil = draw.m_stencil;
+				++numStateChanges;
+				++counters.m_numStateChanges;
+			}
+
+			const uint16_t vb = 0 != (draw.m_streamMask & 1) ? draw.m_stream[0].m_handle.idx : kInvalidHandle;
+			if (currentVb != vb
+			||  currentIb != draw.m_indexBuffer.idx)
+			{
+				currentVb = vb;
+				currentIb = draw.m_indexBuffer.idx;
+				++numBufferChanges;
+				++counters.m_numBufferChanges;
+			}
+
+			for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+			{
+				const Binding& binding = bind.m_bind[stage];
+				Binding& current = currentBind.m_bind[stage];
+
+				if (kInvalidHandle != binding.m_idx
+				&& (current.m_idx          != binding.m_idx
+				||  current.m_type         != binding.m_type
+				||  current.m_samplerFlags != binding.m_samplerFlags) )
+				{
+					current = binding;
+					++numBindChanges;
+					++counters.m_numBindChanges;
+				}
+			}
+		}
+
+		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
+		{
+			const ViewId view = m_viewRemap[BlitKey::decodeView(m_blitKeys[ii])];
+			++m_viewCounters[view].m_numBlit;
+		}
+
+		m_perfStats.numProgramChanges = numProgramChanges;
+		m_perfStats.numBindChanges    = numBindChanges;
+		m_perfStats.numBufferChanges  = numBufferChanges;
+		m_perfStats.numStateChanges   = numStateChanges;
 	}
 
 	RenderFrame::Enum renderFrame(int32_t _msecs)
@@ -1814,6 +1964,8 @@ namespace bgfx
 		m_debug   = BGFX_DEBUG_NONE;
 		m_frameTimeLast = bx::getHPCounter();
 
+		BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - API Thread");
+
 		m_submit->create(_init.limits.minResourceCbSize);
 
 #if BGFX_CONFIG_MULTITHREADED
@@ -2005,6 +2157,8 @@ namespace bgfx
 		m_render->destroy();
 #endif // BGFX_CONFIG_MULTITHREADED
 
+		timelineShutdown();
+
 		bx::memSet(&g_internalData, 0, sizeof(InternalData) );
 		s_ctx = NULL;
 
@@ -2153,7 +2307,7 @@ namespace bgfx
 		}
 	}
 
-	Encoder* Context::begin(bool _forThread)
+	Encoder* Context::begin(bool _forThread, uint8_t _ordinal)
 	{
 		EncoderImpl* encoder = &m_encoder[0];
 
@@ -2169,21 +2323,44 @@ namespace bgfx
 			}
 
 			encoder = &m_encoder[idx];
-			encoder->begin(m_submit, uint8_t(idx) );
+			encoder->begin(m_submit, uint8_t(idx), _ordinal);
+
+			if (BGFX_API_THREAD_MAGIC != s_threadIndex)
+			{
+				s_threadEncoder = uintptr_t(encoder);
+			}
 		}
 #else
-		BX_UNUSED(_forThread);
+		BX_UNUSED(_forThread, _ordinal);
 #endif // BGFX_CONFIG_MULTITHREADED
 
 		return reinterpret_cast<Encoder*>(encoder);
 	}
 
+	EncoderImpl* Context::getThreadEncoder()
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		if (BGFX_API_THREAD_MAGIC != s_threadIndex)
+		{
+			union { uintptr_t ui; EncoderImpl* ptr; } cast = { s_threadEncoder };
+			return cast.ptr;
+		}
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		return &m_encoder[0];
+	}
+
 	void Context::end(Encoder* _encoder)
 	{
 #if BGFX_CONFIG_MULTITHREADED
 		EncoderImpl* encoder = reinterpret_cast<EncoderImpl*>(_encoder);
 		if (encoder != &m_encoder[0])
 		{
+			if (uintptr_t(encoder) == s_threadEncoder)
+			{
+				s_threadEncoder = 0;
+			}
+
 			encoder->end(true);
 			m_encoderEndSem.post();
 		}
@@ -2197,8 +2374,6 @@ namespace bgfx
 		m_encoder[0].end(true);
 
 #if BGFX_CONFIG_MULTITHREADED
-		bx::MutexScope resourceApiScope(m_resourceApiLock);
-
 		encoderApiWait();
 		bx::MutexScope encoderApiScope(m_encoderApiLock);
 #else
@@ -2219,7 +2394,15 @@ namespace bgfx
 
 	void Context::frameNoRenderWait()
 	{
-		swap();
+		{
+#if BGFX_CONFIG_MULTITHREADED
+			// Resource API calls from other threads wait only while frame is being swapped,
+			// not while API thread waits for render thread.
+			ResourceLockScope resourceApiScope(m_resourceLock);
+#endif // BGFX_CONFIG_MULTITHREADED
+
+			swap();
+		}
 
 		// release render thread
 		apiSemPost();
@@ -2232,6 +2415,10 @@ namespace bgfx
 		m_init.resolution.reset &= ~BGFX_RESET_INTERNAL_FORCE;
 		m_submit->m_debug = m_debug;
 		m_submit->m_perfStats.numViews = 0;
+		m_submit->m_perfStats.numProgramChanges = 0;
+		m_submit->m_perfStats.numBindChanges    = 0;
+		m_submit->m_perfStats.numBufferChanges  = 0;
+		m_submit->m_perfStats.numStateChanges   = 0;
 
 		bx::memCopy(m_submit->m_viewRemap, m_viewRemap, sizeof(m_viewRemap) );
 		bx::memCopy(m_submit->m_view, m_view, sizeof(m_view) );
@@ -2259,8 +2446,7 @@ namespace bgfx
 
 		m_frames++;
 		m_submit->start();
-
-		bx::memSet(m_seq, 0, sizeof(m_seq) );
+		m_cmdTicket = 0;
 
 		m_submit->m_textVideoMem->resize(
 			  m_render->m_textVideoMem->m_small
@@ -2346,6 +2532,8 @@ namespace bgfx
 				BGFX_PROFILER_SCOPE("bgfx/Render submit", 0xff2040ff);
 				m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
 				m_flipped = false;
+
+				timelineFrame(m_render->m_perfStats);
 			}
 
 			{
@@ -2668,7 +2856,7 @@ namespace bgfx
 		if (NULL == m_renderCtx)
 		{
 			uint8_t command;
-			_cmdbuf.read(command);
+			_cmdbuf.readCommand(command);
 
 			switch (command)
 			{
@@ -2696,7 +2884,7 @@ namespace bgfx
 
 					if (!m_rendererInitialized)
 					{
-						_cmdbuf.read(command);
+						_cmdbuf.readCommand(command);
 						BX_ASSERT(CommandBuffer::End == command, "Unexpected command %d?"
 							, command
 							);
@@ -2710,7 +2898,7 @@ namespace bgfx
 		do
 		{
 			uint8_t command;
-			_cmdbuf.read(command);
+			_cmdbuf.readCommand(command);
 
 			switch (command)
 			{
@@ -3096,6 +3284,20 @@ namespace bgfx
 				}
 				break;
 
+			case CommandBuffer::SetTextureResidentMip:
+				{
+					BGFX_PROFILER_SCOPE("SetTextureResidentMip", 0xff2040ff);
+
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					uint8_t mip;
+					_cmdbuf.read(mip);
+
+					m_renderCtx->setTextureResidentMip(handle, mip);
+				}
+				break;
+
 			case CommandBuffer::DestroyTexture:
 				{
 					BGFX_PROFILER_SCOPE("DestroyTexture", 0xff2040ff);
@@ -3369,6 +3571,10 @@ namespace bgfx
 
 		Init init = _userInit;
 
+		BX_WARN(init.limits.maxEncoders <= kSortKeySeqNumOrdinals
+			, "Encoders with index %d and above share the last sort key ordinal when ordinal is not passed to begin."
+			, kSortKeySeqNumOrdinals-1
+			);
 		init.limits.maxEncoders       = bx::clamp<uint16_t>(init.limits.maxEncoders, 1, (0 != BGFX_CONFIG_MULTITHREADED) ? 128 : 1);
 		init.limits.minResourceCbSize = bx::min<uint32_t>(init.limits.minResourceCbSize, BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE);
 
@@ -3539,9 +3745,14 @@ namespace bgfx
 		s_ctx->reset(_width, _height, _flags, _format);
 	}
 
-	Encoder* begin(bool _forThread)
+	Encoder* begin(bool _forThread, uint8_t _ordinal)
 	{
-		return s_ctx->begin(_forThread);
+		BX_ASSERT(UINT8_MAX == _ordinal || _ordinal < kSortKeySeqNumOrdinals
+			, "Encoder ordinal %d is out of range (max: %d)."
+			, _ordinal
+			, kSortKeySeqNumOrdinals-1
+			);
+		return s_ctx->begin(_forThread, _ordinal);
 	}
 
 #define BGFX_ENCODER(_func) reinterpret_cast<EncoderImpl*>(this)->_func
@@ -3610,7 +3821,8 @@ namespace bgfx
 	void Encoder::setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
 	{
 		BGFX_CHECK_HANDLE("setIndexBuffer", s_ctx->m_indexBufferHandle, _handle);
-		BGFX_ENCODER(setIndexBuffer(_handle, _firstIndex, _numIndices) );
+		const IndexBuffer& ib = s_ctx->m_indexBuffers[_handle.idx];
+		BGFX_ENCODER(setIndexBuffer(_handle, ib, _firstIndex, _numIndices) );
 	}
 
 	void Encoder::setIndexBuffer(DynamicIndexBufferHandle _handle)
@@ -4071,10 +4283,10 @@ namespace bgfx
 		s_ctx->destroyDynamicVertexBuffer(_handle);
 	}
 
-	uint32_t getAvailTransientIndexBuffer(uint32_t _num)
+	uint32_t getAvailTransientIndexBuffer(uint32_t _num, bool _index32)
 	{
 		BX_ASSERT(0 < _num, "Requesting 0 indices.");
-		return s_ctx->getAvailTransientIndexBuffer(_num);
+		return s_ctx->getAvailTransientIndexBuffer(_num, _index32);
 	}
 
 	uint32_t getAvailTransientVertexBuffer(uint32_t _num, const VertexLayout& _layout)
@@ -4090,16 +4302,18 @@ namespace bgfx
 		return s_ctx->getAvailTransientVertexBuffer(_num, _stride);
 	}
 
-	void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num)
+	void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32)
 	{
 		BX_ASSERT(NULL != _tib, "_tib can't be NULL");
 		BX_ASSERT(0 < _num, "Requesting 0 indices.");
-		s_ctx->allocTransientIndexBuffer(_tib, _num);
-		BX_ASSERT(_num == _tib->size/2
+		BX_ASSERT(!_index32 || 0 != (g_caps.supported & BGFX_CAPS_INDEX32), "32-bit indices are not supported. Use bgfx::getCaps to check BGFX_CAPS_INDEX32 backend renderer capabilities.");
+		s_ctx->allocTransientIndexBuffer(_tib, _num, _index32);
+		const uint32_t indexSize = _tib->isIndex16 ? 2 : 4;
+		BX_ASSERT(_num == _tib->size/indexSize
 			, "Failed to allocate transient index buffer (requested %d, available %d). "
 			  "Use bgfx::getAvailTransient* functions to ensure availability."
 			, _num
-			, _tib->size/2
+			, _tib->size/indexSize
 			);
 	}
 
@@ -4117,19 +4331,15 @@ namespace bgfx
 			);
 	}
 
-	bool allocTransientBuffers(bgfx::TransientVertexBuffer* _tvb, const bgfx::VertexLayout& _layout, uint32_t _numVertices, bgfx::TransientIndexBuffer* _tib, uint32_t _numIndices)
+	bool allocTransientBuffers(bgfx::TransientVertexBuffer* _tvb, const bgfx::VertexLayout& _layout, uint32_t _numVertices, bgfx::TransientIndexBuffer* _tib, uint32_t _numIndices, bool _index32)
 	{
-		BGFX_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
-
-		if (_numVertices == getAvailTransientVertexBuffer(_numVertices, _layout)
-		&&  _numIndices  == getAvailTransientIndexBuffer(_numIndices) )
-		{
-			allocTransientVertexBuffer(_tvb, _numVertices, _layout);
-			allocTransientIndexBuffer(_tib, _numIndices);
-			return true;
-		}
-
-		return false;
+		BX_ASSERT(NULL != _tvb, "_tvb can't be NULL");
+		BX_ASSERT(NULL != _tib, "_tib can't be NULL");
+		BX_ASSERT(0 < _numVertices, "Requesting 0 vertices.");
+		BX_ASSERT(0 < _numIndices, "Requesting 0 indices.");
+		BX_ASSERT(isValid(_layout), "Invalid VertexLayout.");
+		BX_ASSERT(!_index32 || 0 != (g_caps.supported & BGFX_CAPS_INDEX32), "32-bit indices are not supported. Use bgfx::getCaps to check BGFX_CAPS_INDEX32 backend renderer capabilities.");
+		return s_ctx->allocTransientBuffers(_tvb, _layout, _numVertices, _tib, _numIndices, _index32);
 	}
 
 	void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride)
@@ -4579,6 +4789,11 @@ namespace bgfx
 		return s_ctx->readTexture(_handle, _data, _mip);
 	}
 
+	void setTextureResidentMip(TextureHandle _handle, uint8_t _mip)
+	{
+		s_ctx->setTextureResidentMip(_handle, _mip);
+	}
+
 	FrameBufferHandle createFrameBuffer(uint16_t _width, uint16_t _height, TextureFormat::Enum _format, uint64_t _textureFlags)
 	{
 		_textureFlags |= _textureFlags&BGFX_TEXTURE_RT_MSAA_MASK ? 0 : BGFX_TEXTURE_RT;
@@ -5076,6 +5291,12 @@ namespace bgfx
 		BGFX_CHECK_API_THREAD();
 		s_ctx->requestScreenShot(_handle, _filePath);
 	}
+
+	void requestTrace(const char* _filePath, uint32_t _numFrames)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->requestTrace(_filePath, _numFrames);
+	}
 } // namespace bgfx
 
 #if BX_PLATFORM_WINDOWS
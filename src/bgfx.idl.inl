@@ -329,9 +329,9 @@ BGFX_C_API void bgfx_destroy_dynamic_vertex_buffer(bgfx_dynamic_vertex_buffer_ha
 	bgfx::destroy(handle.cpp);
 }
 
-BGFX_C_API uint32_t bgfx_get_avail_transient_index_buffer(uint32_t _num)
+BGFX_C_API uint32_t bgfx_get_avail_transient_index_buffer(uint32_t _num, bool _index32)
 {
-	return bgfx::getAvailTransientIndexBuffer(_num);
+	return bgfx::getAvailTransientIndexBuffer(_num, _index32);
 }
 
 BGFX_C_API uint32_t bgfx_get_avail_transient_vertex_buffer(uint32_t _num, const bgfx_vertex_layout_t * _layout)
@@ -345,9 +345,9 @@ BGFX_C_API uint32_t bgfx_get_avail_instance_data_buffer(uint32_t _num, uint16_t
 	return bgfx::getAvailInstanceDataBuffer(_num, _stride);
 }
 
-BGFX_C_API void bgfx_alloc_transient_index_buffer(bgfx_transient_index_buffer_t* _tib, uint32_t _num)
+BGFX_C_API void bgfx_alloc_transient_index_buffer(bgfx_transient_index_buffer_t* _tib, uint32_t _num, bool _index32)
 {
-	bgfx::allocTransientIndexBuffer((bgfx::TransientIndexBuffer*)_tib, _num);
+	bgfx::allocTransientIndexBuffer((bgfx::TransientIndexBuffer*)_tib, _num, _index32);
 }
 
 BGFX_C_API void bgfx_alloc_transient_vertex_buffer(bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_layout_t * _layout)
@@ -356,10 +356,10 @@ BGFX_C_API void bgfx_alloc_transient_vertex_buffer(bgfx_transient_vertex_buffer_
 	bgfx::allocTransientVertexBuffer((bgfx::TransientVertexBuffer*)_tvb, _num, layout);
 }
 
-BGFX_C_API bool bgfx_alloc_transient_buffers(bgfx_transient_vertex_buffer_t* _tvb, const bgfx_vertex_layout_t * _layout, uint32_t _numVertices, bgfx_transient_index_buffer_t* _tib, uint32_t _numIndices)
+BGFX_C_API bool bgfx_alloc_transient_buffers(bgfx_transient_vertex_buffer_t* _tvb, const bgfx_vertex_layout_t * _layout, uint32_t _numVertices, bgfx_transient_index_buffer_t* _tib, uint32_t _numIndices, bool _index32)
 {
 	const bgfx::VertexLayout & layout = *(const bgfx::VertexLayout *)_layout;
-	return bgfx::allocTransientBuffers((bgfx::TransientVertexBuffer*)_tvb, layout, _numVertices, (bgfx::TransientIndexBuffer*)_tib, _numIndices);
+	return bgfx::allocTransientBuffers((bgfx::TransientVertexBuffer*)_tvb, layout, _numVertices, (bgfx::TransientIndexBuffer*)_tib, _numIndices, _index32);
 }
 
 BGFX_C_API void bgfx_alloc_instance_data_buffer(bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride)
@@ -498,6 +498,12 @@ BGFX_C_API uint32_t bgfx_read_texture(bgfx_texture_handle_t _handle, void* _data
 	return bgfx::readTexture(handle.cpp, _data, _mip);
 }
 
+BGFX_C_API void bgfx_set_texture_resident_mip(bgfx_texture_handle_t _handle, uint8_t _mip)
+{
+	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
+	bgfx::setTextureResidentMip(handle.cpp, _mip);
+}
+
 BGFX_C_API void bgfx_set_texture_name(bgfx_texture_handle_t _handle, const char* _name, int32_t _len)
 {
 	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
@@ -676,9 +682,9 @@ BGFX_C_API void bgfx_reset_view(bgfx_view_id_t _id)
 	bgfx::resetView((bgfx::ViewId)_id);
 }
 
-BGFX_C_API bgfx_encoder_t* bgfx_encoder_begin(bool _forThread)
+BGFX_C_API bgfx_encoder_t* bgfx_encoder_begin(bool _forThread, uint8_t _ordinal)
 {
-	return (bgfx_encoder_t*)bgfx::begin(_forThread);
+	return (bgfx_encoder_t*)bgfx::begin(_forThread, _ordinal);
 }
 
 BGFX_C_API void bgfx_encoder_end(bgfx_encoder_t* _encoder)
@@ -937,6 +943,11 @@ BGFX_C_API void bgfx_request_screen_shot(bgfx_frame_buffer_handle_t _handle, con
 	bgfx::requestScreenShot(handle.cpp, _filePath);
 }
 
+BGFX_C_API void bgfx_request_trace(const char* _filePath, uint32_t _numFrames)
+{
+	bgfx::requestTrace(_filePath, _numFrames);
+}
+
 BGFX_C_API bgfx_render_frame_t bgfx_render_frame(int32_t _msecs)
 {
 	return (bgfx_render_frame_t)bgfx::renderFrame(_msecs);
@@ -1286,6 +1297,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_update_texture_3d,
 			bgfx_update_texture_cube,
 			bgfx_read_texture,
+			bgfx_set_texture_resident_mip,
 			bgfx_set_texture_name,
 			bgfx_get_direct_access_ptr,
 			bgfx_destroy_texture,
@@ -1355,6 +1367,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_discard,
 			bgfx_encoder_blit,
 			bgfx_request_screen_shot,
+			bgfx_request_trace,
 			bgfx_render_frame,
 			bgfx_set_platform_data,
 			bgfx_get_internal_data,
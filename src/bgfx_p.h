@@ -52,16 +52,28 @@
 
 #if BGFX_CONFIG_PROFILER
 #	define BGFX_PROFILER_SCOPE(_name, _abgr)            ProfilerScope BX_CONCATENATE(profilerScope, __LINE__)(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_BEGIN(_name, _abgr)            g_callback->profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_BEGIN_LITERAL(_name, _abgr)    g_callback->profilerBeginLiteral(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_END()                          g_callback->profilerEnd()
-#	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) BX_NOOP()
+#	define BGFX_PROFILER_BEGIN(_name, _abgr)                                       \
+		BX_MACRO_BLOCK_BEGIN                                                       \
+			g_callback->profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__) ); \
+			timelineBegin(_name, _abgr);                                           \
+		BX_MACRO_BLOCK_END
+#	define BGFX_PROFILER_BEGIN_LITERAL(_name, _abgr)                                      \
+		BX_MACRO_BLOCK_BEGIN                                                              \
+			g_callback->profilerBeginLiteral(_name, _abgr, __FILE__, uint16_t(__LINE__) ); \
+			timelineBegin(_name, _abgr);                                                  \
+		BX_MACRO_BLOCK_END
+#	define BGFX_PROFILER_END()          \
+		BX_MACRO_BLOCK_BEGIN            \
+			g_callback->profilerEnd();  \
+			timelineEnd();              \
+		BX_MACRO_BLOCK_END
+#	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) timelineSetThreadName(_name)
 #else
 #	define BGFX_PROFILER_SCOPE(_name, _abgr)            BX_NOOP()
 #	define BGFX_PROFILER_BEGIN(_name, _abgr)            BX_NOOP()
 #	define BGFX_PROFILER_BEGIN_LITERAL(_name, _abgr)    BX_NOOP()
 #	define BGFX_PROFILER_END()                          BX_NOOP()
-#	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) BX_NOOP()
+#	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) timelineSetThreadName(_name)
 #endif // BGFX_PROFILER_SCOPE
 
 namespace bgfx
@@ -130,6 +142,7 @@ namespace bgfx
 #include <bgfx/platform.h>
 #include <bimg/bimg.h>
 #include "shader.h"
+#include "timeline.h"
 #include "vertexlayout.h"
 
 #define BGFX_CHUNK_MAGIC_TEX BX_MAKEFOURCC('T', 'E', 'X', 0x0)
@@ -216,8 +229,12 @@ namespace stl = std;
 #define BGFX_STATE_INTERNAL_OCCLUSION_QUERY UINT64_C(0x4000000000000000)
 
 #define BGFX_SUBMIT_RESERVED_MASK              UINT8_C(0xff)
+#define BGFX_SUBMIT_INTERNAL_NONE              UINT8_C(0x00)
+#define BGFX_SUBMIT_INTERNAL_INDEX32           UINT8_C(0x40)
 #define BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE UINT8_C(0x80)
 
+#define BGFX_BUFFER_INTERNAL_INDEX_MIXED       UINT16_C(0x8000)
+
 #define BGFX_RENDERER_DIRECT3D9_NAME  "Direct3D 9"
 #define BGFX_RENDERER_DIRECT3D11_NAME "Direct3D 11"
 #define BGFX_RENDERER_DIRECT3D12_NAME "Direct3D 12"
@@ -475,11 +492,13 @@ namespace bgfx
 		ProfilerScope(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line)
 		{
 			g_callback->profilerBeginLiteral(_name, _abgr, _filePath, _line);
+			timelineBegin(_name, _abgr);
 		}
 
 		~ProfilerScope()
 		{
 			g_callback->profilerEnd();
+			timelineEnd();
 		}
 	};
 
@@ -775,6 +794,7 @@ namespace bgfx
 			, m_pos(0)
 			, m_size(0)
 			, m_minCapacity(0)
+			, m_payloadAlign(kCommandAlign)
 		{
 			resize();
 			finish();
@@ -807,6 +827,7 @@ namespace bgfx
 			CreateTexture,
 			UpdateTexture,
 			ResizeTexture,
+			SetTextureResidentMip,
 			CreateFrameBuffer,
 			CreateUniform,
 			UpdateViewName,
@@ -849,6 +870,11 @@ namespace bgfx
 		template<typename Type>
 		void write(const Type& _in)
 		{
+			BX_ASSERT(BX_ALIGNOF(Type) <= m_payloadAlign
+				, "Command payload alignment %d is smaller than alignment of written type %d."
+				, m_payloadAlign
+				, BX_ALIGNOF(Type)
+				);
 			align(BX_ALIGNOF(Type) );
 			write(reinterpret_cast<const uint8_t*>(&_in), sizeof(Type) );
 		}
@@ -899,6 +925,50 @@ namespace bgfx
 			m_pos = pos;
 		}
 
+		// Payload of command is aligned to the largest alignment of values inside payload,
+		// so that command records can be copied between buffers without changing alignment
+		// of their payload. Commands without payload, or with handle only, are not padded.
+		static uint32_t getPayloadAlign(uint8_t _cmd)
+		{
+			switch (_cmd)
+			{
+			case RendererShutdownBegin:
+			case End:
+			case RendererShutdownEnd:
+				return 1;
+
+			case DestroyVertexLayout:
+			case DestroyIndexBuffer:
+			case DestroyVertexBuffer:
+			case DestroyDynamicIndexBuffer:
+			case DestroyDynamicVertexBuffer:
+			case DestroyShader:
+			case DestroyProgram:
+			case DestroyTexture:
+			case DestroyFrameBuffer:
+			case DestroyUniform:
+				return BX_ALIGNOF(uint16_t);
+
+			default:
+				break;
+			}
+
+			return kCommandAlign;
+		}
+
+		void writeCommand(uint8_t _cmd)
+		{
+			write(&_cmd, sizeof(_cmd) );
+			m_payloadAlign = getPayloadAlign(_cmd);
+			align(m_payloadAlign);
+		}
+
+		void readCommand(uint8_t& _cmd)
+		{
+			read(&_cmd, sizeof(_cmd) );
+			align(getPayloadAlign(_cmd) );
+		}
+
 		void reset()
 		{
 			m_pos = 0;
@@ -912,8 +982,7 @@ namespace bgfx
 
 		void finish()
 		{
-			uint8_t cmd = End;
-			write(cmd);
+			writeCommand(End);
 			m_size = m_pos;
 			m_pos = 0;
 
@@ -924,11 +993,249 @@ namespace bgfx
 			}
 		}
 
+		static constexpr uint32_t kCommandAlign = 16;
+
 		uint8_t* m_buffer;
 		uint32_t m_pos;
 		uint32_t m_size;
 		uint32_t m_capacity;
 		uint32_t m_minCapacity;
+		uint32_t m_payloadAlign;
+	};
+
+	// Destroy command is command byte padded to handle alignment, followed by handle.
+	constexpr uint32_t kDestroyCommandSize = BX_ALIGNOF(uint16_t) + sizeof(uint16_t);
+	BX_STATIC_ASSERT(sizeof(TextureHandle) == sizeof(uint16_t) && BX_ALIGNOF(TextureHandle) == BX_ALIGNOF(uint16_t) );
+
+	// Size of post command buffer when all resources are destroyed in the same frame.
+	constexpr uint32_t kDestroyAllCommandSize = 0
+		+ kDestroyCommandSize * BGFX_CONFIG_MAX_VERTEX_LAYOUTS
+		+ kDestroyCommandSize * BGFX_CONFIG_MAX_INDEX_BUFFERS
+		+ kDestroyCommandSize * BGFX_CONFIG_MAX_VERTEX_BUFFERS
+		+ kDestroyCommandSize * BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS
+		+ kDestroyCommandSize * BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS
+		+ kDestroyCommandSize * BGFX_CONFIG_MAX_SHADERS
+		+ kDestroyCommandSize * BGFX_CONFIG_MAX_PROGRAMS
+		+ kDestroyCommandSize * BGFX_CONFIG_MAX_TEXTURES
+		+ kDestroyCommandSize * BGFX_CONFIG_MAX_FRAME_BUFFERS
+		+ kDestroyCommandSize * BGFX_CONFIG_MAX_UNIFORMS
+		+ sizeof(uint8_t) // End
+		;
+
+	/// Resource API state is split into domains, each guarded by its own lock. When
+	/// multiple domain locks are needed, they must be taken in order of this enum.
+	struct ResourceDomain
+	{
+		enum Enum
+		{
+			FrameBuffer,
+			Texture,
+			Program,   //!< Shaders and programs.
+			Uniform,
+			Transient, //!< Transient and instance data buffer allocation.
+			Buffer,    //!< Vertex layouts, static, dynamic, and indirect buffers.
+			Query,
+			Misc,      //!< Renderer lifetime, debug text, views, screenshots.
+
+			Count
+		};
+	};
+
+#if BGFX_CONFIG_MULTITHREADED
+	/// Takes locks of all resource domains in lock order.
+	class ResourceLockScope
+	{
+		BX_CLASS(ResourceLockScope
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			, NO_ASSIGNMENT
+			);
+
+	public:
+		ResourceLockScope(bx::Mutex* _mutex)
+			: m_mutex(_mutex)
+		{
+			for (uint32_t ii = 0; ii < ResourceDomain::Count; ++ii)
+			{
+				m_mutex[ii].lock();
+			}
+		}
+
+		~ResourceLockScope()
+		{
+			for (uint32_t ii = ResourceDomain::Count; 0 < ii; --ii)
+			{
+				m_mutex[ii-1].unlock();
+			}
+		}
+
+	private:
+		bx::Mutex* m_mutex;
+	};
+#endif // BGFX_CONFIG_MULTITHREADED
+
+	inline ResourceDomain::Enum getResourceDomain(CommandBuffer::Enum _cmd)
+	{
+		switch (_cmd)
+		{
+		case CommandBuffer::CreateVertexLayout:
+		case CommandBuffer::CreateIndexBuffer:
+		case CommandBuffer::CreateVertexBuffer:
+		case CommandBuffer::CreateDynamicIndexBuffer:
+		case CommandBuffer::UpdateDynamicIndexBuffer:
+		case CommandBuffer::CreateDynamicVertexBuffer:
+		case CommandBuffer::UpdateDynamicVertexBuffer:
+		case CommandBuffer::DestroyVertexLayout:
+		case CommandBuffer::DestroyIndexBuffer:
+		case CommandBuffer::DestroyVertexBuffer:
+		case CommandBuffer::DestroyDynamicIndexBuffer:
+		case CommandBuffer::DestroyDynamicVertexBuffer:
+			return ResourceDomain::Buffer;
+
+		case CommandBuffer::CreateShader:
+		case CommandBuffer::CreateProgram:
+		case CommandBuffer::DestroyShader:
+		case CommandBuffer::DestroyProgram:
+			return ResourceDomain::Program;
+
+		case CommandBuffer::CreateTexture:
+		case CommandBuffer::UpdateTexture:
+		case CommandBuffer::ResizeTexture:
+		case CommandBuffer::SetTextureResidentMip:
+		case CommandBuffer::DestroyTexture:
+		case CommandBuffer::ReadTexture:
+			return ResourceDomain::Texture;
+
+		case CommandBuffer::CreateFrameBuffer:
+		case CommandBuffer::DestroyFrameBuffer:
+			return ResourceDomain::FrameBuffer;
+
+		case CommandBuffer::CreateUniform:
+		case CommandBuffer::DestroyUniform:
+			return ResourceDomain::Uniform;
+
+		case CommandBuffer::InvalidateOcclusionQuery:
+			return ResourceDomain::Query;
+
+		default:
+			break;
+		}
+
+		return ResourceDomain::Misc;
+	}
+
+	inline ResourceDomain::Enum getResourceDomain(Handle _handle)
+	{
+		switch (_handle.type)
+		{
+		case Handle::Shader:  return ResourceDomain::Program;
+		case Handle::Texture: return ResourceDomain::Texture;
+		default:              break;
+		}
+
+		return ResourceDomain::Buffer;
+	}
+
+	/// Commands of one resource domain for one frame. Each record is tagged with ticket
+	/// taken while holding domain lock, and at the end of frame records of all domains
+	/// are merged in ticket order, which preserves order in which API calls happened.
+	class CommandSegment
+	{
+		BX_CLASS(CommandSegment
+			, NO_COPY
+			, NO_ASSIGNMENT
+			);
+
+	public:
+		CommandSegment()
+			: m_record(NULL)
+			, m_num(0)
+			, m_max(0)
+		{
+			start();
+		}
+
+		~CommandSegment()
+		{
+			BX_FREE(g_allocator, m_record);
+		}
+
+		void start()
+		{
+			m_cmdbuf.start();
+			m_num = 0;
+		}
+
+		CommandBuffer& begin(uint32_t _ticket, uint8_t _cmd)
+		{
+			if (m_num == m_max)
+			{
+				m_max    = bx::max<uint32_t>(m_max*2, 64);
+				m_record = (Record*)BX_REALLOC(g_allocator, m_record, m_max*sizeof(Record) );
+			}
+
+			Record& record = m_record[m_num++];
+			record.m_ticket = _ticket;
+			record.m_offset = m_cmdbuf.m_pos;
+
+			m_cmdbuf.writeCommand(_cmd);
+
+			return m_cmdbuf;
+		}
+
+		static void merge(CommandBuffer& _cmdbuf, const CommandSegment* _segment, uint32_t _num)
+		{
+			uint32_t next[ResourceDomain::Count] = {};
+			BX_ASSERT(_num <= BX_COUNTOF(next), "");
+
+			for (;;)
+			{
+				uint32_t idx    = UINT32_MAX;
+				uint32_t ticket = UINT32_MAX;
+
+				for (uint32_t ii = 0; ii < _num; ++ii)
+				{
+					const CommandSegment& segment = _segment[ii];
+					if (next[ii] < segment.m_num
+					&&  segment.m_record[next[ii] ].m_ticket < ticket)
+					{
+						idx    = ii;
+						ticket = segment.m_record[next[ii] ].m_ticket;
+					}
+				}
+
+				if (UINT32_MAX == idx)
+				{
+					break;
+				}
+
+				const CommandSegment& segment = _segment[idx];
+				const uint32_t record = next[idx]++;
+				const uint32_t offset = segment.m_record[record].m_offset;
+				const uint8_t  cmd    = segment.m_cmdbuf.m_buffer[offset];
+				const uint32_t begin  = bx::alignUp(offset + 1, CommandBuffer::getPayloadAlign(cmd) );
+				const uint32_t end    = next[idx] < segment.m_num
+					? segment.m_record[next[idx] ].m_offset
+					: segment.m_cmdbuf.m_pos
+					;
+
+				// Payload is copied at the same alignment it was written with.
+				_cmdbuf.writeCommand(cmd);
+				_cmdbuf.write(&segment.m_cmdbuf.m_buffer[begin], end - begin);
+			}
+		}
+
+	private:
+		struct Record
+		{
+			uint32_t m_ticket;
+			uint32_t m_offset;
+		};
+
+		CommandBuffer m_cmdbuf;
+		Record*  m_record;
+		uint32_t m_num;
+		uint32_t m_max;
 	};
 
 	//
@@ -947,6 +1254,7 @@ namespace bgfx
 	constexpr uint64_t kSortKeyDrawTypeProgram     = uint64_t(0)<<kSortKeyDrawTypeBitShift;
 	constexpr uint64_t kSortKeyDrawTypeDepth       = uint64_t(1)<<kSortKeyDrawTypeBitShift;
 	constexpr uint64_t kSortKeyDrawTypeSequence    = uint64_t(2)<<kSortKeyDrawTypeBitShift;
+	constexpr uint64_t kSortKeyDrawTypeMaterial    = uint64_t(3)<<kSortKeyDrawTypeBitShift;
 
 	//
 	constexpr uint8_t  kSortKeyTransNumBits        = 2;
@@ -971,8 +1279,15 @@ namespace bgfx
 	constexpr uint64_t kSortKeyDraw1ProgramMask    = uint64_t(BGFX_CONFIG_MAX_PROGRAMS-1)<<kSortKeyDraw1ProgramShift;
 
 	//
-	constexpr uint8_t  kSortKeyDraw2SeqShift       = kSortKeyDrawTypeBitShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ;
-	constexpr uint64_t kSortKeyDraw2SeqMask        = ( (uint64_t(1)<<BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ)-1)<<kSortKeyDraw2SeqShift;
+	// Sequence is encoder ordinal in most significant bits, followed by encoder local counter.
+	constexpr uint8_t  kSortKeySeqNumBits          = BGFX_CONFIG_SORT_KEY_NUM_BITS_ORDINAL + BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ;
+	constexpr uint8_t  kSortKeySeqOrdinalShift     = BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ;
+	constexpr uint32_t kSortKeySeqLocalMax         = uint32_t(1)<<BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ;
+	constexpr uint32_t kSortKeySeqNumOrdinals      = uint32_t(1)<<BGFX_CONFIG_SORT_KEY_NUM_BITS_ORDINAL;
+
+	//
+	constexpr uint8_t  kSortKeyDraw2SeqShift       = kSortKeyDrawTypeBitShift - kSortKeySeqNumBits;
+	constexpr uint64_t kSortKeyDraw2SeqMask        = ( (uint64_t(1)<<kSortKeySeqNumBits)-1)<<kSortKeyDraw2SeqShift;
 
 	constexpr uint8_t  kSortKeyDraw2BlendShift     = kSortKeyDraw2SeqShift - kSortKeyTransNumBits;
 	constexpr uint64_t kSortKeyDraw2BlendMask      = uint64_t(0x3)<<kSortKeyDraw2BlendShift;
@@ -981,12 +1296,30 @@ namespace bgfx
 	constexpr uint64_t kSortKeyDraw2ProgramMask    = uint64_t(BGFX_CONFIG_MAX_PROGRAMS-1)<<kSortKeyDraw2ProgramShift;
 
 	//
-	constexpr uint8_t  kSortKeyComputeSeqShift     = kSortKeyDrawBitShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ;
-	constexpr uint64_t kSortKeyComputeSeqMask      = ( (uint64_t(1)<<BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ)-1)<<kSortKeyComputeSeqShift;
+	constexpr uint8_t  kSortKeyDraw3BlendShift     = kSortKeyDrawTypeBitShift - kSortKeyTransNumBits;
+	constexpr uint64_t kSortKeyDraw3BlendMask      = uint64_t(0x3)<<kSortKeyDraw3BlendShift;
+
+	constexpr uint8_t  kSortKeyDraw3ProgramShift   = kSortKeyDraw3BlendShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM;
+	constexpr uint64_t kSortKeyDraw3ProgramMask    = uint64_t(BGFX_CONFIG_MAX_PROGRAMS-1)<<kSortKeyDraw3ProgramShift;
+
+	constexpr uint8_t  kSortKeyDraw3MaterialShift  = kSortKeyDraw3ProgramShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL;
+	constexpr uint64_t kSortKeyDraw3MaterialMask   = ( (uint64_t(1)<<BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL)-1)<<kSortKeyDraw3MaterialShift;
+
+	// Remaining low bits store most significant bits of depth.
+	constexpr uint8_t  kSortKeyDraw3DepthNumBits   = kSortKeyDraw3MaterialShift < 32 ? kSortKeyDraw3MaterialShift : 32;
+	constexpr uint8_t  kSortKeyDraw3DepthShift     = kSortKeyDraw3MaterialShift - kSortKeyDraw3DepthNumBits;
+	constexpr uint64_t kSortKeyDraw3DepthMask      = ( (uint64_t(1)<<kSortKeyDraw3DepthNumBits)-1)<<kSortKeyDraw3DepthShift;
+
+	//
+	constexpr uint8_t  kSortKeyComputeSeqShift     = kSortKeyDrawBitShift - kSortKeySeqNumBits;
+	constexpr uint64_t kSortKeyComputeSeqMask      = ( (uint64_t(1)<<kSortKeySeqNumBits)-1)<<kSortKeyComputeSeqShift;
 
 	constexpr uint8_t  kSortKeyComputeProgramShift = kSortKeyComputeSeqShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM;
 	constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRAMS-1)<<kSortKeyComputeProgramShift;
 
+	BX_STATIC_ASSERT(BGFX_CONFIG_SORT_KEY_NUM_BITS_ORDINAL <= 8); // Ordinal is passed as uint8_t.
+	BX_STATIC_ASSERT(kSortKeySeqNumBits <= 32); // SortKey::m_seq is uint32_t.
+
 	BX_STATIC_ASSERT(BGFX_CONFIG_MAX_VIEWS <= (1<<kSortKeyViewNumBits) );
 	BX_STATIC_ASSERT( (BGFX_CONFIG_MAX_PROGRAMS & (BGFX_CONFIG_MAX_PROGRAMS-1) ) == 0); // Must be power of 2.
 	BX_STATIC_ASSERT( (0 // Render key mask shouldn't overlap.
@@ -1034,6 +1367,24 @@ namespace bgfx
 		^ kSortKeyDraw2BlendMask
 		^ kSortKeyDraw2ProgramMask
 		) );
+	BX_STATIC_ASSERT(kSortKeyDrawTypeBitShift >= kSortKeyTransNumBits + BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM + BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL);
+	BX_STATIC_ASSERT( (0 // Render key mask shouldn't overlap.
+		| kSortKeyViewMask
+		| kSortKeyDrawBit
+		| kSortKeyDrawTypeMask
+		| kSortKeyDraw3BlendMask
+		| kSortKeyDraw3ProgramMask
+		| kSortKeyDraw3MaterialMask
+		| kSortKeyDraw3DepthMask
+		) == (0
+		^ kSortKeyViewMask
+		^ kSortKeyDrawBit
+		^ kSortKeyDrawTypeMask
+		^ kSortKeyDraw3BlendMask
+		^ kSortKeyDraw3ProgramMask
+		^ kSortKeyDraw3MaterialMask
+		^ kSortKeyDraw3DepthMask
+		) );
 	BX_STATIC_ASSERT( (0 // Compute key mask shouldn't overlap.
 		| kSortKeyViewMask
 		| kSortKeyDrawBit
@@ -1071,6 +1422,13 @@ namespace bgfx
 	// |        |                     | |        |                      |
 	// |        |                 seq-+ +-trans  +-program              |
 	// |        |                                                       |
+	// |----------------------------------------------------------------| Draw Key 3 - Sort by material
+	// |        |kkttppppppppprrrrmmmmmmmmbbbbdddddddddddddddddddddddd  |
+	// |        |   ^        ^   ^       ^   ^                       ^  |
+	// |        |   |        |   |       |   |                       |  |
+	// |        |   +-blend  |   +-state |   +-buffers               |  |
+	// |        |    program-+      bind-+                     depth-+  |
+	// |        |                                                       |
 	// |----------------------------------------------------------------| Compute Key
 	// |        |ssssssssssssssssssssppppppppp                          |
 	// |        |                   ^        ^                          |
@@ -1086,6 +1444,7 @@ namespace bgfx
 			SortProgram,
 			SortDepth,
 			SortSequence,
+			SortMaterial,
 		};
 
 		uint64_t encodeDraw(Enum _type)
@@ -1131,6 +1490,19 @@ namespace bgfx
 					return key;
 				}
 				break;
+
+			case SortMaterial:
+				{
+					const uint64_t depth    = ( (uint64_t(m_depth) >> (32-kSortKeyDraw3DepthNumBits) ) << kSortKeyDraw3DepthShift) & kSortKeyDraw3DepthMask;
+					const uint64_t material = (uint64_t(m_material   ) << kSortKeyDraw3MaterialShift) & kSortKeyDraw3MaterialMask;
+					const uint64_t program  = (uint64_t(m_program.idx) << kSortKeyDraw3ProgramShift ) & kSortKeyDraw3ProgramMask;
+					const uint64_t blend    = (uint64_t(m_blend      ) << kSortKeyDraw3BlendShift   ) & kSortKeyDraw3BlendMask;
+					const uint64_t view     = (uint64_t(m_view       ) << kSortKeyViewBitShift      ) & kSortKeyViewMask;
+					const uint64_t key      = view|kSortKeyDrawBit|kSortKeyDrawTypeMaterial|blend|program|material|depth;
+
+					return key;
+				}
+				break;
 			}
 
 			BX_ASSERT(false, "You should not be here.");
@@ -1169,6 +1541,11 @@ namespace bgfx
 					m_program.idx = uint16_t( (_key & kSortKeyDraw2ProgramMask) >> kSortKeyDraw2ProgramShift);
 					return false;
 				}
+				else if (type == kSortKeyDrawTypeMaterial)
+				{
+					m_program.idx = uint16_t( (_key & kSortKeyDraw3ProgramMask) >> kSortKeyDraw3ProgramShift);
+					return false;
+				}
 
 				m_program.idx = uint16_t( (_key & kSortKeyDraw0ProgramMask) >> kSortKeyDraw0ProgramShift);
 				return false; // draw
@@ -1193,15 +1570,17 @@ namespace bgfx
 
 		void reset()
 		{
-			m_depth   = 0;
-			m_seq     = 0;
-			m_program = {0};
-			m_view    = 0;
-			m_blend   = 0;
+			m_depth    = 0;
+			m_seq      = 0;
+			m_material = 0;
+			m_program  = {0};
+			m_view     = 0;
+			m_blend    = 0;
 		}
 
 		uint32_t      m_depth;
 		uint32_t      m_seq;
+		uint32_t      m_material;
 		ProgramHandle m_program;
 		ViewId        m_view;
 		uint8_t       m_blend;
@@ -1224,9 +1603,14 @@ namespace bgfx
 			m_view =   ViewId(_key >> 24);
 		}
 
+		static ViewId decodeView(uint32_t _key)
+		{
+			return ViewId(_key >> 24);
+		}
+
 		static uint32_t remapView(uint32_t _key, ViewId _viewRemap[BGFX_CONFIG_MAX_VIEWS])
 		{
-			const ViewId   oldView  = ViewId(_key >> 24);
+			const ViewId   oldView  = decodeView(_key);
 			const uint32_t view     = uint32_t(_viewRemap[oldView]) << 24;
 			const uint32_t key      = (_key & ~UINT32_C(0xff000000) ) | view;
 			return key;
@@ -1638,15 +2022,25 @@ namespace bgfx
 				m_startIndex      = 0;
 				m_numIndices      = UINT32_MAX;
 				m_indexBuffer.idx = kInvalidHandle;
+				m_submitFlags     = 0;
+			}
+			else
+			{
+				// Index format is kept together with index buffer.
+				m_submitFlags = isIndex16() ? BGFX_SUBMIT_INTERNAL_NONE : BGFX_SUBMIT_INTERNAL_INDEX32;
 			}
 
-			m_submitFlags   = 0;
 			m_startIndirect = 0;
 			m_numIndirect   = UINT16_MAX;
 			m_indirectBuffer.idx = kInvalidHandle;
 			m_occlusionQuery.idx = kInvalidHandle;
 		}
 
+		bool isIndex16() const
+		{
+			return 0 == (m_submitFlags & BGFX_SUBMIT_INTERNAL_INDEX32);
+		}
+
 		bool setStreamBit(uint8_t _stream, VertexBufferHandle _handle)
 		{
 			const uint8_t bit  = 1<<_stream;
@@ -1751,6 +2145,7 @@ namespace bgfx
 	{
 		String   m_name;
 		uint32_t m_size;
+		uint16_t m_flags;
 	};
 
 	struct VertexBuffer
@@ -1959,6 +2354,19 @@ namespace bgfx
 		RectCache m_rectCache;
 	};
 
+	struct ViewCounters
+	{
+		uint32_t m_numDraw;
+		uint32_t m_numCompute;
+		uint32_t m_numBlit;
+		uint32_t m_numDropped;        //!< Written by encoders, only when item doesn't fit into frame.
+		uint32_t m_numProgramChanges;
+		uint32_t m_numBindChanges;
+		uint32_t m_numBufferChanges;
+		uint32_t m_numStateChanges;
+		uint32_t m_uniformSize;
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
 	{
 		Frame()
@@ -1983,7 +2391,7 @@ namespace bgfx
 		void create(uint32_t _minResourceCbSize)
 		{
 			m_cmdPre.init(_minResourceCbSize);
-			m_cmdPost.init(_minResourceCbSize);
+			m_cmdPost.init(bx::max(_minResourceCbSize, kDestroyAllCommandSize) );
 
 			{
 				const uint32_t num = g_caps.limits.maxEncoders;
@@ -2027,15 +2435,30 @@ namespace bgfx
 			m_frameCache.reset();
 			m_numRenderItems = 0;
 			m_numBlitItems   = 0;
+			bx::memSet(m_viewCounters, 0, sizeof(m_viewCounters) );
 			m_iboffset = 0;
 			m_vboffset = 0;
 			m_cmdPre.start();
 			m_cmdPost.start();
+
+			for (uint32_t ii = 0; ii < ResourceDomain::Count; ++ii)
+			{
+				m_cmdPreSegment[ii].start();
+				m_cmdPostSegment[ii].start();
+			}
+
 			m_capture = false;
 		}
 
 		void finish()
 		{
+			// Concurrent slab reservations can overshoot transient buffer size.
+			m_iboffset = bx::min<uint32_t>(m_iboffset, g_caps.limits.transientIbSize);
+			m_vboffset = bx::min<uint32_t>(m_vboffset, g_caps.limits.transientVbSize);
+
+			CommandSegment::merge(m_cmdPre,  m_cmdPreSegment,  ResourceDomain::Count);
+			CommandSegment::merge(m_cmdPost, m_cmdPostSegment, ResourceDomain::Count);
+
 			m_cmdPre.finish();
 			m_cmdPost.finish();
 
@@ -2051,42 +2474,124 @@ namespace bgfx
 
 		void sort();
 
-		uint32_t getAvailTransientIndexBuffer(uint32_t _num)
+		/// Counts state changes between consecutive sorted draw calls, and per view draw, compute,
+		/// blit and uniform counters.
+		void countViewStats();
+
+		/// Returns number of `_stride` sized elements available after `_offset` in transient
+		/// buffer of `_size` bytes.
+		static uint32_t getAvailTransient(uint32_t _offset, uint32_t _num, uint16_t _stride, uint32_t _size)
 		{
-			uint32_t offset   = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
-			uint32_t iboffset = offset + _num*sizeof(uint16_t);
-			iboffset = bx::min<uint32_t>(iboffset, g_caps.limits.transientIbSize);
-			uint32_t num = (iboffset-offset)/sizeof(uint16_t);
-			return num;
+			const uint32_t offset = bx::strideAlign(_offset, _stride);
+
+			if (offset >= _size)
+			{
+				return 0;
+			}
+
+			return bx::min<uint32_t>(_num, (_size - offset)/_stride);
 		}
 
-		uint32_t allocTransientIndexBuffer(uint32_t& _num)
+		/// Allocates up to `_num` elements from transient buffer offset shared by all threads.
+		static uint32_t allocTransient(uint32_t* _offset, uint32_t& _num, uint16_t _stride, uint32_t _size)
 		{
-			uint32_t offset = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
-			uint32_t num    = getAvailTransientIndexBuffer(_num);
-			m_iboffset = offset + num*sizeof(uint16_t);
-			_num = num;
+			uint32_t current = *(volatile uint32_t*)_offset;
+
+			for (;;)
+			{
+				const uint32_t offset = bx::strideAlign(current, _stride);
+				const uint32_t num    = getAvailTransient(current, _num, _stride, _size);
+
+				if (0 == num)
+				{
+					_num = 0;
+					return bx::min(offset, _size);
+				}
 
-			return offset;
+				const uint32_t prev = bx::atomicCompareAndSwap<uint32_t>(_offset, current, offset + num*_stride);
+
+				if (prev == current)
+				{
+					_num = num;
+					return offset;
+				}
+
+				current = prev;
+			}
+		}
+
+		/// Allocates exactly `_num` elements from transient buffer offset shared by all threads.
+		/// Returns false without allocating if there is not enough space. `_prev` receives
+		/// offset before allocation, which is needed to free it with `freeTransient`.
+		static bool allocTransientExact(uint32_t* _offset, uint32_t _num, uint16_t _stride, uint32_t _size, uint32_t& _prev, uint32_t& _start)
+		{
+			uint32_t current = *(volatile uint32_t*)_offset;
+
+			for (;;)
+			{
+				const uint32_t offset = bx::strideAlign(current, _stride);
+
+				if (offset > _size
+				||  _num > (_size - offset)/_stride)
+				{
+					return false;
+				}
+
+				const uint32_t prev = bx::atomicCompareAndSwap<uint32_t>(_offset, current, offset + _num*_stride);
+
+				if (prev == current)
+				{
+					_prev  = current;
+					_start = offset;
+					return true;
+				}
+
+				current = prev;
+			}
+		}
+
+		/// Frees allocation ending at `_end` if nothing was allocated after it, otherwise range
+		/// stays unused until end of frame.
+		static void freeTransient(uint32_t* _offset, uint32_t _prev, uint32_t _end)
+		{
+			bx::atomicCompareAndSwap<uint32_t>(_offset, _end, _prev);
+		}
+
+		/// Reserves `_size` bytes of transient buffer with single atomic. `_size` receives
+		/// reserved size, which is smaller near the end of buffer.
+		static uint32_t reserveTransient(uint32_t* _offset, uint32_t& _size, uint32_t _max)
+		{
+			// Offset can overshoot `_max` only by concurrent reservations.
+			if (*(volatile uint32_t*)_offset >= _max)
+			{
+				_size = 0;
+				return _max;
+			}
+
+			const uint32_t offset = bx::atomicFetchAndAdd<uint32_t>(_offset, _size);
+			_size = offset < _max ? bx::min(_size, _max - offset) : 0;
+
+			return bx::min(offset, _max);
+		}
+
+		uint32_t getAvailTransientIndexBuffer(uint32_t _num, uint16_t _indexSize)
+		{
+			return getAvailTransient(*(volatile uint32_t*)&m_iboffset, _num, _indexSize, g_caps.limits.transientIbSize);
+		}
+
+		uint32_t allocTransientIndexBuffer(uint32_t& _num, uint16_t _indexSize)
+		{
+			return allocTransient(&m_iboffset, _num, _indexSize, g_caps.limits.transientIbSize);
 		}
 
 		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
 		{
-			uint32_t offset   = bx::strideAlign(m_vboffset, _stride);
-			uint32_t vboffset = offset + _num * _stride;
-			vboffset = bx::min<uint32_t>(vboffset, g_caps.limits.transientVbSize);
-			uint32_t num = (vboffset-offset)/_stride;
-			return num;
+			return getAvailTransient(*(volatile uint32_t*)&m_vboffset, _num, _stride, g_caps.limits.transientVbSize);
 		}
 
 		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
 		{
-			uint32_t offset = bx::strideAlign(m_vboffset, _stride);
-			uint32_t num    = getAvailTransientVertexBuffer(_num, _stride);
-			m_vboffset = offset + num * _stride;
-			_num = num;
-
-			return offset;
+			return allocTransient(&m_vboffset, _num, _stride, g_caps.limits.transientVbSize);
 		}
 
 		bool free(IndexBufferHandle _handle)
@@ -2162,8 +2667,8 @@ namespace bgfx
 		uint32_t m_numRenderItems;
 		uint16_t m_numBlitItems;
 
-		uint32_t m_iboffset;
-		uint32_t m_vboffset;
+		uint32_t m_iboffset; //!< Bumped atomically, encoders allocate without locking.
+		uint32_t m_vboffset; //!< Bumped atomically, encoders allocate without locking.
 		TransientIndexBuffer* m_transientIb;
 		TransientVertexBuffer* m_transientVb;
 
@@ -2172,6 +2677,8 @@ namespace bgfx
 
 		CommandBuffer m_cmdPre;
 		CommandBuffer m_cmdPost;
+		CommandSegment m_cmdPreSegment[ResourceDomain::Count];
+		CommandSegment m_cmdPostSegment[ResourceDomain::Count];
 
 		template<typename Ty, uint32_t Max>
 		struct FreeHandle
@@ -2240,8 +2747,9 @@ namespace bgfx
 
 		TextVideoMem* m_textVideoMem;
 
-		Stats     m_perfStats;
-		ViewStats m_viewStats[BGFX_CONFIG_MAX_VIEWS];
+		Stats        m_perfStats;
+		ViewStats    m_viewStats[BGFX_CONFIG_MAX_VIEWS];
+		ViewCounters m_viewCounters[BGFX_CONFIG_MAX_VIEWS];
 
 		int64_t m_waitSubmit;
 		int64_t m_waitRender;
@@ -2249,6 +2757,62 @@ namespace bgfx
 		bool m_capture;
 	};
 
+	/// Range of frame's transient buffer reserved by encoder. Small allocations are
+	/// sub-allocated from slab by owning encoder only, and slab is refilled with single atomic.
+	/// Large allocations, and allocations that don't fit into refilled slab go directly to frame.
+	struct TransientSlab
+	{
+		void reset()
+		{
+			m_offset = 0;
+			m_end    = 0;
+		}
+
+		uint32_t getAvail(uint32_t* _frameOffset, uint32_t _num, uint16_t _stride, uint32_t _size) const
+		{
+			const uint32_t offset = bx::strideAlign(m_offset, _stride);
+
+			if (offset <= m_end
+			&&  _num <= (m_end - offset)/_stride)
+			{
+				return _num;
+			}
+
+			return Frame::getAvailTransient(*(volatile uint32_t*)_frameOffset, _num, _stride, _size);
+		}
+
+		uint32_t alloc(uint32_t* _frameOffset, uint32_t& _num, uint16_t _stride, uint32_t _size)
+		{
+			if (_num <= BGFX_CONFIG_TRANSIENT_SLAB_SIZE/4/_stride)
+			{
+				const uint32_t size = _num*_stride;
+				uint32_t offset = bx::strideAlign(m_offset, _stride);
+
+				if (offset > m_end
+				||  size > m_end - offset)
+				{
+					// Remainder of previous slab is wasted.
+					uint32_t slabSize = BGFX_CONFIG_TRANSIENT_SLAB_SIZE;
+					m_offset = Frame::reserveTransient(_frameOffset, slabSize, _size);
+					m_end    = m_offset + slabSize;
+					offset   = bx::strideAlign(m_offset, _stride);
+				}
+
+				if (offset <= m_end
+				&&  size <= m_end - offset)
+				{
+					m_offset = offset + size;
+					return offset;
+				}
+			}
+
+			return Frame::allocTransient(_frameOffset, _num, _stride, _size);
+		}
+
+		uint32_t m_offset;
+		uint32_t m_end;
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) EncoderImpl
 	{
 		EncoderImpl()
@@ -2256,10 +2820,20 @@ namespace bgfx
 			discard(BGFX_DISCARD_ALL);
 		}
 
-		void begin(Frame* _frame, uint8_t _idx)
+		void begin(Frame* _frame, uint8_t _idx, uint8_t _ordinal = UINT8_MAX)
 		{
 			m_frame = _frame;
 
+			// Default ordinal is encoder index, which depends on order in which threads begin
+			// encoders. When there are more encoders than ordinals, remaining encoders share the
+			// last ordinal and their draw calls are interleaved.
+			const uint32_t ordinal = UINT8_MAX == _ordinal
+				? bx::min<uint32_t>(_idx, kSortKeySeqNumOrdinals-1)
+				: _ordinal
+				;
+			m_seqOrdinal = ordinal << kSortKeySeqOrdinalShift;
+			bx::memSet(m_seq, 0, sizeof(m_seq) );
+
 			m_cpuTimeBegin = bx::getHPCounter();
 
 			m_uniformIdx   = _idx;
@@ -2271,6 +2845,9 @@ namespace bgfx
 
 			m_numSubmitted = 0;
 			m_numDropped   = 0;
+
+			m_ibSlab.reset();
+			m_vbSlab.reset();
 		}
 
 		void end(bool _finalize)
@@ -2377,12 +2954,13 @@ namespace bgfx
 			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, BGFX_CONFIG_MAX_MATRIX_CACHE-1) - _cache);
 		}
 
-		void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
+		void setIndexBuffer(IndexBufferHandle _handle, const IndexBuffer& _ib, uint32_t _firstIndex, uint32_t _numIndices)
 		{
 			BX_ASSERT(UINT8_MAX != m_draw.m_streamMask, "");
 			m_draw.m_startIndex  = _firstIndex;
 			m_draw.m_numIndices  = _numIndices;
 			m_draw.m_indexBuffer = _handle;
+			setIndexFormat(0 == (_ib.m_flags & BGFX_BUFFER_INDEX32) );
 		}
 
 		void setIndexBuffer(const DynamicIndexBuffer& _dib, uint32_t _firstIndex, uint32_t _numIndices)
@@ -2392,18 +2970,27 @@ namespace bgfx
 			m_draw.m_startIndex  = _dib.m_startIndex + _firstIndex;
 			m_draw.m_numIndices  = bx::min(_numIndices, _dib.m_size/indexSize);
 			m_draw.m_indexBuffer = _dib.m_handle;
+			setIndexFormat(2 == indexSize);
 		}
 
 		void setIndexBuffer(const TransientIndexBuffer* _tib, uint32_t _firstIndex, uint32_t _numIndices)
 		{
 			BX_ASSERT(UINT8_MAX != m_draw.m_streamMask, "");
-			const uint32_t numIndices = bx::min(_numIndices, _tib->size/2);
+			const uint32_t indexSize  = _tib->isIndex16 ? 2 : 4;
+			const uint32_t numIndices = bx::min(_numIndices, _tib->size/indexSize);
 			m_draw.m_indexBuffer = _tib->handle;
 			m_draw.m_startIndex  = _tib->startIndex + _firstIndex;
 			m_draw.m_numIndices  = numIndices;
+			setIndexFormat(_tib->isIndex16);
 			m_discard = 0 == numIndices;
 		}
 
+		void setIndexFormat(bool _index16)
+		{
+			m_draw.m_submitFlags &= ~BGFX_SUBMIT_INTERNAL_INDEX32;
+			m_draw.m_submitFlags |= _index16 ? BGFX_SUBMIT_INTERNAL_NONE : BGFX_SUBMIT_INTERNAL_INDEX32;
+		}
+
 		void setVertexBuffer(
 			  uint8_t _stream
 			, VertexBufferHandle _handle
@@ -2584,6 +3171,41 @@ namespace bgfx
 
 		void blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
 
+		uint32_t getAvailTransientIndexBuffer(uint32_t _num, uint16_t _indexSize)
+		{
+			return m_ibSlab.getAvail(&m_frame->m_iboffset, _num, _indexSize, g_caps.limits.transientIbSize);
+		}
+
+		uint32_t allocTransientIndexBuffer(uint32_t& _num, uint16_t _indexSize)
+		{
+			return m_ibSlab.alloc(&m_frame->m_iboffset, _num, _indexSize, g_caps.limits.transientIbSize);
+		}
+
+		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
+		{
+			return m_vbSlab.getAvail(&m_frame->m_vboffset, _num, _stride, g_caps.limits.transientVbSize);
+		}
+
+		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
+		{
+			return m_vbSlab.alloc(&m_frame->m_vboffset, _num, _stride, g_caps.limits.transientVbSize);
+		}
+
+		uint32_t getSeqIncr(ViewId _id)
+		{
+			const uint32_t seq = m_seq[_id]++;
+			BX_WARN(seq != kSortKeySeqLocalMax
+				, "Too many sequential draw calls in view %d from single encoder (max: %d), "
+				  "remaining draw calls share the last sequence number."
+				, _id
+				, kSortKeySeqLocalMax
+				);
+
+			// Counter saturates instead of overflowing into ordinal bits. Sort is stable, and
+			// draw calls with the same key stay in submit order.
+			return m_seqOrdinal | bx::min<uint32_t>(seq, kSortKeySeqLocalMax-1);
+		}
+
 		Frame* m_frame;
 
 		SortKey m_key;
@@ -2595,6 +3217,12 @@ namespace bgfx
 		uint32_t m_numSubmitted;
 		uint32_t m_numDropped;
 
+		TransientSlab m_ibSlab;
+		TransientSlab m_vbSlab;
+
+		uint32_t m_seq[BGFX_CONFIG_MAX_VIEWS];
+		uint32_t m_seqOrdinal;
+
 		uint32_t m_uniformBegin;
 		uint32_t m_uniformEnd;
 		uint32_t m_numVertices[BGFX_CONFIG_MAX_VERTEX_STREAMS];
@@ -2860,6 +3488,7 @@ namespace bgfx
 		virtual void updateTextureEnd() = 0;
 		virtual void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) = 0;
 		virtual void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) = 0;
+		virtual void setTextureResidentMip(TextureHandle _handle, uint8_t _mip) = 0;
 		virtual void overrideInternal(TextureHandle _handle, uintptr_t _ptr) = 0;
 		virtual uintptr_t getInternal(TextureHandle _handle) = 0;
 		virtual void destroyTexture(TextureHandle _handle) = 0;
@@ -2904,6 +3533,7 @@ namespace bgfx
 			, m_colorPaletteDirty(0)
 			, m_frames(0)
 			, m_debug(BGFX_DEBUG_NONE)
+			, m_cmdTicket(0)
 			, m_rtMemoryUsed(0)
 			, m_textureMemoryUsed(0)
 			, m_renderCtx(NULL)
@@ -2935,12 +3565,22 @@ namespace bgfx
 		bool init(const Init& _init);
 		void shutdown();
 
+		// Caller must hold lock of resource domain command belongs to.
+		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd, ResourceDomain::Enum _domain)
+		{
+			const uint32_t ticket = bx::atomicFetchAndAdd<uint32_t>(&m_cmdTicket, 1);
+
+			CommandSegment& segment = _cmd < CommandBuffer::End
+				? m_submit->m_cmdPreSegment[_domain]
+				: m_submit->m_cmdPostSegment[_domain]
+				;
+
+			return segment.begin(ticket, uint8_t(_cmd) );
+		}
+
 		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd)
 		{
-			CommandBuffer& cmdbuf = _cmd < CommandBuffer::End ? m_submit->m_cmdPre : m_submit->m_cmdPost;
-			uint8_t cmd = (uint8_t)_cmd;
-			cmdbuf.write(cmd);
-			return cmdbuf;
+			return getCommandBuffer(_cmd, getResourceDomain(_cmd) );
 		}
 
 		BGFX_API_FUNC(void reset(uint32_t _width, uint32_t _height, uint32_t _flags, TextureFormat::Enum _format) )
@@ -2968,6 +3608,8 @@ namespace bgfx
 				m_view[ii].setFrameBuffer(BGFX_INVALID_HANDLE);
 			}
 
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Texture]);
+
 			for (uint16_t ii = 0, num = m_textureHandle.getNumHandles(); ii < num; ++ii)
 			{
 				uint16_t textureIdx = m_textureHandle.getHandleAt(ii);
@@ -2993,7 +3635,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void dbgTextClear(uint8_t _attr, bool _small) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Misc]);
 
 			m_submit->m_textVideoMem->resize(_small, (uint16_t)m_init.resolution.width, (uint16_t)m_init.resolution.height);
 			m_submit->m_textVideoMem->clear(_attr);
@@ -3001,21 +3643,21 @@ namespace bgfx
 
 		BGFX_API_FUNC(void dbgTextPrintfVargs(uint16_t _x, uint16_t _y, uint8_t _attr, const char* _format, va_list _argList) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Misc]);
 
 			m_submit->m_textVideoMem->printfVargs(_x, _y, _attr, _format, _argList);
 		}
 
 		BGFX_API_FUNC(void dbgTextImage(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const void* _data, uint16_t _pitch) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Misc]);
 
 			m_submit->m_textVideoMem->image(_x, _y, _width, _height, _data, _pitch);
 		}
 
 		BGFX_API_FUNC(const Stats* getPerfStats() )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Misc]);
 
 			Stats& stats = m_submit->m_perfStats;
 			const Resolution& resolution = m_submit->m_resolution;
@@ -3046,7 +3688,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(IndexBufferHandle createIndexBuffer(const Memory* _mem, uint16_t _flags) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			IndexBufferHandle handle = { m_indexBufferHandle.alloc() };
 
@@ -3054,7 +3696,8 @@ namespace bgfx
 			if (isValid(handle) )
 			{
 				IndexBuffer& ib = m_indexBuffers[handle.idx];
-				ib.m_size = _mem->size;
+				ib.m_size  = _mem->size;
+				ib.m_flags = _flags;
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateIndexBuffer);
 				cmdbuf.write(handle);
@@ -3073,7 +3716,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void setName(IndexBufferHandle _handle, const bx::StringView& _name) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			BGFX_CHECK_HANDLE("setName", m_indexBufferHandle, _handle);
 
@@ -3085,7 +3728,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyIndexBuffer(IndexBufferHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			BGFX_CHECK_HANDLE("destroyIndexBuffer", m_indexBufferHandle, _handle);
 			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
@@ -3120,7 +3763,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(VertexLayoutHandle createVertexLayout(const VertexLayout& _layout) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			VertexLayoutHandle handle = findVertexLayout(_layout);
 			if (!isValid(handle) )
@@ -3136,13 +3779,13 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyVertexLayout(VertexLayoutHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 			m_vertexLayoutRef.release(_handle);
 		}
 
 		BGFX_API_FUNC(VertexBufferHandle createVertexBuffer(const Memory* _mem, const VertexLayout& _layout, uint16_t _flags) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			VertexBufferHandle handle = { m_vertexBufferHandle.alloc() };
 
@@ -3181,7 +3824,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void setName(VertexBufferHandle _handle, const bx::StringView& _name) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			BGFX_CHECK_HANDLE("setName", m_vertexBufferHandle, _handle);
 
@@ -3193,7 +3836,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyVertexBuffer(VertexBufferHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			BGFX_CHECK_HANDLE("destroyVertexBuffer", m_vertexBufferHandle, _handle);
 			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
@@ -3234,7 +3877,8 @@ namespace bgfx
 				const uint32_t allocSize = bx::max<uint32_t>(BGFX_CONFIG_DYNAMIC_INDEX_BUFFER_SIZE, _size);
 
 				IndexBuffer& ib = m_indexBuffers[indexBufferHandle.idx];
-				ib.m_size = allocSize;
+				ib.m_size  = allocSize;
+				ib.m_flags = _flags;
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
 				cmdbuf.write(indexBufferHandle);
@@ -3250,7 +3894,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num, uint16_t _flags) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			DynamicIndexBufferHandle handle = { m_dynamicIndexBufferHandle.alloc() };
 			BX_WARN(isValid(handle), "Failed to allocate dynamic index buffer handle.");
@@ -3273,7 +3917,8 @@ namespace bgfx
 				}
 
 				IndexBuffer& ib = m_indexBuffers[indexBufferHandle.idx];
-				ib.m_size = size;
+				ib.m_size  = size;
+				ib.m_flags = _flags;
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
 				cmdbuf.write(indexBufferHandle);
@@ -3306,7 +3951,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(const Memory* _mem, uint16_t _flags) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			BX_ASSERT(0 == (_flags &  BGFX_BUFFER_COMPUTE_READ_WRITE), "Cannot initialize compute buffer from CPU.");
 			const uint32_t indexSize = 0 == (_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
@@ -3325,7 +3970,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void update(DynamicIndexBufferHandle _handle, uint32_t _startIndex, const Memory* _mem) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			BGFX_CHECK_HANDLE("updateDynamicIndexBuffer", m_dynamicIndexBufferHandle, _handle);
 
@@ -3364,7 +4009,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyDynamicIndexBuffer(DynamicIndexBufferHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			BGFX_CHECK_HANDLE("destroyDynamicIndexBuffer", m_dynamicIndexBufferHandle, _handle);
 
@@ -3427,7 +4072,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(DynamicVertexBufferHandle createDynamicVertexBuffer(uint32_t _num, const VertexLayout& _layout, uint16_t _flags) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			VertexLayoutHandle layoutHandle = findVertexLayout(_layout);
 			if (!isValid(layoutHandle) )
@@ -3495,7 +4140,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(DynamicVertexBufferHandle createDynamicVertexBuffer(const Memory* _mem, const VertexLayout& _layout, uint16_t _flags) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			uint32_t numVertices = _mem->size/_layout.m_stride;
 			DynamicVertexBufferHandle handle = createDynamicVertexBuffer(numVertices, _layout, _flags);
@@ -3513,7 +4158,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void update(DynamicVertexBufferHandle _handle, uint32_t _startVertex, const Memory* _mem) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			BGFX_CHECK_HANDLE("updateDynamicVertexBuffer", m_dynamicVertexBufferHandle, _handle);
 
@@ -3555,7 +4200,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyDynamicVertexBuffer(DynamicVertexBufferHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			BGFX_CHECK_HANDLE("destroyDynamicVertexBuffer", m_dynamicVertexBufferHandle, _handle);
 
@@ -3596,22 +4241,38 @@ namespace bgfx
 			m_dynamicVertexBufferHandle.free(_handle.idx);
 		}
 
-		BGFX_API_FUNC(uint32_t getAvailTransientIndexBuffer(uint32_t _num) )
+		BGFX_API_FUNC(uint32_t getAvailTransientIndexBuffer(uint32_t _num, bool _index32) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			const uint16_t indexSize = _index32 ? 4 : 2;
 
-			return m_submit->getAvailTransientIndexBuffer(_num);
+			EncoderImpl* encoder = getThreadEncoder();
+			if (NULL != encoder)
+			{
+				return encoder->getAvailTransientIndexBuffer(_num, indexSize);
+			}
+
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Transient]);
+
+			return m_submit->getAvailTransientIndexBuffer(_num, indexSize);
 		}
 
 		BGFX_API_FUNC(uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			EncoderImpl* encoder = getThreadEncoder();
+			if (NULL != encoder)
+			{
+				return encoder->getAvailTransientVertexBuffer(_num, _stride);
+			}
+
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Transient]);
 
 			return m_submit->getAvailTransientVertexBuffer(_num, _stride);
 		}
 
 		TransientIndexBuffer* createTransientIndexBuffer(uint32_t _size)
 		{
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
+
 			TransientIndexBuffer* tib = NULL;
 
 			IndexBufferHandle handle = { m_indexBufferHandle.alloc() };
@@ -3621,7 +4282,7 @@ namespace bgfx
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
 				cmdbuf.write(handle);
 				cmdbuf.write(_size);
-				uint16_t flags = BGFX_BUFFER_NONE;
+				uint16_t flags = BGFX_BUFFER_INTERNAL_INDEX_MIXED;
 				cmdbuf.write(flags);
 
 				const uint32_t size = 0
@@ -3629,9 +4290,10 @@ namespace bgfx
 					+ bx::alignUp(_size, 16)
 					;
 				tib = (TransientIndexBuffer*)BX_ALIGNED_ALLOC(g_allocator, size, 16);
-				tib->data   = (uint8_t *)tib + bx::alignUp(sizeof(TransientIndexBuffer), 16);
-				tib->size   = _size;
-				tib->handle = handle;
+				tib->data      = (uint8_t *)tib + bx::alignUp(sizeof(TransientIndexBuffer), 16);
+				tib->size      = _size;
+				tib->handle    = handle;
+				tib->isIndex16 = true;
 
 				setDebugName(convert(handle), "Transient Index Buffer");
 			}
@@ -3641,6 +4303,8 @@ namespace bgfx
 
 		void destroyTransientIndexBuffer(TransientIndexBuffer* _tib)
 		{
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyDynamicIndexBuffer);
 			cmdbuf.write(_tib->handle);
 
@@ -3648,22 +4312,42 @@ namespace bgfx
 			BX_ALIGNED_FREE(g_allocator, _tib, 16);
 		}
 
-		BGFX_API_FUNC(void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num) )
+		BGFX_API_FUNC(void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			// 16-bit and 32-bit indices share transient index buffer, each allocation is aligned
+			// to its own index size.
+			const uint16_t indexSize = _index32 ? 4 : 2;
+
+			EncoderImpl* encoder = getThreadEncoder();
+			if (NULL != encoder)
+			{
+				// Frame is not swapped while encoder is active.
+				const uint32_t offset = encoder->allocTransientIndexBuffer(_num, indexSize);
+				initTransientIndexBuffer(_tib, offset, _num, indexSize);
+				return;
+			}
 
-			uint32_t offset = m_submit->allocTransientIndexBuffer(_num);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Transient]);
 
+			const uint32_t offset = m_submit->allocTransientIndexBuffer(_num, indexSize);
+			initTransientIndexBuffer(_tib, offset, _num, indexSize);
+		}
+
+		void initTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _offset, uint32_t _num, uint16_t _indexSize)
+		{
 			TransientIndexBuffer& tib = *m_submit->m_transientIb;
 
-			_tib->data       = &tib.data[offset];
-			_tib->size       = _num * 2;
+			_tib->data       = &tib.data[_offset];
+			_tib->size       = _num * _indexSize;
 			_tib->handle     = tib.handle;
-			_tib->startIndex = bx::strideAlign(offset, 2)/2;
+			_tib->startIndex = bx::strideAlign(_offset, _indexSize)/_indexSize;
+			_tib->isIndex16  = 2 == _indexSize;
 		}
 
 		TransientVertexBuffer* createTransientVertexBuffer(uint32_t _size, const VertexLayout* _layout = NULL)
 		{
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
+
 			TransientVertexBuffer* tvb = NULL;
 
 			VertexBufferHandle handle = { m_vertexBufferHandle.alloc() };
@@ -3708,6 +4392,8 @@ namespace bgfx
 
 		void destroyTransientVertexBuffer(TransientVertexBuffer* _tvb)
 		{
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyDynamicVertexBuffer);
 			cmdbuf.write(_tvb->handle);
 
@@ -3715,14 +4401,12 @@ namespace bgfx
 			BX_ALIGNED_FREE(g_allocator, _tvb, 16);
 		}
 
-		BGFX_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexLayout& _layout) )
+		VertexLayoutHandle findTransientVertexLayout(const VertexLayout& _layout)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
 
 			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.find(_layout.m_hash);
 
-			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
-
 			if (!isValid(layoutHandle) )
 			{
 				VertexLayoutHandle temp = { m_layoutHandle.alloc() };
@@ -3733,34 +4417,116 @@ namespace bgfx
 				m_vertexLayoutRef.add(layoutHandle, _layout.m_hash);
 			}
 
-			uint32_t offset = m_submit->allocTransientVertexBuffer(_num, _layout.m_stride);
+			return layoutHandle;
+		}
+
+		BGFX_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexLayout& _layout) )
+		{
+			const VertexLayoutHandle layoutHandle = findTransientVertexLayout(_layout);
+
+			EncoderImpl* encoder = getThreadEncoder();
+			if (NULL != encoder)
+			{
+				const uint32_t offset = encoder->allocTransientVertexBuffer(_num, _layout.m_stride);
+				initTransientVertexBuffer(_tvb, offset, _num, _layout.m_stride, layoutHandle);
+				return;
+			}
+
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Transient]);
+
+			const uint32_t offset = m_submit->allocTransientVertexBuffer(_num, _layout.m_stride);
+			initTransientVertexBuffer(_tvb, offset, _num, _layout.m_stride, layoutHandle);
+		}
+
+		void initTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _offset, uint32_t _num, uint16_t _stride, VertexLayoutHandle _layoutHandle)
+		{
+			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
 
-			_tvb->data = &dvb.data[offset];
-			_tvb->size = _num * _layout.m_stride;
-			_tvb->startVertex = bx::strideAlign(offset, _layout.m_stride)/_layout.m_stride;
-			_tvb->stride = _layout.m_stride;
+			_tvb->data = &dvb.data[_offset];
+			_tvb->size = _num * _stride;
+			_tvb->startVertex = bx::strideAlign(_offset, _stride)/_stride;
+			_tvb->stride = _stride;
 			_tvb->handle = dvb.handle;
-			_tvb->layoutHandle   = layoutHandle;
+			_tvb->layoutHandle   = _layoutHandle;
 		}
 
-		BGFX_API_FUNC(void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride) )
+		BGFX_API_FUNC(bool allocTransientBuffers(TransientVertexBuffer* _tvb, const VertexLayout& _layout, uint32_t _numVertices, TransientIndexBuffer* _tib, uint32_t _numIndices, bool _index32) )
+		{
+			const VertexLayoutHandle layoutHandle = findTransientVertexLayout(_layout);
+
+			if (NULL != getThreadEncoder() )
+			{
+				// Frame is not swapped while encoder is active.
+				return allocTransientBuffers(_tvb, _layout.m_stride, layoutHandle, _numVertices, _tib, _numIndices, _index32);
+			}
+
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Transient]);
+
+			return allocTransientBuffers(_tvb, _layout.m_stride, layoutHandle, _numVertices, _tib, _numIndices, _index32);
+		}
+
+		bool allocTransientBuffers(TransientVertexBuffer* _tvb, uint16_t _stride, VertexLayoutHandle _layoutHandle, uint32_t _numVertices, TransientIndexBuffer* _tib, uint32_t _numIndices, bool _index32)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			// Checking availability first and allocating after is not atomic, because other
+			// threads allocate without lock. Both ranges are allocated with exact size directly
+			// from frame instead, and vertex range is freed if index range doesn't fit.
+			const uint16_t indexSize = _index32 ? 4 : 2;
+
+			uint32_t vbPrev;
+			uint32_t vbOffset;
+			if (!Frame::allocTransientExact(&m_submit->m_vboffset, _numVertices, _stride, g_caps.limits.transientVbSize, vbPrev, vbOffset) )
+			{
+				return false;
+			}
+
+			uint32_t ibPrev;
+			uint32_t ibOffset;
+			if (!Frame::allocTransientExact(&m_submit->m_iboffset, _numIndices, indexSize, g_caps.limits.transientIbSize, ibPrev, ibOffset) )
+			{
+				Frame::freeTransient(&m_submit->m_vboffset, vbPrev, vbOffset + _numVertices*_stride);
+				return false;
+			}
+
+			initTransientVertexBuffer(_tvb, vbOffset, _numVertices, _stride, _layoutHandle);
+			initTransientIndexBuffer(_tib, ibOffset, _numIndices, indexSize);
 
+			return true;
+		}
+
+		BGFX_API_FUNC(void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride) )
+		{
 			const uint16_t stride = bx::alignUp(_stride, 16);
+
+			EncoderImpl* encoder = getThreadEncoder();
+			if (NULL != encoder)
+			{
+				const uint32_t offset = encoder->allocTransientVertexBuffer(_num, stride);
+				initInstanceDataBuffer(_idb, offset, _num, stride);
+				return;
+			}
+
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Transient]);
+
 			const uint32_t offset = m_submit->allocTransientVertexBuffer(_num, stride);
+			initInstanceDataBuffer(_idb, offset, _num, stride);
+		}
 
+		void initInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _offset, uint32_t _num, uint16_t _stride)
+		{
 			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
-			_idb->data   = &dvb.data[offset];
-			_idb->size   = _num * stride;
-			_idb->offset = offset;
+
+			_idb->data   = &dvb.data[_offset];
+			_idb->size   = _num * _stride;
+			_idb->offset = _offset;
 			_idb->num    = _num;
-			_idb->stride = stride;
+			_idb->stride = _stride;
 			_idb->handle = dvb.handle;
 		}
 
 		IndirectBufferHandle createIndirectBuffer(uint32_t _num)
 		{
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
+
 			BX_UNUSED(_num);
 			IndirectBufferHandle handle = { m_vertexBufferHandle.alloc() };
 
@@ -3781,6 +4547,8 @@ namespace bgfx
 
 		void destroyIndirectBuffer(IndirectBufferHandle _handle)
 		{
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Buffer]);
+
 			VertexBufferHandle handle = { _handle.idx };
 			BGFX_CHECK_HANDLE("destroyDrawIndirectBuffer", m_vertexBufferHandle, handle);
 
@@ -3791,7 +4559,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(ShaderHandle createShader(const Memory* _mem) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Program]);
 
 			bx::MemoryReader reader(_mem->data, _mem->size);
 
@@ -3945,7 +4713,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(uint16_t getShaderUniforms(ShaderHandle _handle, UniformHandle* _uniforms, uint16_t _max) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Program]);
 
 			if (!isValid(_handle) )
 			{
@@ -3967,7 +4735,7 @@ namespace bgfx
 			char tmp[1024];
 			uint16_t len = 1+(uint16_t)bx::snprintf(tmp, BX_COUNTOF(tmp), "%sH %d: %.*s", getTypeName(_handle), _handle.idx, _name.getLength(), _name.getPtr() );
 
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::SetName);
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::SetName, getResourceDomain(_handle) );
 			cmdbuf.write(_handle);
 			cmdbuf.write(len);
 			cmdbuf.write(tmp, len);
@@ -3983,7 +4751,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void setName(ShaderHandle _handle, const bx::StringView& _name) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Program]);
 
 			BGFX_CHECK_HANDLE("setName", m_shaderHandle, _handle);
 
@@ -3995,7 +4763,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyShader(ShaderHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Program]);
 
 			BGFX_CHECK_HANDLE("destroyShader", m_shaderHandle, _handle);
 
@@ -4049,7 +4817,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(ProgramHandle createProgram(ShaderHandle _vsh, ShaderHandle _fsh, bool _destroyShaders) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Program]);
 
 			if (!isValid(_vsh)
 			||  !isValid(_fsh) )
@@ -4110,7 +4878,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(ProgramHandle createProgram(ShaderHandle _vsh, bool _destroyShader) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Program]);
 
 			if (!isValid(_vsh) )
 			{
@@ -4161,7 +4929,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyProgram(ProgramHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Program]);
 
 			BGFX_CHECK_HANDLE("destroyProgram", m_programHandle, _handle);
 
@@ -4188,7 +4956,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(TextureHandle createTexture(const Memory* _mem, uint64_t _flags, uint8_t _skip, TextureInfo* _info, BackbufferRatio::Enum _ratio, bool _immutable) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Texture]);
 
 			TextureInfo ti;
 			if (NULL == _info)
@@ -4268,7 +5036,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void setName(TextureHandle _handle, const bx::StringView& _name) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Texture]);
 			BGFX_CHECK_HANDLE("setName", m_textureHandle, _handle);
 
 			TextureRef& ref = m_textureRef[_handle.idx];
@@ -4285,7 +5053,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void* getDirectAccessPtr(TextureHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Texture]);
 			BGFX_CHECK_HANDLE("getDirectAccessPtr", m_textureHandle, _handle);
 
 			TextureRef& ref = m_textureRef[_handle.idx];
@@ -4294,7 +5062,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyTexture(TextureHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Texture]);
 
 			BGFX_CHECK_HANDLE("destroyTexture", m_textureHandle, _handle);
 
@@ -4309,7 +5077,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(uint32_t readTexture(TextureHandle _handle, void* _data, uint8_t _mip) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Texture]);
 
 			BGFX_CHECK_HANDLE("readTexture", m_textureHandle, _handle);
 
@@ -4323,6 +5091,20 @@ namespace bgfx
 			return m_frames + 2;
 		}
 
+		BGFX_API_FUNC(void setTextureResidentMip(TextureHandle _handle, uint8_t _mip) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Texture]);
+
+			BGFX_CHECK_HANDLE("setTextureResidentMip", m_textureHandle, _handle);
+
+			const TextureRef& ref = m_textureRef[_handle.idx];
+			BX_ASSERT(_mip < ref.m_numMips, "Invalid mip: %d num mips: %d", _mip, ref.m_numMips);
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::SetTextureResidentMip);
+			cmdbuf.write(_handle);
+			cmdbuf.write(bx::min<uint8_t>(_mip, ref.m_numMips-1) );
+		}
+
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers)
 		{
 			const TextureRef& textureRef = m_textureRef[_handle.idx];
@@ -4401,7 +5183,7 @@ namespace bgfx
 			, const Memory* _mem
 		) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Texture]);
 
 			const TextureRef& textureRef = m_textureRef[_handle.idx];
 			if (textureRef.m_immutable)
@@ -4452,7 +5234,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(FrameBufferHandle createFrameBuffer(uint8_t _num, const Attachment* _attachment, bool _destroyTextures) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::FrameBuffer]);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Texture]);
 
 			BX_ASSERT(checkFrameBuffer(_num, _attachment)
 				, "Too many frame buffer attachments (num attachments: %d, max color attachments %d)!"
@@ -4501,7 +5284,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(FrameBufferHandle createFrameBuffer(void* _nwh, uint16_t _width, uint16_t _height, TextureFormat::Enum _format, TextureFormat::Enum _depthFormat) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::FrameBuffer]);
 
 			FrameBufferHandle handle = { m_frameBufferHandle.alloc() };
 			BX_WARN(isValid(handle), "Failed to allocate frame buffer handle.");
@@ -4527,7 +5310,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void setName(FrameBufferHandle _handle, const bx::StringView& _name) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::FrameBuffer]);
 
 			BGFX_CHECK_HANDLE("setName", m_frameBufferHandle, _handle);
 
@@ -4539,7 +5322,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(TextureHandle getTexture(FrameBufferHandle _handle, uint8_t _attachment) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::FrameBuffer]);
 
 			BGFX_CHECK_HANDLE("getTexture", m_frameBufferHandle, _handle);
 
@@ -4555,7 +5338,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyFrameBuffer(FrameBufferHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::FrameBuffer]);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Texture]);
 
 			BGFX_CHECK_HANDLE("destroyFrameBuffer", m_frameBufferHandle, _handle);
 			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
@@ -4582,7 +5366,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(UniformHandle createUniform(const char* _name, UniformType::Enum _type, uint16_t _num) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Uniform]);
 
 			if (PredefinedUniform::Count != nameToPredefinedUniformEnum(_name) )
 			{
@@ -4657,7 +5441,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void getUniformInfo(UniformHandle _handle, UniformInfo& _info) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Uniform]);
 
 			BGFX_CHECK_HANDLE("getUniformInfo", m_uniformHandle, _handle);
 
@@ -4669,7 +5453,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyUniform(UniformHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Uniform]);
 
 			BGFX_CHECK_HANDLE("destroyUniform", m_uniformHandle, _handle);
 
@@ -4692,7 +5476,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(OcclusionQueryHandle createOcclusionQuery() )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Query]);
 
 			OcclusionQueryHandle handle = { m_occlusionQueryHandle.alloc() };
 			if (isValid(handle) )
@@ -4708,7 +5492,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(OcclusionQueryResult::Enum getResult(OcclusionQueryHandle _handle, int32_t* _result) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Query]);
 
 			BGFX_CHECK_HANDLE("getResult", m_occlusionQueryHandle, _handle);
 
@@ -4729,7 +5513,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void destroyOcclusionQuery(OcclusionQueryHandle _handle) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Query]);
 
 			BGFX_CHECK_HANDLE("destroyOcclusionQuery", m_occlusionQueryHandle, _handle);
 
@@ -4738,7 +5522,8 @@ namespace bgfx
 
 		BGFX_API_FUNC(void requestScreenShot(FrameBufferHandle _handle, const char* _filePath) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::FrameBuffer]);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Misc]);
 
 			BGFX_CHECK_HANDLE_INVALID_OK("requestScreenShot", m_frameBufferHandle, _handle);
 
@@ -4759,9 +5544,15 @@ namespace bgfx
 			cmdbuf.write(_filePath, len);
 		}
 
+		BGFX_API_FUNC(void requestTrace(const char* _filePath, uint32_t _numFrames) )
+		{
+			BX_ASSERT(NULL != _filePath, "Trace file path must be specified.");
+			timelineRequest(_filePath, _numFrames);
+		}
+
 		BGFX_API_FUNC(void setPaletteColor(uint8_t _index, const float _rgba[4]) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Misc]);
 
 			BX_ASSERT(_index < BGFX_CONFIG_MAX_COLOR_PALETTE, "Color palette index out of bounds %d (max: %d)."
 				, _index
@@ -4773,7 +5564,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(void setViewName(ViewId _id, const char* _name) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_resourceLock[ResourceDomain::Misc]);
 
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateViewName);
 			cmdbuf.write(_id);
@@ -4850,17 +5641,16 @@ namespace bgfx
 			}
 		}
 
-		BGFX_API_FUNC(Encoder* begin(bool _forThread) );
+		BGFX_API_FUNC(Encoder* begin(bool _forThread, uint8_t _ordinal) );
+
+		/// Returns encoder active on calling thread, or NULL if thread has no encoder. Transient
+		/// buffers are allocated through thread's encoder without taking resource lock.
+		EncoderImpl* getThreadEncoder();
 
 		BGFX_API_FUNC(void end(Encoder* _encoder) );
 
 		BGFX_API_FUNC(uint32_t frame(bool _capture = false) );
 
-		uint32_t getSeqIncr(ViewId _id)
-		{
-			return bx::atomicFetchAndAdd<uint32_t>(&m_seq[_id], 1);
-		}
-
 		void dumpViewStats();
 		void freeDynamicBuffers();
 		void freeAllHandles(Frame* _frame);
@@ -4940,6 +5730,7 @@ namespace bgfx
 			}
 
 			m_submit->m_perfStats.numEncoders = uint8_t(numEncoders);
+			timelineEncoders(m_encoderStats, numEncoders);
 
 			m_encoderHandle->reset();
 			uint16_t idx = m_encoderHandle->alloc();
@@ -4950,7 +5741,7 @@ namespace bgfx
 		bx::Semaphore m_apiSem;
 		bx::Semaphore m_encoderEndSem;
 		bx::Mutex     m_encoderApiLock;
-		bx::Mutex     m_resourceApiLock;
+		bx::Mutex     m_resourceLock[ResourceDomain::Count];
 		bx::Thread    m_thread;
 #else
 		void apiSemPost()
@@ -4976,6 +5767,7 @@ namespace bgfx
 			m_encoderStats[0].cpuTimeBegin = m_encoder[0].m_cpuTimeBegin;
 			m_encoderStats[0].cpuTimeEnd   = m_encoder[0].m_cpuTimeEnd;
 			m_submit->m_perfStats.numEncoders = 1;
+			timelineEncoders(m_encoderStats, 1);
 		}
 #endif // BGFX_CONFIG_MULTITHREADED
 
@@ -5038,7 +5830,6 @@ namespace bgfx
 		VertexLayoutRef  m_vertexLayoutRef;
 
 		ViewId m_viewRemap[BGFX_CONFIG_MAX_VIEWS];
-		uint32_t m_seq[BGFX_CONFIG_MAX_VIEWS];
 		View m_view[BGFX_CONFIG_MAX_VIEWS];
 
 		float m_clearColor[BGFX_CONFIG_MAX_COLOR_PALETTE][4];
@@ -5049,6 +5840,7 @@ namespace bgfx
 		int64_t  m_frameTimeLast;
 		uint32_t m_frames;
 		uint32_t m_debug;
+		uint32_t m_cmdTicket;
 
 		int64_t m_rtMemoryUsed;
 		int64_t m_textureMemoryUsed;
@@ -232,10 +232,18 @@
 #	define BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ 20
 #endif // BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ
 
+#ifndef BGFX_CONFIG_SORT_KEY_NUM_BITS_ORDINAL
+#	define BGFX_CONFIG_SORT_KEY_NUM_BITS_ORDINAL 8
+#endif // BGFX_CONFIG_SORT_KEY_NUM_BITS_ORDINAL
+
 #ifndef BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM
 #	define BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM 9
 #endif // BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM
 
+#ifndef BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL
+#	define BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL 16
+#endif // BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL
+
 // Cannot be configured via compiler options.
 #define BGFX_CONFIG_MAX_PROGRAMS (1<<BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM)
 BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_PROGRAMS), "BGFX_CONFIG_MAX_PROGRAMS must be power of 2.");
@@ -323,6 +331,12 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE (2<<20)
 #endif // BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
 
+/// Size of transient vertex and index buffer range reserved by encoder at once. Allocations up
+/// to quarter of slab size are sub-allocated from encoder's slab without locking.
+#ifndef BGFX_CONFIG_TRANSIENT_SLAB_SIZE
+#	define BGFX_CONFIG_TRANSIENT_SLAB_SIZE (16<<10)
+#endif // BGFX_CONFIG_TRANSIENT_SLAB_SIZE
+
 #ifndef BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
 #	define BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT 5
 #endif // BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
@@ -337,6 +351,18 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_PROFILER 0
 #endif // BGFX_CONFIG_PROFILER
 
+/// Enable built-in timeline recorder, see `bgfx::requestTrace`. Profiler scopes are recorded only
+/// when `BGFX_CONFIG_PROFILER` is enabled.
+#ifndef BGFX_CONFIG_TRACE
+#	define BGFX_CONFIG_TRACE 0
+#endif // BGFX_CONFIG_TRACE
+
+/// Number of timeline events kept per thread while trace is recorded. When thread records more
+/// events, the oldest ones are overwritten.
+#ifndef BGFX_CONFIG_TRACE_MAX_EVENTS
+#	define BGFX_CONFIG_TRACE_MAX_EVENTS (16<<10)
+#endif // BGFX_CONFIG_TRACE_MAX_EVENTS
+
 #ifndef BGFX_CONFIG_RENDERDOC_LOG_FILEPATH
 #	define BGFX_CONFIG_RENDERDOC_LOG_FILEPATH "temp/bgfx"
 #endif // BGFX_CONFIG_RENDERDOC_LOG_FILEPATH
@@ -361,4 +387,16 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_MAX_BACK_BUFFERS 4
 #endif // BGFX_CONFIG_MAX_BACK_BUFFERS
 
+/// Number of worker threads Vulkan renderer uses to record draw calls of large views into
+/// secondary command buffers. When 0 all draw calls are recorded on render thread.
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS
+#	define BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS 0
+#endif // BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS
+
+/// Minimum number of draw calls recorded into one secondary command buffer. Views with less
+/// draw calls are recorded on render thread.
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_RECORD_MIN_DRAWS
+#	define BGFX_CONFIG_RENDERER_VULKAN_RECORD_MIN_DRAWS 512
+#endif // BGFX_CONFIG_RENDERER_VULKAN_RECORD_MIN_DRAWS
+
 #endif // BGFX_CONFIG_H_HEADER_GUARD
@@ -483,59 +483,153 @@ namespace bgfx
 			: m_viewName(_viewName)
 			, m_frame(_frame)
 			, m_gpuTimer(_gpuTimer)
+			, m_numPrimsRendered(NULL)
+			, m_numInstances(NULL)
 			, m_queryIdx(UINT32_MAX)
 			, m_numViews(0)
-			, m_enabled(_enabled && 0 != (_frame->m_debug & BGFX_DEBUG_PROFILER) )
+			, m_enabled(0 != (_frame->m_debug & BGFX_DEBUG_PROFILER) )
+			, m_gpuTimerEnabled(_enabled)
+			, m_inView(false)
 		{
 		}
 
 		~Profiler()
 		{
+			if (m_enabled)
+			{
+				addDroppedViews();
+			}
+
 			m_frame->m_perfStats.numViews = m_numViews;
 		}
 
+		/// Backend counters sampled at view begin and end to get per view primitive and
+		/// instance counts. Arrays are indexed by topology.
+		void setPrimStats(const uint32_t* _numPrimsRendered, const uint32_t* _numInstances)
+		{
+			m_numPrimsRendered = _numPrimsRendered;
+			m_numInstances     = _numInstances;
+		}
+
 		void begin(uint16_t _view)
 		{
-			if (m_enabled)
+			if (m_enabled
+			&&  m_numViews < BGFX_CONFIG_MAX_VIEWS)
 			{
 				ViewStats& viewStats = m_frame->m_perfStats.viewStats[m_numViews];
 				viewStats.cpuTimeBegin = bx::getHPCounter();
 
-				m_queryIdx = m_gpuTimer.begin(_view);
+				m_queryIdx = m_gpuTimerEnabled ? m_gpuTimer.begin(_view) : UINT32_MAX;
+				m_inView   = true;
 
 				viewStats.view = ViewId(_view);
 				bx::strCopy(viewStats.name
 					, BGFX_CONFIG_MAX_VIEW_NAME
 					, &m_viewName[_view][BGFX_CONFIG_MAX_VIEW_NAME_RESERVED]
 					);
+
+				setCounters(viewStats, m_frame->m_viewCounters[_view]);
+
+				if (NULL != m_numPrimsRendered)
+				{
+					bx::memCopy(m_primsBegin,     m_numPrimsRendered, sizeof(m_primsBegin) );
+					bx::memCopy(m_instancesBegin, m_numInstances,     sizeof(m_instancesBegin) );
+				}
 			}
 		}
 
 		void end()
 		{
-			if (m_enabled
-			&&  UINT32_MAX != m_queryIdx)
+			if (m_inView)
 			{
-				m_gpuTimer.end(m_queryIdx);
-
 				ViewStats& viewStats = m_frame->m_perfStats.viewStats[m_numViews];
-				const typename Ty::Result& result = m_gpuTimer.m_result[viewStats.view];
+				viewStats.cpuTimeEnd   = bx::getHPCounter();
+				viewStats.gpuTimeBegin = 0;
+				viewStats.gpuTimeEnd   = 0;
 
-				viewStats.cpuTimeEnd = bx::getHPCounter();
-				viewStats.gpuTimeBegin = result.m_begin;
-				viewStats.gpuTimeEnd = result.m_end;
+				if (UINT32_MAX != m_queryIdx)
+				{
+					m_gpuTimer.end(m_queryIdx);
+
+					const typename Ty::Result& result = m_gpuTimer.m_result[viewStats.view];
+					viewStats.gpuTimeBegin = result.m_begin;
+					viewStats.gpuTimeEnd   = result.m_end;
+				}
+
+				if (NULL != m_numPrimsRendered)
+				{
+					for (uint32_t ii = 0; ii < Topology::Count; ++ii)
+					{
+						viewStats.numPrims[ii]   = m_numPrimsRendered[ii] - m_primsBegin[ii];
+						viewStats.numInstances  += m_numInstances[ii]     - m_instancesBegin[ii];
+					}
+				}
 
 				++m_numViews;
 				m_queryIdx = UINT32_MAX;
+				m_inView   = false;
+			}
+		}
+
+	private:
+		static void setCounters(ViewStats& _viewStats, const ViewCounters& _counters)
+		{
+			_viewStats.numDraw           = _counters.m_numDraw;
+			_viewStats.numCompute        = _counters.m_numCompute;
+			_viewStats.numBlit           = _counters.m_numBlit;
+			_viewStats.numDropped        = _counters.m_numDropped;
+			_viewStats.numProgramChanges = _counters.m_numProgramChanges;
+			_viewStats.numBindChanges    = _counters.m_numBindChanges;
+			_viewStats.numBufferChanges  = _counters.m_numBufferChanges;
+			_viewStats.numStateChanges   = _counters.m_numStateChanges;
+			_viewStats.uniformSize       = _counters.m_uniformSize;
+			_viewStats.numInstances      = 0;
+			bx::memSet(_viewStats.numPrims, 0, sizeof(_viewStats.numPrims) );
+		}
+
+		// Views with all items dropped never reach backend submit loop. Report them anyway,
+		// since dropped items are usually the reason view is missing from frame.
+		void addDroppedViews()
+		{
+			for (uint16_t view = 0; view < BGFX_CONFIG_MAX_VIEWS && m_numViews < BGFX_CONFIG_MAX_VIEWS; ++view)
+			{
+				const ViewCounters& counters = m_frame->m_viewCounters[view];
+
+				if (0 == counters.m_numDropped
+				||  0 != counters.m_numDraw + counters.m_numCompute)
+				{
+					continue;
+				}
+
+				ViewStats& viewStats = m_frame->m_perfStats.viewStats[m_numViews];
+				viewStats.view         = ViewId(view);
+				viewStats.cpuTimeBegin = 0;
+				viewStats.cpuTimeEnd   = 0;
+				viewStats.gpuTimeBegin = 0;
+				viewStats.gpuTimeEnd   = 0;
+				bx::strCopy(viewStats.name
+					, BGFX_CONFIG_MAX_VIEW_NAME
+					, &m_viewName[view][BGFX_CONFIG_MAX_VIEW_NAME_RESERVED]
+					);
+
+				setCounters(viewStats, counters);
+
+				++m_numViews;
 			}
 		}
 
 		const char (*m_viewName)[BGFX_CONFIG_MAX_VIEW_NAME];
 		Frame*   m_frame;
 		Ty&      m_gpuTimer;
+		const uint32_t* m_numPrimsRendered;
+		const uint32_t* m_numInstances;
+		uint32_t m_primsBegin[Topology::Count];
+		uint32_t m_instancesBegin[Topology::Count];
 		uint32_t m_queryIdx;
 		uint16_t m_numViews;
 		bool     m_enabled;
+		bool     m_gpuTimerEnabled;
+		bool     m_inView;
 	};
 
 } // namespace bgfx
@@ -1807,6 +1807,16 @@ namespace bgfx { namespace d3d11
 			m_deviceCtx->Unmap(texture.m_ptr, _mip);
 		}
 
+		void setTextureResidentMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			const TextureD3D11& texture = m_textures[_handle.idx];
+
+			if (NULL != texture.m_ptr)
+			{
+				m_deviceCtx->SetResourceMinLOD(texture.m_ptr, float(bx::min<uint8_t>(_mip, texture.m_numMips-1) ) );
+			}
+		}
+
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) override
 		{
 			TextureD3D11& texture = m_textures[_handle.idx];
@@ -5399,6 +5409,7 @@ namespace bgfx { namespace d3d11
 			, s_viewName
 			, m_timerQuerySupport
 			);
+		profiler.setPrimStats(statsNumPrimsRendered, statsNumInstances);
 
 		m_occlusionQuery.resolve(_render);
 
@@ -6002,16 +6013,18 @@ namespace bgfx { namespace d3d11
 					}
 				}
 
-				if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx)
+				if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx
+				||  currentState.isIndex16() != draw.isIndex16() )
 				{
 					currentState.m_indexBuffer = draw.m_indexBuffer;
+					currentState.m_submitFlags = draw.m_submitFlags;
 
 					uint16_t handle = draw.m_indexBuffer.idx;
 					if (kInvalidHandle != handle)
 					{
 						const IndexBufferD3D11& ib = m_indexBuffers[handle];
 						deviceCtx->IASetIndexBuffer(ib.m_ptr
-							, 0 == (ib.m_flags & BGFX_BUFFER_INDEX32) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT
+							, draw.isIndex16() ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT
 							, 0
 							);
 					}
@@ -6076,7 +6089,7 @@ namespace bgfx { namespace d3d11
 							if (UINT32_MAX == draw.m_numIndices)
 							{
 								const IndexBufferD3D11& ib = m_indexBuffers[draw.m_indexBuffer.idx];
-								const uint32_t indexSize = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+								const uint32_t indexSize = draw.isIndex16() ? 2 : 4;
 								numIndices        = ib.m_size/indexSize;
 								numPrimsSubmitted = numIndices/prim.m_div - prim.m_sub;
 								numInstances      = draw.m_numInstances;
@@ -1683,6 +1683,11 @@ namespace bgfx { namespace d3d12
 			DX_RELEASE(readback, 0);
 		}
 
+		void setTextureResidentMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			m_textures[_handle.idx].setResidentMip(_mip);
+		}
+
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) override
 		{
 			TextureD3D12& texture = m_textures[_handle.idx];
@@ -4047,7 +4052,7 @@ namespace bgfx { namespace d3d12
 				BufferD3D12& ib = s_renderD3D12->m_indexBuffers[_draw.m_indexBuffer.idx];
 				ib.setState(_commandList, D3D12_RESOURCE_STATE_GENERIC_READ);
 
-				const bool hasIndex16 = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32);
+				const bool hasIndex16 = _draw.isIndex16();
 				const uint32_t indexSize = hasIndex16 ? 2 : 4;
 
 				numIndices = UINT32_MAX == _draw.m_numIndices
@@ -4126,7 +4131,7 @@ namespace bgfx { namespace d3d12
 			BufferD3D12& ib = s_renderD3D12->m_indexBuffers[_draw.m_indexBuffer.idx];
 			ib.setState(_commandList, D3D12_RESOURCE_STATE_GENERIC_READ);
 
-			const bool hasIndex16 = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32);
+			const bool hasIndex16 = _draw.isIndex16();
 			const uint32_t indexSize = hasIndex16 ? 2 : 4;
 
 			numIndices = UINT32_MAX == _draw.m_numIndices
@@ -5072,6 +5077,23 @@ namespace bgfx { namespace d3d12
 		BX_UNUSED(_resolve);
 	}
 
+	void TextureD3D12::setResidentMip(uint8_t _mip)
+	{
+		// Shader resource views are created from m_srvd every time texture is bound, so clamp
+		// takes effect from next frame.
+		const float minLod = float(bx::min<uint8_t>(_mip, m_numMips-1) );
+
+		switch (m_srvd.ViewDimension)
+		{
+		case D3D12_SRV_DIMENSION_TEXTURE2D:        m_srvd.Texture2D.ResourceMinLODClamp        = minLod; break;
+		case D3D12_SRV_DIMENSION_TEXTURE2DARRAY:   m_srvd.Texture2DArray.ResourceMinLODClamp   = minLod; break;
+		case D3D12_SRV_DIMENSION_TEXTURE3D:        m_srvd.Texture3D.ResourceMinLODClamp        = minLod; break;
+		case D3D12_SRV_DIMENSION_TEXTURECUBE:      m_srvd.TextureCube.ResourceMinLODClamp      = minLod; break;
+		case D3D12_SRV_DIMENSION_TEXTURECUBEARRAY: m_srvd.TextureCubeArray.ResourceMinLODClamp = minLod; break;
+		default: break;
+		}
+	}
+
 	D3D12_RESOURCE_STATES TextureD3D12::setState(ID3D12GraphicsCommandList* _commandList, D3D12_RESOURCE_STATES _state)
 	{
 		if (m_state != _state)
@@ -5882,6 +5904,7 @@ namespace bgfx { namespace d3d12
 			, m_gpuTimer
 			, s_viewName
 			);
+		profiler.setPrimStats(statsNumPrimsRendered, statsNumInstances);
 
 #if BX_PLATFORM_WINDOWS
 		if (NULL != m_swapChain)
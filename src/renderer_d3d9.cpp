@@ -1126,6 +1126,13 @@ namespace bgfx { namespace d3d9
 			DX_CHECK(texture.m_texture2d->UnlockRect(_mip) );
 		}
 
+		void setTextureResidentMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			// D3DSAMP_MAXMIPLEVEL is sampler state, it's applied when texture is bound.
+			TextureD3D9& texture = m_textures[_handle.idx];
+			texture.m_residentMip = bx::min<uint8_t>(_mip, texture.m_numMips-1);
+		}
+
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) override
 		{
 			TextureD3D9& texture = m_textures[_handle.idx];
@@ -1721,7 +1728,8 @@ namespace bgfx { namespace d3d9
 		{
 			for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
 			{
-				m_samplerFlags[stage] = UINT32_MAX;
+				m_samplerFlags[stage]       = UINT32_MAX;
+				m_samplerMaxMipLevel[stage] = UINT8_MAX;
 			}
 		}
 
@@ -1772,6 +1780,15 @@ namespace bgfx { namespace d3d9
 			}
 		}
 
+		void setSamplerMaxMipLevel(uint8_t _stage, uint8_t _mip)
+		{
+			if (m_samplerMaxMipLevel[_stage] != _mip)
+			{
+				m_samplerMaxMipLevel[_stage] = _mip;
+				setSamplerState(m_device, _stage, D3DSAMP_MAXMIPLEVEL, _mip);
+			}
+		}
+
 		bool isVisible(Frame* _render, OcclusionQueryHandle _handle, bool _visible)
 		{
 			m_occlusionQuery.resolve(_render);
@@ -2243,6 +2260,7 @@ namespace bgfx { namespace d3d9
 		void* m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
 
 		uint64_t m_samplerFlags[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
+		uint8_t  m_samplerMaxMipLevel[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
 
 		TextureD3D9* m_updateTexture;
 		uint8_t* m_updateTextureBits;
@@ -2317,6 +2335,7 @@ namespace bgfx { namespace d3d9
 		if (NULL != m_dynamic)
 		{
 			DX_RELEASE(m_ptr, 0);
+			DX_RELEASE(m_ptr32, 0);
 		}
 	}
 
@@ -2341,6 +2360,68 @@ namespace bgfx { namespace d3d9
 		}
 	}
 
+	// Index format is part of D3D9 index buffer. Buffer with mixed 16/32-bit indices has 32-bit
+	// view, created when first 32-bit draw call uses it.
+	IDirect3DIndexBuffer9* IndexBufferD3D9::getPtr32()
+	{
+		if (NULL == m_ptr32)
+		{
+			DX_CHECK(s_renderD3D9->m_device->CreateIndexBuffer(m_size
+				, D3DUSAGE_WRITEONLY|D3DUSAGE_DYNAMIC
+				, D3DFMT_INDEX32
+				, D3DPOOL_DEFAULT
+				, &m_ptr32
+				, NULL
+				) );
+
+			m_begin32 = 0;
+			m_end32   = 0;
+		}
+
+		return m_ptr32;
+	}
+
+	// Uploads only indices of 32-bit draw calls. Uploaded range is kept contiguous, and it's
+	// grown by uploading only the part not uploaded yet. First upload after buffer update
+	// discards previous contents, and following ones don't overwrite ranges that GPU might be
+	// using.
+	void IndexBufferD3D9::update32(uint32_t _startIndex, uint32_t _numIndices)
+	{
+		const uint32_t begin = bx::min<uint32_t>(_startIndex*4, m_size);
+		const uint32_t end   = UINT32_MAX == _numIndices
+			? m_size
+			: bx::min<uint32_t>(begin + _numIndices*4, m_size)
+			;
+
+		if (begin >= end)
+		{
+			return;
+		}
+
+		IDirect3DIndexBuffer9* ptr = getPtr32();
+
+		if (m_begin32 == m_end32)
+		{
+			update(ptr, begin, end - begin, &m_dynamic[begin], D3DLOCK_DISCARD);
+
+			m_begin32 = begin;
+			m_end32   = end;
+			return;
+		}
+
+		if (begin < m_begin32)
+		{
+			update(ptr, begin, m_begin32 - begin, &m_dynamic[begin], D3DLOCK_NOOVERWRITE);
+			m_begin32 = begin;
+		}
+
+		if (end > m_end32)
+		{
+			update(ptr, m_end32, end - m_end32, &m_dynamic[m_end32], D3DLOCK_NOOVERWRITE);
+			m_end32 = end;
+		}
+	}
+
 	void VertexBufferD3D9::create(uint32_t _size, void* _data, VertexLayoutHandle _layoutHandle)
 	{
 		m_size = _size;
@@ -2939,6 +3020,7 @@ namespace bgfx { namespace d3d9
 			m_height  = ti.height;
 			m_depth   = ti.depth;
 			m_numMips = ti.numMips;
+			m_residentMip = 0;
 			m_requestedFormat = uint8_t(imageContainer.m_format);
 			m_textureFormat   = uint8_t(getViableTextureFormat(imageContainer) );
 			const bool convert = m_textureFormat != m_requestedFormat;
@@ -3127,6 +3209,7 @@ namespace bgfx { namespace d3d9
 			;
 		uint32_t index = (flags & BGFX_SAMPLER_BORDER_COLOR_MASK) >> BGFX_SAMPLER_BORDER_COLOR_SHIFT;
 		s_renderD3D9->setSamplerState(_stage, flags, _palette[index]);
+		s_renderD3D9->setSamplerMaxMipLevel(_stage, m_residentMip);
 
 		IDirect3DDevice9* device = s_renderD3D9->m_device;
 		DX_CHECK(device->SetTexture(_stage, m_ptr) );
@@ -3796,6 +3879,7 @@ namespace bgfx { namespace d3d9
 			, s_viewName
 			, m_timerQuerySupport
 			);
+		profiler.setPrimStats(statsNumPrimsRendered, statsNumInstances);
 
 		if (m_occlusionQuerySupport)
 		{
@@ -4283,15 +4367,20 @@ namespace bgfx { namespace d3d9
 					}
 				}
 
-				if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx)
+				if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx
+				||  currentState.isIndex16() != draw.isIndex16() )
 				{
 					currentState.m_indexBuffer = draw.m_indexBuffer;
+					currentState.m_submitFlags = draw.m_submitFlags;
 
 					uint16_t handle = draw.m_indexBuffer.idx;
 					if (kInvalidHandle != handle)
 					{
-						const IndexBufferD3D9& ib = m_indexBuffers[handle];
-						DX_CHECK(device->SetIndices(ib.m_ptr) );
+						IndexBufferD3D9& ib = m_indexBuffers[handle];
+						DX_CHECK(device->SetIndices(draw.isIndex16() || 0 == (ib.m_flags & BGFX_BUFFER_INTERNAL_INDEX_MIXED)
+							? ib.m_ptr
+							: ib.getPtr32()
+							) );
 					}
 					else
 					{
@@ -4314,10 +4403,17 @@ namespace bgfx { namespace d3d9
 
 					if (isValid(draw.m_indexBuffer) )
 					{
+						IndexBufferD3D9& ib = m_indexBuffers[draw.m_indexBuffer.idx];
+
+						if (!draw.isIndex16()
+						&&  0 != (ib.m_flags & BGFX_BUFFER_INTERNAL_INDEX_MIXED) )
+						{
+							ib.update32(draw.m_startIndex, draw.m_numIndices);
+						}
+
 						if (UINT32_MAX == draw.m_numIndices)
 						{
-							const IndexBufferD3D9& ib = m_indexBuffers[draw.m_indexBuffer.idx];
-							const uint32_t indexSize = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+							const uint32_t indexSize = draw.isIndex16() ? 2 : 4;
 							numIndices        = ib.m_size/indexSize;
 							numPrimsSubmitted = numIndices/prim.m_div - prim.m_sub;
 							numInstances      = draw.m_numInstances;
@@ -132,8 +132,11 @@ namespace bgfx { namespace d3d9
 	{
 		IndexBufferD3D9()
 			: m_ptr(NULL)
+			, m_ptr32(NULL)
 			, m_dynamic(NULL)
 			, m_size(0)
+			, m_begin32(0)
+			, m_end32(0)
 			, m_flags(BGFX_BUFFER_NONE)
 		{
 		}
@@ -147,16 +150,29 @@ namespace bgfx { namespace d3d9
 				bx::memCopy(&m_dynamic[_offset], _data, _size);
 			}
 
+			const DWORD flags = _discard || (m_dynamic && 0 == _offset && m_size == _size) ? D3DLOCK_DISCARD : 0;
+			update(m_ptr, _offset, _size, _data, flags);
+
+			// 32-bit buffer is uploaded on demand by draw calls using it.
+			m_begin32 = 0;
+			m_end32   = 0;
+		}
+
+		IDirect3DIndexBuffer9* getPtr32();
+		void update32(uint32_t _startIndex, uint32_t _numIndices);
+
+		static void update(IDirect3DIndexBuffer9* _ptr, uint32_t _offset, uint32_t _size, void* _data, DWORD _flags)
+		{
 			void* buffer;
-			DX_CHECK(m_ptr->Lock(_offset
+			DX_CHECK(_ptr->Lock(_offset
 				, _size
 				, &buffer
-				, _discard || (m_dynamic && 0 == _offset && m_size == _size) ? D3DLOCK_DISCARD : 0
+				, _flags
 				) );
 
 			bx::memCopy(buffer, _data, _size);
 
-			DX_CHECK(m_ptr->Unlock() );
+			DX_CHECK(_ptr->Unlock() );
 		}
 
 		void destroy()
@@ -164,6 +180,7 @@ namespace bgfx { namespace d3d9
 			if (NULL != m_ptr)
 			{
 				DX_RELEASE(m_ptr, 0);
+				DX_RELEASE(m_ptr32, 0);
 
 				if (NULL != m_dynamic)
 				{
@@ -177,8 +194,11 @@ namespace bgfx { namespace d3d9
 		void postReset();
 
 		IDirect3DIndexBuffer9* m_ptr;
+		IDirect3DIndexBuffer9* m_ptr32; //!< 32-bit view of buffer with mixed 16/32-bit indices.
 		uint8_t* m_dynamic;
 		uint32_t m_size;
+		uint32_t m_begin32; //!< Contiguous byte range of 32-bit view uploaded since last update.
+		uint32_t m_end32;
 		uint16_t m_flags;
 	};
 
@@ -394,6 +414,7 @@ namespace bgfx { namespace d3d9
 		uint32_t m_height;
 		uint32_t m_depth;
 		uint8_t m_numMips;
+		uint8_t m_residentMip;
 		uint8_t m_type;
 		uint8_t m_requestedFormat;
 		uint8_t m_textureFormat;
@@ -3291,6 +3291,11 @@ namespace bgfx { namespace gl
 			}
 		}
 
+		void setTextureResidentMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			m_textures[_handle.idx].setResidentMip(_mip);
+		}
+
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) override
 		{
 			TextureGL& texture = m_textures[_handle.idx];
@@ -5159,6 +5164,8 @@ namespace bgfx { namespace gl
 		m_height  = _height;
 		m_depth   = _depth;
 		m_currentSamplerHash = UINT32_MAX;
+		m_residentMip        = 0;
+		m_currentResidentMip = 0;
 
 		const bool writeOnly    = 0 != (m_flags&BGFX_TEXTURE_RT_WRITE_ONLY);
 		const bool computeWrite = 0 != (m_flags&BGFX_TEXTURE_COMPUTE_WRITE );
@@ -5672,6 +5679,13 @@ namespace bgfx { namespace gl
 		}
 	}
 
+	void TextureGL::setResidentMip(uint8_t _mip)
+	{
+		// Applied in commit when texture is bound for sampling, so that texture bindings are
+		// not changed outside of draw call state.
+		m_residentMip = bx::min<uint8_t>(_mip, m_numMips-1);
+	}
+
 	void TextureGL::setSamplerState(uint32_t _flags, const float _rgba[4])
 	{
 		if (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES < 30)
@@ -5781,6 +5795,18 @@ namespace bgfx { namespace gl
 		GL_CHECK(glActiveTexture(GL_TEXTURE0+_stage) );
 		GL_CHECK(glBindTexture(m_target, m_id) );
 
+		if (m_residentMip != m_currentResidentMip)
+		{
+			// Base level is texture object state, so it applies with and without sampler objects.
+			if (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL || BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+			&&  GL_TEXTURE_2D_MULTISAMPLE != m_target)
+			{
+				GL_CHECK(glTexParameteri(m_target, GL_TEXTURE_BASE_LEVEL, m_residentMip) );
+			}
+
+			m_currentResidentMip = m_residentMip;
+		}
+
 		if (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES)
 		&&  BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES < 30) )
 		{
@@ -7110,6 +7136,7 @@ namespace bgfx { namespace gl
 			, s_viewName
 			, m_timerQuerySupport && !BX_ENABLED(BX_PLATFORM_OSX)
 			);
+		profiler.setPrimStats(statsNumPrimsRendered, statsNumInstances);
 
 		if (m_occlusionQuerySupport)
 		{
@@ -7948,8 +7975,7 @@ namespace bgfx { namespace gl
 
 							if (isValid(draw.m_indexBuffer) )
 							{
-								const IndexBufferGL& ib = m_indexBuffers[draw.m_indexBuffer.idx];
-								const bool hasIndex16 = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32);
+								const bool hasIndex16 = draw.isIndex16();
 								const GLenum indexFormat = hasIndex16
 									? GL_UNSIGNED_SHORT
 									: GL_UNSIGNED_INT
@@ -7993,7 +8019,7 @@ namespace bgfx { namespace gl
 							if (isValid(draw.m_indexBuffer) )
 							{
 								const IndexBufferGL& ib = m_indexBuffers[draw.m_indexBuffer.idx];
-								const bool hasIndex16 = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32);
+								const bool hasIndex16 = draw.isIndex16();
 								const uint32_t indexSize = hasIndex16 ? 2 : 4;
 								const GLenum indexFormat = hasIndex16
 									? GL_UNSIGNED_SHORT
@@ -8143,6 +8169,17 @@ namespace bgfx { namespace gl
 		perfStats.gpuMemoryMax  = -INT64_MAX;
 		perfStats.gpuMemoryUsed = -INT64_MAX;
 
+		if (s_extension[Extension::NVX_gpu_memory_info].m_supported)
+		{
+			GLint totalAvail;
+			GL_CHECK(glGetIntegerv(GL_GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX, &totalAvail) );
+			GLint currAvail;
+			GL_CHECK(glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &currAvail) );
+
+			perfStats.gpuMemoryMax  = 1024 * int64_t(totalAvail);
+			perfStats.gpuMemoryUsed = 1024 * int64_t(totalAvail - currAvail);
+		}
+
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
 		{
 			BGFX_GL_PROFILER_BEGIN_LITERAL("debugstats", kColorFrame);
@@ -782,6 +782,10 @@ typedef uint64_t GLuint64;
 #	define GL_SAMPLER_2D_ARRAY_SHADOW 0x8DC4
 #endif // GL_SAMPLER_2D_ARRAY_SHADOW
 
+#ifndef GL_TEXTURE_BASE_LEVEL
+#	define GL_TEXTURE_BASE_LEVEL 0x813C
+#endif // GL_TEXTURE_BASE_LEVEL
+
 #ifndef GL_TEXTURE_MAX_LEVEL
 #	define GL_TEXTURE_MAX_LEVEL 0x813D
 #endif // GL_TEXTURE_MAX_LEVEL
@@ -1370,6 +1374,8 @@ namespace bgfx { namespace gl
 			, m_flags(0)
 			, m_currentSamplerHash(UINT32_MAX)
 			, m_numMips(0)
+			, m_residentMip(0)
+			, m_currentResidentMip(0)
 		{
 		}
 
@@ -1379,6 +1385,7 @@ namespace bgfx { namespace gl
 		void overrideInternal(uintptr_t _ptr);
 		void update(uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem);
 		void setSamplerState(uint32_t _flags, const float _rgba[4]);
+		void setResidentMip(uint8_t _mip);
 		void commit(uint32_t _stage, uint32_t _flags, const float _palette[][4]);
 		void resolve(uint8_t _resolve) const;
 
@@ -1402,6 +1409,8 @@ namespace bgfx { namespace gl
 		uint32_t m_depth;
 		uint32_t m_numLayers;
 		uint8_t m_numMips;
+		uint8_t m_residentMip;
+		uint8_t m_currentResidentMip;
 		uint8_t m_requestedFormat;
 		uint8_t m_textureFormat;
 	};
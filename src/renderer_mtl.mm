@@ -870,6 +870,15 @@ namespace bgfx { namespace mtl
 			texture.m_ptr.getBytes(_data, srcWidth*bpp/8, 0, region, _mip, 0);
 		}
 
+		void setTextureResidentMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			// Clamped with sampler lodMinClamp. Default sampler of texture is replaced too, since
+			// it's used when texture is bound without sampler flags.
+			TextureMtl& texture = m_textures[_handle.idx];
+			texture.m_residentMip = bx::min<uint8_t>(_mip, texture.m_numMips-1);
+			texture.m_sampler     = getSamplerState(uint32_t(texture.m_flags), texture.m_residentMip);
+		}
+
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) override
 		{
 			TextureMtl& texture = m_textures[_handle.idx];
@@ -2230,10 +2239,11 @@ namespace bgfx { namespace mtl
 		}
 
 
-		SamplerState getSamplerState(uint32_t _flags)
+		SamplerState getSamplerState(uint32_t _flags, uint8_t _minMip = 0)
 		{
 			_flags &= BGFX_SAMPLER_BITS_MASK;
-			SamplerState sampler = m_samplerStateCache.find(_flags);
+			const uint64_t key = uint64_t(_minMip)<<32 | _flags;
+			SamplerState sampler = m_samplerStateCache.find(key);
 
 			if (NULL == sampler)
 			{
@@ -2243,7 +2253,7 @@ namespace bgfx { namespace mtl
 				m_samplerDescriptor.minFilter    = s_textureFilterMinMag[(_flags&BGFX_SAMPLER_MIN_MASK)>>BGFX_SAMPLER_MIN_SHIFT];
 				m_samplerDescriptor.magFilter    = s_textureFilterMinMag[(_flags&BGFX_SAMPLER_MAG_MASK)>>BGFX_SAMPLER_MAG_SHIFT];
 				m_samplerDescriptor.mipFilter    = s_textureFilterMip[(_flags&BGFX_SAMPLER_MIP_MASK)>>BGFX_SAMPLER_MIP_SHIFT];
-				m_samplerDescriptor.lodMinClamp  = 0;
+				m_samplerDescriptor.lodMinClamp  = _minMip;
 				m_samplerDescriptor.lodMaxClamp  = FLT_MAX;
 				m_samplerDescriptor.normalizedCoordinates = TRUE;
 				m_samplerDescriptor.maxAnisotropy =  (0 != (_flags & (BGFX_SAMPLER_MIN_ANISOTROPIC|BGFX_SAMPLER_MAG_ANISOTROPIC) ) ) ? m_mainFrameBuffer.m_swapChain->m_maxAnisotropy : 1;
@@ -2259,7 +2269,7 @@ namespace bgfx { namespace mtl
 				}
 
 				sampler = m_device.newSamplerStateWithDescriptor(m_samplerDescriptor);
-				m_samplerStateCache.add(_flags, sampler);
+				m_samplerStateCache.add(key, sampler);
 			}
 
 			return sampler;
@@ -2620,7 +2630,8 @@ namespace bgfx { namespace mtl
 
 	void TextureMtl::create(const Memory* _mem, uint64_t _flags, uint8_t _skip)
 	{
-		m_sampler = s_renderMtl->getSamplerState(uint32_t(_flags) );
+		m_sampler     = s_renderMtl->getSamplerState(uint32_t(_flags) );
+		m_residentMip = 0;
 
 		bimg::ImageContainer imageContainer;
 
@@ -2965,7 +2976,7 @@ namespace bgfx { namespace mtl
 			s_renderMtl->m_renderCommandEncoder.setVertexTexture(m_ptr, _stage);
 			s_renderMtl->m_renderCommandEncoder.setVertexSamplerState(
 				  0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & _flags)
-					? s_renderMtl->getSamplerState(_flags)
+					? s_renderMtl->getSamplerState(_flags, m_residentMip)
 					: m_sampler
 				, _stage
 				);
@@ -2976,7 +2987,7 @@ namespace bgfx { namespace mtl
 			s_renderMtl->m_renderCommandEncoder.setFragmentTexture(m_ptr, _stage);
 			s_renderMtl->m_renderCommandEncoder.setFragmentSamplerState(
 				  0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & _flags)
-					? s_renderMtl->getSamplerState(_flags)
+					? s_renderMtl->getSamplerState(_flags, m_residentMip)
 					: m_sampler
 				, _stage
 				);
@@ -3803,6 +3814,7 @@ namespace bgfx { namespace mtl
 			, m_gpuTimer
 			, s_viewName
 			);
+		profiler.setPrimStats(statsNumPrimsRendered, statsNumInstances);
 
 		m_occlusionQuery.resolve(_render);
 
@@ -4134,7 +4146,7 @@ namespace bgfx { namespace mtl
 									m_computeCommandEncoder.setTexture(texture.m_ptr, stage);
 									m_computeCommandEncoder.setSamplerState(
 										0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & flags)
-										? getSamplerState(flags)
+										? getSamplerState(flags, texture.m_residentMip)
 										: texture.m_sampler
 										, stage
 										);
@@ -4574,7 +4586,7 @@ namespace bgfx { namespace mtl
 						if (isValid(draw.m_indexBuffer) )
 						{
 							const IndexBufferMtl& ib = m_indexBuffers[draw.m_indexBuffer.idx];
-							MTLIndexType indexType = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32) ? MTLIndexTypeUInt16 : MTLIndexTypeUInt32;
+							MTLIndexType indexType = draw.isIndex16() ? MTLIndexTypeUInt16 : MTLIndexTypeUInt32;
 
 							numDrawIndirect = UINT16_MAX == draw.m_numIndirect
 							? vb.m_size/BGFX_CONFIG_DRAW_INDIRECT_STRIDE
@@ -4603,11 +4615,11 @@ namespace bgfx { namespace mtl
 						if (isValid(draw.m_indexBuffer) )
 						{
 							const IndexBufferMtl& ib = m_indexBuffers[draw.m_indexBuffer.idx];
-							MTLIndexType indexType = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32) ? MTLIndexTypeUInt16 : MTLIndexTypeUInt32;
+							MTLIndexType indexType = draw.isIndex16() ? MTLIndexTypeUInt16 : MTLIndexTypeUInt32;
 
 							if (UINT32_MAX == draw.m_numIndices)
 							{
-								const uint32_t indexSize = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+								const uint32_t indexSize = draw.isIndex16() ? 2 : 4;
 								numIndices        = ib.m_size/indexSize;
 								numPrimsSubmitted = numIndices/prim.m_div - prim.m_sub;
 								numInstances      = draw.m_numInstances;
@@ -4617,7 +4629,7 @@ namespace bgfx { namespace mtl
 							}
 							else if (prim.m_min <= draw.m_numIndices)
 							{
-								const uint32_t indexSize = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+								const uint32_t indexSize = draw.isIndex16() ? 2 : 4;
 								numIndices        = draw.m_numIndices;
 								numPrimsSubmitted = numIndices/prim.m_div - prim.m_sub;
 								numInstances      = draw.m_numInstances;
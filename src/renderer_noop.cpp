@@ -177,6 +177,10 @@ namespace bgfx { namespace noop
 		{
 		}
 
+		void setTextureResidentMip(TextureHandle /*_handle*/, uint8_t /*_mip*/) override
+		{
+		}
+
 		void resizeTexture(TextureHandle /*_handle*/, uint16_t /*_width*/, uint16_t /*_height*/, uint8_t /*_numMips*/, uint16_t /*_numLayers*/) override
 		{
 		}
@@ -243,6 +247,12 @@ namespace bgfx { namespace noop
 			const int64_t timerFreq = bx::getHPFrequency();
 			const int64_t timeBegin = bx::getHPCounter();
 
+			// Sorting is only needed to report state changes.
+			if (0 != (_render->m_debug & BGFX_DEBUG_PROFILER) )
+			{
+				_render->sort();
+			}
+
 			Stats& perfStats = _render->m_perfStats;
 			perfStats.cpuTimeBegin  = timeBegin;
 			perfStats.cpuTimeEnd    = timeBegin;
@@ -957,15 +957,71 @@ VK_IMPORT_DEVICE
 			);
 	}
 
+	// Takes lock only while draw calls are recorded by multiple threads, so that render thread
+	// recording alone doesn't pay for locking.
+	class ConditionalMutexScope
+	{
+		BX_CLASS(ConditionalMutexScope
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			, NO_ASSIGNMENT
+			);
+
+	public:
+		ConditionalMutexScope(bx::Mutex& _mutex, bool _lock)
+			: m_mutex(_lock ? &_mutex : NULL)
+		{
+			if (NULL != m_mutex)
+			{
+				m_mutex->lock();
+			}
+		}
+
+		~ConditionalMutexScope()
+		{
+			if (NULL != m_mutex)
+			{
+				m_mutex->unlock();
+			}
+		}
+
+	private:
+		bx::Mutex* m_mutex;
+	};
+
+	static bool isRgba8(VkFormat _format)
+	{
+		return VK_FORMAT_R8G8B8A8_UNORM == _format
+			|| VK_FORMAT_R8G8B8A8_SRGB  == _format
+			;
+	}
+
+	static bool isBgra8(VkFormat _format)
+	{
+		return VK_FORMAT_B8G8R8A8_UNORM == _format
+			|| VK_FORMAT_B8G8R8A8_SRGB  == _format
+			;
+	}
+
 	struct RendererContextVK : public RendererContextI
 	{
 		RendererContextVK()
 			: m_allocatorCb(NULL)
+			, m_numFramesInFlight(1)
+			, m_frameIdx(0)
+			, m_frameNum(0)
+			, m_completedFrameNum(0)
+			, m_needPresent(false)
+			, m_captureSize(0)
+			, m_captureElapsed(0)
 			, m_renderDocDll(NULL)
 			, m_vulkan1Dll(NULL)
 			, m_maxAnisotropy(1)
 			, m_depthClamp(false)
 			, m_wireframe(false)
+			, m_numRecordThreads(0)
+			, m_recordParallel(false)
+			, m_recordExit(false)
 		{
 		}
 
@@ -973,49 +1029,124 @@ VK_IMPORT_DEVICE
 		{
 		}
 
-		VkResult createSwapchain()
+		// Without window surface backbuffer is ring of regular images, one per frame in flight,
+		// that is never presented.
+		VkResult createOffscreenBackBuffer()
 		{
+			m_numSwapchainImages = m_sci.minImageCount;
+
+			VkImageCreateInfo ici;
+			ici.sType     = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			ici.pNext     = NULL;
+			ici.flags     = 0;
+			ici.imageType = VK_IMAGE_TYPE_2D;
+			ici.format    = m_sci.imageFormat;
+			ici.extent.width  = m_sci.imageExtent.width;
+			ici.extent.height = m_sci.imageExtent.height;
+			ici.extent.depth  = 1;
+			ici.mipLevels     = 1;
+			ici.arrayLayers   = 1;
+			ici.samples       = VK_SAMPLE_COUNT_1_BIT;
+			ici.tiling        = VK_IMAGE_TILING_OPTIMAL;
+			ici.usage = 0
+				| VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+				| VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+				;
+			ici.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+			ici.queueFamilyIndexCount = 0;
+			ici.pQueueFamilyIndices   = NULL;
+			ici.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
+
 			VkResult result = VK_SUCCESS;
-			result = vkCreateSwapchainKHR(m_device, &m_sci, m_allocatorCb, &m_swapchain);
-			if (VK_SUCCESS != result)
-			{
-				BX_TRACE("Create swapchain error: vkCreateSwapchainKHR failed %d: %s.", result, getName(result) );
-				return result;
-			}
 
-			result = vkGetSwapchainImagesKHR(m_device, m_swapchain, &m_numSwapchainImages, NULL);
-			if (VK_SUCCESS != result)
+			for (uint32_t ii = 0; ii < m_numSwapchainImages; ++ii)
 			{
-				BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR failed %d: %s.", result, getName(result) );
-				return result;
-			}
+				result = vkCreateImage(m_device, &ici, m_allocatorCb, &m_backBufferColorImage[ii]);
 
-			if (m_numSwapchainImages < m_sci.minImageCount)
-			{
-				BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR: numSwapchainImages %d < minImageCount %d."
-					, m_numSwapchainImages
-					, m_sci.minImageCount
-					);
-				return VK_ERROR_INITIALIZATION_FAILED;
+				if (VK_SUCCESS != result)
+				{
+					BX_TRACE("Create offscreen backbuffer error: vkCreateImage failed %d: %s.", result, getName(result) );
+					return result;
+				}
+
+				VkMemoryRequirements mr;
+				vkGetImageMemoryRequirements(m_device, m_backBufferColorImage[ii], &mr);
+
+				result = allocateMemory(&mr, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_backBufferColorMemory[ii]);
+
+				if (VK_SUCCESS != result)
+				{
+					BX_TRACE("Create offscreen backbuffer error: vkAllocateMemory failed %d: %s.", result, getName(result) );
+					return result;
+				}
+
+				result = vkBindImageMemory(m_device, m_backBufferColorImage[ii], m_backBufferColorMemory[ii], 0);
+
+				if (VK_SUCCESS != result)
+				{
+					BX_TRACE("Create offscreen backbuffer error: vkBindImageMemory failed %d: %s.", result, getName(result) );
+					return result;
+				}
 			}
 
-			if (m_numSwapchainImages > BX_COUNTOF(m_backBufferColorImage) )
+			return result;
+		}
+
+		VkResult createSwapchain()
+		{
+			VkResult result = VK_SUCCESS;
+
+			if (m_headless)
 			{
-				BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR: numSwapchainImages %d > countof(m_backBufferColorImage) %d."
-					, m_numSwapchainImages
-					, BX_COUNTOF(m_backBufferColorImage)
-					);
-				return VK_ERROR_INITIALIZATION_FAILED;
+				result = createOffscreenBackBuffer();
+				if (VK_SUCCESS != result)
+				{
+					return result;
+				}
 			}
-
-			result = vkGetSwapchainImagesKHR(m_device, m_swapchain, &m_numSwapchainImages, &m_backBufferColorImage[0]);
-			if (VK_SUCCESS != result && VK_INCOMPLETE != result)
+			else
 			{
-				BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR failed %d: %s."
-					, result
-					, getName(result)
-					);
-				return result;
+				result = vkCreateSwapchainKHR(m_device, &m_sci, m_allocatorCb, &m_swapchain);
+				if (VK_SUCCESS != result)
+				{
+					BX_TRACE("Create swapchain error: vkCreateSwapchainKHR failed %d: %s.", result, getName(result) );
+					return result;
+				}
+
+				result = vkGetSwapchainImagesKHR(m_device, m_swapchain, &m_numSwapchainImages, NULL);
+				if (VK_SUCCESS != result)
+				{
+					BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR failed %d: %s.", result, getName(result) );
+					return result;
+				}
+
+				if (m_numSwapchainImages < m_sci.minImageCount)
+				{
+					BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR: numSwapchainImages %d < minImageCount %d."
+						, m_numSwapchainImages
+						, m_sci.minImageCount
+						);
+					return VK_ERROR_INITIALIZATION_FAILED;
+				}
+
+				if (m_numSwapchainImages > BX_COUNTOF(m_backBufferColorImage) )
+				{
+					BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR: numSwapchainImages %d > countof(m_backBufferColorImage) %d."
+						, m_numSwapchainImages
+						, BX_COUNTOF(m_backBufferColorImage)
+						);
+					return VK_ERROR_INITIALIZATION_FAILED;
+				}
+
+				result = vkGetSwapchainImagesKHR(m_device, m_swapchain, &m_numSwapchainImages, &m_backBufferColorImage[0]);
+				if (VK_SUCCESS != result && VK_INCOMPLETE != result)
+				{
+					BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR failed %d: %s."
+						, result
+						, getName(result)
+						);
+					return result;
+				}
 			}
 
 			VkImageCreateInfo ici;
@@ -1137,6 +1268,13 @@ VK_IMPORT_DEVICE
 			{
 				vkDestroy(m_backBufferColorImageView[ii]);
 				m_backBufferColorImageLayout[ii] = VK_IMAGE_LAYOUT_UNDEFINED;
+
+				if (m_headless)
+				{
+					vkDestroy(m_backBufferColorImage[ii]);
+					vkFreeMemory(m_device, m_backBufferColorMemory[ii], m_allocatorCb);
+					m_backBufferColorMemory[ii] = VK_NULL_HANDLE;
+				}
 			}
 			vkDestroy(m_swapchain);
 		}
@@ -1289,8 +1427,24 @@ VK_IMPORT_DEVICE
 
 			m_fbh.idx = kInvalidHandle;
 			bx::memSet(m_uniforms, 0, sizeof(m_uniforms) );
+			bx::memSet(m_uniformSize, 0, sizeof(m_uniformSize) );
 			bx::memSet(&m_resolution, 0, sizeof(m_resolution) );
 
+			// Without native window handle there is no surface to present to, and backbuffer
+			// is rendered offscreen.
+			m_headless  = NULL == g_platformData.nwh;
+			m_surface   = VK_NULL_HANDLE;
+			m_swapchain = VK_NULL_HANDLE;
+
+			m_commandBuffer = VK_NULL_HANDLE;
+
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_captureBuffer); ++ii)
+			{
+				m_captureBuffer[ii]  = VK_NULL_HANDLE;
+				m_captureMemory[ii]  = VK_NULL_HANDLE;
+				m_capturePending[ii] = false;
+			}
+
 			bool imported = true;
 			VkResult result;
 			m_qfiGraphics = UINT32_MAX;
@@ -1364,13 +1518,15 @@ VK_IMPORT
 					}
 				}
 
-				uint32_t numEnabledExtensions = 2;
+				uint32_t numEnabledExtensions = 0;
+
+				const char* enabledExtension[Extension::Count + 2];
 
-				const char* enabledExtension[Extension::Count + 2] =
+				if (!m_headless)
 				{
-					VK_KHR_SURFACE_EXTENSION_NAME,
-					KHR_SURFACE_EXTENSION_NAME,
-				};
+					enabledExtension[numEnabledExtensions++] = VK_KHR_SURFACE_EXTENSION_NAME;
+					enabledExtension[numEnabledExtensions++] = KHR_SURFACE_EXTENSION_NAME;
+				}
 
 				for (uint32_t ii = 0; ii < Extension::Count; ++ii)
 				{
@@ -1429,6 +1585,14 @@ VK_IMPORT
 VK_IMPORT_INSTANCE
 #undef VK_IMPORT_INSTANCE_FUNC
 
+			imported &= m_headless
+				|| (NULL != vkGetPhysicalDeviceSurfaceCapabilitiesKHR
+				&&  NULL != vkGetPhysicalDeviceSurfaceFormatsKHR
+				&&  NULL != vkGetPhysicalDeviceSurfacePresentModesKHR
+				&&  NULL != vkGetPhysicalDeviceSurfaceSupportKHR
+				&&  NULL != vkDestroySurfaceKHR)
+				;
+
 			if (!imported)
 			{
 				BX_TRACE("Init error: Failed to load instance functions.");
@@ -1723,13 +1887,15 @@ VK_IMPORT_INSTANCE
 				}
 
 
-				uint32_t numEnabledExtensions = 2;
+				uint32_t numEnabledExtensions = 0;
 
-				const char* enabledExtension[Extension::Count + 2] =
+				const char* enabledExtension[Extension::Count + 2];
+				enabledExtension[numEnabledExtensions++] = VK_KHR_MAINTENANCE1_EXTENSION_NAME;
+
+				if (!m_headless)
 				{
-					VK_KHR_SWAPCHAIN_EXTENSION_NAME,
-					VK_KHR_MAINTENANCE1_EXTENSION_NAME
-				};
+					enabledExtension[numEnabledExtensions++] = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
+				}
 
 				for (uint32_t ii = 0; ii < Extension::Count; ++ii)
 				{
@@ -1794,6 +1960,14 @@ VK_IMPORT_INSTANCE
 VK_IMPORT_DEVICE
 #undef VK_IMPORT_DEVICE_FUNC
 
+			imported &= m_headless
+				|| (NULL != vkCreateSwapchainKHR
+				&&  NULL != vkDestroySwapchainKHR
+				&&  NULL != vkGetSwapchainImagesKHR
+				&&  NULL != vkAcquireNextImageKHR
+				&&  NULL != vkQueuePresentKHR)
+				;
+
 			if (!imported)
 			{
 				BX_TRACE("Init error: Failed to load device functions.");
@@ -1803,6 +1977,12 @@ VK_IMPORT_DEVICE
 			vkGetDeviceQueue(m_device, m_qfiGraphics, 0, &m_queueGraphics);
 			vkGetDeviceQueue(m_device, m_qfiCompute,  0, &m_queueCompute);
 
+			if (m_headless)
+			{
+				BX_TRACE("Native window handle is not set, rendering offscreen.");
+				result = VK_SUCCESS;
+			}
+			else
 #if BX_PLATFORM_WINDOWS
 			{
 				VkWin32SurfaceCreateInfoKHR sci;
@@ -1893,163 +2073,202 @@ VK_IMPORT_DEVICE
 			errorState = ErrorState::SurfaceCreated;
 
 			{
-				VkBool32 surfaceSupported;
-				result = vkGetPhysicalDeviceSurfaceSupportKHR(m_physicalDevice, m_qfiGraphics, m_surface, &surfaceSupported);
+				m_backBufferDepthStencilFormat = 0 != (g_caps.formats[TextureFormat::D24S8] & BGFX_CAPS_FORMAT_TEXTURE_2D)
+					? VK_FORMAT_D24_UNORM_S8_UINT
+					: VK_FORMAT_D32_SFLOAT_S8_UINT
+					;
 
-				if (VK_SUCCESS != result)
+				// Frame slot can be reused only after GPU finished it, each slot has its own
+				// command buffer, scratch buffer, and semaphores.
+				m_numFramesInFlight = 0 == _init.resolution.maxFrameLatency
+					? 3
+					: _init.resolution.maxFrameLatency
+					;
+
+				if (m_headless)
 				{
-					BX_TRACE("Init error: vkGetPhysicalDeviceSurfaceSupportKHR failed %d: %s.", result, getName(result) );
-					goto error;
+					m_backBufferColorFormat.format         = VK_FORMAT_R8G8B8A8_UNORM;
+					m_backBufferColorFormat.colorSpace     = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+					m_backBufferColorFormatSrgb.format     = VK_FORMAT_R8G8B8A8_SRGB;
+					m_backBufferColorFormatSrgb.colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+
+					bx::memSet(&m_sci, 0, sizeof(m_sci) );
+					m_sci.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+					m_sci.minImageCount   = bx::clamp<uint32_t>(m_numFramesInFlight, 1, BX_COUNTOF(m_backBufferColorImage) );
+					m_sci.imageFormat     = m_backBufferColorFormat.format;
+					m_sci.imageColorSpace = m_backBufferColorFormat.colorSpace;
+					m_sci.imageExtent.width  = bx::max<uint32_t>(_init.resolution.width,  1);
+					m_sci.imageExtent.height = bx::max<uint32_t>(_init.resolution.height, 1);
+					m_sci.imageArrayLayers = 1;
+					m_sci.imageUsage       = 0
+						| VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+						| VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+						;
+					m_sci.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+					m_sci.preTransform     = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+					m_sci.compositeAlpha   = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+					m_sci.presentMode      = VK_PRESENT_MODE_FIFO_KHR;
 				}
+				else
+				{
+					VkBool32 surfaceSupported;
+					result = vkGetPhysicalDeviceSurfaceSupportKHR(m_physicalDevice, m_qfiGraphics, m_surface, &surfaceSupported);
+
+					if (VK_SUCCESS != result)
+					{
+						BX_TRACE("Init error: vkGetPhysicalDeviceSurfaceSupportKHR failed %d: %s.", result, getName(result) );
+						goto error;
+					}
 
-				VkSurfaceCapabilitiesKHR surfaceCapabilities;
-				result = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_physicalDevice, m_surface, &surfaceCapabilities);
+					VkSurfaceCapabilitiesKHR surfaceCapabilities;
+					result = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_physicalDevice, m_surface, &surfaceCapabilities);
 
-				if (VK_SUCCESS != result)
-				{
-					BX_TRACE("Init error: vkGetPhysicalDeviceSurfaceCapabilitiesKHR failed %d: %s.", result, getName(result) );
-					goto error;
-				}
+					if (VK_SUCCESS != result)
+					{
+						BX_TRACE("Init error: vkGetPhysicalDeviceSurfaceCapabilitiesKHR failed %d: %s.", result, getName(result) );
+						goto error;
+					}
 
-				const uint32_t width = bx::clamp<uint32_t>(
-					  _init.resolution.width
-					, surfaceCapabilities.minImageExtent.width
-					, surfaceCapabilities.maxImageExtent.width
-					);
-				const uint32_t height = bx::clamp<uint32_t>(
-					  _init.resolution.height
-					, surfaceCapabilities.minImageExtent.height
-					, surfaceCapabilities.maxImageExtent.height
-					);
+					const uint32_t width = bx::clamp<uint32_t>(
+						  _init.resolution.width
+						, surfaceCapabilities.minImageExtent.width
+						, surfaceCapabilities.maxImageExtent.width
+						);
+					const uint32_t height = bx::clamp<uint32_t>(
+						  _init.resolution.height
+						, surfaceCapabilities.minImageExtent.height
+						, surfaceCapabilities.maxImageExtent.height
+						);
 
-				uint32_t numSurfaceFormats;
-				result = vkGetPhysicalDeviceSurfaceFormatsKHR(m_physicalDevice, m_surface, &numSurfaceFormats, NULL);
+					uint32_t numSurfaceFormats;
+					result = vkGetPhysicalDeviceSurfaceFormatsKHR(m_physicalDevice, m_surface, &numSurfaceFormats, NULL);
 
-				if (VK_SUCCESS != result)
-				{
-					BX_TRACE("Init error: vkGetPhysicalDeviceSurfaceFormatsKHR failed %d: %s.", result, getName(result) );
-					goto error;
-				}
+					if (VK_SUCCESS != result)
+					{
+						BX_TRACE("Init error: vkGetPhysicalDeviceSurfaceFormatsKHR failed %d: %s.", result, getName(result) );
+						goto error;
+					}
 
-				VkSurfaceFormatKHR surfaceFormats[10];
-				numSurfaceFormats = bx::min<uint32_t>(numSurfaceFormats, BX_COUNTOF(surfaceFormats) );
-				vkGetPhysicalDeviceSurfaceFormatsKHR(m_physicalDevice, m_surface, &numSurfaceFormats, surfaceFormats);
+					VkSurfaceFormatKHR surfaceFormats[10];
+					numSurfaceFormats = bx::min<uint32_t>(numSurfaceFormats, BX_COUNTOF(surfaceFormats) );
+					vkGetPhysicalDeviceSurfaceFormatsKHR(m_physicalDevice, m_surface, &numSurfaceFormats, surfaceFormats);
 
-				// find the best match...
-				static const VkFormat preferredSurfaceFormat[] =
-				{
-					VK_FORMAT_R8G8B8A8_UNORM,
-					VK_FORMAT_B8G8R8A8_UNORM
-				};
+					// find the best match...
+					static const VkFormat preferredSurfaceFormat[] =
+					{
+						VK_FORMAT_R8G8B8A8_UNORM,
+						VK_FORMAT_B8G8R8A8_UNORM
+					};
 
-				static const VkFormat preferredSurfaceFormatSrgb[] =
-				{
-					VK_FORMAT_R8G8B8A8_SRGB,
-					VK_FORMAT_B8G8R8A8_SRGB
-				};
+					static const VkFormat preferredSurfaceFormatSrgb[] =
+					{
+						VK_FORMAT_R8G8B8A8_SRGB,
+						VK_FORMAT_B8G8R8A8_SRGB
+					};
 
-				VkColorSpaceKHR preferredColorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+					VkColorSpaceKHR preferredColorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
 
-				uint32_t surfaceFormatIdx = numSurfaceFormats;
-				uint32_t surfaceFormatSrgbIdx = numSurfaceFormats;
+					uint32_t surfaceFormatIdx = numSurfaceFormats;
+					uint32_t surfaceFormatSrgbIdx = numSurfaceFormats;
 
-				for (uint32_t ii = 0; ii < numSurfaceFormats; ii++)
-				{
-					BX_TRACE("Supported surface format: %d", surfaceFormats[ii].format);
+					for (uint32_t ii = 0; ii < numSurfaceFormats; ii++)
+					{
+						BX_TRACE("Supported surface format: %d", surfaceFormats[ii].format);
 
-					if (preferredColorSpace == surfaceFormats[ii].colorSpace)
-                    {
-						for (uint32_t jj = 0; jj < BX_COUNTOF(preferredSurfaceFormat); jj++)
-						{
-							if (preferredSurfaceFormat[jj] == surfaceFormats[ii].format)
+						if (preferredColorSpace == surfaceFormats[ii].colorSpace)
+	                    {
+							for (uint32_t jj = 0; jj < BX_COUNTOF(preferredSurfaceFormat); jj++)
 							{
-								BX_TRACE("Preferred surface format found: %d", surfaceFormats[ii].format);
-								surfaceFormatIdx = ii;
-								break;
+								if (preferredSurfaceFormat[jj] == surfaceFormats[ii].format)
+								{
+									BX_TRACE("Preferred surface format found: %d", surfaceFormats[ii].format);
+									surfaceFormatIdx = ii;
+									break;
+								}
 							}
-						}
 
-						for (uint32_t jj = 0; jj < BX_COUNTOF(preferredSurfaceFormatSrgb); jj++)
-						{
-							if (preferredSurfaceFormatSrgb[jj] == surfaceFormats[ii].format)
+							for (uint32_t jj = 0; jj < BX_COUNTOF(preferredSurfaceFormatSrgb); jj++)
 							{
-								BX_TRACE("Preferred sRGB surface format found: %d", surfaceFormats[ii].format);
-								surfaceFormatSrgbIdx = ii;
-								break;
+								if (preferredSurfaceFormatSrgb[jj] == surfaceFormats[ii].format)
+								{
+									BX_TRACE("Preferred sRGB surface format found: %d", surfaceFormats[ii].format);
+									surfaceFormatSrgbIdx = ii;
+									break;
+								}
 							}
-						}
 
-						if (surfaceFormatIdx     < numSurfaceFormats
-						&&  surfaceFormatSrgbIdx < numSurfaceFormats)
-						{ // found
-							break;
+							if (surfaceFormatIdx     < numSurfaceFormats
+							&&  surfaceFormatSrgbIdx < numSurfaceFormats)
+							{ // found
+								break;
+							}
 						}
 					}
-				}
 
-				BX_ASSERT(surfaceFormatIdx < numSurfaceFormats, "Cannot find preferred surface format from supported surface formats");
-				BX_WARN(surfaceFormatSrgbIdx < numSurfaceFormats, "Cannot find preferred sRGB surface format from supported surface formats");
+					BX_ASSERT(surfaceFormatIdx < numSurfaceFormats, "Cannot find preferred surface format from supported surface formats");
+					BX_WARN(surfaceFormatSrgbIdx < numSurfaceFormats, "Cannot find preferred sRGB surface format from supported surface formats");
 
-				m_backBufferColorFormat = surfaceFormats[surfaceFormatIdx];
-				m_backBufferColorFormatSrgb = surfaceFormatSrgbIdx < numSurfaceFormats ? surfaceFormats[surfaceFormatSrgbIdx] : m_backBufferColorFormat;
+					m_backBufferColorFormat = surfaceFormats[surfaceFormatIdx];
+					m_backBufferColorFormatSrgb = surfaceFormatSrgbIdx < numSurfaceFormats ? surfaceFormats[surfaceFormatSrgbIdx] : m_backBufferColorFormat;
 
-				// find the best match...
-				uint32_t presentModeIdx = findPresentMode(false);
-				if (UINT32_MAX == presentModeIdx)
-				{
-					BX_TRACE("Unable to find present mode.");
-					goto error;
-				}
+					// find the best match...
+					uint32_t presentModeIdx = findPresentMode(false);
+					if (UINT32_MAX == presentModeIdx)
+					{
+						BX_TRACE("Unable to find present mode.");
+						goto error;
+					}
 
-				m_backBufferDepthStencilFormat = 0 != (g_caps.formats[TextureFormat::D24S8] & BGFX_CAPS_FORMAT_TEXTURE_2D)
-					? VK_FORMAT_D24_UNORM_S8_UINT
-					: VK_FORMAT_D32_SFLOAT_S8_UINT
-					;
+					VkCompositeAlphaFlagBitsKHR compositeAlpha = (VkCompositeAlphaFlagBitsKHR)0;
+					if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR)
+					{
+						compositeAlpha = VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR;
+					}
+					else if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_PRE_MULTIPLIED_BIT_KHR)
+					{
+						compositeAlpha = VK_COMPOSITE_ALPHA_PRE_MULTIPLIED_BIT_KHR;
+					}
+					else if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_POST_MULTIPLIED_BIT_KHR)
+					{
+						compositeAlpha = VK_COMPOSITE_ALPHA_POST_MULTIPLIED_BIT_KHR;
+					}
+					else if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR)
+					{
+						compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+					}
 
-				VkCompositeAlphaFlagBitsKHR compositeAlpha = (VkCompositeAlphaFlagBitsKHR)0;
-				if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR)
-				{
-					compositeAlpha = VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR;
-				}
-				else if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_PRE_MULTIPLIED_BIT_KHR)
-				{
-					compositeAlpha = VK_COMPOSITE_ALPHA_PRE_MULTIPLIED_BIT_KHR;
-				}
-				else if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_POST_MULTIPLIED_BIT_KHR)
-				{
-					compositeAlpha = VK_COMPOSITE_ALPHA_POST_MULTIPLIED_BIT_KHR;
-				}
-				else if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR)
-				{
-					compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+					m_sci.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+					m_sci.pNext = NULL;
+					m_sci.flags = 0;
+					m_sci.surface = m_surface;
+					m_sci.minImageCount   = surfaceCapabilities.minImageCount;
+					m_sci.imageFormat     = m_backBufferColorFormat.format;
+					m_sci.imageColorSpace = m_backBufferColorFormat.colorSpace;
+					m_sci.imageExtent.width  = width;
+					m_sci.imageExtent.height = height;
+					m_sci.imageArrayLayers = 1;
+					m_sci.imageUsage       = 0
+						| VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+						| (surfaceCapabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+						;
+					m_sci.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+					m_sci.queueFamilyIndexCount = 0;
+					m_sci.pQueueFamilyIndices   = NULL;
+					m_sci.preTransform   = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+					m_sci.compositeAlpha = compositeAlpha;
+					m_sci.presentMode    = s_presentMode[presentModeIdx].mode;
+					m_sci.clipped        = VK_TRUE;
+					m_sci.oldSwapchain   = VK_NULL_HANDLE;
 				}
 
-				m_sci.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-				m_sci.pNext = NULL;
-				m_sci.flags = 0;
-				m_sci.surface = m_surface;
-				m_sci.minImageCount   = surfaceCapabilities.minImageCount;
-				m_sci.imageFormat     = m_backBufferColorFormat.format;
-				m_sci.imageColorSpace = m_backBufferColorFormat.colorSpace;
-				m_sci.imageExtent.width  = width;
-				m_sci.imageExtent.height = height;
-				m_sci.imageArrayLayers = 1;
-				m_sci.imageUsage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-				m_sci.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
-				m_sci.queueFamilyIndexCount = 0;
-				m_sci.pQueueFamilyIndices   = NULL;
-				m_sci.preTransform   = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
-				m_sci.compositeAlpha = compositeAlpha;
-				m_sci.presentMode    = s_presentMode[presentModeIdx].mode;
-				m_sci.clipped        = VK_TRUE;
-				m_sci.oldSwapchain   = VK_NULL_HANDLE;
-
 				for (uint32_t ii = 0; ii < BX_COUNTOF(m_backBufferColorImageView); ++ii)
 				{
 					m_backBufferColorImageView[ii] = VK_NULL_HANDLE;
 					m_backBufferColorImage[ii]     = VK_NULL_HANDLE;
+					m_backBufferColorMemory[ii]    = VK_NULL_HANDLE;
 					m_backBufferColor[ii]          = VK_NULL_HANDLE;
 					m_presentDone[ii]              = VK_NULL_HANDLE;
+					m_renderDone[ii]               = VK_NULL_HANDLE;
 				}
 
 				result = createSwapchain();
@@ -2067,12 +2286,19 @@ VK_IMPORT_DEVICE
 				for (uint32_t ii = 0; ii < m_numSwapchainImages; ++ii)
 				{
 					result = vkCreateSemaphore(m_device, &sci, m_allocatorCb, &m_presentDone[ii]);
+					if (VK_SUCCESS == result)
+					{
+						result = vkCreateSemaphore(m_device, &sci, m_allocatorCb, &m_renderDone[ii]);
+					}
+
 					if (VK_SUCCESS != result)
 					{
 						BX_TRACE("Init error: vkCreateSemaphore failed %d: %s.", result, getName(result) );
 						goto error;
 					}
 				}
+
+				m_numFramesInFlight = bx::clamp<uint32_t>(m_numFramesInFlight, 1, m_numSwapchainImages);
 			}
 
 			errorState = ErrorState::SwapchainCreated;
@@ -2103,13 +2329,24 @@ VK_IMPORT_DEVICE
 				VkFenceCreateInfo fci;
 				fci.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
 				fci.pNext = NULL;
-				fci.flags = 0;
-				result = vkCreateFence(m_device, &fci, m_allocatorCb, &m_fence);
+				fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-				if (VK_SUCCESS != result)
+				for (uint32_t ii = 0; ii < BX_COUNTOF(m_fence); ++ii)
 				{
-					BX_TRACE("Init error: vkCreateFence failed %d: %s.", result, getName(result) );
-					goto error;
+					m_fence[ii] = VK_NULL_HANDLE;
+					m_fenceFrameNum[ii] = 0;
+				}
+
+				for (uint32_t ii = 0; ii < BX_COUNTOF(m_fence); ++ii)
+				{
+					result = vkCreateFence(m_device, &fci, m_allocatorCb, &m_fence[ii]);
+
+					if (VK_SUCCESS != result)
+					{
+						destroyFences();
+						BX_TRACE("Init error: vkCreateFence failed %d: %s.", result, getName(result) );
+						goto error;
+					}
 				}
 
 				VkCommandPoolCreateInfo cpci;
@@ -2121,7 +2358,7 @@ VK_IMPORT_DEVICE
 
 				if (VK_SUCCESS != result)
 				{
-					vkDestroy(m_fence);
+					destroyFences();
 					BX_TRACE("Init error: vkCreateCommandPool failed %d: %s.", result, getName(result) );
 					goto error;
 				}
@@ -2138,17 +2375,12 @@ VK_IMPORT_DEVICE
 				if (VK_SUCCESS != result)
 				{
 					vkDestroy(m_commandPool);
-					vkDestroy(m_fence);
+					destroyFences();
 					BX_TRACE("Init error: vkAllocateCommandBuffers failed %d: %s.", result, getName(result) );
 					goto error;
 				}
 
 				initSwapchainImageLayout();
-
-//				kick();
-//				finishAll();
-
-				VK_CHECK(vkResetCommandPool(m_device, m_commandPool, 0) );
 			}
 
 			errorState = ErrorState::CommandBuffersCreated;
@@ -2243,6 +2475,12 @@ VK_IMPORT_DEVICE
 				}
 			}
 
+			m_drawRecorder.m_uniforms  = m_uniforms;
+			m_drawRecorder.m_vsScratch = m_vsScratch;
+			m_drawRecorder.m_fsScratch = m_fsScratch;
+
+			initRecordThreads();
+
 			errorState = ErrorState::DescriptorCreated;
 
 			if (NULL == vkSetDebugUtilsObjectNameEXT)
@@ -2268,6 +2506,22 @@ VK_IMPORT_DEVICE
 				bx::snprintf(s_viewName[ii], BGFX_CONFIG_MAX_VIEW_NAME_RESERVED+1, "%3d   ", ii);
 			}
 
+			result = m_gpuTimer.init();
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("GPU timer is not supported %d: %s.", result, getName(result) );
+			}
+
+			result = m_occlusionQuery.init();
+			if (VK_SUCCESS == result)
+			{
+				g_caps.supported |= BGFX_CAPS_OCCLUSION_QUERY;
+			}
+			else
+			{
+				BX_TRACE("Occlusion query is not supported %d: %s.", result, getName(result) );
+			}
+
 			g_internalData.context = m_device;
 			return true;
 
@@ -2285,7 +2539,7 @@ VK_IMPORT_DEVICE
 			case ErrorState::CommandBuffersCreated:
 				vkFreeCommandBuffers(m_device, m_commandPool, BX_COUNTOF(m_commandBuffers), m_commandBuffers);
 				vkDestroy(m_commandPool);
-				vkDestroy(m_fence);
+				destroyFences();
 				BX_FALLTHROUGH;
 
 			case ErrorState::FrameBufferCreated:
@@ -2300,12 +2554,16 @@ VK_IMPORT_DEVICE
 				for (uint32_t ii = 0; ii < BX_COUNTOF(m_backBufferColorImageView); ++ii)
 				{
 					vkDestroy(m_presentDone[ii]);
+					vkDestroy(m_renderDone[ii]);
 				}
 				releaseSwapchain();
 				BX_FALLTHROUGH;
 
 			case ErrorState::SurfaceCreated:
-				vkDestroySurfaceKHR(m_instance, m_surface, m_allocatorCb);
+				if (VK_NULL_HANDLE != m_surface)
+				{
+					vkDestroySurfaceKHR(m_instance, m_surface, m_allocatorCb);
+				}
 				BX_FALLTHROUGH;
 
 			case ErrorState::DeviceCreated:
@@ -2340,11 +2598,18 @@ VK_IMPORT_DEVICE
 			VK_CHECK(vkQueueWaitIdle(m_queueGraphics) );
 			VK_CHECK(vkDeviceWaitIdle(m_device) );
 
+			captureFinish();
+
+			m_gpuTimer.shutdown();
+			m_occlusionQuery.shutdown();
+
 			m_pipelineStateCache.invalidate();
 			m_descriptorSetLayoutCache.invalidate();
 			m_renderPassCache.invalidate();
 			m_samplerCache.invalidate();
 
+			shutdownRecordThreads();
+
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_scratchBuffer); ++ii)
 			{
 				m_scratchBuffer[ii].destroy();
@@ -2375,6 +2640,11 @@ VK_IMPORT_DEVICE
 				m_textures[ii].destroy();
 			}
 
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_release); ++ii)
+			{
+				releaseFrame(ii);
+			}
+
 			vkDestroy(m_pipelineCache);
 //			vkDestroy(m_pipelineLayout);
 //			vkDestroy(m_descriptorSetLayout);
@@ -2382,16 +2652,20 @@ VK_IMPORT_DEVICE
 
 			vkFreeCommandBuffers(m_device, m_commandPool, BX_COUNTOF(m_commandBuffers), m_commandBuffers);
 			vkDestroy(m_commandPool);
-			vkDestroy(m_fence);
+			destroyFences();
 
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_backBufferColorImageView); ++ii)
 			{
 				vkDestroy(m_presentDone[ii]);
+				vkDestroy(m_renderDone[ii]);
 			}
 			releaseSwapchainFramebuffer();
 			releaseSwapchain();
 
-			vkDestroySurfaceKHR(m_instance, m_surface, m_allocatorCb);
+			if (VK_NULL_HANDLE != m_surface)
+			{
+				vkDestroySurfaceKHR(m_instance, m_surface, m_allocatorCb);
+			}
 
 			vkDestroy(m_renderPass);
 
@@ -2427,13 +2701,16 @@ VK_IMPORT_DEVICE
 
 		void flip() override
 		{
-			if (VK_NULL_HANDLE != m_swapchain)
+			if (VK_NULL_HANDLE != m_swapchain
+			&&  m_needPresent)
 			{
+				m_needPresent = false;
+
 				VkPresentInfoKHR pi;
 				pi.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 				pi.pNext = NULL;
-				pi.waitSemaphoreCount = 0;
-				pi.pWaitSemaphores    = NULL;
+				pi.waitSemaphoreCount = 1;
+				pi.pWaitSemaphores    = &m_renderDone[m_frameIdx];
 				pi.swapchainCount = 1;
 				pi.pSwapchains    = &m_swapchain;
 				pi.pImageIndices  = &m_backBufferColorIdx;
@@ -2485,8 +2762,7 @@ VK_IMPORT_DEVICE
 
 		void updateDynamicIndexBuffer(IndexBufferHandle _handle, uint32_t _offset, uint32_t _size, const Memory* _mem) override
 		{
-//			BX_UNUSED(_handle, _offset, _size, _mem);
-			m_indexBuffers[_handle.idx].update(/*m_commandBuffer*/NULL, _offset, bx::min<uint32_t>(_size, _mem->size), _mem->data);
+			m_indexBuffers[_handle.idx].update(beginFrame(), _offset, bx::min<uint32_t>(_size, _mem->size), _mem->data);
 		}
 
 		void destroyDynamicIndexBuffer(IndexBufferHandle _handle) override
@@ -2502,8 +2778,7 @@ VK_IMPORT_DEVICE
 
 		void updateDynamicVertexBuffer(VertexBufferHandle _handle, uint32_t _offset, uint32_t _size, const Memory* _mem) override
 		{
-//			BX_UNUSED(_handle, _offset, _size, _mem);
-			m_vertexBuffers[_handle.idx].update(/*m_commandBuffer*/NULL, _offset, bx::min<uint32_t>(_size, _mem->size), _mem->data);
+			m_vertexBuffers[_handle.idx].update(beginFrame(), _offset, bx::min<uint32_t>(_size, _mem->size), _mem->data);
 		}
 
 		void destroyDynamicVertexBuffer(VertexBufferHandle _handle) override
@@ -2542,7 +2817,7 @@ VK_IMPORT_DEVICE
 
 		void updateTexture(TextureHandle _handle, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem) override
 		{
-			m_textures[_handle.idx].update(m_commandPool, _side, _mip, _rect, _z, _depth, _pitch, _mem);
+			m_textures[_handle.idx].update(beginFrame(), _side, _mip, _rect, _z, _depth, _pitch, _mem);
 		}
 
 		void updateTextureEnd() override
@@ -2553,6 +2828,14 @@ VK_IMPORT_DEVICE
 		{
 		}
 
+		void setTextureResidentMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			// Clamped with sampler minLod. Samplers are cached per resident mip, and descriptor sets
+			// are written every draw, so clamp takes effect from next frame.
+			TextureVK& texture = m_textures[_handle.idx];
+			texture.m_residentMip = bx::min<uint8_t>(_mip, texture.m_numMips-1);
+		}
+
 		void resizeTexture(TextureHandle /*_handle*/, uint16_t /*_width*/, uint16_t /*_height*/, uint8_t /*_numMips*/, uint16_t /*_numLayers*/) override
 		{
 		}
@@ -2596,6 +2879,7 @@ VK_IMPORT_DEVICE
 			void* data = BX_ALLOC(g_allocator, size);
 			bx::memSet(data, 0, size);
 			m_uniforms[_handle.idx] = data;
+			m_uniformSize[_handle.idx] = size;
 			m_uniformReg.add(_handle, _name);
 		}
 
@@ -2603,10 +2887,123 @@ VK_IMPORT_DEVICE
 		{
 			BX_FREE(g_allocator, m_uniforms[_handle.idx]);
 			m_uniforms[_handle.idx] = NULL;
+			m_uniformSize[_handle.idx] = 0;
 		}
 
-		void requestScreenShot(FrameBufferHandle /*_handle*/, const char* /*_filePath*/) override
+		void requestScreenShot(FrameBufferHandle _handle, const char* _filePath) override
 		{
+			TextureVK* texture = NULL;
+			VkImage  image;
+			VkFormat format;
+			uint32_t width;
+			uint32_t height;
+
+			if (isValid(_handle) )
+			{
+				const FrameBufferVK& frameBuffer = m_frameBuffers[_handle.idx];
+
+				if (!isValid(frameBuffer.m_texture[0]) )
+				{
+					BX_TRACE("Unable to capture screenshot %s, frame buffer doesn't have color attachment.", _filePath);
+					return;
+				}
+
+				texture = &m_textures[frameBuffer.m_texture[0].idx];
+				image   = texture->m_textureImage;
+				format  = texture->m_format;
+				width   = texture->m_width;
+				height  = texture->m_height;
+			}
+			else
+			{
+				if (0 == (m_sci.imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) )
+				{
+					BX_TRACE("Unable to capture screenshot %s, swapchain images can't be used as transfer source.", _filePath);
+					return;
+				}
+
+				image  = m_backBufferColorImage[m_backBufferColorIdx];
+				format = m_sci.imageFormat;
+				width  = m_sci.imageExtent.width;
+				height = m_sci.imageExtent.height;
+			}
+
+			if (!isRgba8(format)
+			&&  !isBgra8(format) )
+			{
+				BX_TRACE("Unable to capture screenshot %s, unsupported format %d.", _filePath, format);
+				return;
+			}
+
+			const uint32_t pitch = width*4;
+			const uint32_t size  = pitch*height;
+
+			VkBuffer buffer;
+			VkDeviceMemory memory;
+			VK_CHECK(createReadbackBuffer(size, buffer, memory) );
+
+			VkCommandBuffer commandBuffer = beginNewCommand();
+
+			VkImageLayout oldLayout;
+			if (NULL != texture)
+			{
+				oldLayout = texture->m_currentImageLayout;
+				texture->setImageMemoryBarrier(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+			}
+			else
+			{
+				oldLayout = m_backBufferColorImageLayout[m_backBufferColorIdx];
+				setImageMemoryBarrier(commandBuffer
+					, image
+					, VK_IMAGE_ASPECT_COLOR_BIT
+					, oldLayout
+					, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+					, 1, 1);
+				m_backBufferColorImageLayout[m_backBufferColorIdx] = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+			}
+
+			readbackImage(commandBuffer, image, width, height, buffer);
+
+			if (VK_IMAGE_LAYOUT_UNDEFINED != oldLayout)
+			{
+				if (NULL != texture)
+				{
+					texture->setImageMemoryBarrier(commandBuffer, oldLayout);
+				}
+				else
+				{
+					setImageMemoryBarrier(commandBuffer
+						, image
+						, VK_IMAGE_ASPECT_COLOR_BIT
+						, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+						, oldLayout
+						, 1, 1);
+					m_backBufferColorImageLayout[m_backBufferColorIdx] = oldLayout;
+				}
+			}
+
+			submitCommandAndWait(commandBuffer);
+
+			void* data;
+			VK_CHECK(vkMapMemory(m_device, memory, 0, size, 0, &data) );
+
+			if (isRgba8(format) )
+			{
+				bimg::imageSwizzleBgra8(data, pitch, width, height, data, pitch);
+			}
+
+			g_callback->screenShot(_filePath
+				, width
+				, height
+				, pitch
+				, data
+				, size
+				, false
+				);
+
+			vkUnmapMemory(m_device, memory);
+			vkFreeMemory(m_device, memory, m_allocatorCb);
+			vkDestroy(buffer);
 		}
 
 		void updateViewName(ViewId _id, const char* _name) override
@@ -2624,7 +3021,7 @@ VK_IMPORT_DEVICE
 
 		void invalidateOcclusionQuery(OcclusionQueryHandle _handle) override
 		{
-			BX_UNUSED(_handle);
+			m_occlusionQuery.invalidate(_handle);
 		}
 
 		void setMarker(const char* _marker, uint16_t _len) override
@@ -2673,6 +3070,10 @@ VK_IMPORT_DEVICE
 
 		void submitBlit(BlitState& _bs, uint16_t _view);
 
+		void recordDraw(RecorderVK& _rec, Frame* _render, const SortKey& _key, const RenderItem& _renderItem, const RenderBind& _renderBind);
+
+		static int32_t recordThread(bx::Thread* _self, void* _userData);
+
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
 
 		void blitSetup(TextVideoMemBlitter& _blitter) override
@@ -2725,9 +3126,9 @@ VK_IMPORT_DEVICE
 			UniformBuffer* vcb = program.m_vsh->m_constantBuffer;
 			if (NULL != vcb)
 			{
-				commit(*vcb);
+				m_drawRecorder.commit(*vcb);
 			}
-			ScratchBufferVK& scratchBuffer = m_scratchBuffer[m_backBufferColorIdx];
+			ScratchBufferVK& scratchBuffer = m_scratchBuffer[m_frameIdx];
 			VkDescriptorSetLayout dsl = m_descriptorSetLayoutCache.find(program.m_descriptorSetLayoutHash);
 			VkDescriptorSetAllocateInfo dsai;
 			dsai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
@@ -2740,7 +3141,7 @@ VK_IMPORT_DEVICE
 			const uint32_t align = uint32_t(m_deviceProperties.limits.minUniformBufferOffsetAlignment);
 			TextureVK& texture = m_textures[_blitter.m_texture.idx];
 			uint32_t samplerFlags = (uint32_t)(texture.m_flags & BGFX_SAMPLER_BITS_MASK);
-			VkSampler sampler = getSampler(samplerFlags, 1);
+			VkSampler sampler = getSampler(samplerFlags, 1, 0);
 
 			const uint32_t size = bx::strideAlign(program.m_vsh->m_size, align);
 			uint32_t bufferOffset = scratchBuffer.m_pos;
@@ -2826,8 +3227,9 @@ VK_IMPORT_DEVICE
 			const uint32_t numVertices = _numIndices*4/6;
 			if (0 < numVertices)
 			{
-				m_indexBuffers[_blitter.m_ib->handle.idx].update(m_commandBuffer, 0, _numIndices*2, _blitter.m_ib->data);
-				m_vertexBuffers[_blitter.m_vb->handle.idx].update(m_commandBuffer, 0, numVertices*_blitter.m_layout.m_stride, _blitter.m_vb->data, true);
+				// Called inside render pass where copy can't be recorded.
+				m_indexBuffers[_blitter.m_ib->handle.idx].update(VK_NULL_HANDLE, 0, _numIndices*2, _blitter.m_ib->data);
+				m_vertexBuffers[_blitter.m_vb->handle.idx].update(VK_NULL_HANDLE, 0, numVertices*_blitter.m_layout.m_stride, _blitter.m_vb->data, true);
 
 				vkCmdDrawIndexed(m_commandBuffer
 					, _numIndices
@@ -2912,6 +3314,10 @@ VK_IMPORT_DEVICE
 			{
 				flags &= ~BGFX_RESET_INTERNAL_FORCE;
 
+				// Frames captured with old backbuffer size and format must be delivered
+				// before swapchain is recreated.
+				captureFlush();
+
 				const bool resize        = (m_resolution.reset & BGFX_RESET_MSAA_MASK      ) == (_resolution.reset & BGFX_RESET_MSAA_MASK      );
 				const bool formatChanged = (m_resolution.reset & BGFX_RESET_SRGB_BACKBUFFER) == (_resolution.reset & BGFX_RESET_SRGB_BACKBUFFER);
 
@@ -2938,25 +3344,36 @@ VK_IMPORT_DEVICE
 					m_sci.imageColorSpace = surfaceFormat.colorSpace;
 
 					const bool vsync = !!(flags & BGFX_RESET_VSYNC);
-					const uint32_t presentModeIdx = findPresentMode(vsync);
-					BGFX_FATAL(UINT32_MAX != presentModeIdx
-						, bgfx::Fatal::DeviceLost
-						, "Unable to find present mode."
-						);
+					const char* presentModeName = "offscreen";
+
+					if (m_headless)
+					{
+						m_sci.imageExtent.width  = bx::max<uint32_t>(m_resolution.width,  1);
+						m_sci.imageExtent.height = bx::max<uint32_t>(m_resolution.height, 1);
+					}
+					else
+					{
+						const uint32_t presentModeIdx = findPresentMode(vsync);
+						BGFX_FATAL(UINT32_MAX != presentModeIdx
+							, bgfx::Fatal::DeviceLost
+							, "Unable to find present mode."
+							);
 
-					m_sci.presentMode = s_presentMode[presentModeIdx].mode;
+						m_sci.presentMode = s_presentMode[presentModeIdx].mode;
+						presentModeName   = s_presentMode[presentModeIdx].name;
 
-					VkSurfaceCapabilitiesKHR surfaceCapabilities;
-					VK_CHECK(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_physicalDevice, m_surface, &surfaceCapabilities) );
+						VkSurfaceCapabilitiesKHR surfaceCapabilities;
+						VK_CHECK(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_physicalDevice, m_surface, &surfaceCapabilities) );
 
-					m_sci.imageExtent.width  = bx::clamp<uint32_t>(m_resolution.width
-						, surfaceCapabilities.minImageExtent.width
-						, surfaceCapabilities.maxImageExtent.width
-						);
-					m_sci.imageExtent.height = bx::clamp<uint32_t>(m_resolution.height
-						, surfaceCapabilities.minImageExtent.height
-						, surfaceCapabilities.maxImageExtent.height
-						);
+						m_sci.imageExtent.width  = bx::clamp<uint32_t>(m_resolution.width
+							, surfaceCapabilities.minImageExtent.width
+							, surfaceCapabilities.maxImageExtent.width
+							);
+						m_sci.imageExtent.height = bx::clamp<uint32_t>(m_resolution.height
+							, surfaceCapabilities.minImageExtent.height
+							, surfaceCapabilities.maxImageExtent.height
+							);
+					}
 
 					VK_CHECK(createSwapchain() );
 					VK_CHECK(createSwapchainRenderPass() );
@@ -2964,2773 +3381,4465 @@ VK_IMPORT_DEVICE
 					initSwapchainImageLayout();
 
 					BX_TRACE("Swapchain (%s): %dx%d%s"
-						, s_presentMode[presentModeIdx].name
+						, presentModeName
 						, m_sci.imageExtent.width
 						, m_sci.imageExtent.height
 						, vsync ? " + vsync" : ""
 						);
 				}
+
+				updateCapture();
 			}
 		}
 
-		void setShaderUniform(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
+		void updateCapture()
 		{
-			if (_flags & kUniformFragmentBit)
+			BX_WARN(0 == (m_resolution.reset&BGFX_RESET_CAPTURE)
+				|| 0 != (m_sci.imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+				, "Capture is not supported, swapchain images can't be used as transfer source."
+				);
+
+			// Capture started with previous backbuffer size is ended before new one begins,
+			// so that captureBegin and captureEnd callbacks are always paired.
+			captureFinish();
+
+			if (m_resolution.reset&BGFX_RESET_CAPTURE
+			&&  0 != (m_sci.imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) )
 			{
-				bx::memCopy(&m_fsScratch[_regIndex], _val, _numRegs*16);
+				const uint32_t width  = m_sci.imageExtent.width;
+				const uint32_t height = m_sci.imageExtent.height;
+				m_captureSize = width*height*4;
+
+				// Each frame slot reads back into its own buffer, and frame is delivered
+				// when slot is reused.
+				for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+				{
+					VK_CHECK(createReadbackBuffer(m_captureSize, m_captureBuffer[ii], m_captureMemory[ii]) );
+				}
+
+				g_callback->captureBegin(width, height, width*4, TextureFormat::BGRA8, false);
 			}
-			else
+		}
+
+		void captureFrame(uint32_t _frameIdx)
+		{
+			if (m_capturePending[_frameIdx])
 			{
-				bx::memCopy(&m_vsScratch[_regIndex], _val, _numRegs*16);
+				m_capturePending[_frameIdx] = false;
+
+				void* data;
+				VK_CHECK(vkMapMemory(m_device, m_captureMemory[_frameIdx], 0, m_captureSize, 0, &data) );
+
+				if (isRgba8(m_sci.imageFormat) )
+				{
+					bimg::imageSwizzleBgra8(
+						  data
+						, m_sci.imageExtent.width*4
+						, m_sci.imageExtent.width
+						, m_sci.imageExtent.height
+						, data
+						, m_sci.imageExtent.width*4
+						);
+				}
+
+				g_callback->captureFrame(data, m_captureSize);
+
+				vkUnmapMemory(m_device, m_captureMemory[_frameIdx]);
 			}
 		}
 
-		void setShaderUniform4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
+		// Delivers captured frames still in flight, oldest first.
+		void captureFlush()
 		{
-			setShaderUniform(_flags, _regIndex, _val, _numRegs);
+			for (uint32_t ii = 1; ii <= m_numFramesInFlight; ++ii)
+			{
+				const uint32_t frameIdx = (m_frameIdx + ii) % m_numFramesInFlight;
+
+				if (m_capturePending[frameIdx])
+				{
+					VK_CHECK(vkWaitForFences(m_device, 1, &m_fence[frameIdx], VK_TRUE, UINT64_MAX) );
+					captureFrame(frameIdx);
+				}
+			}
 		}
 
-		void setShaderUniform4x4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
+		void captureFinish()
 		{
-			setShaderUniform(_flags, _regIndex, _val, _numRegs);
+			captureFlush();
+
+			if (0 != m_captureSize)
+			{
+				g_callback->captureEnd();
+				m_captureSize = 0;
+			}
+
+			releaseCaptureBuffers();
 		}
 
-//		void commitShaderUniforms(VkCommandBuffer _commandBuffer, ProgramHandle _program)
-//		{
-//			ProgramVK& program = m_program[_program.idx];
-//
-//			const uint32_t align = uint32_t(m_deviceProperties.limits.minUniformBufferOffsetAlignment);
-//			const uint32_t vsize = bx::strideAlign(program.m_vsh->m_size, align);
-//			const uint32_t fsize = bx::strideAlign( (NULL != program.m_fsh ? program.m_fsh->m_size : 0), align);
-//			const uint32_t total = vsize + fsize;
-//
-//			if (0 < total)
-//			{
-//				ScratchBufferVK& sb = m_scratchBuffer[m_backBufferColorIdx];
-//
-//				uint8_t* data = (uint8_t*)sb.allocUbv(vsize, fsize);
-//
-//				bx::memCopy(data, m_vsScratch, program.m_vsh->m_size);
-//				data += vsize;
-//
-//				if (0 != fsize)
-//				{
-//					bx::memCopy(data, m_fsScratch, program.m_fsh->m_size);
-//				}
-//
-//				vkCmdBindDescriptorSets(_commandBuffer
-//					, VK_PIPELINE_BIND_POINT_GRAPHICS
-//					, m_pipelineLayout
-//					, program.m_pipelineLayout
-//					, 0
-//					, 1
-//					, &sb.m_descriptorSet[sb.m_currentDs - 1]
-//					, 0
-//					, NULL
-//					);
-//			}
-//		}
+		void releaseCaptureBuffers()
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_captureBuffer); ++ii)
+			{
+				vkDestroy(m_captureBuffer[ii]);
+				vkFreeMemory(m_device, m_captureMemory[ii], m_allocatorCb);
+				m_captureMemory[ii] = VK_NULL_HANDLE;
+			}
+		}
 
-		void setFrameBuffer(FrameBufferHandle _fbh, bool _msaa = true)
+		// Record threads and render thread each own command pool and descriptor pool per frame
+		// slot. Slot 0 is used by render thread, which records its share of chunks while record
+		// threads are busy.
+		void initRecordThreads()
 		{
-			BX_UNUSED(_msaa);
+			bx::memSet(m_recordThread, 0, sizeof(m_recordThread) );
+			m_numRecordThreads = 0;
+			m_recordExit = false;
 
-			if (isValid(m_fbh)
-			&&  m_fbh.idx != _fbh.idx)
+#if BX_CONFIG_SUPPORTS_THREADING
+			if (0 == BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS)
 			{
-				const FrameBufferVK& frameBuffer = m_frameBuffers[m_fbh.idx];
-				BX_UNUSED(frameBuffer);
+				return;
+			}
 
-				for (uint8_t ii = 0, num = frameBuffer.m_num; ii < num; ++ii)
-				{
-					TextureVK& texture = m_textures[frameBuffer.m_texture[ii].idx];
-					texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-				}
+			VkDescriptorPoolSize dps[] =
+			{
+				{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 10 },
+				{ VK_DESCRIPTOR_TYPE_SAMPLER,                BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 10 },
+				{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 2<<10                                  },
+				{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 8  },
+				{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 8  },
+			};
 
-				if (isValid(frameBuffer.m_depth) )
+			VkDescriptorPoolCreateInfo dpci;
+			dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			dpci.pNext = NULL;
+			dpci.flags = 0;
+			dpci.maxSets       = 1<<10;
+			dpci.poolSizeCount = BX_COUNTOF(dps);
+			dpci.pPoolSizes    = dps;
+
+			VkCommandPoolCreateInfo cpci;
+			cpci.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+			cpci.pNext = NULL;
+			cpci.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+			cpci.queueFamilyIndex = m_qfiGraphics;
+
+			VkResult result = VK_SUCCESS;
+
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_recordThread); ++ii)
+			{
+				RecordThread* rt = BX_NEW(g_allocator, RecordThread);
+				m_recordThread[ii] = rt;
+
+				for (uint32_t jj = 0; jj < NUM_SWAPCHAIN_IMAGE; ++jj)
 				{
-					TextureVK& texture = m_textures[frameBuffer.m_depth.idx];
-					const bool writeOnly  = 0 != (texture.m_flags&BGFX_TEXTURE_RT_WRITE_ONLY);
-					if (!writeOnly)
+					rt->m_commandPool[jj]    = VK_NULL_HANDLE;
+					rt->m_descriptorPool[jj] = VK_NULL_HANDLE;
+
+					if (VK_SUCCESS == result)
 					{
-						texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+						result = vkCreateCommandPool(m_device, &cpci, m_allocatorCb, &rt->m_commandPool[jj]);
+					}
+
+					if (VK_SUCCESS == result)
+					{
+						result = vkCreateDescriptorPool(m_device, &dpci, m_allocatorCb, &rt->m_descriptorPool[jj]);
 					}
 				}
+
+				rt->m_numCommandBuffers = 0;
+				bx::memSet(rt->m_uniformCopy, 0, sizeof(rt->m_uniformCopy) );
+				bx::memSet(rt->m_uniformCopySize, 0, sizeof(rt->m_uniformCopySize) );
+
+				RecorderVK& rec = rt->m_recorder;
+				rec.m_viewState       = &rt->m_viewState;
+				rec.m_uniforms        = rt->m_uniforms;
+				rec.m_uniformCopy     = rt->m_uniformCopy;
+				rec.m_uniformCopySize = rt->m_uniformCopySize;
+				rec.m_vsScratch       = rt->m_vsScratch;
+				rec.m_fsScratch       = rt->m_fsScratch;
+				rec.m_parallel        = true;
 			}
 
-			if (!isValid(_fbh) )
+			if (VK_SUCCESS != result)
 			{
-//				m_rtvHandle = m_rtvDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
-//				uint32_t rtvDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
-//				m_rtvHandle.ptr += m_backBufferColorIdx * rtvDescriptorSize;
-//				m_dsvHandle = m_dsvDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
-//
-//				m_currentColor        = &m_rtvHandle;
-//				m_currentDepthStencil = &m_dsvHandle;
-//				m_commandList->OMSetRenderTargets(1, m_currentColor, true, m_currentDepthStencil);
+				BX_TRACE("Failed to create record thread pools %d: %s.", result, getName(result) );
+				shutdownRecordThreads();
+				return;
 			}
-			else
+
+			m_numRecordThreads = BX_COUNTOF(m_recordThread);
+
+			for (uint32_t ii = 1; ii < m_numRecordThreads; ++ii)
 			{
-				const FrameBufferVK& frameBuffer = m_frameBuffers[_fbh.idx];
-				BX_UNUSED(frameBuffer);
+				m_recordThread[ii]->m_thread.init(recordThread, m_recordThread[ii], 0, "bgfx - Vulkan record thread");
+			}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+		}
 
-				if (0 < frameBuffer.m_num)
-				{
-//					D3D12_CPU_DESCRIPTOR_HANDLE rtvDescriptor = m_rtvDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
-//					uint32_t rtvDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
-//					m_rtvHandle.ptr = rtvDescriptor.ptr + (BX_COUNTOF(m_backBufferColor) + _fbh.idx * BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS) * rtvDescriptorSize;
-//					m_currentColor  = &m_rtvHandle;
-				}
-				else
-				{
-//					m_currentColor = NULL;
-				}
+		void shutdownRecordThreads()
+		{
+#if BX_CONFIG_SUPPORTS_THREADING
+			m_recordExit = true;
 
-				if (isValid(frameBuffer.m_depth) )
-				{
-//					D3D12_CPU_DESCRIPTOR_HANDLE dsvDescriptor = m_dsvDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
-//					uint32_t dsvDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
-//					m_dsvHandle.ptr = dsvDescriptor.ptr + (1 + _fbh.idx) * dsvDescriptorSize;
-//					m_currentDepthStencil = &m_dsvHandle;
-				}
-				else
+			for (uint32_t ii = 1; ii < m_numRecordThreads; ++ii)
+			{
+				m_recordThread[ii]->m_start.post();
+				m_recordThread[ii]->m_thread.shutdown();
+			}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_recordThread); ++ii)
+			{
+				RecordThread* rt = m_recordThread[ii];
+
+				if (NULL == rt)
 				{
-//					m_currentDepthStencil = NULL;
+					continue;
 				}
 
-				for (uint8_t ii = 0, num = frameBuffer.m_num; ii < num; ++ii)
+				for (uint32_t jj = 0; jj < NUM_SWAPCHAIN_IMAGE; ++jj)
 				{
-					TextureVK& texture = m_textures[frameBuffer.m_texture[ii].idx];
-					texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+					vkDestroy(rt->m_commandPool[jj]);
+					vkDestroy(rt->m_descriptorPool[jj]);
 				}
 
-				if (isValid(frameBuffer.m_depth) )
+				for (uint32_t jj = 0; jj < BX_COUNTOF(rt->m_uniformCopy); ++jj)
 				{
-					TextureVK& texture = m_textures[frameBuffer.m_depth.idx];
-					texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+					BX_FREE(g_allocator, rt->m_uniformCopy[jj]);
 				}
 
-//				m_commandList->OMSetRenderTargets(frameBuffer.m_num
-//												, m_currentColor
-//												, true
-//												, m_currentDepthStencil
-//												);
+				BX_DELETE(g_allocator, rt);
+				m_recordThread[ii] = NULL;
 			}
 
-			m_fbh = _fbh;
-//			m_rtMsaa = _msaa;
+			m_numRecordThreads = 0;
 		}
 
-		void setBlendState(VkPipelineColorBlendStateCreateInfo& _desc, uint64_t _state, uint32_t _rgba = 0)
+		// Called once frame slot is free, command buffers and descriptor sets recorded into
+		// it last time are not used by GPU anymore.
+		void beginRecordFrame()
 		{
-			VkPipelineColorBlendAttachmentState* bas = const_cast<VkPipelineColorBlendAttachmentState*>(_desc.pAttachments);
+			m_drawRecorder.resetStats();
 
-			uint8_t writeMask = 0;
-			writeMask |= (_state & BGFX_STATE_WRITE_R) ? VK_COLOR_COMPONENT_R_BIT : 0;
-			writeMask |= (_state & BGFX_STATE_WRITE_G) ? VK_COLOR_COMPONENT_G_BIT : 0;
-			writeMask |= (_state & BGFX_STATE_WRITE_B) ? VK_COLOR_COMPONENT_B_BIT : 0;
-			writeMask |= (_state & BGFX_STATE_WRITE_A) ? VK_COLOR_COMPONENT_A_BIT : 0;
+			for (uint32_t ii = 0; ii < m_numRecordThreads; ++ii)
+			{
+				RecordThread& rt = *m_recordThread[ii];
+				VK_CHECK(vkResetCommandPool(m_device, rt.m_commandPool[m_frameIdx], 0) );
+				VK_CHECK(vkResetDescriptorPool(m_device, rt.m_descriptorPool[m_frameIdx], 0) );
+				rt.m_numCommandBuffers = 0;
+				rt.m_recorder.resetStats();
+			}
+		}
 
-			bas->blendEnable = !!(BGFX_STATE_BLEND_MASK & _state);
+		// Merged after each parallel view, so that per view stats see primitives recorded by
+		// worker threads.
+		void mergeRecordStats()
+		{
+			RecorderVK& dst = m_drawRecorder;
 
+			for (uint32_t ii = 0; ii < m_numRecordThreads; ++ii)
 			{
-				const uint32_t blend    = uint32_t( (_state & BGFX_STATE_BLEND_MASK         ) >> BGFX_STATE_BLEND_SHIFT);
-				const uint32_t equation = uint32_t( (_state & BGFX_STATE_BLEND_EQUATION_MASK) >> BGFX_STATE_BLEND_EQUATION_SHIFT);
-
-				const uint32_t srcRGB = (blend      ) & 0xf;
-				const uint32_t dstRGB = (blend >>  4) & 0xf;
-				const uint32_t srcA   = (blend >>  8) & 0xf;
-				const uint32_t dstA   = (blend >> 12) & 0xf;
-
-				const uint32_t equRGB = (equation     ) & 0x7;
-				const uint32_t equA   = (equation >> 3) & 0x7;
-
-				bas->srcColorBlendFactor = s_blendFactor[srcRGB][0];
-				bas->dstColorBlendFactor = s_blendFactor[dstRGB][0];
-				bas->colorBlendOp        = s_blendEquation[equRGB];
+				RecorderVK& src = m_recordThread[ii]->m_recorder;
 
-				bas->srcAlphaBlendFactor = s_blendFactor[srcA][1];
-				bas->dstAlphaBlendFactor = s_blendFactor[dstA][1];
-				bas->alphaBlendOp        = s_blendEquation[equA];
+				for (uint32_t jj = 0; jj < BX_COUNTOF(src.m_numPrimsSubmitted); ++jj)
+				{
+					dst.m_numPrimsSubmitted[jj] += src.m_numPrimsSubmitted[jj];
+					dst.m_numPrimsRendered[jj]  += src.m_numPrimsRendered[jj];
+					dst.m_numInstances[jj]      += src.m_numInstances[jj];
+				}
 
-				bas->colorWriteMask = writeMask;
+				dst.m_numIndices += src.m_numIndices;
+				src.resetStats();
 			}
+		}
 
-			uint32_t numAttachments = 1;
-			if (isValid(m_fbh) )
+		// Returns end of view starting at _begin, if view is recorded in parallel, or _begin
+		// otherwise. Views with compute or occlusion queries are recorded on render thread,
+		// since they must be recorded in submission order.
+		uint32_t findParallelView(Frame* _render, uint32_t _begin)
+		{
+			if (2 > m_numRecordThreads)
 			{
-				const FrameBufferVK& frameBuffer = m_frameBuffers[m_fbh.idx];
-				numAttachments = frameBuffer.m_num;
+				return _begin;
 			}
 
-			if (!!(BGFX_STATE_BLEND_INDEPENDENT & _state) && m_deviceFeatures.independentBlend )
-			{
-				for (uint32_t ii = 1, rgba = _rgba; ii < numAttachments; ++ii, rgba >>= 11)
-				{
-					++bas;
-					bas->blendEnable =  0 != (rgba & 0x7ff);
+			SortKey key;
+			key.decode(_render->m_sortKeys[_begin], _render->m_viewRemap);
+			const uint16_t view = key.m_view;
 
-					const uint32_t src      = (rgba     ) & 0xf;
-					const uint32_t dst      = (rgba >> 4) & 0xf;
-					const uint32_t equation = (rgba >> 8) & 0x7;
+			uint32_t end = _begin;
+			for (uint32_t numItems = _render->m_numRenderItems; end < numItems; ++end)
+			{
+				const bool isCompute = key.decode(_render->m_sortKeys[end], _render->m_viewRemap);
 
-					bas->srcColorBlendFactor = s_blendFactor[src][0];
-					bas->dstColorBlendFactor = s_blendFactor[dst][0];
-					bas->colorBlendOp        = s_blendEquation[equation];
+				if (view != key.m_view)
+				{
+					break;
+				}
 
-					bas->srcAlphaBlendFactor = s_blendFactor[src][1];
-					bas->dstAlphaBlendFactor = s_blendFactor[dst][1];
-					bas->alphaBlendOp        = s_blendEquation[equation];
+				const RenderDraw& draw = _render->m_renderItem[_render->m_sortValues[end] ].draw;
 
-					bas->colorWriteMask = writeMask;
-				}
-			}
-			else
-			{
-				for (uint32_t ii = 1; ii < numAttachments; ++ii)
+				if (isCompute
+				||  0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY) )
 				{
-					bx::memCopy(&bas[ii], bas, sizeof(VkPipelineColorBlendAttachmentState) );
+					return _begin;
 				}
 			}
 
-			_desc.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-			_desc.pNext = NULL;
-			_desc.flags = 0;
-			_desc.logicOpEnable = VK_FALSE;
-			_desc.logicOp       = VK_LOGIC_OP_CLEAR;
-			_desc.attachmentCount = numAttachments;
-			_desc.blendConstants[0] = 0.0f;
-			_desc.blendConstants[1] = 0.0f;
-			_desc.blendConstants[2] = 0.0f;
-			_desc.blendConstants[3] = 0.0f;
-		}
-
-		void setRasterizerState(VkPipelineRasterizationStateCreateInfo& _desc, uint64_t _state, bool _wireframe = false)
-		{
-			const uint32_t cull = (_state&BGFX_STATE_CULL_MASK) >> BGFX_STATE_CULL_SHIFT;
-
-			_desc.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-			_desc.pNext = NULL;
-			_desc.flags = 0;
-			_desc.depthClampEnable = m_depthClamp;
-			_desc.rasterizerDiscardEnable = VK_FALSE;
-			_desc.polygonMode = _wireframe
-				? VK_POLYGON_MODE_LINE
-				: VK_POLYGON_MODE_FILL
+			return end - _begin < 2*BGFX_CONFIG_RENDERER_VULKAN_RECORD_MIN_DRAWS
+				? _begin
+				: end
 				;
-			_desc.cullMode  = s_cullMode[cull];
-			_desc.frontFace = (_state&BGFX_STATE_FRONT_CCW) ? VK_FRONT_FACE_COUNTER_CLOCKWISE : VK_FRONT_FACE_CLOCKWISE;
-			_desc.depthBiasEnable = VK_FALSE;
-			_desc.depthBiasConstantFactor = 0.0f;
-			_desc.depthBiasClamp          = 0.0f;
-			_desc.depthBiasSlopeFactor    = 0.0f;
-			_desc.lineWidth               = 1.0f;
 		}
 
-		void setDepthStencilState(VkPipelineDepthStencilStateCreateInfo& _desc, uint64_t _state, uint64_t _stencil = 0)
+		// Layout transitions can't be recorded inside render pass instance, textures sampled by
+		// view recorded in parallel are transitioned before render pass begins.
+		void prepareBindings(Frame* _render, uint32_t _begin, uint32_t _end)
 		{
-			const uint32_t fstencil = unpackStencil(0, _stencil);
-			uint32_t func = (_state&BGFX_STATE_DEPTH_TEST_MASK)>>BGFX_STATE_DEPTH_TEST_SHIFT;
+			SortKey key;
 
-			_desc.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-			_desc.pNext = NULL;
-			_desc.flags = 0;
-			_desc.depthTestEnable  = 0 != func;
-			_desc.depthWriteEnable = !!(BGFX_STATE_WRITE_Z & _state);
-			_desc.depthCompareOp   = s_cmpFunc[func];
-			_desc.depthBoundsTestEnable = VK_FALSE;
+			for (uint32_t item = _begin; item < _end; ++item)
+			{
+				key.decode(_render->m_sortKeys[item], _render->m_viewRemap);
 
-			_desc.stencilTestEnable = 0 != _stencil;
+				const uint32_t itemIdx = _render->m_sortValues[item];
+				const RenderDraw& draw = _render->m_renderItem[itemIdx].draw;
+				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const ProgramVK& program = m_program[key.m_program.idx];
 
-			uint32_t bstencil = unpackStencil(1, _stencil);
-			uint32_t frontAndBack = bstencil != BGFX_STENCIL_NONE && bstencil != fstencil;
-			bstencil = frontAndBack ? bstencil : fstencil;
+				if (0 == draw.m_streamMask
+				||  0 == program.m_descriptorSetLayoutHash)
+				{
+					continue;
+				}
 
-			_desc.front.failOp      = s_stencilOp[(fstencil & BGFX_STENCIL_OP_FAIL_S_MASK) >> BGFX_STENCIL_OP_FAIL_S_SHIFT];
-			_desc.front.passOp      = s_stencilOp[(fstencil & BGFX_STENCIL_OP_PASS_Z_MASK) >> BGFX_STENCIL_OP_PASS_Z_SHIFT];
-			_desc.front.depthFailOp = s_stencilOp[(fstencil & BGFX_STENCIL_OP_FAIL_Z_MASK) >> BGFX_STENCIL_OP_FAIL_Z_SHIFT];
-			_desc.front.compareOp   = s_cmpFunc[(fstencil & BGFX_STENCIL_TEST_MASK) >> BGFX_STENCIL_TEST_SHIFT];
-			_desc.front.compareMask = UINT32_MAX;
-			_desc.front.writeMask   = UINT32_MAX;
-			_desc.front.reference   = 0;
+				for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+				{
+					const Binding& bind = renderBind.m_bind[stage];
 
-			_desc.back.failOp       = s_stencilOp[(bstencil & BGFX_STENCIL_OP_FAIL_S_MASK) >> BGFX_STENCIL_OP_FAIL_S_SHIFT];
-			_desc.back.passOp       = s_stencilOp[(bstencil & BGFX_STENCIL_OP_PASS_Z_MASK) >> BGFX_STENCIL_OP_PASS_Z_SHIFT];
-			_desc.back.depthFailOp  = s_stencilOp[(bstencil & BGFX_STENCIL_OP_FAIL_Z_MASK) >> BGFX_STENCIL_OP_FAIL_Z_SHIFT];
-			_desc.back.compareOp    = s_cmpFunc[(bstencil&BGFX_STENCIL_TEST_MASK) >> BGFX_STENCIL_TEST_SHIFT];
-			_desc.back.compareMask  = UINT32_MAX;
-			_desc.back.writeMask    = UINT32_MAX;
-			_desc.back.reference    = 0;
+					if (kInvalidHandle == bind.m_idx
+					|| (Binding::Image   != bind.m_type && Binding::Texture != bind.m_type)
+					|| (Binding::Texture == bind.m_type && !isValid(program.m_bindInfo[stage].uniformHandle) ) )
+					{
+						continue;
+					}
 
-			_desc.minDepthBounds = 0.0f;
-			_desc.maxDepthBounds = 1.0f;
+					TextureVK& texture = m_textures[bind.m_idx];
+
+					if (VK_IMAGE_LAYOUT_GENERAL != texture.m_currentImageLayout
+					&&  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL != texture.m_currentImageLayout)
+					{
+						texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+					}
+				}
+			}
 		}
 
-		void setInputLayout(VkPipelineVertexInputStateCreateInfo& _vertexInputState, uint8_t _numStream, const VertexLayout** _layout, const ProgramVK& _program, uint8_t _numInstanceData)
+		// Splits view into contiguous chunks, records each chunk into secondary command buffer
+		// on record threads, and executes them in order. Render thread waits for all chunks
+		// before moving to the next view.
+		void recordParallel(Frame* _render, uint16_t _view, uint32_t _begin, uint32_t _end, const VkRenderPassBeginInfo& _rpbi, const Rect& _viewScissorRect, bool _viewHasScissor, ViewState& _viewState)
 		{
-			_vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-			_vertexInputState.pNext = NULL;
-			_vertexInputState.flags = 0;
+			BGFX_PROFILER_SCOPE("bgfx/Record view in parallel", kColorDraw);
 
-			_vertexInputState.vertexBindingDescriptionCount   = 0;
-			_vertexInputState.vertexAttributeDescriptionCount = 0;
+			prepareBindings(_render, _begin, _end);
 
-			uint16_t unsettedAttr[Attrib::Count];
-			bx::memCopy(unsettedAttr, _program.m_vsh->m_attrMask, sizeof(uint16_t) * Attrib::Count);
-			for (uint8_t stream = 0; stream < _numStream; ++stream)
+			vkCmdBeginRenderPass(m_commandBuffer, &_rpbi, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+			const View& view = _render->m_view[_view];
+
+			RecordJob& job = m_recordJob;
+			job.m_render          = _render;
+			job.m_viewState       = &_viewState;
+			job.m_clear           = BGFX_CLEAR_NONE != view.m_clear.m_flags ? &view.m_clear : NULL;
+			job.m_rect            = view.m_rect;
+			job.m_viewScissorRect = _viewScissorRect;
+			job.m_viewHasScissor  = _viewHasScissor;
+			job.m_view            = _view;
+			job.m_begin           = _begin;
+			job.m_next            = 0;
+			job.m_clearRect.setIntersect(view.m_rect, _viewScissorRect);
+
+			job.m_inheritance.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+			job.m_inheritance.pNext                = NULL;
+			job.m_inheritance.renderPass           = _rpbi.renderPass;
+			job.m_inheritance.subpass              = 0;
+			job.m_inheritance.framebuffer          = _rpbi.framebuffer;
+			job.m_inheritance.occlusionQueryEnable = VK_FALSE;
+			job.m_inheritance.queryFlags           = 0;
+			job.m_inheritance.pipelineStatistics   = 0;
+
+			const uint32_t num = _end - _begin;
+			job.m_numChunks = bx::min(kMaxRecordChunks, num/BGFX_CONFIG_RENDERER_VULKAN_RECORD_MIN_DRAWS);
+
+			for (uint32_t ii = 0; ii <= job.m_numChunks; ++ii)
 			{
-				VertexLayout layout;
-				bx::memCopy(&layout, _layout[stream], sizeof(VertexLayout) );
-				const uint16_t* attrMask = _program.m_vsh->m_attrMask;
+				job.m_chunk[ii] = _begin + uint32_t(uint64_t(num)*ii/job.m_numChunks);
+			}
 
-				for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
-				{
-					uint16_t mask = attrMask[ii];
-					uint16_t attr = (layout.m_attributes[ii] & mask);
-					layout.m_attributes[ii] = attr == 0 || attr == UINT16_MAX ? UINT16_MAX : attr;
-					if (unsettedAttr[ii] && attr != UINT16_MAX)
-					{
-						unsettedAttr[ii] = 0;
-					}
-				}
+			const uint32_t numWake = bx::min(m_numRecordThreads, job.m_numChunks) - 1;
 
-				fillVertexLayout(_program.m_vsh, _vertexInputState, layout);
+			m_recordParallel = true;
+
+			for (uint32_t ii = 0; ii < numWake; ++ii)
+			{
+				m_recordThread[ii+1]->m_start.post();
 			}
 
-			for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
+			recordChunks(*m_recordThread[0]);
+
+			for (uint32_t ii = 0; ii < numWake; ++ii)
 			{
-				if (0 < unsettedAttr[ii])
-				{
-					uint32_t numAttribs  = _vertexInputState.vertexAttributeDescriptionCount;
-					VkVertexInputAttributeDescription* inputAttrib = const_cast<VkVertexInputAttributeDescription*>(_vertexInputState.pVertexAttributeDescriptions + numAttribs);
-					inputAttrib->location = _program.m_vsh->m_attrRemap[ii];
-					inputAttrib->binding  = 0;
-					inputAttrib->format = VK_FORMAT_R32G32B32_SFLOAT;
-					inputAttrib->offset = 0;
-					_vertexInputState.vertexAttributeDescriptionCount++;
-				}
+				m_recordDone.wait();
 			}
 
-			if (0 < _numInstanceData)
+			m_recordParallel = false;
+
+			mergeRecordStats();
+
+			vkCmdExecuteCommands(m_commandBuffer, job.m_numChunks, job.m_commandBuffer);
+
+			// Uniform updates were private to chunks. Apply them in order, so that views after
+			// this one see the same values as if view was recorded on render thread.
+			for (uint32_t item = _begin; item < _end; ++item)
 			{
-				fillInstanceBinding(_program.m_vsh, _vertexInputState, _numInstanceData);
+				const RenderDraw& draw = _render->m_renderItem[_render->m_sortValues[item] ].draw;
+				m_drawRecorder.updateUniforms(_render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd, false);
 			}
 		}
 
-		uint32_t getRenderPassHashkey(uint8_t _num, const Attachment* attachments)
+		void recordChunks(RecordThread& _rt)
 		{
-			if (_num == 0)
-				return 0;
-			bx::HashMurmur2A hash;
-			hash.begin(0);
-			for (uint8_t ii = 0; ii < _num; ++ii)
+			RecordJob& job = m_recordJob;
+
+			for (;;)
 			{
-				hash.add(attachments[ii].access);
-				hash.add(attachments[ii].layer);
-				hash.add(attachments[ii].mip);
-				hash.add(attachments[ii].resolve);
+				const uint32_t chunk = bx::atomicFetchAndAdd<uint32_t>(&job.m_next, 1);
 
-				TextureVK& texture = m_textures[attachments[ii].handle.idx];
-				hash.add(texture.m_textureFormat);
+				if (chunk >= job.m_numChunks)
+				{
+					break;
+				}
+
+				job.m_commandBuffer[chunk] = recordChunk(_rt, chunk);
 			}
-			return hash.end();
 		}
 
-		VkRenderPass getRenderPass(uint8_t _num, const Attachment* _attachments)
+		VkCommandBuffer recordChunk(RecordThread& _rt, uint32_t _chunk)
 		{
-			VkRenderPass renderPass = VK_NULL_HANDLE;
-			uint32_t hashKey = getRenderPassHashkey(_num, _attachments);
-			renderPass = (VkRenderPass)m_renderPassCache.find(hashKey);
-			if (renderPass != VK_NULL_HANDLE)
-				return renderPass;
+			const RecordJob& job = m_recordJob;
+			Frame* render = job.m_render;
 
-			// cache missed
-			VkAttachmentDescription ad[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
-			VkAttachmentReference colorAr[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
-			VkAttachmentReference resolveAr[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
-			VkAttachmentReference depthAr;
-			uint32_t numColorAr = 0;
-
-			depthAr.attachment   = VK_ATTACHMENT_UNUSED;
-			depthAr.layout		 = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+			stl::vector<VkCommandBuffer>& commandBuffers = _rt.m_commandBuffers[m_frameIdx];
 
-			for (uint8_t ii = 0; ii < _num; ++ii)
+			if (_rt.m_numCommandBuffers == uint32_t(commandBuffers.size() ) )
 			{
-				TextureVK& texture = m_textures[_attachments[ii].handle.idx];
-				ad[ii].flags          = 0;
-				ad[ii].format         = texture.m_format;
-				ad[ii].samples        = VK_SAMPLE_COUNT_1_BIT;
-
-				if (texture.m_aspectMask & VK_IMAGE_ASPECT_COLOR_BIT)
-				{
-					ad[ii].loadOp                  = VK_ATTACHMENT_LOAD_OP_LOAD;
-					ad[ii].storeOp                 = VK_ATTACHMENT_STORE_OP_STORE;
-					ad[ii].stencilLoadOp           = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-					ad[ii].stencilStoreOp          = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-					ad[ii].initialLayout           = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-					ad[ii].finalLayout             = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-					colorAr[numColorAr].layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-					colorAr[numColorAr].attachment = ii;
-					numColorAr++;
-				}
-				else if (texture.m_aspectMask & VK_IMAGE_ASPECT_DEPTH_BIT)
-				{
-					ad[ii].loadOp         = VK_ATTACHMENT_LOAD_OP_LOAD;
-					ad[ii].storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
-					ad[ii].stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_LOAD;
-					ad[ii].stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE;
-					ad[ii].initialLayout  = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-					ad[ii].finalLayout    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-					depthAr.layout        = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-					depthAr.attachment    = ii;
-				}
+				VkCommandBufferAllocateInfo cbai;
+				cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+				cbai.pNext = NULL;
+				cbai.commandPool = _rt.m_commandPool[m_frameIdx];
+				cbai.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+				cbai.commandBufferCount = 1;
 
-				resolveAr[ii].attachment = VK_ATTACHMENT_UNUSED;
-				resolveAr[ii].layout     = ad[ii].initialLayout;
+				VkCommandBuffer commandBuffer;
+				VK_CHECK(vkAllocateCommandBuffers(m_device, &cbai, &commandBuffer) );
+				commandBuffers.push_back(commandBuffer);
 			}
 
-			VkSubpassDescription sd[1];
-			sd[0].flags                   = 0;
-			sd[0].pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
-			sd[0].inputAttachmentCount    = 0;
-			sd[0].pInputAttachments       = NULL;
-			sd[0].colorAttachmentCount    = numColorAr;
-			sd[0].pColorAttachments       = colorAr;
-			sd[0].pResolveAttachments     = resolveAr;
-			sd[0].pDepthStencilAttachment = &depthAr;
-			sd[0].preserveAttachmentCount = 0;
-			sd[0].pPreserveAttachments    = NULL;
+			VkCommandBuffer commandBuffer = commandBuffers[_rt.m_numCommandBuffers++];
 
-			VkRenderPassCreateInfo rpi;
-			rpi.sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-			rpi.pNext           = NULL;
-			rpi.flags           = 0;
-			rpi.attachmentCount = _num;
-			rpi.pAttachments    = ad;
-			rpi.subpassCount    = BX_COUNTOF(sd);
-			rpi.pSubpasses      = sd;
-			rpi.dependencyCount = 0;
-			rpi.pDependencies   = NULL;
+			VkCommandBufferBeginInfo cbbi;
+			cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			cbbi.pNext = NULL;
+			cbbi.flags = 0
+				| VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+				| VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT
+				;
+			cbbi.pInheritanceInfo = &job.m_inheritance;
+			VK_CHECK(vkBeginCommandBuffer(commandBuffer, &cbbi) );
 
-			VK_CHECK( vkCreateRenderPass(m_device, &rpi, m_allocatorCb, &renderPass) );
+			const Rect& rect = job.m_rect;
 
-			m_renderPassCache.add(hashKey, renderPass);
-			return renderPass;
-		}
+			VkViewport vp;
+			vp.x        =  float(rect.m_x);
+			vp.y        =  float(rect.m_y + rect.m_height);
+			vp.width    =  float(rect.m_width);
+			vp.height   = -float(rect.m_height);
+			vp.minDepth = 0.0f;
+			vp.maxDepth = 1.0f;
+			vkCmdSetViewport(commandBuffer, 0, 1, &vp);
 
-		VkSampler getSampler(uint32_t _samplerFlags, uint32_t _mipLevels)
-		{
-			bx::HashMurmur2A hash;
-			hash.begin();
-			hash.add(_samplerFlags);
-			hash.add(_mipLevels);
-			uint32_t hashKey = hash.end();
+			VkRect2D rc;
+			rc.offset.x      = job.m_viewScissorRect.m_x;
+			rc.offset.y      = job.m_viewScissorRect.m_y;
+			rc.extent.width  = job.m_viewScissorRect.m_width;
+			rc.extent.height = job.m_viewScissorRect.m_height;
+			vkCmdSetScissor(commandBuffer, 0, 1, &rc);
 
-			VkSampler sampler = m_samplerCache.find(hashKey);
-			if (sampler != VK_NULL_HANDLE)
+			if (0 == _chunk
+			&&  NULL != job.m_clear)
 			{
-				return sampler;
+				clearQuad(commandBuffer, job.m_clearRect, *job.m_clear, render->m_colorPalette);
 			}
 
-			const uint32_t cmpFunc = (_samplerFlags&BGFX_SAMPLER_COMPARE_MASK)>>BGFX_SAMPLER_COMPARE_SHIFT;
+			_rt.m_viewState = *job.m_viewState;
 
-			VkSamplerCreateInfo sci;
-			sci.sType            = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-			sci.pNext            = NULL;
-			sci.flags            = 0;
-			sci.magFilter        = VK_FILTER_LINEAR;
-			sci.minFilter        = VK_FILTER_LINEAR;
-			sci.mipmapMode       = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-			sci.addressModeU     = s_textureAddress[(_samplerFlags&BGFX_SAMPLER_U_MASK)>>BGFX_SAMPLER_U_SHIFT];
-			sci.addressModeV     = s_textureAddress[(_samplerFlags&BGFX_SAMPLER_V_MASK)>>BGFX_SAMPLER_V_SHIFT];
-			sci.addressModeW     = s_textureAddress[(_samplerFlags&BGFX_SAMPLER_W_MASK)>>BGFX_SAMPLER_W_SHIFT];
-			sci.mipLodBias       = 0.0f;
-			sci.anisotropyEnable = VK_FALSE;
-			sci.maxAnisotropy    = 4.0f;
-			sci.compareEnable    = 0 != cmpFunc;
-			sci.compareOp        = s_cmpFunc[cmpFunc];
-			sci.minLod           = 0.0f;
-			sci.maxLod           = (float)_mipLevels;
-			sci.borderColor      = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
-			sci.unnormalizedCoordinates = VK_FALSE;
+			RecorderVK& rec = _rt.m_recorder;
+			rec.m_scratchBuffer  = &m_scratchBuffer[m_frameIdx];
+			rec.m_descriptorPool = _rt.m_descriptorPool[m_frameIdx];
+			rec.m_descriptorSet  = VK_NULL_HANDLE;
+			rec.m_currentState.clear();
+			rec.m_currentState.m_stateFlags = BGFX_STATE_NONE;
+			rec.m_currentState.m_stencil    = packStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
+			rec.m_currentProgram     = BGFX_INVALID_HANDLE;
+			rec.m_currentBindHash    = 0;
+			rec.m_currentDslHash     = 0;
+			rec.m_hasPredefined      = false;
+			rec.m_currentPipeline    = VK_NULL_HANDLE;
+			rec.m_blendFactor        = 0;
+			rec.m_primIndex          = m_drawRecorder.m_primIndex;
+			rec.resetUniforms();
+			rec.begin(commandBuffer, job.m_view, job.m_viewScissorRect, job.m_viewHasScissor);
 
-			switch (_samplerFlags & BGFX_SAMPLER_MAG_MASK)
+			// Uniform values are sticky between draw calls, bring them to the state they have
+			// at the start of this chunk.
+			for (uint32_t item = job.m_begin, end = job.m_chunk[_chunk]; item < end; ++item)
 			{
-				case BGFX_SAMPLER_MAG_POINT:       sci.magFilter = VK_FILTER_NEAREST; break;
-				case BGFX_SAMPLER_MAG_ANISOTROPIC: sci.anisotropyEnable = VK_TRUE;    break;
+				const RenderDraw& draw = render->m_renderItem[render->m_sortValues[item] ].draw;
+				rec.updateUniforms(render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd, false);
 			}
 
-			switch (_samplerFlags & BGFX_SAMPLER_MIN_MASK)
-			{
-				case BGFX_SAMPLER_MIN_POINT:       sci.minFilter = VK_FILTER_NEAREST; break;
-				case BGFX_SAMPLER_MIN_ANISOTROPIC: sci.anisotropyEnable = VK_TRUE;    break;
-			}
+			SortKey key;
 
-			uint32_t borderColor = ( (_samplerFlags & BGFX_SAMPLER_BORDER_COLOR_MASK) >> BGFX_SAMPLER_BORDER_COLOR_SHIFT);
-			if (borderColor > 0)
+			for (uint32_t item = job.m_chunk[_chunk], end = job.m_chunk[_chunk+1]; item < end; ++item)
 			{
-				sci.borderColor = VK_BORDER_COLOR_INT_OPAQUE_WHITE;
+				key.decode(render->m_sortKeys[item], render->m_viewRemap);
+
+				const uint32_t itemIdx = render->m_sortValues[item];
+				recordDraw(rec
+					, render
+					, key
+					, render->m_renderItem[itemIdx]
+					, render->m_renderItemBind[itemIdx]
+					);
 			}
 
-			VK_CHECK(vkCreateSampler(m_device, &sci, m_allocatorCb, &sampler) );
+			VK_CHECK(vkEndCommandBuffer(commandBuffer) );
 
-			m_samplerCache.add(hashKey, sampler);
-			return sampler;
+			return commandBuffer;
 		}
 
-		VkPipeline getPipeline(ProgramHandle _program)
+		void setShaderUniform(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 		{
-			ProgramVK& program = m_program[_program.idx];
-
-			bx::HashMurmur2A murmur;
-			murmur.begin();
-			murmur.add(program.m_vsh->m_hash);
-			const uint32_t hash = murmur.end();
-
-			VkPipeline pipeline = m_pipelineStateCache.find(hash);
-
-			if (VK_NULL_HANDLE != pipeline)
+			if (_flags & kUniformFragmentBit)
 			{
-				return pipeline;
+				bx::memCopy(&m_fsScratch[_regIndex], _val, _numRegs*16);
 			}
+			else
+			{
+				bx::memCopy(&m_vsScratch[_regIndex], _val, _numRegs*16);
+			}
+		}
 
-			VkComputePipelineCreateInfo cpci;
-			cpci.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
-			cpci.pNext = NULL;
-			cpci.flags = 0;
-
-			cpci.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-			cpci.stage.pNext  = NULL;
-			cpci.stage.flags  = 0;
-			cpci.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
-			cpci.stage.module = program.m_vsh->m_module;
-			cpci.stage.pName  = "main";
-			cpci.stage.pSpecializationInfo = NULL;
-
-			cpci.layout             = program.m_pipelineLayout;
-			cpci.basePipelineHandle = VK_NULL_HANDLE;
-			cpci.basePipelineIndex  = 0;
-
-			VK_CHECK( vkCreateComputePipelines(m_device, m_pipelineCache, 1, &cpci, m_allocatorCb, &pipeline) );
-
-			m_pipelineStateCache.add(hash, pipeline);
-
-			return pipeline;
+		void setShaderUniform4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
+		{
+			setShaderUniform(_flags, _regIndex, _val, _numRegs);
 		}
 
-		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, ProgramHandle _program, uint8_t _numInstanceData)
+		void setShaderUniform4x4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 		{
-			ProgramVK& program = m_program[_program.idx];
+			setShaderUniform(_flags, _regIndex, _val, _numRegs);
+		}
 
-			_state &= 0
-				| BGFX_STATE_WRITE_RGB
-				| BGFX_STATE_WRITE_A
-				| BGFX_STATE_WRITE_Z
-				| BGFX_STATE_DEPTH_TEST_MASK
-				| BGFX_STATE_BLEND_MASK
-				| BGFX_STATE_BLEND_EQUATION_MASK
-				| BGFX_STATE_BLEND_INDEPENDENT
-				| BGFX_STATE_BLEND_ALPHA_TO_COVERAGE
-				| BGFX_STATE_CULL_MASK
-				| BGFX_STATE_MSAA
-				| BGFX_STATE_LINEAA
-				| BGFX_STATE_CONSERVATIVE_RASTER
-				| BGFX_STATE_PT_MASK
-				;
+//		void commitShaderUniforms(VkCommandBuffer _commandBuffer, ProgramHandle _program)
+//		{
+//			ProgramVK& program = m_program[_program.idx];
+//
+//			const uint32_t align = uint32_t(m_deviceProperties.limits.minUniformBufferOffsetAlignment);
+//			const uint32_t vsize = bx::strideAlign(program.m_vsh->m_size, align);
+//			const uint32_t fsize = bx::strideAlign( (NULL != program.m_fsh ? program.m_fsh->m_size : 0), align);
+//			const uint32_t total = vsize + fsize;
+//
+//			if (0 < total)
+//			{
+//				ScratchBufferVK& sb = m_scratchBuffer[m_backBufferColorIdx];
+//
+//				uint8_t* data = (uint8_t*)sb.allocUbv(vsize, fsize);
+//
+//				bx::memCopy(data, m_vsScratch, program.m_vsh->m_size);
+//				data += vsize;
+//
+//				if (0 != fsize)
+//				{
+//					bx::memCopy(data, m_fsScratch, program.m_fsh->m_size);
+//				}
+//
+//				vkCmdBindDescriptorSets(_commandBuffer
+//					, VK_PIPELINE_BIND_POINT_GRAPHICS
+//					, m_pipelineLayout
+//					, program.m_pipelineLayout
+//					, 0
+//					, 1
+//					, &sb.m_descriptorSet[sb.m_currentDs - 1]
+//					, 0
+//					, NULL
+//					);
+//			}
+//		}
 
-			_stencil &= packStencil(~BGFX_STENCIL_FUNC_REF_MASK, ~BGFX_STENCIL_FUNC_REF_MASK);
+		void setFrameBuffer(FrameBufferHandle _fbh, bool _msaa = true)
+		{
+			BX_UNUSED(_msaa);
 
-			VertexLayout layout;
-			if (0 < _numStreams)
+			if (isValid(m_fbh)
+			&&  m_fbh.idx != _fbh.idx)
 			{
-				bx::memCopy(&layout, _layouts[0], sizeof(VertexLayout) );
-				const uint16_t* attrMask = program.m_vsh->m_attrMask;
+				const FrameBufferVK& frameBuffer = m_frameBuffers[m_fbh.idx];
+				BX_UNUSED(frameBuffer);
 
-				for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
+				for (uint8_t ii = 0, num = frameBuffer.m_num; ii < num; ++ii)
 				{
-					uint16_t mask = attrMask[ii];
-					uint16_t attr = (layout.m_attributes[ii] & mask);
-					layout.m_attributes[ii] = attr == 0 ? UINT16_MAX : attr == UINT16_MAX ? 0 : attr;
+					TextureVK& texture = m_textures[frameBuffer.m_texture[ii].idx];
+					texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+				}
+
+				if (isValid(frameBuffer.m_depth) )
+				{
+					TextureVK& texture = m_textures[frameBuffer.m_depth.idx];
+					const bool writeOnly  = 0 != (texture.m_flags&BGFX_TEXTURE_RT_WRITE_ONLY);
+					if (!writeOnly)
+					{
+						texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+					}
 				}
 			}
 
-			bx::HashMurmur2A murmur;
-			murmur.begin();
-			murmur.add(_state);
-			murmur.add(_stencil);
-			murmur.add(program.m_vsh->m_hash);
-			murmur.add(program.m_vsh->m_attrMask, sizeof(program.m_vsh->m_attrMask) );
-			if (NULL != program.m_fsh)
+			if (!isValid(_fbh) )
 			{
-				murmur.add(program.m_fsh->m_hash);
+//				m_rtvHandle = m_rtvDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+//				uint32_t rtvDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+//				m_rtvHandle.ptr += m_backBufferColorIdx * rtvDescriptorSize;
+//				m_dsvHandle = m_dsvDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+//
+//				m_currentColor        = &m_rtvHandle;
+//				m_currentDepthStencil = &m_dsvHandle;
+//				m_commandList->OMSetRenderTargets(1, m_currentColor, true, m_currentDepthStencil);
 			}
-			for (uint8_t ii = 0; ii < _numStreams; ++ii)
+			else
 			{
-				murmur.add(_layouts[ii]->m_hash);
-			}
-			murmur.add(layout.m_attributes, sizeof(layout.m_attributes) );
-			murmur.add(m_fbh.idx);
-			murmur.add(_numInstanceData);
-			const uint32_t hash = murmur.end();
-
-			VkPipeline pipeline = m_pipelineStateCache.find(hash);
+				const FrameBufferVK& frameBuffer = m_frameBuffers[_fbh.idx];
+				BX_UNUSED(frameBuffer);
 
-			if (VK_NULL_HANDLE != pipeline)
-			{
-				return pipeline;
-			}
+				if (0 < frameBuffer.m_num)
+				{
+//					D3D12_CPU_DESCRIPTOR_HANDLE rtvDescriptor = m_rtvDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+//					uint32_t rtvDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+//					m_rtvHandle.ptr = rtvDescriptor.ptr + (BX_COUNTOF(m_backBufferColor) + _fbh.idx * BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS) * rtvDescriptorSize;
+//					m_currentColor  = &m_rtvHandle;
+				}
+				else
+				{
+//					m_currentColor = NULL;
+				}
 
-			VkPipelineColorBlendAttachmentState blendAttachmentState[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
-			VkPipelineColorBlendStateCreateInfo colorBlendState;
-			colorBlendState.pAttachments = blendAttachmentState;
-			setBlendState(colorBlendState, _state);
+				if (isValid(frameBuffer.m_depth) )
+				{
+//					D3D12_CPU_DESCRIPTOR_HANDLE dsvDescriptor = m_dsvDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+//					uint32_t dsvDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
+//					m_dsvHandle.ptr = dsvDescriptor.ptr + (1 + _fbh.idx) * dsvDescriptorSize;
+//					m_currentDepthStencil = &m_dsvHandle;
+				}
+				else
+				{
+//					m_currentDepthStencil = NULL;
+				}
 
-			VkPipelineInputAssemblyStateCreateInfo inputAssemblyState;
-			inputAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-			inputAssemblyState.pNext = NULL;
-			inputAssemblyState.flags = 0;
-			inputAssemblyState.topology = s_primInfo[(_state&BGFX_STATE_PT_MASK) >> BGFX_STATE_PT_SHIFT].m_topology;
-			inputAssemblyState.primitiveRestartEnable = VK_FALSE;
-
-			VkPipelineRasterizationStateCreateInfo rasterizationState;
-			setRasterizerState(rasterizationState, _state);
+				for (uint8_t ii = 0, num = frameBuffer.m_num; ii < num; ++ii)
+				{
+					TextureVK& texture = m_textures[frameBuffer.m_texture[ii].idx];
+					texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+				}
 
-			VkPipelineDepthStencilStateCreateInfo depthStencilState;
-			setDepthStencilState(depthStencilState, _state, _stencil);
+				if (isValid(frameBuffer.m_depth) )
+				{
+					TextureVK& texture = m_textures[frameBuffer.m_depth.idx];
+					texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+				}
 
-			VkVertexInputBindingDescription  inputBinding[Attrib::Count + 1 + BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT];
-			VkVertexInputAttributeDescription inputAttrib[Attrib::Count + 1 + BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT];
+//				m_commandList->OMSetRenderTargets(frameBuffer.m_num
+//												, m_currentColor
+//												, true
+//												, m_currentDepthStencil
+//												);
+			}
 
-			VkPipelineVertexInputStateCreateInfo vertexInputState;
-			vertexInputState.pVertexBindingDescriptions   = inputBinding;
-			vertexInputState.pVertexAttributeDescriptions = inputAttrib;
-			setInputLayout(vertexInputState, _numStreams, _layouts, program, _numInstanceData);
+			m_fbh = _fbh;
+//			m_rtMsaa = _msaa;
+		}
 
-			const VkDynamicState dynamicStates[] =
-			{
-				VK_DYNAMIC_STATE_VIEWPORT,
-				VK_DYNAMIC_STATE_SCISSOR,
-				VK_DYNAMIC_STATE_BLEND_CONSTANTS,
-				VK_DYNAMIC_STATE_STENCIL_REFERENCE,
-			};
+		void setBlendState(VkPipelineColorBlendStateCreateInfo& _desc, uint64_t _state, uint32_t _rgba = 0)
+		{
+			VkPipelineColorBlendAttachmentState* bas = const_cast<VkPipelineColorBlendAttachmentState*>(_desc.pAttachments);
 
-			VkPipelineDynamicStateCreateInfo dynamicState;
-			dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-			dynamicState.pNext = NULL;
-			dynamicState.flags = 0;
-			dynamicState.dynamicStateCount = BX_COUNTOF(dynamicStates);
-			dynamicState.pDynamicStates    = dynamicStates;
+			uint8_t writeMask = 0;
+			writeMask |= (_state & BGFX_STATE_WRITE_R) ? VK_COLOR_COMPONENT_R_BIT : 0;
+			writeMask |= (_state & BGFX_STATE_WRITE_G) ? VK_COLOR_COMPONENT_G_BIT : 0;
+			writeMask |= (_state & BGFX_STATE_WRITE_B) ? VK_COLOR_COMPONENT_B_BIT : 0;
+			writeMask |= (_state & BGFX_STATE_WRITE_A) ? VK_COLOR_COMPONENT_A_BIT : 0;
 
-			VkPipelineShaderStageCreateInfo shaderStages[2];
-			shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-			shaderStages[0].pNext = NULL;
-			shaderStages[0].flags = 0;
-			shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-			shaderStages[0].module = program.m_vsh->m_module;
-			shaderStages[0].pName  = "main";
-			shaderStages[0].pSpecializationInfo = NULL;
+			bas->blendEnable = !!(BGFX_STATE_BLEND_MASK & _state);
 
-			if (NULL != program.m_fsh)
 			{
-				shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-				shaderStages[1].pNext = NULL;
-				shaderStages[1].flags = 0;
-				shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-				shaderStages[1].module = program.m_fsh->m_module;
-				shaderStages[1].pName  = "main";
-				shaderStages[1].pSpecializationInfo = NULL;
-			}
+				const uint32_t blend    = uint32_t( (_state & BGFX_STATE_BLEND_MASK         ) >> BGFX_STATE_BLEND_SHIFT);
+				const uint32_t equation = uint32_t( (_state & BGFX_STATE_BLEND_EQUATION_MASK) >> BGFX_STATE_BLEND_EQUATION_SHIFT);
 
-			VkPipelineViewportStateCreateInfo viewportState;
-			viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-			viewportState.pNext = NULL;
-			viewportState.flags = 0;
-			viewportState.viewportCount = 1;
-			viewportState.pViewports    = NULL;
-			viewportState.scissorCount  = 1;
-			viewportState.pScissors     = NULL;
+				const uint32_t srcRGB = (blend      ) & 0xf;
+				const uint32_t dstRGB = (blend >>  4) & 0xf;
+				const uint32_t srcA   = (blend >>  8) & 0xf;
+				const uint32_t dstA   = (blend >> 12) & 0xf;
 
-			VkPipelineMultisampleStateCreateInfo multisampleState;
-			multisampleState.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-			multisampleState.pNext = NULL;
-			multisampleState.flags = 0;
-			multisampleState.rasterizationSamples  = VK_SAMPLE_COUNT_1_BIT;
-			multisampleState.sampleShadingEnable   = VK_FALSE;
-			multisampleState.minSampleShading      = !!(BGFX_STATE_CONSERVATIVE_RASTER & _state) ? 1.0f : 0.0f;
-			multisampleState.pSampleMask           = NULL;
-			multisampleState.alphaToCoverageEnable = !!(BGFX_STATE_BLEND_ALPHA_TO_COVERAGE & _state);
-			multisampleState.alphaToOneEnable      = VK_FALSE;
+				const uint32_t equRGB = (equation     ) & 0x7;
+				const uint32_t equA   = (equation >> 3) & 0x7;
 
-			VkGraphicsPipelineCreateInfo graphicsPipeline;
-			graphicsPipeline.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-			graphicsPipeline.pNext = NULL;
-			graphicsPipeline.flags = 0;
-			graphicsPipeline.stageCount = NULL == program.m_fsh ? 1 : 2;
-			graphicsPipeline.pStages    = shaderStages;
-			graphicsPipeline.pVertexInputState   = &vertexInputState;
-			graphicsPipeline.pInputAssemblyState = &inputAssemblyState;
-			graphicsPipeline.pTessellationState  = NULL;
-			graphicsPipeline.pViewportState      = &viewportState;
-			graphicsPipeline.pRasterizationState = &rasterizationState;
-			graphicsPipeline.pMultisampleState   = &multisampleState;
-			graphicsPipeline.pDepthStencilState  = &depthStencilState;
-			graphicsPipeline.pColorBlendState    = &colorBlendState;
-			graphicsPipeline.pDynamicState       = &dynamicState;
-//			graphicsPipeline.layout     = m_pipelineLayout;
-			graphicsPipeline.layout     = program.m_pipelineLayout;
-			graphicsPipeline.renderPass = isValid(m_fbh) ? m_frameBuffers[m_fbh.idx].m_renderPass : m_renderPass;
-			graphicsPipeline.subpass    = 0;
-			graphicsPipeline.basePipelineHandle = VK_NULL_HANDLE;
-			graphicsPipeline.basePipelineIndex  = 0;
+				bas->srcColorBlendFactor = s_blendFactor[srcRGB][0];
+				bas->dstColorBlendFactor = s_blendFactor[dstRGB][0];
+				bas->colorBlendOp        = s_blendEquation[equRGB];
 
-			uint32_t length = g_callback->cacheReadSize(hash);
-			bool cached = length > 0;
+				bas->srcAlphaBlendFactor = s_blendFactor[srcA][1];
+				bas->dstAlphaBlendFactor = s_blendFactor[dstA][1];
+				bas->alphaBlendOp        = s_blendEquation[equA];
 
-			void* cachedData = NULL;
+				bas->colorWriteMask = writeMask;
+			}
 
-			VkPipelineCacheCreateInfo pcci;
-			pcci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-			pcci.pNext = NULL;
-			pcci.flags = 0;
-			pcci.initialDataSize = 0;
-			pcci.pInitialData    = NULL;
+			uint32_t numAttachments = 1;
+			if (isValid(m_fbh) )
+			{
+				const FrameBufferVK& frameBuffer = m_frameBuffers[m_fbh.idx];
+				numAttachments = frameBuffer.m_num;
+			}
 
-			if (cached)
+			if (!!(BGFX_STATE_BLEND_INDEPENDENT & _state) && m_deviceFeatures.independentBlend )
 			{
-				cachedData = BX_ALLOC(g_allocator, length);
-				if (g_callback->cacheRead(hash, cachedData, length) )
+				for (uint32_t ii = 1, rgba = _rgba; ii < numAttachments; ++ii, rgba >>= 11)
 				{
-					BX_TRACE("Loading cached pipeline state (size %d).", length);
-					bx::MemoryReader reader(cachedData, length);
-
-					pcci.initialDataSize = (size_t)reader.remaining();
-					pcci.pInitialData    = reader.getDataPtr();
-				}
-			}
+					++bas;
+					bas->blendEnable =  0 != (rgba & 0x7ff);
 
-			VkPipelineCache cache;
-			VK_CHECK(vkCreatePipelineCache(m_device, &pcci, m_allocatorCb, &cache) );
+					const uint32_t src      = (rgba     ) & 0xf;
+					const uint32_t dst      = (rgba >> 4) & 0xf;
+					const uint32_t equation = (rgba >> 8) & 0x7;
 
-			VK_CHECK(vkCreateGraphicsPipelines(m_device
-				, cache
-				, 1
-				, &graphicsPipeline
-				, m_allocatorCb
-				, &pipeline
-				) );
-			m_pipelineStateCache.add(hash, pipeline);
+					bas->srcColorBlendFactor = s_blendFactor[src][0];
+					bas->dstColorBlendFactor = s_blendFactor[dst][0];
+					bas->colorBlendOp        = s_blendEquation[equation];
 
-			size_t dataSize;
-			VK_CHECK(vkGetPipelineCacheData(m_device, cache, &dataSize, NULL) );
+					bas->srcAlphaBlendFactor = s_blendFactor[src][1];
+					bas->dstAlphaBlendFactor = s_blendFactor[dst][1];
+					bas->alphaBlendOp        = s_blendEquation[equation];
 
-			if (0 < dataSize)
+					bas->colorWriteMask = writeMask;
+				}
+			}
+			else
 			{
-				if (length < dataSize)
+				for (uint32_t ii = 1; ii < numAttachments; ++ii)
 				{
-					cachedData = BX_REALLOC(g_allocator, cachedData, dataSize);
+					bx::memCopy(&bas[ii], bas, sizeof(VkPipelineColorBlendAttachmentState) );
 				}
-				VK_CHECK(vkGetPipelineCacheData(m_device, cache, &dataSize, cachedData) );
-				g_callback->cacheWrite(hash, cachedData, (uint32_t)dataSize);
 			}
 
-			VK_CHECK(vkMergePipelineCaches(m_device, m_pipelineCache, 1, &cache) );
-			vkDestroy(cache);
+			_desc.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+			_desc.pNext = NULL;
+			_desc.flags = 0;
+			_desc.logicOpEnable = VK_FALSE;
+			_desc.logicOp       = VK_LOGIC_OP_CLEAR;
+			_desc.attachmentCount = numAttachments;
+			_desc.blendConstants[0] = 0.0f;
+			_desc.blendConstants[1] = 0.0f;
+			_desc.blendConstants[2] = 0.0f;
+			_desc.blendConstants[3] = 0.0f;
+		}
 
-			if (NULL != cachedData)
-			{
-				BX_FREE(g_allocator, cachedData);
-			}
+		void setRasterizerState(VkPipelineRasterizationStateCreateInfo& _desc, uint64_t _state, bool _wireframe = false)
+		{
+			const uint32_t cull = (_state&BGFX_STATE_CULL_MASK) >> BGFX_STATE_CULL_SHIFT;
 
-			return pipeline;
+			_desc.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+			_desc.pNext = NULL;
+			_desc.flags = 0;
+			_desc.depthClampEnable = m_depthClamp;
+			_desc.rasterizerDiscardEnable = VK_FALSE;
+			_desc.polygonMode = _wireframe
+				? VK_POLYGON_MODE_LINE
+				: VK_POLYGON_MODE_FILL
+				;
+			_desc.cullMode  = s_cullMode[cull];
+			_desc.frontFace = (_state&BGFX_STATE_FRONT_CCW) ? VK_FRONT_FACE_COUNTER_CLOCKWISE : VK_FRONT_FACE_CLOCKWISE;
+			_desc.depthBiasEnable = VK_FALSE;
+			_desc.depthBiasConstantFactor = 0.0f;
+			_desc.depthBiasClamp          = 0.0f;
+			_desc.depthBiasSlopeFactor    = 0.0f;
+			_desc.lineWidth               = 1.0f;
 		}
 
-		void allocDescriptorSet(const ProgramVK& program, const RenderBind& renderBind, ScratchBufferVK& scratchBuffer)
+		void setDepthStencilState(VkPipelineDepthStencilStateCreateInfo& _desc, uint64_t _state, uint64_t _stencil = 0)
 		{
-			VkDescriptorSetLayout dsl = m_descriptorSetLayoutCache.find(program.m_descriptorSetLayoutHash);
-			VkDescriptorSetAllocateInfo dsai;
-			dsai.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			dsai.pNext              = NULL;
-			dsai.descriptorPool     = m_descriptorPool;
-			dsai.descriptorSetCount = 1;
-			dsai.pSetLayouts        = &dsl;
+			const uint32_t fstencil = unpackStencil(0, _stencil);
+			uint32_t func = (_state&BGFX_STATE_DEPTH_TEST_MASK)>>BGFX_STATE_DEPTH_TEST_SHIFT;
 
-			VkDescriptorSet& descriptorSet = scratchBuffer.m_descriptorSet[scratchBuffer.m_currentDs];
-			vkAllocateDescriptorSets(m_device, &dsai, &descriptorSet);
-			scratchBuffer.m_currentDs++;
+			_desc.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+			_desc.pNext = NULL;
+			_desc.flags = 0;
+			_desc.depthTestEnable  = 0 != func;
+			_desc.depthWriteEnable = !!(BGFX_STATE_WRITE_Z & _state);
+			_desc.depthCompareOp   = s_cmpFunc[func];
+			_desc.depthBoundsTestEnable = VK_FALSE;
 
-			VkDescriptorImageInfo imageInfo[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
-			VkDescriptorBufferInfo bufferInfo[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
-			const int MAX_DESCRIPTOR_SETS = 2 * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS + 2;
-			VkWriteDescriptorSet wds[MAX_DESCRIPTOR_SETS];
-			bx::memSet(wds, 0, sizeof(wds) );
-			uint32_t wdsCount    = 0;
-			uint32_t bufferCount = 0;
-			uint32_t imageCount  = 0;
+			_desc.stencilTestEnable = 0 != _stencil;
 
-			for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
-			{
-				const Binding& bind = renderBind.m_bind[stage];
-				const BindInfo& bindInfo = program.m_bindInfo[stage];
-
-				// bgfx does not seem to forbid setting a texture to a stage that a program does not use
-				if (bind.m_type == Binding::Texture
-				&& !isValid(program.m_bindInfo[stage].uniformHandle) )
-					continue;
+			uint32_t bstencil = unpackStencil(1, _stencil);
+			uint32_t frontAndBack = bstencil != BGFX_STENCIL_NONE && bstencil != fstencil;
+			bstencil = frontAndBack ? bstencil : fstencil;
 
-				if (kInvalidHandle != bind.m_idx)
-				{
-                    switch (bind.m_type)
-                    {
-                    case Binding::Image:
-					{
-						wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-						wds[wdsCount].pNext            = NULL;
-						wds[wdsCount].dstSet           = descriptorSet;
-						wds[wdsCount].dstBinding       = bindInfo.binding;
-						wds[wdsCount].dstArrayElement  = 0;
-						wds[wdsCount].descriptorCount  = 1;
-						wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-						wds[wdsCount].pImageInfo       = NULL;
-						wds[wdsCount].pBufferInfo      = NULL;
-						wds[wdsCount].pTexelBufferView = NULL;
+			_desc.front.failOp      = s_stencilOp[(fstencil & BGFX_STENCIL_OP_FAIL_S_MASK) >> BGFX_STENCIL_OP_FAIL_S_SHIFT];
+			_desc.front.passOp      = s_stencilOp[(fstencil & BGFX_STENCIL_OP_PASS_Z_MASK) >> BGFX_STENCIL_OP_PASS_Z_SHIFT];
+			_desc.front.depthFailOp = s_stencilOp[(fstencil & BGFX_STENCIL_OP_FAIL_Z_MASK) >> BGFX_STENCIL_OP_FAIL_Z_SHIFT];
+			_desc.front.compareOp   = s_cmpFunc[(fstencil & BGFX_STENCIL_TEST_MASK) >> BGFX_STENCIL_TEST_SHIFT];
+			_desc.front.compareMask = UINT32_MAX;
+			_desc.front.writeMask   = UINT32_MAX;
+			_desc.front.reference   = 0;
 
-						TextureVK& texture = m_textures[bind.m_idx];
-						VkSampler sampler = getSampler(
-							(0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & bind.m_samplerFlags)
-								? bind.m_samplerFlags
-								: (uint32_t)texture.m_flags
-							) & (BGFX_SAMPLER_BITS_MASK | BGFX_SAMPLER_BORDER_COLOR_MASK)
-							, (uint32_t)texture.m_numMips);
+			_desc.back.failOp       = s_stencilOp[(bstencil & BGFX_STENCIL_OP_FAIL_S_MASK) >> BGFX_STENCIL_OP_FAIL_S_SHIFT];
+			_desc.back.passOp       = s_stencilOp[(bstencil & BGFX_STENCIL_OP_PASS_Z_MASK) >> BGFX_STENCIL_OP_PASS_Z_SHIFT];
+			_desc.back.depthFailOp  = s_stencilOp[(bstencil & BGFX_STENCIL_OP_FAIL_Z_MASK) >> BGFX_STENCIL_OP_FAIL_Z_SHIFT];
+			_desc.back.compareOp    = s_cmpFunc[(bstencil&BGFX_STENCIL_TEST_MASK) >> BGFX_STENCIL_TEST_SHIFT];
+			_desc.back.compareMask  = UINT32_MAX;
+			_desc.back.writeMask    = UINT32_MAX;
+			_desc.back.reference    = 0;
 
-						if (VK_IMAGE_LAYOUT_GENERAL != texture.m_currentImageLayout
-						&&  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL != texture.m_currentImageLayout)
-						{
-							texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-						}
+			_desc.minDepthBounds = 0.0f;
+			_desc.maxDepthBounds = 1.0f;
+		}
 
-						imageInfo[imageCount].imageLayout = texture.m_currentImageLayout;
-						imageInfo[imageCount].imageView   = VK_NULL_HANDLE != texture.m_textureImageStorageView
-							? texture.m_textureImageStorageView
-							: texture.m_textureImageView
-							;
-						imageInfo[imageCount].sampler     = sampler;
-						wds[wdsCount].pImageInfo = &imageInfo[imageCount];
-						++imageCount;
+		void setInputLayout(VkPipelineVertexInputStateCreateInfo& _vertexInputState, uint8_t _numStream, const VertexLayout** _layout, const ProgramVK& _program, uint8_t _numInstanceData)
+		{
+			_vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+			_vertexInputState.pNext = NULL;
+			_vertexInputState.flags = 0;
 
-						++wdsCount;
-					}
-					break;
-					case Binding::VertexBuffer:
-					case Binding::IndexBuffer:
-					{
-						wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-						wds[wdsCount].pNext            = NULL;
-						wds[wdsCount].dstSet           = descriptorSet;
-						wds[wdsCount].dstBinding       = bindInfo.binding;
-						wds[wdsCount].dstArrayElement  = 0;
-						wds[wdsCount].descriptorCount  = 1;
-						wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-						wds[wdsCount].pImageInfo       = NULL;
-						wds[wdsCount].pBufferInfo      = NULL;
-						wds[wdsCount].pTexelBufferView = NULL;
+			_vertexInputState.vertexBindingDescriptionCount   = 0;
+			_vertexInputState.vertexAttributeDescriptionCount = 0;
 
-						BufferVK& sb = bind.m_type == Binding::VertexBuffer ? m_vertexBuffers[bind.m_idx] : m_indexBuffers[bind.m_idx];
-						bufferInfo[bufferCount].buffer = sb.m_buffer;
-						bufferInfo[bufferCount].offset = 0;
-						bufferInfo[bufferCount].range  = sb.m_size;
-						wds[wdsCount].pBufferInfo = &bufferInfo[bufferCount];
-						++bufferCount;
+			uint16_t unsettedAttr[Attrib::Count];
+			bx::memCopy(unsettedAttr, _program.m_vsh->m_attrMask, sizeof(uint16_t) * Attrib::Count);
+			for (uint8_t stream = 0; stream < _numStream; ++stream)
+			{
+				VertexLayout layout;
+				bx::memCopy(&layout, _layout[stream], sizeof(VertexLayout) );
+				const uint16_t* attrMask = _program.m_vsh->m_attrMask;
 
-						++wdsCount;
-					}
-					break;
-					case Binding::Texture:
+				for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
+				{
+					uint16_t mask = attrMask[ii];
+					uint16_t attr = (layout.m_attributes[ii] & mask);
+					layout.m_attributes[ii] = attr == 0 || attr == UINT16_MAX ? UINT16_MAX : attr;
+					if (unsettedAttr[ii] && attr != UINT16_MAX)
 					{
-						TextureVK& texture = m_textures[bind.m_idx];
-						VkSampler sampler = getSampler(
-							(0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & bind.m_samplerFlags)
-								? bind.m_samplerFlags
-								: (uint32_t)texture.m_flags
-							) & (BGFX_SAMPLER_BITS_MASK | BGFX_SAMPLER_BORDER_COLOR_MASK)
-							, (uint32_t)texture.m_numMips);
-
-						if (VK_IMAGE_LAYOUT_GENERAL != texture.m_currentImageLayout
-						&&  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL != texture.m_currentImageLayout)
-						{
-							texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-						}
-
-						imageInfo[imageCount].imageLayout = texture.m_currentImageLayout;
-						imageInfo[imageCount].imageView   = VK_NULL_HANDLE != texture.m_textureImageDepthView
-							? texture.m_textureImageDepthView
-							: texture.m_textureImageView
-							;
-						imageInfo[imageCount].sampler     = sampler;
-
-						wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-						wds[wdsCount].pNext            = NULL;
-						wds[wdsCount].dstSet           = descriptorSet;
-						wds[wdsCount].dstBinding       = bindInfo.binding;
-						wds[wdsCount].dstArrayElement  = 0;
-						wds[wdsCount].descriptorCount  = 1;
-						wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
-						wds[wdsCount].pImageInfo       = &imageInfo[imageCount];
-						wds[wdsCount].pBufferInfo      = NULL;
-						wds[wdsCount].pTexelBufferView = NULL;
-						++wdsCount;
-
-						wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-						wds[wdsCount].pNext            = NULL;
-						wds[wdsCount].dstSet           = descriptorSet;
-						wds[wdsCount].dstBinding       = bindInfo.samplerBinding;
-						wds[wdsCount].dstArrayElement  = 0;
-						wds[wdsCount].descriptorCount  = 1;
-						wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_SAMPLER;
-						wds[wdsCount].pImageInfo       = &imageInfo[imageCount];
-						wds[wdsCount].pBufferInfo      = NULL;
-						wds[wdsCount].pTexelBufferView = NULL;
-						++wdsCount;
-
-						++imageCount;
-					}
-					break;
+						unsettedAttr[ii] = 0;
 					}
 				}
-			}
 
-			const uint32_t align = uint32_t(m_deviceProperties.limits.minUniformBufferOffsetAlignment);
-			const uint32_t vsize = bx::strideAlign(program.m_vsh->m_size, align);
-			const uint32_t fsize = bx::strideAlign( (NULL != program.m_fsh ? program.m_fsh->m_size : 0), align);
-			const uint32_t total = vsize + fsize;
+				fillVertexLayout(_program.m_vsh, _vertexInputState, layout);
+			}
 
-			if (0 < total)
+			for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
 			{
-				uint32_t vsUniformBinding = program.m_vsh->m_uniformBinding;
-				uint32_t fsUniformBinding = NULL != program.m_fsh ? program.m_fsh->m_uniformBinding : 0;
-
-				if (vsize > 0)
-				{
-					bufferInfo[bufferCount].buffer = scratchBuffer.m_buffer;
-					bufferInfo[bufferCount].offset = 0;
-					bufferInfo[bufferCount].range  = vsize;
-
-					wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-					wds[wdsCount].pNext            = NULL;
-					wds[wdsCount].dstSet           = descriptorSet;
-					wds[wdsCount].dstBinding       = vsUniformBinding;
-					wds[wdsCount].dstArrayElement  = 0;
-					wds[wdsCount].descriptorCount  = 1;
-					wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-					wds[wdsCount].pImageInfo       = NULL;
-					wds[wdsCount].pBufferInfo      = &bufferInfo[bufferCount];
-					wds[wdsCount].pTexelBufferView = NULL;
-					++wdsCount;
-					++bufferCount;
-				}
-
-				if (fsize > 0)
+				if (0 < unsettedAttr[ii])
 				{
-					bufferInfo[bufferCount].buffer = scratchBuffer.m_buffer;
-					bufferInfo[bufferCount].offset = 0;
-					bufferInfo[bufferCount].range  = fsize;
-
-					wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-					wds[wdsCount].pNext            = NULL;
-					wds[wdsCount].dstSet           = descriptorSet;
-					wds[wdsCount].dstBinding       = fsUniformBinding;
-					wds[wdsCount].dstArrayElement  = 0;
-					wds[wdsCount].descriptorCount  = 1;
-					wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-					wds[wdsCount].pImageInfo       = NULL;
-					wds[wdsCount].pBufferInfo      = &bufferInfo[bufferCount];
-					wds[wdsCount].pTexelBufferView = NULL;
-					++wdsCount;
-					++bufferCount;
+					uint32_t numAttribs  = _vertexInputState.vertexAttributeDescriptionCount;
+					VkVertexInputAttributeDescription* inputAttrib = const_cast<VkVertexInputAttributeDescription*>(_vertexInputState.pVertexAttributeDescriptions + numAttribs);
+					inputAttrib->location = _program.m_vsh->m_attrRemap[ii];
+					inputAttrib->binding  = 0;
+					inputAttrib->format = VK_FORMAT_R32G32B32_SFLOAT;
+					inputAttrib->offset = 0;
+					_vertexInputState.vertexAttributeDescriptionCount++;
 				}
 			}
 
-			vkUpdateDescriptorSets(m_device, wdsCount, wds, 0, NULL);
+			if (0 < _numInstanceData)
+			{
+				fillInstanceBinding(_program.m_vsh, _vertexInputState, _numInstanceData);
+			}
 		}
 
-		void commit(UniformBuffer& _uniformBuffer)
+		uint32_t getRenderPassHashkey(uint8_t _num, const Attachment* attachments)
 		{
-			_uniformBuffer.reset();
-
-			for (;;)
+			if (_num == 0)
+				return 0;
+			bx::HashMurmur2A hash;
+			hash.begin(0);
+			for (uint8_t ii = 0; ii < _num; ++ii)
 			{
-				uint32_t opcode = _uniformBuffer.read();
-
-				if (UniformType::End == opcode)
-				{
-					break;
-				}
+				hash.add(attachments[ii].access);
+				hash.add(attachments[ii].layer);
+				hash.add(attachments[ii].mip);
+				hash.add(attachments[ii].resolve);
 
-				UniformType::Enum type;
-				uint16_t loc;
-				uint16_t num;
-				uint16_t copy;
-				UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+				TextureVK& texture = m_textures[attachments[ii].handle.idx];
+				hash.add(texture.m_textureFormat);
+			}
+			return hash.end();
+		}
 
-				const char* data;
-				if (copy)
-				{
-					data = _uniformBuffer.read(g_uniformTypeSize[type]*num);
-				}
-				else
-				{
-					UniformHandle handle;
-					bx::memCopy(&handle, _uniformBuffer.read(sizeof(UniformHandle) ), sizeof(UniformHandle) );
-					data = (const char*)m_uniforms[handle.idx];
-				}
+		VkRenderPass getRenderPass(uint8_t _num, const Attachment* _attachments)
+		{
+			VkRenderPass renderPass = VK_NULL_HANDLE;
+			uint32_t hashKey = getRenderPassHashkey(_num, _attachments);
+			renderPass = (VkRenderPass)m_renderPassCache.find(hashKey);
+			if (renderPass != VK_NULL_HANDLE)
+				return renderPass;
 
-#define CASE_IMPLEMENT_UNIFORM(_uniform, _dxsuffix, _type)                   \
-				case UniformType::_uniform:                                  \
-				case UniformType::_uniform|kUniformFragmentBit:         \
-						{                                                    \
-							setShaderUniform(uint8_t(type), loc, data, num); \
-						}                                                    \
-						break;
+			// cache missed
+			VkAttachmentDescription ad[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+			VkAttachmentReference colorAr[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+			VkAttachmentReference resolveAr[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+			VkAttachmentReference depthAr;
+			uint32_t numColorAr = 0;
 
-				switch ( (uint32_t)type)
-				{
-				case UniformType::Mat3:
-				case UniformType::Mat3|kUniformFragmentBit:
-					 {
-						 float* value = (float*)data;
-						 for (uint32_t ii = 0, count = num/3; ii < count; ++ii,  loc += 3*16, value += 9)
-						 {
-							 Matrix4 mtx;
-							 mtx.un.val[ 0] = value[0];
-							 mtx.un.val[ 1] = value[1];
-							 mtx.un.val[ 2] = value[2];
-							 mtx.un.val[ 3] = 0.0f;
-							 mtx.un.val[ 4] = value[3];
-							 mtx.un.val[ 5] = value[4];
-							 mtx.un.val[ 6] = value[5];
-							 mtx.un.val[ 7] = 0.0f;
-							 mtx.un.val[ 8] = value[6];
-							 mtx.un.val[ 9] = value[7];
-							 mtx.un.val[10] = value[8];
-							 mtx.un.val[11] = 0.0f;
-							 setShaderUniform(uint8_t(type), loc, &mtx.un.val[0], 3);
-						 }
-					}
-					break;
-
-				case UniformType::Sampler:
-				case UniformType::Sampler|kUniformFragmentBit:
-					// do nothing, but VkDescriptorSetImageInfo would be set before drawing
-					break;
-//				CASE_IMPLEMENT_UNIFORM(Sampler, I, int);
-				CASE_IMPLEMENT_UNIFORM(Vec4,    F, float);
-				CASE_IMPLEMENT_UNIFORM(Mat4,    F, float);
+			depthAr.attachment   = VK_ATTACHMENT_UNUSED;
+			depthAr.layout		 = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
-				case UniformType::End:
-					break;
+			for (uint8_t ii = 0; ii < _num; ++ii)
+			{
+				TextureVK& texture = m_textures[_attachments[ii].handle.idx];
+				ad[ii].flags          = 0;
+				ad[ii].format         = texture.m_format;
+				ad[ii].samples        = VK_SAMPLE_COUNT_1_BIT;
 
-				default:
-					BX_TRACE("%4d: INVALID 0x%08x, t %d, l %d, n %d, c %d", _uniformBuffer.getPos(), opcode, type, loc, num, copy);
-					break;
+				if (texture.m_aspectMask & VK_IMAGE_ASPECT_COLOR_BIT)
+				{
+					ad[ii].loadOp                  = VK_ATTACHMENT_LOAD_OP_LOAD;
+					ad[ii].storeOp                 = VK_ATTACHMENT_STORE_OP_STORE;
+					ad[ii].stencilLoadOp           = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+					ad[ii].stencilStoreOp          = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+					ad[ii].initialLayout           = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+					ad[ii].finalLayout             = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+					colorAr[numColorAr].layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+					colorAr[numColorAr].attachment = ii;
+					numColorAr++;
 				}
-#undef CASE_IMPLEMENT_UNIFORM
+				else if (texture.m_aspectMask & VK_IMAGE_ASPECT_DEPTH_BIT)
+				{
+					ad[ii].loadOp         = VK_ATTACHMENT_LOAD_OP_LOAD;
+					ad[ii].storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
+					ad[ii].stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_LOAD;
+					ad[ii].stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE;
+					ad[ii].initialLayout  = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+					ad[ii].finalLayout    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+					depthAr.layout        = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+					depthAr.attachment    = ii;
+				}
+
+				resolveAr[ii].attachment = VK_ATTACHMENT_UNUSED;
+				resolveAr[ii].layout     = ad[ii].initialLayout;
 			}
+
+			VkSubpassDescription sd[1];
+			sd[0].flags                   = 0;
+			sd[0].pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+			sd[0].inputAttachmentCount    = 0;
+			sd[0].pInputAttachments       = NULL;
+			sd[0].colorAttachmentCount    = numColorAr;
+			sd[0].pColorAttachments       = colorAr;
+			sd[0].pResolveAttachments     = resolveAr;
+			sd[0].pDepthStencilAttachment = &depthAr;
+			sd[0].preserveAttachmentCount = 0;
+			sd[0].pPreserveAttachments    = NULL;
+
+			VkRenderPassCreateInfo rpi;
+			rpi.sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+			rpi.pNext           = NULL;
+			rpi.flags           = 0;
+			rpi.attachmentCount = _num;
+			rpi.pAttachments    = ad;
+			rpi.subpassCount    = BX_COUNTOF(sd);
+			rpi.pSubpasses      = sd;
+			rpi.dependencyCount = 0;
+			rpi.pDependencies   = NULL;
+
+			VK_CHECK( vkCreateRenderPass(m_device, &rpi, m_allocatorCb, &renderPass) );
+
+			m_renderPassCache.add(hashKey, renderPass);
+			return renderPass;
 		}
 
-		void clearQuad(const Rect& _rect, const Clear& _clear, const float _palette[][4])
+		VkSampler getSampler(uint32_t _samplerFlags, uint32_t _mipLevels, uint8_t _minMip)
 		{
-			VkClearRect rect[1];
-			rect[0].rect.offset.x      = _rect.m_x;
-			rect[0].rect.offset.y      = _rect.m_y;
-			rect[0].rect.extent.width  = _rect.m_width;
-			rect[0].rect.extent.height = _rect.m_height;
-			rect[0].baseArrayLayer = 0;
-			rect[0].layerCount     = 1;
+			bx::HashMurmur2A hash;
+			hash.begin();
+			hash.add(_samplerFlags);
+			hash.add(_mipLevels);
+			hash.add(_minMip);
+			uint32_t hashKey = hash.end();
 
-			uint32_t numMrt = 1;
-			FrameBufferHandle fbh = m_fbh;
-			if (isValid(fbh) )
+			ConditionalMutexScope scope(m_cacheMutex, m_recordParallel);
+
+			VkSampler sampler = m_samplerCache.find(hashKey);
+			if (sampler != VK_NULL_HANDLE)
 			{
-				const FrameBufferVK& fb = m_frameBuffers[fbh.idx];
-				numMrt = fb.m_num;
+				return sampler;
 			}
 
-			VkClearAttachment attachments[BGFX_CONFIG_MAX_FRAME_BUFFERS];
-			uint32_t mrt = 0;
+			const uint32_t cmpFunc = (_samplerFlags&BGFX_SAMPLER_COMPARE_MASK)>>BGFX_SAMPLER_COMPARE_SHIFT;
 
-			if (true //NULL != m_currentColor
-			&&  BGFX_CLEAR_COLOR & _clear.m_flags)
-			{
-				if (BGFX_CLEAR_COLOR_USE_PALETTE & _clear.m_flags)
-				{
-					for (uint32_t ii = 0; ii < numMrt; ++ii)
-					{
-						attachments[mrt].colorAttachment = mrt;
-						attachments[mrt].aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-						uint8_t index = bx::min<uint8_t>(BGFX_CONFIG_MAX_COLOR_PALETTE-1, _clear.m_index[ii]);
-						bx::memCopy(&attachments[mrt].clearValue.color.float32, _palette[index], 16);
-						++mrt;
-					}
-				}
-				else
-				{
-					float frgba[4] =
-					{
-						_clear.m_index[0] * 1.0f / 255.0f,
-						_clear.m_index[1] * 1.0f / 255.0f,
-						_clear.m_index[2] * 1.0f / 255.0f,
-						_clear.m_index[3] * 1.0f / 255.0f,
-					};
+			VkSamplerCreateInfo sci;
+			sci.sType            = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+			sci.pNext            = NULL;
+			sci.flags            = 0;
+			sci.magFilter        = VK_FILTER_LINEAR;
+			sci.minFilter        = VK_FILTER_LINEAR;
+			sci.mipmapMode       = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+			sci.addressModeU     = s_textureAddress[(_samplerFlags&BGFX_SAMPLER_U_MASK)>>BGFX_SAMPLER_U_SHIFT];
+			sci.addressModeV     = s_textureAddress[(_samplerFlags&BGFX_SAMPLER_V_MASK)>>BGFX_SAMPLER_V_SHIFT];
+			sci.addressModeW     = s_textureAddress[(_samplerFlags&BGFX_SAMPLER_W_MASK)>>BGFX_SAMPLER_W_SHIFT];
+			sci.mipLodBias       = 0.0f;
+			sci.anisotropyEnable = VK_FALSE;
+			sci.maxAnisotropy    = 4.0f;
+			sci.compareEnable    = 0 != cmpFunc;
+			sci.compareOp        = s_cmpFunc[cmpFunc];
+			sci.minLod           = (float)_minMip;
+			sci.maxLod           = (float)_mipLevels;
+			sci.borderColor      = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+			sci.unnormalizedCoordinates = VK_FALSE;
 
-					for (uint32_t ii = 0; ii < numMrt; ++ii)
-					{
-						attachments[mrt].colorAttachment = mrt;
-						attachments[mrt].aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-						bx::memCopy(&attachments[mrt].clearValue.color.float32, frgba, 16);
-						++mrt;
-					}
-				}
+			switch (_samplerFlags & BGFX_SAMPLER_MAG_MASK)
+			{
+				case BGFX_SAMPLER_MAG_POINT:       sci.magFilter = VK_FILTER_NEAREST; break;
+				case BGFX_SAMPLER_MAG_ANISOTROPIC: sci.anisotropyEnable = VK_TRUE;    break;
 			}
 
-			if (true //NULL != m_currentDepthStencil
-			&& (BGFX_CLEAR_DEPTH | BGFX_CLEAR_STENCIL) & _clear.m_flags)
+			switch (_samplerFlags & BGFX_SAMPLER_MIN_MASK)
 			{
-				attachments[mrt].colorAttachment = mrt;
-				attachments[mrt].aspectMask = 0;
-				attachments[mrt].aspectMask |= (_clear.m_flags & BGFX_CLEAR_DEPTH  ) ? VK_IMAGE_ASPECT_DEPTH_BIT   : 0;
-				attachments[mrt].aspectMask |= (_clear.m_flags & BGFX_CLEAR_STENCIL) ? VK_IMAGE_ASPECT_STENCIL_BIT : 0;
-
-				attachments[mrt].clearValue.depthStencil.stencil = _clear.m_stencil;
-				attachments[mrt].clearValue.depthStencil.depth   = _clear.m_depth;
-				++mrt;
+				case BGFX_SAMPLER_MIN_POINT:       sci.minFilter = VK_FILTER_NEAREST; break;
+				case BGFX_SAMPLER_MIN_ANISOTROPIC: sci.anisotropyEnable = VK_TRUE;    break;
 			}
 
-			if (mrt > 0)
+			uint32_t borderColor = ( (_samplerFlags & BGFX_SAMPLER_BORDER_COLOR_MASK) >> BGFX_SAMPLER_BORDER_COLOR_SHIFT);
+			if (borderColor > 0)
 			{
-				vkCmdClearAttachments(m_commandBuffer
-					, mrt
-					, attachments
-					, BX_COUNTOF(rect)
-					, rect
-					);
+				sci.borderColor = VK_BORDER_COLOR_INT_OPAQUE_WHITE;
 			}
-		}
-
-		uint64_t kick(VkSemaphore _wait = VK_NULL_HANDLE, VkSemaphore _signal = VK_NULL_HANDLE)
-		{
-			VkPipelineStageFlags stageFlags = 0
-				| VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
-				;
 
-			VkSubmitInfo si;
-			si.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-			si.pNext = NULL;
-			si.waitSemaphoreCount = VK_NULL_HANDLE != _wait;
-			si.pWaitSemaphores    = &_wait;
-			si.pWaitDstStageMask  = &stageFlags;
-			si.commandBufferCount = 1;
-			si.pCommandBuffers    = &m_commandBuffers[m_backBufferColorIdx];
-			si.signalSemaphoreCount = VK_NULL_HANDLE != _signal;
-			si.pSignalSemaphores    = &_signal;
+			VK_CHECK(vkCreateSampler(m_device, &sci, m_allocatorCb, &sampler) );
 
-//			VK_CHECK(vkResetFences(m_device, 1, &m_fence) );
-			VK_CHECK(vkQueueSubmit(m_queueGraphics, 1, &si, VK_NULL_HANDLE) );
-			return 0;
+			m_samplerCache.add(hashKey, sampler);
+			return sampler;
 		}
 
-		void finish()
+		VkPipeline getPipeline(ProgramHandle _program)
 		{
-			finishAll();
-		}
+			ProgramVK& program = m_program[_program.idx];
 
-		void finishAll()
-		{
-			VK_CHECK(vkQueueWaitIdle(m_queueGraphics) );
-//			VK_CHECK(vkWaitForFences(m_device, 1, &m_fence, true, INT64_MAX) );
-		}
+			bx::HashMurmur2A murmur;
+			murmur.begin();
+			murmur.add(program.m_vsh->m_hash);
+			const uint32_t hash = murmur.end();
 
-		int32_t selectMemoryType(uint32_t _memoryTypeBits, uint32_t _propertyFlags, int32_t _startIndex = 0) const
-		{
-			for (int32_t ii = _startIndex, num = m_memoryProperties.memoryTypeCount; ii < num; ++ii)
+			VkPipeline pipeline = m_pipelineStateCache.find(hash);
+
+			if (VK_NULL_HANDLE != pipeline)
 			{
-				const VkMemoryType& memType = m_memoryProperties.memoryTypes[ii];
-				if ( (0 != ( (1<<ii) & _memoryTypeBits) )
-				&& ( (memType.propertyFlags & _propertyFlags) == _propertyFlags) )
-				{
-					return ii;
-				}
+				return pipeline;
 			}
 
-			BX_TRACE("Failed to find memory that supports flags 0x%08x.", _propertyFlags);
-			return -1;
+			VkComputePipelineCreateInfo cpci;
+			cpci.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+			cpci.pNext = NULL;
+			cpci.flags = 0;
+
+			cpci.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			cpci.stage.pNext  = NULL;
+			cpci.stage.flags  = 0;
+			cpci.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+			cpci.stage.module = program.m_vsh->m_module;
+			cpci.stage.pName  = "main";
+			cpci.stage.pSpecializationInfo = NULL;
+
+			cpci.layout             = program.m_pipelineLayout;
+			cpci.basePipelineHandle = VK_NULL_HANDLE;
+			cpci.basePipelineIndex  = 0;
+
+			VK_CHECK( vkCreateComputePipelines(m_device, m_pipelineCache, 1, &cpci, m_allocatorCb, &pipeline) );
+
+			m_pipelineStateCache.add(hash, pipeline);
+
+			return pipeline;
 		}
 
-		VkResult allocateMemory(const VkMemoryRequirements* requirements, VkMemoryPropertyFlags propertyFlags, VkDeviceMemory* memory) const
+		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, ProgramHandle _program, uint8_t _numInstanceData)
 		{
-			VkMemoryAllocateInfo ma;
-			ma.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-			ma.pNext = NULL;
-			ma.allocationSize = requirements->size;
+			ProgramVK& program = m_program[_program.idx];
 
-			VkResult result = VK_ERROR_UNKNOWN;
-			int32_t searchIndex = -1;
-			do
-			{
-				searchIndex++;
-				searchIndex = selectMemoryType(requirements->memoryTypeBits, propertyFlags, searchIndex);
-				if (searchIndex >= 0)
-				{
-					ma.memoryTypeIndex = searchIndex;
-					result = vkAllocateMemory(m_device
-						, &ma
-						, m_allocatorCb
-						, memory
-					);
-				}
-			}
-			while (result != VK_SUCCESS && searchIndex >= 0);
-
-			return result;
-		}
-
-		VkCommandBuffer beginNewCommand(VkCommandBufferUsageFlagBits commandBufferUsageFlag = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT)
-		{
-			VkCommandBufferAllocateInfo cbai;
-			cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-			cbai.pNext = NULL;
-			cbai.commandPool = m_commandPool;
-			cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-			cbai.commandBufferCount = 1;
+			_state &= 0
+				| BGFX_STATE_WRITE_RGB
+				| BGFX_STATE_WRITE_A
+				| BGFX_STATE_WRITE_Z
+				| BGFX_STATE_DEPTH_TEST_MASK
+				| BGFX_STATE_BLEND_MASK
+				| BGFX_STATE_BLEND_EQUATION_MASK
+				| BGFX_STATE_BLEND_INDEPENDENT
+				| BGFX_STATE_BLEND_ALPHA_TO_COVERAGE
+				| BGFX_STATE_CULL_MASK
+				| BGFX_STATE_MSAA
+				| BGFX_STATE_LINEAA
+				| BGFX_STATE_CONSERVATIVE_RASTER
+				| BGFX_STATE_PT_MASK
+				;
 
-			VkCommandBuffer commandBuffer;
-			VK_CHECK(vkAllocateCommandBuffers(m_device, &cbai, &commandBuffer) );
+			_stencil &= packStencil(~BGFX_STENCIL_FUNC_REF_MASK, ~BGFX_STENCIL_FUNC_REF_MASK);
 
-			VkCommandBufferBeginInfo cbbi;
-			cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-			cbbi.pNext = NULL;
-			cbbi.flags = commandBufferUsageFlag;
-			cbbi.pInheritanceInfo = NULL;
-			VK_CHECK(vkBeginCommandBuffer(commandBuffer, &cbbi) );
+			VertexLayout layout;
+			if (0 < _numStreams)
+			{
+				bx::memCopy(&layout, _layouts[0], sizeof(VertexLayout) );
+				const uint16_t* attrMask = program.m_vsh->m_attrMask;
 
-			return commandBuffer;
-		}
+				for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
+				{
+					uint16_t mask = attrMask[ii];
+					uint16_t attr = (layout.m_attributes[ii] & mask);
+					layout.m_attributes[ii] = attr == 0 ? UINT16_MAX : attr == UINT16_MAX ? 0 : attr;
+				}
+			}
 
-		void submitCommandAndWait(VkCommandBuffer commandBuffer)
-		{
-			vkEndCommandBuffer(commandBuffer);
+			bx::HashMurmur2A murmur;
+			murmur.begin();
+			murmur.add(_state);
+			murmur.add(_stencil);
+			murmur.add(program.m_vsh->m_hash);
+			murmur.add(program.m_vsh->m_attrMask, sizeof(program.m_vsh->m_attrMask) );
+			if (NULL != program.m_fsh)
+			{
+				murmur.add(program.m_fsh->m_hash);
+			}
+			for (uint8_t ii = 0; ii < _numStreams; ++ii)
+			{
+				murmur.add(_layouts[ii]->m_hash);
+			}
+			murmur.add(layout.m_attributes, sizeof(layout.m_attributes) );
+			murmur.add(m_fbh.idx);
+			murmur.add(_numInstanceData);
+			const uint32_t hash = murmur.end();
 
-			VkSubmitInfo submitInfo;
-			submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-			submitInfo.pNext = NULL;
-			submitInfo.commandBufferCount = 1;
-			submitInfo.pCommandBuffers = &commandBuffer;
-			submitInfo.waitSemaphoreCount = 0;
-			submitInfo.pWaitSemaphores = NULL;
-			submitInfo.signalSemaphoreCount = 0;
-			submitInfo.pSignalSemaphores = NULL;
-			submitInfo.pWaitDstStageMask = NULL;
+			ConditionalMutexScope scope(m_cacheMutex, m_recordParallel);
 
-			VK_CHECK(vkQueueSubmit(m_queueGraphics, 1, &submitInfo, VK_NULL_HANDLE) );
-			VK_CHECK(vkQueueWaitIdle(m_queueGraphics) );
+			VkPipeline pipeline = m_pipelineStateCache.find(hash);
 
-			vkFreeCommandBuffers(m_device, m_commandPool, 1, &commandBuffer);
-		}
+			if (VK_NULL_HANDLE != pipeline)
+			{
+				return pipeline;
+			}
 
-#define NUM_SWAPCHAIN_IMAGE 4
-		VkAllocationCallbacks*   m_allocatorCb;
-		VkDebugReportCallbackEXT m_debugReportCallback;
-		VkInstance       m_instance;
-		VkPhysicalDevice m_physicalDevice;
+			VkPipelineColorBlendAttachmentState blendAttachmentState[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+			VkPipelineColorBlendStateCreateInfo colorBlendState;
+			colorBlendState.pAttachments = blendAttachmentState;
+			setBlendState(colorBlendState, _state);
 
-		VkPhysicalDeviceProperties       m_deviceProperties;
-		VkPhysicalDeviceMemoryProperties m_memoryProperties;
-		VkPhysicalDeviceFeatures         m_deviceFeatures;
+			VkPipelineInputAssemblyStateCreateInfo inputAssemblyState;
+			inputAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+			inputAssemblyState.pNext = NULL;
+			inputAssemblyState.flags = 0;
+			inputAssemblyState.topology = s_primInfo[(_state&BGFX_STATE_PT_MASK) >> BGFX_STATE_PT_SHIFT].m_topology;
+			inputAssemblyState.primitiveRestartEnable = VK_FALSE;
 
-		VkSwapchainCreateInfoKHR m_sci;
-		VkSurfaceKHR       m_surface;
-		VkSwapchainKHR     m_swapchain;
-		uint32_t           m_numSwapchainImages;
-		VkSurfaceFormatKHR m_backBufferColorFormat;
-		VkSurfaceFormatKHR m_backBufferColorFormatSrgb;
-		VkImageLayout      m_backBufferColorImageLayout[NUM_SWAPCHAIN_IMAGE];
-		VkImage            m_backBufferColorImage[NUM_SWAPCHAIN_IMAGE];
-		VkImageView        m_backBufferColorImageView[NUM_SWAPCHAIN_IMAGE];
-		VkFramebuffer      m_backBufferColor[NUM_SWAPCHAIN_IMAGE];
-		VkCommandBuffer    m_commandBuffers[NUM_SWAPCHAIN_IMAGE];
-		VkCommandBuffer    m_commandBuffer;
-		bool               m_needToRefreshSwapchain;
+			VkPipelineRasterizationStateCreateInfo rasterizationState;
+			setRasterizerState(rasterizationState, _state);
 
-		VkFormat           m_backBufferDepthStencilFormat;
-		VkDeviceMemory     m_backBufferDepthStencilMemory;
-		VkImage            m_backBufferDepthStencilImage;
-		VkImageView        m_backBufferDepthStencilImageView;
+			VkPipelineDepthStencilStateCreateInfo depthStencilState;
+			setDepthStencilState(depthStencilState, _state, _stencil);
 
-		ScratchBufferVK    m_scratchBuffer[NUM_SWAPCHAIN_IMAGE];
-		VkSemaphore        m_presentDone[NUM_SWAPCHAIN_IMAGE];
+			VkVertexInputBindingDescription  inputBinding[Attrib::Count + 1 + BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT];
+			VkVertexInputAttributeDescription inputAttrib[Attrib::Count + 1 + BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT];
 
-		uint32_t m_qfiGraphics;
-		uint32_t m_qfiCompute;
+			VkPipelineVertexInputStateCreateInfo vertexInputState;
+			vertexInputState.pVertexBindingDescriptions   = inputBinding;
+			vertexInputState.pVertexAttributeDescriptions = inputAttrib;
+			setInputLayout(vertexInputState, _numStreams, _layouts, program, _numInstanceData);
 
-		VkDevice m_device;
-		VkQueue  m_queueGraphics;
-		VkQueue  m_queueCompute;
-		VkFence  m_fence;
-		VkRenderPass m_renderPass;
-		VkDescriptorPool m_descriptorPool;
-		VkPipelineCache m_pipelineCache;
-		VkCommandPool m_commandPool;
+			const VkDynamicState dynamicStates[] =
+			{
+				VK_DYNAMIC_STATE_VIEWPORT,
+				VK_DYNAMIC_STATE_SCISSOR,
+				VK_DYNAMIC_STATE_BLEND_CONSTANTS,
+				VK_DYNAMIC_STATE_STENCIL_REFERENCE,
+			};
 
-		void* m_renderDocDll;
-		void* m_vulkan1Dll;
+			VkPipelineDynamicStateCreateInfo dynamicState;
+			dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+			dynamicState.pNext = NULL;
+			dynamicState.flags = 0;
+			dynamicState.dynamicStateCount = BX_COUNTOF(dynamicStates);
+			dynamicState.pDynamicStates    = dynamicStates;
 
-		IndexBufferVK m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
-		VertexBufferVK m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
-		ShaderVK m_shaders[BGFX_CONFIG_MAX_SHADERS];
-		ProgramVK m_program[BGFX_CONFIG_MAX_PROGRAMS];
-		TextureVK m_textures[BGFX_CONFIG_MAX_TEXTURES];
-		VertexLayout m_vertexLayouts[BGFX_CONFIG_MAX_VERTEX_LAYOUTS];
-		FrameBufferVK m_frameBuffers[BGFX_CONFIG_MAX_FRAME_BUFFERS];
-		void* m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
-		Matrix4 m_predefinedUniforms[PredefinedUniform::Count];
-		UniformRegistry m_uniformReg;
+			VkPipelineShaderStageCreateInfo shaderStages[2];
+			shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			shaderStages[0].pNext = NULL;
+			shaderStages[0].flags = 0;
+			shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+			shaderStages[0].module = program.m_vsh->m_module;
+			shaderStages[0].pName  = "main";
+			shaderStages[0].pSpecializationInfo = NULL;
 
-		StateCacheT<VkPipeline> m_pipelineStateCache;
-		StateCacheT<VkDescriptorSetLayout> m_descriptorSetLayoutCache;
-		StateCacheT<VkRenderPass> m_renderPassCache;
-		StateCacheT<VkSampler> m_samplerCache;
+			if (NULL != program.m_fsh)
+			{
+				shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+				shaderStages[1].pNext = NULL;
+				shaderStages[1].flags = 0;
+				shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+				shaderStages[1].module = program.m_fsh->m_module;
+				shaderStages[1].pName  = "main";
+				shaderStages[1].pSpecializationInfo = NULL;
+			}
 
-		Resolution m_resolution;
-		uint32_t m_maxAnisotropy;
-		bool m_depthClamp;
-		bool m_wireframe;
+			VkPipelineViewportStateCreateInfo viewportState;
+			viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+			viewportState.pNext = NULL;
+			viewportState.flags = 0;
+			viewportState.viewportCount = 1;
+			viewportState.pViewports    = NULL;
+			viewportState.scissorCount  = 1;
+			viewportState.pScissors     = NULL;
 
-		TextVideoMem m_textVideoMem;
+			VkPipelineMultisampleStateCreateInfo multisampleState;
+			multisampleState.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+			multisampleState.pNext = NULL;
+			multisampleState.flags = 0;
+			multisampleState.rasterizationSamples  = VK_SAMPLE_COUNT_1_BIT;
+			multisampleState.sampleShadingEnable   = VK_FALSE;
+			multisampleState.minSampleShading      = !!(BGFX_STATE_CONSERVATIVE_RASTER & _state) ? 1.0f : 0.0f;
+			multisampleState.pSampleMask           = NULL;
+			multisampleState.alphaToCoverageEnable = !!(BGFX_STATE_BLEND_ALPHA_TO_COVERAGE & _state);
+			multisampleState.alphaToOneEnable      = VK_FALSE;
 
-		uint8_t m_fsScratch[64<<10];
-		uint8_t m_vsScratch[64<<10];
+			VkGraphicsPipelineCreateInfo graphicsPipeline;
+			graphicsPipeline.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+			graphicsPipeline.pNext = NULL;
+			graphicsPipeline.flags = 0;
+			graphicsPipeline.stageCount = NULL == program.m_fsh ? 1 : 2;
+			graphicsPipeline.pStages    = shaderStages;
+			graphicsPipeline.pVertexInputState   = &vertexInputState;
+			graphicsPipeline.pInputAssemblyState = &inputAssemblyState;
+			graphicsPipeline.pTessellationState  = NULL;
+			graphicsPipeline.pViewportState      = &viewportState;
+			graphicsPipeline.pRasterizationState = &rasterizationState;
+			graphicsPipeline.pMultisampleState   = &multisampleState;
+			graphicsPipeline.pDepthStencilState  = &depthStencilState;
+			graphicsPipeline.pColorBlendState    = &colorBlendState;
+			graphicsPipeline.pDynamicState       = &dynamicState;
+//			graphicsPipeline.layout     = m_pipelineLayout;
+			graphicsPipeline.layout     = program.m_pipelineLayout;
+			graphicsPipeline.renderPass = isValid(m_fbh) ? m_frameBuffers[m_fbh.idx].m_renderPass : m_renderPass;
+			graphicsPipeline.subpass    = 0;
+			graphicsPipeline.basePipelineHandle = VK_NULL_HANDLE;
+			graphicsPipeline.basePipelineIndex  = 0;
 
-		uint32_t m_backBufferColorIdx;
-		FrameBufferHandle m_fbh;
-	};
+			uint32_t length = g_callback->cacheReadSize(hash);
+			bool cached = length > 0;
 
-	static RendererContextVK* s_renderVK;
+			void* cachedData = NULL;
 
-	RendererContextI* rendererCreate(const Init& _init)
-	{
-		s_renderVK = BX_NEW(g_allocator, RendererContextVK);
-		if (!s_renderVK->init(_init) )
-		{
-			BX_DELETE(g_allocator, s_renderVK);
-			s_renderVK = NULL;
-		}
-		return s_renderVK;
-	}
+			VkPipelineCacheCreateInfo pcci;
+			pcci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+			pcci.pNext = NULL;
+			pcci.flags = 0;
+			pcci.initialDataSize = 0;
+			pcci.pInitialData    = NULL;
 
-	void rendererDestroy()
-	{
-		s_renderVK->shutdown();
-		BX_DELETE(g_allocator, s_renderVK);
-		s_renderVK = NULL;
-	}
+			if (cached)
+			{
+				cachedData = BX_ALLOC(g_allocator, length);
+				if (g_callback->cacheRead(hash, cachedData, length) )
+				{
+					BX_TRACE("Loading cached pipeline state (size %d).", length);
+					bx::MemoryReader reader(cachedData, length);
 
-#define VK_DESTROY_FUNC(_name)                                                               \
-			void vkDestroy(Vk##_name& _obj)                                                  \
-			{                                                                                \
-				if (VK_NULL_HANDLE != _obj)                                                  \
-				{                                                                            \
-					vkDestroy##_name(s_renderVK->m_device, _obj, s_renderVK->m_allocatorCb); \
-					_obj = VK_NULL_HANDLE;                                                   \
-				}                                                                            \
+					pcci.initialDataSize = (size_t)reader.remaining();
+					pcci.pInitialData    = reader.getDataPtr();
+				}
 			}
-VK_DESTROY
-#undef VK_DESTROY_FUNC
 
-	void ScratchBufferVK::create(uint32_t _size, uint32_t _maxDescriptors)
-	{
-		m_maxDescriptors = _maxDescriptors;
-		m_currentDs = 0;
-		m_descriptorSet  = (VkDescriptorSet*)BX_ALLOC(g_allocator, m_maxDescriptors * sizeof(VkDescriptorSet) );
-		bx::memSet(m_descriptorSet, 0, sizeof(VkDescriptorSet) * m_maxDescriptors);
-
-		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-		VkDevice device = s_renderVK->m_device;
+			VkPipelineCache cache;
+			VK_CHECK(vkCreatePipelineCache(m_device, &pcci, m_allocatorCb, &cache) );
 
-		VkBufferCreateInfo bci;
-		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		bci.pNext = NULL;
-		bci.flags = 0;
-		bci.size  = _size;
-		bci.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-		bci.queueFamilyIndexCount = 0;
-		bci.pQueueFamilyIndices   = NULL;
+			VK_CHECK(vkCreateGraphicsPipelines(m_device
+				, cache
+				, 1
+				, &graphicsPipeline
+				, m_allocatorCb
+				, &pipeline
+				) );
+			m_pipelineStateCache.add(hash, pipeline);
 
-		VK_CHECK(vkCreateBuffer(
-			  device
-			, &bci
-			, allocatorCb
-			, &m_buffer
-			) );
+			size_t dataSize;
+			VK_CHECK(vkGetPipelineCacheData(m_device, cache, &dataSize, NULL) );
 
-		VkMemoryRequirements mr;
-		vkGetBufferMemoryRequirements(
-			  device
-			, m_buffer
-			, &mr
-			);
+			if (0 < dataSize)
+			{
+				if (length < dataSize)
+				{
+					cachedData = BX_REALLOC(g_allocator, cachedData, dataSize);
+				}
+				VK_CHECK(vkGetPipelineCacheData(m_device, cache, &dataSize, cachedData) );
+				g_callback->cacheWrite(hash, cachedData, (uint32_t)dataSize);
+			}
 
-		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &m_deviceMem) );
+			VK_CHECK(vkMergePipelineCaches(m_device, m_pipelineCache, 1, &cache) );
+			vkDestroy(cache);
 
-		m_size = (uint32_t)mr.size;
-		m_pos  = 0;
+			if (NULL != cachedData)
+			{
+				BX_FREE(g_allocator, cachedData);
+			}
 
-		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem, 0) );
+			return pipeline;
+		}
 
-		VK_CHECK(vkMapMemory(device, m_deviceMem, 0, m_size, 0, (void**)&m_data) );
-	}
+		void allocDescriptorSet(RecorderVK& _rec, const ProgramVK& program, const RenderBind& renderBind)
+		{
+			ScratchBufferVK& scratchBuffer = *_rec.m_scratchBuffer;
 
-	void ScratchBufferVK::destroy()
-	{
-		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-		VkDevice device = s_renderVK->m_device;
+			VkDescriptorSetLayout dsl = m_descriptorSetLayoutCache.find(program.m_descriptorSetLayoutHash);
+			VkDescriptorSetAllocateInfo dsai;
+			dsai.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			dsai.pNext              = NULL;
+			dsai.descriptorPool     = _rec.m_descriptorPool;
+			dsai.descriptorSetCount = 1;
+			dsai.pSetLayouts        = &dsl;
 
-		reset();
-		BX_FREE(g_allocator, m_descriptorSet);
+			VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
 
-		vkUnmapMemory(device, m_deviceMem);
-		vkDestroy(m_buffer);
-		vkFreeMemory(device
-			, m_deviceMem
-			, allocatorCb
-			);
-	}
+			// Record threads allocate from their own pool, which is reset when frame slot is
+			// reused. When it's exhausted, set is allocated from shared pool and released with
+			// scratch buffer.
+			if (VK_NULL_HANDLE == _rec.m_descriptorPool
+			||  VK_SUCCESS != vkAllocateDescriptorSets(m_device, &dsai, &descriptorSet) )
+			{
+				ConditionalMutexScope scope(m_cacheMutex, m_recordParallel);
 
-	void ScratchBufferVK::reset()
-	{
-		if (m_currentDs > 0)
-		{
-			vkFreeDescriptorSets(
-				  s_renderVK->m_device
-				, s_renderVK->m_descriptorPool
-				, m_currentDs
-				, m_descriptorSet
-				);
-		}
+				dsai.descriptorPool = m_descriptorPool;
+				vkAllocateDescriptorSets(m_device, &dsai, &scratchBuffer.m_descriptorSet[scratchBuffer.m_currentDs]);
+				descriptorSet = scratchBuffer.m_descriptorSet[scratchBuffer.m_currentDs];
+				scratchBuffer.m_currentDs++;
+			}
 
-		bx::memSet(m_descriptorSet, 0, sizeof(VkDescriptorSet) * m_maxDescriptors);
-		m_pos = 0;
-		m_currentDs = 0;
-	}
+			_rec.m_descriptorSet = descriptorSet;
 
-	VkResult ImageVK::create(VkFormat _format, const VkExtent3D& _extent)
-	{
-		VkResult result;
+			VkDescriptorImageInfo imageInfo[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
+			VkDescriptorBufferInfo bufferInfo[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
+			const int MAX_DESCRIPTOR_SETS = 2 * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS + 2;
+			VkWriteDescriptorSet wds[MAX_DESCRIPTOR_SETS];
+			bx::memSet(wds, 0, sizeof(wds) );
+			uint32_t wdsCount    = 0;
+			uint32_t bufferCount = 0;
+			uint32_t imageCount  = 0;
 
-		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-		VkDevice device = s_renderVK->m_device;
+			for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+			{
+				const Binding& bind = renderBind.m_bind[stage];
+				const BindInfo& bindInfo = program.m_bindInfo[stage];
 
-		VkImageCreateInfo ici;
-		ici.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-		ici.pNext = NULL;
-		ici.flags = 0;
-		ici.imageType = VK_IMAGE_TYPE_2D;
-		ici.format = _format;
-		ici.extent = _extent;
-		ici.mipLevels   = 1;
-		ici.arrayLayers = 1;
-		ici.samples = VK_SAMPLE_COUNT_1_BIT;
-		ici.tiling  = VK_IMAGE_TILING_OPTIMAL;
-		ici.usage   = 0
-			| VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
-			| VK_IMAGE_USAGE_TRANSFER_SRC_BIT
-			;
-		ici.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-		ici.queueFamilyIndexCount = 0;
-		ici.pQueueFamilyIndices   = 0;
-		ici.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-		result = vkCreateImage(device, &ici, allocatorCb, &m_image);
+				// bgfx does not seem to forbid setting a texture to a stage that a program does not use
+				if (bind.m_type == Binding::Texture
+				&& !isValid(program.m_bindInfo[stage].uniformHandle) )
+					continue;
 
-		if (VK_SUCCESS != result)
-		{
-			BX_TRACE("vkCreateImage failed %d: %s.", result, getName(result) );
-			return result;
-		}
+				if (kInvalidHandle != bind.m_idx)
+				{
+                    switch (bind.m_type)
+                    {
+                    case Binding::Image:
+					{
+						wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+						wds[wdsCount].pNext            = NULL;
+						wds[wdsCount].dstSet           = descriptorSet;
+						wds[wdsCount].dstBinding       = bindInfo.binding;
+						wds[wdsCount].dstArrayElement  = 0;
+						wds[wdsCount].descriptorCount  = 1;
+						wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+						wds[wdsCount].pImageInfo       = NULL;
+						wds[wdsCount].pBufferInfo      = NULL;
+						wds[wdsCount].pTexelBufferView = NULL;
 
-		VkMemoryRequirements mr;
-		vkGetImageMemoryRequirements(device, m_image, &mr);
+						TextureVK& texture = m_textures[bind.m_idx];
+						VkSampler sampler = getSampler(
+							(0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & bind.m_samplerFlags)
+								? bind.m_samplerFlags
+								: (uint32_t)texture.m_flags
+							) & (BGFX_SAMPLER_BITS_MASK | BGFX_SAMPLER_BORDER_COLOR_MASK)
+							, (uint32_t)texture.m_numMips
+							, texture.m_residentMip
+							);
 
-		result = s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_memory);
+						// Record threads must not touch primary command buffer, layout is
+						// transitioned by prepareBindings before render pass begins.
+						if (!m_recordParallel
+						&&  VK_IMAGE_LAYOUT_GENERAL != texture.m_currentImageLayout
+						&&  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL != texture.m_currentImageLayout)
+						{
+							texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+						}
 
-		if (VK_SUCCESS != result)
-		{
-			BX_TRACE("vkAllocateMemory failed %d: %s.", result, getName(result) );
-			destroy();
-			return result;
-		}
+						BX_ASSERT(VK_IMAGE_LAYOUT_GENERAL == texture.m_currentImageLayout
+							|| VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL == texture.m_currentImageLayout
+							, "Texture layout must be transitioned before view is recorded in parallel."
+							);
 
-		result = vkBindImageMemory(device, m_image, m_memory, 0);
+						imageInfo[imageCount].imageLayout = texture.m_currentImageLayout;
+						imageInfo[imageCount].imageView   = VK_NULL_HANDLE != texture.m_textureImageStorageView
+							? texture.m_textureImageStorageView
+							: texture.m_textureImageView
+							;
+						imageInfo[imageCount].sampler     = sampler;
+						wds[wdsCount].pImageInfo = &imageInfo[imageCount];
+						++imageCount;
 
-		if (VK_SUCCESS != result)
-		{
-			BX_TRACE("vkBindImageMemory failed %d: %s.", result, getName(result) );
-			destroy();
-			return result;
-		}
+						++wdsCount;
+					}
+					break;
+					case Binding::VertexBuffer:
+					case Binding::IndexBuffer:
+					{
+						wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+						wds[wdsCount].pNext            = NULL;
+						wds[wdsCount].dstSet           = descriptorSet;
+						wds[wdsCount].dstBinding       = bindInfo.binding;
+						wds[wdsCount].dstArrayElement  = 0;
+						wds[wdsCount].descriptorCount  = 1;
+						wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+						wds[wdsCount].pImageInfo       = NULL;
+						wds[wdsCount].pBufferInfo      = NULL;
+						wds[wdsCount].pTexelBufferView = NULL;
 
-		VkImageViewCreateInfo ivci;
-		ivci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-		ivci.pNext = NULL;
-		ivci.flags = 0;
-		ivci.image    = m_image;
-		ivci.viewType = VK_IMAGE_VIEW_TYPE_2D;
-		ivci.format   = _format;
-		ivci.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
-		ivci.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
-		ivci.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
-		ivci.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
-		ivci.subresourceRange.aspectMask = 0
-			| VK_IMAGE_ASPECT_DEPTH_BIT
-			| VK_IMAGE_ASPECT_STENCIL_BIT
-			;
-		ivci.subresourceRange.baseMipLevel   = 0;
-		ivci.subresourceRange.levelCount     = 1;
-		ivci.subresourceRange.baseArrayLayer = 0;
-		ivci.subresourceRange.layerCount     = 1;
-		result = vkCreateImageView(device, &ivci, allocatorCb, &m_imageView);
-
-		if (VK_SUCCESS != result)
-		{
-			BX_TRACE("vkCreateImageView failed %d: %s.", result, getName(result) );
-			destroy();
-			return result;
-		}
+						BufferVK& sb = bind.m_type == Binding::VertexBuffer ? m_vertexBuffers[bind.m_idx] : m_indexBuffers[bind.m_idx];
+						bufferInfo[bufferCount].buffer = sb.m_buffer;
+						bufferInfo[bufferCount].offset = 0;
+						bufferInfo[bufferCount].range  = sb.m_size;
+						wds[wdsCount].pBufferInfo = &bufferInfo[bufferCount];
+						++bufferCount;
 
-		return VK_SUCCESS;
-	}
+						++wdsCount;
+					}
+					break;
+					case Binding::Texture:
+					{
+						TextureVK& texture = m_textures[bind.m_idx];
+						VkSampler sampler = getSampler(
+							(0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & bind.m_samplerFlags)
+								? bind.m_samplerFlags
+								: (uint32_t)texture.m_flags
+							) & (BGFX_SAMPLER_BITS_MASK | BGFX_SAMPLER_BORDER_COLOR_MASK)
+							, (uint32_t)texture.m_numMips
+							, texture.m_residentMip
+							);
 
-	void ImageVK::destroy()
-	{
-		vkDestroy(m_imageView);
-		vkDestroy(m_image);
-		if (VK_NULL_HANDLE != m_memory)
-		{
-			vkFreeMemory(s_renderVK->m_device, m_memory, s_renderVK->m_allocatorCb);
-			m_memory = VK_NULL_HANDLE;
-		}
-	}
+						// Record threads must not touch primary command buffer, layout is
+						// transitioned by prepareBindings before render pass begins.
+						if (!m_recordParallel
+						&&  VK_IMAGE_LAYOUT_GENERAL != texture.m_currentImageLayout
+						&&  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL != texture.m_currentImageLayout)
+						{
+							texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+						}
 
-	void BufferVK::create(uint32_t _size, void* _data, uint16_t _flags, bool _vertex, uint32_t _stride)
-	{
-		BX_UNUSED(_stride);
+						BX_ASSERT(VK_IMAGE_LAYOUT_GENERAL == texture.m_currentImageLayout
+							|| VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL == texture.m_currentImageLayout
+							, "Texture layout must be transitioned before view is recorded in parallel."
+							);
 
-		m_size    = _size;
-		m_flags   = _flags;
-		m_dynamic = NULL == _data;
+						imageInfo[imageCount].imageLayout = texture.m_currentImageLayout;
+						imageInfo[imageCount].imageView   = VK_NULL_HANDLE != texture.m_textureImageDepthView
+							? texture.m_textureImageDepthView
+							: texture.m_textureImageView
+							;
+						imageInfo[imageCount].sampler     = sampler;
 
-		bool storage  = m_flags & BGFX_BUFFER_COMPUTE_READ_WRITE;
-		bool indirect = m_flags & BGFX_BUFFER_DRAW_INDIRECT;
-		VkBufferCreateInfo bci;
-		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		bci.pNext = NULL;
-		bci.flags = 0;
-		bci.size  = _size;
-		bci.usage = 0
-//			| (m_dynamic            ? VK_BUFFER_USAGE_TRANSFER_DST_BIT    : 0)
-			| (_vertex              ? VK_BUFFER_USAGE_VERTEX_BUFFER_BIT   : VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
-			| (storage || indirect  ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT  : 0)
-			| (indirect             ? VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT : 0)
-			| VK_BUFFER_USAGE_TRANSFER_DST_BIT
-			;
-		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-		bci.queueFamilyIndexCount = 0;
-		bci.pQueueFamilyIndices   = NULL;
+						wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+						wds[wdsCount].pNext            = NULL;
+						wds[wdsCount].dstSet           = descriptorSet;
+						wds[wdsCount].dstBinding       = bindInfo.binding;
+						wds[wdsCount].dstArrayElement  = 0;
+						wds[wdsCount].descriptorCount  = 1;
+						wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+						wds[wdsCount].pImageInfo       = &imageInfo[imageCount];
+						wds[wdsCount].pBufferInfo      = NULL;
+						wds[wdsCount].pTexelBufferView = NULL;
+						++wdsCount;
 
-		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-		VkDevice device = s_renderVK->m_device;
-		VK_CHECK(vkCreateBuffer(device
-			, &bci
-			, allocatorCb
-			, &m_buffer
-			) );
+						wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+						wds[wdsCount].pNext            = NULL;
+						wds[wdsCount].dstSet           = descriptorSet;
+						wds[wdsCount].dstBinding       = bindInfo.samplerBinding;
+						wds[wdsCount].dstArrayElement  = 0;
+						wds[wdsCount].descriptorCount  = 1;
+						wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_SAMPLER;
+						wds[wdsCount].pImageInfo       = &imageInfo[imageCount];
+						wds[wdsCount].pBufferInfo      = NULL;
+						wds[wdsCount].pTexelBufferView = NULL;
+						++wdsCount;
 
-		VkMemoryRequirements mr;
-		vkGetBufferMemoryRequirements(device, m_buffer, &mr);
+						++imageCount;
+					}
+					break;
+					}
+				}
+			}
 
-		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_deviceMem) );
+			const uint32_t align = uint32_t(m_deviceProperties.limits.minUniformBufferOffsetAlignment);
+			const uint32_t vsize = bx::strideAlign(program.m_vsh->m_size, align);
+			const uint32_t fsize = bx::strideAlign( (NULL != program.m_fsh ? program.m_fsh->m_size : 0), align);
+			const uint32_t total = vsize + fsize;
 
-		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem, 0) );
+			if (0 < total)
+			{
+				uint32_t vsUniformBinding = program.m_vsh->m_uniformBinding;
+				uint32_t fsUniformBinding = NULL != program.m_fsh ? program.m_fsh->m_uniformBinding : 0;
 
-		if (!m_dynamic)
-		{
-//			void* dst;
-//			VK_CHECK(vkMapMemory(device, m_deviceMem, 0, ma.allocationSize, 0, &dst) );
-//			bx::memCopy(dst, _data, _size);
-//			vkUnmapMemory(device, m_deviceMem);
+				if (vsize > 0)
+				{
+					bufferInfo[bufferCount].buffer = scratchBuffer.m_buffer;
+					bufferInfo[bufferCount].offset = 0;
+					bufferInfo[bufferCount].range  = vsize;
 
-			// staging buffer
-			VkBuffer stagingBuffer;
-			VkDeviceMemory stagingMem;
-			bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-			bci.pNext = NULL;
-			bci.flags = 0;
-			bci.size = _size;
-			bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-			bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-			bci.queueFamilyIndexCount = 0;
-			bci.pQueueFamilyIndices = NULL;
+					wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+					wds[wdsCount].pNext            = NULL;
+					wds[wdsCount].dstSet           = descriptorSet;
+					wds[wdsCount].dstBinding       = vsUniformBinding;
+					wds[wdsCount].dstArrayElement  = 0;
+					wds[wdsCount].descriptorCount  = 1;
+					wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+					wds[wdsCount].pImageInfo       = NULL;
+					wds[wdsCount].pBufferInfo      = &bufferInfo[bufferCount];
+					wds[wdsCount].pTexelBufferView = NULL;
+					++wdsCount;
+					++bufferCount;
+				}
 
-			VK_CHECK(vkCreateBuffer(device
-				, &bci
-				, allocatorCb
-				, &stagingBuffer
-			) );
+				if (fsize > 0)
+				{
+					bufferInfo[bufferCount].buffer = scratchBuffer.m_buffer;
+					bufferInfo[bufferCount].offset = 0;
+					bufferInfo[bufferCount].range  = fsize;
 
-			vkGetBufferMemoryRequirements(device, stagingBuffer, &mr);
+					wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+					wds[wdsCount].pNext            = NULL;
+					wds[wdsCount].dstSet           = descriptorSet;
+					wds[wdsCount].dstBinding       = fsUniformBinding;
+					wds[wdsCount].dstArrayElement  = 0;
+					wds[wdsCount].descriptorCount  = 1;
+					wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+					wds[wdsCount].pImageInfo       = NULL;
+					wds[wdsCount].pBufferInfo      = &bufferInfo[bufferCount];
+					wds[wdsCount].pTexelBufferView = NULL;
+					++wdsCount;
+					++bufferCount;
+				}
+			}
 
-			VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &stagingMem) );
+			vkUpdateDescriptorSets(m_device, wdsCount, wds, 0, NULL);
+		}
 
-			VK_CHECK(vkBindBufferMemory(device, stagingBuffer, stagingMem, 0) );
+		bool isVisible(Frame* _render, OcclusionQueryHandle _handle, bool _visible)
+		{
+			return _visible == (0 != _render->m_occlusion[_handle.idx]);
+		}
 
-			void* dst;
-			VK_CHECK(vkMapMemory(device, stagingMem, 0, mr.size, 0, &dst) );
-			bx::memCopy(dst, _data, _size);
-			vkUnmapMemory(device, stagingMem);
+		void clearQuad(VkCommandBuffer _commandBuffer, const Rect& _rect, const Clear& _clear, const float _palette[][4])
+		{
+			VkClearRect rect[1];
+			rect[0].rect.offset.x      = _rect.m_x;
+			rect[0].rect.offset.y      = _rect.m_y;
+			rect[0].rect.extent.width  = _rect.m_width;
+			rect[0].rect.extent.height = _rect.m_height;
+			rect[0].baseArrayLayer = 0;
+			rect[0].layerCount     = 1;
 
-			VkCommandBuffer commandBuffer = s_renderVK->beginNewCommand();
-			// copy buffer to buffer
+			uint32_t numMrt = 1;
+			FrameBufferHandle fbh = m_fbh;
+			if (isValid(fbh) )
 			{
-				VkBufferCopy region;
-				region.srcOffset = 0;
-				region.dstOffset = 0;
-				region.size      = _size;
-
-				vkCmdCopyBuffer(commandBuffer, stagingBuffer, m_buffer, 1, &region);
+				const FrameBufferVK& fb = m_frameBuffers[fbh.idx];
+				numMrt = fb.m_num;
 			}
-			s_renderVK->submitCommandAndWait(commandBuffer);
-
-			vkFreeMemory(device, stagingMem, allocatorCb);
-			vkDestroy(stagingBuffer);
-		}
-	}
 
-	void BufferVK::update(VkCommandBuffer _commandBuffer, uint32_t _offset, uint32_t _size, void* _data, bool _discard)
-	{
-		BX_UNUSED(_commandBuffer, _discard);
-//		void* dst;
-//		VkDevice device = s_renderVK->m_device;
-//		VK_CHECK(vkMapMemory(device, m_deviceMem, _offset, _size, 0, &dst) );
-//		bx::memCopy(dst, _data, _size);
-//		vkUnmapMemory(device, m_deviceMem);
+			VkClearAttachment attachments[BGFX_CONFIG_MAX_FRAME_BUFFERS];
+			uint32_t mrt = 0;
 
-		// staging buffer
-		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-		VkDevice device = s_renderVK->m_device;
-		VkBuffer stagingBuffer;
-		VkDeviceMemory stagingMem;
-		VkBufferCreateInfo bci;
-		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		bci.pNext = NULL;
-		bci.flags = 0;
-		bci.size = _size;
-		bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			if (true //NULL != m_currentColor
+			&&  BGFX_CLEAR_COLOR & _clear.m_flags)
+			{
+				if (BGFX_CLEAR_COLOR_USE_PALETTE & _clear.m_flags)
+				{
+					for (uint32_t ii = 0; ii < numMrt; ++ii)
+					{
+						attachments[mrt].colorAttachment = mrt;
+						attachments[mrt].aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+						uint8_t index = bx::min<uint8_t>(BGFX_CONFIG_MAX_COLOR_PALETTE-1, _clear.m_index[ii]);
+						bx::memCopy(&attachments[mrt].clearValue.color.float32, _palette[index], 16);
+						++mrt;
+					}
+				}
+				else
+				{
+					float frgba[4] =
+					{
+						_clear.m_index[0] * 1.0f / 255.0f,
+						_clear.m_index[1] * 1.0f / 255.0f,
+						_clear.m_index[2] * 1.0f / 255.0f,
+						_clear.m_index[3] * 1.0f / 255.0f,
+					};
+
+					for (uint32_t ii = 0; ii < numMrt; ++ii)
+					{
+						attachments[mrt].colorAttachment = mrt;
+						attachments[mrt].aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+						bx::memCopy(&attachments[mrt].clearValue.color.float32, frgba, 16);
+						++mrt;
+					}
+				}
+			}
+
+			if (true //NULL != m_currentDepthStencil
+			&& (BGFX_CLEAR_DEPTH | BGFX_CLEAR_STENCIL) & _clear.m_flags)
+			{
+				attachments[mrt].colorAttachment = mrt;
+				attachments[mrt].aspectMask = 0;
+				attachments[mrt].aspectMask |= (_clear.m_flags & BGFX_CLEAR_DEPTH  ) ? VK_IMAGE_ASPECT_DEPTH_BIT   : 0;
+				attachments[mrt].aspectMask |= (_clear.m_flags & BGFX_CLEAR_STENCIL) ? VK_IMAGE_ASPECT_STENCIL_BIT : 0;
+
+				attachments[mrt].clearValue.depthStencil.stencil = _clear.m_stencil;
+				attachments[mrt].clearValue.depthStencil.depth   = _clear.m_depth;
+				++mrt;
+			}
+
+			if (mrt > 0)
+			{
+				vkCmdClearAttachments(_commandBuffer
+					, mrt
+					, attachments
+					, BX_COUNTOF(rect)
+					, rect
+					);
+			}
+		}
+
+		uint64_t kick(VkSemaphore _wait = VK_NULL_HANDLE, VkSemaphore _signal = VK_NULL_HANDLE)
+		{
+			VkPipelineStageFlags stageFlags = 0
+				| VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+				;
+
+			VkSubmitInfo si;
+			si.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			si.pNext = NULL;
+			si.waitSemaphoreCount = VK_NULL_HANDLE != _wait;
+			si.pWaitSemaphores    = &_wait;
+			si.pWaitDstStageMask  = &stageFlags;
+			si.commandBufferCount = 1;
+			si.pCommandBuffers    = &m_commandBuffers[m_frameIdx];
+			si.signalSemaphoreCount = VK_NULL_HANDLE != _signal;
+			si.pSignalSemaphores    = &_signal;
+
+			VK_CHECK(vkResetFences(m_device, 1, &m_fence[m_frameIdx]) );
+			VK_CHECK(vkQueueSubmit(m_queueGraphics, 1, &si, m_fence[m_frameIdx]) );
+			m_fenceFrameNum[m_frameIdx] = m_frameNum;
+			return 0;
+		}
+
+		void finish()
+		{
+			finishAll();
+		}
+
+		void finishAll()
+		{
+			VK_CHECK(vkQueueWaitIdle(m_queueGraphics) );
+		}
+
+		// Frame command buffer is begun by first resource update of the frame, or by submit.
+		// Updates are recorded in order before draw calls, instead of waiting for queue to
+		// become idle, and their staging buffers are released with frame slot.
+		VkCommandBuffer beginFrame()
+		{
+			if (VK_NULL_HANDLE == m_commandBuffer)
+			{
+				// Wait only for frame that used this slot last time, and let other frames run
+				// on GPU while this one is recorded.
+				m_frameIdx = (m_frameIdx + 1) % m_numFramesInFlight;
+				waitFrame(m_frameIdx);
+				++m_frameNum;
+
+				m_captureElapsed = -bx::getHPCounter();
+				captureFrame(m_frameIdx);
+				m_captureElapsed += bx::getHPCounter();
+
+				m_scratchBuffer[m_frameIdx].reset();
+
+				beginRecordFrame();
+
+				VkCommandBufferBeginInfo cbbi;
+				cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+				cbbi.pNext = NULL;
+				cbbi.flags = 0
+					| VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+					;
+				cbbi.pInheritanceInfo = NULL;
+				m_commandBuffer = m_commandBuffers[m_frameIdx];
+				VK_CHECK(vkBeginCommandBuffer(m_commandBuffer, &cbbi) );
+			}
+
+			return m_commandBuffer;
+		}
+
+		// Waits until GPU is done with frame slot, and destroys objects released while
+		// slot was recorded.
+		void waitFrame(uint32_t _frameIdx)
+		{
+			VK_CHECK(vkWaitForFences(m_device, 1, &m_fence[_frameIdx], VK_TRUE, UINT64_MAX) );
+			m_completedFrameNum = bx::max(m_completedFrameNum, m_fenceFrameNum[_frameIdx]);
+			releaseFrame(_frameIdx);
+		}
+
+		uint32_t getNumFramesPending() const
+		{
+			uint32_t num = 0;
+			for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+			{
+				num += VK_NOT_READY == vkGetFenceStatus(m_device, m_fence[ii]);
+			}
+
+			return num;
+		}
+
+		typedef void (*ReleaseFn)(uint64_t _handle);
+
+		void deferRelease(ReleaseFn _fn, uint64_t _handle)
+		{
+			Release release = { _fn, _handle };
+			m_release[m_frameIdx].push_back(release);
+		}
+
+		void releaseFrame(uint32_t _frameIdx)
+		{
+			ReleaseArray& release = m_release[_frameIdx];
+			for (uint32_t ii = 0, num = uint32_t(release.size() ); ii < num; ++ii)
+			{
+				release[ii].m_fn(release[ii].m_handle);
+			}
+
+			release.clear();
+		}
+
+		void destroyFences()
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_fence); ++ii)
+			{
+				vkDestroy(m_fence[ii]);
+			}
+		}
+
+		int32_t selectMemoryType(uint32_t _memoryTypeBits, uint32_t _propertyFlags, int32_t _startIndex = 0) const
+		{
+			for (int32_t ii = _startIndex, num = m_memoryProperties.memoryTypeCount; ii < num; ++ii)
+			{
+				const VkMemoryType& memType = m_memoryProperties.memoryTypes[ii];
+				if ( (0 != ( (1<<ii) & _memoryTypeBits) )
+				&& ( (memType.propertyFlags & _propertyFlags) == _propertyFlags) )
+				{
+					return ii;
+				}
+			}
+
+			BX_TRACE("Failed to find memory that supports flags 0x%08x.", _propertyFlags);
+			return -1;
+		}
+
+		VkResult allocateMemory(const VkMemoryRequirements* requirements, VkMemoryPropertyFlags propertyFlags, VkDeviceMemory* memory) const
+		{
+			VkMemoryAllocateInfo ma;
+			ma.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+			ma.pNext = NULL;
+			ma.allocationSize = requirements->size;
+
+			VkResult result = VK_ERROR_UNKNOWN;
+			int32_t searchIndex = -1;
+			do
+			{
+				searchIndex++;
+				searchIndex = selectMemoryType(requirements->memoryTypeBits, propertyFlags, searchIndex);
+				if (searchIndex >= 0)
+				{
+					ma.memoryTypeIndex = searchIndex;
+					result = vkAllocateMemory(m_device
+						, &ma
+						, m_allocatorCb
+						, memory
+					);
+				}
+			}
+			while (result != VK_SUCCESS && searchIndex >= 0);
+
+			return result;
+		}
+
+		VkCommandBuffer beginNewCommand(VkCommandBufferUsageFlagBits commandBufferUsageFlag = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT)
+		{
+			VkCommandBufferAllocateInfo cbai;
+			cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			cbai.pNext = NULL;
+			cbai.commandPool = m_commandPool;
+			cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			cbai.commandBufferCount = 1;
+
+			VkCommandBuffer commandBuffer;
+			VK_CHECK(vkAllocateCommandBuffers(m_device, &cbai, &commandBuffer) );
+
+			VkCommandBufferBeginInfo cbbi;
+			cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			cbbi.pNext = NULL;
+			cbbi.flags = commandBufferUsageFlag;
+			cbbi.pInheritanceInfo = NULL;
+			VK_CHECK(vkBeginCommandBuffer(commandBuffer, &cbbi) );
+
+			// Frames still in flight might be using resources this command is about to
+			// overwrite.
+			vkCmdPipelineBarrier(commandBuffer
+				, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+				, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+				, 0
+				, 0
+				, NULL
+				, 0
+				, NULL
+				, 0
+				, NULL
+				);
+
+			return commandBuffer;
+		}
+
+		void submitCommandAndWait(VkCommandBuffer commandBuffer)
+		{
+			vkEndCommandBuffer(commandBuffer);
+
+			VkSubmitInfo submitInfo;
+			submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			submitInfo.pNext = NULL;
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &commandBuffer;
+			submitInfo.waitSemaphoreCount = 0;
+			submitInfo.pWaitSemaphores = NULL;
+			submitInfo.signalSemaphoreCount = 0;
+			submitInfo.pSignalSemaphores = NULL;
+			submitInfo.pWaitDstStageMask = NULL;
+
+			VK_CHECK(vkQueueSubmit(m_queueGraphics, 1, &submitInfo, VK_NULL_HANDLE) );
+			VK_CHECK(vkQueueWaitIdle(m_queueGraphics) );
+
+			vkFreeCommandBuffers(m_device, m_commandPool, 1, &commandBuffer);
+		}
+
+		VkResult createReadbackBuffer(uint32_t _size, VkBuffer& _buffer, VkDeviceMemory& _memory)
+		{
+			VkBufferCreateInfo bci;
+			bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bci.pNext = NULL;
+			bci.flags = 0;
+			bci.size  = _size;
+			bci.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			bci.queueFamilyIndexCount = 0;
+			bci.pQueueFamilyIndices   = NULL;
+
+			VkResult result = vkCreateBuffer(m_device, &bci, m_allocatorCb, &_buffer);
+
+			if (VK_SUCCESS != result)
+			{
+				return result;
+			}
+
+			VkMemoryRequirements mr;
+			vkGetBufferMemoryRequirements(m_device, _buffer, &mr);
+
+			result = allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &_memory);
+
+			if (VK_SUCCESS != result)
+			{
+				vkDestroy(_buffer);
+				return result;
+			}
+
+			return vkBindBufferMemory(m_device, _buffer, _memory, 0);
+		}
+
+		// Copies mip 0 of color image in transfer source layout into buffer, and makes it
+		// visible to host once command buffer is finished.
+		void readbackImage(VkCommandBuffer _commandBuffer, VkImage _image, uint32_t _width, uint32_t _height, VkBuffer _buffer)
+		{
+			VkBufferImageCopy bic;
+			bic.bufferOffset      = 0;
+			bic.bufferRowLength   = 0;
+			bic.bufferImageHeight = 0;
+			bic.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+			bic.imageSubresource.mipLevel       = 0;
+			bic.imageSubresource.baseArrayLayer = 0;
+			bic.imageSubresource.layerCount     = 1;
+			bic.imageOffset.x = 0;
+			bic.imageOffset.y = 0;
+			bic.imageOffset.z = 0;
+			bic.imageExtent.width  = _width;
+			bic.imageExtent.height = _height;
+			bic.imageExtent.depth  = 1;
+
+			vkCmdCopyImageToBuffer(_commandBuffer
+				, _image
+				, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+				, _buffer
+				, 1
+				, &bic
+				);
+
+			VkMemoryBarrier mb;
+			mb.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			mb.pNext = NULL;
+			mb.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			mb.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+
+			vkCmdPipelineBarrier(_commandBuffer
+				, VK_PIPELINE_STAGE_TRANSFER_BIT
+				, VK_PIPELINE_STAGE_HOST_BIT
+				, 0
+				, 1
+				, &mb
+				, 0
+				, NULL
+				, 0
+				, NULL
+				);
+		}
+
+#define NUM_SWAPCHAIN_IMAGE 4
+		VkAllocationCallbacks*   m_allocatorCb;
+		VkDebugReportCallbackEXT m_debugReportCallback;
+		VkInstance       m_instance;
+		VkPhysicalDevice m_physicalDevice;
+
+		VkPhysicalDeviceProperties       m_deviceProperties;
+		VkPhysicalDeviceMemoryProperties m_memoryProperties;
+		VkPhysicalDeviceFeatures         m_deviceFeatures;
+
+		VkSwapchainCreateInfoKHR m_sci;
+		VkSurfaceKHR       m_surface;
+		VkSwapchainKHR     m_swapchain;
+		uint32_t           m_numSwapchainImages;
+		VkSurfaceFormatKHR m_backBufferColorFormat;
+		VkSurfaceFormatKHR m_backBufferColorFormatSrgb;
+		VkImageLayout      m_backBufferColorImageLayout[NUM_SWAPCHAIN_IMAGE];
+		VkImage            m_backBufferColorImage[NUM_SWAPCHAIN_IMAGE];
+		VkDeviceMemory     m_backBufferColorMemory[NUM_SWAPCHAIN_IMAGE];
+		VkImageView        m_backBufferColorImageView[NUM_SWAPCHAIN_IMAGE];
+		VkFramebuffer      m_backBufferColor[NUM_SWAPCHAIN_IMAGE];
+		VkCommandBuffer    m_commandBuffers[NUM_SWAPCHAIN_IMAGE];
+		VkCommandBuffer    m_commandBuffer; //!< Frame command buffer while it's recorded, otherwise NULL.
+		bool               m_needToRefreshSwapchain;
+		bool               m_headless;
+
+		VkFormat           m_backBufferDepthStencilFormat;
+		VkDeviceMemory     m_backBufferDepthStencilMemory;
+		VkImage            m_backBufferDepthStencilImage;
+		VkImageView        m_backBufferDepthStencilImageView;
+
+		ScratchBufferVK    m_scratchBuffer[NUM_SWAPCHAIN_IMAGE];
+		VkSemaphore        m_presentDone[NUM_SWAPCHAIN_IMAGE];
+		VkSemaphore        m_renderDone[NUM_SWAPCHAIN_IMAGE];
+		VkFence            m_fence[NUM_SWAPCHAIN_IMAGE];
+
+		struct Release
+		{
+			ReleaseFn m_fn;
+			uint64_t  m_handle;
+		};
+
+		typedef stl::vector<Release> ReleaseArray;
+		ReleaseArray m_release[NUM_SWAPCHAIN_IMAGE];
+
+		uint32_t m_numFramesInFlight;
+		uint32_t m_frameIdx;
+		uint64_t m_frameNum;
+		uint64_t m_completedFrameNum;
+		uint64_t m_fenceFrameNum[NUM_SWAPCHAIN_IMAGE];
+		bool     m_needPresent;
+
+		VkBuffer       m_captureBuffer[NUM_SWAPCHAIN_IMAGE];
+		VkDeviceMemory m_captureMemory[NUM_SWAPCHAIN_IMAGE];
+		bool           m_capturePending[NUM_SWAPCHAIN_IMAGE];
+		uint32_t       m_captureSize;
+		int64_t        m_captureElapsed;
+
+		TimerQueryVK     m_gpuTimer;
+		OcclusionQueryVK m_occlusionQuery;
+
+		uint32_t m_qfiGraphics;
+		uint32_t m_qfiCompute;
+
+		VkDevice m_device;
+		VkQueue  m_queueGraphics;
+		VkQueue  m_queueCompute;
+		VkRenderPass m_renderPass;
+		VkDescriptorPool m_descriptorPool;
+		VkPipelineCache m_pipelineCache;
+		VkCommandPool m_commandPool;
+
+		void* m_renderDocDll;
+		void* m_vulkan1Dll;
+
+		IndexBufferVK m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
+		VertexBufferVK m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
+		ShaderVK m_shaders[BGFX_CONFIG_MAX_SHADERS];
+		ProgramVK m_program[BGFX_CONFIG_MAX_PROGRAMS];
+		TextureVK m_textures[BGFX_CONFIG_MAX_TEXTURES];
+		VertexLayout m_vertexLayouts[BGFX_CONFIG_MAX_VERTEX_LAYOUTS];
+		FrameBufferVK m_frameBuffers[BGFX_CONFIG_MAX_FRAME_BUFFERS];
+		void* m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t m_uniformSize[BGFX_CONFIG_MAX_UNIFORMS];
+		Matrix4 m_predefinedUniforms[PredefinedUniform::Count];
+		UniformRegistry m_uniformReg;
+
+		StateCacheT<VkPipeline> m_pipelineStateCache;
+		StateCacheT<VkDescriptorSetLayout> m_descriptorSetLayoutCache;
+		StateCacheT<VkRenderPass> m_renderPassCache;
+		StateCacheT<VkSampler> m_samplerCache;
+
+		Resolution m_resolution;
+		uint32_t m_maxAnisotropy;
+		bool m_depthClamp;
+		bool m_wireframe;
+
+		TextVideoMem m_textVideoMem;
+
+		uint8_t m_fsScratch[64<<10];
+		uint8_t m_vsScratch[64<<10];
+
+		uint32_t m_backBufferColorIdx;
+		FrameBufferHandle m_fbh;
+
+		struct RecordThread
+		{
+			bx::Thread    m_thread;
+			bx::Semaphore m_start;
+			RecorderVK    m_recorder;
+			ViewState     m_viewState;
+
+			VkCommandPool    m_commandPool[NUM_SWAPCHAIN_IMAGE];
+			VkDescriptorPool m_descriptorPool[NUM_SWAPCHAIN_IMAGE];
+			stl::vector<VkCommandBuffer> m_commandBuffers[NUM_SWAPCHAIN_IMAGE];
+			uint32_t m_numCommandBuffers;
+
+			void*    m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
+			void*    m_uniformCopy[BGFX_CONFIG_MAX_UNIFORMS];
+			uint32_t m_uniformCopySize[BGFX_CONFIG_MAX_UNIFORMS];
+			uint8_t  m_fsScratch[64<<10];
+			uint8_t  m_vsScratch[64<<10];
+		};
+
+		static constexpr uint32_t kMaxRecordChunks = 2*(BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS+1);
+
+		struct RecordJob
+		{
+			Frame*       m_render;
+			ViewState*   m_viewState;
+			const Clear* m_clear;
+			Rect         m_rect;
+			Rect         m_clearRect;
+			Rect         m_viewScissorRect;
+			bool         m_viewHasScissor;
+			uint16_t     m_view;
+			uint32_t     m_begin;
+			uint32_t     m_numChunks;
+			uint32_t     m_next;
+			uint32_t     m_chunk[kMaxRecordChunks+1];
+			VkCommandBuffer m_commandBuffer[kMaxRecordChunks];
+			VkCommandBufferInheritanceInfo m_inheritance;
+		};
+
+		RecorderVK    m_drawRecorder;
+		RecordJob     m_recordJob;
+		RecordThread* m_recordThread[BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS+1];
+		uint32_t      m_numRecordThreads;
+		bx::Semaphore m_recordDone;
+		bx::Mutex     m_cacheMutex;
+		bool          m_recordParallel;
+		bool          m_recordExit;
+	};
+
+	static RendererContextVK* s_renderVK;
+
+	RendererContextI* rendererCreate(const Init& _init)
+	{
+		s_renderVK = BX_NEW(g_allocator, RendererContextVK);
+		if (!s_renderVK->init(_init) )
+		{
+			BX_DELETE(g_allocator, s_renderVK);
+			s_renderVK = NULL;
+		}
+		return s_renderVK;
+	}
+
+	void rendererDestroy()
+	{
+		s_renderVK->shutdown();
+		BX_DELETE(g_allocator, s_renderVK);
+		s_renderVK = NULL;
+	}
+
+#define VK_DESTROY_FUNC(_name)                                                               \
+			void vkDestroy(Vk##_name& _obj)                                                  \
+			{                                                                                \
+				if (VK_NULL_HANDLE != _obj)                                                  \
+				{                                                                            \
+					vkDestroy##_name(s_renderVK->m_device, _obj, s_renderVK->m_allocatorCb); \
+					_obj = VK_NULL_HANDLE;                                                   \
+				}                                                                            \
+			}
+VK_DESTROY
+#undef VK_DESTROY_FUNC
+
+#define VK_DESTROY_FUNC(_name)                                                                               \
+			void release(Vk##_name& _obj)                                                                    \
+			{                                                                                                \
+				if (VK_NULL_HANDLE != _obj)                                                                  \
+				{                                                                                            \
+					struct Deleter                                                                           \
+					{                                                                                        \
+						static void destroy(uint64_t _handle)                                                \
+						{                                                                                    \
+							vkDestroy##_name(s_renderVK->m_device, (::Vk##_name)_handle, s_renderVK->m_allocatorCb); \
+						}                                                                                    \
+					};                                                                                       \
+					s_renderVK->deferRelease(Deleter::destroy, (uint64_t)_obj.vk);                           \
+					_obj = VK_NULL_HANDLE;                                                                   \
+				}                                                                                            \
+			}
+VK_DESTROY
+#undef VK_DESTROY_FUNC
+
+	void release(VkDeviceMemory& _memory)
+	{
+		if (VK_NULL_HANDLE != _memory)
+		{
+			struct Deleter
+			{
+				static void destroy(uint64_t _handle)
+				{
+					vkFreeMemory(s_renderVK->m_device, (VkDeviceMemory)_handle, s_renderVK->m_allocatorCb);
+				}
+			};
+
+			s_renderVK->deferRelease(Deleter::destroy, (uint64_t)_memory);
+			_memory = VK_NULL_HANDLE;
+		}
+	}
+
+	void ScratchBufferVK::create(uint32_t _size, uint32_t _maxDescriptors)
+	{
+		m_maxDescriptors = _maxDescriptors;
+		m_currentDs = 0;
+		m_descriptorSet  = (VkDescriptorSet*)BX_ALLOC(g_allocator, m_maxDescriptors * sizeof(VkDescriptorSet) );
+		bx::memSet(m_descriptorSet, 0, sizeof(VkDescriptorSet) * m_maxDescriptors);
+
+		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		VkDevice device = s_renderVK->m_device;
+
+		VkBufferCreateInfo bci;
+		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bci.pNext = NULL;
+		bci.flags = 0;
+		bci.size  = _size;
+		bci.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		bci.queueFamilyIndexCount = 0;
+		bci.pQueueFamilyIndices   = NULL;
+
+		VK_CHECK(vkCreateBuffer(
+			  device
+			, &bci
+			, allocatorCb
+			, &m_buffer
+			) );
+
+		VkMemoryRequirements mr;
+		vkGetBufferMemoryRequirements(
+			  device
+			, m_buffer
+			, &mr
+			);
+
+		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &m_deviceMem) );
+
+		m_size = (uint32_t)mr.size;
+		m_pos  = 0;
+
+		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem, 0) );
+
+		VK_CHECK(vkMapMemory(device, m_deviceMem, 0, m_size, 0, (void**)&m_data) );
+	}
+
+	void ScratchBufferVK::destroy()
+	{
+		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		VkDevice device = s_renderVK->m_device;
+
+		reset();
+		BX_FREE(g_allocator, m_descriptorSet);
+
+		vkUnmapMemory(device, m_deviceMem);
+		vkDestroy(m_buffer);
+		vkFreeMemory(device
+			, m_deviceMem
+			, allocatorCb
+			);
+	}
+
+	void ScratchBufferVK::reset()
+	{
+		if (m_currentDs > 0)
+		{
+			vkFreeDescriptorSets(
+				  s_renderVK->m_device
+				, s_renderVK->m_descriptorPool
+				, m_currentDs
+				, m_descriptorSet
+				);
+		}
+
+		bx::memSet(m_descriptorSet, 0, sizeof(VkDescriptorSet) * m_maxDescriptors);
+		m_pos = 0;
+		m_currentDs = 0;
+	}
+
+	VkResult ImageVK::create(VkFormat _format, const VkExtent3D& _extent)
+	{
+		VkResult result;
+
+		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		VkDevice device = s_renderVK->m_device;
+
+		VkImageCreateInfo ici;
+		ici.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		ici.pNext = NULL;
+		ici.flags = 0;
+		ici.imageType = VK_IMAGE_TYPE_2D;
+		ici.format = _format;
+		ici.extent = _extent;
+		ici.mipLevels   = 1;
+		ici.arrayLayers = 1;
+		ici.samples = VK_SAMPLE_COUNT_1_BIT;
+		ici.tiling  = VK_IMAGE_TILING_OPTIMAL;
+		ici.usage   = 0
+			| VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
+			| VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+			;
+		ici.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		ici.queueFamilyIndexCount = 0;
+		ici.pQueueFamilyIndices   = 0;
+		ici.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		result = vkCreateImage(device, &ici, allocatorCb, &m_image);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("vkCreateImage failed %d: %s.", result, getName(result) );
+			return result;
+		}
+
+		VkMemoryRequirements mr;
+		vkGetImageMemoryRequirements(device, m_image, &mr);
+
+		result = s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_memory);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("vkAllocateMemory failed %d: %s.", result, getName(result) );
+			destroy();
+			return result;
+		}
+
+		result = vkBindImageMemory(device, m_image, m_memory, 0);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("vkBindImageMemory failed %d: %s.", result, getName(result) );
+			destroy();
+			return result;
+		}
+
+		VkImageViewCreateInfo ivci;
+		ivci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		ivci.pNext = NULL;
+		ivci.flags = 0;
+		ivci.image    = m_image;
+		ivci.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		ivci.format   = _format;
+		ivci.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+		ivci.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+		ivci.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+		ivci.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+		ivci.subresourceRange.aspectMask = 0
+			| VK_IMAGE_ASPECT_DEPTH_BIT
+			| VK_IMAGE_ASPECT_STENCIL_BIT
+			;
+		ivci.subresourceRange.baseMipLevel   = 0;
+		ivci.subresourceRange.levelCount     = 1;
+		ivci.subresourceRange.baseArrayLayer = 0;
+		ivci.subresourceRange.layerCount     = 1;
+		result = vkCreateImageView(device, &ivci, allocatorCb, &m_imageView);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("vkCreateImageView failed %d: %s.", result, getName(result) );
+			destroy();
+			return result;
+		}
+
+		return VK_SUCCESS;
+	}
+
+	void ImageVK::destroy()
+	{
+		vkDestroy(m_imageView);
+		vkDestroy(m_image);
+		if (VK_NULL_HANDLE != m_memory)
+		{
+			vkFreeMemory(s_renderVK->m_device, m_memory, s_renderVK->m_allocatorCb);
+			m_memory = VK_NULL_HANDLE;
+		}
+	}
+
+	void BufferVK::create(uint32_t _size, void* _data, uint16_t _flags, bool _vertex, uint32_t _stride)
+	{
+		BX_UNUSED(_stride);
+
+		m_size    = _size;
+		m_flags   = _flags;
+		m_dynamic = NULL == _data;
+
+		bool storage  = m_flags & BGFX_BUFFER_COMPUTE_READ_WRITE;
+		bool indirect = m_flags & BGFX_BUFFER_DRAW_INDIRECT;
+		VkBufferCreateInfo bci;
+		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bci.pNext = NULL;
+		bci.flags = 0;
+		bci.size  = _size;
+		bci.usage = 0
+//			| (m_dynamic            ? VK_BUFFER_USAGE_TRANSFER_DST_BIT    : 0)
+			| (_vertex              ? VK_BUFFER_USAGE_VERTEX_BUFFER_BIT   : VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+			| (storage || indirect  ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT  : 0)
+			| (indirect             ? VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT : 0)
+			| VK_BUFFER_USAGE_TRANSFER_DST_BIT
+			;
+		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		bci.queueFamilyIndexCount = 0;
+		bci.pQueueFamilyIndices   = NULL;
+
+		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		VkDevice device = s_renderVK->m_device;
+		VK_CHECK(vkCreateBuffer(device
+			, &bci
+			, allocatorCb
+			, &m_buffer
+			) );
+
+		VkMemoryRequirements mr;
+		vkGetBufferMemoryRequirements(device, m_buffer, &mr);
+
+		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_deviceMem) );
+
+		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem, 0) );
+
+		if (!m_dynamic)
+		{
+//			void* dst;
+//			VK_CHECK(vkMapMemory(device, m_deviceMem, 0, ma.allocationSize, 0, &dst) );
+//			bx::memCopy(dst, _data, _size);
+//			vkUnmapMemory(device, m_deviceMem);
+
+			// staging buffer
+			VkBuffer stagingBuffer;
+			VkDeviceMemory stagingMem;
+			bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bci.pNext = NULL;
+			bci.flags = 0;
+			bci.size = _size;
+			bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+			bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			bci.queueFamilyIndexCount = 0;
+			bci.pQueueFamilyIndices = NULL;
+
+			VK_CHECK(vkCreateBuffer(device
+				, &bci
+				, allocatorCb
+				, &stagingBuffer
+			) );
+
+			vkGetBufferMemoryRequirements(device, stagingBuffer, &mr);
+
+			VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &stagingMem) );
+
+			VK_CHECK(vkBindBufferMemory(device, stagingBuffer, stagingMem, 0) );
+
+			void* dst;
+			VK_CHECK(vkMapMemory(device, stagingMem, 0, mr.size, 0, &dst) );
+			bx::memCopy(dst, _data, _size);
+			vkUnmapMemory(device, stagingMem);
+
+			VkCommandBuffer commandBuffer = s_renderVK->beginNewCommand();
+			// copy buffer to buffer
+			{
+				VkBufferCopy region;
+				region.srcOffset = 0;
+				region.dstOffset = 0;
+				region.size      = _size;
+
+				vkCmdCopyBuffer(commandBuffer, stagingBuffer, m_buffer, 1, &region);
+			}
+			s_renderVK->submitCommandAndWait(commandBuffer);
+
+			vkFreeMemory(device, stagingMem, allocatorCb);
+			vkDestroy(stagingBuffer);
+		}
+	}
+
+	void BufferVK::update(VkCommandBuffer _commandBuffer, uint32_t _offset, uint32_t _size, void* _data, bool _discard)
+	{
+		BX_UNUSED(_discard);
+//		void* dst;
+//		VkDevice device = s_renderVK->m_device;
+//		VK_CHECK(vkMapMemory(device, m_deviceMem, _offset, _size, 0, &dst) );
+//		bx::memCopy(dst, _data, _size);
+//		vkUnmapMemory(device, m_deviceMem);
+
+		// staging buffer
+		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		VkDevice device = s_renderVK->m_device;
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingMem;
+		VkBufferCreateInfo bci;
+		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bci.pNext = NULL;
+		bci.flags = 0;
+		bci.size = _size;
+		bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 		bci.queueFamilyIndexCount = 0;
 		bci.pQueueFamilyIndices = NULL;
 
-		VK_CHECK(vkCreateBuffer(device
-			, &bci
-			, allocatorCb
-			, &stagingBuffer
-		) );
+		VK_CHECK(vkCreateBuffer(device
+			, &bci
+			, allocatorCb
+			, &stagingBuffer
+		) );
+
+		VkMemoryRequirements mr;
+		vkGetBufferMemoryRequirements(device
+			, stagingBuffer
+			, &mr
+		);
+
+		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &stagingMem) );
+
+		VK_CHECK(vkBindBufferMemory(device, stagingBuffer, stagingMem, 0) );
+
+		void* dst;
+		VK_CHECK(vkMapMemory(device, stagingMem, 0, mr.size, 0, &dst) );
+		bx::memCopy(dst, _data, _size);
+		vkUnmapMemory(device, stagingMem);
+
+		VkBufferCopy region;
+		region.srcOffset = 0;
+		region.dstOffset = _offset;
+		region.size      = _size;
+
+		if (VK_NULL_HANDLE != _commandBuffer)
+		{
+			// Record copy into frame command buffer. Previous frames might still read
+			// from this buffer, and draws recorded later in this frame must see result.
+			VkMemoryBarrier mb;
+			mb.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			mb.pNext         = NULL;
+			mb.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+			mb.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+			vkCmdPipelineBarrier(_commandBuffer
+				, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+				, VK_PIPELINE_STAGE_TRANSFER_BIT
+				, 0
+				, 1
+				, &mb
+				, 0
+				, NULL
+				, 0
+				, NULL
+				);
+
+			vkCmdCopyBuffer(_commandBuffer, stagingBuffer, m_buffer, 1, &region);
+
+			// Dynamic buffers can also be read by compute shaders and indirect draws.
+			mb.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			mb.dstAccessMask = 0
+				| VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT
+				| VK_ACCESS_INDEX_READ_BIT
+				| VK_ACCESS_INDIRECT_COMMAND_READ_BIT
+				| VK_ACCESS_SHADER_READ_BIT
+				| VK_ACCESS_SHADER_WRITE_BIT
+				;
+
+			vkCmdPipelineBarrier(_commandBuffer
+				, VK_PIPELINE_STAGE_TRANSFER_BIT
+				, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+				, 0
+				, 1
+				, &mb
+				, 0
+				, NULL
+				, 0
+				, NULL
+				);
+
+			release(stagingBuffer);
+			release(stagingMem);
+			return;
+		}
+
+		VkCommandBuffer commandBuffer = s_renderVK->beginNewCommand();
+		vkCmdCopyBuffer(commandBuffer, stagingBuffer, m_buffer, 1, &region);
+		s_renderVK->submitCommandAndWait(commandBuffer);
+
+		vkFreeMemory(device, stagingMem, allocatorCb);
+		vkDestroy(stagingBuffer);
+	}
+
+	void BufferVK::destroy()
+	{
+		if (VK_NULL_HANDLE != m_buffer)
+		{
+			release(m_buffer);
+			release(m_deviceMem);
+			m_dynamic = false;
+		}
+	}
+
+	void VertexBufferVK::create(uint32_t _size, void* _data, VertexLayoutHandle _layoutHandle, uint16_t _flags)
+	{
+		BufferVK::create(_size, _data, _flags, true);
+		m_layoutHandle = _layoutHandle;
+	}
+
+	void ShaderVK::create(const Memory* _mem)
+	{
+		bx::MemoryReader reader(_mem->data, _mem->size);
+
+		uint32_t magic;
+		bx::read(&reader, magic);
+
+		VkShaderStageFlagBits shaderStage;
+		BX_UNUSED(shaderStage);
+
+		if (isShaderType(magic, 'C') )
+		{
+			shaderStage = VK_SHADER_STAGE_COMPUTE_BIT;
+		}
+		else if (isShaderType(magic, 'F') )
+		{
+			shaderStage = VK_SHADER_STAGE_FRAGMENT_BIT;
+		}
+		else if (isShaderType(magic, 'V') )
+		{
+			shaderStage = VK_SHADER_STAGE_VERTEX_BIT;
+		}
+
+		const bool fragment = isShaderType(magic, 'F');
+
+		uint32_t hashIn;
+		bx::read(&reader, hashIn);
+
+		uint32_t hashOut;
+
+		if (isShaderVerLess(magic, 6) )
+		{
+			hashOut = hashIn;
+		}
+		else
+		{
+			bx::read(&reader, hashOut);
+		}
+
+		uint16_t count;
+		bx::read(&reader, count);
+
+		m_numPredefined = 0;
+		m_numUniforms = count;
+
+		BX_TRACE("%s Shader consts %d"
+			, getShaderTypeName(magic)
+			, count
+			);
+
+		uint8_t fragmentBit = fragment ? kUniformFragmentBit : 0;
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+		{
+			m_bindInfo[ii].uniformHandle  = BGFX_INVALID_HANDLE;
+			m_bindInfo[ii].type           = BindType::Count;
+			m_bindInfo[ii].binding        = 0;
+			m_bindInfo[ii].samplerBinding = 0;
+		}
+
+		if (0 < count)
+		{
+			for (uint32_t ii = 0; ii < count; ++ii)
+			{
+				uint8_t nameSize = 0;
+				bx::read(&reader, nameSize);
+
+				char name[256];
+				bx::read(&reader, &name, nameSize);
+				name[nameSize] = '\0';
+
+				uint8_t type = 0;
+				bx::read(&reader, type);
+
+				uint8_t num;
+				bx::read(&reader, num);
+
+				uint16_t regIndex;
+				bx::read(&reader, regIndex);
+
+				uint16_t regCount;
+				bx::read(&reader, regCount);
+
+				if (!isShaderVerLess(magic, 8) )
+				{
+					uint16_t texInfo = 0;
+					bx::read(&reader, texInfo);
+				}
+				const char* kind = "invalid";
+
+				PredefinedUniform::Enum predefined = nameToPredefinedUniformEnum(name);
+				if (PredefinedUniform::Count != predefined)
+				{
+					kind = "predefined";
+					m_predefined[m_numPredefined].m_loc   = regIndex;
+					m_predefined[m_numPredefined].m_count = regCount;
+					m_predefined[m_numPredefined].m_type  = uint8_t(predefined|fragmentBit);
+					m_numPredefined++;
+				}
+				else if (UniformType::End == (~kUniformMask & type) )
+				{
+					// regCount is used for descriptor type
+					const bool  isBuffer = regCount == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+					const uint16_t stage = regIndex - (isBuffer ? 16 : 32) - (fragment ? 48 : 0);  // regIndex is used for buffer binding index
+
+					m_bindInfo[stage].type = isBuffer ? BindType::Buffer : BindType::Image;
+					m_bindInfo[stage].uniformHandle  = { 0 };
+					m_bindInfo[stage].binding        = regIndex;
+
+					kind = "storage";
+				}
+				else if (UniformType::Sampler == (~kUniformMask & type) )
+				{
+					const uint16_t stage = regIndex - 16 - (fragment ? 48 : 0); // regIndex is used for image/sampler binding index
+
+					const UniformRegInfo* info = s_renderVK->m_uniformReg.find(name);
+					BX_ASSERT(NULL != info, "User defined uniform '%s' is not found, it won't be set.", name);
+
+					m_bindInfo[stage].uniformHandle    = info->m_handle;
+					m_bindInfo[stage].type             = BindType::Sampler;
+					m_bindInfo[stage].binding          = regIndex;
+					m_bindInfo[stage].samplerBinding   = regIndex + 16;
+
+					kind = "sampler";
+				}
+				else
+				{
+					const UniformRegInfo* info = s_renderVK->m_uniformReg.find(name);
+					BX_ASSERT(NULL != info, "User defined uniform '%s' is not found, it won't be set.", name);
+
+					if (NULL != info)
+					{
+						if (NULL == m_constantBuffer)
+						{
+							m_constantBuffer = UniformBuffer::create(1024);
+						}
+
+						kind = "user";
+						m_constantBuffer->writeUniformHandle( (UniformType::Enum)(type|fragmentBit), regIndex, info->m_handle, regCount);
+					}
+				}
+
+
+				BX_TRACE("\t%s: %s (%s), num %2d, r.index %3d, r.count %2d"
+					, kind
+					, name
+					, getUniformTypeName(UniformType::Enum(type&~kUniformMask) )
+					, num
+					, regIndex
+					, regCount
+					);
+				BX_UNUSED(kind);
+			}
+
+			if (NULL != m_constantBuffer)
+			{
+				m_constantBuffer->finish();
+			}
+		}
+
+		uint32_t shaderSize;
+		bx::read(&reader, shaderSize);
+
+		const void* code = reader.getDataPtr();
+		bx::skip(&reader, shaderSize+1);
+
+		m_code = alloc(shaderSize);
+		bx::memCopy(m_code->data, code, shaderSize);
+
+		VkShaderModuleCreateInfo smci;
+		smci.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		smci.pNext = NULL;
+		smci.flags = 0;
+		smci.codeSize = m_code->size;
+		smci.pCode    = (const uint32_t*)m_code->data;
+
+//		disassemble(bx::getDebugOut(), m_code->data, m_code->size);
+
+		VK_CHECK(vkCreateShaderModule(
+			  s_renderVK->m_device
+			, &smci
+			, s_renderVK->m_allocatorCb
+			, &m_module
+			) );
+
+		bx::memSet(m_attrMask,  0, sizeof(m_attrMask) );
+		bx::memSet(m_attrRemap, 0, sizeof(m_attrRemap) );
+
+		bx::read(&reader, m_numAttrs);
+
+		for (uint8_t ii = 0; ii < m_numAttrs; ++ii)
+		{
+			uint16_t id;
+			bx::read(&reader, id);
+
+			Attrib::Enum attr = idToAttrib(id);
+
+			if (Attrib::Count != attr)
+			{
+				m_attrMask[attr]  = UINT16_MAX;
+				m_attrRemap[attr] = ii;
+			}
+		}
+
+		bx::HashMurmur2A murmur;
+		murmur.begin();
+		murmur.add(hashIn);
+		murmur.add(hashOut);
+		murmur.add(m_code->data, m_code->size);
+		murmur.add(m_numAttrs);
+		murmur.add(m_attrMask,  m_numAttrs);
+		murmur.add(m_attrRemap, m_numAttrs);
+		m_hash = murmur.end();
+
+		bx::read(&reader, m_size);
+
+		// fill binding description with uniform informations
+		uint16_t bidx = 0;
+		if (m_size > 0)
+		{
+			m_uniformBinding = fragment ? 48 : 0;
+
+			VkDescriptorSetLayoutBinding& binding = m_bindings[bidx];
+			binding.stageFlags = VK_SHADER_STAGE_ALL;
+			binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+			binding.binding = m_uniformBinding;
+			binding.pImmutableSamplers = NULL;
+			binding.descriptorCount = 1;
+			bidx++;
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_bindInfo); ++ii)
+		{
+			switch (m_bindInfo[ii].type)
+			{
+				case BindType::Buffer:
+				case BindType::Image:
+				{
+					VkDescriptorSetLayoutBinding& binding = m_bindings[bidx];
+					binding.stageFlags = VK_SHADER_STAGE_ALL;
+					binding.descriptorType = BindType::Buffer == m_bindInfo[ii].type
+						? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+						: VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+					binding.binding = m_bindInfo[ii].binding;
+					binding.pImmutableSamplers = NULL;
+					binding.descriptorCount = 1;
+					bidx++;
+				}
+				break;
+
+				case BindType::Sampler:
+				{
+					VkDescriptorSetLayoutBinding& textureBinding = m_bindings[bidx];
+					textureBinding.stageFlags = VK_SHADER_STAGE_ALL;
+					textureBinding.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+					textureBinding.binding = m_bindInfo[ii].binding;
+					textureBinding.pImmutableSamplers = NULL;
+					textureBinding.descriptorCount = 1;
+					bidx++;
+
+					VkDescriptorSetLayoutBinding& samplerBinding = m_bindings[bidx];
+					samplerBinding.stageFlags = VK_SHADER_STAGE_ALL;
+					samplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+					samplerBinding.binding = m_bindInfo[ii].samplerBinding;
+					samplerBinding.pImmutableSamplers = NULL;
+					samplerBinding.descriptorCount = 1;
+					bidx++;
+				}
+				break;
+
+				default:
+					break;
+			}
+		}
+
+		m_numBindings = bidx;
+	}
+
+	void ShaderVK::destroy()
+	{
+		if (NULL != m_constantBuffer)
+		{
+			UniformBuffer::destroy(m_constantBuffer);
+			m_constantBuffer = NULL;
+		}
+
+		m_numPredefined = 0;
+
+		if (NULL != m_code)
+		{
+			release(m_code);
+			m_code = NULL;
+			m_hash = 0;
+		}
+
+		if (VK_NULL_HANDLE != m_module)
+		{
+			vkDestroy(m_module);
+		}
+	}
+
+	void ProgramVK::create(const ShaderVK* _vsh, const ShaderVK* _fsh)
+	{
+		BX_ASSERT(NULL != _vsh->m_code, "Vertex shader doesn't exist.");
+		m_vsh = _vsh;
+		bx::memCopy(
+			  &m_predefined[0]
+			, _vsh->m_predefined
+			, _vsh->m_numPredefined * sizeof(PredefinedUniform)
+			);
+		m_numPredefined = _vsh->m_numPredefined;
+
+		if (NULL != _fsh)
+		{
+			BX_ASSERT(NULL != _fsh->m_code, "Fragment shader doesn't exist.");
+			m_fsh = _fsh;
+			bx::memCopy(
+				  &m_predefined[m_numPredefined]
+				, _fsh->m_predefined
+				, _fsh->m_numPredefined * sizeof(PredefinedUniform)
+				);
+			m_numPredefined += _fsh->m_numPredefined;
+		}
+
+		for (uint8_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+		{
+			if (isValid(m_vsh->m_bindInfo[stage].uniformHandle) )
+			{
+				m_bindInfo[stage] = m_vsh->m_bindInfo[stage];
+			}
+			else if (NULL != m_fsh && isValid(m_fsh->m_bindInfo[stage].uniformHandle) )
+			{
+				m_bindInfo[stage] = m_fsh->m_bindInfo[stage];
+			}
+		}
+
+		// create exact pipeline layout
+		VkDescriptorSetLayout dsl = VK_NULL_HANDLE;
+
+		uint32_t numBindings = m_vsh->m_numBindings + (m_fsh ? m_fsh->m_numBindings : 0);
+		if (0 < numBindings)
+		{
+			// generate descriptor set layout hash
+			bx::HashMurmur2A murmur;
+			murmur.begin();
+			murmur.add(m_vsh->m_bindings, sizeof(VkDescriptorSetLayoutBinding) * m_vsh->m_numBindings);
+			if (NULL != m_fsh)
+			{
+				murmur.add(m_fsh->m_bindings, sizeof(VkDescriptorSetLayoutBinding) * m_fsh->m_numBindings);
+			}
+			m_descriptorSetLayoutHash = murmur.end();
+
+			dsl = s_renderVK->m_descriptorSetLayoutCache.find(m_descriptorSetLayoutHash);
+
+			if (NULL == dsl)
+			{
+				VkDescriptorSetLayoutBinding bindings[64];
+				bx::memCopy(
+					  bindings
+					, m_vsh->m_bindings
+					, sizeof(VkDescriptorSetLayoutBinding) * m_vsh->m_numBindings
+					);
+				if (NULL != m_fsh)
+				{
+					bx::memCopy(
+						  bindings + m_vsh->m_numBindings
+						, m_fsh->m_bindings
+						, sizeof(VkDescriptorSetLayoutBinding) * m_fsh->m_numBindings
+						);
+				}
+
+				VkDescriptorSetLayoutCreateInfo dslci;
+				dslci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+				dslci.pNext = NULL;
+				dslci.flags = 0;
+				dslci.bindingCount = numBindings;
+				dslci.pBindings = bindings;
+
+				VK_CHECK(vkCreateDescriptorSetLayout(
+					  s_renderVK->m_device
+					, &dslci
+					, s_renderVK->m_allocatorCb
+					, &dsl
+					) );
+
+				s_renderVK->m_descriptorSetLayoutCache.add(m_descriptorSetLayoutHash, dsl);
+			}
+		}
+
+		VkPipelineLayoutCreateInfo plci;
+		plci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		plci.pNext = NULL;
+		plci.flags = 0;
+		plci.pushConstantRangeCount = 0;
+		plci.pPushConstantRanges = NULL;
+		plci.setLayoutCount = (dsl == VK_NULL_HANDLE ? 0 : 1);
+		plci.pSetLayouts = &dsl;
+
+		VK_CHECK(vkCreatePipelineLayout(
+			  s_renderVK->m_device
+			, &plci
+			, s_renderVK->m_allocatorCb
+			, &m_pipelineLayout
+			) );
+	}
+
+	void ProgramVK::destroy()
+	{
+		release(m_pipelineLayout);
+		m_numPredefined = 0;
+		m_vsh = NULL;
+		m_fsh = NULL;
+	}
+
+	void* TextureVK::create(const Memory* _mem, uint64_t _flags, uint8_t _skip)
+	{
+		bimg::ImageContainer imageContainer;
+
+		if (bimg::imageParse(imageContainer, _mem->data, _mem->size) )
+		{
+			VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+			VkDevice device = s_renderVK->m_device;
+
+			const bimg::ImageBlockInfo& blockInfo = bimg::getBlockInfo(imageContainer.m_format);
+			const uint8_t startLod = bx::min<uint8_t>(_skip, imageContainer.m_numMips - 1);
+
+			bimg::TextureInfo ti;
+			bimg::imageGetSize(
+				  &ti
+				, uint16_t(imageContainer.m_width >> startLod)
+				, uint16_t(imageContainer.m_height >> startLod)
+				, uint16_t(imageContainer.m_depth >> startLod)
+				, imageContainer.m_cubeMap
+				, 1 < imageContainer.m_numMips
+				, imageContainer.m_numLayers
+				, imageContainer.m_format
+				);
+
+			ti.numMips = bx::min<uint8_t>(imageContainer.m_numMips - startLod, ti.numMips);
+
+			m_flags     = _flags;
+			m_width     = ti.width;
+			m_height    = ti.height;
+			m_depth     = ti.depth;
+			m_numLayers = ti.numLayers;
+			m_requestedFormat = bgfx::TextureFormat::Enum(imageContainer.m_format);
+			m_textureFormat = getViableTextureFormat(imageContainer);
+			m_format = bimg::isDepth(bimg::TextureFormat::Enum(m_textureFormat) )
+				? s_textureFormat[m_textureFormat].m_fmtDsv
+				: (m_flags & BGFX_TEXTURE_SRGB) ? s_textureFormat[m_textureFormat].m_fmtSrgb : s_textureFormat[m_textureFormat].m_fmt
+				;
+			m_components = s_textureFormat[m_textureFormat].m_mapping;
+
+			const bool convert = m_textureFormat != m_requestedFormat;
+			const uint8_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
+			m_aspectMask = bimg::isDepth(bimg::TextureFormat::Enum(m_textureFormat) )
+				? VK_IMAGE_ASPECT_DEPTH_BIT
+				: VK_IMAGE_ASPECT_COLOR_BIT
+				;
+
+			if (m_format == VK_FORMAT_S8_UINT
+			||  m_format == VK_FORMAT_D16_UNORM_S8_UINT
+			||  m_format == VK_FORMAT_D24_UNORM_S8_UINT
+			||  m_format == VK_FORMAT_D32_SFLOAT_S8_UINT)
+			{
+				m_aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+			}
+
+			if (imageContainer.m_cubeMap)
+			{
+				m_type = VK_IMAGE_VIEW_TYPE_CUBE;
+			}
+			else if (imageContainer.m_depth > 1)
+			{
+				m_type = VK_IMAGE_VIEW_TYPE_3D;
+			}
+			else
+			{
+				m_type = VK_IMAGE_VIEW_TYPE_2D;
+			}
+
+			m_numMips = ti.numMips;
+			m_residentMip = 0;
+			m_numSides = ti.numLayers * (imageContainer.m_cubeMap ? 6 : 1);
+			const uint16_t numSides = ti.numLayers * (imageContainer.m_cubeMap ? 6 : 1);
+			const uint32_t numSrd = numSides * ti.numMips;
+
+			uint32_t kk = 0;
+
+			const bool compressed = bimg::isCompressed(bimg::TextureFormat::Enum(m_textureFormat) );
+			const bool swizzle = TextureFormat::BGRA8 == m_textureFormat && 0 != (m_flags & BGFX_TEXTURE_COMPUTE_WRITE);
+
+			const bool writeOnly    = 0 != (m_flags & BGFX_TEXTURE_RT_WRITE_ONLY);
+			const bool computeWrite = 0 != (m_flags & BGFX_TEXTURE_COMPUTE_WRITE);
+			const bool renderTarget = 0 != (m_flags & BGFX_TEXTURE_RT_MASK);
+			const bool blit         = 0 != (m_flags & BGFX_TEXTURE_BLIT_DST);
+
+			BX_UNUSED(swizzle, writeOnly, computeWrite, renderTarget, blit);
+
+			BX_TRACE(
+				  "Texture %3d: %s (requested: %s), %dx%dx%d%s RT[%c], BO[%c], CW[%c]%s."
+				, (int)(this - s_renderVK->m_textures)
+				, getName( (TextureFormat::Enum)m_textureFormat)
+				, getName( (TextureFormat::Enum)m_requestedFormat)
+				, ti.width
+				, ti.height
+				, ti.depth
+				, imageContainer.m_cubeMap ? "x6" : ""
+				, renderTarget ? 'x' : ' '
+				, writeOnly ? 'x' : ' '
+				, computeWrite ? 'x' : ' '
+				, swizzle ? " (swizzle BGRA8 -> RGBA8)" : ""
+				);
+
+			// decode images
+			struct ImageInfo
+			{
+				uint8_t* data;
+				uint32_t width;
+				uint32_t height;
+				uint32_t depth;
+				uint32_t pitch;
+				uint32_t slice;
+				uint32_t size;
+				uint8_t mipLevel;
+				uint8_t layer;
+			};
+
+			ImageInfo* imageInfos = (ImageInfo*)BX_ALLOC(g_allocator, sizeof(ImageInfo) * numSrd);
+			bx::memSet(imageInfos, 0, sizeof(ImageInfo) * numSrd);
+			uint32_t alignment = 1; // tightly aligned buffer
+			for (uint8_t side = 0; side < numSides; ++side)
+			{
+				for (uint8_t lod = 0; lod < ti.numMips; ++lod)
+				{
+					bimg::ImageMip mip;
+					if (bimg::imageGetRawData(imageContainer, side, lod + startLod, _mem->data, _mem->size, mip) )
+					{
+						if (convert)
+						{
+							const uint32_t pitch = bx::strideAlign(bx::max<uint32_t>(mip.m_width, 4) * bpp / 8, alignment);
+							const uint32_t slice = bx::strideAlign(bx::max<uint32_t>(mip.m_height, 4) * pitch, alignment);
+							const uint32_t size = slice * mip.m_depth;
+
+							uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, size);
+							bimg::imageDecodeToBgra8(
+								  g_allocator
+								, temp
+								, mip.m_data
+								, mip.m_width
+								, mip.m_height
+								, pitch
+								, mip.m_format
+								);
 
-		VkMemoryRequirements mr;
-		vkGetBufferMemoryRequirements(device
-			, stagingBuffer
-			, &mr
-		);
+							imageInfos[kk].data = temp;
+							imageInfos[kk].width = mip.m_width;
+							imageInfos[kk].height = mip.m_height;
+							imageInfos[kk].depth = mip.m_depth;
+							imageInfos[kk].pitch = pitch;
+							imageInfos[kk].slice = slice;
+							imageInfos[kk].size = size;
+							imageInfos[kk].mipLevel = lod;
+							imageInfos[kk].layer = side;
+						}
+						else if (compressed)
+						{
+							const uint32_t pitch = bx::strideAlign( (mip.m_width / blockInfo.blockWidth) * mip.m_blockSize, alignment);
+							const uint32_t slice = bx::strideAlign( (mip.m_height / blockInfo.blockHeight) * pitch, alignment);
+							const uint32_t size = slice * mip.m_depth;
 
-		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &stagingMem) );
+							uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, size);
+							bimg::imageCopy(
+								  temp
+								, mip.m_height / blockInfo.blockHeight
+								, (mip.m_width / blockInfo.blockWidth) * mip.m_blockSize
+								, mip.m_depth
+								, mip.m_data
+								, pitch
+								);
 
-		VK_CHECK(vkBindBufferMemory(device, stagingBuffer, stagingMem, 0) );
+							imageInfos[kk].data = temp;
+							imageInfos[kk].width = mip.m_width;
+							imageInfos[kk].height = mip.m_height;
+							imageInfos[kk].depth = mip.m_depth;
+							imageInfos[kk].pitch = pitch;
+							imageInfos[kk].slice = slice;
+							imageInfos[kk].size = size;
+							imageInfos[kk].mipLevel = lod;
+							imageInfos[kk].layer = side;
+						}
+						else
+						{
+							const uint32_t pitch = bx::strideAlign(mip.m_width * mip.m_bpp / 8, alignment);
+							const uint32_t slice = bx::strideAlign(mip.m_height * pitch, alignment);
+							const uint32_t size = slice * mip.m_depth;
 
-		void* dst;
-		VK_CHECK(vkMapMemory(device, stagingMem, 0, mr.size, 0, &dst) );
-		bx::memCopy(dst, _data, _size);
-		vkUnmapMemory(device, stagingMem);
+							uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, size);
+							bimg::imageCopy(temp
+								, mip.m_height
+								, mip.m_width * mip.m_bpp / 8
+								, mip.m_depth
+								, mip.m_data
+								, pitch
+							);
 
-		VkCommandBuffer commandBuffer = s_renderVK->beginNewCommand();
+							imageInfos[kk].data = temp;
+							imageInfos[kk].width = mip.m_width;
+							imageInfos[kk].height = mip.m_height;
+							imageInfos[kk].depth = mip.m_depth;
+							imageInfos[kk].pitch = pitch;
+							imageInfos[kk].slice = slice;
+							imageInfos[kk].size = size;
+							imageInfos[kk].mipLevel = lod;
+							imageInfos[kk].layer = side;
+						}
+					}
+					++kk;
+				}
+			}
+
+			uint32_t totalMemSize = 0;
+			VkBufferImageCopy* bufferCopyInfo = (VkBufferImageCopy*)BX_ALLOC(g_allocator, sizeof(VkBufferImageCopy) * numSrd);
+			for (uint32_t ii = 0; ii < numSrd; ++ii)
+			{
+				uint32_t idealWidth  = bx::max<uint32_t>(1, m_width  >> imageInfos[ii].mipLevel);
+				uint32_t idealHeight = bx::max<uint32_t>(1, m_height >> imageInfos[ii].mipLevel);
+				bufferCopyInfo[ii].bufferOffset      = totalMemSize;
+				bufferCopyInfo[ii].bufferRowLength   = 0; // assume that image data are tightly aligned
+				bufferCopyInfo[ii].bufferImageHeight = 0; // assume that image data are tightly aligned
+				bufferCopyInfo[ii].imageSubresource.aspectMask     = m_aspectMask;
+				bufferCopyInfo[ii].imageSubresource.mipLevel       = imageInfos[ii].mipLevel;
+				bufferCopyInfo[ii].imageSubresource.baseArrayLayer = imageInfos[ii].layer;
+				bufferCopyInfo[ii].imageSubresource.layerCount     = 1;
+				bufferCopyInfo[ii].imageOffset = { 0, 0, 0 };
+				bufferCopyInfo[ii].imageExtent = { idealWidth, idealHeight, imageInfos[ii].depth };
+				totalMemSize += imageInfos[ii].size;
+			}
+
+			VkBuffer stagingBuffer = VK_NULL_HANDLE;
+			VkDeviceMemory stagingDeviceMem = VK_NULL_HANDLE;
+			if (totalMemSize > 0)
+			{
+				// staging buffer creation
+				VkBufferCreateInfo bci;
+				bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+				bci.pNext = NULL;
+				bci.flags = 0;
+				bci.size = totalMemSize;
+				bci.queueFamilyIndexCount = 0;
+				bci.pQueueFamilyIndices = NULL;
+				bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+				bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+				VK_CHECK(vkCreateBuffer(
+					  device
+					, &bci
+					, allocatorCb
+					, &stagingBuffer
+					) );
+
+				VkMemoryRequirements mr;
+				vkGetBufferMemoryRequirements(
+					  device
+					, stagingBuffer
+					, &mr
+					);
+
+				VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &stagingDeviceMem) );
+
+				VK_CHECK(vkBindBufferMemory(
+					  device
+					, stagingBuffer
+					, stagingDeviceMem
+					, 0
+					) );
+				VK_CHECK(vkMapMemory(
+					  device
+					, stagingDeviceMem
+					, 0
+					, mr.size
+					, 0
+					, (void**)& m_directAccessPtr
+					) );
+
+				uint8_t* mappedMemory = (uint8_t*)m_directAccessPtr;
+
+				// copy image to staging buffer
+				for (uint32_t ii = 0; ii < numSrd; ++ii)
+				{
+					bx::memCopy(mappedMemory, imageInfos[ii].data, imageInfos[ii].size);
+					mappedMemory += imageInfos[ii].size;
+				}
+
+				vkUnmapMemory(device, stagingDeviceMem);
+			}
+
+			// create texture and allocate its device memory
+			VkImageCreateInfo ici;
+			ici.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			ici.pNext = NULL;
+			ici.flags = VK_IMAGE_VIEW_TYPE_CUBE == m_type
+				? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT
+				: 0
+				;
+			ici.pQueueFamilyIndices   = NULL;
+			ici.queueFamilyIndexCount = 0;
+			ici.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
+			ici.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+			ici.usage                 = 0
+				| VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+				| VK_IMAGE_USAGE_TRANSFER_DST_BIT
+				| VK_IMAGE_USAGE_SAMPLED_BIT
+				| (_flags & BGFX_TEXTURE_RT_MASK
+					? (bimg::isDepth( (bimg::TextureFormat::Enum)m_textureFormat)
+						? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
+						: VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT)
+					: 0
+					)
+				| (_flags & BGFX_TEXTURE_COMPUTE_WRITE ? VK_IMAGE_USAGE_STORAGE_BIT : 0)
+				;
+			ici.format        = m_format;
+			ici.samples       = VK_SAMPLE_COUNT_1_BIT;
+			ici.mipLevels     = m_numMips;
+			ici.arrayLayers   = m_numSides;
+			ici.extent.width  = m_width;
+			ici.extent.height = m_height;
+			ici.extent.depth  = m_depth;
+			ici.imageType     = VK_IMAGE_VIEW_TYPE_3D == m_type
+				? VK_IMAGE_TYPE_3D
+				: VK_IMAGE_TYPE_2D
+				;
+			ici.tiling        = VK_IMAGE_TILING_OPTIMAL;
+
+			VK_CHECK(vkCreateImage(device, &ici, allocatorCb, &m_textureImage) );
+
+			VkMemoryRequirements imageMemReq;
+			vkGetImageMemoryRequirements(device, m_textureImage, &imageMemReq);
+
+			VK_CHECK(s_renderVK->allocateMemory(&imageMemReq, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_textureDeviceMem) );
+
+			vkBindImageMemory(device, m_textureImage, m_textureDeviceMem, 0);
+
+			if (stagingBuffer)
+			{
+				VkCommandBuffer commandBuffer = s_renderVK->beginNewCommand();
+				copyBufferToTexture(commandBuffer, stagingBuffer, numSrd, bufferCopyInfo);
+				s_renderVK->submitCommandAndWait(commandBuffer);
+			}
+			else
+			{
+				VkCommandBuffer commandBuffer = s_renderVK->beginNewCommand();
+				setImageMemoryBarrier(
+					  commandBuffer
+					, (m_flags & BGFX_TEXTURE_COMPUTE_WRITE
+						? VK_IMAGE_LAYOUT_GENERAL
+						: VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+					  )
+					);
+				s_renderVK->submitCommandAndWait(commandBuffer);
+			}
+
+			vkFreeMemory(device, stagingDeviceMem, allocatorCb);
+			vkDestroy(stagingBuffer);
+
+			BX_FREE(g_allocator, bufferCopyInfo);
+			for (uint32_t ii = 0; ii < numSrd; ++ii)
+			{
+				BX_FREE(g_allocator, imageInfos[ii].data);
+			}
+			BX_FREE(g_allocator, imageInfos);
+
+			// image view creation
+			{
+				VkImageViewCreateInfo viewInfo;
+				viewInfo.sType      = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+				viewInfo.pNext      = NULL;
+				viewInfo.flags      = 0;
+				viewInfo.image      = m_textureImage;
+				viewInfo.viewType   = m_type;
+				viewInfo.format     = m_format;
+				viewInfo.components = m_components;
+				viewInfo.subresourceRange.aspectMask     = m_aspectMask;
+				viewInfo.subresourceRange.baseMipLevel   = 0;
+				viewInfo.subresourceRange.levelCount     = m_numMips; //m_numMips;
+				viewInfo.subresourceRange.baseArrayLayer = 0;
+				viewInfo.subresourceRange.layerCount     = m_numSides; //(m_type == VK_IMAGE_VIEW_TYPE_CUBE ? 6 : m_numLayers);
+				VK_CHECK(vkCreateImageView(
+					  device
+					, &viewInfo
+					, allocatorCb
+					, &m_textureImageView
+					) );
+			}
 
-		// copy buffer to buffer
-		{
-			VkBufferCopy region;
-			region.srcOffset = 0;
-			region.dstOffset = _offset;
-			region.size      = _size;
+			if ( (m_aspectMask & VK_IMAGE_ASPECT_DEPTH_BIT)
+			&&   (m_aspectMask & VK_IMAGE_ASPECT_STENCIL_BIT) )
+			{
+				VkImageViewCreateInfo viewInfo;
+				viewInfo.sType      = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+				viewInfo.pNext      = NULL;
+				viewInfo.flags      = 0;
+				viewInfo.image      = m_textureImage;
+				viewInfo.viewType   = m_type;
+				viewInfo.format     = m_format;
+				viewInfo.components = m_components;
+				viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_DEPTH_BIT;
+				viewInfo.subresourceRange.baseMipLevel   = 0;
+				viewInfo.subresourceRange.levelCount     = m_numMips; //m_numMips;
+				viewInfo.subresourceRange.baseArrayLayer = 0;
+				viewInfo.subresourceRange.layerCount     = m_numSides; //(m_type == VK_IMAGE_VIEW_TYPE_CUBE ? 6 : m_numLayers);
+				VK_CHECK(vkCreateImageView(
+					device
+					, &viewInfo
+					, allocatorCb
+					, &m_textureImageDepthView
+					) );
+			}
 
-			vkCmdCopyBuffer(commandBuffer, stagingBuffer, m_buffer, 1, &region);
+			// image view creation for storage if needed
+			if (m_flags & BGFX_TEXTURE_COMPUTE_WRITE)
+			{
+				VkImageViewCreateInfo viewInfo;
+				viewInfo.sType      = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+				viewInfo.pNext      = NULL;
+				viewInfo.flags      = 0;
+				viewInfo.image      = m_textureImage;
+				viewInfo.viewType   = m_type == VK_IMAGE_VIEW_TYPE_CUBE
+					? VK_IMAGE_VIEW_TYPE_2D_ARRAY
+					: m_type
+					;
+				viewInfo.format     = m_format;
+				viewInfo.components = m_components;
+				viewInfo.subresourceRange.aspectMask     = m_aspectMask;
+				viewInfo.subresourceRange.baseMipLevel   = 0;
+				viewInfo.subresourceRange.levelCount     = m_numMips; //m_numMips;
+				viewInfo.subresourceRange.baseArrayLayer = 0;
+				viewInfo.subresourceRange.layerCount     = m_numSides; //(m_type == VK_IMAGE_VIEW_TYPE_CUBE ? 6 : m_numLayers);
+				VK_CHECK(vkCreateImageView(
+					  device
+					, &viewInfo
+					, allocatorCb
+					, &m_textureImageStorageView
+					) );
+			}
 		}
 
-		s_renderVK->submitCommandAndWait(commandBuffer);
-
-		vkFreeMemory(device, stagingMem, allocatorCb);
-		vkDestroy(stagingBuffer);
+		return m_directAccessPtr;
 	}
 
-	void BufferVK::destroy()
+	void TextureVK::destroy()
 	{
-		if (VK_NULL_HANDLE != m_buffer)
+		if (m_textureImage)
 		{
-			VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-			VkDevice device = s_renderVK->m_device;
+			release(m_textureImageStorageView);
+			release(m_textureImageDepthView);
+			release(m_textureImageView);
+			release(m_textureImage);
+			release(m_textureDeviceMem);
 
-			vkDestroy(m_buffer);
-			vkFreeMemory(device
-				, m_deviceMem
-				, allocatorCb
-				);
-			m_dynamic = false;
+			m_currentImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 		}
 	}
 
-	void VertexBufferVK::create(uint32_t _size, void* _data, VertexLayoutHandle _layoutHandle, uint16_t _flags)
-	{
-		BufferVK::create(_size, _data, _flags, true);
-		m_layoutHandle = _layoutHandle;
-	}
-
-	void ShaderVK::create(const Memory* _mem)
+	void TextureVK::update(VkCommandBuffer _commandBuffer, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem)
 	{
-		bx::MemoryReader reader(_mem->data, _mem->size);
-
-		uint32_t magic;
-		bx::read(&reader, magic);
-
-		VkShaderStageFlagBits shaderStage;
-		BX_UNUSED(shaderStage);
-
-		if (isShaderType(magic, 'C') )
-		{
-			shaderStage = VK_SHADER_STAGE_COMPUTE_BIT;
-		}
-		else if (isShaderType(magic, 'F') )
-		{
-			shaderStage = VK_SHADER_STAGE_FRAGMENT_BIT;
-		}
-		else if (isShaderType(magic, 'V') )
-		{
-			shaderStage = VK_SHADER_STAGE_VERTEX_BIT;
-		}
-
-		const bool fragment = isShaderType(magic, 'F');
-
-		uint32_t hashIn;
-		bx::read(&reader, hashIn);
-
-		uint32_t hashOut;
-
-		if (isShaderVerLess(magic, 6) )
-		{
-			hashOut = hashIn;
-		}
-		else
+		const uint32_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
+		uint32_t rectpitch = _rect.m_width * bpp / 8;
+		uint32_t slicepitch = rectpitch * _rect.m_height;
+		if (bimg::isCompressed(bimg::TextureFormat::Enum(m_textureFormat) ) )
 		{
-			bx::read(&reader, hashOut);
+			const bimg::ImageBlockInfo& blockInfo = bimg::getBlockInfo(bimg::TextureFormat::Enum(m_textureFormat) );
+			rectpitch = (_rect.m_width / blockInfo.blockWidth) * blockInfo.blockSize;
+			slicepitch = (_rect.m_height / blockInfo.blockHeight) * rectpitch;
 		}
+		const uint32_t srcpitch = UINT16_MAX == _pitch ? rectpitch : _pitch;
+		const uint32_t size     = UINT16_MAX == _pitch ? slicepitch  * _depth: _rect.m_height * _pitch * _depth;
+		const bool convert = m_textureFormat != m_requestedFormat;
 
-		uint16_t count;
-		bx::read(&reader, count);
-
-		m_numPredefined = 0;
-		m_numUniforms = count;
-
-		BX_TRACE("%s Shader consts %d"
-			, getShaderTypeName(magic)
-			, count
-			);
-
-		uint8_t fragmentBit = fragment ? kUniformFragmentBit : 0;
+		uint8_t* data = _mem->data;
+		uint8_t* temp = NULL;
 
-		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+		if (convert)
 		{
-			m_bindInfo[ii].uniformHandle  = BGFX_INVALID_HANDLE;
-			m_bindInfo[ii].type           = BindType::Count;
-			m_bindInfo[ii].binding        = 0;
-			m_bindInfo[ii].samplerBinding = 0;
+			temp = (uint8_t*)BX_ALLOC(g_allocator, slicepitch);
+			bimg::imageDecodeToBgra8(g_allocator, temp, data, _rect.m_width, _rect.m_height, srcpitch, bimg::TextureFormat::Enum(m_requestedFormat) );
+			data = temp;
 		}
 
-		if (0 < count)
-		{
-			for (uint32_t ii = 0; ii < count; ++ii)
-			{
-				uint8_t nameSize = 0;
-				bx::read(&reader, nameSize);
-
-				char name[256];
-				bx::read(&reader, &name, nameSize);
-				name[nameSize] = '\0';
-
-				uint8_t type = 0;
-				bx::read(&reader, type);
-
-				uint8_t num;
-				bx::read(&reader, num);
-
-				uint16_t regIndex;
-				bx::read(&reader, regIndex);
-
-				uint16_t regCount;
-				bx::read(&reader, regCount);
-
-				if (!isShaderVerLess(magic, 8) )
-				{
-					uint16_t texInfo = 0;
-					bx::read(&reader, texInfo);
-				}
-				const char* kind = "invalid";
-
-				PredefinedUniform::Enum predefined = nameToPredefinedUniformEnum(name);
-				if (PredefinedUniform::Count != predefined)
-				{
-					kind = "predefined";
-					m_predefined[m_numPredefined].m_loc   = regIndex;
-					m_predefined[m_numPredefined].m_count = regCount;
-					m_predefined[m_numPredefined].m_type  = uint8_t(predefined|fragmentBit);
-					m_numPredefined++;
-				}
-				else if (UniformType::End == (~kUniformMask & type) )
-				{
-					// regCount is used for descriptor type
-					const bool  isBuffer = regCount == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-					const uint16_t stage = regIndex - (isBuffer ? 16 : 32) - (fragment ? 48 : 0);  // regIndex is used for buffer binding index
-
-					m_bindInfo[stage].type = isBuffer ? BindType::Buffer : BindType::Image;
-					m_bindInfo[stage].uniformHandle  = { 0 };
-					m_bindInfo[stage].binding        = regIndex;
+		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		VkDevice device = s_renderVK->m_device;
 
-					kind = "storage";
-				}
-				else if (UniformType::Sampler == (~kUniformMask & type) )
-				{
-					const uint16_t stage = regIndex - 16 - (fragment ? 48 : 0); // regIndex is used for image/sampler binding index
+		VkBuffer stagingBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory stagingDeviceMem = VK_NULL_HANDLE;
 
-					const UniformRegInfo* info = s_renderVK->m_uniformReg.find(name);
-					BX_ASSERT(NULL != info, "User defined uniform '%s' is not found, it won't be set.", name);
+		// staging buffer creation
+		VkBufferCreateInfo bci;
+		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bci.pNext = NULL;
+		bci.flags = 0;
+		bci.size = size;
+		bci.queueFamilyIndexCount = 0;
+		bci.pQueueFamilyIndices = NULL;
+		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		VK_CHECK(vkCreateBuffer(
+			  device
+			, &bci
+			, allocatorCb
+			, &stagingBuffer
+			) );
 
-					m_bindInfo[stage].uniformHandle    = info->m_handle;
-					m_bindInfo[stage].type             = BindType::Sampler;
-					m_bindInfo[stage].binding          = regIndex;
-					m_bindInfo[stage].samplerBinding   = regIndex + 16;
+		VkMemoryRequirements mr;
+		vkGetBufferMemoryRequirements(
+			  device
+			, stagingBuffer
+			, &mr
+			);
 
-					kind = "sampler";
-				}
-				else
-				{
-					const UniformRegInfo* info = s_renderVK->m_uniformReg.find(name);
-					BX_ASSERT(NULL != info, "User defined uniform '%s' is not found, it won't be set.", name);
+		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &stagingDeviceMem) );
 
-					if (NULL != info)
-					{
-						if (NULL == m_constantBuffer)
-						{
-							m_constantBuffer = UniformBuffer::create(1024);
-						}
+		void* directAccessPtr = NULL;
+		VK_CHECK(vkBindBufferMemory(device, stagingBuffer, stagingDeviceMem, 0) );
+		VK_CHECK(vkMapMemory(device, stagingDeviceMem, 0, size, 0, (void**)&directAccessPtr) );
+		bx::memCopy(directAccessPtr, data, size);
+		vkUnmapMemory(device, stagingDeviceMem);
 
-						kind = "user";
-						m_constantBuffer->writeUniformHandle( (UniformType::Enum)(type|fragmentBit), regIndex, info->m_handle, regCount);
-					}
-				}
+		VkBufferImageCopy region;
+		region.bufferOffset      = 0;
+		region.bufferRowLength   = (_pitch == UINT16_MAX ? 0 : _pitch * 8 / bpp);
+		region.bufferImageHeight = 0;
+		region.imageSubresource.aspectMask     = m_aspectMask;
+		region.imageSubresource.mipLevel       = _mip;
+		region.imageSubresource.baseArrayLayer = _side;
+		region.imageSubresource.layerCount     = 1;
+		region.imageOffset = { _rect.m_x, _rect.m_y, _z };
+		region.imageExtent = { _rect.m_width, _rect.m_height, _depth };
 
+		// Copy is executed with frame, staging buffer is released once frame slot is free.
+		copyBufferToTexture(_commandBuffer, stagingBuffer, 1, &region);
 
-				BX_TRACE("\t%s: %s (%s), num %2d, r.index %3d, r.count %2d"
-					, kind
-					, name
-					, getUniformTypeName(UniformType::Enum(type&~kUniformMask) )
-					, num
-					, regIndex
-					, regCount
-					);
-				BX_UNUSED(kind);
-			}
+		release(stagingBuffer);
+		release(stagingDeviceMem);
 
-			if (NULL != m_constantBuffer)
-			{
-				m_constantBuffer->finish();
-			}
+		if (NULL != temp)
+		{
+			BX_FREE(g_allocator, temp);
 		}
+	}
 
-		uint32_t shaderSize;
-		bx::read(&reader, shaderSize);
-
-		const void* code = reader.getDataPtr();
-		bx::skip(&reader, shaderSize+1);
+	void TextureVK::copyBufferToTexture(VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, uint32_t bufferImageCopyCount, VkBufferImageCopy* bufferImageCopy)
+	{
+		// image Layout transition into destination optimal
+		setImageMemoryBarrier(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
 
-		m_code = alloc(shaderSize);
-		bx::memCopy(m_code->data, code, shaderSize);
+		// copy buffer to image
+		vkCmdCopyBufferToImage(
+			  commandBuffer
+			, stagingBuffer
+			, m_textureImage
+			, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+			, bufferImageCopyCount
+			, bufferImageCopy
+			);
 
-		VkShaderModuleCreateInfo smci;
-		smci.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-		smci.pNext = NULL;
-		smci.flags = 0;
-		smci.codeSize = m_code->size;
-		smci.pCode    = (const uint32_t*)m_code->data;
+		setImageMemoryBarrier(commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	}
 
-//		disassemble(bx::getDebugOut(), m_code->data, m_code->size);
+	void TextureVK::setImageMemoryBarrier(VkCommandBuffer commandBuffer, VkImageLayout newImageLayout)
+	{
+		if (m_currentImageLayout == newImageLayout)
+			return;
+		bgfx::vk::setImageMemoryBarrier(commandBuffer
+			, m_textureImage
+			, m_aspectMask
+			, m_currentImageLayout
+			, newImageLayout
+			, m_numMips
+			, m_numSides
+			);
+		m_currentImageLayout = newImageLayout;
+	}
 
-		VK_CHECK(vkCreateShaderModule(
-			  s_renderVK->m_device
-			, &smci
-			, s_renderVK->m_allocatorCb
-			, &m_module
-			) );
+	void FrameBufferVK::create(uint8_t _num, const Attachment* _attachment)
+	{
+		// create frame buffer object
+		m_numAttachment = _num;
+		bx::memCopy(m_attachment, _attachment, sizeof(Attachment) * _num);
 
-		bx::memSet(m_attrMask,  0, sizeof(m_attrMask) );
-		bx::memSet(m_attrRemap, 0, sizeof(m_attrRemap) );
+		VkDevice device = s_renderVK->m_device;
+		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		VkRenderPass renderPass = s_renderVK->getRenderPass(_num, _attachment);
 
-		bx::read(&reader, m_numAttrs);
+		TextureVK& firstTexture = s_renderVK->m_textures[m_attachment[0].handle.idx];
+		::VkImageView textureImageViews[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
 
-		for (uint8_t ii = 0; ii < m_numAttrs; ++ii)
+		m_depth.idx = bx::kInvalidHandle;
+		m_num = 0;
+		for (uint8_t ii = 0; ii < m_numAttachment; ++ii)
 		{
-			uint16_t id;
-			bx::read(&reader, id);
-
-			Attrib::Enum attr = idToAttrib(id);
-
-			if (Attrib::Count != attr)
+			TextureVK& texture = s_renderVK->m_textures[m_attachment[ii].handle.idx];
+			textureImageViews[ii] = texture.m_textureImageView;
+			if (texture.m_aspectMask & VK_IMAGE_ASPECT_COLOR_BIT)
 			{
-				m_attrMask[attr]  = UINT16_MAX;
-				m_attrRemap[attr] = ii;
+				m_texture[m_num] = m_attachment[ii].handle;
+				m_num++;
+			}
+			else if (texture.m_aspectMask & VK_IMAGE_ASPECT_DEPTH_BIT)
+			{
+				m_depth = m_attachment[ii].handle;
 			}
 		}
 
-		bx::HashMurmur2A murmur;
-		murmur.begin();
-		murmur.add(hashIn);
-		murmur.add(hashOut);
-		murmur.add(m_code->data, m_code->size);
-		murmur.add(m_numAttrs);
-		murmur.add(m_attrMask,  m_numAttrs);
-		murmur.add(m_attrRemap, m_numAttrs);
-		m_hash = murmur.end();
+		VkFramebufferCreateInfo fci;
+		fci.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		fci.pNext = NULL;
+		fci.flags = 0;
+		fci.renderPass      = renderPass;
+		fci.attachmentCount = m_numAttachment;
+		fci.pAttachments    = textureImageViews;
+		fci.width  = firstTexture.m_width >> m_attachment[0].mip;
+		fci.height = firstTexture.m_height >> m_attachment[0].mip;
+		fci.layers = firstTexture.m_numSides;
+		VK_CHECK( vkCreateFramebuffer(device, &fci, allocatorCb, &m_framebuffer) );
+		m_renderPass = renderPass;
+	}
 
-		bx::read(&reader, m_size);
+	void FrameBufferVK::destroy()
+	{
+		release(m_framebuffer);
+	}
 
-		// fill binding description with uniform informations
-		uint16_t bidx = 0;
-		if (m_size > 0)
-		{
-			m_uniformBinding = fragment ? 48 : 0;
+	void RecorderVK::begin(VkCommandBuffer _commandBuffer, uint16_t _view, const Rect& _viewScissorRect, bool _viewHasScissor)
+	{
+		m_commandBuffer      = _commandBuffer;
+		m_view               = _view;
+		m_viewScissorRect    = _viewScissorRect;
+		m_viewHasScissor     = _viewHasScissor;
+		m_restoreScissor     = false;
+		m_prim               = Topology::Count;
+		m_commandListChanged = true;
+	}
 
-			VkDescriptorSetLayoutBinding& binding = m_bindings[bidx];
-			binding.stageFlags = VK_SHADER_STAGE_ALL;
-			binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-			binding.binding = m_uniformBinding;
-			binding.pImmutableSamplers = NULL;
-			binding.descriptorCount = 1;
-			bidx++;
-		}
+	void RecorderVK::resetStats()
+	{
+		bx::memSet(m_numPrimsSubmitted, 0, sizeof(m_numPrimsSubmitted) );
+		bx::memSet(m_numPrimsRendered,  0, sizeof(m_numPrimsRendered) );
+		bx::memSet(m_numInstances,      0, sizeof(m_numInstances) );
+		m_numIndices = 0;
+	}
 
-		for (uint32_t ii = 0; ii < BX_COUNTOF(m_bindInfo); ++ii)
+	void RecorderVK::resetUniforms()
+	{
+		if (NULL != m_uniformCopy)
 		{
-			switch (m_bindInfo[ii].type)
-			{
-				case BindType::Buffer:
-				case BindType::Image:
-				{
-					VkDescriptorSetLayoutBinding& binding = m_bindings[bidx];
-					binding.stageFlags = VK_SHADER_STAGE_ALL;
-					binding.descriptorType = BindType::Buffer == m_bindInfo[ii].type
-						? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
-						: VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-					binding.binding = m_bindInfo[ii].binding;
-					binding.pImmutableSamplers = NULL;
-					binding.descriptorCount = 1;
-					bidx++;
-				}
-				break;
-
-				case BindType::Sampler:
-				{
-					VkDescriptorSetLayoutBinding& textureBinding = m_bindings[bidx];
-					textureBinding.stageFlags = VK_SHADER_STAGE_ALL;
-					textureBinding.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
-					textureBinding.binding = m_bindInfo[ii].binding;
-					textureBinding.pImmutableSamplers = NULL;
-					textureBinding.descriptorCount = 1;
-					bidx++;
-
-					VkDescriptorSetLayoutBinding& samplerBinding = m_bindings[bidx];
-					samplerBinding.stageFlags = VK_SHADER_STAGE_ALL;
-					samplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
-					samplerBinding.binding = m_bindInfo[ii].samplerBinding;
-					samplerBinding.pImmutableSamplers = NULL;
-					samplerBinding.descriptorCount = 1;
-					bidx++;
-				}
-				break;
-
-				default:
-					break;
-			}
+			bx::memCopy(m_uniforms, s_renderVK->m_uniforms, sizeof(s_renderVK->m_uniforms) );
 		}
-
-		m_numBindings = bidx;
 	}
 
-	void ShaderVK::destroy()
+	void RecorderVK::updateUniform(uint16_t _loc, const void* _data, uint32_t _size)
 	{
-		if (NULL != m_constantBuffer)
+		if (NULL != m_uniformCopy
+		&&  m_uniforms[_loc] != m_uniformCopy[_loc])
 		{
-			UniformBuffer::destroy(m_constantBuffer);
-			m_constantBuffer = NULL;
-		}
+			// Global uniform value is shared with other record threads, copy it before first
+			// write.
+			const uint32_t size = s_renderVK->m_uniformSize[_loc];
 
-		m_numPredefined = 0;
+			if (m_uniformCopySize[_loc] < size)
+			{
+				m_uniformCopy[_loc]     = BX_REALLOC(g_allocator, m_uniformCopy[_loc], size);
+				m_uniformCopySize[_loc] = size;
+			}
 
-		if (NULL != m_code)
-		{
-			release(m_code);
-			m_code = NULL;
-			m_hash = 0;
+			bx::memCopy(m_uniformCopy[_loc], m_uniforms[_loc], size);
+			m_uniforms[_loc] = m_uniformCopy[_loc];
 		}
 
-		if (VK_NULL_HANDLE != m_module)
-		{
-			vkDestroy(m_module);
-		}
+		bx::memCopy(m_uniforms[_loc], _data, _size);
 	}
 
-	void ProgramVK::create(const ShaderVK* _vsh, const ShaderVK* _fsh)
+	void RecorderVK::updateUniforms(UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end, bool _marker)
 	{
-		BX_ASSERT(NULL != _vsh->m_code, "Vertex shader doesn't exist.");
-		m_vsh = _vsh;
-		bx::memCopy(
-			  &m_predefined[0]
-			, _vsh->m_predefined
-			, _vsh->m_numPredefined * sizeof(PredefinedUniform)
-			);
-		m_numPredefined = _vsh->m_numPredefined;
-
-		if (NULL != _fsh)
+		_uniformBuffer->reset(_begin);
+		while (_uniformBuffer->getPos() < _end)
 		{
-			BX_ASSERT(NULL != _fsh->m_code, "Fragment shader doesn't exist.");
-			m_fsh = _fsh;
-			bx::memCopy(
-				  &m_predefined[m_numPredefined]
-				, _fsh->m_predefined
-				, _fsh->m_numPredefined * sizeof(PredefinedUniform)
-				);
-			m_numPredefined += _fsh->m_numPredefined;
-		}
+			uint32_t opcode = _uniformBuffer->read();
 
-		for (uint8_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
-		{
-			if (isValid(m_vsh->m_bindInfo[stage].uniformHandle) )
+			if (UniformType::End == opcode)
 			{
-				m_bindInfo[stage] = m_vsh->m_bindInfo[stage];
+				break;
 			}
-			else if (NULL != m_fsh && isValid(m_fsh->m_bindInfo[stage].uniformHandle) )
+
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+			uint32_t size = g_uniformTypeSize[type]*num;
+			const char* data = _uniformBuffer->read(size);
+			if (UniformType::Count > type)
 			{
-				m_bindInfo[stage] = m_fsh->m_bindInfo[stage];
+				if (copy)
+				{
+					updateUniform(loc, data, size);
+				}
+				else
+				{
+					updateUniform(loc, *(const char**)(data), size);
+				}
+			}
+			else if (_marker
+			     &&  BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
+			{
+				VkDebugUtilsLabelEXT dul;
+				dul.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+				dul.pNext = NULL;
+				dul.pLabelName = data;
+				dul.color[0] = 1.0f;
+				dul.color[1] = 0.0f;
+				dul.color[2] = 0.0f;
+				dul.color[3] = 1.0f;
+				vkCmdInsertDebugUtilsLabelEXT(m_commandBuffer, &dul);
 			}
 		}
+	}
 
-		// create exact pipeline layout
-		VkDescriptorSetLayout dsl = VK_NULL_HANDLE;
+	void RecorderVK::commit(UniformBuffer& _uniformBuffer)
+	{
+		_uniformBuffer.reset();
 
-		uint32_t numBindings = m_vsh->m_numBindings + (m_fsh ? m_fsh->m_numBindings : 0);
-		if (0 < numBindings)
+		for (;;)
 		{
-			// generate descriptor set layout hash
-			bx::HashMurmur2A murmur;
-			murmur.begin();
-			murmur.add(m_vsh->m_bindings, sizeof(VkDescriptorSetLayoutBinding) * m_vsh->m_numBindings);
-			if (NULL != m_fsh)
+			uint32_t opcode = _uniformBuffer.read();
+
+			if (UniformType::End == opcode)
 			{
-				murmur.add(m_fsh->m_bindings, sizeof(VkDescriptorSetLayoutBinding) * m_fsh->m_numBindings);
+				break;
 			}
-			m_descriptorSetLayoutHash = murmur.end();
 
-			dsl = s_renderVK->m_descriptorSetLayoutCache.find(m_descriptorSetLayoutHash);
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
 
-			if (NULL == dsl)
+			const char* data;
+			if (copy)
 			{
-				VkDescriptorSetLayoutBinding bindings[64];
-				bx::memCopy(
-					  bindings
-					, m_vsh->m_bindings
-					, sizeof(VkDescriptorSetLayoutBinding) * m_vsh->m_numBindings
-					);
-				if (NULL != m_fsh)
-				{
-					bx::memCopy(
-						  bindings + m_vsh->m_numBindings
-						, m_fsh->m_bindings
-						, sizeof(VkDescriptorSetLayoutBinding) * m_fsh->m_numBindings
-						);
+				data = _uniformBuffer.read(g_uniformTypeSize[type]*num);
+			}
+			else
+			{
+				UniformHandle handle;
+				bx::memCopy(&handle, _uniformBuffer.read(sizeof(UniformHandle) ), sizeof(UniformHandle) );
+				data = (const char*)m_uniforms[handle.idx];
+			}
+
+#define CASE_IMPLEMENT_UNIFORM(_uniform, _dxsuffix, _type)                   \
+			case UniformType::_uniform:                                  \
+			case UniformType::_uniform|kUniformFragmentBit:         \
+					{                                                    \
+						setShaderUniform(uint8_t(type), loc, data, num); \
+					}                                                    \
+					break;
+
+			switch ( (uint32_t)type)
+			{
+			case UniformType::Mat3:
+			case UniformType::Mat3|kUniformFragmentBit:
+				 {
+					 float* value = (float*)data;
+					 for (uint32_t ii = 0, count = num/3; ii < count; ++ii,  loc += 3*16, value += 9)
+					 {
+						 Matrix4 mtx;
+						 mtx.un.val[ 0] = value[0];
+						 mtx.un.val[ 1] = value[1];
+						 mtx.un.val[ 2] = value[2];
+						 mtx.un.val[ 3] = 0.0f;
+						 mtx.un.val[ 4] = value[3];
+						 mtx.un.val[ 5] = value[4];
+						 mtx.un.val[ 6] = value[5];
+						 mtx.un.val[ 7] = 0.0f;
+						 mtx.un.val[ 8] = value[6];
+						 mtx.un.val[ 9] = value[7];
+						 mtx.un.val[10] = value[8];
+						 mtx.un.val[11] = 0.0f;
+						 setShaderUniform(uint8_t(type), loc, &mtx.un.val[0], 3);
+					 }
 				}
+				break;
 
-				VkDescriptorSetLayoutCreateInfo dslci;
-				dslci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-				dslci.pNext = NULL;
-				dslci.flags = 0;
-				dslci.bindingCount = numBindings;
-				dslci.pBindings = bindings;
+			case UniformType::Sampler:
+			case UniformType::Sampler|kUniformFragmentBit:
+				// do nothing, but VkDescriptorSetImageInfo would be set before drawing
+				break;
+//				CASE_IMPLEMENT_UNIFORM(Sampler, I, int);
+			CASE_IMPLEMENT_UNIFORM(Vec4,    F, float);
+			CASE_IMPLEMENT_UNIFORM(Mat4,    F, float);
 
-				VK_CHECK(vkCreateDescriptorSetLayout(
-					  s_renderVK->m_device
-					, &dslci
-					, s_renderVK->m_allocatorCb
-					, &dsl
-					) );
+			case UniformType::End:
+				break;
 
-				s_renderVK->m_descriptorSetLayoutCache.add(m_descriptorSetLayoutHash, dsl);
+			default:
+				BX_TRACE("%4d: INVALID 0x%08x, t %d, l %d, n %d, c %d", _uniformBuffer.getPos(), opcode, type, loc, num, copy);
+				break;
 			}
+#undef CASE_IMPLEMENT_UNIFORM
 		}
+	}
 
-		VkPipelineLayoutCreateInfo plci;
-		plci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		plci.pNext = NULL;
-		plci.flags = 0;
-		plci.pushConstantRangeCount = 0;
-		plci.pPushConstantRanges = NULL;
-		plci.setLayoutCount = (dsl == VK_NULL_HANDLE ? 0 : 1);
-		plci.pSetLayouts = &dsl;
-
-		VK_CHECK(vkCreatePipelineLayout(
-			  s_renderVK->m_device
-			, &plci
-			, s_renderVK->m_allocatorCb
-			, &m_pipelineLayout
-			) );
+	void RecorderVK::setShaderUniform(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
+	{
+		if (_flags & kUniformFragmentBit)
+		{
+			bx::memCopy(&m_fsScratch[_regIndex], _val, _numRegs*16);
+		}
+		else
+		{
+			bx::memCopy(&m_vsScratch[_regIndex], _val, _numRegs*16);
+		}
 	}
 
-	void ProgramVK::destroy()
+	void RecorderVK::setShaderUniform4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 	{
-		vkDestroy(m_pipelineLayout);
-		m_numPredefined = 0;
-		m_vsh = NULL;
-		m_fsh = NULL;
+		setShaderUniform(_flags, _regIndex, _val, _numRegs);
 	}
 
-	void* TextureVK::create(const Memory* _mem, uint64_t _flags, uint8_t _skip)
+	void RecorderVK::setShaderUniform4x4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 	{
-		bimg::ImageContainer imageContainer;
+		setShaderUniform(_flags, _regIndex, _val, _numRegs);
+	}
 
-		if (bimg::imageParse(imageContainer, _mem->data, _mem->size) )
+	uint32_t RecorderVK::allocScratch(uint32_t _size)
+	{
+		if (m_parallel)
 		{
-			VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-			VkDevice device = s_renderVK->m_device;
-
-			const bimg::ImageBlockInfo& blockInfo = bimg::getBlockInfo(imageContainer.m_format);
-			const uint8_t startLod = bx::min<uint8_t>(_skip, imageContainer.m_numMips - 1);
-
-			bimg::TextureInfo ti;
-			bimg::imageGetSize(
-				  &ti
-				, uint16_t(imageContainer.m_width >> startLod)
-				, uint16_t(imageContainer.m_height >> startLod)
-				, uint16_t(imageContainer.m_depth >> startLod)
-				, imageContainer.m_cubeMap
-				, 1 < imageContainer.m_numMips
-				, imageContainer.m_numLayers
-				, imageContainer.m_format
-				);
-
-			ti.numMips = bx::min<uint8_t>(imageContainer.m_numMips - startLod, ti.numMips);
+			return bx::atomicFetchAndAdd<uint32_t>(&m_scratchBuffer->m_pos, _size);
+		}
 
-			m_flags     = _flags;
-			m_width     = ti.width;
-			m_height    = ti.height;
-			m_depth     = ti.depth;
-			m_numLayers = ti.numLayers;
-			m_requestedFormat = bgfx::TextureFormat::Enum(imageContainer.m_format);
-			m_textureFormat = getViableTextureFormat(imageContainer);
-			m_format = bimg::isDepth(bimg::TextureFormat::Enum(m_textureFormat) )
-				? s_textureFormat[m_textureFormat].m_fmtDsv
-				: (m_flags & BGFX_TEXTURE_SRGB) ? s_textureFormat[m_textureFormat].m_fmtSrgb : s_textureFormat[m_textureFormat].m_fmt
-				;
-			m_components = s_textureFormat[m_textureFormat].m_mapping;
+		const uint32_t pos = m_scratchBuffer->m_pos;
+		m_scratchBuffer->m_pos += _size;
+		return pos;
+	}
 
-			const bool convert = m_textureFormat != m_requestedFormat;
-			const uint8_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
-			m_aspectMask = bimg::isDepth(bimg::TextureFormat::Enum(m_textureFormat) )
-				? VK_IMAGE_ASPECT_DEPTH_BIT
-				: VK_IMAGE_ASPECT_COLOR_BIT
-				;
+	VkResult TimerQueryVK::init()
+	{
+		const VkPhysicalDeviceLimits& limits = s_renderVK->m_deviceProperties.limits;
 
-			if (m_format == VK_FORMAT_S8_UINT
-			||  m_format == VK_FORMAT_D16_UNORM_S8_UINT
-			||  m_format == VK_FORMAT_D24_UNORM_S8_UINT
-			||  m_format == VK_FORMAT_D32_SFLOAT_S8_UINT)
-			{
-				m_aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
-			}
+		m_queryPool = VK_NULL_HANDLE;
+		m_frequency = 0.0f < limits.timestampPeriod
+			? uint64_t(1000000000.0 / double(limits.timestampPeriod) )
+			: 1000000000
+			;
 
-			if (imageContainer.m_cubeMap)
-			{
-				m_type = VK_IMAGE_VIEW_TYPE_CUBE;
-			}
-			else if (imageContainer.m_depth > 1)
-			{
-				m_type = VK_IMAGE_VIEW_TYPE_3D;
-			}
-			else
-			{
-				m_type = VK_IMAGE_VIEW_TYPE_2D;
-			}
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_result); ++ii)
+		{
+			m_result[ii].reset();
+		}
 
-			m_numMips = ti.numMips;
-			m_numSides = ti.numLayers * (imageContainer.m_cubeMap ? 6 : 1);
-			const uint16_t numSides = ti.numLayers * (imageContainer.m_cubeMap ? 6 : 1);
-			const uint32_t numSrd = numSides * ti.numMips;
+		m_control.reset();
 
-			uint32_t kk = 0;
+		if (!limits.timestampComputeAndGraphics)
+		{
+			return VK_ERROR_FEATURE_NOT_PRESENT;
+		}
 
-			const bool compressed = bimg::isCompressed(bimg::TextureFormat::Enum(m_textureFormat) );
-			const bool swizzle = TextureFormat::BGRA8 == m_textureFormat && 0 != (m_flags & BGFX_TEXTURE_COMPUTE_WRITE);
+		VkQueryPoolCreateInfo qpci;
+		qpci.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		qpci.pNext = NULL;
+		qpci.flags = 0;
+		qpci.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+		qpci.queryCount = m_control.m_size * 2;
+		qpci.pipelineStatistics = 0;
 
-			const bool writeOnly    = 0 != (m_flags & BGFX_TEXTURE_RT_WRITE_ONLY);
-			const bool computeWrite = 0 != (m_flags & BGFX_TEXTURE_COMPUTE_WRITE);
-			const bool renderTarget = 0 != (m_flags & BGFX_TEXTURE_RT_MASK);
-			const bool blit         = 0 != (m_flags & BGFX_TEXTURE_BLIT_DST);
+		VkResult result = vkCreateQueryPool(s_renderVK->m_device, &qpci, s_renderVK->m_allocatorCb, &m_queryPool);
+		if (VK_SUCCESS != result)
+		{
+			m_queryPool = VK_NULL_HANDLE;
+			return result;
+		}
 
-			BX_UNUSED(swizzle, writeOnly, computeWrite, renderTarget, blit);
+		return VK_SUCCESS;
+	}
 
-			BX_TRACE(
-				  "Texture %3d: %s (requested: %s), %dx%dx%d%s RT[%c], BO[%c], CW[%c]%s."
-				, (int)(this - s_renderVK->m_textures)
-				, getName( (TextureFormat::Enum)m_textureFormat)
-				, getName( (TextureFormat::Enum)m_requestedFormat)
-				, ti.width
-				, ti.height
-				, ti.depth
-				, imageContainer.m_cubeMap ? "x6" : ""
-				, renderTarget ? 'x' : ' '
-				, writeOnly ? 'x' : ' '
-				, computeWrite ? 'x' : ' '
-				, swizzle ? " (swizzle BGRA8 -> RGBA8)" : ""
-				);
+	void TimerQueryVK::shutdown()
+	{
+		vkDestroy(m_queryPool);
+	}
 
-			// decode images
-			struct ImageInfo
-			{
-				uint8_t* data;
-				uint32_t width;
-				uint32_t height;
-				uint32_t depth;
-				uint32_t pitch;
-				uint32_t slice;
-				uint32_t size;
-				uint8_t mipLevel;
-				uint8_t layer;
-			};
+	uint32_t TimerQueryVK::begin(uint32_t _resultIdx)
+	{
+		if (VK_NULL_HANDLE == m_queryPool)
+		{
+			return UINT32_MAX;
+		}
 
-			ImageInfo* imageInfos = (ImageInfo*)BX_ALLOC(g_allocator, sizeof(ImageInfo) * numSrd);
-			bx::memSet(imageInfos, 0, sizeof(ImageInfo) * numSrd);
-			uint32_t alignment = 1; // tightly aligned buffer
-			for (uint8_t side = 0; side < numSides; ++side)
-			{
-				for (uint8_t lod = 0; lod < ti.numMips; ++lod)
-				{
-					bimg::ImageMip mip;
-					if (bimg::imageGetRawData(imageContainer, side, lod + startLod, _mem->data, _mem->size, mip) )
-					{
-						if (convert)
-						{
-							const uint32_t pitch = bx::strideAlign(bx::max<uint32_t>(mip.m_width, 4) * bpp / 8, alignment);
-							const uint32_t slice = bx::strideAlign(bx::max<uint32_t>(mip.m_height, 4) * pitch, alignment);
-							const uint32_t size = slice * mip.m_depth;
+		while (0 == m_control.reserve(1) )
+		{
+			Result& result = m_result[m_query[m_control.m_read].m_resultIdx];
+			--result.m_pending;
+			m_control.consume(1);
+		}
 
-							uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, size);
-							bimg::imageDecodeToBgra8(
-								  g_allocator
-								, temp
-								, mip.m_data
-								, mip.m_width
-								, mip.m_height
-								, pitch
-								, mip.m_format
-								);
+		Result& result = m_result[_resultIdx];
+		++result.m_pending;
 
-							imageInfos[kk].data = temp;
-							imageInfos[kk].width = mip.m_width;
-							imageInfos[kk].height = mip.m_height;
-							imageInfos[kk].depth = mip.m_depth;
-							imageInfos[kk].pitch = pitch;
-							imageInfos[kk].slice = slice;
-							imageInfos[kk].size = size;
-							imageInfos[kk].mipLevel = lod;
-							imageInfos[kk].layer = side;
-						}
-						else if (compressed)
-						{
-							const uint32_t pitch = bx::strideAlign( (mip.m_width / blockInfo.blockWidth) * mip.m_blockSize, alignment);
-							const uint32_t slice = bx::strideAlign( (mip.m_height / blockInfo.blockHeight) * pitch, alignment);
-							const uint32_t size = slice * mip.m_depth;
+		const uint32_t idx = m_control.m_current;
+		Query& query = m_query[idx];
+		query.m_resultIdx = _resultIdx;
+		query.m_ready     = false;
+		query.m_frameNum  = s_renderVK->m_frameNum;
 
-							uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, size);
-							bimg::imageCopy(
-								  temp
-								, mip.m_height / blockInfo.blockHeight
-								, (mip.m_width / blockInfo.blockWidth) * mip.m_blockSize
-								, mip.m_depth
-								, mip.m_data
-								, pitch
-								);
+		// Must be called outside of render pass, reset is not allowed inside.
+		VkCommandBuffer commandBuffer = s_renderVK->m_commandBuffer;
 
-							imageInfos[kk].data = temp;
-							imageInfos[kk].width = mip.m_width;
-							imageInfos[kk].height = mip.m_height;
-							imageInfos[kk].depth = mip.m_depth;
-							imageInfos[kk].pitch = pitch;
-							imageInfos[kk].slice = slice;
-							imageInfos[kk].size = size;
-							imageInfos[kk].mipLevel = lod;
-							imageInfos[kk].layer = side;
-						}
-						else
-						{
-							const uint32_t pitch = bx::strideAlign(mip.m_width * mip.m_bpp / 8, alignment);
-							const uint32_t slice = bx::strideAlign(mip.m_height * pitch, alignment);
-							const uint32_t size = slice * mip.m_depth;
+		const uint32_t offset = idx * 2 + 0;
+		vkCmdResetQueryPool(commandBuffer, m_queryPool, offset, 2);
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_queryPool, offset);
 
-							uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, size);
-							bimg::imageCopy(temp
-								, mip.m_height
-								, mip.m_width * mip.m_bpp / 8
-								, mip.m_depth
-								, mip.m_data
-								, pitch
-							);
+		m_control.commit(1);
 
-							imageInfos[kk].data = temp;
-							imageInfos[kk].width = mip.m_width;
-							imageInfos[kk].height = mip.m_height;
-							imageInfos[kk].depth = mip.m_depth;
-							imageInfos[kk].pitch = pitch;
-							imageInfos[kk].slice = slice;
-							imageInfos[kk].size = size;
-							imageInfos[kk].mipLevel = lod;
-							imageInfos[kk].layer = side;
-						}
-					}
-					++kk;
-				}
+		return idx;
+	}
+
+	void TimerQueryVK::end(uint32_t _idx)
+	{
+		Query& query = m_query[_idx];
+		query.m_ready = true;
+
+		const uint32_t offset = _idx * 2 + 1;
+		vkCmdWriteTimestamp(s_renderVK->m_commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_queryPool, offset);
+
+		while (update() )
+		{
+		}
+	}
+
+	bool TimerQueryVK::update()
+	{
+		if (0 != m_control.available() )
+		{
+			uint32_t idx = m_control.m_read;
+			Query& query = m_query[idx];
+
+			if (!query.m_ready)
+			{
+				return false;
 			}
 
-			uint32_t totalMemSize = 0;
-			VkBufferImageCopy* bufferCopyInfo = (VkBufferImageCopy*)BX_ALLOC(g_allocator, sizeof(VkBufferImageCopy) * numSrd);
-			for (uint32_t ii = 0; ii < numSrd; ++ii)
+			// Results are read only after fence of frame that wrote them is signaled,
+			// so reading never stalls.
+			if (query.m_frameNum > s_renderVK->m_completedFrameNum)
 			{
-				uint32_t idealWidth  = bx::max<uint32_t>(1, m_width  >> imageInfos[ii].mipLevel);
-				uint32_t idealHeight = bx::max<uint32_t>(1, m_height >> imageInfos[ii].mipLevel);
-				bufferCopyInfo[ii].bufferOffset      = totalMemSize;
-				bufferCopyInfo[ii].bufferRowLength   = 0; // assume that image data are tightly aligned
-				bufferCopyInfo[ii].bufferImageHeight = 0; // assume that image data are tightly aligned
-				bufferCopyInfo[ii].imageSubresource.aspectMask     = m_aspectMask;
-				bufferCopyInfo[ii].imageSubresource.mipLevel       = imageInfos[ii].mipLevel;
-				bufferCopyInfo[ii].imageSubresource.baseArrayLayer = imageInfos[ii].layer;
-				bufferCopyInfo[ii].imageSubresource.layerCount     = 1;
-				bufferCopyInfo[ii].imageOffset = { 0, 0, 0 };
-				bufferCopyInfo[ii].imageExtent = { idealWidth, idealHeight, imageInfos[ii].depth };
-				totalMemSize += imageInfos[ii].size;
+				return false;
 			}
 
-			VkBuffer stagingBuffer = VK_NULL_HANDLE;
-			VkDeviceMemory stagingDeviceMem = VK_NULL_HANDLE;
-			if (totalMemSize > 0)
+			uint64_t timestamp[2];
+			VkResult result = vkGetQueryPoolResults(s_renderVK->m_device
+				, m_queryPool
+				, idx * 2
+				, 2
+				, sizeof(timestamp)
+				, timestamp
+				, sizeof(uint64_t)
+				, VK_QUERY_RESULT_64_BIT
+				);
+
+			if (VK_SUCCESS != result)
 			{
-				// staging buffer creation
-				VkBufferCreateInfo bci;
-				bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-				bci.pNext = NULL;
-				bci.flags = 0;
-				bci.size = totalMemSize;
-				bci.queueFamilyIndexCount = 0;
-				bci.pQueueFamilyIndices = NULL;
-				bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-				bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-				VK_CHECK(vkCreateBuffer(
-					  device
-					, &bci
-					, allocatorCb
-					, &stagingBuffer
-					) );
+				return false;
+			}
 
-				VkMemoryRequirements mr;
-				vkGetBufferMemoryRequirements(
-					  device
-					, stagingBuffer
-					, &mr
-					);
+			m_control.consume(1);
 
-				VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &stagingDeviceMem) );
+			Result& res = m_result[query.m_resultIdx];
+			--res.m_pending;
+			res.m_begin = timestamp[0];
+			res.m_end   = timestamp[1];
 
-				VK_CHECK(vkBindBufferMemory(
-					  device
-					, stagingBuffer
-					, stagingDeviceMem
-					, 0
-					) );
-				VK_CHECK(vkMapMemory(
-					  device
-					, stagingDeviceMem
-					, 0
-					, mr.size
-					, 0
-					, (void**)& m_directAccessPtr
-					) );
+			return true;
+		}
 
-				uint8_t* mappedMemory = (uint8_t*)m_directAccessPtr;
+		return false;
+	}
 
-				// copy image to staging buffer
-				for (uint32_t ii = 0; ii < numSrd; ++ii)
-				{
-					bx::memCopy(mappedMemory, imageInfos[ii].data, imageInfos[ii].size);
-					mappedMemory += imageInfos[ii].size;
-				}
+	VkResult OcclusionQueryVK::init()
+	{
+		VkQueryPoolCreateInfo qpci;
+		qpci.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		qpci.pNext = NULL;
+		qpci.flags = 0;
+		qpci.queryType  = VK_QUERY_TYPE_OCCLUSION;
+		qpci.queryCount = BX_COUNTOF(m_handle);
+		qpci.pipelineStatistics = 0;
+
+		VkResult result = vkCreateQueryPool(s_renderVK->m_device, &qpci, s_renderVK->m_allocatorCb, &m_queryPool);
+		if (VK_SUCCESS != result)
+		{
+			m_queryPool = VK_NULL_HANDLE;
+			return result;
+		}
 
-				vkUnmapMemory(device, stagingDeviceMem);
-			}
+		// Queries must be reset before first use. After that every query is reset when
+		// its result is resolved.
+		VkCommandBuffer commandBuffer = s_renderVK->beginNewCommand();
+		vkCmdResetQueryPool(commandBuffer, m_queryPool, 0, BX_COUNTOF(m_handle) );
+		s_renderVK->submitCommandAndWait(commandBuffer);
 
-			// create texture and allocate its device memory
-			VkImageCreateInfo ici;
-			ici.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-			ici.pNext = NULL;
-			ici.flags = VK_IMAGE_VIEW_TYPE_CUBE == m_type
-				? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT
-				: 0
-				;
-			ici.pQueueFamilyIndices   = NULL;
-			ici.queueFamilyIndexCount = 0;
-			ici.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
-			ici.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
-			ici.usage                 = 0
-				| VK_IMAGE_USAGE_TRANSFER_SRC_BIT
-				| VK_IMAGE_USAGE_TRANSFER_DST_BIT
-				| VK_IMAGE_USAGE_SAMPLED_BIT
-				| (_flags & BGFX_TEXTURE_RT_MASK
-					? (bimg::isDepth( (bimg::TextureFormat::Enum)m_textureFormat)
-						? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
-						: VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT)
-					: 0
-					)
-				| (_flags & BGFX_TEXTURE_COMPUTE_WRITE ? VK_IMAGE_USAGE_STORAGE_BIT : 0)
-				;
-			ici.format        = m_format;
-			ici.samples       = VK_SAMPLE_COUNT_1_BIT;
-			ici.mipLevels     = m_numMips;
-			ici.arrayLayers   = m_numSides;
-			ici.extent.width  = m_width;
-			ici.extent.height = m_height;
-			ici.extent.depth  = m_depth;
-			ici.imageType     = VK_IMAGE_VIEW_TYPE_3D == m_type
-				? VK_IMAGE_TYPE_3D
-				: VK_IMAGE_TYPE_2D
-				;
-			ici.tiling        = VK_IMAGE_TILING_OPTIMAL;
+		m_control.reset();
 
-			VK_CHECK(vkCreateImage(device, &ici, allocatorCb, &m_textureImage) );
+		return VK_SUCCESS;
+	}
 
-			VkMemoryRequirements imageMemReq;
-			vkGetImageMemoryRequirements(device, m_textureImage, &imageMemReq);
+	void OcclusionQueryVK::shutdown()
+	{
+		vkDestroy(m_queryPool);
+	}
 
-			VK_CHECK(s_renderVK->allocateMemory(&imageMemReq, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_textureDeviceMem) );
+	bool OcclusionQueryVK::begin(VkCommandBuffer _commandBuffer, OcclusionQueryHandle _handle)
+	{
+		// Query slots can be recycled only after they are reset outside of render pass,
+		// drop query when all of them are in flight.
+		if (0 == m_control.reserve(1) )
+		{
+			return false;
+		}
 
-			vkBindImageMemory(device, m_textureImage, m_textureDeviceMem, 0);
+		const uint32_t idx = m_control.m_current;
+		m_handle[idx]   = _handle;
+		m_frameNum[idx] = s_renderVK->m_frameNum;
 
-			if (stagingBuffer)
-			{
-				copyBufferToTexture(stagingBuffer, numSrd, bufferCopyInfo);
-			}
-			else
+		vkCmdBeginQuery(_commandBuffer
+			, m_queryPool
+			, idx
+			, s_renderVK->m_deviceFeatures.occlusionQueryPrecise ? VK_QUERY_CONTROL_PRECISE_BIT : 0
+			);
+
+		return true;
+	}
+
+	void OcclusionQueryVK::end(VkCommandBuffer _commandBuffer)
+	{
+		vkCmdEndQuery(_commandBuffer, m_queryPool, m_control.m_current);
+		m_control.commit(1);
+	}
+
+	void OcclusionQueryVK::resolve(VkCommandBuffer _commandBuffer, Frame* _render)
+	{
+		if (VK_NULL_HANDLE == m_queryPool)
+		{
+			return;
+		}
+
+		uint32_t first = m_control.m_read;
+		uint32_t num   = 0;
+
+		while (0 != m_control.available() )
+		{
+			const uint32_t idx = m_control.m_read;
+
+			if (m_frameNum[idx] > s_renderVK->m_completedFrameNum)
 			{
-				VkCommandBuffer commandBuffer = s_renderVK->beginNewCommand();
-				setImageMemoryBarrier(
-					  commandBuffer
-					, (m_flags & BGFX_TEXTURE_COMPUTE_WRITE
-						? VK_IMAGE_LAYOUT_GENERAL
-						: VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-					  )
-					);
-				s_renderVK->submitCommandAndWait(commandBuffer);
+				break;
 			}
 
-			vkFreeMemory(device, stagingDeviceMem, allocatorCb);
-			vkDestroy(stagingBuffer);
-
-			BX_FREE(g_allocator, bufferCopyInfo);
-			for (uint32_t ii = 0; ii < numSrd; ++ii)
+			uint64_t result;
+			if (VK_SUCCESS != vkGetQueryPoolResults(s_renderVK->m_device
+				, m_queryPool
+				, idx
+				, 1
+				, sizeof(result)
+				, &result
+				, sizeof(result)
+				, VK_QUERY_RESULT_64_BIT
+				) )
 			{
-				BX_FREE(g_allocator, imageInfos[ii].data);
+				break;
 			}
-			BX_FREE(g_allocator, imageInfos);
 
-			// image view creation
+			OcclusionQueryHandle handle = m_handle[idx];
+			if (isValid(handle) )
 			{
-				VkImageViewCreateInfo viewInfo;
-				viewInfo.sType      = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-				viewInfo.pNext      = NULL;
-				viewInfo.flags      = 0;
-				viewInfo.image      = m_textureImage;
-				viewInfo.viewType   = m_type;
-				viewInfo.format     = m_format;
-				viewInfo.components = m_components;
-				viewInfo.subresourceRange.aspectMask     = m_aspectMask;
-				viewInfo.subresourceRange.baseMipLevel   = 0;
-				viewInfo.subresourceRange.levelCount     = m_numMips; //m_numMips;
-				viewInfo.subresourceRange.baseArrayLayer = 0;
-				viewInfo.subresourceRange.layerCount     = m_numSides; //(m_type == VK_IMAGE_VIEW_TYPE_CUBE ? 6 : m_numLayers);
-				VK_CHECK(vkCreateImageView(
-					  device
-					, &viewInfo
-					, allocatorCb
-					, &m_textureImageView
-					) );
+				_render->m_occlusion[handle.idx] = int32_t(bx::min<uint64_t>(result, INT32_MAX) );
 			}
 
-			if ( (m_aspectMask & VK_IMAGE_ASPECT_DEPTH_BIT)
-			&&   (m_aspectMask & VK_IMAGE_ASPECT_STENCIL_BIT) )
+			m_control.consume(1);
+
+			if (0 == m_control.m_read)
 			{
-				VkImageViewCreateInfo viewInfo;
-				viewInfo.sType      = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-				viewInfo.pNext      = NULL;
-				viewInfo.flags      = 0;
-				viewInfo.image      = m_textureImage;
-				viewInfo.viewType   = m_type;
-				viewInfo.format     = m_format;
-				viewInfo.components = m_components;
-				viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_DEPTH_BIT;
-				viewInfo.subresourceRange.baseMipLevel   = 0;
-				viewInfo.subresourceRange.levelCount     = m_numMips; //m_numMips;
-				viewInfo.subresourceRange.baseArrayLayer = 0;
-				viewInfo.subresourceRange.layerCount     = m_numSides; //(m_type == VK_IMAGE_VIEW_TYPE_CUBE ? 6 : m_numLayers);
-				VK_CHECK(vkCreateImageView(
-					device
-					, &viewInfo
-					, allocatorCb
-					, &m_textureImageDepthView
-					) );
+				vkCmdResetQueryPool(_commandBuffer, m_queryPool, first, num + 1);
+				first = 0;
+				num   = 0;
 			}
-
-			// image view creation for storage if needed
-			if (m_flags & BGFX_TEXTURE_COMPUTE_WRITE)
+			else
 			{
-				VkImageViewCreateInfo viewInfo;
-				viewInfo.sType      = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-				viewInfo.pNext      = NULL;
-				viewInfo.flags      = 0;
-				viewInfo.image      = m_textureImage;
-				viewInfo.viewType   = m_type == VK_IMAGE_VIEW_TYPE_CUBE
-					? VK_IMAGE_VIEW_TYPE_2D_ARRAY
-					: m_type
-					;
-				viewInfo.format     = m_format;
-				viewInfo.components = m_components;
-				viewInfo.subresourceRange.aspectMask     = m_aspectMask;
-				viewInfo.subresourceRange.baseMipLevel   = 0;
-				viewInfo.subresourceRange.levelCount     = m_numMips; //m_numMips;
-				viewInfo.subresourceRange.baseArrayLayer = 0;
-				viewInfo.subresourceRange.layerCount     = m_numSides; //(m_type == VK_IMAGE_VIEW_TYPE_CUBE ? 6 : m_numLayers);
-				VK_CHECK(vkCreateImageView(
-					  device
-					, &viewInfo
-					, allocatorCb
-					, &m_textureImageStorageView
-					) );
+				++num;
 			}
 		}
 
-		return m_directAccessPtr;
+		if (0 != num)
+		{
+			vkCmdResetQueryPool(_commandBuffer, m_queryPool, first, num);
+		}
 	}
 
-	void TextureVK::destroy()
+	void OcclusionQueryVK::invalidate(OcclusionQueryHandle _handle)
 	{
-		if (m_textureImage)
+		const uint32_t size = m_control.m_size;
+
+		for (uint32_t ii = 0, num = m_control.available(); ii < num; ++ii)
 		{
-			VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-			VkDevice device = s_renderVK->m_device;
+			OcclusionQueryHandle& handle = m_handle[(m_control.m_read + ii) % size];
+			if (handle.idx == _handle.idx)
+			{
+				handle.idx = bgfx::kInvalidHandle;
+			}
+		}
+	}
+
+	int32_t RendererContextVK::recordThread(bx::Thread* /*_self*/, void* _userData)
+	{
+		RecordThread& rt = *(RecordThread*)_userData;
 
-			vkFreeMemory(device, m_textureDeviceMem, allocatorCb);
+		for (;;)
+		{
+			rt.m_start.wait();
 
-			vkDestroy(m_textureImageStorageView);
-			vkDestroy(m_textureImageDepthView);
-			vkDestroy(m_textureImageView);
-			vkDestroy(m_textureImage);
+			if (s_renderVK->m_recordExit)
+			{
+				return bx::kExitSuccess;
+			}
 
-			m_currentImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			s_renderVK->recordChunks(rt);
+			s_renderVK->m_recordDone.post();
 		}
 	}
 
-	void TextureVK::update(VkCommandPool _commandPool, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem)
+	void RendererContextVK::recordDraw(RecorderVK& _rec, Frame* _render, const SortKey& _key, const RenderItem& _renderItem, const RenderBind& _renderBind)
 	{
-		BX_UNUSED(_commandPool);
+		const RenderDraw& draw = _renderItem.draw;
 
-		const uint32_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
-		uint32_t rectpitch = _rect.m_width * bpp / 8;
-		uint32_t slicepitch = rectpitch * _rect.m_height;
-		if (bimg::isCompressed(bimg::TextureFormat::Enum(m_textureFormat) ) )
+		const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
 		{
-			const bimg::ImageBlockInfo& blockInfo = bimg::getBlockInfo(bimg::TextureFormat::Enum(m_textureFormat) );
-			rectpitch = (_rect.m_width / blockInfo.blockWidth) * blockInfo.blockSize;
-			slicepitch = (_rect.m_height / blockInfo.blockHeight) * rectpitch;
+			const bool occluded = true
+				&& isValid(draw.m_occlusionQuery)
+				&& !hasOcclusionQuery
+				&& !isVisible(_render, draw.m_occlusionQuery, 0 != (draw.m_submitFlags&BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE) )
+				;
+
+			if (occluded
+			||  _render->m_frameCache.isZeroArea(_rec.m_viewScissorRect, draw.m_scissor) )
+			{
+//						if (resetState)
+//						{
+//							_rec.m_currentState.clear();
+//							_rec.m_currentState.m_scissor = !draw.m_scissor;
+//							currentBind.clear();
+//						}
+
+				return;
+			}
 		}
-		const uint32_t srcpitch = UINT16_MAX == _pitch ? rectpitch : _pitch;
-		const uint32_t size     = UINT16_MAX == _pitch ? slicepitch  * _depth: _rect.m_height * _pitch * _depth;
-		const bool convert = m_textureFormat != m_requestedFormat;
 
-		uint8_t* data = _mem->data;
-		uint8_t* temp = NULL;
+		const uint64_t newFlags = draw.m_stateFlags;
+		uint64_t changedFlags = _rec.m_currentState.m_stateFlags ^ draw.m_stateFlags;
+		_rec.m_currentState.m_stateFlags = newFlags;
 
-		if (convert)
+		const uint64_t newStencil = draw.m_stencil;
+		uint64_t changedStencil = (_rec.m_currentState.m_stencil ^ draw.m_stencil) & BGFX_STENCIL_FUNC_REF_MASK;
+		_rec.m_currentState.m_stencil = newStencil;
+
+		if (_rec.m_commandListChanged)
 		{
-			temp = (uint8_t*)BX_ALLOC(g_allocator, slicepitch);
-			bimg::imageDecodeToBgra8(g_allocator, temp, data, _rect.m_width, _rect.m_height, srcpitch, bimg::TextureFormat::Enum(m_requestedFormat) );
-			data = temp;
-		}
+			_rec.m_commandListChanged = false;
 
-		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-		VkDevice device = s_renderVK->m_device;
+//					m_commandList->SetGraphicsRootSignature(m_rootSignature);
+//					ID3D12DescriptorHeap* heaps[] = {
+//						m_samplerAllocator.getHeap(),
+//						scratchBuffer.getHeap(),
+//					};
+//					m_commandList->SetDescriptorHeaps(BX_COUNTOF(heaps), heaps);
 
-		VkBuffer stagingBuffer = VK_NULL_HANDLE;
-		VkDeviceMemory stagingDeviceMem = VK_NULL_HANDLE;
+			_rec.m_currentPipeline        = VK_NULL_HANDLE;
+			_rec.m_currentBindHash        = 0;
+			_rec.m_currentDslHash         = 0;
+			_rec.m_currentProgram         = BGFX_INVALID_HANDLE;
+			_rec.m_currentState.clear();
+			_rec.m_currentState.m_scissor = !draw.m_scissor;
+			changedFlags = BGFX_STATE_MASK;
+			changedStencil = packStencil(BGFX_STENCIL_MASK, BGFX_STENCIL_MASK);
+			_rec.m_currentState.m_stateFlags = newFlags;
+			_rec.m_currentState.m_stencil    = newStencil;
+
+			const uint64_t pt = newFlags&BGFX_STATE_PT_MASK;
+			_rec.m_primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
+		}
+
+		_rec.updateUniforms(_render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd, true);
+
+		if (0 != draw.m_streamMask)
+		{
+			_rec.m_currentState.m_streamMask = draw.m_streamMask;
+
+			const uint64_t state = draw.m_stateFlags;
+			const uint64_t f0 = BGFX_STATE_BLEND_FACTOR;
+			const uint64_t f1 = BGFX_STATE_BLEND_INV_FACTOR;
+			const uint64_t f2 = BGFX_STATE_BLEND_FACTOR<<4;
+			const uint64_t f3 = BGFX_STATE_BLEND_INV_FACTOR<<4;
+			bool hasFactor = 0
+				|| f0 == (state & f0)
+				|| f1 == (state & f1)
+				|| f2 == (state & f2)
+				|| f3 == (state & f3)
+				;
 
-		// staging buffer creation
-		VkBufferCreateInfo bci;
-		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		bci.pNext = NULL;
-		bci.flags = 0;
-		bci.size = size;
-		bci.queueFamilyIndexCount = 0;
-		bci.pQueueFamilyIndices = NULL;
-		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-		bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-		VK_CHECK(vkCreateBuffer(
-			  device
-			, &bci
-			, allocatorCb
-			, &stagingBuffer
-			) );
+			const VertexLayout* layouts[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+			uint8_t numStreams = 0;
+			if (UINT8_MAX != draw.m_streamMask)
+			{
+				for (uint32_t idx = 0, streamMask = draw.m_streamMask
+					; 0 != streamMask
+					; streamMask >>= 1, idx += 1, ++numStreams
+					)
+				{
+					const uint32_t ntz = bx::uint32_cnttz(streamMask);
+					streamMask >>= ntz;
+					idx         += ntz;
+
+					_rec.m_currentState.m_stream[idx].m_layoutHandle   = draw.m_stream[idx].m_layoutHandle;
+					_rec.m_currentState.m_stream[idx].m_handle         = draw.m_stream[idx].m_handle;
+					_rec.m_currentState.m_stream[idx].m_startVertex    = draw.m_stream[idx].m_startVertex;
+
+					uint16_t handle = draw.m_stream[idx].m_handle.idx;
+					const VertexBufferVK& vb = m_vertexBuffers[handle];
+					const uint16_t decl = isValid(draw.m_stream[idx].m_layoutHandle)
+						? draw.m_stream[idx].m_layoutHandle.idx
+						: vb.m_layoutHandle.idx
+						;
+					const VertexLayout& layout = m_vertexLayouts[decl];
 
-		VkMemoryRequirements mr;
-		vkGetBufferMemoryRequirements(
-			  device
-			, stagingBuffer
-			, &mr
-			);
+					layouts[numStreams] = &layout;
+				}
+			}
 
-		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &stagingDeviceMem) );
+			VkPipeline pipeline =
+				getPipeline(state
+					, draw.m_stencil
+					, numStreams
+					, layouts
+					, _key.m_program
+					, uint8_t(draw.m_instanceDataStride/16)
+					);
 
-		void* directAccessPtr = NULL;
-		VK_CHECK(vkBindBufferMemory(device, stagingBuffer, stagingDeviceMem, 0) );
-		VK_CHECK(vkMapMemory(device, stagingDeviceMem, 0, size, 0, (void**)&directAccessPtr) );
-		bx::memCopy(directAccessPtr, data, size);
-		vkUnmapMemory(device, stagingDeviceMem);
+			uint16_t scissor = draw.m_scissor;
 
-		VkBufferImageCopy region;
-		region.bufferOffset      = 0;
-		region.bufferRowLength   = (_pitch == UINT16_MAX ? 0 : _pitch * 8 / bpp);
-		region.bufferImageHeight = 0;
-		region.imageSubresource.aspectMask     = m_aspectMask;
-		region.imageSubresource.mipLevel       = _mip;
-		region.imageSubresource.baseArrayLayer = _side;
-		region.imageSubresource.layerCount     = 1;
-		region.imageOffset = { _rect.m_x, _rect.m_y, _z };
-		region.imageExtent = { _rect.m_width, _rect.m_height, _depth };
+			if (pipeline != _rec.m_currentPipeline
+			||  0 != changedStencil)
+			{
+				const uint32_t fstencil = unpackStencil(0, draw.m_stencil);
+				const uint32_t ref = (fstencil&BGFX_STENCIL_FUNC_REF_MASK)>>BGFX_STENCIL_FUNC_REF_SHIFT;
+				vkCmdSetStencilReference(_rec.m_commandBuffer, VK_STENCIL_FRONT_AND_BACK, ref);
+			}
 
-		copyBufferToTexture(stagingBuffer, 1, &region);
+			if (pipeline != _rec.m_currentPipeline
+			|| (hasFactor && _rec.m_blendFactor != draw.m_rgba) )
+			{
+				_rec.m_blendFactor = draw.m_rgba;
 
-		vkFreeMemory(device, stagingDeviceMem, allocatorCb);
-		vkDestroy(stagingBuffer);
+				float bf[4];
+				bf[0] = ( (draw.m_rgba>>24)     )/255.0f;
+				bf[1] = ( (draw.m_rgba>>16)&0xff)/255.0f;
+				bf[2] = ( (draw.m_rgba>> 8)&0xff)/255.0f;
+				bf[3] = ( (draw.m_rgba    )&0xff)/255.0f;
+				vkCmdSetBlendConstants(_rec.m_commandBuffer, bf);
+			}
 
-		if (NULL != temp)
-		{
-			BX_FREE(g_allocator, temp);
-		}
-	}
+			if (0 != (BGFX_STATE_PT_MASK & changedFlags)
+			||  s_primInfo[_rec.m_prim].m_topology != s_primInfo[_rec.m_primIndex].m_topology)
+			{
+				const uint64_t pt = newFlags&BGFX_STATE_PT_MASK;
+				_rec.m_primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
+				_rec.m_prim      = _rec.m_primIndex;
+//						m_commandList->IASetPrimitiveTopology(prim.m_topology);
+			}
 
-	void TextureVK::copyBufferToTexture(VkBuffer stagingBuffer, uint32_t bufferImageCopyCount, VkBufferImageCopy* bufferImageCopy)
-	{
-		VkCommandBuffer commandBuffer = s_renderVK->beginNewCommand();
+			if (_rec.m_currentState.m_scissor != scissor)
+			{
+				_rec.m_currentState.m_scissor = scissor;
 
-		// image Layout transition into destination optimal
-		setImageMemoryBarrier(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+				if (UINT16_MAX == scissor)
+				{
+					if (_rec.m_restoreScissor
+					||  _rec.m_viewHasScissor)
+					{
+						_rec.m_restoreScissor = false;
+						VkRect2D rc;
+						rc.offset.x      = _rec.m_viewScissorRect.m_x;
+						rc.offset.y      = _rec.m_viewScissorRect.m_y;
+						rc.extent.width  = _rec.m_viewScissorRect.m_width;
+						rc.extent.height = _rec.m_viewScissorRect.m_height;
+						vkCmdSetScissor(_rec.m_commandBuffer, 0, 1, &rc);
+					}
+				}
+				else
+				{
+					_rec.m_restoreScissor = true;
+					Rect scissorRect;
+					scissorRect.setIntersect(_rec.m_viewScissorRect, _render->m_frameCache.m_rectCache.m_cache[scissor]);
+
+					VkRect2D rc;
+					rc.offset.x      = scissorRect.m_x;
+					rc.offset.y      = scissorRect.m_y;
+					rc.extent.width  = scissorRect.m_width;
+					rc.extent.height = scissorRect.m_height;
+					vkCmdSetScissor(_rec.m_commandBuffer, 0, 1, &rc);
+				}
+			}
 
-		// copy buffer to image
-		vkCmdCopyBufferToImage(
-			  commandBuffer
-			, stagingBuffer
-			, m_textureImage
-			, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-			, bufferImageCopyCount
-			, bufferImageCopy
-			);
+			if (pipeline != _rec.m_currentPipeline)
+			{
+				_rec.m_currentPipeline = pipeline;
+				vkCmdBindPipeline(_rec.m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+			}
 
-		setImageMemoryBarrier(commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		s_renderVK->submitCommandAndWait(commandBuffer);
-	}
+			bool constantsChanged = false;
+			if (draw.m_uniformBegin < draw.m_uniformEnd
+			||  _rec.m_currentProgram.idx != _key.m_program.idx
+			||  BGFX_STATE_ALPHA_REF_MASK & changedFlags)
+			{
+				_rec.m_currentProgram = _key.m_program;
+				ProgramVK& program = m_program[_rec.m_currentProgram.idx];
 
-	void TextureVK::setImageMemoryBarrier(VkCommandBuffer commandBuffer, VkImageLayout newImageLayout)
-	{
-		if (m_currentImageLayout == newImageLayout)
-			return;
-		bgfx::vk::setImageMemoryBarrier(commandBuffer
-			, m_textureImage
-			, m_aspectMask
-			, m_currentImageLayout
-			, newImageLayout
-			, m_numMips
-			, m_numSides
-			);
-		m_currentImageLayout = newImageLayout;
-	}
+				UniformBuffer* vcb = program.m_vsh->m_constantBuffer;
+				if (NULL != vcb)
+				{
+					_rec.commit(*vcb);
+				}
 
-	void FrameBufferVK::create(uint8_t _num, const Attachment* _attachment)
-	{
-		// create frame buffer object
-		m_numAttachment = _num;
-		bx::memCopy(m_attachment, _attachment, sizeof(Attachment) * _num);
+				UniformBuffer* fcb = program.m_fsh->m_constantBuffer;
+				if (NULL != fcb)
+				{
+					_rec.commit(*fcb);
+				}
 
-		VkDevice device = s_renderVK->m_device;
-		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-		VkRenderPass renderPass = s_renderVK->getRenderPass(_num, _attachment);
+				_rec.m_hasPredefined = 0 < program.m_numPredefined;
+				constantsChanged = true;
+			}
 
-		TextureVK& firstTexture = s_renderVK->m_textures[m_attachment[0].handle.idx];
-		::VkImageView textureImageViews[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+			const ProgramVK& program = m_program[_rec.m_currentProgram.idx];
 
-		m_depth.idx = bx::kInvalidHandle;
-		m_num = 0;
-		for (uint8_t ii = 0; ii < m_numAttachment; ++ii)
-		{
-			TextureVK& texture = s_renderVK->m_textures[m_attachment[ii].handle.idx];
-			textureImageViews[ii] = texture.m_textureImageView;
-			if (texture.m_aspectMask & VK_IMAGE_ASPECT_COLOR_BIT)
+			if (_rec.m_hasPredefined)
 			{
-				m_texture[m_num] = m_attachment[ii].handle;
-				m_num++;
+				uint32_t ref = (newFlags & BGFX_STATE_ALPHA_REF_MASK) >> BGFX_STATE_ALPHA_REF_SHIFT;
+				_rec.m_viewState->m_alphaRef = ref / 255.0f;
+				_rec.m_viewState->setPredefined<4>(&_rec, _rec.m_view, program, _render, draw);
+			}
+
+			if (program.m_descriptorSetLayoutHash != 0)
+			{
+				uint32_t bindHash = bx::hash<bx::HashMurmur2A>(_renderBind.m_bind, sizeof(_renderBind.m_bind) );
+				if (_rec.m_currentBindHash != bindHash
+				||  _rec.m_currentDslHash  != program.m_descriptorSetLayoutHash)
+				{
+					_rec.m_currentBindHash = bindHash;
+					_rec.m_currentDslHash  = program.m_descriptorSetLayoutHash;
+
+					allocDescriptorSet(_rec, program, _renderBind);
+				}
+
+				uint32_t numOffset = 0;
+				uint32_t offsets[2] = { 0, 0 };
+
+				if (constantsChanged
+				||  _rec.m_hasPredefined)
+				{
+					const uint32_t align = uint32_t(m_deviceProperties.limits.minUniformBufferOffsetAlignment);
+					const uint32_t vsize = bx::strideAlign(program.m_vsh->m_size, align);
+					const uint32_t fsize = bx::strideAlign(NULL != program.m_fsh ? program.m_fsh->m_size : 0, align);
+					const uint32_t total = vsize + fsize;
+
+					const uint32_t pos = _rec.allocScratch(total);
+					uint8_t* data = _rec.m_scratchBuffer->m_data;
+
+					if (vsize > 0)
+					{
+						offsets[numOffset++] = pos;
+						bx::memCopy(&data[pos], _rec.m_vsScratch, program.m_vsh->m_size);
+					}
+
+					if (fsize > 0)
+					{
+						offsets[numOffset++] = pos + vsize;
+						bx::memCopy(&data[pos + vsize], _rec.m_fsScratch, program.m_fsh->m_size);
+					}
+				}
+
+				vkCmdBindDescriptorSets(
+					_rec.m_commandBuffer
+					, VK_PIPELINE_BIND_POINT_GRAPHICS
+					, program.m_pipelineLayout
+					, 0
+					, 1
+					, &_rec.m_descriptorSet
+					, numOffset
+					, offsets
+					);
+			}
+
+			uint32_t numIndices = 0;
+			for (uint32_t ii = 0; ii < numStreams; ++ii)
+			{
+				VkDeviceSize offset = 0;
+				vkCmdBindVertexBuffers(_rec.m_commandBuffer
+					, ii
+					, 1
+					, &m_vertexBuffers[draw.m_stream[ii].m_handle.idx].m_buffer
+					, &offset
+					);
+			}
+
+			if (isValid(draw.m_instanceDataBuffer) )
+			{
+				VkDeviceSize instanceOffset = draw.m_instanceDataOffset;
+				VertexBufferVK& instanceBuffer = m_vertexBuffers[draw.m_instanceDataBuffer.idx];
+				vkCmdBindVertexBuffers(_rec.m_commandBuffer
+					, numStreams
+					, 1
+					, &instanceBuffer.m_buffer
+					, &instanceOffset
+					);
+			}
+
+			const bool occlusionQuery = true
+				&& hasOcclusionQuery
+				&& m_occlusionQuery.begin(_rec.m_commandBuffer, draw.m_occlusionQuery)
+				;
+
+			if (!isValid(draw.m_indexBuffer) )
+			{
+				const VertexBufferVK& vertexBuffer = m_vertexBuffers[draw.m_stream[0].m_handle.idx];
+				const VertexLayout* layout = layouts[0];
+
+				const uint32_t numVertices = UINT32_MAX == draw.m_numVertices
+					? vertexBuffer.m_size / layout->m_stride
+					: draw.m_numVertices
+					;
+				vkCmdDraw(_rec.m_commandBuffer
+					, numVertices
+					, draw.m_numInstances
+					, draw.m_stream[0].m_startVertex
+					, 0
+					);
+			}
+			else
+			{
+				BufferVK& ib = m_indexBuffers[draw.m_indexBuffer.idx];
+
+				const bool hasIndex16 = draw.isIndex16();
+				const uint32_t indexSize = hasIndex16 ? 2 : 4;
+
+				numIndices = UINT32_MAX == draw.m_numIndices
+					? ib.m_size / indexSize
+					: draw.m_numIndices
+					;
+
+				vkCmdBindIndexBuffer(_rec.m_commandBuffer
+					, ib.m_buffer
+					, 0
+					, hasIndex16
+						? VK_INDEX_TYPE_UINT16
+						: VK_INDEX_TYPE_UINT32
+					);
+				vkCmdDrawIndexed(_rec.m_commandBuffer
+					, numIndices
+					, draw.m_numInstances
+					, draw.m_startIndex
+					, draw.m_stream[0].m_startVertex
+					, 0
+					);
 			}
-			else if (texture.m_aspectMask & VK_IMAGE_ASPECT_DEPTH_BIT)
+
+			const PrimInfo& prim = s_primInfo[_rec.m_prim];
+			uint32_t numPrimsSubmitted = numIndices / prim.m_div - prim.m_sub;
+			uint32_t numPrimsRendered  = numPrimsSubmitted*draw.m_numInstances;
+
+			_rec.m_numPrimsSubmitted[_rec.m_primIndex] += numPrimsSubmitted;
+			_rec.m_numPrimsRendered[_rec.m_primIndex]  += numPrimsRendered;
+			_rec.m_numInstances[_rec.m_primIndex]      += draw.m_numInstances;
+			_rec.m_numIndices                          += numIndices;
+
+			if (occlusionQuery)
 			{
-				m_depth = m_attachment[ii].handle;
+				m_occlusionQuery.end(_rec.m_commandBuffer);
 			}
 		}
-
-		VkFramebufferCreateInfo fci;
-		fci.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-		fci.pNext = NULL;
-		fci.flags = 0;
-		fci.renderPass      = renderPass;
-		fci.attachmentCount = m_numAttachment;
-		fci.pAttachments    = textureImageViews;
-		fci.width  = firstTexture.m_width >> m_attachment[0].mip;
-		fci.height = firstTexture.m_height >> m_attachment[0].mip;
-		fci.layers = firstTexture.m_numSides;
-		VK_CHECK( vkCreateFramebuffer(device, &fci, allocatorCb, &m_framebuffer) );
-		m_renderPass = renderPass;
-	}
-
-	void FrameBufferVK::destroy()
-	{
-		vkDestroy(m_framebuffer);
 	}
 
 	void RendererContextVK::submitBlit(BlitState& _bs, uint16_t _view)
@@ -5740,7 +7849,7 @@ VK_DESTROY
 		VkImageLayout oldSrcLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 		VkImageLayout oldDstLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
-		VkCommandBuffer commandBuffer = beginNewCommand();
+		VkCommandBuffer commandBuffer = m_commandBuffer;
 		while (_bs.hasItem(_view) )
 		{
 			const BlitItem& blit = _bs.advance();
@@ -5820,120 +7929,125 @@ VK_DESTROY
 		{
 			m_textures[currentDst.idx].setImageMemoryBarrier(commandBuffer, oldDstLayout);
 		}
-		submitCommandAndWait(commandBuffer);
 	}
 
 	void RendererContextVK::submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter)
 	{
 		BX_UNUSED(_render, _clearQuad, _textVideoMemBlitter);
 
-		m_commandBuffer = beginNewCommand();
-		BGFX_VK_PROFILER_BEGIN_LITERAL("rendererSubmit", kColorView);
-		submitCommandAndWait(m_commandBuffer);
-		m_commandBuffer = VK_NULL_HANDLE;
-
 		updateResolution(_render->m_resolution);
 
 		int64_t timeBegin = bx::getHPCounter();
-		int64_t captureElapsed = 0;
 
-//		m_gpuTimer.begin(m_commandList);
+		beginFrame();
+
+		const int64_t captureElapsed = m_captureElapsed;
+
+		VkSemaphore renderWait = VK_NULL_HANDLE;
+
+		if (m_headless)
+		{
+			// Offscreen backbuffer image is owned by frame slot, and it's free once slot's
+			// fence is signaled.
+			m_backBufferColorIdx = m_frameIdx;
+		}
+		else
+		{
+			renderWait = m_presentDone[m_frameIdx];
+			VkResult result = vkAcquireNextImageKHR(
+				  m_device
+				, m_swapchain
+				, UINT64_MAX
+				, renderWait
+				, VK_NULL_HANDLE
+				, &m_backBufferColorIdx
+				);
+
+			if (VK_ERROR_OUT_OF_DATE_KHR == result
+			||  VK_SUBOPTIMAL_KHR        == result)
+			{
+				m_needToRefreshSwapchain = true;
+
+				// Resource updates recorded for this frame must still be executed.
+				VK_CHECK(vkEndCommandBuffer(m_commandBuffer) );
+				kick();
+				m_commandBuffer = VK_NULL_HANDLE;
+				return;
+			}
+		}
+
+		ScratchBufferVK& scratchBuffer = m_scratchBuffer[m_frameIdx];
+
+		BGFX_VK_PROFILER_BEGIN_LITERAL("rendererSubmit", kColorView);
+
+		m_occlusionQuery.resolve(m_commandBuffer, _render);
+
+		uint32_t frameQueryIdx = m_gpuTimer.begin(BGFX_CONFIG_MAX_VIEWS);
 
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
 			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(/*m_commandList*/NULL, 0, _render->m_iboffset, ib->data);
+			m_indexBuffers[ib->handle.idx].update(m_commandBuffer, 0, _render->m_iboffset, ib->data);
 		}
 
 		if (0 < _render->m_vboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
 			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(/*m_commandList*/NULL, 0, _render->m_vboffset, vb->data);
+			m_vertexBuffers[vb->handle.idx].update(m_commandBuffer, 0, _render->m_vboffset, vb->data);
 		}
 
 		_render->sort();
 
-		RenderDraw currentState;
-		currentState.clear();
-		currentState.m_stateFlags = BGFX_STATE_NONE;
-		currentState.m_stencil    = packStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
-
 		static ViewState viewState;
 		viewState.reset(_render);
 
+		RecorderVK& recorder = m_drawRecorder;
+		recorder.m_viewState     = &viewState;
+		recorder.m_scratchBuffer = &scratchBuffer;
+		recorder.m_descriptorSet = VK_NULL_HANDLE;
+		recorder.m_currentState.clear();
+		recorder.m_currentState.m_stateFlags = BGFX_STATE_NONE;
+		recorder.m_currentState.m_stencil    = packStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
+
 // 		bool wireframe = !!(_render->m_debug&BGFX_DEBUG_WIREFRAME);
 // 		setDebugWireframe(wireframe);
 
-		uint16_t currentSamplerStateIdx = kInvalidHandle;
-		ProgramHandle currentProgram    = BGFX_INVALID_HANDLE;
-		uint32_t currentBindHash        = 0;
-		uint32_t currentDslHash         = 0;
-		bool     hasPredefined          = false;
-		bool     commandListChanged     = false;
-		VkPipeline currentPipeline = VK_NULL_HANDLE;
+		recorder.m_currentProgram     = BGFX_INVALID_HANDLE;
+		recorder.m_currentBindHash    = 0;
+		recorder.m_currentDslHash     = 0;
+		recorder.m_hasPredefined      = false;
+		recorder.m_commandListChanged = false;
+		recorder.m_currentPipeline    = VK_NULL_HANDLE;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
 
 		BlitState bs(_render);
 
-		uint32_t blendFactor = 0;
+		recorder.m_blendFactor = 0;
 
 		const uint64_t primType = _render->m_debug&BGFX_DEBUG_WIREFRAME ? BGFX_STATE_PT_LINES : 0;
-		uint8_t primIndex = uint8_t(primType >> BGFX_STATE_PT_SHIFT);
-		PrimInfo prim = s_primInfo[primIndex];
+		recorder.m_primIndex = uint8_t(primType >> BGFX_STATE_PT_SHIFT);
+		recorder.m_prim      = recorder.m_primIndex;
 
 		bool wasCompute     = false;
 		bool viewHasScissor = false;
-		bool restoreScissor = false;
 		Rect viewScissorRect;
 		viewScissorRect.clear();
 
 		const uint32_t maxComputeBindings = g_caps.limits.maxComputeBindings;
 		BX_UNUSED(maxComputeBindings);
 
-		uint32_t statsNumPrimsSubmitted[BX_COUNTOF(s_primInfo)] = {};
-		uint32_t statsNumPrimsRendered[BX_COUNTOF(s_primInfo)] = {};
-		uint32_t statsNumInstances[BX_COUNTOF(s_primInfo)] = {};
-		uint32_t statsNumIndices = 0;
 		uint32_t statsKeyType[2] = {};
 
-		VkSemaphore renderWait = m_presentDone[m_backBufferColorIdx];
-		VkResult result = vkAcquireNextImageKHR(
-			  m_device
-			, m_swapchain
-			, UINT64_MAX
-			, renderWait
-			, VK_NULL_HANDLE
-			, &m_backBufferColorIdx
+		Profiler<TimerQueryVK> profiler(
+			  _render
+			, m_gpuTimer
+			, s_viewName
 			);
-
-		if (VK_ERROR_OUT_OF_DATE_KHR == result
-		||  VK_SUBOPTIMAL_KHR        == result)
-		{
-			m_needToRefreshSwapchain = true;
-			return;
-		}
-
-		const uint64_t f0 = BGFX_STATE_BLEND_FACTOR;
-		const uint64_t f1 = BGFX_STATE_BLEND_INV_FACTOR;
-		const uint64_t f2 = BGFX_STATE_BLEND_FACTOR<<4;
-		const uint64_t f3 = BGFX_STATE_BLEND_INV_FACTOR<<4;
-
-		ScratchBufferVK& scratchBuffer = m_scratchBuffer[m_backBufferColorIdx];
-		scratchBuffer.reset();
-
-		VkCommandBufferBeginInfo cbbi;
-		cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		cbbi.pNext = NULL;
-		cbbi.flags = 0
-			| VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
-			;
-		cbbi.pInheritanceInfo = NULL;
-		m_commandBuffer = m_commandBuffers[m_backBufferColorIdx];
-		VK_CHECK(vkBeginCommandBuffer(m_commandBuffer, &cbbi) );
+		profiler.setPrimStats(recorder.m_numPrimsRendered, recorder.m_numInstances);
 
 		setImageMemoryBarrier(m_commandBuffer
 			, m_backBufferColorImage[m_backBufferColorIdx]
@@ -5985,20 +8099,24 @@ VK_DESTROY
 						beginRenderPass = false;
 					}
 
-					VK_CHECK(vkEndCommandBuffer(m_commandBuffer) );
+					view = key.m_view;
+					recorder.m_currentPipeline = VK_NULL_HANDLE;
+					recorder.m_currentProgram  = BGFX_INVALID_HANDLE;
+					recorder.m_hasPredefined   = false;
+
+					if (viewChanged)
+					{
+						if (item > 1)
+						{
+							profiler.end();
+						}
 
-					kick(renderWait);
-					renderWait = VK_NULL_HANDLE;
-					finishAll();
+						profiler.begin(view);
+					}
 
-					view = key.m_view;
-					currentPipeline = VK_NULL_HANDLE;
-					currentSamplerStateIdx = kInvalidHandle;
-					currentProgram         = BGFX_INVALID_HANDLE;
-					hasPredefined          = false;
-					BX_UNUSED(currentSamplerStateIdx);
+					// Blits must be recorded outside of render pass.
+					submitBlit(bs, view);
 
-					VK_CHECK(vkBeginCommandBuffer(m_commandBuffer, &cbbi) );
 					fbh = _render->m_view[view].m_fbh;
 					setFrameBuffer(fbh);
 
@@ -6019,6 +8137,22 @@ VK_DESTROY
 					setViewType(view, " ");
 					BGFX_VK_PROFILER_BEGIN(view, kColorView);
 
+					const uint32_t viewBegin = uint32_t(item-1);
+					const uint32_t viewEnd   = viewChanged && !isCompute
+						? findParallelView(_render, viewBegin)
+						: viewBegin
+						;
+
+					if (viewBegin < viewEnd)
+					{
+						recordParallel(_render, view, viewBegin, viewEnd, rpbi, viewScissorRect, viewHasScissor, viewState);
+						statsKeyType[0] += viewEnd - viewBegin - 1;
+						beginRenderPass = true;
+						wasCompute      = false;
+						item = int32_t(viewEnd);
+						continue;
+					}
+
 					if (!isCompute && !beginRenderPass)
 					{
 						vkCmdBeginRenderPass(m_commandBuffer, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
@@ -6040,19 +8174,15 @@ VK_DESTROY
 						rc.extent.height = viewScissorRect.m_height;
 						vkCmdSetScissor(m_commandBuffer, 0, 1, &rc);
 
-						restoreScissor = false;
+						recorder.begin(m_commandBuffer, view, viewScissorRect, viewHasScissor);
 
 						Clear& clr = _render->m_view[view].m_clear;
 						if (BGFX_CLEAR_NONE != clr.m_flags)
 						{
 							Rect clearRect = rect;
 							clearRect.setIntersect(rect, viewScissorRect);
-							clearQuad(clearRect, clr, _render->m_colorPalette);
+							clearQuad(m_commandBuffer, clearRect, clr, _render->m_colorPalette);
 						}
-
-						prim = s_primInfo[Topology::Count]; // Force primitive type update.
-
-						submitBlit(bs, view);
 					}
 				}
 
@@ -6071,60 +8201,60 @@ VK_DESTROY
 
 					VkPipeline pipeline = getPipeline(key.m_program);
 
-					if (pipeline != currentPipeline)
+					if (pipeline != recorder.m_currentPipeline)
 					{
-						currentPipeline = pipeline;
+						recorder.m_currentPipeline = pipeline;
 						vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
-						currentBindHash = 0;
-						currentDslHash = 0;
+						recorder.m_currentBindHash = 0;
+						recorder.m_currentDslHash = 0;
 					}
 
 					bool constantsChanged = false;
 
 					if (compute.m_uniformBegin < compute.m_uniformEnd
-					||  currentProgram.idx != key.m_program.idx)
+					||  recorder.m_currentProgram.idx != key.m_program.idx)
 					{
 						rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
 
-						currentProgram = key.m_program;
-						ProgramVK& program = m_program[currentProgram.idx];
+						recorder.m_currentProgram = key.m_program;
+						ProgramVK& program = m_program[recorder.m_currentProgram.idx];
 
 						UniformBuffer* vcb = program.m_vsh->m_constantBuffer;
 
 						if (NULL != vcb)
 						{
-							commit(*vcb);
+							recorder.commit(*vcb);
 						}
 
-						hasPredefined = 0 < program.m_numPredefined;
+						recorder.m_hasPredefined = 0 < program.m_numPredefined;
 						constantsChanged = true;
 					}
 
-					const ProgramVK& program = m_program[currentProgram.idx];
+					const ProgramVK& program = m_program[recorder.m_currentProgram.idx];
 
 					if (constantsChanged
-					||  hasPredefined)
+					||  recorder.m_hasPredefined)
 					{
-						viewState.setPredefined<4>(this, view, program, _render, compute);
+						viewState.setPredefined<4>(&recorder, view, program, _render, compute);
 					}
 
 					if (program.m_descriptorSetLayoutHash != 0)
 					{
 						uint32_t bindHash = bx::hash<bx::HashMurmur2A>(renderBind.m_bind, sizeof(renderBind.m_bind) );
 
-						if (currentBindHash != bindHash
-						||  currentDslHash  != program.m_descriptorSetLayoutHash)
+						if (recorder.m_currentBindHash != bindHash
+						||  recorder.m_currentDslHash  != program.m_descriptorSetLayoutHash)
 						{
-							currentBindHash = bindHash;
-							currentDslHash  = program.m_descriptorSetLayoutHash;
+							recorder.m_currentBindHash = bindHash;
+							recorder.m_currentDslHash  = program.m_descriptorSetLayoutHash;
 
-							allocDescriptorSet(program, renderBind, scratchBuffer);
+							allocDescriptorSet(recorder, program, renderBind);
 						}
 
 						uint32_t offset = 0;
 
 						if (constantsChanged
-						||  hasPredefined)
+						||  recorder.m_hasPredefined)
 						{
 							const uint32_t align = uint32_t(m_deviceProperties.limits.minUniformBufferOffsetAlignment);
 							const uint32_t vsize = bx::strideAlign(program.m_vsh->m_size, align);
@@ -6142,8 +8272,8 @@ VK_DESTROY
 							, program.m_pipelineLayout
 							, 0
 							, 1
-							, &scratchBuffer.getCurrentDS()
-							, constantsChanged || hasPredefined ? 1 : 0
+							, &recorder.m_descriptorSet
+							, constantsChanged || recorder.m_hasPredefined ? 1 : 0
 							, &offset
 							);
 					}
@@ -6172,38 +8302,6 @@ VK_DESTROY
 					continue;
 				}
 
-				const RenderDraw& draw = renderItem.draw;
-
-				const bool hasOcclusionQuery = false; //0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
-				{
-					const bool occluded = false //true
-//						&& isValid(draw.m_occlusionQuery)
-//						&& !hasOcclusionQuery
-//						&& !isVisible(_render, draw.m_occlusionQuery, 0 != (draw.m_submitFlags&BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE) )
-						;
-
-					if (occluded
-					||  _render->m_frameCache.isZeroArea(viewScissorRect, draw.m_scissor) )
-					{
-//						if (resetState)
-//						{
-//							currentState.clear();
-//							currentState.m_scissor = !draw.m_scissor;
-//							currentBind.clear();
-//						}
-
-						continue;
-					}
-				}
-
-				const uint64_t newFlags = draw.m_stateFlags;
-				uint64_t changedFlags = currentState.m_stateFlags ^ draw.m_stateFlags;
-				currentState.m_stateFlags = newFlags;
-
-				const uint64_t newStencil = draw.m_stencil;
-				uint64_t changedStencil = (currentState.m_stencil ^ draw.m_stencil) & BGFX_STENCIL_FUNC_REF_MASK;
-				currentState.m_stencil = newStencil;
-
 				if (viewChanged
 				||  wasCompute)
 				{
@@ -6218,335 +8316,37 @@ VK_DESTROY
 						setViewType(view, " ");
 						BGFX_VK_PROFILER_BEGIN(view, kColorDraw);
 					}
-
-					commandListChanged = true;
 				}
 
-				if (commandListChanged)
-				{
-					commandListChanged = false;
-
-//					m_commandList->SetGraphicsRootSignature(m_rootSignature);
-//					ID3D12DescriptorHeap* heaps[] = {
-//						m_samplerAllocator.getHeap(),
-//						scratchBuffer.getHeap(),
-//					};
-//					m_commandList->SetDescriptorHeaps(BX_COUNTOF(heaps), heaps);
+				recordDraw(recorder, _render, key, renderItem, renderBind);
+			}
 
-					currentPipeline        = VK_NULL_HANDLE;
-					currentBindHash        = 0;
-					currentDslHash         = 0;
-					currentSamplerStateIdx = kInvalidHandle;
-					currentProgram         = BGFX_INVALID_HANDLE;
-					currentState.clear();
-					currentState.m_scissor = !draw.m_scissor;
-					changedFlags = BGFX_STATE_MASK;
-					changedStencil = packStencil(BGFX_STENCIL_MASK, BGFX_STENCIL_MASK);
-					currentState.m_stateFlags = newFlags;
-					currentState.m_stencil    = newStencil;
+			if (wasCompute)
+			{
+				setViewType(view, "C");
+				BGFX_VK_PROFILER_END();
+				BGFX_VK_PROFILER_BEGIN(view, kColorCompute);
+			}
 
-					const uint64_t pt = newFlags&BGFX_STATE_PT_MASK;
-					primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
+			if (bs.hasItem(BGFX_CONFIG_MAX_VIEWS) )
+			{
+				if (beginRenderPass)
+				{
+					vkCmdEndRenderPass(m_commandBuffer);
 				}
 
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				submitBlit(bs, BGFX_CONFIG_MAX_VIEWS);
 
-				if (0 != draw.m_streamMask)
+				if (beginRenderPass)
 				{
-					currentState.m_streamMask = draw.m_streamMask;
-
-					const uint64_t state = draw.m_stateFlags;
-					bool hasFactor = 0
-						|| f0 == (state & f0)
-						|| f1 == (state & f1)
-						|| f2 == (state & f2)
-						|| f3 == (state & f3)
-						;
-
-					const VertexLayout* layouts[BGFX_CONFIG_MAX_VERTEX_STREAMS];
-					uint8_t numStreams = 0;
-					if (UINT8_MAX != draw.m_streamMask)
-					{
-						for (uint32_t idx = 0, streamMask = draw.m_streamMask
-							; 0 != streamMask
-							; streamMask >>= 1, idx += 1, ++numStreams
-							)
-						{
-							const uint32_t ntz = bx::uint32_cnttz(streamMask);
-							streamMask >>= ntz;
-							idx         += ntz;
-
-							currentState.m_stream[idx].m_layoutHandle   = draw.m_stream[idx].m_layoutHandle;
-							currentState.m_stream[idx].m_handle         = draw.m_stream[idx].m_handle;
-							currentState.m_stream[idx].m_startVertex    = draw.m_stream[idx].m_startVertex;
-
-							uint16_t handle = draw.m_stream[idx].m_handle.idx;
-							const VertexBufferVK& vb = m_vertexBuffers[handle];
-							const uint16_t decl = isValid(draw.m_stream[idx].m_layoutHandle)
-								? draw.m_stream[idx].m_layoutHandle.idx
-								: vb.m_layoutHandle.idx
-								;
-							const VertexLayout& layout = m_vertexLayouts[decl];
-
-							layouts[numStreams] = &layout;
-						}
-					}
-
-					VkPipeline pipeline =
-						getPipeline(state
-							, draw.m_stencil
-							, numStreams
-							, layouts
-							, key.m_program
-							, uint8_t(draw.m_instanceDataStride/16)
-							);
-
-					uint16_t scissor = draw.m_scissor;
-
-					if (pipeline != currentPipeline
-					||  0 != changedStencil)
-					{
-						const uint32_t fstencil = unpackStencil(0, draw.m_stencil);
-						const uint32_t ref = (fstencil&BGFX_STENCIL_FUNC_REF_MASK)>>BGFX_STENCIL_FUNC_REF_SHIFT;
-						vkCmdSetStencilReference(m_commandBuffer, VK_STENCIL_FRONT_AND_BACK, ref);
-					}
-
-					if (pipeline != currentPipeline
-					|| (hasFactor && blendFactor != draw.m_rgba) )
-					{
-						blendFactor = draw.m_rgba;
-
-						float bf[4];
-						bf[0] = ( (draw.m_rgba>>24)     )/255.0f;
-						bf[1] = ( (draw.m_rgba>>16)&0xff)/255.0f;
-						bf[2] = ( (draw.m_rgba>> 8)&0xff)/255.0f;
-						bf[3] = ( (draw.m_rgba    )&0xff)/255.0f;
-						vkCmdSetBlendConstants(m_commandBuffer, bf);
-					}
-
-					if (0 != (BGFX_STATE_PT_MASK & changedFlags)
-					||  prim.m_topology != s_primInfo[primIndex].m_topology)
-					{
-						const uint64_t pt = newFlags&BGFX_STATE_PT_MASK;
-						primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
-						prim = s_primInfo[primIndex];
-//						m_commandList->IASetPrimitiveTopology(prim.m_topology);
-					}
-
-					if (currentState.m_scissor != scissor)
-					{
-						currentState.m_scissor = scissor;
-
-						if (UINT16_MAX == scissor)
-						{
-							if (restoreScissor
-							||  viewHasScissor)
-							{
-								restoreScissor = false;
-								VkRect2D rc;
-								rc.offset.x      = viewScissorRect.m_x;
-								rc.offset.y      = viewScissorRect.m_y;
-								rc.extent.width  = viewScissorRect.m_width;
-								rc.extent.height = viewScissorRect.m_height;
-								vkCmdSetScissor(m_commandBuffer, 0, 1, &rc);
-							}
-						}
-						else
-						{
-							restoreScissor = true;
-							Rect scissorRect;
-							scissorRect.setIntersect(viewScissorRect, _render->m_frameCache.m_rectCache.m_cache[scissor]);
-
-							VkRect2D rc;
-							rc.offset.x      = scissorRect.m_x;
-							rc.offset.y      = scissorRect.m_y;
-							rc.extent.width  = scissorRect.m_width;
-							rc.extent.height = scissorRect.m_height;
-							vkCmdSetScissor(m_commandBuffer, 0, 1, &rc);
-						}
-					}
-
-					if (pipeline != currentPipeline)
-					{
-						currentPipeline = pipeline;
-						vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-					}
-
-					bool constantsChanged = false;
-					if (draw.m_uniformBegin < draw.m_uniformEnd
-					||  currentProgram.idx != key.m_program.idx
-					||  BGFX_STATE_ALPHA_REF_MASK & changedFlags)
-					{
-						currentProgram = key.m_program;
-						ProgramVK& program = m_program[currentProgram.idx];
-
-						UniformBuffer* vcb = program.m_vsh->m_constantBuffer;
-						if (NULL != vcb)
-						{
-							commit(*vcb);
-						}
-
-						UniformBuffer* fcb = program.m_fsh->m_constantBuffer;
-						if (NULL != fcb)
-						{
-							commit(*fcb);
-						}
-
-						hasPredefined = 0 < program.m_numPredefined;
-						constantsChanged = true;
-					}
-
-					const ProgramVK& program = m_program[currentProgram.idx];
-
-					if (hasPredefined)
-					{
-						uint32_t ref = (newFlags & BGFX_STATE_ALPHA_REF_MASK) >> BGFX_STATE_ALPHA_REF_SHIFT;
-						viewState.m_alphaRef = ref / 255.0f;
-						viewState.setPredefined<4>(this, view, program, _render, draw);
-					}
-
-					if (program.m_descriptorSetLayoutHash != 0)
-					{
-						uint32_t bindHash = bx::hash<bx::HashMurmur2A>(renderBind.m_bind, sizeof(renderBind.m_bind) );
-						if (currentBindHash != bindHash
-						||  currentDslHash  != program.m_descriptorSetLayoutHash)
-						{
-							currentBindHash = bindHash;
-							currentDslHash  = program.m_descriptorSetLayoutHash;
-
-							allocDescriptorSet(program, renderBind, scratchBuffer);
-						}
-
-						uint32_t numOffset = 0;
-						uint32_t offsets[2] = { 0, 0 };
-
-						if (constantsChanged
-						||  hasPredefined)
-						{
-							const uint32_t align = uint32_t(m_deviceProperties.limits.minUniformBufferOffsetAlignment);
-							const uint32_t vsize = bx::strideAlign(program.m_vsh->m_size, align);
-							const uint32_t fsize = bx::strideAlign(NULL != program.m_fsh ? program.m_fsh->m_size : 0, align);
-							const uint32_t total = vsize + fsize;
-
-							if (vsize > 0)
-							{
-								offsets[numOffset++] = scratchBuffer.m_pos;
-								bx::memCopy(&scratchBuffer.m_data[scratchBuffer.m_pos], m_vsScratch, program.m_vsh->m_size);
-							}
-
-							if (fsize > 0)
-							{
-								offsets[numOffset++] = scratchBuffer.m_pos + vsize;
-								bx::memCopy(&scratchBuffer.m_data[scratchBuffer.m_pos + vsize], m_fsScratch, program.m_fsh->m_size);
-							}
-
-							scratchBuffer.m_pos += total;
-						}
-
-						vkCmdBindDescriptorSets(
-							m_commandBuffer
-							, VK_PIPELINE_BIND_POINT_GRAPHICS
-							, program.m_pipelineLayout
-							, 0
-							, 1
-							, &scratchBuffer.getCurrentDS()
-							, numOffset
-							, offsets
-							);
-					}
-
-					uint32_t numIndices = 0;
-					for (uint32_t ii = 0; ii < numStreams; ++ii)
-					{
-						VkDeviceSize offset = 0;
-						vkCmdBindVertexBuffers(m_commandBuffer
-							, ii
-							, 1
-							, &m_vertexBuffers[draw.m_stream[ii].m_handle.idx].m_buffer
-							, &offset
-							);
-					}
-
-					if (isValid(draw.m_instanceDataBuffer) )
-					{
-						VkDeviceSize instanceOffset = draw.m_instanceDataOffset;
-						VertexBufferVK& instanceBuffer = m_vertexBuffers[draw.m_instanceDataBuffer.idx];
-						vkCmdBindVertexBuffers(m_commandBuffer
-							, numStreams
-							, 1
-							, &instanceBuffer.m_buffer
-							, &instanceOffset
-							);
-					}
-
-					if (!isValid(draw.m_indexBuffer) )
-					{
-						const VertexBufferVK& vertexBuffer = m_vertexBuffers[draw.m_stream[0].m_handle.idx];
-						const VertexLayout* layout = layouts[0];
-
-						const uint32_t numVertices = UINT32_MAX == draw.m_numVertices
-							? vertexBuffer.m_size / layout->m_stride
-							: draw.m_numVertices
-							;
-						vkCmdDraw(m_commandBuffer
-							, numVertices
-							, draw.m_numInstances
-							, draw.m_stream[0].m_startVertex
-							, 0
-							);
-					}
-					else
-					{
-						BufferVK& ib = m_indexBuffers[draw.m_indexBuffer.idx];
-
-						const bool hasIndex16 = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32);
-						const uint32_t indexSize = hasIndex16 ? 2 : 4;
-
-						numIndices = UINT32_MAX == draw.m_numIndices
-							? ib.m_size / indexSize
-							: draw.m_numIndices
-							;
-
-						vkCmdBindIndexBuffer(m_commandBuffer
-							, ib.m_buffer
-							, 0
-							, hasIndex16
-								? VK_INDEX_TYPE_UINT16
-								: VK_INDEX_TYPE_UINT32
-							);
-						vkCmdDrawIndexed(m_commandBuffer
-							, numIndices
-							, draw.m_numInstances
-							, draw.m_startIndex
-							, draw.m_stream[0].m_startVertex
-							, 0
-							);
-					}
-
-					uint32_t numPrimsSubmitted = numIndices / prim.m_div - prim.m_sub;
-					uint32_t numPrimsRendered  = numPrimsSubmitted*draw.m_numInstances;
-
-					statsNumPrimsSubmitted[primIndex] += numPrimsSubmitted;
-					statsNumPrimsRendered[primIndex]  += numPrimsRendered;
-					statsNumInstances[primIndex]      += draw.m_numInstances;
-					statsNumIndices                   += numIndices;
-
-					if (hasOcclusionQuery)
-					{
-//						m_occlusionQuery.begin(m_commandList, _render, draw.m_occlusionQuery);
-//						m_occlusionQuery.end(m_commandList);
-					}
+					vkCmdBeginRenderPass(m_commandBuffer, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
 				}
 			}
 
-			if (wasCompute)
+			if (0 < _render->m_numRenderItems)
 			{
-				setViewType(view, "C");
-				BGFX_VK_PROFILER_END();
-				BGFX_VK_PROFILER_BEGIN(view, kColorCompute);
+				profiler.end();
 			}
-
-			submitBlit(bs, BGFX_CONFIG_MAX_VIEWS);
 		}
 
 		BGFX_VK_PROFILER_END();
@@ -6562,7 +8362,6 @@ VK_DESTROY
 		static uint32_t maxGpuLatency = 0;
 		static double   maxGpuElapsed = 0.0f;
 		double elapsedGpuMs = 0.0;
-BX_UNUSED(maxGpuLatency, maxGpuElapsed, elapsedGpuMs);
 
 		static int64_t presentMin = 0; //m_presentElapsed;
 		static int64_t presentMax = 0; //m_presentElapsed;
@@ -6570,15 +8369,17 @@ BX_UNUSED(presentMin, presentMax);
 //		presentMin = bx::min<int64_t>(presentMin, m_presentElapsed);
 //		presentMax = bx::max<int64_t>(presentMax, m_presentElapsed);
 
-//		m_gpuTimer.end(m_commandList);
+		if (UINT32_MAX != frameQueryIdx)
+		{
+			m_gpuTimer.end(frameQueryIdx);
+
+			const TimerQueryVK::Result& timerResult = m_gpuTimer.m_result[BGFX_CONFIG_MAX_VIEWS];
+			double toGpuMs = 1000.0 / double(m_gpuTimer.m_frequency);
+			elapsedGpuMs   = (timerResult.m_end - timerResult.m_begin) * toGpuMs;
+			maxGpuElapsed  = elapsedGpuMs > maxGpuElapsed ? elapsedGpuMs : maxGpuElapsed;
+		}
 
-//		while (m_gpuTimer.get() )
-//		{
-//			double toGpuMs = 1000.0 / double(m_gpuTimer.m_frequency);
-//			elapsedGpuMs   = m_gpuTimer.m_elapsed * toGpuMs;
-//			maxGpuElapsed  = elapsedGpuMs > maxGpuElapsed ? elapsedGpuMs : maxGpuElapsed;
-//		}
-//		maxGpuLatency = bx::uint32_imax(maxGpuLatency, m_gpuTimer.m_control.available()-1);
+		maxGpuLatency = bx::uint32_imax(maxGpuLatency, getNumFramesPending() );
 
 		const int64_t timerFreq = bx::getHPFrequency();
 
@@ -6586,17 +8387,43 @@ BX_UNUSED(presentMin, presentMax);
 		perfStats.cpuTimeBegin  = timeBegin;
 		perfStats.cpuTimeEnd    = timeEnd;
 		perfStats.cpuTimerFreq  = timerFreq;
-//		perfStats.gpuTimeBegin  = m_gpuTimer.m_begin;
-//		perfStats.gpuTimeEnd    = m_gpuTimer.m_end;
-//		perfStats.gpuTimerFreq  = m_gpuTimer.m_frequency;
-//		perfStats.numDraw       = statsKeyType[0];
-//		perfStats.numCompute    = statsKeyType[1];
+		const TimerQueryVK::Result& timerResult = m_gpuTimer.m_result[BGFX_CONFIG_MAX_VIEWS];
+		perfStats.gpuTimeBegin  = timerResult.m_begin;
+		perfStats.gpuTimeEnd    = timerResult.m_end;
+		perfStats.gpuTimerFreq  = m_gpuTimer.m_frequency;
+		perfStats.numDraw       = statsKeyType[0];
+		perfStats.numCompute    = statsKeyType[1];
 		perfStats.numBlit       = _render->m_numBlitItems;
-//		perfStats.maxGpuLatency = maxGpuLatency;
-		bx::memCopy(perfStats.numPrims, statsNumPrimsRendered, sizeof(perfStats.numPrims) );
+		perfStats.maxGpuLatency = maxGpuLatency;
+		bx::memCopy(perfStats.numPrims, recorder.m_numPrimsRendered, sizeof(perfStats.numPrims) );
 		perfStats.gpuMemoryMax  = -INT64_MAX;
 		perfStats.gpuMemoryUsed = -INT64_MAX;
 
+		if (s_extension[Extension::EXT_memory_budget].m_supported)
+		{
+			VkPhysicalDeviceMemoryBudgetPropertiesEXT dmbp;
+			dmbp.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+			dmbp.pNext = NULL;
+
+			VkPhysicalDeviceMemoryProperties2 pdmp2;
+			pdmp2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+			pdmp2.pNext = &dmbp;
+
+			vkGetPhysicalDeviceMemoryProperties2KHR(m_physicalDevice, &pdmp2);
+
+			perfStats.gpuMemoryMax  = 0;
+			perfStats.gpuMemoryUsed = 0;
+
+			for (uint32_t ii = 0; ii < m_memoryProperties.memoryHeapCount; ++ii)
+			{
+				if (0 != (m_memoryProperties.memoryHeaps[ii].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) )
+				{
+					perfStats.gpuMemoryMax  += int64_t(dmbp.heapBudget[ii]);
+					perfStats.gpuMemoryUsed += int64_t(dmbp.heapUsage[ii]);
+				}
+			}
+		}
+
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
 		{
 			BGFX_VK_PROFILER_BEGIN_LITERAL("debugstats", kColorFrame);
@@ -6681,20 +8508,25 @@ BX_UNUSED(presentMin, presentMax);
 					);
 
 				double elapsedCpuMs = double(frameTime)*toMs;
-				tvm.printf(10, pos++, 0x8b, "   Submitted: %5d (draw %5d, compute %4d) / CPU %7.4f [ms] "
+				tvm.printf(10, pos++, 0x8b, "   Submitted: %5d (draw %5d, compute %4d) / CPU %7.4f [ms] %c GPU %7.4f [ms] (latency %d) "
 					, _render->m_numRenderItems
 					, statsKeyType[0]
 					, statsKeyType[1]
 					, elapsedCpuMs
+					, elapsedCpuMs > maxGpuElapsed ? '>' : '<'
+					, maxGpuElapsed
+					, maxGpuLatency
 					);
+				maxGpuLatency = 0;
+				maxGpuElapsed = 0.0;
 
 				for (uint32_t ii = 0; ii < Topology::Count; ++ii)
 				{
 					tvm.printf(10, pos++, 0x8b, "   %9s: %7d (#inst: %5d), submitted: %7d "
 						, getName(Topology::Enum(ii) )
-						, statsNumPrimsRendered[ii]
-						, statsNumInstances[ii]
-						, statsNumPrimsSubmitted[ii]
+						, recorder.m_numPrimsRendered[ii]
+						, recorder.m_numInstances[ii]
+						, recorder.m_numPrimsSubmitted[ii]
 						);
 				}
 
@@ -6703,7 +8535,7 @@ BX_UNUSED(presentMin, presentMax);
 					tvm.printf(tvm.m_width-27, 0, 0x4f, " [F11 - RenderDoc capture] ");
 				}
 
-				tvm.printf(10, pos++, 0x8b, "      Indices: %7d ", statsNumIndices);
+				tvm.printf(10, pos++, 0x8b, "      Indices: %7d ", recorder.m_numIndices);
 //				tvm.printf(10, pos++, 0x8b, " Uniform size: %7d, Max: %7d ", _render->m_uniformEnd, _render->m_uniformMax);
 				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
 				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
@@ -6762,20 +8594,51 @@ BX_UNUSED(presentMin, presentMax);
 			beginRenderPass = false;
 		}
 
+		if (0 != m_captureSize)
+		{
+			setImageMemoryBarrier(m_commandBuffer
+				, m_backBufferColorImage[m_backBufferColorIdx]
+				, VK_IMAGE_ASPECT_COLOR_BIT
+				, m_backBufferColorImageLayout[m_backBufferColorIdx]
+				, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+				, 1, 1);
+			m_backBufferColorImageLayout[m_backBufferColorIdx] = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+			readbackImage(m_commandBuffer
+				, m_backBufferColorImage[m_backBufferColorIdx]
+				, m_sci.imageExtent.width
+				, m_sci.imageExtent.height
+				, m_captureBuffer[m_frameIdx]
+				);
+			m_capturePending[m_frameIdx] = true;
+		}
+
+		const VkImageLayout finalLayout = m_headless
+			? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+			: VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+			;
+
 		setImageMemoryBarrier(m_commandBuffer
 			, m_backBufferColorImage[m_backBufferColorIdx]
 			, VK_IMAGE_ASPECT_COLOR_BIT
 			, m_backBufferColorImageLayout[m_backBufferColorIdx]
-			, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+			, finalLayout
 			, 1, 1);
-		m_backBufferColorImageLayout[m_backBufferColorIdx] = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		m_backBufferColorImageLayout[m_backBufferColorIdx] = finalLayout;
 
 		VK_CHECK(vkEndCommandBuffer(m_commandBuffer) );
 
-		kick(renderWait); //, m_presentDone[m_backBufferColorIdx]);
-		finishAll();
+		if (m_headless)
+		{
+			kick();
+		}
+		else
+		{
+			kick(renderWait, m_renderDone[m_frameIdx]);
+			m_needPresent = true;
+		}
 
-		VK_CHECK(vkResetCommandPool(m_device, m_commandPool, 0) );
+		m_commandBuffer = VK_NULL_HANDLE;
 	}
 
 } /* namespace vk */ } // namespace bgfx
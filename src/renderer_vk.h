@@ -76,13 +76,13 @@
 			VK_IMPORT_INSTANCE_FUNC(false, vkGetPhysicalDeviceMemoryProperties);       \
 			VK_IMPORT_INSTANCE_FUNC(true,  vkGetPhysicalDeviceMemoryProperties2KHR);   \
 			VK_IMPORT_INSTANCE_FUNC(false, vkGetPhysicalDeviceQueueFamilyProperties);  \
-			VK_IMPORT_INSTANCE_FUNC(false, vkGetPhysicalDeviceSurfaceCapabilitiesKHR); \
-			VK_IMPORT_INSTANCE_FUNC(false, vkGetPhysicalDeviceSurfaceFormatsKHR);      \
-			VK_IMPORT_INSTANCE_FUNC(false, vkGetPhysicalDeviceSurfacePresentModesKHR); \
-			VK_IMPORT_INSTANCE_FUNC(false, vkGetPhysicalDeviceSurfaceSupportKHR);      \
+			VK_IMPORT_INSTANCE_FUNC(true,  vkGetPhysicalDeviceSurfaceCapabilitiesKHR); \
+			VK_IMPORT_INSTANCE_FUNC(true,  vkGetPhysicalDeviceSurfaceFormatsKHR);      \
+			VK_IMPORT_INSTANCE_FUNC(true,  vkGetPhysicalDeviceSurfacePresentModesKHR); \
+			VK_IMPORT_INSTANCE_FUNC(true,  vkGetPhysicalDeviceSurfaceSupportKHR);      \
 			VK_IMPORT_INSTANCE_FUNC(false, vkCreateDevice);                            \
 			VK_IMPORT_INSTANCE_FUNC(false, vkDestroyDevice);                           \
-			VK_IMPORT_INSTANCE_FUNC(false, vkDestroySurfaceKHR);                       \
+			VK_IMPORT_INSTANCE_FUNC(true,  vkDestroySurfaceKHR);                       \
 			/* VK_EXT_debug_report */                                                  \
 			VK_IMPORT_INSTANCE_FUNC(true,  vkCreateDebugReportCallbackEXT);            \
 			VK_IMPORT_INSTANCE_FUNC(true,  vkDestroyDebugReportCallbackEXT);           \
@@ -91,16 +91,17 @@
 
 #define VK_IMPORT_DEVICE                                                   \
 			VK_IMPORT_DEVICE_FUNC(false, vkGetDeviceQueue);                \
-			VK_IMPORT_DEVICE_FUNC(false, vkCreateSwapchainKHR);            \
-			VK_IMPORT_DEVICE_FUNC(false, vkDestroySwapchainKHR);           \
-			VK_IMPORT_DEVICE_FUNC(false, vkGetSwapchainImagesKHR);         \
-			VK_IMPORT_DEVICE_FUNC(false, vkAcquireNextImageKHR);           \
-			VK_IMPORT_DEVICE_FUNC(false, vkQueuePresentKHR);               \
+			VK_IMPORT_DEVICE_FUNC(true,  vkCreateSwapchainKHR);            \
+			VK_IMPORT_DEVICE_FUNC(true,  vkDestroySwapchainKHR);           \
+			VK_IMPORT_DEVICE_FUNC(true,  vkGetSwapchainImagesKHR);         \
+			VK_IMPORT_DEVICE_FUNC(true,  vkAcquireNextImageKHR);           \
+			VK_IMPORT_DEVICE_FUNC(true,  vkQueuePresentKHR);               \
 			VK_IMPORT_DEVICE_FUNC(false, vkCreateFence);                   \
 			VK_IMPORT_DEVICE_FUNC(false, vkDestroyFence);                  \
 			VK_IMPORT_DEVICE_FUNC(false, vkCreateSemaphore);               \
 			VK_IMPORT_DEVICE_FUNC(false, vkDestroySemaphore);              \
 			VK_IMPORT_DEVICE_FUNC(false, vkResetFences);                   \
+			VK_IMPORT_DEVICE_FUNC(false, vkGetFenceStatus);                \
 			VK_IMPORT_DEVICE_FUNC(false, vkCreateCommandPool);             \
 			VK_IMPORT_DEVICE_FUNC(false, vkDestroyCommandPool);            \
 			VK_IMPORT_DEVICE_FUNC(false, vkResetCommandPool);              \
@@ -141,6 +142,9 @@
 			VK_IMPORT_DEVICE_FUNC(false, vkAllocateDescriptorSets);        \
 			VK_IMPORT_DEVICE_FUNC(false, vkFreeDescriptorSets);            \
 			VK_IMPORT_DEVICE_FUNC(false, vkUpdateDescriptorSets);          \
+			VK_IMPORT_DEVICE_FUNC(false, vkCreateQueryPool);               \
+			VK_IMPORT_DEVICE_FUNC(false, vkDestroyQueryPool);              \
+			VK_IMPORT_DEVICE_FUNC(false, vkGetQueryPoolResults);           \
 			VK_IMPORT_DEVICE_FUNC(false, vkQueueSubmit);                   \
 			VK_IMPORT_DEVICE_FUNC(false, vkQueueWaitIdle);                 \
 			VK_IMPORT_DEVICE_FUNC(false, vkDeviceWaitIdle);                \
@@ -171,7 +175,13 @@
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdResolveImage);               \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdCopyBuffer);                 \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdCopyBufferToImage);          \
+			VK_IMPORT_DEVICE_FUNC(false, vkCmdCopyImageToBuffer);          \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdBlitImage);                  \
+			VK_IMPORT_DEVICE_FUNC(false, vkCmdResetQueryPool);             \
+			VK_IMPORT_DEVICE_FUNC(false, vkCmdWriteTimestamp);             \
+			VK_IMPORT_DEVICE_FUNC(false, vkCmdBeginQuery);                 \
+			VK_IMPORT_DEVICE_FUNC(false, vkCmdEndQuery);                   \
+			VK_IMPORT_DEVICE_FUNC(false, vkCmdExecuteCommands);            \
 			VK_IMPORT_DEVICE_FUNC(false, vkMapMemory);                     \
 			VK_IMPORT_DEVICE_FUNC(false, vkUnmapMemory);                   \
 			VK_IMPORT_DEVICE_FUNC(false, vkFlushMappedMemoryRanges);       \
@@ -210,6 +220,7 @@
 			VK_DESTROY_FUNC(Pipeline);            \
 			VK_DESTROY_FUNC(PipelineCache);       \
 			VK_DESTROY_FUNC(PipelineLayout);      \
+			VK_DESTROY_FUNC(QueryPool);           \
 			VK_DESTROY_FUNC(RenderPass);          \
 			VK_DESTROY_FUNC(Semaphore);           \
 			VK_DESTROY_FUNC(ShaderModule);        \
@@ -283,10 +294,14 @@ namespace bgfx { namespace vk
 				const ::Vk##_name* operator &() const { return &vk; }    \
 			};                                                           \
 			BX_STATIC_ASSERT(sizeof(::Vk##_name) == sizeof(Vk##_name) ); \
-			void vkDestroy(Vk##_name&)
+			void vkDestroy(Vk##_name&);                                  \
+			void release(Vk##_name&)
 VK_DESTROY
 #undef VK_DESTROY_FUNC
 
+	/// Destroys object once GPU finished all frames that might still be using it.
+	void release(VkDeviceMemory& _memory);
+
 	struct DslBinding
 	{
 		enum Enum
@@ -326,7 +341,7 @@ VK_DESTROY
 			typename HashMap::iterator it = m_hashMap.find(_key);
 			if (it != m_hashMap.end() )
 			{
-				vkDestroy(it->second);
+				release(it->second);
 				m_hashMap.erase(it);
 			}
 		}
@@ -335,7 +350,7 @@ VK_DESTROY
 		{
 			for (typename HashMap::iterator it = m_hashMap.begin(), itEnd = m_hashMap.end(); it != itEnd; ++it)
 			{
-				vkDestroy(it->second);
+				release(it->second);
 			}
 
 			m_hashMap.clear();
@@ -527,9 +542,9 @@ VK_DESTROY
 
 		void* create(const Memory* _mem, uint64_t _flags, uint8_t _skip);
 		void destroy();
-		void update(VkCommandPool commandPool, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem);
+		void update(VkCommandBuffer _commandBuffer, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem);
 
-		void copyBufferToTexture(VkBuffer stagingBuffer, uint32_t bufferImageCopyCount, VkBufferImageCopy* bufferImageCopy);
+		void copyBufferToTexture(VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, uint32_t bufferImageCopyCount, VkBufferImageCopy* bufferImageCopy);
 		void setImageMemoryBarrier(VkCommandBuffer commandBuffer, VkImageLayout newImageLayout);
 
 		void*    m_directAccessPtr;
@@ -542,6 +557,7 @@ VK_DESTROY
 		uint8_t  m_requestedFormat;
 		uint8_t  m_textureFormat;
 		uint8_t  m_numMips;
+		uint8_t  m_residentMip;
 
 		VkImageViewType m_type;
 		VkFormat m_format;
@@ -585,6 +601,134 @@ VK_DESTROY
 		VkRenderPass m_renderPass;
 	};
 
+	struct TimerQueryVK
+	{
+		TimerQueryVK()
+			: m_control(BX_COUNTOF(m_query) )
+		{
+		}
+
+		VkResult init();
+		void shutdown();
+		uint32_t begin(uint32_t _resultIdx);
+		void end(uint32_t _idx);
+		bool update();
+
+		struct Query
+		{
+			uint32_t m_resultIdx;
+			bool     m_ready;
+			uint64_t m_frameNum;
+		};
+
+		struct Result
+		{
+			void reset()
+			{
+				m_begin     = 0;
+				m_end       = 0;
+				m_pending   = 0;
+			}
+
+			uint64_t m_begin;
+			uint64_t m_end;
+			uint32_t m_pending;
+		};
+
+		uint64_t m_frequency;
+
+		Result m_result[BGFX_CONFIG_MAX_VIEWS+1];
+		Query m_query[BGFX_CONFIG_MAX_VIEWS*4];
+
+		VkQueryPool m_queryPool;
+		bx::RingBufferControl m_control;
+	};
+
+	struct OcclusionQueryVK
+	{
+		OcclusionQueryVK()
+			: m_control(BX_COUNTOF(m_handle) )
+		{
+		}
+
+		VkResult init();
+		void shutdown();
+		bool begin(VkCommandBuffer _commandBuffer, OcclusionQueryHandle _handle);
+		void end(VkCommandBuffer _commandBuffer);
+		void resolve(VkCommandBuffer _commandBuffer, Frame* _render);
+		void invalidate(OcclusionQueryHandle _handle);
+
+		VkQueryPool m_queryPool;
+		OcclusionQueryHandle m_handle[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
+		uint64_t m_frameNum[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
+		bx::RingBufferControl m_control;
+	};
+
+	// Draw call recording state. Render thread records into primary command buffer, and
+	// record threads record ranges of large views into secondary command buffers. Recorders
+	// with copy-on-write uniforms keep uniform updates private, and shared uniform values are
+	// not modified while views are recorded in parallel.
+	struct RecorderVK
+	{
+		RecorderVK()
+			: m_viewState(NULL)
+			, m_scratchBuffer(NULL)
+			, m_commandBuffer(VK_NULL_HANDLE)
+			, m_descriptorPool(VK_NULL_HANDLE)
+			, m_uniforms(NULL)
+			, m_uniformCopy(NULL)
+			, m_uniformCopySize(NULL)
+			, m_vsScratch(NULL)
+			, m_fsScratch(NULL)
+			, m_parallel(false)
+		{
+			resetStats();
+		}
+
+		void begin(VkCommandBuffer _commandBuffer, uint16_t _view, const Rect& _viewScissorRect, bool _viewHasScissor);
+		void resetStats();
+		void resetUniforms();
+		void updateUniform(uint16_t _loc, const void* _data, uint32_t _size);
+		void updateUniforms(UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end, bool _marker);
+		void commit(UniformBuffer& _uniformBuffer);
+		void setShaderUniform(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs);
+		void setShaderUniform4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs);
+		void setShaderUniform4x4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs);
+		uint32_t allocScratch(uint32_t _size);
+
+		RenderDraw       m_currentState;
+		ViewState*       m_viewState;
+		ScratchBufferVK* m_scratchBuffer;
+		VkCommandBuffer  m_commandBuffer;
+		VkDescriptorPool m_descriptorPool;
+		VkDescriptorSet  m_descriptorSet;
+		VkPipeline       m_currentPipeline;
+		ProgramHandle    m_currentProgram;
+		uint32_t         m_currentBindHash;
+		uint32_t         m_currentDslHash;
+		uint32_t         m_blendFactor;
+		Rect             m_viewScissorRect;
+		uint16_t         m_view;
+		uint8_t          m_primIndex;
+		uint8_t          m_prim;
+		bool             m_viewHasScissor;
+		bool             m_restoreScissor;
+		bool             m_hasPredefined;
+		bool             m_commandListChanged;
+
+		void**    m_uniforms;
+		void**    m_uniformCopy;
+		uint32_t* m_uniformCopySize;
+		uint8_t*  m_vsScratch;
+		uint8_t*  m_fsScratch;
+		bool      m_parallel;
+
+		uint32_t m_numPrimsSubmitted[Topology::Count+1];
+		uint32_t m_numPrimsRendered[Topology::Count+1];
+		uint32_t m_numInstances[Topology::Count+1];
+		uint32_t m_numIndices;
+	};
+
 } /* namespace bgfx */ } // namespace vk
 
 #endif // BGFX_RENDERER_VK_H_HEADER_GUARD
@@ -882,6 +882,14 @@ namespace bgfx { namespace webgpu
 			readback(texture.m_readback, texture, _data);
 		}
 
+		void setTextureResidentMip(TextureHandle _handle, uint8_t _mip) override
+		{
+			// Resident mip is applied with sampler lodMinClamp when texture is bound, so that
+			// texture view keeps full mip chain and mip numbering in shader is unchanged.
+			TextureWgpu& texture = m_textures[_handle.idx];
+			texture.m_residentMip = bx::min<uint8_t>(_mip, texture.m_numMips-1);
+		}
+
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) override
 		{
 			TextureWgpu& texture = m_textures[_handle.idx];
@@ -1372,8 +1380,11 @@ namespace bgfx { namespace webgpu
 							wgpu::BindGroupEntry& samplerEntry = b.m_entries[b.numEntries++];
 							samplerEntry.binding = bindInfo.m_binding + 16;
 							samplerEntry.sampler = 0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & flags)
-								? getSamplerState(flags)
-								: texture.m_sampler;
+								? getSamplerState(flags, texture.m_residentMip)
+								: 0 == texture.m_residentMip
+								? texture.m_sampler
+								: getSamplerState(uint32_t(texture.m_flags), texture.m_residentMip)
+								;
 						}
 					}
 					break;
@@ -2175,10 +2186,11 @@ namespace bgfx { namespace webgpu
 		}
 
 
-		wgpu::Sampler getSamplerState(uint32_t _flags)
+		wgpu::Sampler getSamplerState(uint32_t _flags, uint8_t _minMip = 0)
 		{
 			_flags &= BGFX_SAMPLER_BITS_MASK;
-			SamplerStateWgpu* sampler = m_samplerStateCache.find(_flags);
+			const uint64_t key = uint64_t(_flags) | (uint64_t(_minMip) << 32);
+			SamplerStateWgpu* sampler = m_samplerStateCache.find(key);
 
 			if (NULL == sampler)
 			{
@@ -2191,7 +2203,7 @@ namespace bgfx { namespace webgpu
 				desc.minFilter    = s_textureFilterMinMag[(_flags&BGFX_SAMPLER_MIN_MASK)>>BGFX_SAMPLER_MIN_SHIFT];
 				desc.magFilter    = s_textureFilterMinMag[(_flags&BGFX_SAMPLER_MAG_MASK)>>BGFX_SAMPLER_MAG_SHIFT];
 				desc.mipmapFilter = s_textureFilterMip[(_flags&BGFX_SAMPLER_MIP_MASK)>>BGFX_SAMPLER_MIP_SHIFT];
-				desc.lodMinClamp  = 0;
+				desc.lodMinClamp  = float(_minMip);
 				desc.lodMaxClamp  = bx::kFloatMax;
 
 				const uint32_t cmpFunc = (_flags&BGFX_SAMPLER_COMPARE_MASK)>>BGFX_SAMPLER_COMPARE_SHIFT;
@@ -2201,7 +2213,7 @@ namespace bgfx { namespace webgpu
 					;
 
 				sampler->m_sampler = s_renderWgpu->m_device.CreateSampler(&desc);
-				m_samplerStateCache.add(_flags, sampler);
+				m_samplerStateCache.add(key, sampler);
 			}
 
 			return sampler->m_sampler;
@@ -2955,6 +2967,7 @@ namespace bgfx { namespace webgpu
 			m_depth     = ti.depth;
 			m_numLayers = ti.numLayers;
 			m_numMips   = ti.numMips;
+			m_residentMip = 0;
 			m_numSides  = ti.numLayers * (imageContainer.m_cubeMap ? 6 : 1);
 			m_requestedFormat  = TextureFormat::Enum(imageContainer.m_format);
 			m_textureFormat    = getViableTextureFormat(imageContainer);
@@ -4100,6 +4113,7 @@ namespace bgfx { namespace webgpu
 			, m_gpuTimer
 			, s_viewName
 			);
+		profiler.setPrimStats(statsNumPrimsRendered, statsNumInstances);
 
 		if (0 == (_render->m_debug & BGFX_DEBUG_IFH))
 		{
@@ -4493,13 +4507,7 @@ namespace bgfx { namespace webgpu
 						rce.SetVertexBuffer(idx, vb.m_ptr, offset);
 					}
 
-					bool index32 = false;
-
-					if (isValid(draw.m_indexBuffer))
-					{
-						const IndexBufferWgpu& ib = m_indexBuffers[draw.m_indexBuffer.idx];
-						index32 = 0 != (ib.m_flags & BGFX_BUFFER_INDEX32);
-					}
+					const bool index32 = isValid(draw.m_indexBuffer) && !draw.isIndex16();
 
 					currentState.m_numVertices = numVertices;
 
@@ -4662,7 +4670,7 @@ namespace bgfx { namespace webgpu
 						{
 							const IndexBufferWgpu& ib = m_indexBuffers[draw.m_indexBuffer.idx];
 
-							const uint32_t indexSize = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+							const uint32_t indexSize = draw.isIndex16() ? 2 : 4;
 
 							if (UINT32_MAX == draw.m_numIndices)
 							{
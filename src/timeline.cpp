@@ -0,0 +1,743 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_p.h"
+#include "timeline.h"
+
+#include <bx/file.h>
+#include <bx/thread.h>
+
+namespace bgfx
+{
+	int32_t g_timelineEnabled = 0;
+
+	// Must be called with timeline mutex held, value before change is known.
+	static void timelineSetEnabled(bool _enabled)
+	{
+		bx::atomicCompareAndSwap<int32_t>(&g_timelineEnabled, _enabled ? 0 : 1, _enabled ? 1 : 0);
+	}
+
+	struct TimelineEvent
+	{
+		enum Enum
+		{
+			Begin,    //!< CPU scope begin on thread owning ring buffer.
+			End,      //!< CPU scope end on thread owning ring buffer.
+			Complete, //!< CPU interval on synthetic track.
+			Gpu,      //!< GPU interval in GPU timer ticks.
+			GpuSync,  //!< CPU time when GPU frame end time was read back.
+		};
+
+		int64_t  m_begin;
+		int64_t  m_end;
+		uint32_t m_abgr;
+		uint16_t m_track;
+		uint8_t  m_type;
+		char     m_name[41];
+	};
+
+	BX_STATIC_ASSERT(64 == sizeof(TimelineEvent) );
+
+	struct TimelineThread
+	{
+		TimelineEvent* m_event;
+		uint32_t m_write; //!< Number of events ever written, only owning thread writes it.
+		char m_name[64];
+	};
+
+	// Thread ids are tid in trace. Synthetic tracks use ids that never collide with them.
+	static constexpr uint32_t kTimelineMaxThreads   = 64;
+	static constexpr uint32_t kTimelineMaxDepth     = 64;
+	static constexpr uint32_t kTimelineTrackViews   = 1000;
+	static constexpr uint32_t kTimelineTrackGpu     = 1001;
+	static constexpr uint32_t kTimelineTrackEncoder = 1100;
+
+	// Events closest to write position might be overwritten while ring buffers are copied.
+	static constexpr uint32_t kTimelineSlack = 64;
+	BX_STATIC_ASSERT(kTimelineSlack < BGFX_CONFIG_TRACE_MAX_EVENTS);
+
+	struct TimelineContext
+	{
+		TimelineContext()
+			: m_numThreads(0)
+			, m_generation(1)
+			, m_numFrames(0)
+			, m_start(0)
+			, m_gpuFreq(0)
+			, m_exporting(false)
+		{
+			m_filePath[0] = '\0';
+		}
+
+		bx::Mutex m_mutex;
+		TimelineThread m_thread[kTimelineMaxThreads];
+		uint32_t m_numThreads;
+		uint32_t m_generation;
+		uint32_t m_numFrames;
+		int64_t  m_start;
+		int64_t  m_gpuFreq;
+		char     m_filePath[1024];
+		bool     m_exporting; //!< Ring buffers are being copied, new trace can't start.
+
+		// Trace file is formatted and written from snapshot on export thread.
+		bx::Thread m_exportThread;
+	};
+
+	// Copy of recorded events, owned by export thread. Events of thread `ii` are in range
+	// [m_offset[ii], m_offset[ii+1]).
+	struct TimelineSnapshot
+	{
+		TimelineEvent* m_event;
+		uint32_t m_offset[kTimelineMaxThreads+1];
+		char     m_name[kTimelineMaxThreads][64];
+		uint32_t m_numThreads;
+		int64_t  m_start;
+		int64_t  m_end;
+		int64_t  m_gpuFreq;
+		char     m_filePath[1024];
+	};
+
+	static TimelineContext s_timeline;
+
+	// Thread local value is generation<<8 | (slot+1). Generation changes on shutdown, so threads
+	// that outlive bgfx instance register again with the next one.
+	//
+	// Thread name is kept until thread records first event and gets ring buffer.
+#if defined(BX_THREAD_LOCAL)
+	static BX_THREAD_LOCAL uint32_t s_timelineThreadId(0);
+	static BX_THREAD_LOCAL const char* s_timelineThreadName(NULL);
+
+	static uint32_t timelineGetThreadId()
+	{
+		return s_timelineThreadId;
+	}
+
+	static void timelineSetThreadId(uint32_t _id)
+	{
+		s_timelineThreadId = _id;
+	}
+
+	static const char* timelineGetPendingName()
+	{
+		return s_timelineThreadName;
+	}
+
+	static void timelineSetPendingName(const char* _name)
+	{
+		s_timelineThreadName = _name;
+	}
+#else
+	static bx::TlsData s_timelineThreadId;
+	static bx::TlsData s_timelineThreadName;
+
+	static uint32_t timelineGetThreadId()
+	{
+		return uint32_t(uintptr_t(s_timelineThreadId.get() ) );
+	}
+
+	static void timelineSetThreadId(uint32_t _id)
+	{
+		s_timelineThreadId.set( (void*)uintptr_t(_id) );
+	}
+
+	static const char* timelineGetPendingName()
+	{
+		return (const char*)s_timelineThreadName.get();
+	}
+
+	static void timelineSetPendingName(const char* _name)
+	{
+		s_timelineThreadName.set( (void*)_name);
+	}
+#endif // defined(BX_THREAD_LOCAL)
+
+	static TimelineThread* timelineGetThread()
+	{
+		const uint32_t id = timelineGetThreadId();
+
+		if (0 != (id & 0xff)
+		&&  s_timeline.m_generation == (id >> 8) )
+		{
+			return &s_timeline.m_thread[(id & 0xff) - 1];
+		}
+
+		bx::MutexScope scope(s_timeline.m_mutex);
+
+		if (kTimelineMaxThreads == s_timeline.m_numThreads)
+		{
+			return NULL;
+		}
+
+		const uint32_t slot = s_timeline.m_numThreads++;
+
+		TimelineThread& thread = s_timeline.m_thread[slot];
+		thread.m_event = NULL;
+		thread.m_write = 0;
+
+		const char* name = timelineGetPendingName();
+		if (NULL != name)
+		{
+			bx::strCopy(thread.m_name, BX_COUNTOF(thread.m_name), name);
+		}
+		else
+		{
+			bx::snprintf(thread.m_name, BX_COUNTOF(thread.m_name), "Thread %d", slot);
+		}
+
+		timelineSetThreadId(s_timeline.m_generation << 8 | (slot + 1) );
+
+		return &thread;
+	}
+
+	static TimelineEvent* timelineAlloc(TimelineThread& _thread, uint8_t _type, uint16_t _track, const char* _name, uint32_t _abgr)
+	{
+		if (NULL == _thread.m_event)
+		{
+			_thread.m_event = (TimelineEvent*)BX_ALLOC(g_allocator, BGFX_CONFIG_TRACE_MAX_EVENTS*sizeof(TimelineEvent) );
+		}
+
+		TimelineEvent* event = &_thread.m_event[_thread.m_write % BGFX_CONFIG_TRACE_MAX_EVENTS];
+		event->m_begin = 0;
+		event->m_end   = 0;
+		event->m_abgr  = _abgr;
+		event->m_track = _track;
+		event->m_type  = _type;
+		bx::strCopy(event->m_name, BX_COUNTOF(event->m_name), _name);
+
+		return event;
+	}
+
+	static void timelineCommit(TimelineThread& _thread)
+	{
+		// Publish event to thread writing trace file.
+		bx::atomicFetchAndAdd<uint32_t>(&_thread.m_write, 1);
+	}
+
+	static void timelineWriteEvent(uint8_t _type, uint16_t _track, const char* _name, uint32_t _abgr, int64_t _begin, int64_t _end)
+	{
+		TimelineThread* thread = timelineGetThread();
+
+		if (NULL != thread)
+		{
+			TimelineEvent* event = timelineAlloc(*thread, _type, _track, _name, _abgr);
+			event->m_begin = _begin;
+			event->m_end   = _end;
+			timelineCommit(*thread);
+		}
+	}
+
+	void timelineWriteBegin(const char* _name, uint32_t _abgr)
+	{
+		timelineWriteEvent(TimelineEvent::Begin, 0, _name, _abgr, bx::getHPCounter(), 0);
+	}
+
+	void timelineWriteEnd()
+	{
+		timelineWriteEvent(TimelineEvent::End, 0, "", 0, bx::getHPCounter(), 0);
+	}
+
+	static void timelineWriteInterval(uint8_t _type, uint16_t _track, const char* _name, int64_t _begin, int64_t _end)
+	{
+		timelineWriteEvent(_type, _track, _name, 0, _begin, _end);
+	}
+
+	static TimelineSnapshot* timelineSnapshot(const char* _filePath, int64_t _start, int64_t _gpuFreq, uint32_t _numThreads);
+	static void timelineExport(TimelineSnapshot* _snapshot);
+
+	void timelineWriteEncoders(const EncoderStats* _encoderStats, uint16_t _numEncoders)
+	{
+		for (uint16_t ii = 0; ii < _numEncoders; ++ii)
+		{
+			const EncoderStats& stats = _encoderStats[ii];
+
+			if (stats.cpuTimeBegin < stats.cpuTimeEnd)
+			{
+				timelineWriteInterval(
+					  TimelineEvent::Complete
+					, uint16_t(kTimelineTrackEncoder + ii)
+					, "Encoder submit"
+					, stats.cpuTimeBegin
+					, stats.cpuTimeEnd
+					);
+			}
+		}
+	}
+
+	void timelineWriteFrame(const Stats& _stats)
+	{
+		timelineWriteInterval(TimelineEvent::Complete, kTimelineTrackViews, "Render submit", _stats.cpuTimeBegin, _stats.cpuTimeEnd);
+
+		const bool gpuTimer = 0 != _stats.gpuTimerFreq
+			&& _stats.gpuTimeBegin < _stats.gpuTimeEnd
+			;
+
+		if (gpuTimer)
+		{
+			s_timeline.m_gpuFreq = _stats.gpuTimerFreq;
+			timelineWriteInterval(TimelineEvent::Gpu,     kTimelineTrackGpu, "GPU frame", _stats.gpuTimeBegin, _stats.gpuTimeEnd);
+			timelineWriteInterval(TimelineEvent::GpuSync, kTimelineTrackGpu, "",          bx::getHPCounter(),  _stats.gpuTimeEnd);
+		}
+
+		for (uint16_t ii = 0; ii < _stats.numViews; ++ii)
+		{
+			const ViewStats& viewStats = _stats.viewStats[ii];
+
+			if (viewStats.cpuTimeBegin < viewStats.cpuTimeEnd)
+			{
+				timelineWriteInterval(TimelineEvent::Complete, kTimelineTrackViews, viewStats.name, viewStats.cpuTimeBegin, viewStats.cpuTimeEnd);
+			}
+
+			if (gpuTimer
+			&&  viewStats.gpuTimeBegin < viewStats.gpuTimeEnd)
+			{
+				timelineWriteInterval(TimelineEvent::Gpu, kTimelineTrackGpu, viewStats.name, viewStats.gpuTimeBegin, viewStats.gpuTimeEnd);
+			}
+		}
+
+		char     filePath[BX_COUNTOF(s_timeline.m_filePath)];
+		int64_t  start;
+		int64_t  gpuFreq;
+		uint32_t numThreads;
+
+		{
+			bx::MutexScope scope(s_timeline.m_mutex);
+
+			if (0 == s_timeline.m_numFrames
+			||  0 != --s_timeline.m_numFrames)
+			{
+				return;
+			}
+
+			timelineSetEnabled(false);
+			s_timeline.m_exporting = true;
+
+			bx::strCopy(filePath, BX_COUNTOF(filePath), s_timeline.m_filePath);
+			start      = s_timeline.m_start;
+			gpuFreq    = s_timeline.m_gpuFreq;
+			numThreads = s_timeline.m_numThreads;
+		}
+
+		TimelineSnapshot* snapshot = timelineSnapshot(filePath, start, gpuFreq, numThreads);
+
+		{
+			bx::MutexScope scope(s_timeline.m_mutex);
+			s_timeline.m_exporting = false;
+		}
+
+		timelineExport(snapshot);
+	}
+
+	void timelineSetThreadName(const char* _name)
+	{
+		if (!BX_ENABLED(BGFX_CONFIG_TRACE) )
+		{
+			return;
+		}
+
+		timelineSetPendingName(_name);
+
+		// Thread that doesn't record isn't registered, name is picked up with its first event.
+		if (!timelineIsEnabled() )
+		{
+			return;
+		}
+
+		TimelineThread* thread = timelineGetThread();
+
+		if (NULL != thread)
+		{
+			bx::strCopy(thread->m_name, BX_COUNTOF(thread->m_name), _name);
+		}
+	}
+
+	void timelineRequest(const char* _filePath, uint32_t _numFrames)
+	{
+		if (!BX_ENABLED(BGFX_CONFIG_TRACE) )
+		{
+			BX_TRACE("Trace can't be recorded, library is built with BGFX_CONFIG_TRACE 0.");
+			return;
+		}
+
+		bx::MutexScope scope(s_timeline.m_mutex);
+
+		if (timelineIsEnabled()
+		||  s_timeline.m_exporting)
+		{
+			BX_TRACE("Trace '%s' is already being recorded.", s_timeline.m_filePath);
+			return;
+		}
+
+		bx::strCopy(s_timeline.m_filePath, BX_COUNTOF(s_timeline.m_filePath), _filePath);
+		s_timeline.m_numFrames = bx::max<uint32_t>(_numFrames, 1);
+		s_timeline.m_start     = bx::getHPCounter();
+		s_timeline.m_gpuFreq   = 0;
+
+		timelineSetEnabled(true);
+	}
+
+	static void timelineExportWait();
+
+	void timelineShutdown()
+	{
+		timelineExportWait();
+
+		bx::MutexScope scope(s_timeline.m_mutex);
+
+		timelineSetEnabled(false);
+
+		for (uint32_t ii = 0; ii < s_timeline.m_numThreads; ++ii)
+		{
+			BX_FREE(g_allocator, s_timeline.m_thread[ii].m_event);
+			s_timeline.m_thread[ii].m_event = NULL;
+		}
+
+		s_timeline.m_numThreads = 0;
+		s_timeline.m_numFrames  = 0;
+		++s_timeline.m_generation;
+	}
+
+	static void timelineEscape(char* _out, uint32_t _max, const char* _str)
+	{
+		uint32_t len = 0;
+
+		for (const char* ptr = _str; '\0' != *ptr && len + 2 < _max; ++ptr)
+		{
+			const char ch = *ptr;
+
+			if ('"' == ch
+			||  '\\' == ch)
+			{
+				_out[len++] = '\\';
+				_out[len++] = ch;
+			}
+			else
+			{
+				_out[len++] = uint8_t(ch) < 0x20 ? ' ' : ch;
+			}
+		}
+
+		_out[len] = '\0';
+	}
+
+	struct TimelineWriter
+	{
+		TimelineWriter(bx::WriterI* _writer, int64_t _start)
+			: m_writer(_writer)
+			, m_toUs(1000000.0/double(bx::getHPFrequency() ) )
+			, m_start(_start)
+			, m_first(true)
+		{
+		}
+
+		double toUs(int64_t _time) const
+		{
+			return double(_time - m_start)*m_toUs;
+		}
+
+		void separator()
+		{
+			bx::write(m_writer, &m_err, m_first ? "\n" : ",\n");
+			m_first = false;
+		}
+
+		void trackName(uint32_t _tid, const char* _name)
+		{
+			char name[128];
+			timelineEscape(name, BX_COUNTOF(name), _name);
+
+			separator();
+			bx::write(m_writer, &m_err
+				, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}"
+				, _tid
+				, name
+				);
+		}
+
+		void interval(uint32_t _tid, const char* _name, uint32_t _abgr, double _ts, double _dur)
+		{
+			char name[128];
+			timelineEscape(name, BX_COUNTOF(name), _name);
+
+			separator();
+			bx::write(m_writer, &m_err
+				, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"color\":\"#%02x%02x%02x\"}}"
+				, name
+				, _tid
+				, _ts
+				, bx::max(_dur, 0.0)
+				, (_abgr    )&0xff
+				, (_abgr>> 8)&0xff
+				, (_abgr>>16)&0xff
+				);
+		}
+
+		bx::WriterI* m_writer;
+		bx::Error m_err;
+		double  m_toUs;
+		int64_t m_start;
+		bool    m_first;
+	};
+
+	// Called on render thread after recording is stopped. Only copies events, trace is formatted
+	// on export thread.
+	static TimelineSnapshot* timelineSnapshot(const char* _filePath, int64_t _start, int64_t _gpuFreq, uint32_t _numThreads)
+	{
+		TimelineSnapshot* snapshot = BX_NEW(g_allocator, TimelineSnapshot);
+		snapshot->m_numThreads = _numThreads;
+		snapshot->m_start      = _start;
+		snapshot->m_end        = bx::getHPCounter();
+		snapshot->m_gpuFreq    = _gpuFreq;
+		bx::strCopy(snapshot->m_filePath, BX_COUNTOF(snapshot->m_filePath), _filePath);
+
+		uint32_t first[kTimelineMaxThreads];
+		uint32_t numEvents = 0;
+
+		for (uint32_t ii = 0; ii < _numThreads; ++ii)
+		{
+			TimelineThread& thread = s_timeline.m_thread[ii];
+
+			// Owning thread might still be committing events recorded before trace was stopped.
+			const uint32_t write = NULL != thread.m_event
+				? bx::atomicFetchAndAdd<uint32_t>(&thread.m_write, 0)
+				: 0
+				;
+
+			first[ii] = write > BGFX_CONFIG_TRACE_MAX_EVENTS - kTimelineSlack
+				? write - (BGFX_CONFIG_TRACE_MAX_EVENTS - kTimelineSlack)
+				: 0
+				;
+
+			snapshot->m_offset[ii] = numEvents;
+			numEvents += write - first[ii];
+
+			bx::strCopy(snapshot->m_name[ii], BX_COUNTOF(snapshot->m_name[ii]), thread.m_name);
+		}
+
+		snapshot->m_offset[_numThreads] = numEvents;
+		snapshot->m_event = (TimelineEvent*)BX_ALLOC(g_allocator, bx::max<uint32_t>(numEvents, 1)*sizeof(TimelineEvent) );
+
+		for (uint32_t ii = 0; ii < _numThreads; ++ii)
+		{
+			const TimelineThread& thread = s_timeline.m_thread[ii];
+			const uint32_t num   = snapshot->m_offset[ii+1] - snapshot->m_offset[ii];
+
+			if (0 < num)
+			{
+				// Ring buffer range might wrap around.
+				const uint32_t begin = first[ii] % BGFX_CONFIG_TRACE_MAX_EVENTS;
+				const uint32_t num0  = bx::min<uint32_t>(num, BGFX_CONFIG_TRACE_MAX_EVENTS - begin);
+
+				TimelineEvent* dst = &snapshot->m_event[snapshot->m_offset[ii] ];
+				bx::memCopy(dst,        &thread.m_event[begin], num0*sizeof(TimelineEvent) );
+				bx::memCopy(&dst[num0], &thread.m_event[0],     (num - num0)*sizeof(TimelineEvent) );
+			}
+		}
+
+		return snapshot;
+	}
+
+	static void timelineSnapshotDestroy(TimelineSnapshot* _snapshot)
+	{
+		BX_FREE(g_allocator, _snapshot->m_event);
+		BX_DELETE(g_allocator, _snapshot);
+	}
+
+	static bool timelineExportWrite(bx::WriterI* _writer, const TimelineSnapshot& _snapshot)
+	{
+		const int64_t start = _snapshot.m_start;
+		const int64_t end   = _snapshot.m_end;
+
+		TimelineWriter out(_writer, start);
+
+		// GPU and CPU timers are not synchronized. GPU frame can't end after CPU read back its end
+		// time, place GPU timeline as late as that allows across all recorded frames.
+		const double gpuToUs = 0 != _snapshot.m_gpuFreq
+			? 1000000.0/double(_snapshot.m_gpuFreq)
+			: 0.0
+			;
+		double gpuOffset = 0.0;
+		bool   hasGpu    = false;
+
+		for (uint32_t jj = 0, num = _snapshot.m_offset[_snapshot.m_numThreads]; jj < num; ++jj)
+		{
+			const TimelineEvent& event = _snapshot.m_event[jj];
+
+			if (TimelineEvent::GpuSync == event.m_type
+			&&  start <= event.m_begin)
+			{
+				const double offset = out.toUs(event.m_begin) - double(event.m_end)*gpuToUs;
+				gpuOffset = hasGpu ? bx::min(gpuOffset, offset) : offset;
+				hasGpu    = true;
+			}
+		}
+
+		bx::write(_writer, &out.m_err, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+		out.separator();
+		bx::write(_writer, &out.m_err, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"bgfx\"}}");
+
+		uint32_t numEncoders = 0;
+
+		for (uint32_t ii = 0; ii < _snapshot.m_numThreads; ++ii)
+		{
+			const uint32_t tid = ii + 1;
+
+			out.trackName(tid, _snapshot.m_name[ii]);
+
+			// Scopes are matched per thread. End without begin is scope that was open when ring
+			// buffer wrapped, begin without end is still open and ends with trace.
+			uint32_t stack[kTimelineMaxDepth];
+			uint32_t depth    = 0;
+			uint32_t overflow = 0;
+
+			for (uint32_t jj = _snapshot.m_offset[ii], jend = _snapshot.m_offset[ii+1]; jj < jend; ++jj)
+			{
+				const TimelineEvent& event = _snapshot.m_event[jj];
+
+				switch (event.m_type)
+				{
+				case TimelineEvent::Begin:
+					if (kTimelineMaxDepth == depth)
+					{
+						++overflow;
+					}
+					else
+					{
+						stack[depth++] = jj;
+					}
+					break;
+
+				case TimelineEvent::End:
+					if (0 < overflow)
+					{
+						--overflow;
+					}
+					else if (0 < depth)
+					{
+						const TimelineEvent& begin = _snapshot.m_event[stack[--depth] ];
+
+						if (start <= begin.m_begin)
+						{
+							out.interval(tid, begin.m_name, begin.m_abgr, out.toUs(begin.m_begin), out.toUs(event.m_begin) - out.toUs(begin.m_begin) );
+						}
+					}
+					break;
+
+				case TimelineEvent::Complete:
+					if (start <= event.m_begin)
+					{
+						if (kTimelineTrackEncoder <= event.m_track)
+						{
+							numEncoders = bx::max<uint32_t>(numEncoders, event.m_track - kTimelineTrackEncoder + 1);
+						}
+
+						out.interval(event.m_track, event.m_name, event.m_abgr, out.toUs(event.m_begin), out.toUs(event.m_end) - out.toUs(event.m_begin) );
+					}
+					break;
+
+				case TimelineEvent::Gpu:
+					if (hasGpu)
+					{
+						const double ts = double(event.m_begin)*gpuToUs + gpuOffset;
+
+						if (0.0 <= ts)
+						{
+							out.interval(event.m_track, event.m_name, event.m_abgr, ts, double(event.m_end - event.m_begin)*gpuToUs);
+						}
+					}
+					break;
+
+				default:
+					break;
+				}
+			}
+
+			while (0 < depth)
+			{
+				const TimelineEvent& begin = _snapshot.m_event[stack[--depth] ];
+
+				if (start <= begin.m_begin)
+				{
+					out.interval(tid, begin.m_name, begin.m_abgr, out.toUs(begin.m_begin), out.toUs(end) - out.toUs(begin.m_begin) );
+				}
+			}
+		}
+
+		out.trackName(kTimelineTrackViews, "Render thread views");
+
+		if (hasGpu)
+		{
+			out.trackName(kTimelineTrackGpu, "GPU");
+		}
+
+		for (uint32_t ii = 0; ii < numEncoders; ++ii)
+		{
+			char name[32];
+			bx::snprintf(name, BX_COUNTOF(name), "Encoder %d", ii);
+			out.trackName(kTimelineTrackEncoder + ii, name);
+		}
+
+		bx::write(_writer, &out.m_err, "\n]}\n");
+
+		return out.m_err.isOk();
+	}
+
+	static void timelineExportFile(TimelineSnapshot* _snapshot)
+	{
+		bx::FileWriter writer;
+
+		if (bx::open(&writer, _snapshot->m_filePath) )
+		{
+			const bool ok = timelineExportWrite(&writer, *_snapshot);
+			bx::close(&writer);
+
+			if (ok)
+			{
+				BX_TRACE("Trace written to '%s'.", _snapshot->m_filePath);
+			}
+			else
+			{
+				BX_TRACE("Failed to write trace file '%s'.", _snapshot->m_filePath);
+			}
+		}
+		else
+		{
+			BX_TRACE("Failed to open trace file '%s'.", _snapshot->m_filePath);
+		}
+
+		timelineSnapshotDestroy(_snapshot);
+	}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	static int32_t timelineExportThread(bx::Thread* /*_self*/, void* _userData)
+	{
+		timelineExportFile( (TimelineSnapshot*)_userData);
+		return bx::kExitSuccess;
+	}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+	// Waits for previous trace file to be written.
+	static void timelineExportWait()
+	{
+#if BX_CONFIG_SUPPORTS_THREADING
+		if (s_timeline.m_exportThread.isRunning() )
+		{
+			s_timeline.m_exportThread.shutdown();
+		}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+	}
+
+	static void timelineExport(TimelineSnapshot* _snapshot)
+	{
+		timelineExportWait();
+
+#if BX_CONFIG_SUPPORTS_THREADING
+		s_timeline.m_exportThread.init(timelineExportThread, _snapshot, 0, "bgfx - trace writer");
+#else
+		timelineExportFile(_snapshot);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+	}
+
+} // namespace bgfx
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_TIMELINE_H_HEADER_GUARD
+#define BGFX_TIMELINE_H_HEADER_GUARD
+
+#include <bx/bx.h>
+#include <bgfx/bgfx.h>
+#include "config.h"
+
+namespace bgfx
+{
+	/// Timeline recorder backing `bgfx::requestTrace`.
+	///
+	/// Every thread writes events into its own ring buffer without taking locks. Render thread
+	/// counts recorded frames and copies all ring buffers once trace is stopped. Export thread
+	/// merges the copy with encoder and GPU view timings, and writes Chrome trace event JSON,
+	/// which can be opened in chrome://tracing or Perfetto UI.
+	///
+	/// When trace is not recorded, every entry point costs one flag check.
+	///
+	/// Flag is changed only with atomic operations while holding timeline mutex, and it's read
+	/// without lock from any thread.
+	extern int32_t g_timelineEnabled;
+
+	///
+	inline bool timelineIsEnabled()
+	{
+		return BX_ENABLED(BGFX_CONFIG_TRACE) && 0 != *(volatile int32_t*)&g_timelineEnabled;
+	}
+
+	///
+	void timelineWriteBegin(const char* _name, uint32_t _abgr);
+
+	///
+	void timelineWriteEnd();
+
+	///
+	void timelineWriteEncoders(const EncoderStats* _encoderStats, uint16_t _numEncoders);
+
+	///
+	void timelineWriteFrame(const Stats& _stats);
+
+	/// Begin CPU scope on calling thread.
+	inline void timelineBegin(const char* _name, uint32_t _abgr)
+	{
+		if (timelineIsEnabled() )
+		{
+			timelineWriteBegin(_name, _abgr);
+		}
+	}
+
+	/// End CPU scope on calling thread.
+	inline void timelineEnd()
+	{
+		if (timelineIsEnabled() )
+		{
+			timelineWriteEnd();
+		}
+	}
+
+	/// Record encoder submit times. Must be called from API thread once encoders are done.
+	inline void timelineEncoders(const EncoderStats* _encoderStats, uint16_t _numEncoders)
+	{
+		if (timelineIsEnabled() )
+		{
+			timelineWriteEncoders(_encoderStats, _numEncoders);
+		}
+	}
+
+	/// Record view timings of rendered frame, and write trace file once requested number of frames
+	/// is recorded. Must be called from render thread after frame is submitted. Trace file is
+	/// formatted and written on worker thread.
+	inline void timelineFrame(const Stats& _stats)
+	{
+		if (timelineIsEnabled() )
+		{
+			timelineWriteFrame(_stats);
+		}
+	}
+
+	/// Name calling thread in trace. `_name` must stay valid until thread records its first event.
+	void timelineSetThreadName(const char* _name);
+
+	/// Start recording trace, which will be written to `_filePath` after `_numFrames` frames are
+	/// rendered.
+	void timelineRequest(const char* _filePath, uint32_t _numFrames);
+
+	/// Release all ring buffers. Trace in progress is discarded, and trace file that is being
+	/// written is finished.
+	void timelineShutdown();
+
+} // namespace bgfx
+
+#endif // BGFX_TIMELINE_H_HEADER_GUARD
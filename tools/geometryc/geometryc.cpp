@@ -54,6 +54,11 @@ namespace stl = tinystl;
 #include <bx/uint32_t.h>
 #include <bx/math.h>
 #include <bx/file.h>
+#include <bx/mutex.h>
+#include <bx/semaphore.h>
+#include <bx/thread.h>
+
+#include <thread>
 
 #include "bounds.h"
 
@@ -151,22 +156,145 @@ struct Mesh
 };
 
 static uint32_t s_obbSteps = 17;
+static uint32_t s_numLods = 0;
+static bool s_meshlets = false;
+static bool s_index32 = false;
 
 #define BGFX_CHUNK_MAGIC_VB  BX_MAKEFOURCC('V', 'B', ' ', 0x1)
 #define BGFX_CHUNK_MAGIC_VBC BX_MAKEFOURCC('V', 'B', 'C', 0x0)
 #define BGFX_CHUNK_MAGIC_IB  BX_MAKEFOURCC('I', 'B', ' ', 0x0)
 #define BGFX_CHUNK_MAGIC_IBC BX_MAKEFOURCC('I', 'B', 'C', 0x1)
 #define BGFX_CHUNK_MAGIC_PRI BX_MAKEFOURCC('P', 'R', 'I', 0x0)
+#define BGFX_CHUNK_MAGIC_VB32  BX_MAKEFOURCC('V', 'B', ' ', 0x2)
+#define BGFX_CHUNK_MAGIC_VBC32 BX_MAKEFOURCC('V', 'B', 'C', 0x1)
+#define BGFX_CHUNK_MAGIC_IB32  BX_MAKEFOURCC('I', 'B', ' ', 0x1)
+#define BGFX_CHUNK_MAGIC_IBC32 BX_MAKEFOURCC('I', 'B', 'C', 0x2)
+#define BGFX_CHUNK_MAGIC_LOD BX_MAKEFOURCC('L', 'O', 'D', 0x0)
+#define BGFX_CHUNK_MAGIC_MSH BX_MAKEFOURCC('M', 'S', 'H', 0x0)
+
+#define BGFX_GEOMETRYC_MAX_LODS             8
+#define BGFX_GEOMETRYC_MESHLET_MAX_VERTICES 64
+#define BGFX_GEOMETRYC_MESHLET_MAX_TRIANGLES 124
+
+struct Stage
+{
+	enum Enum
+	{
+		Tangents,
+		VertexCache,
+		VertexFetch,
+		Bounds,
+		Lods,
+		Meshlets,
+		Compress,
+
+		Count
+	};
+};
+
+static const char* s_stageName[] =
+{
+	"tangents",
+	"tri reorder",
+	"vertex fetch",
+	"bounds",
+	"lods",
+	"meshlets",
+	"compress",
+};
+BX_STATIC_ASSERT(BX_COUNTOF(s_stageName) == Stage::Count);
+
+class BufferWriter : public bx::WriterI
+{
+public:
+	virtual ~BufferWriter()
+	{
+	}
+
+	virtual int32_t write(const void* _data, int32_t _size, bx::Error*) override
+	{
+		const uint8_t* data = (const uint8_t*)_data;
+		m_buffer.insert(m_buffer.end(), data, data+_size);
+		return _size;
+	}
+
+	stl::vector<uint8_t> m_buffer;
+};
+
+// Vertex buffer with all its primitives, processed independently of other batches. Output
+// and log are buffered, and written in batch order to keep output deterministic.
+struct Batch
+{
+	Batch()
+		: m_vertices(NULL)
+		, m_indices(NULL)
+		, m_numVertices(0)
+		, m_numIndices(0)
+		, m_done(false)
+	{
+		bx::memSet(m_elapsed, 0, sizeof(m_elapsed) );
+	}
+
+	~Batch()
+	{
+		delete [] m_vertices;
+		delete [] m_indices;
+	}
+
+	uint8_t*  m_vertices;
+	uint32_t* m_indices;
+	uint32_t  m_numVertices;
+	uint32_t  m_numIndices;
+	stl::string m_material;
+	PrimitiveArray m_primitives;
+
+	BufferWriter m_writer;
+	stl::string m_log;
+	int64_t m_elapsed[Stage::Count];
+	bool m_done;
+};
+
+void batchPrintf(Batch& _batch, const char* _format, ...)
+{
+	char temp[256];
+
+	va_list argList;
+	va_start(argList, _format);
+	int32_t len = bx::vsnprintf(temp, sizeof(temp), _format, argList);
+	va_end(argList);
 
-void optimizeVertexCache(uint16_t* _indices, uint32_t _numIndices, uint32_t _numVertices)
+	len = bx::clamp<int32_t>(len, 0, sizeof(temp)-1);
+	_batch.m_log.append(temp, temp+len);
+}
+
+struct StageScope
+{
+	StageScope(Batch& _batch, Stage::Enum _stage)
+		: m_batch(_batch)
+		, m_stage(_stage)
+		, m_start(bx::getHPCounter() )
+	{
+	}
+
+	~StageScope()
+	{
+		m_batch.m_elapsed[m_stage] += bx::getHPCounter() - m_start;
+	}
+
+	Batch& m_batch;
+	Stage::Enum m_stage;
+	int64_t m_start;
+};
+
+void optimizeVertexCache(uint32_t* _indices, uint32_t _numIndices, uint32_t _numVertices)
 {
-	uint16_t* newIndexList = new uint16_t[_numIndices];
+	uint32_t* newIndexList = new uint32_t[_numIndices];
 	meshopt_optimizeVertexCache(newIndexList, _indices, _numIndices, _numVertices);
-	bx::memCopy(_indices, newIndexList, _numIndices * 2);
+	bx::memCopy(_indices, newIndexList, _numIndices * 4);
 	delete[] newIndexList;
 }
 
-uint32_t optimizeVertexFetch(uint16_t* _indices, uint32_t _numIndices, uint8_t* _vertexData, uint32_t _numVertices, uint16_t _stride)
+uint32_t optimizeVertexFetch(uint32_t* _indices, uint32_t _numIndices, uint8_t* _vertexData, uint32_t _numVertices, uint16_t _stride)
 {
 	unsigned char* newVertices = (unsigned char*)malloc(_numVertices * _stride );
 	size_t vertexCount = meshopt_optimizeVertexFetch(newVertices, _indices, _numIndices, _vertexData, _numVertices, _stride);
@@ -176,39 +304,64 @@ uint32_t optimizeVertexFetch(uint16_t* _indices, uint32_t _numIndices, uint8_t*
 	return uint32_t(vertexCount);
 }
 
-void writeCompressedIndices(bx::WriterI* _writer, const uint16_t* _indices, uint32_t _numIndices, uint32_t _numVertices)
+// Writes indices as 16-bit, or 32-bit when --index32 is used.
+void writeIndices(bx::WriterI* _writer, const uint32_t* _indices, uint32_t _numIndices)
+{
+	if (s_index32)
+	{
+		bx::write(_writer, _indices, _numIndices*4);
+	}
+	else
+	{
+		for (uint32_t ii = 0; ii < _numIndices; ++ii)
+		{
+			bx::write(_writer, uint16_t(_indices[ii]) );
+		}
+	}
+}
+
+void writeCompressedIndices(Batch& _batch, const uint32_t* _indices, uint32_t _numIndices, uint32_t _numVertices)
 {
+	StageScope scope(_batch, Stage::Compress);
+	bx::WriterI* writer = &_batch.m_writer;
+
+	// Encoded index stream doesn't depend on index size, it's selected when decoding.
+	const uint32_t indexSize = s_index32 ? 4 : 2;
+
 	size_t maxSize = meshopt_encodeIndexBufferBound(_numIndices, _numVertices);
 	unsigned char* compressedIndices = (unsigned char*)malloc(maxSize);
 	size_t compressedSize = meshopt_encodeIndexBuffer(compressedIndices, maxSize, _indices, _numIndices);
-	bx::printf( "indices uncompressed: %10d, compressed: %10d, ratio: %0.2f%%\n"
-		, _numIndices*2
+	batchPrintf(_batch, "indices uncompressed: %10d, compressed: %10d, ratio: %0.2f%%\n"
+		, _numIndices*indexSize
 		, (uint32_t)compressedSize
-		, 100.0f - float(compressedSize ) / float(_numIndices*2)*100.0f
+		, 100.0f - float(compressedSize ) / float(_numIndices*indexSize)*100.0f
 		);
 
-	bx::write(_writer, (uint32_t)compressedSize);
-	bx::write(_writer, compressedIndices, (uint32_t)compressedSize );
+	bx::write(writer, (uint32_t)compressedSize);
+	bx::write(writer, compressedIndices, (uint32_t)compressedSize );
 	free(compressedIndices);
 }
 
-void writeCompressedVertices(bx::WriterI* _writer,  const uint8_t* _vertices, uint32_t _numVertices, uint16_t _stride)
+void writeCompressedVertices(Batch& _batch, const uint8_t* _vertices, uint32_t _numVertices, uint16_t _stride)
 {
+	StageScope scope(_batch, Stage::Compress);
+	bx::WriterI* writer = &_batch.m_writer;
+
 	size_t maxSize = meshopt_encodeVertexBufferBound(_numVertices, _stride);
 	unsigned char* compressedVertices = (unsigned char*)malloc(maxSize);
 	size_t compressedSize = meshopt_encodeVertexBuffer(compressedVertices, maxSize, _vertices, _numVertices, _stride);
-	bx::printf("vertices uncompressed: %10d, compressed: %10d, ratio: %0.2f%%\n"
+	batchPrintf(_batch, "vertices uncompressed: %10d, compressed: %10d, ratio: %0.2f%%\n"
 		, _numVertices * _stride
 		, (uint32_t)compressedSize
 		, 100.0f - float(compressedSize) / float(_numVertices * _stride)*100.0f
 		);
 
-	bx::write(_writer, (uint32_t)compressedSize);
-	bx::write(_writer, compressedVertices, (uint32_t)compressedSize );
+	bx::write(writer, (uint32_t)compressedSize);
+	bx::write(writer, compressedVertices, (uint32_t)compressedSize );
 	free(compressedVertices);
 }
 
-void calcTangents(void* _vertices, uint16_t _numVertices, bgfx::VertexLayout _layout, const uint16_t* _indices, uint32_t _numIndices)
+void calcTangents(void* _vertices, uint32_t _numVertices, bgfx::VertexLayout _layout, const uint32_t* _indices, uint32_t _numIndices)
 {
 	struct PosTexcoord
 	{
@@ -231,7 +384,7 @@ void calcTangents(void* _vertices, uint16_t _numVertices, bgfx::VertexLayout _la
 
 	for (uint32_t ii = 0, num = _numIndices/3; ii < num; ++ii)
 	{
-		const uint16_t* indices = &_indices[ii*3];
+		const uint32_t* indices = &_indices[ii*3];
 		uint32_t i0 = indices[0];
 		uint32_t i1 = indices[1];
 		uint32_t i2 = indices[2];
@@ -331,11 +484,202 @@ void write(bx::WriterI* _writer, const void* _vertices, uint32_t _numVertices, u
 	bx::write(_writer, obb);
 }
 
-void write(bx::WriterI* _writer
+// LOD chain is written as separate index lists referencing group vertex buffer. Each LOD
+// is simplified from full resolution index list, and error is smallest simplifier error
+// threshold that reached target index count, converted from relative to mesh extents
+// into object space units. LOD 0 is group index buffer itself and it's not written.
+void writeLods(Batch& _batch
 		, const uint8_t* _vertices
 		, uint32_t _numVertices
 		, const bgfx::VertexLayout& _layout
-		, const uint16_t* _indices
+		, const uint32_t* _indices
+		, uint32_t _numIndices
+		)
+{
+	StageScope scope(_batch, Stage::Lods);
+	bx::WriterI* writer = &_batch.m_writer;
+
+	static const float s_errorSteps[] =
+	{
+		0.0005f, 0.001f, 0.002f, 0.005f, 0.01f, 0.02f, 0.05f, 0.1f, 0.2f, 0.5f, 1.0f,
+	};
+
+	const uint32_t stride = _layout.getStride();
+	const float* positions = (const float*)&_vertices[_layout.getOffset(bgfx::Attrib::Position)];
+
+	Aabb aabb;
+	toAabb(aabb, positions, _numVertices, stride);
+	const bx::Vec3 extents = bx::sub(aabb.max, aabb.min);
+	const float scale = bx::max(extents.x, extents.y, extents.z);
+
+	uint32_t* lodIndices = new uint32_t[_numIndices * (s_numLods + 1)];
+	uint32_t lodNumIndices[BGFX_GEOMETRYC_MAX_LODS];
+	float lodError[BGFX_GEOMETRYC_MAX_LODS];
+
+	uint32_t numLods = 0;
+	uint32_t lastNumIndices = _numIndices;
+	uint32_t offset = 0;
+
+	for (uint32_t lod = 0; lod < s_numLods; ++lod)
+	{
+		const uint32_t target = (_numIndices >> (lod + 1) ) / 3 * 3;
+		if (target < 3)
+		{
+			break;
+		}
+
+		uint32_t* dst = &lodIndices[offset];
+
+		size_t numIndices = 0;
+		float error = 0.0f;
+		for (uint32_t step = 0; step < BX_COUNTOF(s_errorSteps); ++step)
+		{
+			error = s_errorSteps[step];
+			numIndices = meshopt_simplify(
+				  dst
+				, _indices
+				, _numIndices
+				, positions
+				, _numVertices
+				, stride
+				, target
+				, error
+				);
+
+			if (numIndices <= target + target/10)
+			{
+				break;
+			}
+		}
+
+		// Stop chain when simplifier can't remove at least 10% more triangles.
+		if (0 == numIndices
+		||  numIndices > lastNumIndices - lastNumIndices/10)
+		{
+			break;
+		}
+
+		meshopt_optimizeVertexCache(dst, dst, numIndices, _numVertices);
+
+		lodNumIndices[numLods] = uint32_t(numIndices);
+		lodError[numLods]      = error * scale;
+		lastNumIndices = uint32_t(numIndices);
+		offset += uint32_t(numIndices);
+		++numLods;
+	}
+
+	bx::write(writer, BGFX_CHUNK_MAGIC_LOD);
+	bx::write(writer, uint8_t(numLods) );
+
+	offset = 0;
+	for (uint32_t lod = 0; lod < numLods; ++lod)
+	{
+		bx::write(writer, lodError[lod]);
+		bx::write(writer, lodNumIndices[lod]);
+		writeIndices(writer, &lodIndices[offset], lodNumIndices[lod]);
+		offset += lodNumIndices[lod];
+
+		batchPrintf(_batch, "lod %d: indices %10d, error: %f\n"
+			, lod + 1
+			, lodNumIndices[lod]
+			, lodError[lod]
+			);
+	}
+
+	delete [] lodIndices;
+}
+
+// Meshlets are built from optimized group index list. Each meshlet has bounding sphere and
+// normal cone for culling, list of group vertex indices, and list of triangles with meshlet
+// local indices.
+void writeMeshlets(Batch& _batch
+		, const uint8_t* _vertices
+		, uint32_t _numVertices
+		, const bgfx::VertexLayout& _layout
+		, const uint32_t* _indices
+		, uint32_t _numIndices
+		)
+{
+	StageScope scope(_batch, Stage::Meshlets);
+	bx::WriterI* writer = &_batch.m_writer;
+
+	const uint32_t stride = _layout.getStride();
+	const float* positions = (const float*)&_vertices[_layout.getOffset(bgfx::Attrib::Position)];
+
+	size_t maxMeshlets = meshopt_buildMeshletsBound(
+		  _numIndices
+		, BGFX_GEOMETRYC_MESHLET_MAX_VERTICES
+		, BGFX_GEOMETRYC_MESHLET_MAX_TRIANGLES
+		);
+	meshopt_Meshlet* meshlets = (meshopt_Meshlet*)malloc(maxMeshlets * sizeof(meshopt_Meshlet) );
+	uint32_t numMeshlets = uint32_t(meshopt_buildMeshlets(
+		  meshlets
+		, _indices
+		, _numIndices
+		, _numVertices
+		, BGFX_GEOMETRYC_MESHLET_MAX_VERTICES
+		, BGFX_GEOMETRYC_MESHLET_MAX_TRIANGLES
+		) );
+
+	uint32_t numMeshletVertices  = 0;
+	uint32_t numMeshletTriangles = 0;
+
+	bx::write(writer, BGFX_CHUNK_MAGIC_MSH);
+	bx::write(writer, numMeshlets);
+
+	for (uint32_t ii = 0; ii < numMeshlets; ++ii)
+	{
+		const meshopt_Meshlet& meshlet = meshlets[ii];
+		meshopt_Bounds bounds = meshopt_computeMeshletBounds(&meshlet, positions, _numVertices, stride);
+
+		bx::write(writer, bounds.center, sizeof(bounds.center) );
+		bx::write(writer, bounds.radius);
+		bx::write(writer, bounds.cone_apex, sizeof(bounds.cone_apex) );
+		bx::write(writer, bounds.cone_axis, sizeof(bounds.cone_axis) );
+		bx::write(writer, bounds.cone_cutoff);
+		bx::write(writer, numMeshletVertices);
+		bx::write(writer, numMeshletTriangles);
+		bx::write(writer, uint8_t(meshlet.vertex_count) );
+		bx::write(writer, uint8_t(meshlet.triangle_count) );
+
+		numMeshletVertices  += meshlet.vertex_count;
+		numMeshletTriangles += meshlet.triangle_count;
+	}
+
+	bx::write(writer, numMeshletVertices);
+	for (uint32_t ii = 0; ii < numMeshlets; ++ii)
+	{
+		const meshopt_Meshlet& meshlet = meshlets[ii];
+		writeIndices(writer, meshlet.vertices, meshlet.vertex_count);
+	}
+
+	bx::write(writer, numMeshletTriangles);
+	for (uint32_t ii = 0; ii < numMeshlets; ++ii)
+	{
+		const meshopt_Meshlet& meshlet = meshlets[ii];
+		bx::write(writer, meshlet.indices, meshlet.triangle_count*3);
+	}
+
+	batchPrintf(_batch, "meshlets: %10d, vertices: %10d, triangles: %10d\n"
+		, numMeshlets
+		, numMeshletVertices
+		, numMeshletTriangles
+		);
+
+	free(meshlets);
+}
+
+void writeBounds(Batch& _batch, const void* _vertices, uint32_t _numVertices, uint32_t _stride)
+{
+	StageScope scope(_batch, Stage::Bounds);
+	write(&_batch.m_writer, _vertices, _numVertices, _stride);
+}
+
+void write(Batch& _batch
+		, const uint8_t* _vertices
+		, uint32_t _numVertices
+		, const bgfx::VertexLayout& _layout
+		, const uint32_t* _indices
 		, uint32_t _numIndices
 		, bool _compress
 		, const stl::string& _material
@@ -345,61 +689,288 @@ void write(bx::WriterI* _writer
 	using namespace bx;
 	using namespace bgfx;
 
+	bx::WriterI* writer = &_batch.m_writer;
 	uint32_t stride = _layout.getStride();
 
 	if (_compress)
 	{
-		write(_writer, BGFX_CHUNK_MAGIC_VBC);
-		write(_writer, _vertices, _numVertices, stride);
+		write(writer, s_index32 ? BGFX_CHUNK_MAGIC_VBC32 : BGFX_CHUNK_MAGIC_VBC);
+		writeBounds(_batch, _vertices, _numVertices, stride);
 
-		write(_writer, _layout);
+		write(writer, _layout);
 
-		write(_writer, uint16_t(_numVertices) );
-		writeCompressedVertices(_writer, _vertices, _numVertices, uint16_t(stride));
+		if (s_index32)
+		{
+			write(writer, _numVertices);
+		}
+		else
+		{
+			write(writer, uint16_t(_numVertices) );
+		}
+		writeCompressedVertices(_batch, _vertices, _numVertices, uint16_t(stride));
 	}
 	else
 	{
-		write(_writer, BGFX_CHUNK_MAGIC_VB);
-		write(_writer, _vertices, _numVertices, stride);
+		write(writer, s_index32 ? BGFX_CHUNK_MAGIC_VB32 : BGFX_CHUNK_MAGIC_VB);
+		writeBounds(_batch, _vertices, _numVertices, stride);
 
-		write(_writer, _layout);
+		write(writer, _layout);
 
-		write(_writer, uint16_t(_numVertices) );
-		write(_writer, _vertices, _numVertices*stride);
+		if (s_index32)
+		{
+			write(writer, _numVertices);
+		}
+		else
+		{
+			write(writer, uint16_t(_numVertices) );
+		}
+		write(writer, _vertices, _numVertices*stride);
 	}
 
 	if (_compress)
 	{
-		write(_writer, BGFX_CHUNK_MAGIC_IBC);
-		write(_writer, _numIndices);
-		writeCompressedIndices(_writer, _indices, _numIndices, _numVertices);
+		write(writer, s_index32 ? BGFX_CHUNK_MAGIC_IBC32 : BGFX_CHUNK_MAGIC_IBC);
+		write(writer, _numIndices);
+		writeCompressedIndices(_batch, _indices, _numIndices, _numVertices);
 	}
 	else
 	{
-		write(_writer, BGFX_CHUNK_MAGIC_IB);
-		write(_writer, _numIndices);
-		write(_writer, _indices, _numIndices*2);
+		write(writer, s_index32 ? BGFX_CHUNK_MAGIC_IB32 : BGFX_CHUNK_MAGIC_IB);
+		write(writer, _numIndices);
+		writeIndices(writer, _indices, _numIndices);
+	}
+
+	if (0 < s_numLods)
+	{
+		writeLods(_batch, _vertices, _numVertices, _layout, _indices, _numIndices);
+	}
+
+	if (s_meshlets)
+	{
+		writeMeshlets(_batch, _vertices, _numVertices, _layout, _indices, _numIndices);
 	}
 
-	write(_writer, BGFX_CHUNK_MAGIC_PRI);
+	write(writer, BGFX_CHUNK_MAGIC_PRI);
 	uint16_t nameLen = uint16_t(_material.size() );
-	write(_writer, nameLen);
-	write(_writer, _material.c_str(), nameLen);
-	write(_writer, uint16_t(_primitives.size() ) );
+	write(writer, nameLen);
+	write(writer, _material.c_str(), nameLen);
+	write(writer, uint16_t(_primitives.size() ) );
 	for (PrimitiveArray::const_iterator primIt = _primitives.begin(); primIt != _primitives.end(); ++primIt)
 	{
 		const Primitive& prim = *primIt;
 		nameLen = uint16_t(prim.m_name.size() );
-		write(_writer, nameLen);
-		write(_writer, prim.m_name.c_str(), nameLen);
-		write(_writer, prim.m_startIndex);
-		write(_writer, prim.m_numIndices);
-		write(_writer, prim.m_startVertex);
-		write(_writer, prim.m_numVertices);
-		write(_writer, &_vertices[prim.m_startVertex*stride], prim.m_numVertices, stride);
+		write(writer, nameLen);
+		write(writer, prim.m_name.c_str(), nameLen);
+		write(writer, prim.m_startIndex);
+		write(writer, prim.m_numIndices);
+		write(writer, prim.m_startVertex);
+		write(writer, prim.m_numVertices);
+		writeBounds(_batch, &_vertices[prim.m_startVertex*stride], prim.m_numVertices, stride);
+	}
+}
+
+void process(Batch& _batch, const bgfx::VertexLayout& _layout, bool _hasTangent, bool _compress)
+{
+	if (_hasTangent)
+	{
+		StageScope scope(_batch, Stage::Tangents);
+		calcTangents(_batch.m_vertices, _batch.m_numVertices, _layout, _batch.m_indices, _batch.m_numIndices);
+	}
+
+	{
+		StageScope scope(_batch, Stage::VertexCache);
+		for (PrimitiveArray::const_iterator primIt = _batch.m_primitives.begin(); primIt != _batch.m_primitives.end(); ++primIt)
+		{
+			const Primitive& prim = *primIt;
+			optimizeVertexCache(_batch.m_indices + prim.m_startIndex, prim.m_numIndices, _batch.m_numVertices);
+		}
+	}
+
+	{
+		StageScope scope(_batch, Stage::VertexFetch);
+		_batch.m_numVertices = optimizeVertexFetch(
+			  _batch.m_indices
+			, _batch.m_numIndices
+			, _batch.m_vertices
+			, _batch.m_numVertices
+			, _layout.getStride()
+			);
+	}
+
+	if (0 < _batch.m_numVertices
+	&&  0 < _batch.m_numIndices)
+	{
+		write(_batch
+			, _batch.m_vertices
+			, _batch.m_numVertices
+			, _layout
+			, _batch.m_indices
+			, _batch.m_numIndices
+			, _compress
+			, _batch.m_material
+			, _batch.m_primitives
+			);
 	}
 }
 
+// Processes batches on worker threads. Batches are returned by pop in the same order they
+// were pushed, regardless of order in which they were processed.
+class BatchProcessor
+{
+public:
+	BatchProcessor(const bgfx::VertexLayout& _layout, bool _hasTangent, bool _compress, uint32_t _numThreads)
+		: m_layout(_layout)
+		, m_thread(NULL)
+		, m_numThreads(_numThreads > 1 ? _numThreads : 0)
+		, m_next(0)
+		, m_front(0)
+		, m_hasTangent(_hasTangent)
+		, m_compress(_compress)
+		, m_exit(false)
+	{
+		if (0 < m_numThreads)
+		{
+			m_thread = new bx::Thread[m_numThreads];
+			for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+			{
+				m_thread[ii].init(threadFunc, this, 0, "geometryc");
+			}
+		}
+	}
+
+	~BatchProcessor()
+	{
+		{
+			bx::MutexScope scope(m_mutex);
+			m_exit = true;
+		}
+
+		m_work.post();
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_thread[ii].shutdown();
+		}
+
+		delete [] m_thread;
+	}
+
+	void push(Batch* _batch)
+	{
+		if (0 == m_numThreads)
+		{
+			process(*_batch, m_layout, m_hasTangent, m_compress);
+			_batch->m_done = true;
+			m_batches.push_back(_batch);
+			return;
+		}
+
+		{
+			bx::MutexScope scope(m_mutex);
+			m_batches.push_back(_batch);
+		}
+
+		m_work.post();
+	}
+
+	// Returns next batch in push order, or NULL when there are no more batches. When _wait
+	// is false, NULL is returned also when next batch is not processed yet.
+	Batch* pop(bool _wait)
+	{
+		for (;;)
+		{
+			{
+				bx::MutexScope scope(m_mutex);
+
+				if (m_front == m_batches.size() )
+				{
+					return NULL;
+				}
+
+				Batch* batch = m_batches[m_front];
+				if (batch->m_done)
+				{
+					m_batches[m_front] = NULL;
+					++m_front;
+					return batch;
+				}
+			}
+
+			if (!_wait)
+			{
+				return NULL;
+			}
+
+			m_done.wait();
+		}
+	}
+
+	uint32_t getNumInFlight()
+	{
+		bx::MutexScope scope(m_mutex);
+		return uint32_t(m_batches.size() ) - m_front;
+	}
+
+private:
+	static int32_t threadFunc(bx::Thread* /*_thread*/, void* _userData)
+	{
+		BatchProcessor* processor = (BatchProcessor*)_userData;
+		return processor->worker();
+	}
+
+	int32_t worker()
+	{
+		for (;;)
+		{
+			m_work.wait();
+
+			Batch* batch = NULL;
+
+			{
+				bx::MutexScope scope(m_mutex);
+
+				if (m_next < m_batches.size() )
+				{
+					batch = m_batches[m_next];
+					++m_next;
+				}
+				else if (m_exit)
+				{
+					// Wake next worker, it will exit too.
+					m_work.post();
+					return 0;
+				}
+			}
+
+			if (NULL != batch)
+			{
+				process(*batch, m_layout, m_hasTangent, m_compress);
+
+				{
+					bx::MutexScope scope(m_mutex);
+					batch->m_done = true;
+				}
+
+				m_done.post();
+			}
+		}
+	}
+
+	bgfx::VertexLayout m_layout;
+	bx::Thread*   m_thread;
+	bx::Mutex     m_mutex;
+	bx::Semaphore m_work;
+	bx::Semaphore m_done;
+
+	stl::vector<Batch*> m_batches;
+	uint32_t m_numThreads;
+	uint32_t m_next;
+	uint32_t m_front;
+	bool m_hasTangent;
+	bool m_compress;
+	bool m_exit;
+};
+
 inline uint32_t rgbaToAbgr(uint8_t _r, uint8_t _g, uint8_t _b, uint8_t _a)
 {
 	return (uint32_t(_r)<<0)
@@ -934,6 +1505,10 @@ void help(const char* _error = NULL)
 		  "      --tangent            Calculate tangent vectors (packing mode is the same as normal).\n"
 		  "      --barycentric        Adds barycentric vertex attribute (packed in bgfx::Attrib::Color1).\n"
 		  "  -c, --compress           Compress indices.\n"
+		  "      --lods <num>         Number of LODs to generate, each with half of triangles of previous (max 8).\n"
+		  "      --meshlets           Build meshlets with culling bounds and normal cones.\n"
+		  "      --index32            Use 32-bit indices, one vertex and index buffer per material.\n"
+		  "  -j, --jobs <num>         Number of worker threads. Default value is number of CPU cores.\n"
 		  "      --[l/r]h-up+[y/z]	  Coordinate system. Default is '--lh-up+y' Left-Handed +Y is up.\n"
 
 		  "\n"
@@ -941,6 +1516,24 @@ void help(const char* _error = NULL)
 		);
 }
 
+void writeBatch(bx::WriterI* _writer, const Batch& _batch, int64_t* _stageElapsed, int32_t& _numVertices, int32_t& _numIndices)
+{
+	bx::printf("%s", _batch.m_log.c_str() );
+
+	if (!_batch.m_writer.m_buffer.empty() )
+	{
+		bx::write(_writer, &_batch.m_writer.m_buffer[0], int32_t(_batch.m_writer.m_buffer.size() ) );
+	}
+
+	for (uint32_t stage = 0; stage < Stage::Count; ++stage)
+	{
+		_stageElapsed[stage] += _batch.m_elapsed[stage];
+	}
+
+	_numVertices += _batch.m_numVertices;
+	_numIndices  += _batch.m_numIndices;
+}
+
 int main(int _argc, const char* _argv[])
 {
 	bx::CommandLine cmdLine(_argc, _argv);
@@ -991,6 +1584,16 @@ int main(int _argc, const char* _argv[])
 	cmdLine.hasArg(s_obbSteps, '\0', "obb");
 	s_obbSteps = bx::uint32_min(bx::uint32_max(s_obbSteps, 1), 90);
 
+	cmdLine.hasArg(s_numLods, '\0', "lods");
+	s_numLods = bx::uint32_min(s_numLods, BGFX_GEOMETRYC_MAX_LODS);
+
+	s_meshlets = cmdLine.hasArg("meshlets");
+	s_index32  = cmdLine.hasArg("index32");
+
+	uint32_t numJobs = std::thread::hardware_concurrency();
+	cmdLine.hasArg(numJobs, 'j', "jobs");
+	numJobs = bx::uint32_min(bx::uint32_max(numJobs, 1), 64);
+
 	uint32_t packNormal = 0;
 	cmdLine.hasArg(packNormal, '\0', "packnormal");
 
@@ -1022,7 +1625,8 @@ int main(int _argc, const char* _argv[])
 	}
 
 	int64_t parseElapsed = -bx::getHPCounter();
-	int64_t triReorderElapsed = 0;
+	int64_t writeElapsed = 0;
+	int64_t stageElapsed[Stage::Count] = {};
 
 	uint32_t size = (uint32_t)bx::getSize(&fr);
 	char* data = new char[size+1];
@@ -1189,7 +1793,7 @@ int main(int _argc, const char* _argv[])
 
 	uint32_t stride = layout.getStride();
 	uint8_t* vertexData = new uint8_t[mesh.m_triangles.size() * 3 * stride];
-	uint16_t* indexData = new uint16_t[mesh.m_triangles.size() * 3];
+	uint32_t* indexData = new uint32_t[mesh.m_triangles.size() * 3];
 	int32_t numVertices = 0;
 	int32_t numIndices = 0;
 
@@ -1198,9 +1802,13 @@ int main(int _argc, const char* _argv[])
 	int32_t writtenIndices = 0;
 
 	uint8_t* vertices = vertexData;
-	uint16_t* indices = indexData;
+	uint32_t* indices = indexData;
 
-	const uint32_t tableSize = 65536 * 2;
+	// Vertex deduplication table must be able to hold all vertices of single vertex buffer.
+	const uint32_t tableSize = s_index32
+		? bx::uint32_max(65536 * 2, bx::uint32_nextpow2(uint32_t(mesh.m_triangles.size() * 3) * 2) )
+		: 65536 * 2
+		;
 	const uint32_t hashmod = tableSize - 1;
 	uint32_t* table = new uint32_t[tableSize];
 	bx::memSet(table, 0xff, tableSize * sizeof(uint32_t));
@@ -1223,6 +1831,9 @@ int main(int _argc, const char* _argv[])
 	uint32_t positionOffset = layout.getOffset(bgfx::Attrib::Position);
 	uint32_t color0Offset   = layout.getOffset(bgfx::Attrib::Color0);
 
+	BatchProcessor processor(layout, hasTangent, compress, numJobs);
+	const uint32_t maxInFlight = numJobs*2;
+
 	Group sentinelGroup;
 	sentinelGroup.m_startTriangle = 0;
 	sentinelGroup.m_numTriangles = UINT32_MAX;
@@ -1236,7 +1847,7 @@ int main(int _argc, const char* _argv[])
 		{
 			if (0 != bx::strCmp(material.c_str(), groupIt->m_material.c_str() )
 			|| sentinel
-			||  65533 <= numVertices)
+			|| (!s_index32 && 65533 <= numVertices) )
 			{
 				prim.m_numVertices = numVertices - prim.m_startVertex;
 				prim.m_numIndices  = numIndices  - prim.m_startIndex;
@@ -1245,41 +1856,41 @@ int main(int _argc, const char* _argv[])
 					primitives.push_back(prim);
 				}
 
-				if (hasTangent)
+				if (0 < numIndices)
 				{
-					calcTangents(vertexData, uint16_t(numVertices), layout, indexData, numIndices);
+					Batch* batch = new Batch;
+					batch->m_numVertices = numVertices;
+					batch->m_numIndices  = numIndices;
+					batch->m_vertices    = new uint8_t[numVertices*stride];
+					batch->m_indices     = new uint32_t[numIndices];
+					bx::memCopy(batch->m_vertices, vertexData, numVertices*stride);
+					bx::memCopy(batch->m_indices, indexData, numIndices*sizeof(uint32_t) );
+					batch->m_material   = material;
+					batch->m_primitives = primitives;
+					processor.push(batch);
 				}
+				primitives.clear();
 
-				triReorderElapsed -= bx::getHPCounter();
-				for (PrimitiveArray::const_iterator primIt = primitives.begin(); primIt != primitives.end(); ++primIt)
+				// Write processed batches in order, and limit number of batches held in memory.
+				for (bool wait = processor.getNumInFlight() > maxInFlight;;)
 				{
-					const Primitive& prim1 = *primIt;
-					optimizeVertexCache(indexData + prim1.m_startIndex, prim1.m_numIndices, numVertices);
-				}
-				numVertices = optimizeVertexFetch(indexData, numIndices, vertexData, numVertices, uint16_t(stride));
+					Batch* batch = processor.pop(wait);
+					if (NULL == batch)
+					{
+						break;
+					}
 
-				triReorderElapsed += bx::getHPCounter();
+					writeElapsed -= bx::getHPCounter();
+					writeBatch(&writer, *batch, stageElapsed, writtenVertices, writtenIndices);
+					writeElapsed += bx::getHPCounter();
+					delete batch;
 
-				if ( numVertices > 0 && numIndices > 0 )
-				{
-					write(&writer
-						  , vertexData
-						  , numVertices
-						  , layout
-						  , indexData
-						  , numIndices
-						  , compress
-						  , material
-						  , primitives
-						  );
+					wait = processor.getNumInFlight() > maxInFlight;
 				}
-				primitives.clear();
 
 				bx::memSet(table, 0xff, tableSize * sizeof(uint32_t));
 
 				++writtenPrimitives;
-				writtenVertices += numVertices;
-				writtenIndices += numIndices;
 
 				vertices = vertexData;
 				indices  = indexData;
@@ -1372,7 +1983,7 @@ int main(int _argc, const char* _argv[])
 					exit(bx::kExitFailure);
 				}
 
-				*indices++ = (uint16_t)vertexIndex;
+				*indices++ = vertexIndex;
 				++numIndices;
 			}
 		}
@@ -1395,6 +2006,14 @@ int main(int _argc, const char* _argv[])
 			);
 	}
 
+	for (Batch* batch = processor.pop(true); NULL != batch; batch = processor.pop(true) )
+	{
+		writeElapsed -= bx::getHPCounter();
+		writeBatch(&writer, *batch, stageElapsed, writtenVertices, writtenIndices);
+		writeElapsed += bx::getHPCounter();
+		delete batch;
+	}
+
 	BX_ASSERT(0 == primitives.size(), "Not all primitives are written");
 
 	bx::printf("size: %d\n", uint32_t(bx::seek(&writer) ) );
@@ -1407,10 +2026,17 @@ int main(int _argc, const char* _argv[])
 	now = bx::getHPCounter();
 	convertElapsed += now;
 
-	bx::printf("parse %f [s]\ntri reorder %f [s]\nconvert %f [s]\ng %d, p %d, v %d, i %d\n"
-		, double(parseElapsed)/bx::getHPFrequency()
-		, double(triReorderElapsed)/bx::getHPFrequency()
+	bx::printf("parse %f [s]\n", double(parseElapsed)/bx::getHPFrequency() );
+
+	for (uint32_t stage = 0; stage < Stage::Count; ++stage)
+	{
+		bx::printf("%s %f [s]\n", s_stageName[stage], double(stageElapsed[stage])/bx::getHPFrequency() );
+	}
+
+	bx::printf("write %f [s]\nconvert %f [s] (%d jobs)\ng %d, p %d, v %d, i %d\n"
+		, double(writeElapsed)/bx::getHPFrequency()
 		, double(convertElapsed)/bx::getHPFrequency()
+		, numJobs
 		, uint32_t(mesh.m_groups.size()-1)
 		, writtenPrimitives
 		, writtenVertices
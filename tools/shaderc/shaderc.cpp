@@ -18,9 +18,6 @@ extern "C"
 #define BGFX_CHUNK_MAGIC_FSH BX_MAKEFOURCC('F', 'S', 'H', BGFX_SHADER_BIN_VERSION)
 #define BGFX_CHUNK_MAGIC_VSH BX_MAKEFOURCC('V', 'S', 'H', BGFX_SHADER_BIN_VERSION)
 
-#define BGFX_SHADERC_VERSION_MAJOR 1
-#define BGFX_SHADERC_VERSION_MINOR 16
-
 namespace bgfx
 {
 	bool g_verbose = false;
@@ -902,6 +899,18 @@ namespace bgfx
 			  "      --varyingdef <file path>  Path to varying.def.sc file.\n"
 			  "      --verbose                 Verbose.\n"
 
+			  "\n"
+			  "Batch mode:\n"
+			  "      --batch <file path>       Compile all shaders listed in manifest file. Each line contains options\n"
+			  "                                for one shader, lines starting with # are ignored.\n"
+			  "  -j, --jobs <num>              Number of shaders compiled in parallel (default number of CPU cores).\n"
+			  "      --cache <dir>             Compiled shader cache directory (default .shaderc-cache).\n"
+
+			  "\n"
+			  "Pack mode:\n"
+			  "      --pack <file path>        Write compiled shaders listed in manifest file into shader pack -o <file path>.\n"
+			  "                                Each line contains permutation name and compiled shader file path.\n"
+
 			  "\n"
 			  "Options (DX9 and DX11 only):\n"
 
@@ -2334,6 +2343,16 @@ namespace bgfx
 			return bx::kExitFailure;
 		}
 
+		if (cmdLine.hasArg("batch") )
+		{
+			return compileShaderBatch(_argc, _argv);
+		}
+
+		if (cmdLine.hasArg("pack") )
+		{
+			return compileShaderPack(_argc, _argv);
+		}
+
 		g_verbose = cmdLine.hasArg("verbose");
 
 		const char* filePath = cmdLine.findOption('f');
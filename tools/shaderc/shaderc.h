@@ -6,6 +6,11 @@
 #ifndef SHADERC_H_HEADER_GUARD
 #define SHADERC_H_HEADER_GUARD
 
+#define BGFX_SHADERC_VERSION_MAJOR 1
+#define BGFX_SHADERC_VERSION_MINOR 16
+
+#define BGFX_CHUNK_MAGIC_SPK BX_MAKEFOURCC('S', 'P', 'K', 0x0)
+
 namespace bgfx
 {
 	extern bool g_verbose;
@@ -154,6 +159,9 @@ namespace bgfx
 
 	const char* getPsslPreamble();
 
+	int compileShaderBatch(int _argc, const char* _argv[]);
+	int compileShaderPack(int _argc, const char* _argv[]);
+
 } // namespace bgfx
 
 #endif // SHADERC_H_HEADER_GUARD
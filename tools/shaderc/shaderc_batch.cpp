@@ -0,0 +1,416 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "shaderc.h"
+#include <bx/filepath.h>
+#include <bx/mutex.h>
+#include <bx/process.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
+
+#include <stdio.h>
+#include <algorithm>
+#include <thread>
+
+namespace bgfx
+{
+	// Batch mode runs every manifest job as separate shaderc process. Preprocessor and
+	// some of shader compilers keep global state, and they can't be used from multiple
+	// threads inside one process.
+	//
+	// Cache key is hash of preprocessed source, all options that affect output, and
+	// shaderc version. Preprocessed source already includes defines, varying.def.sc, and
+	// all included files, so changes in any of them produce different key.
+
+	struct BatchJob
+	{
+		std::vector<std::string> args;
+		std::string outputFilePath;
+		std::string log;
+		uint32_t line;
+		bool cached;
+		bool compiled;
+	};
+
+	struct BatchContext
+	{
+		std::string exePath;
+		std::string cacheDir;
+		std::vector<BatchJob> jobs;
+		bx::Mutex mutex;
+		uint32_t next;
+		uint32_t numCached;
+		uint32_t numCompiled;
+		uint32_t numFailed;
+	};
+
+	static bool isPathOption(const std::string& _arg)
+	{
+		return _arg == "-f"
+			|| _arg == "-o"
+			|| _arg == "-i"
+			|| _arg == "--varyingdef"
+			;
+	}
+
+	static bool hasArg(const std::vector<std::string>& _args, const char* _arg)
+	{
+		return _args.end() != std::find(_args.begin(), _args.end(), _arg);
+	}
+
+	static std::string quote(const std::string& _arg)
+	{
+		return "\"" + _arg + "\"";
+	}
+
+	static bool runProcess(const std::string& _exePath, const std::vector<std::string>& _args, std::string& _log)
+	{
+		std::string args;
+		for (size_t ii = 0; ii < _args.size(); ++ii)
+		{
+			args += ii == 0 ? "" : " ";
+			args += quote(_args[ii]);
+		}
+
+		bx::Error err;
+		bx::ProcessReader reader;
+		if (!bx::open(&reader, _exePath.c_str(), args.c_str(), &err) )
+		{
+			_log += "Unable to run '" + _exePath + "'.\n";
+			return false;
+		}
+
+		char temp[1024];
+		for (;;)
+		{
+			int32_t size = bx::read(&reader, temp, sizeof(temp), &err);
+			_log.append(temp, size);
+
+			if (!err.isOk() )
+			{
+				break;
+			}
+		}
+
+		bx::close(&reader);
+
+		return 0 == reader.getExitCode();
+	}
+
+	static bool readFile(const std::string& _filePath, std::string& _data)
+	{
+		bx::FileReader reader;
+		if (!bx::open(&reader, _filePath.c_str() ) )
+		{
+			return false;
+		}
+
+		const uint32_t size = uint32_t(bx::getSize(&reader) );
+		_data.resize(size);
+		if (0 < size)
+		{
+			bx::read(&reader, &_data[0], size);
+		}
+		bx::close(&reader);
+
+		return true;
+	}
+
+	static bool copyFile(const std::string& _dstPath, const std::string& _srcPath)
+	{
+		std::string data;
+		if (!readFile(_srcPath, data) )
+		{
+			return false;
+		}
+
+		bx::FileWriter writer;
+		if (!bx::open(&writer, _dstPath.c_str() ) )
+		{
+			return false;
+		}
+
+		bx::Error err;
+		bx::write(&writer, data.c_str(), int32_t(data.size() ), &err);
+		bx::close(&writer);
+
+		return err.isOk();
+	}
+
+	// Copy into cache through temporary file, so that other processes using the same cache
+	// never see partially written entry.
+	static void storeFile(const std::string& _cachePath, const std::string& _srcPath, const std::string& _tmpPath)
+	{
+		if (copyFile(_tmpPath, _srcPath) )
+		{
+			bx::remove(_cachePath.c_str() );
+			if (0 != ::rename(_tmpPath.c_str(), _cachePath.c_str() ) )
+			{
+				bx::remove(_tmpPath.c_str() );
+			}
+		}
+	}
+
+	static void processJob(BatchContext& _ctx, uint32_t _index)
+	{
+		BatchJob& job = _ctx.jobs[_index];
+
+		char tmpName[64];
+		bx::snprintf(tmpName, sizeof(tmpName), "tmp-%d-%" PRIx64, _index, bx::getHPCounter() );
+		const std::string tmpPath = _ctx.cacheDir + "/" + tmpName;
+
+		// Preprocess only into temporary file.
+		std::vector<std::string> args;
+		for (size_t ii = 0; ii < job.args.size(); ++ii)
+		{
+			const std::string& arg = job.args[ii];
+
+			if (arg == "-o")
+			{
+				++ii;
+			}
+			else if (arg == "--bin2c")
+			{
+				if (ii+1 < job.args.size()
+				&&  '-' != job.args[ii+1][0])
+				{
+					++ii;
+				}
+			}
+			else if (arg != "--depends")
+			{
+				args.push_back(arg);
+			}
+		}
+
+		args.push_back("--preprocess");
+		args.push_back("-o");
+		args.push_back(tmpPath);
+
+		std::string preprocessed;
+		if (!runProcess(_ctx.exePath, args, job.log)
+		||  !readFile(tmpPath, preprocessed) )
+		{
+			bx::remove(tmpPath.c_str() );
+			return;
+		}
+
+		bx::remove(tmpPath.c_str() );
+
+		// Output path affects output only when bin2c array name is derived from it, or when
+		// depends file is generated.
+		const bool keepOutputPath = hasArg(job.args, "--bin2c") || hasArg(job.args, "--depends");
+
+		bx::HashMurmur2A murmur;
+		bx::HashCrc32 crc;
+		murmur.begin();
+		crc.begin();
+
+		const uint32_t version[] = { BGFX_SHADERC_VERSION_MAJOR, BGFX_SHADERC_VERSION_MINOR, BGFX_API_VERSION };
+		murmur.add(version, sizeof(version) );
+		crc.add(version, sizeof(version) );
+
+		for (size_t ii = 0; ii < job.args.size(); ++ii)
+		{
+			const std::string& arg = job.args[ii];
+
+			if (isPathOption(arg)
+			&&  !(keepOutputPath && arg == "-o") )
+			{
+				++ii;
+				continue;
+			}
+
+			murmur.add(arg.c_str(), uint32_t(arg.size()+1) );
+			crc.add(arg.c_str(), uint32_t(arg.size()+1) );
+		}
+
+		murmur.add(preprocessed.c_str(), uint32_t(preprocessed.size() ) );
+		crc.add(preprocessed.c_str(), uint32_t(preprocessed.size() ) );
+
+		char key[32];
+		bx::snprintf(key, sizeof(key), "%08x%08x", murmur.end(), crc.end() );
+
+		const std::string cachePath  = _ctx.cacheDir + "/" + key + ".bin";
+		const std::string dependPath = cachePath + ".d";
+		const bool depends = hasArg(job.args, "--depends");
+
+		if (copyFile(job.outputFilePath, cachePath)
+		&& (!depends || copyFile(job.outputFilePath + ".d", dependPath) ) )
+		{
+			job.cached   = true;
+			job.compiled = true;
+			return;
+		}
+
+		if (!runProcess(_ctx.exePath, job.args, job.log) )
+		{
+			return;
+		}
+
+		job.compiled = true;
+
+		storeFile(cachePath, job.outputFilePath, tmpPath);
+
+		if (depends)
+		{
+			storeFile(dependPath, job.outputFilePath + ".d", tmpPath);
+		}
+	}
+
+	static int32_t batchThread(bx::Thread* /*_thread*/, void* _userData)
+	{
+		BatchContext& ctx = *(BatchContext*)_userData;
+
+		for (;;)
+		{
+			uint32_t index;
+
+			{
+				bx::MutexScope scope(ctx.mutex);
+				if (ctx.next == ctx.jobs.size() )
+				{
+					return 0;
+				}
+
+				index = ctx.next++;
+			}
+
+			processJob(ctx, index);
+
+			const BatchJob& job = ctx.jobs[index];
+
+			bx::MutexScope scope(ctx.mutex);
+
+			ctx.numCached   += job.cached;
+			ctx.numCompiled += job.compiled && !job.cached;
+			ctx.numFailed   += !job.compiled;
+
+			bx::printf("[%d/%d] %s %s\n"
+				, index+1
+				, uint32_t(ctx.jobs.size() )
+				, job.cached ? "cached" : job.compiled ? "compiled" : "FAILED"
+				, job.outputFilePath.c_str()
+				);
+
+			if (!job.compiled
+			||  g_verbose)
+			{
+				bx::printf("%s", job.log.c_str() );
+			}
+		}
+	}
+
+	int compileShaderBatch(int _argc, const char* _argv[])
+	{
+		bx::CommandLine cmdLine(_argc, _argv);
+
+		g_verbose = cmdLine.hasArg("verbose");
+
+		const char* manifestPath = cmdLine.findOption("batch");
+		if (NULL == manifestPath)
+		{
+			bx::printf("Manifest file must be specified.\n");
+			return bx::kExitFailure;
+		}
+
+		std::string manifest;
+		if (!readFile(manifestPath, manifest) )
+		{
+			bx::printf("Unable to open manifest file '%s'.\n", manifestPath);
+			return bx::kExitFailure;
+		}
+
+		BatchContext ctx;
+		ctx.exePath     = _argv[0];
+		ctx.cacheDir    = cmdLine.findOption("cache", ".shaderc-cache");
+		ctx.next        = 0;
+		ctx.numCached   = 0;
+		ctx.numCompiled = 0;
+		ctx.numFailed   = 0;
+
+		if (!bx::makeAll(ctx.cacheDir.c_str() ) )
+		{
+			bx::printf("Unable to create cache directory '%s'.\n", ctx.cacheDir.c_str() );
+			return bx::kExitFailure;
+		}
+
+		char commandLine[4096];
+		int32_t argc;
+		char* argv[128];
+
+		uint32_t line = 0;
+		for (bx::StringView next(manifest.c_str(), uint32_t(manifest.size() ) ); !next.isEmpty(); )
+		{
+			uint32_t len = sizeof(commandLine);
+			next = bx::tokenizeCommandLine(next, commandLine, len, argc, argv, BX_COUNTOF(argv), '\n');
+			++line;
+
+			if (0 == argc
+			||  '#' == argv[0][0])
+			{
+				continue;
+			}
+
+			BatchJob job;
+			job.line     = line;
+			job.cached   = false;
+			job.compiled = false;
+
+			for (int32_t ii = 0; ii < argc; ++ii)
+			{
+				job.args.push_back(argv[ii]);
+
+				if (0 == bx::strCmp(argv[ii], "-o")
+				&&  ii+1 < argc)
+				{
+					job.outputFilePath = argv[ii+1];
+				}
+			}
+
+			if (job.outputFilePath.empty() )
+			{
+				bx::printf("%s(%d): Output file name must be specified.\n", manifestPath, line);
+				return bx::kExitFailure;
+			}
+
+			ctx.jobs.push_back(job);
+		}
+
+		uint32_t numThreads = std::thread::hardware_concurrency();
+		cmdLine.hasArg(numThreads, 'j', "jobs");
+		numThreads = bx::uint32_min(bx::uint32_max(numThreads, 1), 64);
+		numThreads = bx::uint32_min(numThreads, bx::uint32_max(uint32_t(ctx.jobs.size() ), 1) );
+
+		const int64_t start = bx::getHPCounter();
+
+		bx::Thread* threads = new bx::Thread[numThreads];
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			threads[ii].init(batchThread, &ctx, 0, "shaderc");
+		}
+
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			threads[ii].shutdown();
+		}
+
+		delete [] threads;
+
+		const double elapsed = double(bx::getHPCounter() - start)/double(bx::getHPFrequency() );
+
+		bx::printf("%d jobs, %d cached, %d compiled, %d failed, %d threads, %f [s]\n"
+			, uint32_t(ctx.jobs.size() )
+			, ctx.numCached
+			, ctx.numCompiled
+			, ctx.numFailed
+			, numThreads
+			, elapsed
+			);
+
+		return 0 == ctx.numFailed ? bx::kExitSuccess : bx::kExitFailure;
+	}
+
+} // namespace bgfx
@@ -0,0 +1,225 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "shaderc.h"
+
+namespace bgfx
+{
+	// Shader pack file layout:
+	//
+	//   u32 magic          - BGFX_CHUNK_MAGIC_SPK.
+	//   u32 numEntries
+	//   u32 numBlobs
+	//   Entry[numEntries]  - u32 key, u32 blob index. Sorted by key.
+	//   Blob[numBlobs]     - u32 offset, u32 size. Offset from start of file.
+	//   Blob data          - Compiled shaders, each aligned to 16 bytes.
+	//
+	// Key is MurmurHash2A of permutation name. Permutations with identical bytecode share
+	// the same blob.
+
+	struct PackEntry
+	{
+		uint32_t key;
+		uint32_t blob;
+		std::string name;
+
+		bool operator<(const PackEntry& _rhs) const
+		{
+			return key < _rhs.key;
+		}
+	};
+
+	struct PackBlob
+	{
+		uint32_t hash;
+		uint32_t offset;
+		std::string data;
+	};
+
+	static bool readPackFile(const char* _filePath, std::string& _data)
+	{
+		bx::FileReader reader;
+		if (!bx::open(&reader, _filePath) )
+		{
+			return false;
+		}
+
+		const uint32_t size = uint32_t(bx::getSize(&reader) );
+		_data.resize(size);
+		if (0 < size)
+		{
+			bx::read(&reader, &_data[0], size);
+		}
+		bx::close(&reader);
+
+		return true;
+	}
+
+	int compileShaderPack(int _argc, const char* _argv[])
+	{
+		bx::CommandLine cmdLine(_argc, _argv);
+
+		const char* manifestPath = cmdLine.findOption("pack");
+		if (NULL == manifestPath)
+		{
+			bx::printf("Manifest file must be specified.\n");
+			return bx::kExitFailure;
+		}
+
+		const char* outFilePath = cmdLine.findOption('o');
+		if (NULL == outFilePath)
+		{
+			bx::printf("Output file name must be specified.\n");
+			return bx::kExitFailure;
+		}
+
+		std::string manifest;
+		if (!readPackFile(manifestPath, manifest) )
+		{
+			bx::printf("Unable to open manifest file '%s'.\n", manifestPath);
+			return bx::kExitFailure;
+		}
+
+		std::vector<PackEntry> entries;
+		std::vector<PackBlob> blobs;
+		std::unordered_map<uint32_t, std::vector<uint32_t> > blobMap;
+
+		char commandLine[4096];
+		int32_t argc;
+		char* argv[16];
+
+		uint32_t line = 0;
+		for (bx::StringView next(manifest.c_str(), uint32_t(manifest.size() ) ); !next.isEmpty(); )
+		{
+			uint32_t len = sizeof(commandLine);
+			next = bx::tokenizeCommandLine(next, commandLine, len, argc, argv, BX_COUNTOF(argv), '\n');
+			++line;
+
+			if (0 == argc
+			||  '#' == argv[0][0])
+			{
+				continue;
+			}
+
+			if (2 != argc)
+			{
+				bx::printf("%s(%d): Expected '<permutation name> <shader file path>'.\n", manifestPath, line);
+				return bx::kExitFailure;
+			}
+
+			PackBlob blob;
+			if (!readPackFile(argv[1], blob.data) )
+			{
+				bx::printf("%s(%d): Unable to open shader file '%s'.\n", manifestPath, line, argv[1]);
+				return bx::kExitFailure;
+			}
+
+			blob.hash   = bx::hash<bx::HashMurmur2A>(blob.data.c_str(), uint32_t(blob.data.size() ) );
+			blob.offset = 0;
+
+			PackEntry entry;
+			entry.key  = bx::hash<bx::HashMurmur2A>(argv[0]);
+			entry.blob = UINT32_MAX;
+			entry.name = argv[0];
+
+			std::vector<uint32_t>& candidates = blobMap[blob.hash];
+			for (uint32_t ii = 0, num = uint32_t(candidates.size() ); ii < num; ++ii)
+			{
+				if (blobs[candidates[ii] ].data == blob.data)
+				{
+					entry.blob = candidates[ii];
+					break;
+				}
+			}
+
+			if (UINT32_MAX == entry.blob)
+			{
+				entry.blob = uint32_t(blobs.size() );
+				candidates.push_back(entry.blob);
+				blobs.push_back(blob);
+			}
+
+			entries.push_back(entry);
+		}
+
+		std::stable_sort(entries.begin(), entries.end() );
+
+		for (uint32_t ii = 1, num = uint32_t(entries.size() ); ii < num; ++ii)
+		{
+			if (entries[ii-1].key == entries[ii].key)
+			{
+				bx::printf("Permutation names '%s' and '%s' have the same key 0x%08x.\n"
+					, entries[ii-1].name.c_str()
+					, entries[ii].name.c_str()
+					, entries[ii].key
+					);
+				return bx::kExitFailure;
+			}
+		}
+
+		const uint32_t numEntries = uint32_t(entries.size() );
+		const uint32_t numBlobs   = uint32_t(blobs.size() );
+
+		uint32_t offset = sizeof(uint32_t)*3 + numEntries*sizeof(uint32_t)*2 + numBlobs*sizeof(uint32_t)*2;
+		uint32_t size   = 0;
+		for (uint32_t ii = 0; ii < numBlobs; ++ii)
+		{
+			offset = bx::strideAlign(offset, 16);
+			blobs[ii].offset = offset;
+			offset += uint32_t(blobs[ii].data.size() );
+			size   += uint32_t(blobs[ii].data.size() );
+		}
+
+		bx::FileWriter writer;
+		if (!bx::open(&writer, outFilePath) )
+		{
+			bx::printf("Unable to open output file '%s'.\n", outFilePath);
+			return bx::kExitFailure;
+		}
+
+		bx::Error err;
+		bx::write(&writer, BGFX_CHUNK_MAGIC_SPK, &err);
+		bx::write(&writer, numEntries, &err);
+		bx::write(&writer, numBlobs, &err);
+
+		for (uint32_t ii = 0; ii < numEntries; ++ii)
+		{
+			bx::write(&writer, entries[ii].key, &err);
+			bx::write(&writer, entries[ii].blob, &err);
+		}
+
+		for (uint32_t ii = 0; ii < numBlobs; ++ii)
+		{
+			bx::write(&writer, blobs[ii].offset, &err);
+			bx::write(&writer, uint32_t(blobs[ii].data.size() ), &err);
+		}
+
+		const uint8_t pad[16] = {};
+		uint32_t pos = sizeof(uint32_t)*3 + numEntries*sizeof(uint32_t)*2 + numBlobs*sizeof(uint32_t)*2;
+		for (uint32_t ii = 0; ii < numBlobs; ++ii)
+		{
+			bx::write(&writer, pad, int32_t(blobs[ii].offset - pos), &err);
+			bx::write(&writer, blobs[ii].data.c_str(), int32_t(blobs[ii].data.size() ), &err);
+			pos = blobs[ii].offset + uint32_t(blobs[ii].data.size() );
+		}
+
+		bx::close(&writer);
+
+		if (!err.isOk() )
+		{
+			bx::printf("Failed to write output file '%s'.\n", outFilePath);
+			return bx::kExitFailure;
+		}
+
+		bx::printf("%d permutations, %d unique shaders, %d bytes of bytecode.\n"
+			, numEntries
+			, numBlobs
+			, size
+			);
+
+		return bx::kExitSuccess;
+	}
+
+} // namespace bgfx
@@ -11,10 +11,14 @@
 #include <bx/easing.h>
 #include <bx/file.h>
 #include <bx/filepath.h>
+#include <bx/hash.h>
 #include <bx/math.h>
+#include <bx/mutex.h>
 #include <bx/os.h>
 #include <bx/process.h>
+#include <bx/semaphore.h>
 #include <bx/settings.h>
+#include <bx/thread.h>
 #include <bx/uint32_t.h>
 
 #include <entry/entry.h>
@@ -30,6 +34,8 @@ namespace stl = tinystl;
 #include <string>
 #include <algorithm>
 
+#include <sys/stat.h>
+
 #include <bimg/decode.h>
 
 #include <bgfx/embedded_shader.h>
@@ -184,6 +190,7 @@ static const InputBinding s_bindingView[] =
 	{ entry::Key::KeyH,      entry::Modifier::None,       1, NULL, "view help"               },
 
 	{ entry::Key::Return,    entry::Modifier::None,       1, NULL, "view files"              },
+	{ entry::Key::KeyT,      entry::Modifier::None,       1, NULL, "view thumbnails"         },
 
 	{ entry::Key::KeyS,      entry::Modifier::None,       1, NULL, "view sdf"                },
 
@@ -247,6 +254,8 @@ extern "C" uint32_t __stdcall GetModuleFileNameA(void* _module, char* _outFilePa
 
 #endif // BX_PLATFORM_WINDOWS
 
+typedef stl::vector<std::string> FileList;
+
 struct View
 {
 	View()
@@ -272,6 +281,7 @@ struct View
 		, m_transitionTime(1.0f)
 		, m_width(1280)
 		, m_height(720)
+		, m_cacheSize(512)
 		, m_filter(true)
 		, m_fit(true)
 		, m_alpha(false)
@@ -279,6 +289,7 @@ struct View
 		, m_about(false)
 		, m_info(false)
 		, m_files(false)
+		, m_thumbnails(false)
 		, m_sdf(false)
 		, m_inLinear(false)
 	{
@@ -681,97 +692,13 @@ struct View
 			{
 				m_files ^= true;
 			}
-		}
-
-		return 0;
-	}
-
-	static bool sortNameAscending(const std::string& _lhs, const std::string& _rhs)
-	{
-		return 0 > bx::strCmpV(_lhs.c_str(), _rhs.c_str() );
-	}
-
-	void updateFileList(const bx::FilePath& _filePath)
-	{
-		bx::DirectoryReader dr;
-
-		if (bx::open(&dr, _filePath) )
-		{
-			m_path = _filePath;
-		}
-		else if (bx::open(&dr, _filePath.getPath() ) )
-		{
-			m_path = _filePath.getPath();
-		}
-		else
-		{
-			DBG("File path `%s` not found.", _filePath.getCPtr() );
-			return;
-		}
-
-		bx::Error err;
-
-		m_fileList.clear();
-
-		while (err.isOk() )
-		{
-			bx::FileInfo fi;
-			bx::read(&dr, fi, &err);
-
-			if (err.isOk()
-			&&  bx::FileType::File == fi.type)
+			else if (0 == bx::strCmp(_argv[1], "thumbnails") )
 			{
-				bx::StringView ext = fi.filePath.getExt();
-
-				if (!ext.isEmpty() )
-				{
-					ext.set(ext.getPtr()+1, ext.getTerm() );
-
-					bool supported = false;
-					for (uint32_t ii = 0; ii < BX_COUNTOF(s_supportedExt); ++ii)
-					{
-						const bx::StringView supportedExt(s_supportedExt[ii]);
-
-						if (0 == bx::strCmpI(bx::max(ext.getPtr(), ext.getTerm() - supportedExt.getLength() ), supportedExt) )
-						{
-							supported = true;
-							break;
-						}
-					}
-
-					if (supported)
-					{
-						const bx::StringView fileName = fi.filePath.getFileName();
-						m_fileList.push_back(std::string(fileName.getPtr(), fileName.getTerm() ) );
-					}
-				}
+				m_thumbnails ^= true;
 			}
 		}
 
-		bx::close(&dr);
-
-		std::sort(m_fileList.begin(), m_fileList.end(), sortNameAscending);
-
-		m_fileIndex = 0;
-		uint32_t idx = 0;
-
-		const bx::StringView fileName = _filePath.getFileName();
-
-		for (FileList::const_iterator it = m_fileList.begin(); it != m_fileList.end(); ++it, ++idx)
-		{
-			if (0 == bx::strCmpI(it->c_str(), fileName) )
-			{
-				// If it is case-insensitive match then might be correct one, but keep
-				// searching.
-				m_fileIndex = idx;
-
-				if (0 == bx::strCmp(it->c_str(), fileName) )
-				{
-					// If it is exact match we're done.
-					break;
-				}
-			}
-		}
+		return 0;
 	}
 
 	void load()
@@ -801,6 +728,11 @@ struct View
 			{
 				m_height = 720;
 			}
+
+			if (!bx::fromString(&m_cacheSize, settings.get("view/cache") ) )
+			{
+				m_cacheSize = 512;
+			}
 		}
 	}
 
@@ -823,6 +755,9 @@ struct View
 			bx::toString(tmp, sizeof(tmp), m_height);
 			settings.set("view/height", tmp);
 
+			bx::toString(tmp, sizeof(tmp), m_cacheSize);
+			settings.set("view/cache", tmp);
+
 			bx::FileWriter writer;
 			if (bx::open(&writer, filePath) )
 			{
@@ -833,9 +768,7 @@ struct View
 	}
 
 	bx::FilePath m_path;
-
-	typedef stl::vector<std::string> FileList;
-	FileList m_fileList;
+	FileList     m_fileList;
 
 	bgfx::TextureInfo m_textureInfo;
 	Geometry::Enum m_cubeMapGeo;
@@ -860,6 +793,7 @@ struct View
 	float    m_transitionTime;
 	uint32_t m_width;
 	uint32_t m_height;
+	uint32_t m_cacheSize;
 	bool     m_filter;
 	bool     m_fit;
 	bool     m_alpha;
@@ -867,6 +801,7 @@ struct View
 	bool     m_about;
 	bool     m_info;
 	bool     m_files;
+	bool     m_thumbnails;
 	bool     m_sdf;
 	bool     m_inLinear;
 };
@@ -877,6 +812,827 @@ int cmdView(CmdContext* /*_context*/, void* _userData, int _argc, char const* co
 	return view->cmd(_argc, _argv);
 }
 
+static const uint32_t kNumLoaderThreads   = 4;
+static const uint32_t kPrefetchDistance   = 2;
+static const uint32_t kMaxCachedTextures  = 256;
+static const uint32_t kThumbnailSize      = 128;
+static const uint32_t kMaxThumbnails      = 512;
+
+static const uint64_t kTextureFlags = 0
+	| BGFX_SAMPLER_U_CLAMP
+	| BGFX_SAMPLER_V_CLAMP
+	| BGFX_SAMPLER_W_CLAMP
+	;
+
+static bool sortNameAscending(const std::string& _lhs, const std::string& _rhs)
+{
+	return 0 > bx::strCmpV(_lhs.c_str(), _rhs.c_str() );
+}
+
+// Scans directory of `_filePath`, or `_filePath` itself if it's directory. Returns index of
+// `_filePath` in sorted file list, or UINT32_MAX if path is not found.
+static uint32_t scanDirectory(bx::FilePath& _outPath, FileList& _outFileList, const bx::FilePath& _filePath)
+{
+	bx::DirectoryReader dr;
+
+	if (bx::open(&dr, _filePath) )
+	{
+		_outPath = _filePath;
+	}
+	else if (bx::open(&dr, _filePath.getPath() ) )
+	{
+		_outPath = _filePath.getPath();
+	}
+	else
+	{
+		DBG("File path `%s` not found.", _filePath.getCPtr() );
+		return UINT32_MAX;
+	}
+
+	bx::Error err;
+
+	_outFileList.clear();
+
+	while (err.isOk() )
+	{
+		bx::FileInfo fi;
+		bx::read(&dr, fi, &err);
+
+		if (err.isOk()
+		&&  bx::FileType::File == fi.type)
+		{
+			bx::StringView ext = fi.filePath.getExt();
+
+			if (!ext.isEmpty() )
+			{
+				ext.set(ext.getPtr()+1, ext.getTerm() );
+
+				bool supported = false;
+				for (uint32_t ii = 0; ii < BX_COUNTOF(s_supportedExt); ++ii)
+				{
+					const bx::StringView supportedExt(s_supportedExt[ii]);
+
+					if (0 == bx::strCmpI(bx::max(ext.getPtr(), ext.getTerm() - supportedExt.getLength() ), supportedExt) )
+					{
+						supported = true;
+						break;
+					}
+				}
+
+				if (supported)
+				{
+					const bx::StringView fileName = fi.filePath.getFileName();
+					_outFileList.push_back(std::string(fileName.getPtr(), fileName.getTerm() ) );
+				}
+			}
+		}
+	}
+
+	bx::close(&dr);
+
+	std::sort(_outFileList.begin(), _outFileList.end(), sortNameAscending);
+
+	uint32_t fileIndex = 0;
+	uint32_t idx = 0;
+
+	const bx::StringView fileName = _filePath.getFileName();
+
+	for (FileList::const_iterator it = _outFileList.begin(); it != _outFileList.end(); ++it, ++idx)
+	{
+		if (0 == bx::strCmpI(it->c_str(), fileName) )
+		{
+			// If it is case-insensitive match then might be correct one, but keep
+			// searching.
+			fileIndex = idx;
+
+			if (0 == bx::strCmp(it->c_str(), fileName) )
+			{
+				// If it is exact match we're done.
+				break;
+			}
+		}
+	}
+
+	return fileIndex;
+}
+
+static bool getFileStat(const bx::FilePath& _filePath, uint64_t& _outSize, uint64_t& _outTime)
+{
+#if BX_PLATFORM_WINDOWS
+	struct ::_stat64 st;
+	if (0 != ::_stat64(_filePath.getCPtr(), &st) )
+#else
+	struct ::stat st;
+	if (0 != ::stat(_filePath.getCPtr(), &st) )
+#endif // BX_PLATFORM_WINDOWS
+	{
+		return false;
+	}
+
+	_outSize = uint64_t(st.st_size);
+	_outTime = uint64_t(st.st_mtime);
+
+	return true;
+}
+
+// Called from worker threads, must not use shared entry::getFileReader().
+static bimg::ImageContainer* decodeImage(const bx::FilePath& _filePath, bimg::TextureFormat::Enum _dstFormat = bimg::TextureFormat::Count)
+{
+	bx::FileReader reader;
+	if (!bx::open(&reader, _filePath) )
+	{
+		return NULL;
+	}
+
+	bx::AllocatorI* allocator = entry::getAllocator();
+
+	bx::Error err;
+	const uint32_t size = uint32_t(bx::getSize(&reader) );
+	void* data = BX_ALLOC(allocator, size);
+	bx::read(&reader, data, int32_t(size), &err);
+	bx::close(&reader);
+
+	bimg::ImageContainer* imageContainer = NULL;
+	if (err.isOk() )
+	{
+		imageContainer = bimg::imageParse(allocator, data, size, _dstFormat);
+	}
+
+	BX_FREE(allocator, data);
+
+	return imageContainer;
+}
+
+// Returns BGRA8 thumbnail of first mip, side, and layer. Thumbnail is read from `_cachePath`
+// when file didn't change since it was generated, otherwise it's generated and written there.
+static bimg::ImageContainer* createThumbnail(const bx::FilePath& _filePath, const bx::FilePath& _cachePath)
+{
+	uint64_t size;
+	uint64_t time;
+	if (!getFileStat(_filePath, size, time) )
+	{
+		return NULL;
+	}
+
+	const char* path = _filePath.getCPtr();
+	const int32_t len = bx::strLen(path);
+
+	bx::HashMurmur2A murmur;
+	murmur.begin();
+	murmur.add(path, len);
+
+	bx::HashCrc32 crc;
+	crc.begin();
+	crc.add(path, len);
+	crc.add(&size, sizeof(size) );
+	crc.add(&time, sizeof(time) );
+
+	char name[32];
+	bx::snprintf(name, BX_COUNTOF(name), "%08x%08x.tga", murmur.end(), crc.end() );
+
+	bx::FilePath thumbnailPath = _cachePath;
+	thumbnailPath.join(name);
+
+	bimg::ImageContainer* thumbnail = decodeImage(thumbnailPath, bimg::TextureFormat::BGRA8);
+	if (NULL != thumbnail)
+	{
+		return thumbnail;
+	}
+
+	bimg::ImageContainer* image = decodeImage(_filePath, bimg::TextureFormat::BGRA8);
+	if (NULL == image)
+	{
+		return NULL;
+	}
+
+	bimg::ImageMip mip;
+	if (!bimg::imageGetRawData(*image, 0, 0, image->m_data, image->m_size, mip) )
+	{
+		bimg::imageFree(image);
+		return NULL;
+	}
+
+	const uint32_t srcWidth  = mip.m_width;
+	const uint32_t srcHeight = mip.m_height;
+	const uint32_t maxSize   = bx::max(srcWidth, srcHeight);
+
+	uint32_t width  = srcWidth;
+	uint32_t height = srcHeight;
+
+	if (kThumbnailSize < maxSize)
+	{
+		width  = bx::max<uint32_t>(1, srcWidth *kThumbnailSize/maxSize);
+		height = bx::max<uint32_t>(1, srcHeight*kThumbnailSize/maxSize);
+	}
+
+	thumbnail = bimg::imageAlloc(
+		  entry::getAllocator()
+		, bimg::TextureFormat::BGRA8
+		, uint16_t(width)
+		, uint16_t(height)
+		, 1
+		, 1
+		, false
+		, false
+		);
+
+	// Box filter, every source texel contributes to exactly one thumbnail texel.
+	const uint8_t* src = mip.m_data;
+	uint8_t* dst = (uint8_t*)thumbnail->m_data;
+
+	for (uint32_t yy = 0; yy < height; ++yy)
+	{
+		const uint32_t y0 = yy*srcHeight/height;
+		const uint32_t y1 = bx::max(y0+1, (yy+1)*srcHeight/height);
+
+		for (uint32_t xx = 0; xx < width; ++xx, dst += 4)
+		{
+			const uint32_t x0 = xx*srcWidth/width;
+			const uint32_t x1 = bx::max(x0+1, (xx+1)*srcWidth/width);
+
+			uint32_t sum[4] = { 0, 0, 0, 0 };
+
+			for (uint32_t sy = y0; sy < y1; ++sy)
+			{
+				const uint8_t* texel = &src[(sy*srcWidth + x0)*4];
+
+				for (uint32_t sx = x0; sx < x1; ++sx, texel += 4)
+				{
+					sum[0] += texel[0];
+					sum[1] += texel[1];
+					sum[2] += texel[2];
+					sum[3] += texel[3];
+				}
+			}
+
+			const uint32_t count = (y1-y0)*(x1-x0);
+			dst[0] = uint8_t(sum[0]/count);
+			dst[1] = uint8_t(sum[1]/count);
+			dst[2] = uint8_t(sum[2]/count);
+			dst[3] = uint8_t(sum[3]/count);
+		}
+	}
+
+	bimg::imageFree(image);
+
+	bx::FileWriter writer;
+	if (bx::open(&writer, thumbnailPath) )
+	{
+		bx::Error err;
+		bimg::imageWriteTga(&writer, width, height, width*4, thumbnail->m_data, false, false, &err);
+		bx::close(&writer);
+	}
+
+	return thumbnail;
+}
+
+/// Loads textures on worker threads. Directory scan, image decoding, and thumbnail generation
+/// are done by workers, and textures are created on main thread in `update`.
+///
+/// Decoded textures are kept in LRU cache bounded by memory budget. Thumbnails are cached on
+/// disk, keyed by hash of file path, size and modification time.
+///
+class TextureLoader
+{
+public:
+	struct Job
+	{
+		enum Enum
+		{
+			Scan,
+			Decode,
+			Thumbnail,
+
+			Count
+		};
+
+		Enum         m_type;
+		uint32_t     m_key;        //!< Hash of file path for decode, file index for thumbnail.
+		uint32_t     m_generation; //!< Scan generation.
+		bx::FilePath m_filePath;
+	};
+
+	struct CachedTexture
+	{
+		uint32_t                m_key;
+		bgfx::TextureHandle     m_handle; //!< Invalid if file failed to load.
+		bgfx::TextureInfo       m_info;
+		bimg::Orientation::Enum m_orientation;
+	};
+
+	struct Thumbnail
+	{
+		bgfx::TextureHandle m_handle;
+		uint16_t m_width;
+		uint16_t m_height;
+		uint32_t m_frame;  //!< Last frame when thumbnail was requested.
+		bool     m_failed;
+	};
+
+	///
+	TextureLoader(uint32_t _numThreads, uint32_t _cacheSize)
+		: m_thumbnailPath(bx::Dir::Home)
+		, m_cacheSize(uint64_t(_cacheSize)<<20)
+		, m_numThreads(bx::uint32_clamp(_numThreads, 1, kMaxThreads) )
+		, m_numThumbnails(0)
+		, m_pinned(UINT32_MAX)
+		, m_urgent(UINT32_MAX)
+		, m_frame(0)
+		, m_generation(0)
+		, m_listGeneration(0)
+		, m_scanIndex(0)
+		, m_scanGeneration(0)
+		, m_scanDone(false)
+		, m_exit(false)
+	{
+		m_thumbnailPath.join(".config/bgfx/texturev/thumbnails");
+		bx::makeAll(m_thumbnailPath);
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_thread[ii].init(workerThread, this, 0, "texturev loader");
+		}
+	}
+
+	/// Queued jobs are discarded, and all textures are destroyed.
+	~TextureLoader()
+	{
+		{
+			bx::MutexScope scope(m_mutex);
+			m_exit = true;
+		}
+
+		m_work.post();
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_thread[ii].shutdown();
+		}
+
+		for (ResultArray::iterator it = m_results.begin(), itEnd = m_results.end(); it != itEnd; ++it)
+		{
+			if (NULL != it->m_image)
+			{
+				bimg::imageFree(it->m_image);
+			}
+		}
+
+		for (TextureArray::iterator it = m_textures.begin(), itEnd = m_textures.end(); it != itEnd; ++it)
+		{
+			if (bgfx::isValid(it->m_handle) )
+			{
+				bgfx::destroy(it->m_handle);
+			}
+		}
+
+		resetThumbnails(0);
+	}
+
+	/// Scan directory on worker thread. If `_filePath` is file, its directory is scanned.
+	void scan(const bx::FilePath& _filePath)
+	{
+		uint32_t generation;
+
+		{
+			bx::MutexScope scope(m_mutex);
+			generation = ++m_generation;
+		}
+
+		push(Job::Scan, 0, generation, _filePath, true);
+	}
+
+	/// Returns true when most recent scan is done. Receives scanned directory, sorted file
+	/// list, and index of scanned file in list.
+	bool pollScan(bx::FilePath& _outPath, FileList& _outFileList, uint32_t& _outIndex)
+	{
+		{
+			bx::MutexScope scope(m_mutex);
+
+			if (!m_scanDone)
+			{
+				return false;
+			}
+
+			m_scanDone = false;
+
+			_outPath = m_scanPath;
+			_outFileList.swap(m_scanFileList);
+			_outIndex = m_scanIndex;
+			m_scanFileList.clear();
+			m_listGeneration = m_scanGeneration;
+		}
+
+		cancel(Job::Decode);
+		cancel(Job::Thumbnail);
+		resetThumbnails(uint32_t(_outFileList.size() ) );
+
+		return true;
+	}
+
+	/// Returns true and receives texture if it's in cache, otherwise queues decoding. Urgent
+	/// requests are decoded before prefetch and thumbnail requests.
+	bool get(const bx::FilePath& _filePath, bool _urgent, CachedTexture& _outTexture)
+	{
+		const uint32_t key = bx::hash<bx::HashMurmur2A>(_filePath.getCPtr() );
+
+		for (uint32_t ii = 0, num = uint32_t(m_textures.size() ); ii < num; ++ii)
+		{
+			if (key == m_textures[ii].m_key)
+			{
+				_outTexture = m_textures[ii];
+
+				// Move to front as most recently used.
+				m_textures.erase(m_textures.begin() + ii);
+				m_textures.insert(m_textures.begin(), _outTexture);
+
+				return true;
+			}
+		}
+
+		if (_urgent)
+		{
+			m_urgent = key;
+		}
+
+		push(Job::Decode, key, m_listGeneration, _filePath, _urgent);
+
+		return false;
+	}
+
+	/// Texture with key is not evicted while it's displayed.
+	void pin(uint32_t _key)
+	{
+		m_pinned = _key;
+	}
+
+	/// Returns true when there is no work queued or in flight.
+	bool isIdle()
+	{
+		bx::MutexScope scope(m_mutex);
+		return m_pending.empty();
+	}
+
+	/// Returns thumbnail of file in scanned file list, or NULL while it's generated.
+	const Thumbnail* getThumbnail(uint32_t _index, const bx::FilePath& _filePath)
+	{
+		if (_index >= m_thumbnails.size() )
+		{
+			return NULL;
+		}
+
+		Thumbnail& thumbnail = m_thumbnails[_index];
+		thumbnail.m_frame = m_frame;
+
+		if (bgfx::isValid(thumbnail.m_handle)
+		||  thumbnail.m_failed)
+		{
+			return &thumbnail;
+		}
+
+		push(Job::Thumbnail, _index, m_listGeneration, _filePath, false);
+
+		return NULL;
+	}
+
+	/// Drops queued jobs of type that didn't start yet.
+	void cancel(Job::Enum _type)
+	{
+		bx::MutexScope scope(m_mutex);
+
+		for (uint32_t queue = 0; queue < BX_COUNTOF(m_jobs); ++queue)
+		{
+			JobArray& jobs = m_jobs[queue];
+
+			for (uint32_t ii = 0; ii < jobs.size();)
+			{
+				if (_type == jobs[ii].m_type)
+				{
+					removePending(jobs[ii].m_type, jobs[ii].m_key);
+					jobs.erase(jobs.begin() + ii);
+				}
+				else
+				{
+					++ii;
+				}
+			}
+		}
+	}
+
+	/// Creates textures from decoded images. Must be called from thread that calls bgfx API.
+	void update()
+	{
+		ResultArray results;
+
+		{
+			bx::MutexScope scope(m_mutex);
+			results.swap(m_results);
+
+			for (ResultArray::const_iterator it = results.begin(), itEnd = results.end(); it != itEnd; ++it)
+			{
+				removePending(it->m_job.m_type, it->m_job.m_key);
+			}
+		}
+
+		++m_frame;
+
+		for (ResultArray::iterator it = results.begin(), itEnd = results.end(); it != itEnd; ++it)
+		{
+			const Job& job = it->m_job;
+			bimg::ImageContainer* image = it->m_image;
+
+			if (Job::Decode == job.m_type)
+			{
+				CachedTexture texture;
+				texture.m_key              = job.m_key;
+				texture.m_handle.idx       = bgfx::kInvalidHandle;
+				texture.m_orientation      = bimg::Orientation::R0;
+				bx::memSet(&texture.m_info, 0, sizeof(texture.m_info) );
+				texture.m_info.format      = bgfx::TextureFormat::Count;
+
+				if (NULL != image)
+				{
+					texture.m_orientation = image->m_orientation;
+					texture.m_handle      = createTexture(image, kTextureFlags, job.m_filePath.getCPtr(), &texture.m_info);
+				}
+
+				m_textures.insert(m_textures.begin(), texture);
+			}
+			else if (Job::Thumbnail == job.m_type
+			     &&  job.m_generation == m_listGeneration
+			     &&  job.m_key < m_thumbnails.size() )
+			{
+				Thumbnail& thumbnail = m_thumbnails[job.m_key];
+				thumbnail.m_failed = NULL == image;
+
+				if (NULL != image)
+				{
+					thumbnail.m_width  = uint16_t(image->m_width);
+					thumbnail.m_height = uint16_t(image->m_height);
+					thumbnail.m_handle = createTexture(image, kTextureFlags, job.m_filePath.getCPtr() );
+					thumbnail.m_failed = !bgfx::isValid(thumbnail.m_handle);
+					m_numThumbnails += !thumbnail.m_failed;
+				}
+			}
+			else if (NULL != image)
+			{
+				bimg::imageFree(image);
+			}
+		}
+
+		evict();
+	}
+
+private:
+	struct Result
+	{
+		Job m_job;
+		bimg::ImageContainer* m_image;
+	};
+
+	static const uint32_t kMaxThreads = 8;
+
+	static int32_t workerThread(bx::Thread* /*_thread*/, void* _userData)
+	{
+		TextureLoader* loader = (TextureLoader*)_userData;
+		return loader->worker();
+	}
+
+	int32_t worker()
+	{
+		for (;;)
+		{
+			m_work.wait();
+
+			Job job;
+			bool hasJob = false;
+
+			{
+				bx::MutexScope scope(m_mutex);
+
+				if (m_exit)
+				{
+					// Wake next worker, it will exit too.
+					m_work.post();
+					return 0;
+				}
+
+				for (uint32_t ii = 0; ii < BX_COUNTOF(m_jobs) && !hasJob; ++ii)
+				{
+					if (!m_jobs[ii].empty() )
+					{
+						job = m_jobs[ii][0];
+						m_jobs[ii].erase(m_jobs[ii].begin() );
+						hasJob = true;
+					}
+				}
+			}
+
+			if (!hasJob)
+			{
+				// Job was cancelled.
+				continue;
+			}
+
+			if (Job::Scan == job.m_type)
+			{
+				bx::FilePath path;
+				FileList fileList;
+				const uint32_t index = scanDirectory(path, fileList, job.m_filePath);
+
+				bx::MutexScope scope(m_mutex);
+				removePending(job.m_type, job.m_key);
+
+				if (UINT32_MAX != index
+				&&  job.m_generation == m_generation)
+				{
+					m_scanPath = path;
+					m_scanFileList.swap(fileList);
+					m_scanIndex      = index;
+					m_scanGeneration = job.m_generation;
+					m_scanDone       = true;
+				}
+			}
+			else
+			{
+				Result result;
+				result.m_job   = job;
+				result.m_image = Job::Decode == job.m_type
+					? decodeImage(job.m_filePath)
+					: createThumbnail(job.m_filePath, m_thumbnailPath)
+					;
+
+				bx::MutexScope scope(m_mutex);
+				m_results.push_back(result);
+			}
+		}
+	}
+
+	void push(Job::Enum _type, uint32_t _key, uint32_t _generation, const bx::FilePath& _filePath, bool _urgent)
+	{
+		{
+			bx::MutexScope scope(m_mutex);
+
+			const uint64_t id = uint64_t(_type)<<32 | _key;
+
+			for (uint32_t ii = 0, num = uint32_t(m_pending.size() ); ii < num; ++ii)
+			{
+				if (id == m_pending[ii])
+				{
+					if (_urgent)
+					{
+						// Already queued as prefetch, move it in front of other work.
+						JobArray& jobs = m_jobs[1];
+
+						for (uint32_t jj = 0, numJobs = uint32_t(jobs.size() ); jj < numJobs; ++jj)
+						{
+							if (_type == jobs[jj].m_type
+							&&  _key  == jobs[jj].m_key)
+							{
+								m_jobs[0].push_back(jobs[jj]);
+								jobs.erase(jobs.begin() + jj);
+								break;
+							}
+						}
+					}
+
+					return;
+				}
+			}
+
+			Job job;
+			job.m_type       = _type;
+			job.m_key        = _key;
+			job.m_generation = _generation;
+			job.m_filePath   = _filePath;
+
+			m_jobs[_urgent ? 0 : 1].push_back(job);
+			m_pending.push_back(id);
+		}
+
+		m_work.post();
+	}
+
+	// Must be called with m_mutex locked.
+	void removePending(Job::Enum _type, uint32_t _key)
+	{
+		const uint64_t id = uint64_t(_type)<<32 | _key;
+
+		for (uint32_t ii = 0, num = uint32_t(m_pending.size() ); ii < num; ++ii)
+		{
+			if (id == m_pending[ii])
+			{
+				m_pending.erase(m_pending.begin() + ii);
+				break;
+			}
+		}
+	}
+
+	void resetThumbnails(uint32_t _numFiles)
+	{
+		for (ThumbnailArray::iterator it = m_thumbnails.begin(), itEnd = m_thumbnails.end(); it != itEnd; ++it)
+		{
+			if (bgfx::isValid(it->m_handle) )
+			{
+				bgfx::destroy(it->m_handle);
+			}
+		}
+
+		m_thumbnails.resize(_numFiles);
+		m_numThumbnails = 0;
+
+		for (ThumbnailArray::iterator it = m_thumbnails.begin(), itEnd = m_thumbnails.end(); it != itEnd; ++it)
+		{
+			it->m_handle.idx = bgfx::kInvalidHandle;
+			it->m_width  = 0;
+			it->m_height = 0;
+			it->m_frame  = 0;
+			it->m_failed = false;
+		}
+	}
+
+	void evict()
+	{
+		uint64_t size = 0;
+		for (TextureArray::const_iterator it = m_textures.begin(), itEnd = m_textures.end(); it != itEnd; ++it)
+		{
+			size += it->m_info.storageSize;
+		}
+
+		for (uint32_t ii = uint32_t(m_textures.size() ); 0 < ii; --ii)
+		{
+			if (size <= m_cacheSize
+			&&  m_textures.size() <= kMaxCachedTextures)
+			{
+				break;
+			}
+
+			const CachedTexture& texture = m_textures[ii-1];
+
+			if (m_pinned != texture.m_key
+			&&  m_urgent != texture.m_key)
+			{
+				size -= texture.m_info.storageSize;
+
+				if (bgfx::isValid(texture.m_handle) )
+				{
+					bgfx::destroy(texture.m_handle);
+				}
+
+				m_textures.erase(m_textures.begin() + ii - 1);
+			}
+		}
+
+		if (m_numThumbnails > kMaxThumbnails)
+		{
+			// Keep only thumbnails that were visible during last two frames.
+			for (ThumbnailArray::iterator it = m_thumbnails.begin(), itEnd = m_thumbnails.end(); it != itEnd; ++it)
+			{
+				if (bgfx::isValid(it->m_handle)
+				&&  it->m_frame + 2 < m_frame)
+				{
+					bgfx::destroy(it->m_handle);
+					it->m_handle.idx = bgfx::kInvalidHandle;
+					--m_numThumbnails;
+				}
+			}
+		}
+	}
+
+	typedef stl::vector<Job> JobArray;
+	typedef stl::vector<Result> ResultArray;
+	typedef stl::vector<CachedTexture> TextureArray;
+	typedef stl::vector<Thumbnail> ThumbnailArray;
+	typedef stl::vector<uint64_t> PendingArray;
+
+	bx::Thread    m_thread[kMaxThreads];
+	bx::Semaphore m_work;
+	bx::Mutex     m_mutex;
+
+	JobArray     m_jobs[2]; //!< Urgent, and prefetch jobs.
+	ResultArray  m_results;
+	PendingArray m_pending; //!< Jobs queued, in flight, or waiting for update.
+
+	TextureArray   m_textures; //!< Most recently used first.
+	ThumbnailArray m_thumbnails;
+	bx::FilePath   m_thumbnailPath;
+
+	uint64_t m_cacheSize;
+	uint32_t m_numThreads;
+	uint32_t m_numThumbnails;
+	uint32_t m_pinned;
+	uint32_t m_urgent; //!< Most recent urgent request.
+	uint32_t m_frame;
+	uint32_t m_generation;
+	uint32_t m_listGeneration;
+
+	bx::FilePath m_scanPath;
+	FileList     m_scanFileList;
+	uint32_t     m_scanIndex;
+	uint32_t     m_scanGeneration;
+	bool         m_scanDone;
+	bool         m_exit;
+};
+
 struct PosUvwColorVertex
 {
 	float m_x;
@@ -1411,16 +2167,23 @@ int _main_(int _argc, char** _argv)
 	const char* filePath = _argc < 2 ? "" : _argv[1];
 
 	std::string path = filePath;
-	{
-		bx::FilePath fp(filePath);
-		view.updateFileList(fp);
-	}
 
 	int exitcode = bx::kExitSuccess;
-	bgfx::TextureHandle texture = BGFX_INVALID_HANDLE;
 
 	{
-		uint32_t fileIndex = 0;
+		TextureLoader loader(kNumLoaderThreads, view.m_cacheSize);
+		loader.scan(bx::FilePath(filePath) );
+
+		auto getFilePath = [&](uint32_t _index) -> bx::FilePath
+		{
+			bx::FilePath fp = view.m_path;
+			fp.join(view.m_fileList[_index].c_str() );
+			return fp;
+		};
+
+		bgfx::TextureHandle texture = BGFX_INVALID_HANDLE;
+		uint32_t fileIndex = UINT32_MAX;
+		bool loading = false;
 		bool dragging = false;
 
 		entry::WindowState windowState;
@@ -1433,10 +2196,18 @@ int _main_(int _argc, char** _argv)
 
 			if (!windowState.m_dropFile.isEmpty() )
 			{
-				view.updateFileList(windowState.m_dropFile);
+				loader.scan(windowState.m_dropFile);
 				windowState.m_dropFile.clear();
 			}
 
+			loader.update();
+
+			if (loader.pollScan(view.m_path, view.m_fileList, view.m_fileIndex) )
+			{
+				fileIndex = UINT32_MAX;
+				loading   = false;
+			}
+
 			imguiBeginFrame(mouseState.m_mx
 				,  mouseState.m_my
 				, (mouseState.m_buttons[entry::MouseButton::Left  ] ? IMGUI_MBUT_LEFT   : 0)
@@ -1484,7 +2255,7 @@ int _main_(int _argc, char** _argv)
 							, s_filter
 							) )
 						{
-							view.updateFileList(tmp);
+							loader.scan(tmp);
 						}
 					}
 
@@ -1493,6 +2264,11 @@ int _main_(int _argc, char** _argv)
 						cmdExec("view files");
 					}
 
+					if (ImGui::MenuItem("Show Thumbnails", NULL, view.m_thumbnails) )
+					{
+						cmdExec("view thumbnails");
+					}
+
 					ImGui::Separator();
 					if (ImGui::MenuItem("Exit") )
 					{
@@ -1871,6 +2647,102 @@ int _main_(int _argc, char** _argv)
 				ImGui::End();
 			}
 
+			if (view.m_thumbnails)
+			{
+				char temp[bx::kMaxFilePath];
+				bx::snprintf(temp, BX_COUNTOF(temp), "%s##Thumbnails", view.m_path.getCPtr() );
+
+				ImGui::SetNextWindowSize(
+					  ImVec2(640.0f, 480.0f)
+					, ImGuiCond_FirstUseEver
+					);
+
+				if (ImGui::Begin(temp, &view.m_thumbnails) )
+				{
+					// Only thumbnails visible in this frame are requested again.
+					loader.cancel(TextureLoader::Job::Thumbnail);
+
+					const ImGuiStyle& style = ImGui::GetStyle();
+					const float imageSize  = float(kThumbnailSize);
+					const ImVec2 cellSize(
+						  imageSize + 2.0f*style.FramePadding.x
+						, imageSize + 2.0f*style.FramePadding.y
+						);
+
+					const int32_t numFiles   = int32_t(view.m_fileList.size() );
+					const int32_t numColumns = bx::max(1, int32_t(ImGui::GetContentRegionAvail().x / (cellSize.x + style.ItemSpacing.x) ) );
+					const int32_t numRows    = (numFiles + numColumns - 1) / numColumns;
+
+					ImGuiListClipper clipper(numRows, cellSize.y + style.ItemSpacing.y);
+
+					for (int32_t row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+					{
+						for (int32_t column = 0; column < numColumns; ++column)
+						{
+							const int32_t index = row*numColumns + column;
+							if (index >= numFiles)
+							{
+								break;
+							}
+
+							if (0 != column)
+							{
+								ImGui::SameLine();
+							}
+
+							ImGui::PushID(index);
+
+							const bool selected = uint32_t(index) == view.m_fileIndex;
+							if (selected)
+							{
+								ImGui::PushStyleColor(ImGuiCol_Button, style.Colors[ImGuiCol_ButtonActive]);
+							}
+
+							if (ImGui::Button("##thumbnail", cellSize) )
+							{
+								view.m_fileIndex = uint32_t(index);
+							}
+
+							if (selected)
+							{
+								ImGui::PopStyleColor();
+							}
+
+							if (ImGui::IsItemHovered() )
+							{
+								ImGui::SetTooltip("%s", view.m_fileList[index].c_str() );
+							}
+
+							const TextureLoader::Thumbnail* thumbnail = loader.getThumbnail(uint32_t(index), getFilePath(uint32_t(index) ) );
+
+							if (NULL != thumbnail
+							&&  bgfx::isValid(thumbnail->m_handle) )
+							{
+								const ImVec2 min = ImGui::GetItemRectMin();
+								const ImVec2 max = ImGui::GetItemRectMax();
+								const float scale = imageSize / float(bx::max(thumbnail->m_width, thumbnail->m_height) );
+								const float halfWidth  = 0.5f*scale*float(thumbnail->m_width);
+								const float halfHeight = 0.5f*scale*float(thumbnail->m_height);
+								const float centerX = 0.5f*(min.x + max.x);
+								const float centerY = 0.5f*(min.y + max.y);
+
+								ImGui::GetWindowDrawList()->AddImage(
+									  ImGui::toId(thumbnail->m_handle, IMGUI_FLAGS_ALPHA_BLEND, 0)
+									, ImVec2(centerX - halfWidth, centerY - halfHeight)
+									, ImVec2(centerX + halfWidth, centerY + halfHeight)
+									);
+							}
+
+							ImGui::PopID();
+						}
+					}
+
+					clipper.End();
+				}
+
+				ImGui::End();
+			}
+
 			if (ImGui::BeginPopupModal("About", &view.m_about, ImGuiWindowFlags_AlwaysAutoResize) )
 			{
 				ImGui::SetWindowFontScale(1.0f);
@@ -1927,6 +2799,7 @@ int _main_(int _argc, char** _argv)
 
 				keyBindingHelp("up",   "Previous texture.");
 				keyBindingHelp("down", "Next texture.");
+				keyBindingHelp("t",    "Toggle thumbnails.");
 				ImGui::NextLine();
 
 				keyBindingHelp("r/g/b", "Toggle R, G, or B color channel.");
@@ -1952,29 +2825,45 @@ int _main_(int _argc, char** _argv)
 
 			imguiEndFrame();
 
-			if ( (!bgfx::isValid(texture) || view.m_fileIndex != fileIndex)
+			if (view.m_fileIndex != fileIndex
 			&&  0 != view.m_fileList.size() )
 			{
-				if (bgfx::isValid(texture) )
+				fileIndex = view.m_fileIndex;
+				loading   = true;
+
+				// Drop decoding of files that are not near selected one anymore.
+				loader.cancel(TextureLoader::Job::Decode);
+			}
+
+			TextureLoader::CachedTexture cached;
+			if (loading
+			&&  loader.get(getFilePath(fileIndex), true, cached) )
+			{
+				loading = false;
+
+				// Prefetch neighbouring files while selected file is viewed.
+				const uint32_t numFiles = uint32_t(view.m_fileList.size() );
+				for (uint32_t ii = 1; ii <= kPrefetchDistance; ++ii)
 				{
-					bgfx::destroy(texture);
+					TextureLoader::CachedTexture prefetch;
+
+					if (fileIndex + ii < numFiles)
+					{
+						loader.get(getFilePath(fileIndex + ii), false, prefetch);
+					}
+
+					if (ii <= fileIndex)
+					{
+						loader.get(getFilePath(fileIndex - ii), false, prefetch);
+					}
 				}
 
-				fileIndex = view.m_fileIndex;
+				loader.pin(cached.m_key);
+				texture = cached.m_handle;
+				view.m_textureInfo = cached.m_info;
 
-				bx::FilePath fp = view.m_path;
-				fp.join(view.m_fileList[view.m_fileIndex].c_str() );
-
-				bimg::Orientation::Enum orientation;
-				texture = loadTexture(fp.getCPtr()
-					, 0
-					| BGFX_SAMPLER_U_CLAMP
-					| BGFX_SAMPLER_V_CLAMP
-					| BGFX_SAMPLER_W_CLAMP
-					, 0
-					, &view.m_textureInfo
-					, &orientation
-					);
+				const bx::FilePath fp = getFilePath(fileIndex);
+				const bimg::Orientation::Enum orientation = cached.m_orientation;
 
 				bimg::TextureFormat::Enum format = bimg::TextureFormat::Enum(view.m_textureInfo.format);
 
@@ -2026,7 +2915,7 @@ int _main_(int _argc, char** _argv)
 				}
 				else
 				{
-					bx::stringPrintf(title, "Failed to load %s!", filePath);
+					bx::stringPrintf(title, "Failed to load %s!", fp.getCPtr() );
 				}
 
 				entry::WindowHandle handle = { 0 };
@@ -2220,18 +3109,15 @@ int _main_(int _argc, char** _argv)
 
 			// Slow down when nothing is animating...
 			if (!dragging
-			&&  !anyActive() )
+			&&  !loading
+			&&  !anyActive()
+			&&  loader.isIdle() )
 			{
 				bx::sleep(100);
 			}
 		}
 	}
 
-	if (bgfx::isValid(texture) )
-	{
-		bgfx::destroy(texture);
-	}
-
 	bgfx::destroy(checkerBoard);
 	bgfx::destroy(s_texColor);
 	bgfx::destroy(u_mtx);